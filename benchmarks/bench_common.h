@@ -0,0 +1,56 @@
+#ifndef CEREBRUMLUX_BENCH_COMMON_H
+#define CEREBRUMLUX_BENCH_COMMON_H
+
+#include <cstddef>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "../src/swarm_vectordb/DataModels.h"
+
+namespace CerebrumLux {
+namespace Bench {
+
+// Tüm fikstürlerin paylaştığı çalışma dizini. main() çıkışta siler.
+const std::string& data_dir();
+
+// --max_vectors=N ile verilen üst sınır. Bu değeri aşan boyut argümanları atlanır.
+std::size_t max_vectors();
+void set_max_vectors(std::size_t value);
+
+// Tembel oluşturulan paylaşılan fikstürler (açık veritabanları vb.) burada kapatılır;
+// main() data_dir() silinmeden önce run_teardown() çağırır.
+void at_teardown(std::function<void()> fn);
+void run_teardown();
+
+// Deterministik, birim uzunluklu rastgele embedding'ler (aynı seed -> aynı vektör).
+inline std::vector<float> random_embedding(std::mt19937& rng, int dim = 256) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(static_cast<std::size_t>(dim));
+    float norm = 0.0f;
+    for (float& x : v) { x = dist(rng); norm += x * x; }
+    norm = norm > 0.0f ? std::sqrt(norm) : 1.0f;
+    for (float& x : v) x /= norm;
+    return v;
+}
+
+inline SwarmVectorDB::CryptofigVector make_cryptofig_vector(const std::string& id, const std::vector<float>& embedding) {
+    SwarmVectorDB::CryptofigVector cv;
+    cv.id = id;
+    cv.embedding = Eigen::Map<const Eigen::VectorXf>(embedding.data(), static_cast<Eigen::Index>(embedding.size()));
+    cv.cryptofig.assign(32, 0x5a);
+    cv.fisher_query = "benchmark fisher query";
+    cv.topic = "Benchmark";
+    cv.content_hash = id;
+    return cv;
+}
+
+} // namespace Bench
+} // namespace CerebrumLux
+
+#endif // CEREBRUMLUX_BENCH_COMMON_H
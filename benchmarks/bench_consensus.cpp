@@ -0,0 +1,113 @@
+// SwarmConsensusTree: 100k ekleme. Eski uygulama her eklemede tüm yaprakları birleştirip yeniden hash'lediği
+// için O(N^2) idi (100k'da pratikte bitmez); karşılaştırma küçük boyutta Legacy ölçümüyle verilir.
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <openssl/sha.h>
+
+#include "bench_common.h"
+#include "../src/swarm_vectordb/ConsensusTree.h"
+
+namespace {
+
+using CerebrumLux::SwarmVectorDB::CryptofigVector;
+using CerebrumLux::SwarmVectorDB::SwarmConsensusTree;
+
+const std::vector<CryptofigVector>& consensus_vectors(std::size_t n) {
+    static std::vector<CryptofigVector> vectors;
+    if (vectors.size() < n) {
+        std::mt19937 rng(7);
+        for (std::size_t i = vectors.size(); i < n; ++i) {
+            vectors.push_back(CerebrumLux::Bench::make_cryptofig_vector("consensus_" + std::to_string(i),
+                                                                        CerebrumLux::Bench::random_embedding(rng)));
+        }
+    }
+    return vectors;
+}
+
+// Arg: eklenen vektör sayısı; her iterasyon boş ağaçtan başlar.
+void BM_ConsensusTree_Insert(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& vectors = consensus_vectors(n);
+    for (auto _ : state) {
+        SwarmConsensusTree tree(16);
+        for (std::size_t i = 0; i < n; ++i) tree.update_tree(vectors[i]);
+        benchmark::DoNotOptimize(tree.root());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConsensusTree_Insert)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Aynı 100k ekleme, 1000'lik partilerle.
+void BM_ConsensusTree_BatchInsert(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& vectors = consensus_vectors(n);
+    constexpr std::size_t kBatch = 1000;
+    for (auto _ : state) {
+        SwarmConsensusTree tree(16);
+        for (std::size_t i = 0; i < n; i += kBatch) {
+            tree.update_batch(std::vector<CryptofigVector>(vectors.begin() + i, vectors.begin() + std::min(n, i + kBatch)));
+        }
+        benchmark::DoNotOptimize(tree.root());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConsensusTree_BatchInsert)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Dolu (100k) ağaçta tek yaprak güncellemesi: yalnızca kova + yol yeniden hash'lenir.
+void BM_ConsensusTree_UpdateExisting(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& vectors = consensus_vectors(n);
+    SwarmConsensusTree tree(16);
+    tree.update_batch(vectors);
+    std::vector<SwarmConsensusTree::Hash> leaves(n);
+    for (std::size_t i = 0; i < n; ++i) leaves[i] = SwarmConsensusTree::leaf_hash(vectors[i]);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        SwarmConsensusTree::Hash leaf = leaves[i % n];
+        leaf[0] ^= 0x5A; // Farklı içerik
+        tree.set_leaf(vectors[i % n].id, leaf);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsensusTree_UpdateExisting)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Eski update_tree: to_string ile float kodlaması ve her eklemede tüm yaprakların yeniden hash'lenmesi.
+std::string legacy_hex(const unsigned char* buf) {
+    std::stringstream ss;
+    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) ss << std::hex << std::setw(2) << std::setfill('0') << (int)buf[i];
+    return ss.str();
+}
+
+void BM_ConsensusTree_LegacyInsert(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    const auto& vectors = consensus_vectors(n);
+    for (auto _ : state) {
+        std::vector<std::string> leaf_hashes;
+        std::string root;
+        unsigned char hash_buf[SHA256_DIGEST_LENGTH];
+        for (std::size_t v = 0; v < n; ++v) {
+            const CryptofigVector& cv = vectors[v];
+            std::string data = cv.id + cv.content_hash + cv.fisher_query;
+            for (uint8_t byte : cv.cryptofig) data += static_cast<char>(byte);
+            for (int i = 0; i < cv.embedding.size(); ++i) data += std::to_string(cv.embedding(i));
+            SHA256(reinterpret_cast<const unsigned char*>(data.data()), data.size(), hash_buf);
+            leaf_hashes.push_back(legacy_hex(hash_buf));
+            std::string combined;
+            for (const auto& h : leaf_hashes) combined += h;
+            SHA256(reinterpret_cast<const unsigned char*>(combined.data()), combined.size(), hash_buf);
+            root = legacy_hex(hash_buf);
+        }
+        benchmark::DoNotOptimize(root);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConsensusTree_LegacyInsert)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+} // namespace
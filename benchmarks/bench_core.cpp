@@ -0,0 +1,80 @@
+// UnicodeSanitizer, Logger ve Ed25519 doğrulama mikro ölçümleri.
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/core/logger.h"
+#include "../src/core/enums.h"
+#include "../src/crypto/CryptoManager.h"
+#include "../src/learning/UnicodeSanitizer.h"
+
+namespace {
+
+// Türkçe karakterler, kontrol karakterleri ve ardışık boşluklar içeren tipik kapsül metni.
+std::string make_sanitizer_input(std::size_t bytes) {
+    static const std::string chunk =
+        "Bu temiz bir test kapsülüdür. Güzel bir gün geçiriyoruz;  çalışma\x01\x02 ortamı\t\tşöyle:\n"
+        "ASCII text with   repeated   spaces and \x07 bell characters. ";
+    std::string input;
+    input.reserve(bytes + chunk.size());
+    while (input.size() < bytes) input += chunk;
+    input.resize(bytes);
+    return input;
+}
+
+void BM_UnicodeSanitizer_Sanitize(benchmark::State& state) {
+    CerebrumLux::UnicodeSanitizer sanitizer;
+    const std::string input = make_sanitizer_input(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto output = sanitizer.sanitize(input);
+        benchmark::DoNotOptimize(output);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_UnicodeSanitizer_Sanitize)->RangeMultiplier(8)->Range(256, 1 << 16);
+
+// Logger main() içinde WARNING seviyesinde, dosyaya yazacak şekilde başlatılır.
+// Filtered: seviye altında kalan çağrının maliyeti (LOG_DEFAULT makrosunun stringstream'i dahil).
+void BM_Logger_Log_Filtered(benchmark::State& state) {
+    std::size_t i = 0;
+    for (auto _ : state) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "bench filtered message " << i++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_Log_Filtered);
+BENCHMARK(BM_Logger_Log_Filtered)->Threads(4);
+
+// Written: biçimlendirme, mutex ve dosyaya flush dahil tam yol.
+void BM_Logger_Log_Written(benchmark::State& state) {
+    const std::string message = "bench written message with a typical payload length for capsule logs";
+    for (auto _ : state) {
+        CerebrumLux::Logger::getInstance().log(CerebrumLux::LogLevel::WARNING, message, __FILE__, __LINE__);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Logger_Log_Written)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Logger_Log_Written)->Threads(4)->Unit(benchmark::kMicrosecond);
+
+// --- Ed25519 ---
+
+void BM_CryptoManager_Ed25519Verify(benchmark::State& state) {
+    CerebrumLux::Crypto::CryptoManager crypto;
+    const std::string message(static_cast<std::size_t>(state.range(0)), 'c');
+    const std::string public_key_pem = crypto.get_my_public_key_pem();
+    const std::string signature = crypto.ed25519_sign(message, crypto.get_my_private_key_pem());
+    if (signature.empty() || !crypto.ed25519_verify(message, signature, public_key_pem)) {
+        state.SkipWithError("Ed25519 imza fikstürü kurulamadi");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crypto.ed25519_verify(message, signature, public_key_pem));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CryptoManager_Ed25519Verify)->Arg(256)->Arg(16384)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,140 @@
+// FastTextWrapper: tek tek classify() döngüsü ile classify_batch()'in karşılaştırması.
+// Model, sentetik etiketli bir korpustan süreç başına bir kez eğitilir (küçük boyutlu; sınıflandırma maliyeti
+// gerçek modellere göre düşük olduğundan ölçüm ağırlıklı olarak belirteçleme ve bellek ayırma farkını gösterir).
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/communication/fasttext_wrapper.h"
+#include "../src/core/task_scheduler.h"
+
+namespace {
+
+constexpr std::size_t kBatch = 10000;
+
+// Etiket başına ayırt edici kelimeler; cümleler bunlarla ortak dolgu kelimelerinin karışımıdır.
+const std::array<std::pair<const char*, std::array<const char*, 4>>, 6> kIntents = {{
+    {"question", {"nedir", "neden", "nasil", "hangi"}},
+    {"command", {"ac", "kapat", "calistir", "durdur"}},
+    {"greeting", {"merhaba", "selam", "gunaydin", "iyi"}},
+    {"feedback", {"guzel", "kotu", "begendim", "yanlis"}},
+    {"learning", {"ogren", "ders", "konu", "calisma"}},
+    {"code", {"fonksiyon", "derle", "hata", "sinif"}},
+}};
+const std::array<const char*, 8> kFiller = {"bu", "bir", "ve", "icin", "daha", "cok", "simdi", "lutfen"};
+
+std::string make_sentence(std::mt19937& rng, std::size_t intent) {
+    std::uniform_int_distribution<int> length(4, 16);
+    std::uniform_int_distribution<int> pick_key(0, 3);
+    std::uniform_int_distribution<int> pick_filler(0, 7);
+    std::bernoulli_distribution keyword(0.4);
+    std::string sentence;
+    const int words = length(rng);
+    for (int i = 0; i < words; ++i) {
+        if (!sentence.empty()) sentence += ' ';
+        sentence += keyword(rng) ? kIntents[intent].second[pick_key(rng)] : kFiller[pick_filler(rng)];
+    }
+    sentence += '?';
+    return sentence;
+}
+
+struct FastTextFixture {
+    std::unique_ptr<CerebrumLux::FastTextWrapper> wrapper;
+    std::vector<std::string> texts;
+    std::vector<std::string_view> views;
+};
+
+FastTextFixture* fasttext_fixture() {
+    static std::unique_ptr<FastTextFixture> fixture;
+    if (fixture) return fixture->wrapper ? fixture.get() : nullptr;
+    fixture = std::make_unique<FastTextFixture>();
+    CerebrumLux::Bench::at_teardown([] { fixture.reset(); });
+
+    const std::string corpus_path = CerebrumLux::Bench::data_dir() + "/fasttext_corpus.txt";
+    const std::string model_path = CerebrumLux::Bench::data_dir() + "/fasttext_bench.bin";
+    std::mt19937 rng(42);
+    {
+        std::ofstream corpus(corpus_path);
+        for (int i = 0; i < 6000; ++i) {
+            const std::size_t intent = static_cast<std::size_t>(i) % kIntents.size();
+            corpus << "__label__" << kIntents[intent].first << ' ' << make_sentence(rng, intent) << '\n';
+        }
+    }
+
+    fasttext::Args args;
+    args.input = corpus_path;
+    args.output = model_path;
+    args.model = fasttext::model_name::sup;
+    args.loss = fasttext::loss_name::softmax;
+    args.dim = 50;
+    args.epoch = 5;
+    args.lr = 0.5;
+    args.minCount = 1;
+    args.minn = 0;
+    args.maxn = 0;
+    args.wordNgrams = 2;
+    args.bucket = 200000;
+    args.thread = 1;
+    args.verbose = 0;
+    try {
+        fasttext::FastText trainer;
+        trainer.train(args);
+        trainer.saveModel(model_path);
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+
+    fixture->wrapper = std::make_unique<CerebrumLux::FastTextWrapper>(model_path);
+    fixture->texts.reserve(kBatch);
+    for (std::size_t i = 0; i < kBatch; ++i) fixture->texts.push_back(make_sentence(rng, i % kIntents.size()));
+    fixture->views.assign(fixture->texts.begin(), fixture->texts.end());
+    return fixture.get();
+}
+
+// Mevcut yol: metin başına normalizeText kopyası + stringstream + predictLine, çağıran iş parçacığında.
+void BM_FastText_ClassifyLoop(benchmark::State& state) {
+    FastTextFixture* fixture = fasttext_fixture();
+    if (!fixture) {
+        state.SkipWithError("FastText modeli eğitilemedi");
+        return;
+    }
+    for (auto _ : state) {
+        for (const std::string& text : fixture->texts) {
+            auto result = fixture->wrapper->classify(text);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_FastText_ClassifyLoop)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Argüman: iş parçacığı sayısı (1: yalnızca görünüm belirteçleme ve arabellek yeniden kullanımının kazancı).
+// Ölçeklenmenin görülmesi için BackgroundLearning sınıf sınırı ölçüm süresince argümana yükseltilir.
+void BM_FastText_ClassifyBatch(benchmark::State& state) {
+    FastTextFixture* fixture = fasttext_fixture();
+    if (!fixture) {
+        state.SkipWithError("FastText modeli eğitilemedi");
+        return;
+    }
+    const std::size_t threads = static_cast<std::size_t>(state.range(0));
+    CerebrumLux::TaskScheduler& scheduler = CerebrumLux::TaskScheduler::instance();
+    const std::size_t previous_limit = scheduler.max_concurrency(CerebrumLux::TaskClass::BackgroundLearning);
+    scheduler.set_max_concurrency(CerebrumLux::TaskClass::BackgroundLearning, threads);
+    for (auto _ : state) {
+        auto results = fixture->wrapper->classify_batch(fixture->views, threads);
+        benchmark::DoNotOptimize(results);
+    }
+    scheduler.set_max_concurrency(CerebrumLux::TaskClass::BackgroundLearning, previous_limit);
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_FastText_ClassifyBatch)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,120 @@
+// Motor döngüsünde AIInsightsEngine -> GoalManager / MetaEvolutionEngine içgörü aktarımının maliyeti.
+//
+// Json: eski yol. Her tüketici (GoalManager ve MetaEvolutionEngine) generate_insights'tan JSON string'i alıp
+//       std::vector<AIInsight>'a geri ayrıştırıyordu; ödül aynı vektör üzerinden hesaplanıyordu.
+// Batch: yeni yol. İçgörüler tek bir InsightBatch'e taşınır; hedef seçimi ve ödül POD özetler üzerinden okunur.
+// Her iki ölçüm de içgörü vektörünün kopyalanmasını (üretimin yerine) içerir, böylece yalnızca aktarım farkı görünür.
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/core/enums.h"
+#include "../src/communication/ai_insights_engine.h"
+#include "../src/communication/insight_batch.h"
+#include "../src/meta/meta_evolution_engine.h"
+
+namespace {
+
+std::vector<CerebrumLux::AIInsight> make_insights(std::size_t count) {
+    static const CerebrumLux::InsightType types[] = {
+        CerebrumLux::InsightType::PerformanceAnomaly, CerebrumLux::InsightType::LearningOpportunity,
+        CerebrumLux::InsightType::EfficiencySuggestion, CerebrumLux::InsightType::CodeDevelopmentSuggestion};
+    static const CerebrumLux::UrgencyLevel urgencies[] = {
+        CerebrumLux::UrgencyLevel::Low, CerebrumLux::UrgencyLevel::Medium,
+        CerebrumLux::UrgencyLevel::High, CerebrumLux::UrgencyLevel::Critical};
+
+    std::vector<CerebrumLux::AIInsight> insights;
+    insights.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::vector<float> cryptofig(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.01f * static_cast<float>(i % 97));
+        insights.emplace_back("Bench_" + std::to_string(i),
+                              "Simüle kod metrikleri karmaşıklığın yükseldiğini gösteriyor.",
+                              "Kod Geliştirme",
+                              "İlgili modülü refaktör edin.",
+                              types[i % 4], urgencies[(i / 4) % 4],
+                              cryptofig,
+                              std::vector<std::string>{"seq_" + std::to_string(i)},
+                              "src/brain/autoencoder.cpp",
+                              "seq_" + std::to_string(i));
+    }
+    return insights;
+}
+
+// Eski GoalManager / MetaEvolutionEngine ödül döngüleriyle aynı mantık.
+float legacy_reward(const std::vector<CerebrumLux::AIInsight>& insights, CerebrumLux::AIGoal goal) {
+    const float critical = static_cast<float>(CerebrumLux::UrgencyLevel::Critical);
+    float reward = 0.0f;
+    for (const auto& insight : insights) {
+        if (goal == CerebrumLux::AIGoal::MaximizeLearning && insight.type == CerebrumLux::InsightType::LearningOpportunity) {
+            reward += static_cast<float>(insight.urgency) / critical * 0.1f;
+        }
+    }
+    for (const auto& insight : insights) {
+        const float urgency_val = static_cast<float>(insight.urgency) / critical;
+        if (insight.urgency == CerebrumLux::UrgencyLevel::Critical) reward += (urgency_val - 1.0f) * 0.5f;
+        else if (insight.urgency == CerebrumLux::UrgencyLevel::High) reward += (urgency_val - 0.5f) * 0.2f;
+    }
+    return reward;
+}
+
+std::vector<CerebrumLux::AIInsight> json_round_trip(const std::vector<CerebrumLux::AIInsight>& produced) {
+    nlohmann::json j = produced;
+    const std::string payload = j.dump();
+    return nlohmann::json::parse(payload).get<std::vector<CerebrumLux::AIInsight>>();
+}
+
+// Arg: döngü başına içgörü sayısı.
+void BM_InsightHandoff_Json(benchmark::State& state) {
+    const auto prototype = make_insights(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        // GoalManager
+        auto goal_insights = json_round_trip(std::vector<CerebrumLux::AIInsight>(prototype));
+        bool security = false;
+        for (const auto& insight : goal_insights) {
+            security |= insight.type == CerebrumLux::InsightType::SecurityAlert && insight.urgency == CerebrumLux::UrgencyLevel::Critical;
+        }
+        benchmark::DoNotOptimize(security);
+        // MetaEvolutionEngine
+        auto meta_insights = json_round_trip(std::vector<CerebrumLux::AIInsight>(prototype));
+        benchmark::DoNotOptimize(legacy_reward(meta_insights, CerebrumLux::AIGoal::MaximizeLearning));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsightHandoff_Json)->Arg(4)->Arg(16)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+void BM_InsightHandoff_Batch(benchmark::State& state) {
+    const auto prototype = make_insights(static_cast<std::size_t>(state.range(0)));
+    CerebrumLux::InsightBatch batch;
+    std::uint64_t tick = 0;
+    for (auto _ : state) {
+        std::vector<CerebrumLux::AIInsight> produced(prototype);
+        batch.begin_tick(++tick);
+        for (auto& insight : produced) batch.push(std::move(insight));
+
+        benchmark::DoNotOptimize(batch.contains(CerebrumLux::InsightType::SecurityAlert, CerebrumLux::UrgencyLevel::Critical));
+        float goal_reward = 0.0f;
+        float insight_reward = 0.0f;
+        CerebrumLux::MetaEvolutionEngine::compute_insight_rewards(batch, CerebrumLux::AIGoal::MaximizeLearning, goal_reward, insight_reward);
+        benchmark::DoNotOptimize(goal_reward + insight_reward);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsightHandoff_Batch)->Arg(4)->Arg(16)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+// GUI/dışa aktarım yolunda kalan tek serileştirme.
+void BM_InsightBatch_ToJson(benchmark::State& state) {
+    auto produced = make_insights(static_cast<std::size_t>(state.range(0)));
+    CerebrumLux::InsightBatch batch;
+    batch.begin_tick(1);
+    for (auto& insight : produced) batch.push(std::move(insight));
+    for (auto _ : state) {
+        auto json = batch.to_json();
+        benchmark::DoNotOptimize(json);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsightBatch_ToJson)->Arg(16)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,258 @@
+// LearningModule (Q-tablosu) ve CryptofigAutoencoder mikro ölçümleri.
+
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/core/logger.h"
+#include "../src/core/enums.h"
+#include "../src/brain/autoencoder.h"
+#include "../src/brain/cryptofig_processor.h"
+#include "../src/brain/intent_analyzer.h"
+#include "../src/brain/intent_learner.h"
+#include "../src/brain/prediction_engine.h"
+#include "../src/communication/ai_insights_engine.h"
+#include "../src/communication/fasttext_wrapper.h"
+#include "../src/communication/natural_language_processor.h"
+#include "../src/communication/suggestion_engine.h"
+#include "../src/crypto/CryptoManager.h"
+#include "../src/data_models/sequence_manager.h"
+#include "../src/learning/KnowledgeBase.h"
+#include "../src/learning/LearningModule.h"
+#include "../src/learning/QValueIndex.h"
+#include "../src/planning_execution/goal_manager.h"
+#include "../src/user/user_profile_manager.h"
+
+namespace {
+
+using CerebrumLux::Bench::random_embedding;
+
+// Embedding üretimini model yüklemeden sabitleyen NLP; testlerdeki DummyNLP ile aynı rolü görür.
+class BenchNLP : public CerebrumLux::NaturalLanguageProcessor {
+public:
+    BenchNLP(CerebrumLux::GoalManager& gm, CerebrumLux::KnowledgeBase& kb) : CerebrumLux::NaturalLanguageProcessor(gm, kb, nullptr) {}
+
+    CerebrumLux::ChatResponse generate_response_text(
+        CerebrumLux::UserIntent, CerebrumLux::AbstractState, CerebrumLux::AIGoal,
+        const CerebrumLux::DynamicSequence&, const std::vector<std::string>&,
+        const CerebrumLux::KnowledgeBase&, const std::vector<float>&
+    ) const override {
+        CerebrumLux::ChatResponse res;
+        res.text = "bench response";
+        return res;
+    }
+
+    std::vector<float> generate_text_embedding_sync(const std::string&, CerebrumLux::Language) const override {
+        return std::vector<float>(256, 0.1f);
+    }
+
+    std::string generate_simple_response(const std::string&) const override {
+        return "bench simple response";
+    }
+};
+
+// LearningModule'ün bağımlılık zinciri; süreç başına bir kez kurulur.
+struct LearningFixture {
+    CerebrumLux::FastTextWrapper fasttext{"dummy.bin"};
+    CerebrumLux::Crypto::CryptoManager crypto;
+    CerebrumLux::IntentAnalyzer analyzer{fasttext};
+    CerebrumLux::SequenceManager sequence_manager;
+    CerebrumLux::SuggestionEngine suggester{analyzer};
+    CerebrumLux::UserProfileManager user_profile_manager;
+    CerebrumLux::IntentLearner learner{analyzer, suggester, user_profile_manager};
+    CerebrumLux::PredictionEngine predictor{analyzer, sequence_manager};
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    CerebrumLux::CryptofigProcessor cryptofig_processor{analyzer, autoencoder};
+    CerebrumLux::AIInsightsEngine insights{analyzer, learner, predictor, autoencoder, cryptofig_processor};
+    CerebrumLux::KnowledgeBase kb{CerebrumLux::Bench::data_dir() + "/learning_kb"};
+    CerebrumLux::GoalManager goal_manager{insights};
+    BenchNLP nlp{goal_manager, kb};
+    CerebrumLux::LearningModule learning{kb, crypto, nlp};
+};
+
+LearningFixture& learning_fixture() {
+    static std::unique_ptr<LearningFixture> fixture;
+    if (!fixture) {
+        fixture = std::make_unique<LearningFixture>();
+        CerebrumLux::Bench::at_teardown([] { fixture.reset(); });
+    }
+    return *fixture;
+}
+
+std::vector<std::vector<float>> make_states(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::vector<float>> states;
+    states.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) states.push_back(random_embedding(rng));
+    return states;
+}
+
+void BM_LearningModule_UpdateQValues(benchmark::State& state) {
+    LearningFixture& f = learning_fixture();
+    const auto states = make_states(static_cast<std::size_t>(state.range(0)), 23);
+    const int action_count = static_cast<int>(CerebrumLux::AIAction::Evaluate) + 1;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& current = states[i % states.size()];
+        const auto& next = states[(i + 1) % states.size()];
+        const auto action = static_cast<CerebrumLux::AIAction>(i % action_count);
+        f.learning.update_q_values(current, action, 0.5f, next);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LearningModule_UpdateQValues)->Arg(64)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+void BM_LearningModule_SaveQTable(benchmark::State& state) {
+    LearningFixture& f = learning_fixture();
+    // Q-tablosunu istenen durum sayısına kadar doldur (önceki ölçümlerden kalan durumlar korunur).
+    const auto states = make_states(static_cast<std::size_t>(state.range(0)), 29);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        f.learning.update_q_values(states[i], CerebrumLux::AIAction::Respond, 1.0f, states[(i + 1) % states.size()]);
+    }
+
+    for (auto _ : state) {
+        f.learning.save_q_table();
+    }
+    state.counters["states"] = static_cast<double>(f.learning.getQTable().q_values.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(f.learning.getQTable().q_values.size()));
+}
+BENCHMARK(BM_LearningModule_SaveQTable)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// Meta-evrim sömürü adımı: durum için en iyi eylemin bulunması.
+// Lmdb: eski yol (LMDB'den JSON okuma + ayrıştırma + argmax). Memory: QValueIndex (argmax önceden hesaplı).
+std::vector<std::vector<float>> populate_q_states(LearningFixture& f, std::size_t count) {
+    const auto states = make_states(count, 47);
+    const int action_count = static_cast<int>(CerebrumLux::AIAction::Evaluate) + 1;
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        for (int a = 1; a < action_count; a += 5) {
+            f.learning.update_q_values(states[i], static_cast<CerebrumLux::AIAction>(a), static_cast<float>((i + a) % 7) * 0.1f, states[i]);
+        }
+    }
+    return states;
+}
+
+void BM_LearningModule_ExploitLookup_Lmdb(benchmark::State& state) {
+    LearningFixture& f = learning_fixture();
+    const auto states = populate_q_states(f, static_cast<std::size_t>(state.range(0)));
+    f.learning.save_q_table();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto key = CerebrumLux::LearningModule::state_key_for(states[i++ % states.size()]);
+        auto json_opt = f.kb.get_swarm_db().get_q_value_json(key);
+        CerebrumLux::AIAction best = CerebrumLux::AIAction::None;
+        float best_q = -std::numeric_limits<float>::max();
+        if (json_opt) {
+            const nlohmann::json action_map = nlohmann::json::parse(*json_opt);
+            for (auto it = action_map.begin(); it != action_map.end(); ++it) {
+                const float q = it.value().get<float>();
+                if (q > best_q) { best_q = q; best = CerebrumLux::string_to_action(it.key()); }
+            }
+        }
+        benchmark::DoNotOptimize(best);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LearningModule_ExploitLookup_Lmdb)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+void BM_LearningModule_ExploitLookup_Memory(benchmark::State& state) {
+    LearningFixture& f = learning_fixture();
+    const auto states = populate_q_states(f, static_cast<std::size_t>(state.range(0)));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto key = CerebrumLux::LearningModule::state_key_for(states[i++ % states.size()]);
+        benchmark::DoNotOptimize(f.learning.getQValueIndex().best_action(key));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LearningModule_ExploitLookup_Memory)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LearningModule_ExploitLookup_Memory)->Arg(1000)->Threads(4)->Unit(benchmark::kMicrosecond);
+
+// QTableWorker yolu: tek bir Q-değeri güncellemesinden sonra snapshot alma + delta sorgusu.
+// Yalnızca değişen parça kopyalanır; Arg: durum sayısı.
+void BM_QValueIndex_SnapshotDelta(benchmark::State& state) {
+    CerebrumLux::QValueIndex index;
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    for (std::size_t i = 0; i < count; ++i) index.set("state_" + std::to_string(i), CerebrumLux::AIAction::Respond, 0.1f);
+    std::uint64_t last_version = index.snapshot()->version();
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        index.set("state_" + std::to_string(i++ % count), CerebrumLux::AIAction::Teach, static_cast<float>(i));
+        const auto snapshot = index.snapshot();
+        benchmark::DoNotOptimize(snapshot->changed_since(last_version));
+        last_version = snapshot->version();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QValueIndex_SnapshotDelta)->Arg(1000)->Arg(16000)->Unit(benchmark::kMicrosecond);
+
+// --- CryptofigAutoencoder ---
+
+void BM_CryptofigAutoencoder_Encode(benchmark::State& state) {
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    std::mt19937 rng(31);
+    const auto input = random_embedding(rng, CerebrumLux::CryptofigAutoencoder::INPUT_DIM);
+    for (auto _ : state) {
+        auto latent = autoencoder.encode(input);
+        benchmark::DoNotOptimize(latent);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CryptofigAutoencoder_Encode);
+
+void BM_CryptofigAutoencoder_AdjustWeightsOnError(benchmark::State& state) {
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    std::mt19937 rng(37);
+    const auto input = random_embedding(rng, CerebrumLux::CryptofigAutoencoder::INPUT_DIM);
+    for (auto _ : state) {
+        autoencoder.adjust_weights_on_error(input, 0.01f);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CryptofigAutoencoder_AdjustWeightsOnError)->Unit(benchmark::kMicrosecond);
+
+CerebrumLux::CryptofigAutoencoder::SampleMatrix random_sample_matrix(std::mt19937& rng, int rows) {
+    CerebrumLux::CryptofigAutoencoder::SampleMatrix samples(rows, CerebrumLux::CryptofigAutoencoder::INPUT_DIM);
+    for (int r = 0; r < rows; ++r) {
+        const auto v = random_embedding(rng, CerebrumLux::CryptofigAutoencoder::INPUT_DIM);
+        for (int c = 0; c < CerebrumLux::CryptofigAutoencoder::INPUT_DIM; ++c) samples(r, c) = v[static_cast<std::size_t>(c)];
+    }
+    return samples;
+}
+
+// Arg: örnek sayısı. items = örnek.
+void BM_CryptofigAutoencoder_EncodeBatch(benchmark::State& state) {
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    std::mt19937 rng(41);
+    const auto samples = random_sample_matrix(rng, static_cast<int>(state.range(0)));
+    CerebrumLux::CryptofigAutoencoder::LatentMatrix latent;
+    for (auto _ : state) {
+        autoencoder.encode_batch(samples, latent);
+        benchmark::DoNotOptimize(latent.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CryptofigAutoencoder_EncodeBatch)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+// Args: {örnek sayısı, mini-batch boyutu}. Tek örnekli adjust_weights_on_error ile örnek başına süre karşılaştırılabilir.
+void BM_CryptofigAutoencoder_TrainBatch(benchmark::State& state) {
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    std::mt19937 rng(43);
+    const auto samples = random_sample_matrix(rng, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(autoencoder.train_batch(samples, 0.01f, static_cast<std::size_t>(state.range(1))));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CryptofigAutoencoder_TrainBatch)->Args({1024, 1})->Args({1024, 32})->Args({1024, 256})->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,93 @@
+// cerebrumlux_bench: sıcak yollar için Google Benchmark tabanlı mikro ölçüm hedefi.
+//
+// Kullanım:
+//   cerebrumlux_bench [--max_vectors=N] [Google Benchmark bayrakları]
+//
+// --benchmark_out verilmezse sonuçlar ayrıca "cerebrumlux_bench.json" dosyasına JSON olarak yazılır;
+// böylece her çalıştırma zaman içinde karşılaştırılabilecek makine okunur bir kayıt bırakır.
+// --max_vectors (varsayılan 100000) vektör veritabanı / HNSW fikstürlerinin üst boyutudur;
+// 10^6'lık ölçümler için --max_vectors=1000000 verin (doldurma birkaç dakika sürer).
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/core/logger.h"
+
+namespace CerebrumLux {
+namespace Bench {
+
+namespace {
+std::size_t g_max_vectors = 100000;
+std::vector<std::function<void()>>& teardown_list() {
+    static std::vector<std::function<void()>> list;
+    return list;
+}
+}
+
+const std::string& data_dir() {
+    static const std::string dir = [] {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "cerebrumlux_bench_data";
+        std::filesystem::create_directories(path);
+        return path.string();
+    }();
+    return dir;
+}
+
+std::size_t max_vectors() { return g_max_vectors; }
+void set_max_vectors(std::size_t value) { g_max_vectors = value; }
+
+void at_teardown(std::function<void()> fn) { teardown_list().push_back(std::move(fn)); }
+
+void run_teardown() {
+    auto& list = teardown_list();
+    for (auto it = list.rbegin(); it != list.rend(); ++it) (*it)();
+    list.clear();
+}
+
+} // namespace Bench
+} // namespace CerebrumLux
+
+int main(int argc, char* argv[]) {
+    // LearningModule zamanlayıcıları ve Logger sinyalleri için bir Qt çekirdek uygulaması gerekir.
+    QCoreApplication app(argc, argv);
+
+    // Ölçülen yolların içindeki INFO/DEBUG logları dosyaya yazılmasın; yalnızca uyarılar loglanır.
+    CerebrumLux::Logger::getInstance().init(CerebrumLux::LogLevel::WARNING, "cerebrumlux_bench_log.txt", "BENCH");
+
+    std::vector<char*> args;
+    bool has_out = false;
+    for (int i = 0; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--max_vectors=", 14) == 0) {
+            CerebrumLux::Bench::set_max_vectors(std::strtoull(argv[i] + 14, nullptr, 10));
+            continue;
+        }
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) has_out = true;
+        args.push_back(argv[i]);
+    }
+    std::string out_arg = "--benchmark_out=cerebrumlux_bench.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(&out_arg[0]);
+        args.push_back(&format_arg[0]);
+    }
+
+    int bench_argc = static_cast<int>(args.size());
+    benchmark::Initialize(&bench_argc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(bench_argc, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    CerebrumLux::Bench::run_teardown();
+
+    std::error_code ec;
+    std::filesystem::remove_all(CerebrumLux::Bench::data_dir(), ec);
+    CerebrumLux::Logger::getInstance().shutdown();
+    return 0;
+}
@@ -0,0 +1,56 @@
+// MetricsRegistry sıcak yol maliyeti: enstrümantasyon noktaları nanosaniye mertebesinde kalmalı.
+
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/core/metrics.h"
+
+namespace {
+
+using CerebrumLux::Metrics::MetricsRegistry;
+
+void BM_Metrics_CounterInc(benchmark::State& state) {
+    static auto& counter = MetricsRegistry::instance().counter("cerebrumlux_bench_counter_total", "bench");
+    for (auto _ : state) {
+        counter.inc();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Metrics_CounterInc);
+BENCHMARK(BM_Metrics_CounterInc)->Threads(4);
+
+void BM_Metrics_GaugeAdd(benchmark::State& state) {
+    static auto& gauge = MetricsRegistry::instance().gauge("cerebrumlux_bench_gauge", "bench");
+    for (auto _ : state) {
+        gauge.add(1.0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Metrics_GaugeAdd);
+BENCHMARK(BM_Metrics_GaugeAdd)->Threads(4);
+
+void BM_Metrics_HistogramRecord(benchmark::State& state) {
+    static auto& histogram = MetricsRegistry::instance().histogram("cerebrumlux_bench_histogram_seconds", "bench");
+    std::uint64_t value = 1;
+    for (auto _ : state) {
+        histogram.record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL; // Farklı kovalara dağıt
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Metrics_HistogramRecord);
+BENCHMARK(BM_Metrics_HistogramRecord)->Threads(4);
+
+// ScopedTimer: iki steady_clock okuması + record.
+void BM_Metrics_ScopedTimer(benchmark::State& state) {
+    static auto& histogram = MetricsRegistry::instance().histogram("cerebrumlux_bench_scoped_seconds", "bench");
+    for (auto _ : state) {
+        CerebrumLux::Metrics::ScopedTimer timer(histogram);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Metrics_ScopedTimer);
+
+} // namespace
@@ -0,0 +1,122 @@
+// ShardedSwarmVectorDB: aynı sentetik korpus üzerinde 1 parça ile N parçanın karşılaştırması.
+// Argümanlar {vektör sayısı, parça sayısı}; 1 parçalı satır tekil SwarmVectorDB'nin taban çizgisidir
+// (aynı sarmalayıcıdan geçer, yani fark yalnızca paralel yayılım ve birleştirmeden gelir).
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/swarm_vectordb/ShardedVectorDB.h"
+
+namespace {
+
+using CerebrumLux::Bench::random_embedding;
+using CerebrumLux::Bench::make_cryptofig_vector;
+using CerebrumLux::SwarmVectorDB::ShardedSwarmVectorDB;
+
+// Doldurma bu boyutta yığınlarla yapılır (her parça yığın başına tek transaction açar).
+constexpr std::size_t kFillChunk = 10000;
+// Toplu yazma ölçümünün kullanabileceği parça başına HNSW kapasite payı.
+constexpr std::size_t kStoreHeadroom = 100000;
+
+struct ShardedFixture {
+    std::unique_ptr<ShardedSwarmVectorDB> db;
+    std::size_t stored_extra = 0;
+};
+
+ShardedFixture* sharded_fixture(std::size_t n, std::size_t shards) {
+    static std::map<std::pair<std::size_t, std::size_t>, std::unique_ptr<ShardedFixture>> cache;
+    auto it = cache.find({n, shards});
+    if (it != cache.end()) return it->second.get();
+
+    if (cache.empty()) {
+        CerebrumLux::Bench::at_teardown([] { cache.clear(); });
+    }
+
+    auto fixture = std::make_unique<ShardedFixture>();
+    const std::string path = CerebrumLux::Bench::data_dir() + "/sharded_" + std::to_string(n) + "_" + std::to_string(shards);
+    // Hash bölümleme parçaları ~n/shards civarında tutar; %10 pay dağılımdaki sapmayı karşılar.
+    const std::size_t per_shard = n / shards + n / (10 * shards) + 1000 + kStoreHeadroom;
+    fixture->db = std::make_unique<ShardedSwarmVectorDB>(path, shards, CerebrumLux::SwarmVectorDB::ShardPartition::Hash, per_shard);
+    if (!fixture->db->open()) return nullptr;
+
+    // Korpus parça sayısından bağımsızdır: aynı seed, aynı ID'ler.
+    std::mt19937 rng(42);
+    std::vector<CerebrumLux::SwarmVectorDB::CryptofigVector> chunk;
+    chunk.reserve(kFillChunk);
+    for (std::size_t i = 0; i < n; ++i) {
+        chunk.push_back(make_cryptofig_vector("bench_vec_" + std::to_string(i), random_embedding(rng)));
+        if (chunk.size() == kFillChunk || i + 1 == n) {
+            if (!fixture->db->store_vectors_batch(chunk)) return nullptr;
+            chunk.clear();
+        }
+    }
+    return cache.emplace(std::make_pair(n, shards), std::move(fixture)).first->second.get();
+}
+
+ShardedFixture* acquire_sharded_db(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    if (n > CerebrumLux::Bench::max_vectors()) {
+        state.SkipWithError("--max_vectors sinirini asiyor");
+        return nullptr;
+    }
+    ShardedFixture* fixture = sharded_fixture(n, static_cast<std::size_t>(state.range(1)));
+    if (!fixture) state.SkipWithError("ShardedSwarmVectorDB fikstürü kurulamadi");
+    return fixture;
+}
+
+void BM_ShardedVectorDB_SearchSimilar(benchmark::State& state) {
+    ShardedFixture* fixture = acquire_sharded_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng(13);
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 256; ++i) queries.push_back(random_embedding(rng));
+
+    std::size_t q = 0;
+    for (auto _ : state) {
+        auto ids = fixture->db->search_similar_vectors(queries[q++ & 255], 10);
+        benchmark::DoNotOptimize(ids);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedVectorDB_SearchSimilar)
+    ->Args({100000, 1})->Args({100000, 4})
+    ->Args({1000000, 1})->Args({1000000, 4})->Args({1000000, 8})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_ShardedVectorDB_StoreBatch(benchmark::State& state) {
+    ShardedFixture* fixture = acquire_sharded_db(state);
+    if (!fixture) return;
+
+    constexpr std::size_t kBatch = 1000;
+    std::mt19937 rng(7 + fixture->stored_extra);
+    for (auto _ : state) {
+        // Parça başına pay, en kötü durumda tüm yığının tek parçaya düşmesine karşı toplam üzerinden korunur.
+        if (fixture->stored_extra + kBatch > kStoreHeadroom) {
+            state.SkipWithError("HNSW kapasite payi doldu");
+            break;
+        }
+        state.PauseTiming();
+        std::vector<CerebrumLux::SwarmVectorDB::CryptofigVector> batch;
+        batch.reserve(kBatch);
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            batch.push_back(make_cryptofig_vector("bench_store_" + std::to_string(fixture->stored_extra++), random_embedding(rng)));
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(fixture->db->store_vectors_batch(batch));
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+BENCHMARK(BM_ShardedVectorDB_StoreBatch)
+    ->Args({100000, 1})->Args({100000, 4})
+    ->Args({1000000, 1})->Args({1000000, 4})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
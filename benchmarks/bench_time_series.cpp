@@ -0,0 +1,67 @@
+// GraphPanel çizim maliyeti: TimeSeriesStore::view() piksel bütçesine indirger, bu yüzden süre oturum
+// uzunluğundan (nokta sayısından) bağımsız kalmalıdır. Karşılaştırma için tüm noktaların kopyalandığı eski yol.
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../src/core/time_series.h"
+
+namespace {
+
+constexpr std::size_t kPixelBudget = 1200;
+
+CerebrumLux::TimeSeriesStore make_store(std::size_t count) {
+    CerebrumLux::TimeSeriesStore store;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = static_cast<double>(i) * 100.0; // 100 ms aralıklı örnekler
+        store.append(x, 0.5 + 0.4 * std::sin(static_cast<double>(i) * 0.001) + ((i % 977) == 0 ? 0.09 : 0.0));
+    }
+    return store;
+}
+
+// Arg: oturumdaki nokta sayısı.
+void BM_TimeSeries_FullCopy(benchmark::State& state) {
+    const auto store = make_store(static_cast<std::size_t>(state.range(0)));
+    const auto all = store.view_all(store.size());
+    for (auto _ : state) {
+        std::vector<CerebrumLux::SeriesPoint> copy(all);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimeSeries_FullCopy)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_TimeSeries_ViewAll(benchmark::State& state) {
+    const auto store = make_store(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto points = store.view_all(kPixelBudget);
+        benchmark::DoNotOptimize(points.data());
+    }
+}
+BENCHMARK(BM_TimeSeries_ViewAll)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+// Yakınlaştırılmış görünüm: aralığın %10'u.
+void BM_TimeSeries_ViewZoomed(benchmark::State& state) {
+    const auto store = make_store(static_cast<std::size_t>(state.range(0)));
+    const double span = store.last_x() - store.first_x();
+    for (auto _ : state) {
+        auto points = store.view(store.first_x() + span * 0.45, store.first_x() + span * 0.55, kPixelBudget);
+        benchmark::DoNotOptimize(points.data());
+    }
+}
+BENCHMARK(BM_TimeSeries_ViewZoomed)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_TimeSeries_Append(benchmark::State& state) {
+    CerebrumLux::TimeSeriesStore store;
+    double x = 0.0;
+    for (auto _ : state) {
+        store.append(x, std::sin(x));
+        x += 1.0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimeSeries_Append);
+
+} // namespace
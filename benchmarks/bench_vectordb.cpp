@@ -0,0 +1,213 @@
+// SwarmVectorDB (LMDB + HNSW) ve HNSWIndex mikro ölçümleri.
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "../src/swarm_vectordb/VectorDB.h"
+#include "../src/hnswlib_wrapper.h"
+
+namespace {
+
+using CerebrumLux::Bench::random_embedding;
+using CerebrumLux::Bench::make_cryptofig_vector;
+
+// store_vector ölçümünün yeni eklemeler için kullanabileceği HNSW kapasite payı.
+constexpr std::size_t kStoreHeadroom = 200000;
+
+struct VectorDbFixture {
+    std::unique_ptr<CerebrumLux::SwarmVectorDB::SwarmVectorDB> db;
+    std::vector<std::string> ids;
+    std::size_t stored_extra = 0;
+};
+
+// Her boyut için veritabanı süreç başına bir kez doldurulur ve tüm ölçümlerce paylaşılır.
+// Çok iş parçacıklı ölçümlerde her iş parçacığı buraya aynı anda girer; ilk gelen doldurur.
+VectorDbFixture* vector_db_fixture(std::size_t n) {
+    static std::mutex cache_mutex;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    static std::map<std::size_t, std::unique_ptr<VectorDbFixture>> cache;
+    auto it = cache.find(n);
+    if (it != cache.end()) return it->second.get();
+
+    if (cache.empty()) {
+        CerebrumLux::Bench::at_teardown([] { cache.clear(); });
+    }
+
+    auto fixture = std::make_unique<VectorDbFixture>();
+    const std::string path = CerebrumLux::Bench::data_dir() + "/vectordb_" + std::to_string(n);
+    fixture->db = std::make_unique<CerebrumLux::SwarmVectorDB::SwarmVectorDB>(path, n + kStoreHeadroom);
+    if (!fixture->db->open()) return nullptr;
+
+    std::mt19937 rng(42);
+    fixture->ids.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string id = "bench_vec_" + std::to_string(i);
+        if (!fixture->db->store_vector(make_cryptofig_vector(id, random_embedding(rng)))) return nullptr;
+        fixture->ids.push_back(std::move(id));
+    }
+    return cache.emplace(n, std::move(fixture)).first->second.get();
+}
+
+// Boyut argümanı --max_vectors sınırını aşıyorsa veya fikstür kurulamadıysa ölçümü atlar.
+VectorDbFixture* acquire_vector_db(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    if (n > CerebrumLux::Bench::max_vectors()) {
+        state.SkipWithError("--max_vectors sinirini asiyor");
+        return nullptr;
+    }
+    VectorDbFixture* fixture = vector_db_fixture(n);
+    if (!fixture) state.SkipWithError("SwarmVectorDB fikstürü kurulamadi");
+    return fixture;
+}
+
+void BM_SwarmVectorDB_StoreVector(benchmark::State& state) {
+    VectorDbFixture* fixture = acquire_vector_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng(7 + fixture->stored_extra);
+    for (auto _ : state) {
+        if (fixture->stored_extra >= kStoreHeadroom) {
+            state.SkipWithError("HNSW kapasite payi doldu");
+            break;
+        }
+        state.PauseTiming();
+        const auto cv = make_cryptofig_vector("bench_store_" + std::to_string(fixture->stored_extra++), random_embedding(rng));
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(fixture->db->store_vector(cv));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwarmVectorDB_StoreVector)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_SwarmVectorDB_GetVector(benchmark::State& state) {
+    VectorDbFixture* fixture = acquire_vector_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<std::size_t> pick(0, fixture->ids.size() - 1);
+    for (auto _ : state) {
+        auto cv = fixture->db->get_vector(fixture->ids[pick(rng)]);
+        benchmark::DoNotOptimize(cv);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwarmVectorDB_GetVector)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+void BM_SwarmVectorDB_SearchSimilar(benchmark::State& state) {
+    VectorDbFixture* fixture = acquire_vector_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng(13);
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 256; ++i) queries.push_back(random_embedding(rng));
+
+    std::size_t q = 0;
+    for (auto _ : state) {
+        auto ids = fixture->db->search_similar_vectors(queries[q++ & 255], static_cast<int>(state.range(1)));
+        benchmark::DoNotOptimize(ids);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwarmVectorDB_SearchSimilar)
+    ->Args({10000, 5})->Args({100000, 5})->Args({1000000, 5})
+    ->Args({100000, 50})
+    ->Unit(benchmark::kMicrosecond);
+
+// --- Eşzamanlı okuma ---
+// Okuma transaction'ları havuzdan kiralanır ve okumalar yazar kilidini almaz; iş parçacığı sayısıyla ölçeklenmeyi
+// gösterir (UseRealTime: ölçüm duvar saatiyle, items/s tüm iş parçacıklarının toplamıdır).
+
+// Her iş parçacığı farklı bir diziyle çalışsın diye tohum iş parçacığı kimliğinden türetilir.
+std::mt19937 thread_rng(unsigned salt) {
+    return std::mt19937(static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id())) ^ salt);
+}
+
+void BM_SwarmVectorDB_ConcurrentGet(benchmark::State& state) {
+    VectorDbFixture* fixture = acquire_vector_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng = thread_rng(11);
+    std::uniform_int_distribution<std::size_t> pick(0, fixture->ids.size() - 1);
+    for (auto _ : state) {
+        auto cv = fixture->db->get_vector(fixture->ids[pick(rng)]);
+        benchmark::DoNotOptimize(cv);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwarmVectorDB_ConcurrentGet)
+    ->Arg(100000)->Threads(1)->Threads(2)->Threads(4)->Threads(8)
+    ->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+void BM_SwarmVectorDB_ConcurrentSearch(benchmark::State& state) {
+    VectorDbFixture* fixture = acquire_vector_db(state);
+    if (!fixture) return;
+
+    std::mt19937 rng = thread_rng(13);
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 256; ++i) queries.push_back(random_embedding(rng));
+
+    std::size_t q = 0;
+    for (auto _ : state) {
+        auto ids = fixture->db->search_similar_vectors(queries[q++ & 255], 10);
+        benchmark::DoNotOptimize(ids);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwarmVectorDB_ConcurrentSearch)
+    ->Arg(100000)->Threads(1)->Threads(2)->Threads(4)->Threads(8)
+    ->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// --- HNSWIndex (LMDB olmadan, yalnızca indeks) ---
+
+CerebrumLux::HNSW::HNSWIndex* hnsw_fixture(std::size_t n) {
+    static std::map<std::size_t, std::unique_ptr<CerebrumLux::HNSW::HNSWIndex>> cache;
+    auto it = cache.find(n);
+    if (it != cache.end()) return it->second.get();
+
+    if (cache.empty()) {
+        CerebrumLux::Bench::at_teardown([] { cache.clear(); });
+    }
+
+    auto index = std::make_unique<CerebrumLux::HNSW::HNSWIndex>(256, n);
+    index->create_new_index();
+    std::mt19937 rng(42);
+    for (std::size_t i = 0; i < n; ++i) {
+        index->add_item(random_embedding(rng), static_cast<hnswlib::labeltype>(i));
+    }
+    return cache.emplace(n, std::move(index)).first->second.get();
+}
+
+void BM_HNSWIndex_SearchKnn(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    if (n > CerebrumLux::Bench::max_vectors()) {
+        state.SkipWithError("--max_vectors sinirini asiyor");
+        return;
+    }
+    CerebrumLux::HNSW::HNSWIndex* index = hnsw_fixture(n);
+
+    std::mt19937 rng(17);
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 256; ++i) queries.push_back(random_embedding(rng));
+
+    std::size_t q = 0;
+    for (auto _ : state) {
+        auto labels = index->search_knn(queries[q++ & 255], static_cast<int>(state.range(1)));
+        benchmark::DoNotOptimize(labels);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HNSWIndex_SearchKnn)
+    ->Args({10000, 10})->Args({100000, 10})->Args({1000000, 10})
+    ->Args({100000, 100})
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -9,6 +9,24 @@ void LlamaAdapter::set_inference_fn(InferFn fn) {
     infer_fn = fn;
 }
 
+void LlamaAdapter::set_structured_inference_fn(StructuredInferFn fn) {
+    std::lock_guard lk(mtx);
+    structured_fn = fn;
+}
+
+bool LlamaAdapter::has_structured_inference() {
+    std::lock_guard lk(mtx);
+    return static_cast<bool>(structured_fn);
+}
+
+std::string LlamaAdapter::infer_structured(const std::string &prompt, const std::string &json_schema) {
+    {
+        std::lock_guard lk(mtx);
+        if (structured_fn) return structured_fn(prompt, json_schema);
+    }
+    return infer_sync(prompt);
+}
+
 std::string LlamaAdapter::infer_sync(const std::string &prompt) {
     std::lock_guard lk(mtx);
     if (!infer_fn) throw std::runtime_error("LlamaAdapter::infer_fn not set");
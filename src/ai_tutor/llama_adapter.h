@@ -21,18 +21,28 @@ struct LlamaInferenceConfig {
 class LlamaAdapter {
 public:
     using InferFn = std::function<std::string(const std::string& prompt)>;
+    // Schema-constrained inference: the output must be a JSON document matching json_schema.
+    using StructuredInferFn = std::function<std::string(const std::string& prompt, const std::string& json_schema)>;
 
     // Set the sync inference function (e.g. wrapper around llama.cpp)
     static void set_inference_fn(InferFn fn);
+    // Set the constrained inference function (e.g. LLMEngine::generate with a cached JsonGrammar)
+    static void set_structured_inference_fn(StructuredInferFn fn);
 
     // Synchronous wrapper (returns model string result)
     static std::string infer_sync(const std::string &prompt);
 
+    // Returns JSON matching json_schema when a structured function is bound; otherwise falls back to infer_sync
+    // and the caller has to validate the text itself.
+    static std::string infer_structured(const std::string &prompt, const std::string &json_schema);
+    static bool has_structured_inference();
+
     // Asynchronous inference with config
     std::string infer(const std::string& prompt, const LlamaInferenceConfig& cfg);
 
 private:
     static inline InferFn infer_fn = nullptr;
+    static inline StructuredInferFn structured_fn = nullptr;
     static inline std::mutex mtx;
 };
 
@@ -9,6 +9,19 @@ namespace CerebrumLux { // Add CerebrumLux namespace
 
 using json = nlohmann::json;
 
+const std::string& TeacherEvaluator::evaluation_schema() {
+    static const std::string schema = R"({
+        "type": "object",
+        "properties": {
+            "score_cxx": { "type": "integer", "minimum": 0, "maximum": 100 },
+            "score_conversation": { "type": "integer", "minimum": 0, "maximum": 100 },
+            "score_overall": { "type": "integer", "minimum": 0, "maximum": 100 },
+            "feedback": { "type": "string", "maxLength": 240 }
+        }
+    })";
+    return schema;
+}
+
 std::string TeacherEvaluator::build_evaluation_prompt(
     const std::string &lesson_context,
     const std::string &student_response
@@ -31,12 +44,13 @@ std::optional<EvaluationResult> TeacherEvaluator::evaluate_response(
     std::string prompt = build_evaluation_prompt(lesson_context, student_response);
     std::string raw;
     try {
-        raw = CerebrumLux::LlamaAdapter::infer_sync(prompt);
+        raw = CerebrumLux::LlamaAdapter::infer_structured(prompt, evaluation_schema());
     } catch (const std::exception &ex) {
         std::cerr<<"TeacherEvaluator: inference error: "<<ex.what()<<"\n";
         return std::nullopt;
     }
-    // try parse JSON in raw (robust parse: find first { ... })
+    // Constrained output is the JSON document itself (possibly with leading whitespace). The substring search
+    // below only matters for an unconstrained fallback binding.
     auto first = raw.find('{');
     if (first == std::string::npos) { // fallback: return as feedback
         EvaluationResult r; r.feedback = raw; r.raw_json = raw; return r;
@@ -52,12 +52,16 @@ public:
 class TeacherEvaluator {
 public:
     // Ask teacher LLM to evaluate; returns EvaluationResult on success.
-    // This calls CerebrumLux::LlamaAdapter::infer_sync internally.
+    // This calls CerebrumLux::LlamaAdapter::infer_structured with evaluation_schema() internally.
     static std::optional<EvaluationResult> evaluate_response(
         const std::string &lesson_context,
         const std::string &student_response
     );
 
+    // JSON schema of the evaluation output. Inference is constrained to it, so the reply is always a complete,
+    // parseable document and generation stops at its closing brace.
+    static const std::string& evaluation_schema();
+
     // Utility: constructs the JSON-scoring prompt (human-readable)
     static std::string build_evaluation_prompt(
         const std::string &lesson_context,
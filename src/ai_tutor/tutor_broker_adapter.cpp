@@ -3,10 +3,9 @@
 #include "teacher_ai.h"
 #include "student_ai.h"
 #include "llama_adapter.h"
+#include "core/keyword_matcher.h"
+#include "core/task_scheduler.h"
 #include <iostream>
-#include <condition_variable>
-#include <chrono> // Required for std::chrono
-#include <algorithm> // Required for std::transform
 #include <sstream> // Required for std::ostringstream
 
 // Ensure CerebrumLux types are available
@@ -15,7 +14,10 @@
 #include "teacher_ai.h" // For CerebrumLux::TeacherAI
 #include "llama_adapter.h"  // For CerebrumLux::LlamaAdapter
 
-TutorBrokerAdapter::TutorBrokerAdapter(): running(false) {}
+TutorBrokerAdapter::TutorBrokerAdapter(): TutorBrokerAdapter(0) {}
+
+TutorBrokerAdapter::TutorBrokerAdapter(std::size_t worker_count, std::size_t capacity)
+    : workers(worker_count), lane_capacity(capacity) {}
 
 TutorBrokerAdapter::~TutorBrokerAdapter(){ stop(); }
 
@@ -23,61 +25,48 @@ void TutorBrokerAdapter::set_gui_callback(std::function<void(const std::string&,
     gui_cb = cb;
 }
 
-void TutorBrokerAdapter::push_user_input(const std::string &user, const std::string &text) {
-    {
-        std::lock_guard lk(q_mtx);
-        queue.push_back({ "gui", "user_input", user, text });
+bool TutorBrokerAdapter::push_user_input(const std::string &user, const std::string &text) {
+    BrokerMsg m{ "gui", "user_input", user, text, std::hash<std::string>{}(user) };
+    // start workers on first use; a worker wakes as soon as its lane gets a message (no polling)
+    if (!pool.running()) start();
+    // Called from the GUI thread: a full lane is reported instead of blocking the event loop.
+    if (pool.try_post(m.session, m)) return true;
+    if (gui_cb) {
+        gui_cb("broker", "error", pool.running() ? std::string("Broker busy: too many pending messages for this user")
+                                                 : std::string("Broker stopped, message dropped"));
     }
-    // notify worker by starting thread if not running
-    if (!running) start();
+    return false;
 }
 
 void TutorBrokerAdapter::start() {
-    if (running) return;
-    running = true;
-    worker = std::thread(&TutorBrokerAdapter::main_loop, this);
+    pool.start(workers, lane_capacity, [this](std::size_t, BrokerMsg &m) { dispatch(m); });
 }
 
 void TutorBrokerAdapter::stop() {
-    if (!running) return;
-    running = false;
-    if (worker.joinable()) worker.join();
+    pool.stop();
 }
 
-void TutorBrokerAdapter::main_loop() {
-    CerebrumLux::TeacherAI teacher; 
-    CerebrumLux::StudentAI student; 
-    while (running) {
-        BrokerMsg m;
-        {
-            std::lock_guard lk(q_mtx);
-            if (queue.empty()) {
-                // idle sleep
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                continue;
-            }
-            m = queue.front();
-            queue.pop_front();
-        }
-        try {
-            if (m.type == "user_input") handle_user(m);
-            else {
-                // handle other types...
-            }
-        } catch (const std::exception &ex) {
-            std::cerr<<"Broker main loop exception: "<<ex.what()<<"\n";
+void TutorBrokerAdapter::dispatch(BrokerMsg &m) {
+    try {
+        if (m.type == "user_input") handle_user(m);
+        else {
+            // handle other types...
         }
+    } catch (const std::exception &ex) {
+        std::cerr<<"Broker main loop exception: "<<ex.what()<<"\n";
     }
 }
 
 std::string TutorBrokerAdapter::decide_route(const std::string &text) {
-    // lightweight: check for technical tokens
-    std::string s = text;
-    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
-    if (s.find("class ") != std::string::npos || s.find("std::") != std::string::npos || s.find("#include") != std::string::npos) return "student";
-    if (s.find("teach") != std::string::npos || s.find("lesson") != std::string::npos) return "teacher";
-    if (s.find("hello") != std::string::npos || s.find("merhaba") != std::string::npos) return "chat";
-    return "student";
+    // lightweight: check for technical tokens. Rule ID = priority (lowest matching wins), one case-folded pass.
+    static const char *const kRoutes[] = {"student", "teacher", "chat"};
+    static const CerebrumLux::KeywordMatcher matcher({
+        {"class ", 0}, {"std::", 0}, {"#include", 0},
+        {"teach", 1}, {"lesson", 1},
+        {"hello", 2}, {"merhaba", 2},
+    });
+    const std::optional<int> route = matcher.first_match(text);
+    return route ? kRoutes[*route] : "student";
 }
 
 void TutorBrokerAdapter::handle_user(const BrokerMsg &m) {
@@ -88,17 +77,21 @@ void TutorBrokerAdapter::handle_user(const BrokerMsg &m) {
 
         if (gui_cb) gui_cb("student", "response", resp);
 
-        std::thread([m, resp, this]() {
-            std::string context = "Auto lesson context (student route)";
-            auto opt = CerebrumLux::TeacherEvaluator::evaluate_response(context, resp);
-            if (opt) {
-                std::ostringstream out;
-                out << "Score overall: " << opt->score_overall << " - feedback: " << opt->feedback;
-                if (gui_cb) gui_cb("teacher", "evaluation", out.str());
-            } else {
-                if (gui_cb) gui_cb("teacher", "evaluation", std::string("Evaluation failed"));
-            }
-        }).detach();
+        // Evaluation runs on the shared scheduler instead of a detached thread per message. The callback is
+        // captured by value so a pending evaluation never touches a destroyed adapter.
+        CerebrumLux::TaskScheduler::instance().submit(CerebrumLux::TaskClass::BackgroundLearning,
+            [resp, cb = gui_cb](const CerebrumLux::CancellationToken& token) {
+                std::string context = "Auto lesson context (student route)";
+                auto opt = CerebrumLux::TeacherEvaluator::evaluate_response(context, resp);
+                if (token.cancelled() || !cb) return;
+                if (opt) {
+                    std::ostringstream out;
+                    out << "Score overall: " << opt->score_overall << " - feedback: " << opt->feedback;
+                    cb("teacher", "evaluation", out.str());
+                } else {
+                    cb("teacher", "evaluation", std::string("Evaluation failed"));
+                }
+            });
 
     } else if (route == "teacher") {
         CerebrumLux::TeacherAI teacher; 
@@ -7,45 +7,46 @@
 
 #include "curriculum.h"
 #include "teacher_evaluator.h"
+#include "core/session_worker_pool.h"
 #include <functional>
 #include <string>
-#include <atomic>
-#include <thread> // Required for std::thread
-#include <mutex> // Required for std::mutex
-#include <deque> // Required for std::deque
+#include <cstdint>
 
 struct BrokerMsg {
     std::string from;
     std::string type; // user_input/lesson_request/...
     std::string user;
     std::string text;
+    std::uint64_t session = 0; // hash of user; selects the worker lane
 };
 
 class TutorBrokerAdapter {
 public:
     TutorBrokerAdapter();
+    // workers 0: hardware concurrency. Messages of one user are handled in order by the same worker.
+    explicit TutorBrokerAdapter(std::size_t workers, std::size_t lane_capacity = 256);
     ~TutorBrokerAdapter();
 
     // set optional callbacks
     void set_gui_callback(std::function<void(const std::string& from, const std::string& type, const std::string& payload)> cb);
 
-    // push user input (from GUI)
-    void push_user_input(const std::string &user, const std::string &text);
+    // push user input (from GUI); starts the workers on first use. Never blocks: if the user's lane is full the
+    // message is rejected, the GUI callback gets a "busy" error and false is returned.
+    bool push_user_input(const std::string &user, const std::string &text);
 
     // start/stop loop
     void start();
     void stop();
 
 private:
-    void main_loop();
+    void dispatch(BrokerMsg &m);
     void handle_user(const BrokerMsg &m);
     std::string decide_route(const std::string &text); // simple heuristics (or use FastText externally)
 
     std::function<void(const std::string& from, const std::string& type, const std::string& payload)> gui_cb;
-    std::atomic<bool> running;
-    std::thread worker;
-    std::mutex q_mtx;
-    std::deque<BrokerMsg> queue;
+    std::size_t workers;
+    std::size_t lane_capacity;
+    CerebrumLux::SessionWorkerPool<BrokerMsg> pool;
 };
 
 #endif // TUTOR_BROKER_ADAPTER_H
@@ -1,26 +1,41 @@
 // src/ai_tutor/tutor_broker_router.cpp
 #include "tutor_broker_router.h"
+#include "core/keyword_matcher.h"
+#include "core/metrics.h"
 #include <iostream>
+#include <atomic>
 #include <chrono>
 #include <algorithm>
 #include <cctype>
+#include <thread>
 
 using namespace std::chrono_literals;
 
 // ---------------- IntentRouter Implementation ----------------
 
-bool IntentRouter::contains_any(const std::string &s, const std::initializer_list<std::string>& keys){
-    for (const auto &k: keys) if (s.find(k) != std::string::npos) return true;
-    return false;
+namespace {
+
+// Fallback heuristic keyword groups. route() scans the message once and then checks the groups in priority order.
+enum RouteRule : int { kRouteStudent = 0, kRouteTeacher, kRouteGreeting, kRouteTechnical };
+
+const CerebrumLux::KeywordMatcher& route_matcher() {
+    static const CerebrumLux::KeywordMatcher matcher([] {
+        std::vector<CerebrumLux::KeywordMatcher::Rule> rules;
+        for (const char* k : {"compile","build","segmentation","memory","pointer","template"}) rules.push_back({k, kRouteStudent});
+        for (const char* k : {"teach","curriculum","lesson","explain","how to"}) rules.push_back({k, kRouteTeacher});
+        for (const char* k : {"hi","hello","merhaba","how are you","selam"}) rules.push_back({k, kRouteGreeting});
+        for (const char* k : {"class ","int ","std::","template","->","::","#include"}) rules.push_back({k, kRouteTechnical});
+        return rules;
+    }());
+    return matcher;
 }
 
-std::string IntentRouter::lower_copy(const std::string &s) {
-    std::string r = s;
-    std::transform(r.begin(), r.end(), r.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-    return r;
+bool has_rule(const std::vector<int> &hits, RouteRule rule) {
+    return std::binary_search(hits.begin(), hits.end(), static_cast<int>(rule));
 }
 
+} // namespace
+
 std::string IntentRouter::route(const std::string &user_text) {
     // 1) try fasttext if available (very fast)
     if (fasttext_cb) {
@@ -30,11 +45,11 @@ std::string IntentRouter::route(const std::string &user_text) {
         if (label == "intent_chat") return "external_llm";
         if (label == "intent_gui_action") return "hand_off_to_gui";
     }
-    // 2) fallback lightweight heuristics
-    std::string lower = lower_copy(user_text);
-    if (contains_any(lower, {"compile","build","segmentation","memory","pointer","template"})) return "student";
-    if (contains_any(lower, {"teach","curriculum","lesson","explain","how to"} )) return "teacher";
-    if (contains_any(lower, {"hi","hello","merhaba","how are you","selam"})) return "external_llm";
+    // 2) fallback lightweight heuristics (single case-folded pass over the text)
+    const std::vector<int> hits = route_matcher().match_ids(user_text);
+    if (has_rule(hits, kRouteStudent)) return "student";
+    if (has_rule(hits, kRouteTeacher)) return "teacher";
+    if (has_rule(hits, kRouteGreeting)) return "external_llm";
     // 3) if llm classifier available, use it
     if (llm_classify_cb) {
         std::string label = llm_classify_cb(user_text);
@@ -45,18 +60,77 @@ std::string IntentRouter::route(const std::string &user_text) {
         }
     }
     // default: student for technical queries, otherwise external_llm
-    bool hasTechnical = contains_any(lower, {"class ","int ","std::","template","->","::","#include"});
+    bool hasTechnical = has_rule(hits, kRouteTechnical);
     return hasTechnical ? "student" : "external_llm";
 }
 
 
+// ---------------- Message helpers ----------------
+
+const char* msg_actor_to_string(MsgActor actor) {
+    switch (actor) {
+        case MsgActor::Gui: return "gui";
+        case MsgActor::Broker: return "broker";
+        case MsgActor::Router: return "router";
+        case MsgActor::Teacher: return "teacher";
+        case MsgActor::Student: return "student";
+        case MsgActor::ExternalLlm: return "external_llm";
+        case MsgActor::None: break;
+    }
+    return "none";
+}
+
+const char* msg_type_to_string(MsgType type) {
+    switch (type) {
+        case MsgType::UserInput: return "user_input";
+        case MsgType::AskStudent: return "ask_student";
+        case MsgType::AskTeacher: return "ask_teacher";
+        case MsgType::UserResponse: return "user_response";
+        case MsgType::Evaluation: return "evaluation";
+        case MsgType::Lesson: return "lesson";
+        case MsgType::Info: return "info";
+        case MsgType::Error: return "error";
+        case MsgType::None: break;
+    }
+    return "none";
+}
+
+namespace {
+
+// Broker metrics, registered once (cerebrumlux_broker_*).
+struct BrokerMetrics {
+    CerebrumLux::Metrics::Histogram& queue_wait;
+    CerebrumLux::Metrics::Counter& handled;
+    CerebrumLux::Metrics::Counter& failed;
+    CerebrumLux::Metrics::Counter& rejected;
+
+    static BrokerMetrics& get() {
+        static BrokerMetrics metrics{
+            CerebrumLux::Metrics::MetricsRegistry::instance().histogram(
+                "cerebrumlux_broker_queue_wait_seconds", "Time a tutor broker message waits in its lane before a worker picks it up"),
+            counter("handled"), counter("failed"), counter("rejected")};
+        return metrics;
+    }
+
+private:
+    static CerebrumLux::Metrics::Counter& counter(const std::string& result) {
+        return CerebrumLux::Metrics::MetricsRegistry::instance().counter(
+            "cerebrumlux_broker_messages_total", "Tutor broker input messages by outcome", "result=\"" + result + "\"");
+    }
+};
+
+} // namespace
+
 // ---------------- TutorBroker Implementation ----------------
 
 TutorBroker::TutorBroker()
-    : QObject(nullptr), running(false)
+    : TutorBroker(Config{})
+{
+}
+
+TutorBroker::TutorBroker(const Config& cfg)
+    : QObject(nullptr), config(cfg)
 {
-    teacher = std::make_unique<CerebrumLux::TeacherAI>();
-    student = std::make_unique<CerebrumLux::StudentAI>();
 }
 
 TutorBroker::~TutorBroker() {
@@ -75,105 +149,92 @@ void TutorBroker::set_llm_classifier(std::function<std::string(const std::string
     intent_router.set_llm_classifier(cb);
 }
 
-void TutorBroker::push_user_input(const std::string &userid, const std::string &text) {
+bool TutorBroker::push_user_input(const std::string &userid, const std::string &text) {
     Msg m;
     m.id = gen_id();
-    m.from = "gui";
-    m.to = "router";
-    m.type = "user_input";
-    m.payload["user"] = userid;
-    m.payload["text"] = text;
-    m.meta["ts"] = now_ts();
-    inbox.push(m);
+    m.session = session_key(userid);
+    m.ts_ms = now_ms();
+    m.from = MsgActor::Gui;
+    m.to = MsgActor::Router;
+    m.type = MsgType::UserInput;
+    m.user = userid;
+    m.text = text;
+    if (pool.try_post(m.session, m)) return true;
+
+    BrokerMetrics::get().rejected.inc();
+    emit_to_gui(reply_to(m, MsgActor::Broker, MsgType::Error,
+                         pool.running() ? "Broker busy: too many pending messages for this session"
+                                        : "Broker is not running"));
+    return false;
 }
 
 void TutorBroker::start() {
-    if(running) return;
-    running = true;
-    worker = std::thread([this](){ this->loop(); });
+    if (pool.running()) return;
+    std::size_t workers = config.workers;
+    if (workers == 0) workers = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    // Worker contexts persist across stop/start so learned student state is not lost; only missing ones are created.
+    while (contexts.size() < workers) contexts.push_back(std::make_unique<WorkerContext>());
+    pool.start(workers, config.lane_capacity, [this](std::size_t worker, Msg &m) { dispatch(worker, m); });
 }
 
 void TutorBroker::stop() {
-    if(!running) return;
-    running = false;
-    inbox.push(Msg()); // Push an empty message to wake up the worker thread
-    if (worker.joinable()) {
-        worker.join();
-    }
+    pool.stop();
 }
 
-void TutorBroker::loop() {
-    while (running) {
-        Msg m = inbox.wait_pop();
-        if (!running) break;
-        try {
-            if (m.to == "router" && m.type == "user_input") {
-                handle_user_input(m);
-            } else {
-                handle_internal(m);
-            }
-        } catch (const std::exception &ex) {
-            std::cerr << "Broker error: " << ex.what() << "\n";
-            Msg err_msg;
-            err_msg.id = gen_id();
-            err_msg.from = "broker";
-            err_msg.to = "gui";
-            err_msg.type = "error";
-            err_msg.payload["text"] = std::string("Broker error: ") + ex.what();
-            emit_to_gui(err_msg);
+void TutorBroker::dispatch(std::size_t worker, Msg &m) {
+    if (m.ts_ms > 0) {
+        const std::int64_t waited_ms = std::max<std::int64_t>(0, now_ms() - m.ts_ms);
+        BrokerMetrics::get().queue_wait.record_duration(std::chrono::milliseconds(waited_ms));
+    }
+    try {
+        if (m.to == MsgActor::Router && m.type == MsgType::UserInput) {
+            handle_user_input(*contexts[worker], m);
+        } else {
+            handle_internal(m);
         }
+        BrokerMetrics::get().handled.inc();
+    } catch (const std::exception &ex) {
+        std::cerr << "Broker error: " << ex.what() << "\n";
+        BrokerMetrics::get().failed.inc();
+        emit_to_gui(reply_to(m, MsgActor::Broker, MsgType::Error, std::string("Broker error: ") + ex.what()));
     }
 }
 
-void TutorBroker::handle_user_input(const Msg &m) {
-    std::string text = m.payload.value("text", "");
-    std::string user = m.payload.value("user", "user0");
-    std::string route_target = intent_router.route(text);
+void TutorBroker::handle_user_input(WorkerContext &ctx, const Msg &m) {
+    std::string route_target = intent_router.route(m.text);
 
     if (route_target == "student") {
-        Msg req; req.id = gen_id(); req.from = "broker"; req.to = "student"; req.type = "ask_student";
-        req.payload["text"] = text; req.meta["user"] = user;
-        process_student_request(req);
+        Msg req = reply_to(m, MsgActor::Broker, MsgType::AskStudent, m.text);
+        req.to = MsgActor::Student;
+        process_student_request(ctx, req);
     } else if (route_target == "teacher") {
-        Msg req; req.id = gen_id(); req.from = "broker"; req.to = "teacher"; req.type = "ask_teacher";
-        req.payload["text"] = text; req.meta["user"] = user;
-        process_teacher_request(req);
+        Msg req = reply_to(m, MsgActor::Broker, MsgType::AskTeacher, m.text);
+        req.to = MsgActor::Teacher;
+        process_teacher_request(ctx, req);
     } else if (route_target == "external_llm") {
         if (external_llm_cb) {
-            std::string resp = external_llm_cb(text);
-            Msg out; out.id=gen_id(); out.from="external_llm"; out.to="gui"; out.type="user_response";
-            out.payload["text"] = resp; out.meta["user"]=user;
-            emit_to_gui(out);
+            emit_to_gui(reply_to(m, MsgActor::ExternalLlm, MsgType::UserResponse, external_llm_cb(m.text)));
         } else {
-            process_teacher_request(Msg{gen_id(),"broker","teacher","ask_teacher", json{{"text",text}}, json{{"user",user}}});
+            Msg req = reply_to(m, MsgActor::Broker, MsgType::AskTeacher, m.text);
+            req.to = MsgActor::Teacher;
+            process_teacher_request(ctx, req);
         }
     } else { // hand_off_to_gui or unknown
-        Msg out; out.id=gen_id(); out.from="broker"; out.to="gui"; out.type="info";
-        out.payload["text"] = std::string("Unhandled route: ") + route_target; out.meta["user"]=user;
-        emit_to_gui(out);
+        emit_to_gui(reply_to(m, MsgActor::Broker, MsgType::Info, std::string("Unhandled route: ") + route_target));
     }
 }
 
-void TutorBroker::process_student_request(const Msg &req) {
-    std::string prompt = req.payload.value("text", "");
-    std::string student_resp = student->respond(prompt);
+void TutorBroker::process_student_request(WorkerContext &ctx, const Msg &req) {
+    std::string student_resp = ctx.student.respond(req.text);
+    emit_to_gui(reply_to(req, MsgActor::Student, MsgType::UserResponse, student_resp));
 
-    Msg out; out.id = gen_id(); out.from="student"; out.to="gui"; out.type="user_response";
-    out.payload["text"] = student_resp; out.meta = req.meta;
-    emit_to_gui(out);
-
-    std::string eval = teacher->evaluate(student_resp);
-    Msg ev; ev.id=gen_id(); ev.from="teacher"; ev.to="gui"; ev.type="evaluation";
-    ev.payload["text"] = eval; ev.meta = req.meta;
-    emit_to_gui(ev);
+    std::string eval = ctx.teacher.evaluate(student_resp);
+    emit_to_gui(reply_to(req, MsgActor::Teacher, MsgType::Evaluation, std::move(eval)));
 }
 
-void TutorBroker::process_teacher_request(const Msg &req) {
-    std::string text = req.payload.value("text", "");
-    std::string lesson = teacher->teach(text); // 'text' might be a section title or a question
-    Msg out; out.id=gen_id(); out.from="teacher"; out.to="gui"; out.type="lesson";
-    out.payload["text"] = lesson; out.meta = req.meta;
-    emit_to_gui(out);
+void TutorBroker::process_teacher_request(WorkerContext &ctx, const Msg &req) {
+    std::string lesson = ctx.teacher.teach(req.text); // 'text' might be a section title or a question
+    emit_to_gui(reply_to(req, MsgActor::Teacher, MsgType::Lesson, std::move(lesson)));
 }
 
 void TutorBroker::handle_internal(const Msg &m) {
@@ -181,19 +242,33 @@ void TutorBroker::handle_internal(const Msg &m) {
 }
 
 void TutorBroker::emit_to_gui(const Msg &m) {
+    // Called from worker threads; Qt queues the signal to receivers living on the GUI thread.
     emit new_message_for_gui(m);
 }
 
-std::string TutorBroker::now_ts() {
-    using namespace std::chrono;
-    auto t = system_clock::now();
-    auto s = duration_cast<milliseconds>(t.time_since_epoch()).count();
-    return std::to_string(s);
+Msg TutorBroker::reply_to(const Msg &req, MsgActor from, MsgType type, std::string text) const {
+    Msg out;
+    out.id = gen_id();
+    out.session = req.session;
+    out.ts_ms = now_ms();
+    out.from = from;
+    out.to = MsgActor::Gui;
+    out.type = type;
+    out.user = req.user;
+    out.text = std::move(text);
+    return out;
 }
 
-std::string TutorBroker::gen_id() {
-    static std::atomic<uint64_t> counter(1);
-    uint64_t v = counter.fetch_add(1);
-    return "m" + std::to_string(v);
+std::uint64_t TutorBroker::session_key(const std::string &userid) {
+    return static_cast<std::uint64_t>(std::hash<std::string>{}(userid.empty() ? std::string("user0") : userid));
 }
 
+std::int64_t TutorBroker::now_ms() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+std::uint64_t TutorBroker::gen_id() {
+    static std::atomic<std::uint64_t> counter(1);
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
@@ -3,59 +3,38 @@
 #define TUTOR_BROKER_ROUTER_H
 
 #include <string>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
 #include <functional>
-#include <atomic>
-#include <thread>
+#include <cstdint>
 #include <memory>
-#include <optional>
+#include <vector>
 
-#include "external/nlohmann/json.hpp"
 #include "ai_tutor/curriculum.h"
 #include "ai_tutor/teacher_ai.h"
 #include "ai_tutor/student_ai.h"
+#include "core/session_worker_pool.h"
 #include <QObject>
 #include <QMetaType>
 
-using json = nlohmann::json;
-
 // ---------------- Message struct ----------------
-struct Msg {
-    std::string id;
-    std::string from;   // "gui"|"broker"|"teacher"|"student"|"router"|"intent"
-    std::string to;     // target
-    std::string type;   // "user_input"|"lesson_request"|"lesson"|"answer"|"eval"|"intent"
-    json payload;       // freeform
-    json meta;
-};
-Q_DECLARE_METATYPE(Msg)
+// Typed, fixed-layout message. Routing fields are enums instead of strings and the only heap data is the user id
+// and the text, so a message moves through the lock-free lanes without json parsing or per-field allocations.
+enum class MsgActor : std::uint8_t { None = 0, Gui, Broker, Router, Teacher, Student, ExternalLlm };
+enum class MsgType : std::uint8_t { None = 0, UserInput, AskStudent, AskTeacher, UserResponse, Evaluation, Lesson, Info, Error };
 
+const char* msg_actor_to_string(MsgActor actor);
+const char* msg_type_to_string(MsgType type);
 
-// ---------------- Thread-safe queue ----------------
-template<typename T>
-class TSQueue {
-    std::queue<T> q;
-    std::mutex m;
-    std::condition_variable cv;
-public:
-    void push(const T &v){ std::lock_guard lk(m); q.push(v); cv.notify_one(); }
-    
-    T wait_pop() {
-        std::unique_lock lk(m);
-        cv.wait(lk, [&]{ return !q.empty(); });
-        T v = q.front(); q.pop(); return v;
-    }
-    
-    bool try_pop(T &out) {
-        std::lock_guard lk(m);
-        if (q.empty()) return false;
-        out = q.front(); q.pop(); return true;
-    }
-    
-    bool empty(){ std::lock_guard lk(m); return q.empty(); }
+struct Msg {
+    std::uint64_t id = 0;
+    std::uint64_t session = 0;  // hash of the user id; all messages of a session are handled in order by one worker
+    std::int64_t ts_ms = 0;     // creation time (ms since epoch)
+    MsgActor from = MsgActor::None;
+    MsgActor to = MsgActor::None;
+    MsgType type = MsgType::None;
+    std::string user;
+    std::string text;
 };
+Q_DECLARE_METATYPE(Msg)
 
 // ---------------- IntentRouter ----------------
 class IntentRouter {
@@ -72,48 +51,61 @@ public:
 private:
     std::function<std::string(const std::string&)> fasttext_cb;
     std::function<std::string(const std::string&)> llm_classify_cb;
-
-    static bool contains_any(const std::string &s, const std::initializer_list<std::string>& keys);
-    static std::string lower_copy(const std::string &s);
 };
 
 // ---------------- TutorBroker ----------------
+// Routes user input to the student/teacher/external LLM on a pool of workers. Each worker owns a lock-free lane and
+// its own TeacherAI/StudentAI instances (they keep per-instance state and are not shared across threads); a user
+// always maps to the same lane, so replies for one session keep their order while sessions run in parallel.
 class TutorBroker : public QObject {
     Q_OBJECT
 public:
+    struct Config {
+        std::size_t workers = 0;         // 0: hardware concurrency
+        std::size_t lane_capacity = 256; // per-worker queue bound; a full lane rejects input with an error message
+    };
+
     TutorBroker();
+    explicit TutorBroker(const Config& config);
     ~TutorBroker();
 
     void set_external_llm(std::function<std::string(const std::string&)> llm_cb);
     void set_fasttext_classifier(std::function<std::string(const std::string&)> fcb);
     void set_llm_classifier(std::function<std::string(const std::string&)> cb);
 
-    void push_user_input(const std::string &userid, const std::string &text);
-    
+    // Non-blocking. Returns false (and emits an error message) if the broker is stopped or the user's lane is full.
+    bool push_user_input(const std::string &userid, const std::string &text);
+
     void start();
-    void stop();
+    void stop(); // pending messages are dropped; in-flight ones finish first
+    bool is_running() const { return pool.running(); }
 
 signals:
     void new_message_for_gui(const Msg& message);
 
 private:
-    std::unique_ptr<CerebrumLux::TeacherAI> teacher;
-    std::unique_ptr<CerebrumLux::StudentAI> student;
+    struct WorkerContext {
+        CerebrumLux::TeacherAI teacher;
+        CerebrumLux::StudentAI student;
+    };
+
+    Config config;
+    std::vector<std::unique_ptr<WorkerContext>> contexts;
     IntentRouter intent_router;
-    TSQueue<Msg> inbox;
-    std::atomic<bool> running;
-    std::thread worker;
+    CerebrumLux::SessionWorkerPool<Msg> pool;
     std::function<std::string(const std::string&)> external_llm_cb;
 
-    void loop();
-    void handle_user_input(const Msg &m);
-    void process_student_request(const Msg &req);
-    void process_teacher_request(const Msg &req);
+    void dispatch(std::size_t worker, Msg &m);
+    void handle_user_input(WorkerContext &ctx, const Msg &m);
+    void process_student_request(WorkerContext &ctx, const Msg &req);
+    void process_teacher_request(WorkerContext &ctx, const Msg &req);
     void handle_internal(const Msg &m);
     void emit_to_gui(const Msg &m);
+    Msg reply_to(const Msg &req, MsgActor from, MsgType type, std::string text) const;
 
-    static std::string now_ts();
-    static std::string gen_id();
+    static std::uint64_t session_key(const std::string &userid);
+    static std::int64_t now_ms();
+    static std::uint64_t gen_id();
 };
 
 #endif // TUTOR_BROKER_ROUTER_H
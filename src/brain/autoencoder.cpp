@@ -15,6 +15,44 @@ namespace CerebrumLux { // TÜM İMPLEMENTASYON BU NAMESPACE İÇİNDE OLACAK
 const int CryptofigAutoencoder::INPUT_DIM;
 const int CryptofigAutoencoder::LATENT_DIM;
 
+namespace {
+
+// Ağırlık vektörleri kayıt biçimi değişmesin diye std::vector<float> olarak tutulur ve Eigen ile yerinde eşlenir.
+// encoder_weights[i * LATENT_DIM + j] ve decoder_weights[i * INPUT_DIM + j] düzenleri satır öncelikli matrislere karşılık gelir.
+using EncoderMatrix = Eigen::Matrix<float, CryptofigAutoencoder::INPUT_DIM, CryptofigAutoencoder::LATENT_DIM, Eigen::RowMajor>;
+using DecoderMatrix = Eigen::Matrix<float, CryptofigAutoencoder::LATENT_DIM, CryptofigAutoencoder::INPUT_DIM, Eigen::RowMajor>;
+using InputRow = Eigen::Matrix<float, 1, CryptofigAutoencoder::INPUT_DIM>;
+using LatentRow = Eigen::Matrix<float, 1, CryptofigAutoencoder::LATENT_DIM>;
+
+// Bu eşiğin altındaki yeniden yapılandırma hatası (RMSE) için ağırlıklar güncellenmez.
+constexpr float kMinErrorForUpdate = 0.1f;
+
+Eigen::Map<const EncoderMatrix> encoder_matrix(const std::vector<float>& weights) {
+    return Eigen::Map<const EncoderMatrix>(weights.data());
+}
+
+Eigen::Map<const DecoderMatrix> decoder_matrix(const std::vector<float>& weights) {
+    return Eigen::Map<const DecoderMatrix>(weights.data());
+}
+
+// Eigen'in vektörleştirilmiş exp'i ile sigmoid: 1 / (1 + e^-x)
+template <typename Derived>
+void apply_sigmoid(Eigen::MatrixBase<Derived>& x) {
+    x = (1.0f + (-x.array()).exp()).inverse().matrix();
+}
+
+template <typename Derived>
+void apply_sigmoid(Eigen::MatrixBase<Derived>&& x) {
+    apply_sigmoid(x);
+}
+
+template <typename Derived>
+void clamp_unit(Eigen::MatrixBase<Derived>& x) {
+    x = x.cwiseMax(-1.0f).cwiseMin(1.0f);
+}
+
+} // namespace
+
 // Default constructor calls the initialization method
 CryptofigAutoencoder::CryptofigAutoencoder() {
     initialize_weights(); // Call the unified initialization method
@@ -55,13 +93,10 @@ std::vector<float> CryptofigAutoencoder::encode(const std::vector<float>& input_
     }
 
     std::vector<float> latent_features(LATENT_DIM, 0.0f);
-    for (int j = 0; j < LATENT_DIM; ++j) {
-        float sum = 0.0f;
-        for (int i = 0; i < INPUT_DIM; ++i) { // Corrected loop variable from `i` to `i`
-            sum += input_features[i] * encoder_weights[i * LATENT_DIM + j]; // Use correct member name
-        }
-        latent_features[j] = sigmoid(sum + encoder_bias[j]);
-    }
+    Eigen::Map<LatentRow> latent(latent_features.data());
+    latent.noalias() = Eigen::Map<const InputRow>(input_features.data()).lazyProduct(encoder_matrix(encoder_weights));
+    latent += Eigen::Map<const LatentRow>(encoder_bias.data());
+    apply_sigmoid(latent);
     return latent_features;
 }
 
@@ -72,13 +107,10 @@ std::vector<float> CryptofigAutoencoder::decode(const std::vector<float>& latent
     }
 
     std::vector<float> reconstructed_features(INPUT_DIM, 0.0f);
-    for (int j = 0; j < INPUT_DIM; ++j) {
-        float sum = 0.0f;
-        for (int i = 0; i < LATENT_DIM; ++i) { // Corrected loop variable from `i` to `i`
-            sum += latent_features[i] * decoder_weights[i * INPUT_DIM + j]; // Use correct member name
-        }
-        reconstructed_features[j] = sigmoid(sum + decoder_bias[j]); // Use correct member name
-    }
+    Eigen::Map<InputRow> reconstructed(reconstructed_features.data());
+    reconstructed.noalias() = Eigen::Map<const LatentRow>(latent_features.data()) * decoder_matrix(decoder_weights);
+    reconstructed += Eigen::Map<const InputRow>(decoder_bias.data());
+    apply_sigmoid(reconstructed);
     return reconstructed_features;
 }
 
@@ -92,45 +124,122 @@ void CryptofigAutoencoder::adjust_weights_on_error(const std::vector<float>& inp
         return;
     }
 
-    std::vector<float> latent_features = encode(input_features);
-    std::vector<float> reconstructed_features = decode(latent_features);
-
-    float total_error = 0.0f;
-    for (int i = 0; i < INPUT_DIM; ++i) {
-        float error = input_features[i] - reconstructed_features[i];
-        total_error += error * error;
+    // Tek örnek, 1 satırlık mini-batch olarak işlenir; güncelleme kuralı birebir aynıdır.
+    Eigen::Map<const SampleMatrix> input(input_features.data(), 1, INPUT_DIM);
+    float total_error = train_minibatch(input, learning_rate_ae);
+    if (total_error > kMinErrorForUpdate) {
+        LOG_DEFAULT(LogLevel::DEBUG, "CryptofigAutoencoder: Agirliklar hataya gore ayarlandi. Hata: " << total_error << "\n");
     }
-    total_error = std::sqrt(total_error / INPUT_DIM); // RMSE
+}
 
-    if (total_error > 0.1f) { 
-        float adjustment_magnitude = learning_rate_ae * total_error; 
+void CryptofigAutoencoder::encode_batch(const SampleMatrix& inputs, LatentMatrix& latent_out) const {
+    latent_out.resize(inputs.rows(), LATENT_DIM);
+    latent_out.noalias() = inputs * encoder_matrix(encoder_weights);
+    latent_out.rowwise() += Eigen::Map<const LatentRow>(encoder_bias.data());
+    apply_sigmoid(latent_out);
+}
 
-        for (int j = 0; j < INPUT_DIM; ++j) {
-            float output_error = input_features[j] - reconstructed_features[j];
-            decoder_bias[j] += adjustment_magnitude * output_error; // Use correct member name
-            decoder_bias[j] = std::min(1.0f, std::max(-1.0f, decoder_bias[j])); // Use correct member name
+void CryptofigAutoencoder::decode_batch(const LatentMatrix& latent, SampleMatrix& reconstructed_out) const {
+    reconstructed_out.resize(latent.rows(), INPUT_DIM);
+    reconstructed_out.noalias() = latent * decoder_matrix(decoder_weights);
+    reconstructed_out.rowwise() += Eigen::Map<const InputRow>(decoder_bias.data());
+    apply_sigmoid(reconstructed_out);
+}
 
-            for (int i = 0; i < LATENT_DIM; ++i) {
-                decoder_weights[i * INPUT_DIM + j] += adjustment_magnitude * output_error * latent_features[i]; // Use correct member name
-                decoder_weights[i * INPUT_DIM + j] = std::min(1.0f, std::max(-1.0f, decoder_weights[i * INPUT_DIM + j])); // Use correct member name
-            }
-        }
+void CryptofigAutoencoder::reserve_scratch(Eigen::Index rows) {
+    if (scratch_latent.rows() >= rows) return;
+    scratch_latent.resize(rows, LATENT_DIM);
+    scratch_reconstructed.resize(rows, INPUT_DIM);
+    scratch_error.resize(rows, INPUT_DIM);
+    scratch_latent_signal.resize(rows, LATENT_DIM);
+    scratch_scale.resize(rows);
+}
 
-        for (int j = 0; j < LATENT_DIM; ++j) {
-            float latent_error_signal = 0.0f;
-            for (int k = 0; k < INPUT_DIM; ++k) {
-                latent_error_signal += (input_features[k] - reconstructed_features[k]) * decoder_weights[j * INPUT_DIM + k]; // Use correct member name
-            }
-            encoder_bias[j] += adjustment_magnitude * latent_error_signal; // Use correct member name
-            encoder_bias[j] = std::min(1.0f, std::max(-1.0f, encoder_bias[j])); // Use correct member name
-
-            for (int i = 0; i < INPUT_DIM; ++i) {
-                encoder_weights[i * LATENT_DIM + j] += adjustment_magnitude * latent_error_signal * input_features[i]; // Use correct member name
-                encoder_weights[i * LATENT_DIM + j] = std::min(1.0f, std::max(-1.0f, encoder_weights[i * LATENT_DIM + j])); // Use correct member name
-            }
+float CryptofigAutoencoder::train_minibatch(const Eigen::Ref<const SampleMatrix>& inputs, float learning_rate_ae) {
+    const Eigen::Index rows = inputs.rows();
+    reserve_scratch(rows);
+    auto latent = scratch_latent.topRows(rows);
+    auto reconstructed = scratch_reconstructed.topRows(rows);
+    auto error = scratch_error.topRows(rows);
+    auto latent_signal = scratch_latent_signal.topRows(rows);
+    auto scale = scratch_scale.head(rows);
+
+    Eigen::Map<EncoderMatrix> enc_w(encoder_weights.data());
+    Eigen::Map<LatentRow> enc_b(encoder_bias.data());
+    Eigen::Map<DecoderMatrix> dec_w(decoder_weights.data());
+    Eigen::Map<InputRow> dec_b(decoder_bias.data());
+
+    // İleri geçiş
+    latent.noalias() = inputs * enc_w;
+    latent.rowwise() += enc_b;
+    apply_sigmoid(latent);
+    reconstructed.noalias() = latent * dec_w;
+    reconstructed.rowwise() += dec_b;
+    apply_sigmoid(reconstructed);
+    error = inputs - reconstructed;
+
+    // Örnek başına RMSE; yalnızca eşiği aşan örnekler lr * RMSE ağırlığıyla güncellemeye katılır.
+    scale = (error.rowwise().squaredNorm() / static_cast<float>(INPUT_DIM)).array().sqrt().matrix();
+    const float error_sum = scale.sum();
+    scale = (scale.array() > kMinErrorForUpdate).select(scale * learning_rate_ae, 0.0f);
+    if (scale.maxCoeff() <= 0.0f) return error_sum;
+
+    const float inv_rows = 1.0f / static_cast<float>(rows);
+    error.array().colwise() *= scale.array(); // error artık "adjustment_magnitude * output_error"
+
+    dec_b += inv_rows * error.colwise().sum();
+    dec_w.noalias() += inv_rows * (latent.transpose() * error);
+    clamp_unit(dec_b);
+    clamp_unit(dec_w);
+
+    // Gizil hata sinyali güncellenmiş decoder ağırlıklarıyla hesaplanır (tek örnekli kuralda olduğu gibi).
+    latent_signal.noalias() = error * dec_w.transpose();
+    enc_b += inv_rows * latent_signal.colwise().sum();
+    enc_w.noalias() += inv_rows * (inputs.transpose() * latent_signal);
+    clamp_unit(enc_b);
+    clamp_unit(enc_w);
+
+    return error_sum;
+}
+
+float CryptofigAutoencoder::train_batch(const SampleMatrix& inputs, float learning_rate_ae, std::size_t batch_size) {
+    if (inputs.rows() == 0) {
+        LOG_DEFAULT(LogLevel::WARNING, "CryptofigAutoencoder::train_batch: Boş girdi matrisi, eğitim atlandı.");
+        return 0.0f;
+    }
+    const Eigen::Index step = static_cast<Eigen::Index>(std::max<std::size_t>(1, batch_size));
+    double error_sum = 0.0;
+    for (Eigen::Index start = 0; start < inputs.rows(); start += step) {
+        const Eigen::Index rows = std::min(step, inputs.rows() - start);
+        error_sum += train_minibatch(inputs.middleRows(start, rows), learning_rate_ae);
+    }
+    const float mean_error = static_cast<float>(error_sum / static_cast<double>(inputs.rows()));
+    LOG_DEFAULT(LogLevel::DEBUG, "CryptofigAutoencoder::train_batch: " << inputs.rows() << " örnek, batch " << step << ", ortalama RMSE: " << mean_error);
+    return mean_error;
+}
+
+float CryptofigAutoencoder::train_on_samples(const std::vector<std::vector<float>>& samples, float learning_rate_ae, std::size_t batch_size, int epochs) {
+    std::vector<std::size_t> order;
+    order.reserve(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].size() == INPUT_DIM) order.push_back(i);
+    }
+    if (order.size() != samples.size()) {
+        LOG_DEFAULT(LogLevel::WARNING, "CryptofigAutoencoder::train_on_samples: " << (samples.size() - order.size()) << " örnek boyut uyuşmazlığı nedeniyle atlandı.");
+    }
+    if (order.empty()) return 0.0f;
+
+    scratch_inputs.resize(static_cast<Eigen::Index>(order.size()), INPUT_DIM);
+    float mean_error = 0.0f;
+    for (int epoch = 0; epoch < std::max(1, epochs); ++epoch) {
+        std::shuffle(order.begin(), order.end(), SafeRNG::getInstance().get_generator());
+        for (std::size_t row = 0; row < order.size(); ++row) {
+            scratch_inputs.row(static_cast<Eigen::Index>(row)) = Eigen::Map<const InputRow>(samples[order[row]].data());
         }
-        LOG_DEFAULT(LogLevel::DEBUG, "CryptofigAutoencoder: Agirliklar hataya gore ayarlandi. Hata: " << total_error << "\n");
+        mean_error = train_batch(scratch_inputs, learning_rate_ae, batch_size);
     }
+    LOG_DEFAULT(LogLevel::INFO, "CryptofigAutoencoder::train_on_samples: " << order.size() << " örnek, " << std::max(1, epochs) << " epoch, son ortalama RMSE: " << mean_error);
+    return mean_error;
 }
 
 void CryptofigAutoencoder::save_weights(const std::string& filename) const {
@@ -6,6 +6,8 @@
 #include <numeric> // std::accumulate için
 #include <algorithm> // std::min, std::max için
 #include <cmath>   // std::exp için (burada gerek yok, autoencoder.cpp'ye taşındı)
+#include <cstddef> // std::size_t için
+#include <Eigen/Dense> // Toplu (batch) encode/eğitim için
 // #include "../core/enums.h" // LogLevel için (burada gerek yok, autoencoder.cpp'ye taşındı)
 // #include "../core/utils.h" // SafeRNG ve diğerleri için (burada gerek yok, autoencoder.cpp'ye taşındı)
 
@@ -33,6 +35,21 @@ public:
     // Meta-öğrenme esintili, tek adımlı ağırlık ayarlaması
     void adjust_weights_on_error(const std::vector<float>& input_features, float learning_rate_ae);
 
+    // Toplu (batch) API: her satır bir örnektir. Satır öncelikli düzen sayesinde bir std::vector<float> doğrudan bir satıra kopyalanabilir.
+    using SampleMatrix = Eigen::Matrix<float, Eigen::Dynamic, INPUT_DIM, Eigen::RowMajor>;
+    using LatentMatrix = Eigen::Matrix<float, Eigen::Dynamic, LATENT_DIM, Eigen::RowMajor>;
+
+    // Çıktı matrisleri çağıran tarafından sağlanır; aynı boyutla tekrar kullanıldığında bellek ayrılmaz.
+    void encode_batch(const SampleMatrix& inputs, LatentMatrix& latent_out) const;
+    void decode_batch(const LatentMatrix& latent, SampleMatrix& reconstructed_out) const;
+
+    // Mini-batch eğitim: girdiler batch_size'lık dilimler halinde işlenir, her dilim için tek bir güncelleme yapılır.
+    // Güncelleme kuralı adjust_weights_on_error ile aynıdır, dilimdeki örnekler üzerinden ortalanır. Ortalama RMSE döner.
+    float train_batch(const SampleMatrix& inputs, float learning_rate_ae, std::size_t batch_size = 32);
+    // Bilgi tabanı dökümleri gibi vektör listeleri için: her epoch'ta örnekleri karıştırıp train_batch uygular.
+    // Boyutu INPUT_DIM olmayan örnekler atlanır. Son epoch'un ortalama RMSE'sini döner.
+    float train_on_samples(const std::vector<std::vector<float>>& samples, float learning_rate_ae, std::size_t batch_size = 32, int epochs = 1);
+
     // Ağırlıkları dosyaya kaydetme/yükleme
     void save_weights(const std::string& filename) const;
     void load_weights(const std::string& filename);
@@ -49,7 +66,19 @@ private:
     float sigmoid_derivative(float x) const; // Keep this
     // void initialize_random_weights(); // REMOVED: No longer needed after unifying with initialize_weights()
     void initialize_weights(); // This is the unified initialization method
-    
+
+    // Tek bir mini-batch için ileri geçiş + ağırlık güncellemesi. Satır RMSE'lerinin toplamını döner.
+    float train_minibatch(const Eigen::Ref<const SampleMatrix>& inputs, float learning_rate_ae);
+    void reserve_scratch(Eigen::Index rows);
+
+    // Eğitim çalışma alanları: yalnızca büyütülür, alt satırları (topRows) kullanılır.
+    // Eğitim metotları const olmadığı için tek yazar varsayılır; encode/decode bunlara dokunmaz.
+    SampleMatrix scratch_inputs;
+    LatentMatrix scratch_latent;
+    SampleMatrix scratch_reconstructed;
+    SampleMatrix scratch_error;
+    LatentMatrix scratch_latent_signal;
+    Eigen::VectorXf scratch_scale;
 
 };
 
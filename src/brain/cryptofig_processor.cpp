@@ -3,6 +3,7 @@
 #include "../core/enums.h" // LogLevel için
 #include "../brain/autoencoder.h" // CryptofigAutoencoder::INPUT_DIM, LATENT_DIM için
 #include "../core/utils.h" // SafeRNG için
+#include "../learning/KnowledgeBase.h" // train_autoencoder_on_knowledge_base için
 #include <algorithm> // std::min için
 #include <stdexcept> // std::runtime_error için
 
@@ -60,6 +61,21 @@ void CryptofigProcessor::process_expert_cryptofig(const std::vector<float>& expe
     // Gelecekte, uzman kriptofig'leri öğrenme modülüne yönlendirme mantığı eklenebilir.
 }
 
+float CryptofigProcessor::train_autoencoder_on_knowledge_base(const KnowledgeBase& kb, float learning_rate, std::size_t batch_size, int epochs) {
+    std::vector<std::vector<float>> embeddings;
+    for (auto& capsule : kb.get_all_capsules()) {
+        if (capsule.embedding.size() == CryptofigAutoencoder::INPUT_DIM) {
+            embeddings.push_back(std::move(capsule.embedding));
+        }
+    }
+    if (embeddings.empty()) {
+        LOG_DEFAULT(LogLevel::WARNING, "CryptofigProcessor::train_autoencoder_on_knowledge_base: Uygun boyutta embedding içeren kapsül bulunamadı.");
+        return 0.0f;
+    }
+    LOG_DEFAULT(LogLevel::INFO, "CryptofigProcessor::train_autoencoder_on_knowledge_base: " << embeddings.size() << " kapsül embedding'i ile autoencoder eğitiliyor.");
+    return cryptofig_autoencoder.train_on_samples(embeddings, learning_rate, batch_size, epochs);
+}
+
 const CryptofigAutoencoder& CryptofigProcessor::get_autoencoder() const {
     return cryptofig_autoencoder;
 }
@@ -16,6 +16,8 @@
 
 namespace CerebrumLux {
 
+class KnowledgeBase; // İleri bildirim
+
 class CryptofigProcessor {
 public:
     CryptofigProcessor(IntentAnalyzer& analyzer, CryptofigAutoencoder& autoencoder);
@@ -24,6 +26,9 @@ public:
     void process_sequence(DynamicSequence& sequence, float autoencoder_learning_rate);
     void process_expert_cryptofig(const std::vector<float>& expert_cryptofig, IntentLearner& learner);
 
+    // Bilgi tabanındaki tüm kapsül embedding'leriyle autoencoder'ı mini-batch modunda eğitir. Son ortalama RMSE'yi döner.
+    float train_autoencoder_on_knowledge_base(const KnowledgeBase& kb, float learning_rate, std::size_t batch_size = 32, int epochs = 1);
+
     // Get_autoencoder bildirimleri
     const CryptofigAutoencoder& get_autoencoder() const; // Const versiyon
     CryptofigAutoencoder& get_autoencoder(); // non-const versiyon
@@ -0,0 +1,325 @@
+#include "json_grammar.h"
+#include "../core/logger.h"
+#include "../external/nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace CerebrumLux {
+
+namespace {
+
+bool is_json_whitespace(unsigned char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+// UTF-8 öncü baytının gerektirdiği toplam bayt sayısı (devam baytları ve ASCII için 1).
+std::size_t utf8_sequence_length(unsigned char c) {
+    if ((c & 0xE0) == 0xC0) return 2;
+    if ((c & 0xF0) == 0xE0) return 3;
+    if ((c & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+constexpr std::size_t kDefaultStringMaxLength = 512;
+
+} // namespace
+
+void JsonGrammar::add_literal(std::string text, bool whitespace_before) {
+    Segment segment;
+    segment.kind = SegmentKind::Choice;
+    segment.whitespace_before = whitespace_before;
+    segment.options.push_back(std::move(text));
+    segments_.push_back(std::move(segment));
+}
+
+std::shared_ptr<const JsonGrammar> JsonGrammar::compile(const std::string& schema_json) {
+    using ordered_json = nlohmann::ordered_json; // Alanlar şemadaki sırayla üretilir
+    ordered_json schema;
+    try {
+        schema = ordered_json::parse(schema_json);
+    } catch (const std::exception& e) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: Şema ayrıştırılamadı: " << e.what());
+        return nullptr;
+    }
+    // value() yanlış tipte bir alanda (ör. "type": 3) nlohmann type_error fırlatır; bu yüzden tipler önce denetlenir.
+    const bool root_is_object = schema.is_object() && schema.contains("type") && schema["type"].is_string() &&
+                                schema["type"].get<std::string>() == "object";
+    if (!root_is_object || !schema.contains("properties") ||
+        !schema["properties"].is_object() || schema["properties"].empty()) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: Kök şema boş olmayan properties içeren bir object olmalı.");
+        return nullptr;
+    }
+
+    auto grammar = std::make_shared<JsonGrammar>();
+    grammar->add_literal("{");
+    bool first = true;
+    for (const auto& property : schema["properties"].items()) {
+        const ordered_json& spec = property.value();
+        if (!spec.is_object()) {
+            LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' alanının şeması object değil.");
+            return nullptr;
+        }
+        if (!first) grammar->add_literal(",");
+        first = false;
+        grammar->add_literal(ordered_json(property.key()).dump());
+        grammar->add_literal(":");
+
+        // Şema alanları yanlış tipte olabilir ("maxLength": "uzun", "minimum": [1]); value() ve get() bu durumda
+        // nlohmann type_error fırlatır. Derleme istisna sızdırmaz: alan loglanır ve şema reddedilir.
+        Segment value;
+        try {
+            const std::string type = spec.value("type", "");
+            if (spec.contains("enum")) {
+                const ordered_json& values = spec["enum"];
+                if (!values.is_array() || values.empty() || values.size() > kMaxChoiceOptions) {
+                    LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' enum'u 1-" << kMaxChoiceOptions << " öğe içermeli.");
+                    return nullptr;
+                }
+                value.kind = SegmentKind::Choice;
+                for (const auto& option : values) {
+                    if (!option.is_string()) {
+                        LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: Yalnızca string enum değerleri destekleniyor ('" << property.key() << "').");
+                        return nullptr;
+                    }
+                    // Tırnaklı JSON metni: kapanış tırnağı seçenekleri önek içermez kılar.
+                    std::string quoted = option.dump();
+                    if (std::find(value.options.begin(), value.options.end(), quoted) == value.options.end()) {
+                        value.options.push_back(std::move(quoted));
+                    }
+                }
+            } else if (type == "integer") {
+                value.kind = SegmentKind::Integer;
+                value.minimum = spec.value("minimum", static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::min()));
+                value.maximum = spec.value("maximum", static_cast<std::int64_t>(std::numeric_limits<std::int32_t>::max()));
+                if (value.minimum > value.maximum) {
+                    LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' için minimum > maximum.");
+                    return nullptr;
+                }
+            } else if (type == "string") {
+                value.kind = SegmentKind::String;
+                if (spec.contains("maxLength") && !spec["maxLength"].is_number_unsigned()) {
+                    // Negatif bir tamsayı size_t'ye sarılır ve sınırı fiilen kaldırırdı.
+                    LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' için maxLength negatif olmayan bir tamsayı olmalı.");
+                    return nullptr;
+                }
+                value.max_length = spec.value("maxLength", kDefaultStringMaxLength);
+            } else if (type == "boolean") {
+                value.kind = SegmentKind::Choice;
+                value.options = {"true", "false"};
+            } else {
+                LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' için desteklenmeyen tür: '" << type << "'.");
+                return nullptr;
+            }
+        } catch (const nlohmann::json::exception& e) {
+            LOG_ERROR_CERR(LogLevel::WARNING, "JsonGrammar: '" << property.key() << "' alanının şeması geçersiz: " << e.what());
+            return nullptr;
+        }
+        grammar->segments_.push_back(std::move(value));
+    }
+    grammar->add_literal("}");
+    return grammar;
+}
+
+std::shared_ptr<const JsonGrammar> JsonGrammar::cached(const std::string& schema_json) {
+    static std::mutex cache_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const JsonGrammar>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(schema_json);
+    if (it != cache.end()) return it->second;
+    // Geçersiz şemalar da (nullptr) saklanır; her çağrıda yeniden derlenip loglanmaz.
+    std::shared_ptr<const JsonGrammar> grammar = compile(schema_json);
+    cache.emplace(schema_json, grammar);
+    return grammar;
+}
+
+std::size_t JsonGrammar::max_document_length() const {
+    std::size_t total = 0;
+    for (const Segment& segment : segments_) {
+        if (segment.whitespace_before) total += kMaxWhitespaceRun;
+        switch (segment.kind) {
+            case SegmentKind::Choice: {
+                std::size_t longest = 0;
+                for (const std::string& option : segment.options) longest = std::max(longest, option.size());
+                total += longest;
+                break;
+            }
+            case SegmentKind::Integer: {
+                std::uint64_t lo = 0;
+                std::uint64_t hi = 0;
+                std::uint64_t largest = 0;
+                integer_bounds(segment, false, lo, hi);
+                if (lo <= hi) largest = hi;
+                integer_bounds(segment, true, lo, hi);
+                if (lo <= hi) largest = std::max(largest, hi);
+                std::size_t digits = 1;
+                for (; largest >= 10; largest /= 10) ++digits;
+                total += digits + 1; // eksi işareti
+                break;
+            }
+            case SegmentKind::String:
+                total += 2 + 2 * segment.max_length; // tırnaklar + her baytın kaçışlı olduğu en kötü durum
+                break;
+        }
+    }
+    return total;
+}
+
+bool JsonGrammar::integer_prefix_viable(std::uint64_t magnitude, std::uint64_t lo, std::uint64_t hi) {
+    if (lo > hi || magnitude > hi) return false;
+    if (magnitude >= lo) return true;
+    if (magnitude == 0) return false; // Baştaki sıfır genişletilemez
+    // magnitude * 10^k + r (0 <= r < 10^k) biçimindeki genişletmelerden biri [lo, hi] aralığına düşüyor mu?
+    std::uint64_t base = magnitude;
+    std::uint64_t span = 0;
+    while (base <= hi / 10) {
+        base *= 10;
+        span = span * 10 + 9;
+        if (base + span >= lo) return true;
+    }
+    return false;
+}
+
+void JsonGrammar::integer_bounds(const Segment& segment, bool negative, std::uint64_t& lo, std::uint64_t& hi) const {
+    if (!negative) {
+        if (segment.maximum < 0) {
+            lo = 1;
+            hi = 0;
+            return;
+        }
+        lo = segment.minimum > 0 ? static_cast<std::uint64_t>(segment.minimum) : 0;
+        hi = static_cast<std::uint64_t>(segment.maximum);
+        return;
+    }
+    if (segment.minimum >= 0) {
+        lo = 1;
+        hi = 0;
+        return;
+    }
+    // -m in [minimum, maximum]  =>  m in [max(-maximum, 0), -minimum]; INT64_MIN taşmadan çevrilir.
+    lo = segment.maximum < 0 ? static_cast<std::uint64_t>(-(segment.maximum + 1)) + 1 : 0;
+    hi = static_cast<std::uint64_t>(-(segment.minimum + 1)) + 1;
+}
+
+void JsonGrammar::finish_segment(State& state) const {
+    ++state.segment;
+    state.offset = 0;
+    state.mask = 0;
+    state.whitespace = 0;
+    state.flags = 0;
+    state.magnitude = 0;
+}
+
+bool JsonGrammar::advance(State& state, unsigned char c) const {
+    for (;;) {
+        if (complete(state)) return false;
+        const Segment& segment = segments_[state.segment];
+
+        if (!(state.flags & kStarted) && segment.whitespace_before && is_json_whitespace(c)) {
+            if (state.whitespace >= kMaxWhitespaceRun) return false;
+            ++state.whitespace;
+            return true;
+        }
+
+        switch (segment.kind) {
+            case SegmentKind::Choice: {
+                if (!(state.flags & kStarted)) {
+                    const std::size_t n = segment.options.size();
+                    state.mask = n >= 32 ? ~0u : ((1u << n) - 1);
+                    state.flags |= kStarted;
+                }
+                std::uint32_t next = 0;
+                for (std::size_t i = 0; i < segment.options.size(); ++i) {
+                    const std::uint32_t bit = 1u << i;
+                    const std::string& option = segment.options[i];
+                    if ((state.mask & bit) && option.size() > state.offset &&
+                        static_cast<unsigned char>(option[state.offset]) == c) {
+                        next |= bit;
+                    }
+                }
+                if (next == 0) return false;
+                ++state.offset;
+                state.mask = next;
+                for (std::size_t i = 0; i < segment.options.size(); ++i) {
+                    if ((next & (1u << i)) && segment.options[i].size() == state.offset) {
+                        finish_segment(state);
+                        break;
+                    }
+                }
+                return true;
+            }
+
+            case SegmentKind::Integer: {
+                std::uint64_t lo = 0;
+                std::uint64_t hi = 0;
+                if (c == '-' && !(state.flags & kStarted)) {
+                    integer_bounds(segment, true, lo, hi);
+                    if (lo > hi) return false;
+                    state.flags |= kStarted | kNegative;
+                    return true;
+                }
+                const bool negative = (state.flags & kNegative) != 0;
+                if (c >= '0' && c <= '9') {
+                    if (state.flags & kLeadingZero) return false;
+                    const std::uint64_t digit = c - '0';
+                    if (state.magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) return false;
+                    const std::uint64_t next = state.magnitude * 10 + digit;
+                    integer_bounds(segment, negative, lo, hi);
+                    if (!integer_prefix_viable(next, lo, hi)) return false;
+                    if (state.offset == 0 && digit == 0) state.flags |= kLeadingZero;
+                    state.magnitude = next;
+                    ++state.offset;
+                    state.flags |= kStarted;
+                    return true;
+                }
+                // Sayı, ardından gelen ilk rakam olmayan karakterle biter; karakter sonraki parçaya devredilir.
+                if (state.offset == 0) return false;
+                integer_bounds(segment, negative, lo, hi);
+                if (state.magnitude < lo || state.magnitude > hi) return false;
+                finish_segment(state);
+                continue;
+            }
+
+            case SegmentKind::String: {
+                if (!(state.flags & kStarted)) {
+                    if (c != '"') return false;
+                    state.flags |= kStarted;
+                    return true;
+                }
+                if (state.flags & kEscape) {
+                    if (c == 0 || !std::strchr("\"\\/bfnrt", c)) return false;
+                    state.flags &= ~kEscape;
+                    ++state.offset;
+                    return true;
+                }
+                if (c == '"') {
+                    finish_segment(state);
+                    return true;
+                }
+                if (c < 0x20) return false;
+                // Çok baytlı bir karakter sınırda bölünmesin.
+                if (state.offset + utf8_sequence_length(c) > segment.max_length) return false;
+                if (c == '\\') {
+                    state.flags |= kEscape;
+                    return true;
+                }
+                ++state.offset;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+bool JsonGrammar::advance(State& state, std::string_view text) const {
+    for (char c : text) {
+        if (!advance(state, static_cast<unsigned char>(c))) return false;
+    }
+    return true;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,74 @@
+#ifndef JSON_GRAMMAR_H
+#define JSON_GRAMMAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CerebrumLux {
+
+// JSON şemasından derlenen karakter düzeyi otomat; LLMEngine örnekleyicisinde token maskesi olarak kullanılır.
+//
+// Desteklenen şema alt kümesi: kök "object"; properties altında "integer" (minimum/maximum), "string" (maxLength),
+// "boolean" ve string "enum" alanları. Tüm alanlar şemadaki sırayla ve zorunlu olarak üretilir; yapısal
+// karakterlerin çevresinde sınırlı boşluk serbesttir. Sayı aralıkları ve uzunluk sınırları otomat içinde
+// zorlandığından her kabul edilen önek geçerli bir belgeye tamamlanabilir ve çıktı sonlu kalır.
+class JsonGrammar {
+public:
+    enum class SegmentKind : std::uint8_t { Choice, Integer, String };
+
+    struct Segment {
+        SegmentKind kind = SegmentKind::Choice;
+        bool whitespace_before = true;
+        std::vector<std::string> options;   // Choice: önek içermeyen seçenekler (sabitler, "true"/"false", tırnaklı enum)
+        std::int64_t minimum = 0;           // Integer
+        std::int64_t maximum = 0;           // Integer
+        std::size_t max_length = 0;         // String (bayt)
+    };
+
+    // Kopyalanması ucuz ayrıştırma durumu; her token denemesi bir kopya üzerinde yürütülür.
+    struct State {
+        std::uint32_t segment = 0;
+        std::uint32_t offset = 0;   // Choice: eşleşen karakter; Integer: basamak; String: içerik baytı
+        std::uint32_t mask = 0;     // Choice: hâlâ olası seçenekler
+        std::uint8_t whitespace = 0;
+        std::uint8_t flags = 0;
+        std::uint64_t magnitude = 0; // Integer: şimdiye kadarki mutlak değer
+    };
+
+    static constexpr std::size_t kMaxChoiceOptions = 32;
+    static constexpr std::uint8_t kMaxWhitespaceRun = 2; // Belge sınırına her yapısal karakterde eklenir
+
+    // Şemayı derler; desteklenmeyen veya geçersiz şemada nullptr döner (hata loglanır).
+    static std::shared_ptr<const JsonGrammar> compile(const std::string& schema_json);
+    // Şema metnine göre önbelleklenmiş derleme; aynı şema süreç boyunca bir kez derlenir.
+    static std::shared_ptr<const JsonGrammar> cached(const std::string& schema_json);
+
+    State initial_state() const { return State{}; }
+    // Karakteri kabul ederse durumu ilerletir ve true döner; reddederse durum tanımsızdır (kopya üzerinde çağırın).
+    bool advance(State& state, unsigned char c) const;
+    bool advance(State& state, std::string_view text) const;
+    // Belge tamamlandı mı (son yapısal karakter tüketildi).
+    bool complete(const State& state) const { return state.segment >= segments_.size(); }
+    // Kabul edilebilecek en uzun belgenin karakter sayısı (boşluklar ve kaçış dizileri dahil).
+    std::size_t max_document_length() const;
+
+    const std::vector<Segment>& segments() const { return segments_; }
+
+private:
+    enum Flag : std::uint8_t { kStarted = 1, kNegative = 2, kEscape = 4, kLeadingZero = 8 };
+
+    void add_literal(std::string text, bool whitespace_before = true);
+    static bool integer_prefix_viable(std::uint64_t magnitude, std::uint64_t lo, std::uint64_t hi);
+    void integer_bounds(const Segment& segment, bool negative, std::uint64_t& lo, std::uint64_t& hi) const;
+    void finish_segment(State& state) const;
+
+    std::vector<Segment> segments_;
+};
+
+} // namespace CerebrumLux
+
+#endif // JSON_GRAMMAR_H
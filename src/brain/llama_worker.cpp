@@ -1,5 +1,6 @@
 #include "llama_worker.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
 #include <QDebug>
 #include <QCoreApplication>
 #include <chrono> // For latency calculation
@@ -7,6 +8,32 @@
 
 namespace CerebrumLux {
 
+namespace {
+
+struct LlamaWorkerMetrics {
+    Metrics::Gauge& queue_depth = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_llama_queue_depth", "LlamaWorker kuyruğunda bekleyen istek sayısı");
+    Metrics::Counter& inference_requests = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llama_requests_total", "LlamaWorker tarafından işlenen istekler", "type=\"inference\"");
+    Metrics::Counter& embedding_requests = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llama_requests_total", "LlamaWorker tarafından işlenen istekler", "type=\"embedding\"");
+    Metrics::Counter& model_not_loaded = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llama_errors_total", "LlamaWorker hataları", "reason=\"model_not_loaded\"");
+    Metrics::Histogram& queue_wait = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llama_queue_wait_seconds", "İsteğin kuyrukta beklediği süre");
+    Metrics::Histogram& inference_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llama_latency_seconds", "LLM çağrı süresi", "type=\"inference\"");
+    Metrics::Histogram& embedding_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llama_latency_seconds", "LLM çağrı süresi", "type=\"embedding\"");
+};
+
+LlamaWorkerMetrics& worker_metrics() {
+    static LlamaWorkerMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
 LlamaWorker::LlamaWorker(LLMEngine& llm_engine_ref, QObject* parent) 
     : QObject(parent), llm_engine_(llm_engine_ref), worker_thread_(new QThread(this)) {
     this->moveToThread(worker_thread_); // LlamaWorker'ı kendi thread'ine taşı
@@ -27,6 +54,8 @@ LlamaWorker::~LlamaWorker() {
 void LlamaWorker::enqueueRequest(const LlamaRequest& request) {
     QMutexLocker locker(&mutex_);
     request_queue_.enqueue(request);
+    enqueue_times_.enqueue(std::chrono::steady_clock::now());
+    worker_metrics().queue_depth.inc();
     condition_.wakeOne(); // Bir isteğin geldiğini bildir
     LOG_DEFAULT(LogLevel::TRACE, "LlamaWorker: Yeni istek kuyruğa eklendi. İstek ID: " << request.requestId);
 }
@@ -41,9 +70,12 @@ void LlamaWorker::processRequests() {
                 if (!running_.load()) return; // Uyandırıldı ama durma sinyali ise çık
             }
             request = request_queue_.dequeue();
+            worker_metrics().queue_wait.record_duration(std::chrono::steady_clock::now() - enqueue_times_.dequeue());
+            worker_metrics().queue_depth.dec();
         }
 
         if (!llm_engine_.is_model_loaded()) {
+            worker_metrics().model_not_loaded.inc();
             LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "LlamaWorker: LLM modeli yüklü değil, istek işlenemedi. İstek ID: " << request.requestId);
             // Modeli yüklü değilse, hata yanıtı dön ve devam et, uygulamayı durdurma.
             if (request.requestType == LlamaRequestType::INFERENCE) {
@@ -64,6 +96,8 @@ void LlamaWorker::processRequests() {
             std::vector<float> embedding = llm_engine_.get_embedding(request.prompt);
             
             auto t1 = std::chrono::steady_clock::now();
+            worker_metrics().embedding_requests.inc();
+            worker_metrics().embedding_latency.record_duration(t1 - t0);
             double latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
             LOG_DEFAULT(LogLevel::INFO, "LlamaWorker: Embedding tamamlandı. Latency: " << latency_ms << "ms. ID: " << request.requestId);
 
@@ -73,16 +107,36 @@ void LlamaWorker::processRequests() {
             }
             emit embeddingReady(QString::fromStdString(request.requestId), embedding);
         } else { // Inference Request
+            if (request.stream && request.stream->is_cancelled()) {
+                // Kuyrukta beklerken iptal edilen istek için model hiç çalıştırılmaz.
+                request.stream->finish();
+                ChatResponse cancelled_response;
+                cancelled_response.reasoning = "LLM Inference (iptal edildi)";
+                cancelled_response.cancelled = true;
+                emit llamaResponseReady(QString::fromStdString(request.requestId), cancelled_response);
+                continue;
+            }
             LOG_DEFAULT(LogLevel::INFO, "LlamaWorker: Inference isteği işleniyor. Prompt: " << request.prompt.substr(0, std::min((size_t)50, request.prompt.length())) << "...");
-            std::string llm_raw_response_text = llm_engine_.generate(request.prompt, request.config);
+            std::string llm_raw_response_text = request.stream
+                ? llm_engine_.generate(request.prompt, request.config, request.stream->callback())
+                : llm_engine_.generate(request.prompt, request.config);
 
             auto t1 = std::chrono::steady_clock::now();
+            worker_metrics().inference_requests.inc();
+            worker_metrics().inference_latency.record_duration(t1 - t0);
             double latency_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
 
             ChatResponse response;
             response.text = llm_raw_response_text;
             response.reasoning = "LLM Inference"; // Basit bir gerekçe
             response.latency_ms = latency_ms;
+            if (request.stream) {
+                request.stream->finish();
+                const TokenStreamStats stream_stats = request.stream->stats();
+                response.ttft_ms = stream_stats.ttft_ms;
+                response.tokens_per_second = stream_stats.tokens_per_second;
+                response.cancelled = request.stream->is_cancelled();
+            }
 
             // TODO: LLM'den gelen yanıttan suggested_questions ve reasoning'i parse et
             // Şimdilik boş bırakılıyor.
@@ -13,6 +13,7 @@
 #include <atomic> // std::atomic için
 
 #include "llm_engine.h" // LLMEngine'i kullanacak
+#include "token_stream.h" // Akışlı (streaming) inference için
 #include "../gui/DataTypes.h" // ChatResponse için
 #include "../core/enums.h" // LlamaRequestType ve CryptofigAutoencoder::INPUT_DIM için (dolaylı olarak)
 
@@ -38,6 +39,8 @@ struct LlamaRequest {
     std::string requestId; // Yanıtı MainWindow'a eşlemek için
     CerebrumLux::LlamaRequestType requestType; // İstek tipi (inference veya embedding)
     LLMGenerationConfig config; // Generate için konfigürasyon
+    // Ayarlanırsa üretilen token'lar bu akışa yazılır; akış iptal edilirse üretim durdurulur.
+    std::shared_ptr<TokenStream> stream;
 };
 
 class LlamaWorker : public QObject {
@@ -63,6 +66,7 @@ public slots:
 private:
     LLMEngine& llm_engine_; // LLMEngine referansı (LlamaWorker'a dışarıdan verilir)
     QQueue<LlamaRequest> request_queue_;
+    QQueue<std::chrono::steady_clock::time_point> enqueue_times_; // Kuyruk bekleme süresi metriği için (request_queue_ ile paralel)
     QMutex mutex_; // Kuyruk erişimi için mutex
     QWaitCondition condition_; // İstek geldiğinde iş parçacığını uyandırmak için
 
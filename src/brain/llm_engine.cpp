@@ -1,17 +1,45 @@
 #include "llm_engine.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
 #include "../learning/UnicodeSanitizer.h" // EKLENDİ
 #include <iostream>
 #include <vector>
 #include <cstring>
 #include <algorithm>
 #include <cmath> // sqrt ve pow için
+#include <chrono> // TTFT ve token/s ölçümü için
 
 namespace CerebrumLux {
 
 // Statik backend başlatma bayrağı
 static bool g_llama_backend_initialized = false;
 
+namespace {
+
+struct GenerationMetrics {
+    Metrics::Histogram& ttft = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llm_time_to_first_token_seconds", "generate çağrısından ilk token'a kadar geçen süre (prompt çözümleme dahil)");
+    Metrics::Histogram& token_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llm_token_seconds", "Token başına üretim süresi (ilk token hariç)");
+    Metrics::Gauge& tokens_per_second = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_llm_tokens_per_second", "Son generate çağrısının çözümleme hızı");
+    Metrics::Counter& tokens = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llm_generated_tokens_total", "Üretilen toplam token sayısı");
+    Metrics::Counter& cancelled = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llm_cancelled_total", "Callback tarafından durdurulan generate çağrıları");
+    Metrics::Histogram& grammar_mask = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_llm_grammar_mask_seconds", "Dilbilgisi kısıtlı örneklemede adım başına token maskesi süresi");
+    Metrics::Counter& grammar_incomplete = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_llm_grammar_incomplete_total", "Belge tamamlanmadan biten dilbilgisi kısıtlı generate çağrıları");
+};
+
+GenerationMetrics& generation_metrics() {
+    static GenerationMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
 // YENİ: Global instance tanımı
 LLMEngine* LLMEngine::global_instance = nullptr;
 
@@ -78,6 +106,8 @@ void LLMEngine::unload_model() {
     std::lock_guard<std::recursive_mutex> lock(engine_mutex); // KİLİT
     if (ctx) { llama_free(ctx); ctx = nullptr; } // ctx null kontrolü içerde
     if (model) { llama_free_model(model); model = nullptr; } // model null kontrolü içerde
+    vocab_pieces.clear();
+    for (auto& tokens : vocab_by_first_byte) tokens.clear();
 }
 
 std::vector<llama_token> LLMEngine::tokenize(const std::string& text, bool add_bos) {
@@ -100,6 +130,21 @@ std::string LLMEngine::token_to_str(llama_token token) {
     return std::string(buf, n);
 }
 
+void LLMEngine::build_grammar_vocab() {
+    // Kilitli generate içinden çağrılır.
+    const int n_vocab = llama_n_vocab(model);
+    vocab_pieces.assign(n_vocab, std::string());
+    for (auto& tokens : vocab_by_first_byte) tokens.clear();
+    char buf[256];
+    for (llama_token token = 0; token < n_vocab; ++token) {
+        // special=false: kontrol tokenları (BOS/EOS vb.) boş döner ve maskede hiç aday olmaz.
+        const int n = llama_token_to_piece(model, token, buf, sizeof(buf), 0, false);
+        if (n <= 0) continue;
+        vocab_pieces[token].assign(buf, n);
+        vocab_by_first_byte[static_cast<unsigned char>(buf[0])].push_back(token);
+    }
+}
+
 // YENİ: Embedding Üretim Fonksiyonu
 std::vector<float> LLMEngine::get_embedding(const std::string& text) { 
     UnicodeSanitizer sanitizer;
@@ -179,21 +224,36 @@ std::vector<float> CerebrumLux::LLMEngine::reduce_embedding_dimension(const std:
 std::string LLMEngine::generate(const std::string& prompt, 
                                 const LLMGenerationConfig& config,
                                 std::function<bool(const std::string&)> callback) {
+    const auto t_start = std::chrono::steady_clock::now();
     UnicodeSanitizer sanitizer;
     std::string sanitized_prompt = sanitizer.sanitize(prompt);
     std::lock_guard<std::recursive_mutex> lock(engine_mutex); // KİLİT
     if (!model || !ctx) return {};
 
     std::vector<llama_token> tokens_list = tokenize(sanitized_prompt, true);
-    
+    int max_tokens = config.max_tokens;
+
     // --- GÜVENLİK YAMASI: BUFFER OVERFLOW ENGELLEME ---
-    const int max_prompt_tokens = n_ctx - config.max_tokens;
+    // Prompt, istenen çıktı bütçesine yer kalacak şekilde kırpılır. Kırpma ortadan yapılır: promptun sonu genellikle
+    // talimattır (ör. "yalnızca JSON döndür") ve kaybolmamalı; baştaki BOS ve bağlam girişi de korunur.
+    const int max_prompt_tokens = std::max(1, n_ctx - max_tokens);
     if (tokens_list.size() > (size_t)max_prompt_tokens) {
-        LOG_DEFAULT(LogLevel::WARNING, "LLMEngine: Prompt çok uzun (" << tokens_list.size() << " token), kırpılıyor.");
-        tokens_list.resize(max_prompt_tokens);
+        LOG_DEFAULT(LogLevel::WARNING, "LLMEngine: Prompt çok uzun (" << tokens_list.size() << " token), ortadan kırpılıyor.");
+        const std::size_t tail = std::min<std::size_t>(kPromptTailTokens, max_prompt_tokens / 2);
+        const std::size_t head = max_prompt_tokens - tail;
+        tokens_list.erase(tokens_list.begin() + head, tokens_list.end() - tail);
     }
     // --------------------------------------------------
 
+    // Kısıtlı üretimde bütçe en uzun geçerli belgeye yetecek kadar büyütülür (her token en az bir karakter), böylece
+    // çıktı max_tokens yüzünden yarım kalıp yeniden denenmek zorunda kalmaz. Büyütme yalnızca promptun bıraktığı
+    // yeri kullanır; belge sınırı için prompt kırpılmaz.
+    if (config.grammar) {
+        const std::size_t room = static_cast<std::size_t>(n_ctx) - tokens_list.size();
+        const std::size_t document_bound = std::min<std::size_t>(config.grammar->max_document_length(), room);
+        max_tokens = std::max(max_tokens, static_cast<int>(document_bound));
+    }
+
     llama_kv_cache_clear(ctx); // KV cache'i temizliyoruz (Yeni prompt için)
 
     llama_batch batch = llama_batch_init(n_ctx, 0, 1);
@@ -213,21 +273,52 @@ std::string LLMEngine::generate(const std::string& prompt,
         return "";
     }
 
+    const JsonGrammar* grammar = config.grammar.get();
+    JsonGrammar::State grammar_state;
+    if (grammar) {
+        grammar_state = grammar->initial_state();
+        if (vocab_pieces.empty()) build_grammar_vocab();
+    }
+
     int n_cur = batch.n_tokens;
     int n_decode = 0;
     std::string full_response = "";
     std::vector<llama_token> last_n_tokens(64, 0); 
+    auto t_first_token = t_start;
+    auto t_last_token = t_start;
 
-    while (n_decode < config.max_tokens) {
+    while (n_decode < max_tokens) {
         if (n_cur >= n_ctx) break; // Context dolduysa dur
 
         auto* logits = llama_get_logits_ith(ctx, batch.n_tokens - 1);
         int n_vocab = llama_n_vocab(model);
 
         std::vector<llama_token_data> candidates;
-        candidates.reserve(n_vocab);
-        for (int token_id = 0; token_id < n_vocab; token_id++) {
-            candidates.emplace_back(llama_token_data{token_id, logits[token_id], 0.0f});
+        if (grammar) {
+            // Token maskesi: yalnızca metni dilbilgisi durumundan kabul edilen tokenlar aday olur.
+            const auto t_mask = std::chrono::steady_clock::now();
+            for (int byte = 0; byte < 256; ++byte) {
+                const std::vector<llama_token>& group = vocab_by_first_byte[byte];
+                if (group.empty()) continue;
+                JsonGrammar::State probe = grammar_state;
+                if (!grammar->advance(probe, static_cast<unsigned char>(byte))) continue;
+                for (llama_token token_id : group) {
+                    probe = grammar_state;
+                    if (grammar->advance(probe, vocab_pieces[token_id])) {
+                        candidates.emplace_back(llama_token_data{token_id, logits[token_id], 0.0f});
+                    }
+                }
+            }
+            generation_metrics().grammar_mask.record_duration(std::chrono::steady_clock::now() - t_mask);
+            if (candidates.empty()) {
+                LOG_ERROR_CERR(LogLevel::WARNING, "LLMEngine: Dilbilgisine uyan aday token kalmadı, üretim durduruluyor.");
+                break;
+            }
+        } else {
+            candidates.reserve(n_vocab);
+            for (int token_id = 0; token_id < n_vocab; token_id++) {
+                candidates.emplace_back(llama_token_data{token_id, logits[token_id], 0.0f});
+            }
         }
         llama_token_data_array candidates_p = { candidates.data(), candidates.size(), false };
 
@@ -239,9 +330,31 @@ std::string LLMEngine::generate(const std::string& prompt,
 
         if (new_token_id == llama_token_eos(model)) break;
 
-        std::string piece = token_to_str(new_token_id);
+        std::string piece = grammar ? vocab_pieces[new_token_id] : token_to_str(new_token_id);
         full_response += piece;
-        if (callback && !callback(piece)) break;
+        if (grammar) grammar->advance(grammar_state, piece); // Aday maskeden geçtiği için her zaman kabul edilir
+
+        const auto t_token = std::chrono::steady_clock::now();
+        if (n_decode == 0) {
+            t_first_token = t_token;
+            generation_metrics().ttft.record_duration(t_token - t_start);
+        } else {
+            generation_metrics().token_latency.record_duration(t_token - t_last_token);
+        }
+        t_last_token = t_token;
+        generation_metrics().tokens.inc();
+
+        if (callback && !callback(piece)) {
+            generation_metrics().cancelled.inc();
+            n_decode++;
+            break;
+        }
+
+        // Yapılandırılmış çıktı tamamlandı: EOS'u veya max_tokens'ı beklemeden dur.
+        if (grammar && grammar->complete(grammar_state)) {
+            n_decode++;
+            break;
+        }
 
         batch.n_tokens = 0;
         batch.token[0] = new_token_id;
@@ -261,6 +374,21 @@ std::string LLMEngine::generate(const std::string& prompt,
     }
 
     llama_batch_free(batch);
+
+    if (grammar && !grammar->complete(grammar_state)) {
+        generation_metrics().grammar_incomplete.inc();
+        LOG_DEFAULT(LogLevel::WARNING, "LLMEngine: Kısıtlı üretim belge tamamlanmadan bitti (" << n_decode << " token).");
+    }
+
+    if (n_decode > 1) {
+        const double decode_s = std::chrono::duration<double>(t_last_token - t_first_token).count();
+        if (decode_s > 0.0) {
+            const double tps = (n_decode - 1) / decode_s;
+            generation_metrics().tokens_per_second.set(tps);
+            const double ttft_ms = std::chrono::duration<double, std::milli>(t_first_token - t_start).count();
+            LOG_DEFAULT(LogLevel::DEBUG, "LLMEngine: " << n_decode << " token, TTFT: " << ttft_ms << " ms, " << tps << " token/s");
+        }
+    }
     return sanitizer.sanitize(full_response);
 }
 
@@ -8,6 +8,9 @@
 #include <atomic>
 #include <thread>
 #include <mutex> // EKLENDİ: std::recursive_mutex için
+#include <array>
+
+#include "json_grammar.h"
 
 // llama.cpp başlık dosyası
 #include "llama.h" 
@@ -20,6 +23,9 @@ struct LLMGenerationConfig {
     float top_p = 0.9f;
     int top_k = 40;
     float repeat_penalty = 1.1f;
+    // Doluysa çıktı bu dilbilgisine uyan JSON ile sınırlanır (örnekleyicide token maskesi) ve belge tamamlanınca
+    // üretim durur. Şema başına derleme için JsonGrammar::cached kullanın.
+    std::shared_ptr<const JsonGrammar> grammar;
 };
 
 class LLMEngine {
@@ -60,11 +66,20 @@ private:
     
     // Model parametreleri
     int n_ctx = 2048; 
+    // Uzun prompt ortadan kırpılırken sondan korunan token sayısı (talimat kısmı).
+    static constexpr std::size_t kPromptTailTokens = 128;
     int n_threads = std::thread::hardware_concurrency(); 
 
     // Tokenizer yardımcıları
     std::vector<llama_token> tokenize(const std::string& text, bool add_bos);
     std::string token_to_str(llama_token token);
+
+    // Dilbilgisi maskesi için model başına bir kez çıkarılan sözlük: token metinleri (özel tokenlar boş) ve ilk
+    // baytlarına göre gruplanmış tokenlar. Her adımda önce 256 bayt denenir, yalnızca kabul edilen ilk bayta
+    // sahip tokenlar tam olarak sınanır.
+    std::vector<std::string> vocab_pieces;
+    std::array<std::vector<llama_token>, 256> vocab_by_first_byte;
+    void build_grammar_vocab();
 };
 
 } // namespace CerebrumLux
@@ -0,0 +1,58 @@
+#include "token_stream.h"
+
+namespace CerebrumLux {
+
+TokenStream::TokenStream() : created_at_(Clock::now()) {}
+
+bool TokenStream::push(const std::string& piece) {
+    if (is_cancelled()) return false;
+    const auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (token_count_ == 0) first_token_at_ = now;
+        last_token_at_ = now;
+        ++token_count_;
+        pending_ += piece;
+    }
+    has_pending_.store(true, std::memory_order_release);
+    return !is_cancelled();
+}
+
+void TokenStream::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_at_ = Clock::now();
+    }
+    finished_.store(true, std::memory_order_release);
+}
+
+std::function<bool(const std::string&)> TokenStream::callback() {
+    return [this](const std::string& piece) { return push(piece); };
+}
+
+std::string TokenStream::take_pending() {
+    std::string out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.swap(pending_);
+    has_pending_.store(false, std::memory_order_release);
+    return out;
+}
+
+TokenStreamStats TokenStream::stats() const {
+    using Ms = std::chrono::duration<double, std::milli>;
+    TokenStreamStats s;
+    std::lock_guard<std::mutex> lock(mutex_);
+    s.token_count = token_count_;
+    const auto end = is_finished() ? finished_at_ : Clock::now();
+    s.elapsed_ms = Ms(end - created_at_).count();
+    if (token_count_ > 0) {
+        s.ttft_ms = Ms(first_token_at_ - created_at_).count();
+        const double decode_s = std::chrono::duration<double>(last_token_at_ - first_token_at_).count();
+        if (token_count_ > 1 && decode_s > 0.0) {
+            s.tokens_per_second = static_cast<double>(token_count_ - 1) / decode_s;
+        }
+    }
+    return s;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,65 @@
+#ifndef CEREBRUM_LUX_TOKEN_STREAM_H
+#define CEREBRUM_LUX_TOKEN_STREAM_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace CerebrumLux {
+
+struct TokenStreamStats {
+    std::size_t token_count = 0;
+    double ttft_ms = 0.0;           // İsteğin oluşturulmasından ilk token'a kadar geçen süre
+    double tokens_per_second = 0.0; // İlk token'dan sonraki çözümleme hızı
+    double elapsed_ms = 0.0;
+};
+
+// LLM üretimini token token GUI'ye taşıyan, thread-safe akış tamponu.
+//
+// Üretici (LLM thread'i) push() ile parçaları ekler; tüketici (GUI thread'i) take_pending() ile biriken
+// metni tek seferde alır. Böylece GUI her token için değil, her çizim karesinde bir kez güncellenir.
+// cancel() sonraki push() çağrısının false dönmesini sağlar; LLMEngine::generate bu durumda üretimi keser.
+class TokenStream {
+public:
+    TokenStream();
+
+    // --- Üretici tarafı ---
+    // false: akış iptal edildi, üretim durdurulmalı.
+    bool push(const std::string& piece);
+    void finish();
+    // LLMEngine::generate'in callback parametresine doğrudan verilebilir.
+    std::function<bool(const std::string&)> callback();
+
+    // --- Tüketici tarafı ---
+    // Son çağrıdan bu yana biriken metni döndürür ve tamponu boşaltır.
+    std::string take_pending();
+    bool has_pending() const { return has_pending_.load(std::memory_order_acquire); }
+    bool is_finished() const { return finished_.load(std::memory_order_acquire); }
+
+    void cancel() { cancelled_.store(true, std::memory_order_release); }
+    bool is_cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+    TokenStreamStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    mutable std::mutex mutex_;
+    std::string pending_;
+    std::size_t token_count_ = 0;
+    Clock::time_point created_at_;
+    Clock::time_point first_token_at_;
+    Clock::time_point last_token_at_;
+    Clock::time_point finished_at_;
+
+    std::atomic<bool> has_pending_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<bool> cancelled_{false};
+};
+
+} // namespace CerebrumLux
+
+#endif // CEREBRUM_LUX_TOKEN_STREAM_H
@@ -1,5 +1,6 @@
 // AIInsightsEngine.cpp
 #include "ai_insights_engine.h"
+#include "insight_batch.h"
 #include "../core/logger.h"
 #include "../core/enums.h" // InsightType, UrgencyLevel, UserIntent, AIAction, KnowledgeTopic, InsightSeverity için
 #include "../core/utils.h" // intent_to_string, SafeRNG için
@@ -463,11 +464,10 @@ std::vector<AIInsight> AIInsightsEngine::generateGeneralNonCodeDevelopmentInsigh
 }
 
 // === Insight generation ana metodu (Refaktör Edilmiş) ===
-std::string AIInsightsEngine::generate_insights(const DynamicSequence& current_sequence) {
+void AIInsightsEngine::generate_insights(const DynamicSequence& current_sequence, InsightBatch& out) {
     LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine::generate_insights: Yeni içgörüler üretiliyor.");
     auto now = std::chrono::system_clock::now();
-    std::vector<AIInsight> insights_vector;
-    bool code_dev_insight_generated = false;
+    out.begin_tick(++insight_tick);
 
     // Adım 1: Simüle kod metriklerini güncelle
     updateSimulatedCodeMetrics(now);
@@ -477,48 +477,40 @@ std::string AIInsightsEngine::generate_insights(const DynamicSequence& current_s
     std::vector<AIInsight> code_analysis_insights = generateCodeAnalysisInsights(current_sequence, now);
     std::vector<AIInsight> simulated_metric_code_dev_insights = generateSimulatedMetricCodeDevelopmentInsights(current_sequence, now);
 
-    insights_vector.insert(insights_vector.end(), std::make_move_iterator(code_analysis_insights.begin()), std::make_move_iterator(code_analysis_insights.end()));
-    insights_vector.insert(insights_vector.end(), std::make_move_iterator(simulated_metric_code_dev_insights.begin()), std::make_move_iterator(simulated_metric_code_dev_insights.end()));
-
-    if (!insights_vector.empty()) {
-        code_dev_insight_generated = true;
-    }
+    for (auto& insight : code_analysis_insights) out.push(std::move(insight));
+    for (auto& insight : simulated_metric_code_dev_insights) out.push(std::move(insight));
 
-    if (code_dev_insight_generated) {
-        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "AIInsightsEngine::generate_insights: CodeDev içgörüler üretildi (" << insights_vector.size() << " adet). Diğer içgörüler ATLANDI.\n");
-        for (const auto& insight : insights_vector) {
-            LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine: DÖNÜŞ İÇGÖRÜSÜ (Özet): ID=" << insight.id
-                                  << ", Type=" << static_cast<int>(insight.type)
-                                  << ", Context=" << insight.context << ", FilePath=" << insight.code_file_path);
-            if (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion) {
-                LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "AIInsightsEngine: !!! DÖNÜŞ İÇGÖRÜSÜ CodeDev TESPİT EDİLDİ: ID=" << insight.id << ", FilePath=" << insight.code_file_path);
-            }
-        }
-        nlohmann::json j = insights_vector;
-        std::string result_json_str = j.dump();
-        LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine: DÖNÜŞ JSON STRING (Tam - CodeDev Öncelikli): " << result_json_str.substr(0, std::min(result_json_str.length(), (size_t)500)));
-        return result_json_str;
+    if (!out.empty()) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "AIInsightsEngine::generate_insights: CodeDev içgörüler üretildi (" << out.size() << " adet). Diğer içgörüler ATLANDI.\n");
     }
     // Adım 3: Eğer CodeDev içgörüsü üretilmediyse, genel içgörüler üret
     else {
         std::vector<AIInsight> general_non_code_dev_insights = generateGeneralNonCodeDevelopmentInsights(current_sequence, now);
-        insights_vector.insert(insights_vector.end(), std::make_move_iterator(general_non_code_dev_insights.begin()), std::make_move_iterator(general_non_code_dev_insights.end()));
+        for (auto& insight : general_non_code_dev_insights) out.push(std::move(insight));
+    }
+
+    LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine::generate_insights: İçgörü üretimi bitti. Sayı: " << out.size() << "\n");
+    if (out.dropped() > 0) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "AIInsightsEngine::generate_insights: İçgörü halkası doldu, en eski " << out.dropped() << " içgörü düşürüldü.");
     }
-    
-    LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine::generate_insights: İçgörü üretimi bitti. Sayı: " << insights_vector.size() << "\n");
 
     // Metottan dönmeden önce tüm üretilen içgörüleri özetle (LOG SEVİYESİ TRACE)
-    for (const auto& insight : insights_vector) {
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const AIInsight& insight = out.insight(i);
         LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "AIInsightsEngine: DÖNÜŞ İÇGÖRÜSÜ (Özet): ID=" << insight.id
                                   << ", Type=" << static_cast<int>(insight.type)
                                   << ", Context=" << insight.context << ", FilePath=" << insight.code_file_path);
         if (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion) {
             LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "AIInsightsEngine: !!! DÖNÜŞ İÇGÖRÜSÜ CodeDev TESPİT EDİLDİ: ID=" << insight.id << ", FilePath=" << insight.code_file_path);
-        }                          
+        }
     }
-    
-    nlohmann::json j = insights_vector;
-    return j.dump();
+}
+
+// GUI ve dışa aktarım için JSON sarmalayıcısı; motor içi tüketiciler InsightBatch sürümünü kullanır.
+std::string AIInsightsEngine::generate_insights(const DynamicSequence& current_sequence) {
+    InsightBatch batch;
+    generate_insights(current_sequence, batch);
+    return batch.to_json();
 }
 
 // Cooldown kontrolü
@@ -7,6 +7,7 @@
 #include <vector>
 #include <map> // Cooldown mekanizması için
 #include <chrono> // Cooldown mekanizması için
+#include <cstdint>
 
 #include "../brain/intent_analyzer.h"
 #include "../brain/intent_learner.h"
@@ -121,6 +122,8 @@ struct AIInsight {
     }
 };
 
+class InsightBatch; // insight_batch.h
+
 // AI Insights Engine sınıfı
 class AIInsightsEngine {
 public:
@@ -128,7 +131,9 @@ public:
                      CryptofigAutoencoder& autoencoder, CryptofigProcessor& cryptofig_processor);
 
 
-    // ABI uyumluluğu ve modül bağımsızlığı için JSON string'i döndürür.
+    // Motor içi tipli yol: içgörüler out'a yazılır (out.begin_tick ile önceki içerik silinir).
+    void generate_insights(const DynamicSequence& current_sequence, InsightBatch& out);
+    // GUI/dışa aktarım için JSON string'i döndürür.
     std::string generate_insights(const DynamicSequence& current_sequence);
     
     float calculate_autoencoder_reconstruction_error(const std::vector<float>& statistical_features) const;
@@ -170,6 +175,8 @@ private:
     float last_simulated_code_complexity = 0.95f;
     float last_simulated_code_readability = 0.25f;
     float last_simulated_optimization_potential = 0.85f;
+
+    std::uint64_t insight_tick = 0; // InsightBatch kayıtlarındaki döngü numarası
 };
 
 } // namespace CerebrumLux
@@ -0,0 +1,140 @@
+#include "context_packer.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "../learning/CapsuleTextIndex.h"
+
+namespace CerebrumLux {
+
+namespace {
+
+bool is_meaningless(const std::string& text) {
+    return text.empty() ||
+           text.find("Is this data relevant to AI Insight?") != std::string::npos ||
+           text.find("Bilgi bulunamadı.") != std::string::npos;
+}
+
+// UTF-8 çok baytlı karakteri bölmeden en fazla max_bytes uzunluğunda önek.
+std::size_t utf8_prefix_length(const std::string& text, std::size_t max_bytes) {
+    if (max_bytes >= text.size()) return text.size();
+    std::size_t len = max_bytes;
+    while (len > 0 && (static_cast<unsigned char>(text[len]) & 0xC0) == 0x80) --len;
+    return len;
+}
+
+// Metni cümle sınırlarından (. ! ? satır sonu) böler; ayraçlar cümlede kalır.
+std::vector<std::pair<std::size_t, std::size_t>> split_sentences(const std::string& text) {
+    std::vector<std::pair<std::size_t, std::size_t>> sentences;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '.' || c == '!' || c == '?' || c == '\n') {
+            sentences.emplace_back(start, i + 1);
+            start = i + 1;
+        }
+    }
+    if (start < text.size()) sentences.emplace_back(start, text.size());
+    return sentences;
+}
+
+} // namespace
+
+ContextPacker::ContextPacker(ContextPackerOptions options) : options_(std::move(options)) {}
+
+std::size_t ContextPacker::estimate_tokens(const std::string& text) {
+    std::size_t words = 0;
+    bool in_word = false;
+    for (unsigned char c : text) {
+        const bool space = c == ' ' || c == '\n' || c == '\t' || c == '\r';
+        if (!space && !in_word) ++words;
+        in_word = !space;
+    }
+    return std::max(words, (text.size() + 3) / 4);
+}
+
+std::string ContextPacker::display_text(const Capsule& capsule) {
+    if (!is_meaningless(capsule.content)) return capsule.content;
+    if (!is_meaningless(capsule.plain_text_summary)) return capsule.plain_text_summary;
+    return "";
+}
+
+std::size_t ContextPacker::count_tokens(const std::string& text) const {
+    return options_.token_counter ? options_.token_counter(text) : estimate_tokens(text);
+}
+
+std::string ContextPacker::best_window(const std::string& text, const std::vector<std::string>& query_terms,
+                                       std::size_t max_tokens, bool& truncated) const {
+    truncated = false;
+    if (count_tokens(text) <= max_tokens) return text;
+
+    const auto sentences = split_sentences(text);
+    const std::unordered_set<std::string> terms(query_terms.begin(), query_terms.end());
+
+    // Sorgu terimlerinin en çok geçtiği cümleden başla; eşitlikte önceki cümle kazanır.
+    std::size_t best = 0;
+    std::size_t best_hits = 0;
+    if (!terms.empty()) {
+        for (std::size_t i = 0; i < sentences.size(); ++i) {
+            std::size_t hits = 0;
+            for (const std::string& token : CapsuleTextIndex::tokenize(text.substr(sentences[i].first, sentences[i].second - sentences[i].first))) {
+                hits += terms.count(token);
+            }
+            if (hits > best_hits) {
+                best_hits = hits;
+                best = i;
+            }
+        }
+    }
+
+    truncated = true;
+    // Kesim işaretleri ("...") de bütçeden sayılır.
+    const std::string lead = best > 0 ? "..." : "";
+    auto fits = [&](const std::string& body) { return count_tokens(lead + body + "...") <= max_tokens; };
+    std::string window;
+    std::size_t end = best; // Pencereye giren son cümleden sonraki cümle
+    for (; end < sentences.size(); ++end) {
+        std::string candidate = window + text.substr(sentences[end].first, sentences[end].second - sentences[end].first);
+        if (!fits(candidate)) break;
+        window = std::move(candidate);
+    }
+    if (window.empty()) {
+        // Tek cümle bile sığmıyor: bayt sınırından (UTF-8 güvenli) kes; ~4 bayt/token tahmini sayaçla doğrulanır.
+        const std::string sentence = text.substr(sentences[best].first, sentences[best].second - sentences[best].first);
+        std::size_t len = utf8_prefix_length(sentence, max_tokens * 4);
+        while (len > 0 && !fits(sentence.substr(0, len))) len = utf8_prefix_length(sentence, len - 1);
+        window = sentence.substr(0, len);
+    }
+
+    const std::size_t first = window.find_first_not_of(" \t\r\n");
+    window = first == std::string::npos ? std::string() : window.substr(first);
+    if (best > 0) window = "..." + window;
+    // Pencere metnin sonuna kadar uzanıyorsa sonda kesilen bir şey yoktur.
+    return end == sentences.size() ? window : window + "...";
+}
+
+PackedContext ContextPacker::pack(const std::vector<Capsule>& ranked, const std::string& query) const {
+    PackedContext packed;
+    const std::vector<std::string> query_terms = CapsuleTextIndex::tokenize(query);
+    std::unordered_set<std::string> seen_texts;
+
+    for (std::size_t i = 0; i < ranked.size(); ++i) {
+        const std::string text = display_text(ranked[i]);
+        const std::size_t remaining = options_.token_budget - std::min(options_.token_budget, packed.used_tokens);
+        if (text.empty() || packed.items.size() >= options_.max_capsules ||
+            remaining < options_.min_tokens_per_capsule || !seen_texts.insert(text).second) {
+            packed.leftover.push_back(i);
+            continue;
+        }
+
+        PackedCapsule item;
+        item.index = i;
+        item.snippet = best_window(text, query_terms, std::min(remaining, options_.max_tokens_per_capsule), item.truncated);
+        item.tokens = count_tokens(item.snippet);
+        packed.used_tokens += item.tokens;
+        packed.items.push_back(std::move(item));
+    }
+    return packed;
+}
+
+} // namespace CerebrumLux
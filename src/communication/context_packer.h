@@ -0,0 +1,59 @@
+#ifndef CONTEXT_PACKER_H
+#define CONTEXT_PACKER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../learning/Capsule.h"
+
+namespace CerebrumLux {
+
+struct ContextPackerOptions {
+    std::size_t token_budget = 384;           // Yanıta/prompt'a giren tüm kapsül parçalarının toplam token bütçesi
+    std::size_t max_capsules = 3;
+    std::size_t max_tokens_per_capsule = 160; // Tek bir kapsülün alabileceği en fazla pay
+    std::size_t min_tokens_per_capsule = 24;  // Bundan az yer kaldıysa kapsül kırpılmak yerine atlanır
+    // Token sayacı (ör. modelin tokenizer'ı). Boşsa estimate_tokens kullanılır.
+    std::function<std::size_t(const std::string&)> token_counter;
+};
+
+struct PackedCapsule {
+    std::size_t index = 0; // Girdi listesindeki sıra
+    std::string snippet;
+    std::size_t tokens = 0;
+    bool truncated = false;
+};
+
+struct PackedContext {
+    std::vector<PackedCapsule> items;   // Sıralama korunur
+    std::vector<std::size_t> leftover;  // Bütçeye sığmayan / tekrar eden kapsüllerin indeksleri
+    std::size_t used_tokens = 0;
+};
+
+// Sıralı kapsül listesinden token bütçesine sığan en iyi parçaları seçer.
+// Her kapsül için sorgu terimlerinin en yoğun geçtiği cümle penceresi seçilir (içeriğin başı değil); aynı içeriğe
+// sahip kapsüller bir kez alınır. Anlamsız içerik (boş, "Bilgi bulunamadı." vb.) özetle değiştirilir.
+class ContextPacker {
+public:
+    explicit ContextPacker(ContextPackerOptions options = {});
+
+    PackedContext pack(const std::vector<Capsule>& ranked, const std::string& query) const;
+
+    // Tokenizer yokken kaba tahmin: UTF-8 metin için ~4 bayt/token, en az kelime sayısı kadar.
+    static std::size_t estimate_tokens(const std::string& text);
+
+    // Kapsülün gösterilebilir metni; içerik anlamsızsa özet, o da yoksa boş döner.
+    static std::string display_text(const Capsule& capsule);
+
+private:
+    std::size_t count_tokens(const std::string& text) const;
+    std::string best_window(const std::string& text, const std::vector<std::string>& query_terms, std::size_t max_tokens, bool& truncated) const;
+
+    ContextPackerOptions options_;
+};
+
+} // namespace CerebrumLux
+
+#endif // CONTEXT_PACKER_H
@@ -3,19 +3,77 @@
 #include <algorithm> // std::transform için
 #include <sstream>   // std::stringstream için
 #include <cctype>    // std::tolower, std::ispunct için
+#include <atomic>
+#include <cmath>     // std::exp için
+#include <thread>
+#include "../core/task_scheduler.h"
 
 namespace CerebrumLux {
 
+// fasttext::FastText sözlük, model ve argümanları korumalı üyelerde tutar; toplu yol bunlara doğrudan erişir.
+class FastTextWrapper::Model : public fasttext::FastText {
+public:
+    const fasttext::Dictionary& dictionary() const { return *dict_; }
+    const fasttext::Model& model() const { return *model_; }
+    const fasttext::Args& args() const { return *args_; }
+    bool dictionary_pruned() const { return dict_->isPruned(); }
+};
+
+namespace {
+
+constexpr const char* kLabelPrefix = "__label__";
+
+// normalizeText ile classify_view'un ortak kuralı: ASCII küçük harf, noktalama atılır.
+void normalize_into(std::string_view text, std::string& out) {
+    out.clear();
+    out.reserve(text.size());
+    for (char ch : text) {
+        const unsigned char c = static_cast<unsigned char>(ch);
+        if (std::ispunct(c)) continue;
+        out.push_back(static_cast<char>(std::tolower(c)));
+    }
+}
+
+// fasttext::Dictionary::readWord ile aynı ayırıcılar.
+inline bool is_fasttext_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f' || c == '\0';
+}
+
+// İş parçacığı başına yeniden kullanılan arabellekler; ısındıktan sonra metin başına bellek ayrılmaz.
+struct BatchScratch {
+    std::string normalized;
+    std::string token;
+    std::string bounded; // BOW + belirteç + EOW (sözlük dışı kelimelerin alt kelimeleri için)
+    std::vector<int32_t> words;
+    std::vector<int32_t> word_hashes;
+    fasttext::Predictions predictions;
+    std::unique_ptr<fasttext::Model::State> state; // hidden/output/grad fasttext::Vector'leri
+};
+
+BatchScratch& batch_scratch() {
+    thread_local BatchScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
 // ----------------------------------------------------
 // FastTextWrapper Implementasyonu
 // ----------------------------------------------------
 
 FastTextWrapper::FastTextWrapper(const std::string &modelPath) {
-    ft_model_ = std::make_unique<fasttext::FastText>();
+    ft_model_ = std::make_unique<Model>();
     try {
         if (std::filesystem::exists(modelPath) && std::filesystem::file_size(modelPath) > 0) {
             ft_model_->loadModel(modelPath);
             is_model_loaded_ = true;
+            const fasttext::Dictionary& dict = ft_model_->dictionary();
+            labels_.reserve(static_cast<std::size_t>(dict.nlabels()));
+            for (int32_t i = 0; i < dict.nlabels(); ++i) {
+                std::string label = dict.getLabel(i);
+                if (label.rfind(kLabelPrefix, 0) == 0) label.erase(0, 9);
+                labels_.push_back(std::move(label));
+            }
             LOG_DEFAULT(LogLevel::INFO, "FastTextWrapper: Model başarıyla yüklendi: " << modelPath);
         } else {
             LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "FastTextWrapper: Model bulunamadi veya boş: " << modelPath);
@@ -65,13 +123,121 @@ FastTextResult FastTextWrapper::classify(const std::string &text) const {
 }
 
 std::string FastTextWrapper::normalizeText(const std::string& text) const {
-    std::string normalized = text;
-    // Küçük harfe çevir
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(),
-                   [](unsigned char c){ return static_cast<unsigned char>(std::tolower(c)); });
-    // Basit noktalama işaretlerini kaldırma
-    normalized.erase(std::remove_if(normalized.begin(), normalized.end(), [](char c){ return std::ispunct(c); }), normalized.end());
+    // Küçük harfe çevir ve basit noktalama işaretlerini kaldır
+    std::string normalized;
+    normalize_into(text, normalized);
     return normalized;
 }
 
+std::vector<FastTextResult> FastTextWrapper::classify_batch(const std::vector<std::string_view>& texts, std::size_t max_threads) const {
+    std::vector<FastTextResult> results(texts.size(), FastTextResult{"unknown", 0.0, {}});
+    if (texts.empty()) return results;
+    if (!is_model_loaded_) {
+        LOG_DEFAULT(LogLevel::WARNING, "FastTextWrapper: Model yüklü değil. " << texts.size() << " metinlik toplu sınıflandırma yapılamadı.");
+        return results;
+    }
+
+    // İş parçalar halinde ortak bir sayaçtan alınır: kısa ve uzun metinler karışık olsa da iş parçacıkları dengeli kalır.
+    constexpr std::size_t kChunk = 64;
+    const std::size_t chunks = (texts.size() + kChunk - 1) / kChunk;
+    const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    const std::size_t participants = std::min(chunks, max_threads > 0 ? max_threads : hardware);
+
+    TaskScheduler::instance().parallel_for(TaskClass::BackgroundLearning, chunks, [&](std::size_t chunk) {
+        const std::size_t end = std::min(texts.size(), (chunk + 1) * kChunk);
+        for (std::size_t i = chunk * kChunk; i < end; ++i) results[i] = classify_view(texts[i]);
+    }, participants);
+    LOG_DEFAULT(LogLevel::DEBUG, "FastTextWrapper: " << texts.size() << " metin " << participants << " iş parçacığıyla sınıflandırıldı.");
+    return results;
+}
+
+FastTextResult FastTextWrapper::classify_view(std::string_view text) const {
+    FastTextResult r{"unknown", 0.0, {}};
+    const fasttext::Dictionary& dict = ft_model_->dictionary();
+    const fasttext::Args& args = ft_model_->args();
+    if (args.model != fasttext::model_name::sup) return r;
+
+    BatchScratch& s = batch_scratch();
+    normalize_into(text, s.normalized);
+
+    // Budanmış (nicemlenmiş) sözlüklerde kelime n-gram kimlikleri sözlüğün iç tablosundan geçer; orada akış yolu kullanılır.
+    if (ft_model_->dictionary_pruned()) {
+        if (s.normalized.empty()) return r;
+        std::istringstream in(s.normalized);
+        std::vector<std::pair<fasttext::real, std::string>> predictions;
+        ft_model_->predictLine(in, predictions, 1, 0.0f);
+        if (!predictions.empty()) {
+            r.label = predictions[0].second.rfind(kLabelPrefix, 0) == 0 ? predictions[0].second.substr(9) : predictions[0].second;
+            r.confidence = static_cast<double>(predictions[0].first);
+        }
+        return r;
+    }
+
+    // Dictionary::getLine'ın akış yerine görünüm üzerindeki karşılığı: aynı kimlikleri aynı sırayla üretir.
+    s.words.clear();
+    s.word_hashes.clear();
+    auto add_token = [&](const std::string& token) {
+        const uint32_t h = dict.hash(token);
+        const int32_t wid = dict.getId(token, h);
+        const fasttext::entry_type type = wid < 0 ? dict.getType(token) : dict.getType(wid);
+        if (type != fasttext::entry_type::word) return; // Girdideki etiketler tahmine katılmaz
+        if (wid < 0) {
+            if (token != fasttext::Dictionary::EOS) {
+                s.bounded.assign(fasttext::Dictionary::BOW);
+                s.bounded.append(token);
+                s.bounded.append(fasttext::Dictionary::EOW);
+                dict.computeSubwords(s.bounded, s.words);
+            }
+        } else if (args.maxn <= 0) {
+            s.words.push_back(wid);
+        } else {
+            const std::vector<int32_t>& subwords = dict.getSubwords(wid);
+            s.words.insert(s.words.end(), subwords.begin(), subwords.end());
+        }
+        s.word_hashes.push_back(static_cast<int32_t>(h));
+    };
+
+    const std::string& line = s.normalized;
+    for (std::size_t i = 0; i < line.size();) {
+        if (line[i] == '\n') { // getLine ilk satır sonunda EOS ekleyip durur
+            s.token.assign(fasttext::Dictionary::EOS);
+            add_token(s.token);
+            break;
+        }
+        if (is_fasttext_space(line[i])) {
+            ++i;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < line.size() && !is_fasttext_space(line[end])) ++end;
+        s.token.assign(line, i, end - i);
+        add_token(s.token);
+        i = end;
+    }
+    if (args.bucket > 0) {
+        const int32_t nwords = dict.nwords();
+        for (std::size_t i = 0; i < s.word_hashes.size(); ++i) {
+            uint64_t h = static_cast<uint64_t>(s.word_hashes[i]);
+            for (std::size_t j = i + 1; j < s.word_hashes.size() && j < i + static_cast<std::size_t>(args.wordNgrams); ++j) {
+                h = h * 116049371 + static_cast<uint64_t>(s.word_hashes[j]);
+                s.words.push_back(nwords + static_cast<int32_t>(h % static_cast<uint64_t>(args.bucket)));
+            }
+        }
+    }
+    if (s.words.empty()) return r;
+
+    const int32_t outputs = static_cast<int32_t>(labels_.size());
+    if (!s.state || s.state->hidden.size() != args.dim || s.state->output.size() != outputs) {
+        s.state = std::make_unique<fasttext::Model::State>(args.dim, outputs, 0);
+    }
+    s.predictions.clear();
+    ft_model_->model().predict(s.words, 1, 0.0f, s.predictions, *s.state);
+    if (!s.predictions.empty()) {
+        // Model log-olasılık döndürür; predictLine gibi olasılığa çevrilir.
+        r.label = labels_[static_cast<std::size_t>(s.predictions[0].second)];
+        r.confidence = std::exp(static_cast<double>(s.predictions[0].first));
+    }
+    return r;
+}
+
 } // namespace CerebrumLux
\ No newline at end of file
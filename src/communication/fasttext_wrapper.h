@@ -2,6 +2,8 @@
 #define CEREBRUM_LUX_FASTTEXT_WRAPPER_H
 
 #include <string>
+#include <string_view>
+#include <vector>
 #include <memory>
 #include <filesystem> // std::filesystem için
 #include "../external/fasttext/include/fasttext.h" // FastText kütüphanesi için
@@ -28,12 +30,25 @@ public:
     // Metni sınıflandırır ve etiket + güven + isteğe bağlı kısa yanıt döndürür
     FastTextResult classify(const std::string &text) const;
 
+    // Toplu sınıflandırma (KB içe aktarma, müfredat koşuları). Sonuçlar classify() ile aynıdır ve girdi sırasıyla
+    // döner; metinler kopyalanmadan doğrudan görünümlerden belirteçlenir, her iş parçacığı kendi arabelleklerini
+    // yeniden kullanır ve iş ortak zamanlayıcıya (BackgroundLearning sınıfı, çağıran da katılır) dağıtılır.
+    // max_threads 0 ise donanım iş parçacığı sayısı; fiili paralellik ayrıca sınıf sınırıyla kısıtlanır.
+    // Görünümlerin gösterdiği metinler çağrı boyunca geçerli kalmalıdır.
+    std::vector<FastTextResult> classify_batch(const std::vector<std::string_view>& texts, std::size_t max_threads = 0) const;
+
     // FastText'in sınıflandırma için ihtiyaç duyduğu ön-işleme (küçük harf, noktalama kaldırma)
     std::string normalizeText(const std::string& text) const;
 
 private:
-    std::unique_ptr<fasttext::FastText> ft_model_; // FastText modelinin kendi instance'ı
+    class Model; // fasttext::FastText'in korumalı sözlük/model üyelerine erişen alt sınıf
+
+    // Tek bir metni iş parçacığına ait arabelleklerle sınıflandırır (classify_batch çekirdeği).
+    FastTextResult classify_view(std::string_view text) const;
+
+    std::unique_ptr<Model> ft_model_; // FastText modelinin kendi instance'ı
     bool is_model_loaded_ = false; // Modelin yüklü olup olmadığını gösterir
+    std::vector<std::string> labels_; // Etiket indeksine göre "__label__" öneki atılmış adlar (yüklemede bir kez)
 };
 
 } // namespace CerebrumLux
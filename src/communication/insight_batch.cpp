@@ -0,0 +1,77 @@
+#include "insight_batch.h"
+
+#include <algorithm>
+
+#include "../external/nlohmann/json.hpp"
+
+namespace CerebrumLux {
+
+InsightBatch::InsightBatch(std::size_t capacity)
+    : records_(std::max<std::size_t>(1, capacity)),
+      details_(std::max<std::size_t>(1, capacity)) {
+    for (std::size_t i = 0; i < records_.size(); ++i) {
+        records_[i] = {InsightType::None, UrgencyLevel::None, static_cast<std::uint32_t>(i), 0};
+    }
+}
+
+void InsightBatch::begin_tick(std::uint64_t tick) {
+    head_ = 0;
+    size_ = 0;
+    dropped_ = 0;
+    tick_ = tick;
+    type_counts_.fill(0);
+}
+
+std::size_t InsightBatch::claim_slot(InsightType type, UrgencyLevel urgency) {
+    std::size_t index;
+    if (size_ < records_.size()) {
+        index = physical_index(size_);
+        ++size_;
+    } else {
+        // Halka dolu: en eski kaydın yerine yaz.
+        index = head_;
+        --type_counts_[type_index(records_[index].type)];
+        head_ = (head_ + 1) % records_.size();
+        ++dropped_;
+    }
+    InsightRecord& rec = records_[index];
+    rec.type = type;
+    rec.urgency = urgency;
+    rec.tick = tick_;
+    ++type_counts_[type_index(type)];
+    return rec.slot;
+}
+
+void InsightBatch::push(AIInsight&& insight) {
+    const std::size_t slot = claim_slot(insight.type, insight.urgency);
+    details_[slot] = std::move(insight);
+}
+
+void InsightBatch::push(const AIInsight& insight) {
+    const std::size_t slot = claim_slot(insight.type, insight.urgency);
+    details_[slot] = insight;
+}
+
+bool InsightBatch::contains(InsightType type, UrgencyLevel urgency) const {
+    if (count(type) == 0) return false;
+    for (std::size_t i = 0; i < size_; ++i) {
+        const InsightRecord& rec = record(i);
+        if (rec.type == type && rec.urgency == urgency) return true;
+    }
+    return false;
+}
+
+std::vector<AIInsight> InsightBatch::to_vector() const {
+    std::vector<AIInsight> out;
+    out.reserve(size_);
+    for (std::size_t i = 0; i < size_; ++i) out.push_back(insight(i));
+    return out;
+}
+
+std::string InsightBatch::to_json() const {
+    nlohmann::json j = nlohmann::json::array();
+    for (std::size_t i = 0; i < size_; ++i) j.push_back(insight(i));
+    return j.dump();
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,79 @@
+#ifndef INSIGHT_BATCH_H
+#define INSIGHT_BATCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../core/enums.h"
+#include "ai_insights_engine.h" // AIInsight
+
+namespace CerebrumLux {
+
+// Tek bir içgörünün sıcak yolda okunan özeti. Ödül hesabı ve hedef seçimi yalnızca bu alanlara bakar.
+struct InsightRecord {
+    InsightType type;
+    UrgencyLevel urgency;
+    std::uint32_t slot;  // Ayrıntının (AIInsight) halkadaki yeri
+    std::uint64_t tick;  // Üretildiği motor döngüsü
+};
+
+// Bir motor döngüsünde üretilen içgörülerin tipli, süreç içi taşıyıcısı.
+//
+// AIInsightsEngine -> GoalManager / MetaEvolutionEngine / LearningModule hattında JSON serileştirmesinin yerini alır;
+// JSON yalnızca GUI/dışa aktarım için to_json() ile üretilir.
+// Sabit kapasiteli bir halka: kapasite aşılırsa en eski kayıt üzerine yazılır (dropped() artar).
+// Kayıtlar ve ayrıntı slotları döngüler arasında yeniden kullanılır; sabit durumda bellek ayırma yapılmaz
+// (AIInsight içindeki string/vektörler hariç).
+// Thread-safe değildir; tek bir motor döngüsü tarafından doldurulup aynı döngüde okunur.
+class InsightBatch {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64;
+    static constexpr std::size_t kInsightTypeCount = static_cast<std::size_t>(InsightType::None) + 1;
+
+    explicit InsightBatch(std::size_t capacity = kDefaultCapacity);
+
+    // Yeni döngü: içerik boşaltılır, kapasite korunur.
+    void begin_tick(std::uint64_t tick);
+    void push(AIInsight&& insight);
+    void push(const AIInsight& insight);
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return records_.size(); }
+    std::uint64_t tick() const { return tick_; }
+    std::size_t dropped() const { return dropped_; }
+
+    // i: 0 en eski kayıt, size()-1 en yeni kayıt.
+    const InsightRecord& record(std::size_t i) const { return records_[physical_index(i)]; }
+    const AIInsight& insight(std::size_t i) const { return details_[records_[physical_index(i)].slot]; }
+
+    std::size_t count(InsightType type) const { return type_counts_[type_index(type)]; }
+    bool contains(InsightType type, UrgencyLevel urgency) const;
+
+    // GUI/dışa aktarım için: AIInsightsEngine'in eski dönüş biçimiyle aynı JSON dizisi.
+    std::string to_json() const;
+    std::vector<AIInsight> to_vector() const;
+
+private:
+    static std::size_t type_index(InsightType type) {
+        const std::size_t index = static_cast<std::size_t>(type);
+        return index < kInsightTypeCount ? index : kInsightTypeCount - 1;
+    }
+    std::size_t physical_index(std::size_t i) const { return (head_ + i) % records_.size(); }
+    std::size_t claim_slot(InsightType type, UrgencyLevel urgency);
+
+    std::vector<InsightRecord> records_;
+    std::vector<AIInsight> details_;
+    std::array<std::uint32_t, kInsightTypeCount> type_counts_{};
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::size_t dropped_ = 0;
+    std::uint64_t tick_ = 0;
+};
+
+} // namespace CerebrumLux
+
+#endif // INSIGHT_BATCH_H
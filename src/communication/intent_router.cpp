@@ -9,10 +9,40 @@
 #include "../external/fasttext/include/fasttext.h"
 #include "../brain/llm_engine.h" // LlamaInvoker için LLMEngine
 #include "../core/logger.h" // CerebrumLux logger için
+#include "../core/metrics.h"
+#include "../core/task_scheduler.h"
 #include "../gui/DataTypes.h" // ChatResponse için
 
 namespace CerebrumLux {
 
+namespace {
+
+struct IntentRouterMetrics {
+    Metrics::Counter& cache_hits = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_router_cache_total", "IntentRouter önbellek aramaları", "result=\"hit\"");
+    Metrics::Counter& cache_misses = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_router_cache_total", "IntentRouter önbellek aramaları", "result=\"miss\"");
+    Metrics::Counter& routed_fasttext = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_router_routed_total", "IntentRouter yönlendirme kararları", "route=\"fasttext\"");
+    Metrics::Counter& routed_llama = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_router_routed_total", "IntentRouter yönlendirme kararları", "route=\"llama\"");
+    Metrics::Counter& rejected_busy = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_router_routed_total", "IntentRouter yönlendirme kararları", "route=\"rejected_busy\"");
+    Metrics::Gauge& active_llama_calls = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_router_active_llama_calls", "Devam eden Llama çağrısı sayısı");
+    Metrics::Histogram& classify_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_router_classify_seconds", "FastText sınıflandırma süresi");
+    Metrics::Histogram& llama_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_router_llama_seconds", "IntentRouter üzerinden yapılan Llama çağrısı süresi");
+};
+
+IntentRouterMetrics& router_metrics() {
+    static IntentRouterMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
 // ----------------------------------------------------
 // LlamaInvoker Implementasyonu
 // ----------------------------------------------------
@@ -80,9 +110,7 @@ IntentRouter::IntentRouter(FastTextWrapper *ft,
 
     LOG_DEFAULT(LogLevel::INFO, "IntentRouter: Başlatıldı.");
     
-    // QtConcurrent::run ile başlatılan asenkron Llama çağrılarını takip etmek için
-    // QFutureWatcher kullanacağız, ama IntentRouter'da QFutureWatcher üyesi yok,
-    // bu yüzden lambda içinden direkt emit yapacağız.
+    // Sınıflandırma ve Llama çağrıları ortak TaskScheduler'da çalışır; sonuç lambda içinden callback ile iletilir.
 }
 
 void IntentRouter::handle_user_input(const std::string &userId, const std::string &text) {
@@ -95,6 +123,7 @@ void IntentRouter::handle_user_input(const std::string &userId, const std::strin
         if (it != cache_.end()) {
             auto tp = it->second.second;
             if (std::chrono::steady_clock::now() - tp < std::chrono::seconds(cfg_.cache_ttl_s)) {
+                router_metrics().cache_hits.inc();
                 LOG_DEFAULT(LogLevel::INFO, "IntentRouter: Önbellekten yanıt döndürüldü. User: " << userId);                
                 callback_(userId, it->second.first);
                 return;
@@ -102,12 +131,17 @@ void IntentRouter::handle_user_input(const std::string &userId, const std::strin
                 cache_.erase(it); // TTL dolmuş, önbellekten sil
             }
         }
+        router_metrics().cache_misses.inc();
     }
 
-    // 2. FastText ile Sınıflandırma (Arka planda)
+    // 2. FastText ile Sınıflandırma (Arka planda, Interactive sınıfı)
     // Bu işlem de bloklayıcı olmamalı.
-    QtConcurrent::run([this, userId, text, normalized_text]() mutable {
-        FastTextResult ftres = ft_->classify(text); // FastText hızlı olduğu için direkt çağrılabilir
+    TaskScheduler::instance().submit(TaskClass::Interactive, [this, userId, text, normalized_text]() mutable {
+        FastTextResult ftres;
+        {
+            Metrics::ScopedTimer classify_timer(router_metrics().classify_latency);
+            ftres = ft_->classify(text); // FastText hızlı olduğu için direkt çağrılabilir
+        }
         
         ChatResponse router_response; // IntentRouter'ın nihai yanıtı
         router_response.text = "";
@@ -132,6 +166,7 @@ void IntentRouter::handle_user_input(const std::string &userId, const std::strin
         }
 
         if (handled_by_fasttext) {
+            router_metrics().routed_fasttext.inc();
             if (cfg_.enable_cache) {
                 std::lock_guard<std::mutex> lock(mtx_);
                 cache_[normalized_text] = {router_response, std::chrono::steady_clock::now()};
@@ -145,6 +180,7 @@ void IntentRouter::handle_user_input(const std::string &userId, const std::strin
         if (current_llama_calls_.load() >= cfg_.max_concurrent_llama) {
             router_response.text = "Şu an yoğunluk var, lütfen kısa süre sonra tekrar deneyin.";
             router_response.reasoning = "Llama meşgul (Concurrent Limit)";
+            router_metrics().rejected_busy.inc();
             LOG_DEFAULT(LogLevel::WARNING, "IntentRouter: Llama eşzamanlı çağrı limitine ulaşıldı.");
             callback_(userId, router_response);
             return;
@@ -152,15 +188,18 @@ void IntentRouter::handle_user_input(const std::string &userId, const std::strin
 
         // c. Llama çağrısını başlat
         current_llama_calls_.fetch_add(1);
+        router_metrics().routed_llama.inc();
+        router_metrics().active_llama_calls.inc();
         LOG_DEFAULT(LogLevel::INFO, "IntentRouter: Llama çağrısı başlatılıyor. Aktif Llama çağrısı: " << current_llama_calls_.load() );
 
-        // Llama çağrısını yeni bir thread'de asenkron olarak başlatıyoruz
-        // QFutureWatcher kullanmak yerine, direkt lambda içinden sinyal emit edeceğiz
-        // veya QFuture'ı tutup onLlamaCallFinished slotunda işleyeceğiz.
-        // Şimdilik basitlik adına QFuture'ı ignore edip lambda içinden callback çağıralım.
-        QThreadPool::globalInstance()->start([this, userId, text, normalized_text]() {
+        // Llama çağrısı Inference sınıfında ayrı bir görev olarak başlatılır; sınıflandırma görevi (Interactive)
+        // LLM'i beklemeden biter. Sonuç lambda içinden callback ile iletilir.
+        TaskScheduler::instance().submit(TaskClass::Inference, [this, userId, text, normalized_text]() {
+            const auto llama_start = std::chrono::steady_clock::now();
             LlamaResult lr = llama_->infer_sync(text); // LLM Engine'i çağırır (bloklar ama ayrı thread'de)
+            router_metrics().llama_latency.record_duration(std::chrono::steady_clock::now() - llama_start);
             current_llama_calls_.fetch_sub(1); // Llama çağrısı bitti
+            router_metrics().active_llama_calls.dec();
             LOG_DEFAULT(LogLevel::INFO, "IntentRouter: Llama çağrısı tamamlandı. Aktif Llama çağrısı: " << current_llama_calls_.load());
 
             ChatResponse llama_final_response;
@@ -12,9 +12,10 @@
 #include <sstream>   // stringstream için
 #include <functional> // std::hash için (statik embedding için)
 #include <algorithm> // std::min için
-#include <QtConcurrent/QtConcurrent> // EKLENDİ (Asenkron işlemler için)
+#include "../core/task_scheduler.h" // Asenkron embedding istekleri için ortak zamanlayıcı
 #include "../brain/llm_engine.h" // EKLENDİ: Llama-2 Motoruna Erişim
 #include "../gui/DataTypes.h" // ChatResponse için
+#include "context_packer.h" // Token bütçeli bağlam seçimi için
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -110,12 +111,16 @@ ChatResponse LLMProcessor::generate_response_text(
         final_results_for_synthesis = definitive_results;
         LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NaturalLanguageProcessor: Doğrudan tanımlayıcı kapsüller önceliklendirildi.");
     } else {
-        // Doğrudan ID ile bulunamazsa, semantik arama yap (Yanıt + Öneriler için daha fazla sonuç al)
-        std::vector<CerebrumLux::Capsule> semantic_search_results = kb.semantic_search(search_query_embedding, 6);
-        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NaturalLanguageProcessor: KnowledgeBase'den semantik arama yapıldı. Bulunan kapsül sayısı: " << semantic_search_results.size() << " (Sorgu: '" << search_term_for_embedding << "')");
+        // Doğrudan ID ile bulunamazsa hibrit arama yap: BM25 birebir terimleri (hata kodu, tanımlayıcı),
+        // HNSW anlamsal yakınlığı yakalar; sonuçlar RRF ile birleştirilir (Yanıt + Öneriler için 6 sonuç).
+        CerebrumLux::HybridSearchOptions search_options;
+        search_options.top_k = 6;
+        std::vector<CerebrumLux::HybridSearchHit> semantic_search_results = kb.hybrid_search(search_term_for_embedding, search_query_embedding, search_options);
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NaturalLanguageProcessor: KnowledgeBase'den hibrit arama yapıldı. Bulunan kapsül sayısı: " << semantic_search_results.size() << " (Sorgu: '" << search_term_for_embedding << "')");
  
         // Semantic arama sonuçlarını da final_results'a ekle, ancak boş veya anlamsız olanları filtrele
-        for (const auto& capsule : semantic_search_results) {
+        for (const auto& hit : semantic_search_results) {
+            const CerebrumLux::Capsule& capsule = hit.capsule;
             // Kapsül içeriğinin anlamsız olup olmadığını kontrol et
             if (capsule.content.empty() ||
                 capsule.content.find("Is this data relevant to AI Insight?") != std::string::npos ||
@@ -140,49 +145,31 @@ ChatResponse LLMProcessor::generate_response_text(
         response_stream << "Bilgi tabanımda sorunuzla ilgili bazı bilgiler buldum: \n";
         reasoning_stream << "Yanıt, KnowledgeBase'deki ";
 
-        size_t used_capsule_count = 0;
-        // En alakalı kapsülleri birleştirerek yanıt oluştur
-        for (size_t i = 0; i < final_results_for_synthesis.size(); ++i) {
-            const CerebrumLux::Capsule& capsule = final_results_for_synthesis[i];
+        // Token bütçesine sığan en alakalı parçaları seç; bütçeye girmeyenler öneri olarak kalır.
+        const CerebrumLux::ContextPacker packer;
+        const CerebrumLux::PackedContext packed = packer.pack(final_results_for_synthesis, search_term_for_embedding);
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NaturalLanguageProcessor: Bağlam paketlendi. Kapsül: " << packed.items.size() << ", token: " << packed.used_tokens);
+
+        for (size_t i = 0; i < packed.items.size(); ++i) {
+            const CerebrumLux::PackedCapsule& item = packed.items[i];
+            const CerebrumLux::Capsule& capsule = final_results_for_synthesis[item.index];
             cited_capsule_ids.push_back(capsule.id);
-            
+
             // YENİ LOG: Bulunan her kapsülün ID'sini, konusunu ve içeriğini (özet veya tam) logla.
             LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NaturalLanguageProcessor: Bulunan Kapsül - ID: " << capsule.id 
                         << ", Konu: " << capsule.topic 
                         << ", Özet: '" << capsule.plain_text_summary.substr(0, std::min((size_t)100, capsule.plain_text_summary.length())) << "'"
                         << ", İçerik Boyutu: " << capsule.content.length()
-                        << ", İçerik (İlk 100 char): '" << capsule.content.substr(0, std::min((size_t)100, capsule.content.length())) << "...'");
-
-            // Kapsülün içeriğini veya özetini kullanarak daha zengin bir yanıt oluştur
-            std::string display_content = capsule.content;
-            if (display_content.empty() ||
-                display_content.find("Is this data relevant to AI Insight?") != std::string::npos ||
-                display_content.find("Bilgi bulunamadı.") != std::string::npos)
-            {
-                display_content = capsule.plain_text_summary; // İçerik boşsa özeti kullan
-                if (display_content.empty() ||
-                    display_content.find("Is this data relevant to AI Insight?") != std::string::npos ||
-                    display_content.find("Bilgi bulunamadı.") != std::string::npos)
-                {
-                    display_content = "İlgili bilgi mevcut değil."; // Hem içerik hem özet boşsa veya anlamsızsa
-                }
-            }
-            
-            // Metni biraz kırp (çok uzunsa) ve sonuna ... ekle
-            std::string content_snippet = display_content.substr(0, std::min((size_t)400, display_content.length()));
-            if (display_content.length() > 400) content_snippet += "...";
+                        << ", Parça token: " << item.tokens << (item.truncated ? " (kırpıldı)" : ""));
 
-            response_stream << "\n- **" << capsule.topic << "**: " << content_snippet << " [cite:" << capsule.id << "]";
+            response_stream << "\n- **" << capsule.topic << "**: " << item.snippet << " [cite:" << capsule.id << "]";
 
             reasoning_stream << "'" << capsule.topic << "' (ID: " << capsule.id << ")";
-            if (i < final_results_for_synthesis.size() - 1) {
+            if (i < packed.items.size() - 1) {
                 reasoning_stream << ", ";
             }
-            used_capsule_count++;
-            
-            // İlk 2 kapsülü yanıt için kullan, gerisini önerilere sakla
-            if (used_capsule_count >= 2) break;
         }
+        const size_t used_capsule_count = packed.items.size();
         reasoning_stream << " kapsüllerinin sentezlenmesiyle oluşturuldu.";
 
         generated_text = response_stream.str();
@@ -192,9 +179,9 @@ ChatResponse LLMProcessor::generate_response_text(
             generated_text += "\nDaha detaylı bilgi için yukarıdaki referanslara tıklayabilirsiniz.";
         }
 
-        // YENİ: Geriye kalan kapsüllerden öneri soruları oluştur
-        for (size_t i = used_capsule_count; i < final_results_for_synthesis.size(); ++i) {
-            const CerebrumLux::Capsule& cap = final_results_for_synthesis[i];
+        // YENİ: Bağlama girmeyen kapsüllerden öneri soruları oluştur
+        for (size_t index : packed.leftover) {
+            const CerebrumLux::Capsule& cap = final_results_for_synthesis[index];
             if (!cap.topic.empty() && cap.topic != "AI Insight") { // "AI Insight" başlığı çok genel, onu atla
                  response_obj.suggested_questions.push_back(cap.topic + " hakkında bilgi ver");
             }
@@ -289,25 +276,69 @@ std::string NaturalLanguageProcessor::generate_dynamic_prompt(
 }
 
 CerebrumLux::UserIntent NaturalLanguageProcessor::rule_based_intent_guess(const std::string& lower_text) const {
-    for (const auto& pair : this->intent_keyword_map) {
-        for (const auto& keyword : pair.second) {
-            if (lower_text.find(keyword) != std::string::npos) {
-                return pair.first;
-            }
-        }
-    }
-    return CerebrumLux::UserIntent::Undefined;
+    // Kural ID'si niyetin enum değeridir; en küçük ID, eski harita sırasındaki ilk eşleşen niyettir.
+    const std::optional<int> id = intent_matcher_.first_match(lower_text);
+    return id ? static_cast<CerebrumLux::UserIntent>(*id) : CerebrumLux::UserIntent::Undefined;
 }
 
 CerebrumLux::AbstractState NaturalLanguageProcessor::rule_based_state_guess(const std::string& lower_text) const {
-    for (const auto& pair : this->state_keyword_map) {
-        for (const auto& keyword : pair.second) {
-            if (lower_text.find(keyword) != std::string::npos) {
-                return pair.first;
-            }
-        }
+    const std::optional<int> id = state_matcher_.first_match(lower_text);
+    return id ? static_cast<CerebrumLux::AbstractState>(*id) : CerebrumLux::AbstractState::Idle;
+}
+
+void NaturalLanguageProcessor::set_intent_keywords(std::map<CerebrumLux::UserIntent, std::vector<std::string>> keywords) {
+    std::lock_guard<std::mutex> lock(keyword_mutex_);
+    intent_keyword_map = std::move(keywords);
+    std::vector<CerebrumLux::KeywordMatcher::Rule> rules;
+    for (const auto& pair : intent_keyword_map) {
+        for (const auto& keyword : pair.second) rules.push_back({keyword, static_cast<int>(pair.first)});
     }
-    return CerebrumLux::AbstractState::Idle;
+    intent_matcher_.rebuild(rules);
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NLP: Niyet anahtar kelime otomatı yeniden derlendi (" << rules.size() << " kalıp).");
+}
+
+void NaturalLanguageProcessor::set_state_keywords(std::map<CerebrumLux::AbstractState, std::vector<std::string>> keywords) {
+    std::lock_guard<std::mutex> lock(keyword_mutex_);
+    state_keyword_map = std::move(keywords);
+    std::vector<CerebrumLux::KeywordMatcher::Rule> rules;
+    for (const auto& pair : state_keyword_map) {
+        for (const auto& keyword : pair.second) rules.push_back({keyword, static_cast<int>(pair.first)});
+    }
+    state_matcher_.rebuild(rules);
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "NLP: Durum anahtar kelime otomatı yeniden derlendi (" << rules.size() << " kalıp).");
+}
+
+namespace {
+
+// Refleks tablosu; kural ID'si yanıtın indeksidir (küçük indeks önceliklidir). Kalıplar katlanarak eşlendiğinden
+// "Selam" / "selam" gibi büyük harfli ikizlere gerek yoktur.
+const char* const kReflexResponses[] = {
+    "Selam! Senin için ne yapabilirim?",
+    "Merhaba! Cerebrum Lux sistemi hazır.",
+    "Ben bir yapay zeka sistemiyim, dolayısıyla hislerim yok ama tüm sistemlerim %100 verimlilikle çalışıyor. Sen nasılsın?",
+    "Ben Cerebrum Lux. Kişisel donanımlarda çalışmak üzere tasarlanmış, mahremiyet odaklı ve yüksek performanslı bir yapay zekayım.",
+    "Adım Cerebrum Lux. 'Işık Beyin' anlamına gelir.",
+    "Sistemi kapatma yetkim şu an simülasyon modunda. (Refleks Yanıtı)",
+};
+
+const CerebrumLux::KeywordMatcher& reflex_matcher() {
+    static const CerebrumLux::KeywordMatcher matcher({
+        {"selam", 0},
+        {"merhaba", 1},
+        {"nasılsın", 2},
+        {"kimsin", 3},
+        {"adın ne", 4}, {"ismin ne", 4},
+        {"kapat", 5}, {"exit", 5},
+    });
+    return matcher;
+}
+
+} // namespace
+
+std::string NaturalLanguageProcessor::get_reflex_response(const std::string& text, const UserIntent& intent) const {
+    (void)intent;
+    const std::optional<int> id = reflex_matcher().first_match(text);
+    return id ? kReflexResponses[*id] : "";
 }
 
 void NaturalLanguageProcessor::update_model(const std::string& observed_text, CerebrumLux::UserIntent true_intent, const std::vector<float>& latent_cryptofig) {
@@ -412,8 +443,8 @@ CerebrumLux::UserIntent NaturalLanguageProcessor::infer_intent_from_text(const s
 
 // YENİ: Asenkron embedding isteğini işleyen fonksiyon
 void NaturalLanguageProcessor::request_embedding_async(const std::string& text, const std::string& request_id) {
-    // QtConcurrent::run ile senkron embedding fonksiyonunu arka planda çalıştır
-    QtConcurrent::run([this, text, request_id]() {
+    // Senkron embedding fonksiyonunu ortak zamanlayıcıda (Inference sınıfı) arka planda çalıştır
+    TaskScheduler::instance().submit(TaskClass::Inference, [this, text, request_id]() {
         // Arka plan thread'inde senkron metodu çağır
         std::vector<float> embedding = this->generate_text_embedding_sync(text);
         // Sonuç hazır olduğunda sinyali yay
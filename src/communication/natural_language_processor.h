@@ -7,9 +7,11 @@
 #include <memory> // std::unique_ptr için
 #include <optional> // std::optional için
 #include <atomic> // std::atomic için
+#include <mutex>
 #include <QObject> // EKLENDİ (NaturalLanguageProcessor bir QObject olacak)
 
 #include "../core/enums.h" // Language enum'u ve diğer enum'lar için
+#include "../core/keyword_matcher.h" // Kural anahtar kelimeleri için Aho-Corasick otomatı
 #include "../gui/DataTypes.h" // ChatResponse için
 
 // DÜZELTME: Incomplete type hatasını çözmek için tam tanımları dahil et
@@ -85,18 +87,14 @@ public:
         return std::min(1.0f, load);
     }
 
-    // YENİ: Refleks yanıtı (Varsa döndürür, yoksa boş döner)
-    inline std::string get_reflex_response(const std::string& text, const UserIntent& intent) const {
-        // Bu fonksiyonun tanımı .cpp dosyasından buraya taşındı.
-        std::string key = text;
-        if (key.find("Selam") != std::string::npos || key.find("selam") != std::string::npos) return "Selam! Senin için ne yapabilirim?";
-        if (key.find("Merhaba") != std::string::npos || key.find("merhaba") != std::string::npos) return "Merhaba! Cerebrum Lux sistemi hazır.";
-        if (key.find("Nasılsın") != std::string::npos || key.find("nasılsın") != std::string::npos) return "Ben bir yapay zeka sistemiyim, dolayısıyla hislerim yok ama tüm sistemlerim %100 verimlilikle çalışıyor. Sen nasılsın?";
-        if (key.find("Kimsin") != std::string::npos || key.find("kimsin") != std::string::npos) return "Ben Cerebrum Lux. Kişisel donanımlarda çalışmak üzere tasarlanmış, mahremiyet odaklı ve yüksek performanslı bir yapay zekayım.";
-        if (key.find("Adın ne") != std::string::npos || key.find("adın ne") != std::string::npos || key.find("ismin ne") != std::string::npos) return "Adım Cerebrum Lux. 'Işık Beyin' anlamına gelir.";
-        if (key.find("kapat") != std::string::npos || key.find("exit") != std::string::npos) return "Sistemi kapatma yetkim şu an simülasyon modunda. (Refleks Yanıtı)";
-        return "";
-    }
+    // YENİ: Refleks yanıtı (Varsa döndürür, yoksa boş döner). Tüm refleks kalıpları tek geçişte aranır;
+    // birden çok kalıp eşleşirse tablodaki ilk refleks kazanır.
+    std::string get_reflex_response(const std::string& text, const UserIntent& intent) const;
+
+    // Kural tabanlı tahminin anahtar kelime kümeleri. Değiştirildiğinde otomat yeniden derlenir; eşzamanlı
+    // tahminler eski veya yeni kümeyi bütün olarak görür. Birden çok niyet eşleşirse enum sırasında ilki kazanır.
+    void set_intent_keywords(std::map<CerebrumLux::UserIntent, std::vector<std::string>> keywords);
+    void set_state_keywords(std::map<CerebrumLux::AbstractState, std::vector<std::string>> keywords);
 
     // public yapıldı (önceki oturumda yapılmıştı)
     inline std::string fallback_response_for_intent(CerebrumLux::UserIntent intent, CerebrumLux::AbstractState state, const CerebrumLux::DynamicSequence& sequence) const;
@@ -141,6 +139,9 @@ private:
     CerebrumLux::KnowledgeBase& kbRef_; // KnowledgeBase referansı
     std::map<CerebrumLux::UserIntent, std::vector<std::string>> intent_keyword_map;
     std::map<CerebrumLux::AbstractState, std::vector<std::string>> state_keyword_map;
+    std::mutex keyword_mutex_; // Kümeleri değiştiren çağrıları sıralar (tahminler kilit almaz)
+    CerebrumLux::KeywordMatcher intent_matcher_; // Kural ID'si = UserIntent değeri
+    CerebrumLux::KeywordMatcher state_matcher_;  // Kural ID'si = AbstractState değeri
     std::map<CerebrumLux::UserIntent, std::vector<float>> intent_cryptofig_weights; // NLP modelinin dahili ağırlıkları
 
     CerebrumLux::UserIntent rule_based_intent_guess(const std::string& lower_text) const;
@@ -25,6 +25,24 @@ ChatResponse ResponseEngine::generate_response(
     const KnowledgeBase& kb,
     const std::vector<float>& user_embedding // YENİ: Embedding parametresi
 ) const { 
+    return generate_response_streaming(current_intent, current_abstract_state, current_goal, sequence, kb, user_embedding, nullptr);
+}
+
+ChatResponse ResponseEngine::generate_response_streaming(
+    CerebrumLux::UserIntent current_intent,
+    CerebrumLux::AbstractState current_abstract_state,
+    CerebrumLux::AIGoal current_goal,
+    const DynamicSequence& sequence,
+    const KnowledgeBase& kb,
+    const std::vector<float>& user_embedding,
+    const std::shared_ptr<TokenStream>& stream
+) const {
+    // Hangi yoldan dönülürse dönülsün akış kapatılır; GUI tarafı bitişi buradan anlar.
+    struct StreamFinisher {
+        const std::shared_ptr<TokenStream>& stream;
+        ~StreamFinisher() { if (stream) stream->finish(); }
+    } stream_finisher{stream};
+
     LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "ResponseEngine: Yanıt üretimi isteniyor. Niyet: " << CerebrumLux::to_string(current_intent) << ", Durum: " << CerebrumLux::abstract_state_to_string(current_abstract_state));
 
     // Kapsülden anahtar kelimeler çıkarma (placeholder olarak sequence'den alındı)
@@ -125,11 +143,20 @@ ChatResponse ResponseEngine::generate_response(
         LLMGenerationConfig config;
         config.max_tokens = 512;
         config.temperature = 0.3f; // Daha tutarlı yanıtlar için düşük sıcaklık
-        std::string llm_output = llm_engine.generate(prompt, config); // DÜZELTME: llm_engine.generate()
+        std::string llm_output = stream
+            ? llm_engine.generate(prompt, config, stream->callback())
+            : llm_engine.generate(prompt, config); // DÜZELTME: llm_engine.generate()
+
+        if (stream) {
+            const TokenStreamStats stream_stats = stream->stats();
+            nlp_generated_response.ttft_ms = stream_stats.ttft_ms;
+            nlp_generated_response.tokens_per_second = stream_stats.tokens_per_second;
+            nlp_generated_response.cancelled = stream->is_cancelled();
+        }
 
         if (!llm_output.empty()) {
             nlp_generated_response.text = llm_output; // Yanıtı LLM çıktısı ile değiştir
-            nlp_generated_response.reasoning += " (LLM ile işlendi)";
+            nlp_generated_response.reasoning += nlp_generated_response.cancelled ? " (LLM ile işlendi, kullanıcı durdurdu)" : " (LLM ile işlendi)";
             LOG_DEFAULT(LogLevel::INFO, "ResponseEngine: LLM yanıtı başarıyla üretildi.");
         } else {
             LOG_ERROR_CERR(LogLevel::WARNING, "ResponseEngine: LLM yanıt üretemedi, kural tabanlı yanıt dönülüyor.");
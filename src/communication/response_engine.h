@@ -11,6 +11,7 @@
 #include "../data_models/dynamic_sequence.h"
 #include "../learning/KnowledgeBase.h"
 #include "../brain/llm_engine.h" 
+#include "../brain/token_stream.h" // Akışlı yanıt üretimi için
 #include "../gui/DataTypes.h" // EKLENDİ: ChatResponse için (Artık buradan geliyor)
 #include "natural_language_processor.h" // NaturalLanguageProcessor'ın tam tanımı için
 
@@ -32,6 +33,19 @@ public:
         const std::vector<float>& user_embedding // YENİ: Embedding parametresi
     ) const;
 
+    // generate_response ile aynı karar akışı; LLM kullanılırsa üretilen token'lar stream'e de yazılır.
+    // stream->cancel() üretimi bir sonraki token'da keser; bu durumda kısmi metin cancelled=true ile döner.
+    // Refleks/kural tabanlı yanıtlarda stream'e bir şey yazılmaz, yalnızca finish() çağrılır.
+    ChatResponse generate_response_streaming(
+        CerebrumLux::UserIntent current_intent,
+        CerebrumLux::AbstractState current_abstract_state,
+        CerebrumLux::AIGoal current_goal,
+        const CerebrumLux::DynamicSequence& sequence,
+        const CerebrumLux::KnowledgeBase& kb,
+        const std::vector<float>& user_embedding,
+        const std::shared_ptr<TokenStream>& stream
+    ) const;
+
     // YENİ: LLM Motoruna erişim (Gerekirse dışarıdan yapılandırmak için)
     LLMEngine& get_llm_engine() { return llm_engine; }
 
@@ -0,0 +1,233 @@
+#include "keyword_matcher.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+namespace CerebrumLux {
+
+namespace {
+
+// Tek bir kod noktasının küçük harf karşılığı (Unicode basit katlamanın sık kullanılan alt kümesi).
+char32_t fold_code_point(char32_t c) {
+    if (c < 0x80) return (c >= 'A' && c <= 'Z') ? c + 0x20 : c;
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 0x20;  // Latin-1: À..Þ (× hariç)
+    if (c == 0x130) return 'i';                                 // İ -> i
+    if (c >= 0x100 && c <= 0x137) return c | 1;                 // Ā..ķ: büyük çift, küçük tek (Ğ, ı dahil)
+    if (c >= 0x139 && c <= 0x148) return (c & 1) ? c + 1 : c;   // Ĺ..ň: büyük tek, küçük çift
+    if (c >= 0x14A && c <= 0x177) return c | 1;                 // Ŋ..ŷ (Ş, Œ dahil)
+    if (c == 0x178) return 0xFF;                                // Ÿ -> ÿ
+    if (c >= 0x179 && c <= 0x17E) return (c & 1) ? c + 1 : c;   // Ź..ž
+    if (c >= 0x410 && c <= 0x42F) return c + 0x20;              // Kiril А..Я
+    if (c >= 0x400 && c <= 0x40F) return c + 0x50;              // Kiril Ѐ..Џ
+    return c;
+}
+
+// Metni katlanmış UTF-8 baytları olarak emit'e verir; emit false dönerse durur. Geçersiz diziler bayt bayt geçer.
+template <typename Emit>
+bool for_each_folded_byte(std::string_view text, Emit&& emit) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const std::size_t n = text.size();
+    for (std::size_t i = 0; i < n;) {
+        const unsigned char lead = bytes[i];
+        if (lead < 0x80) {
+            if (!emit(static_cast<unsigned char>(fold_code_point(lead)))) return false;
+            ++i;
+            continue;
+        }
+        std::size_t len = 0;
+        char32_t cp = 0;
+        if ((lead & 0xE0) == 0xC0) { len = 2; cp = lead & 0x1F; }
+        else if ((lead & 0xF0) == 0xE0) { len = 3; cp = lead & 0x0F; }
+        else if ((lead & 0xF8) == 0xF0) { len = 4; cp = lead & 0x07; }
+        bool valid = len > 0 && i + len <= n;
+        for (std::size_t k = 1; valid && k < len; ++k) {
+            if ((bytes[i + k] & 0xC0) != 0x80) valid = false;
+            else cp = (cp << 6) | (bytes[i + k] & 0x3F);
+        }
+        if (!valid) {
+            if (!emit(lead)) return false;
+            ++i;
+            continue;
+        }
+        const char32_t folded = fold_code_point(cp);
+        if (folded == cp) {
+            for (std::size_t k = 0; k < len; ++k) {
+                if (!emit(bytes[i + k])) return false;
+            }
+        } else if (folded < 0x80) {
+            if (!emit(static_cast<unsigned char>(folded))) return false;
+        } else if (folded < 0x800) {
+            if (!emit(static_cast<unsigned char>(0xC0 | (folded >> 6)))) return false;
+            if (!emit(static_cast<unsigned char>(0x80 | (folded & 0x3F)))) return false;
+        } else {
+            // Katlanan aralıkların hepsi U+FFFF altında.
+            if (!emit(static_cast<unsigned char>(0xE0 | (folded >> 12)))) return false;
+            if (!emit(static_cast<unsigned char>(0x80 | ((folded >> 6) & 0x3F)))) return false;
+            if (!emit(static_cast<unsigned char>(0x80 | (folded & 0x3F)))) return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+} // namespace
+
+struct KeywordMatcher::Automaton {
+    std::array<std::uint16_t, 256> byte_class{}; // 0: hiçbir desende geçmeyen bayt (her durumdan köke döner)
+    std::size_t classes = 1;
+    std::vector<std::int32_t> next;              // durum * classes + sınıf -> durum (tam DFA)
+    std::vector<std::uint32_t> output_begin;     // durum başına outputs aralığı (durum sayısı + 1)
+    std::vector<int> outputs;                    // bu durumda biten tüm desenlerin kural ID'leri (sonek dahil)
+    std::size_t patterns = 0;
+};
+
+void KeywordMatcher::rebuild(const std::vector<Rule>& rules) {
+    auto automaton = std::make_shared<Automaton>();
+
+    std::vector<std::pair<std::string, int>> folded;
+    folded.reserve(rules.size());
+    for (const Rule& rule : rules) {
+        std::string pattern = fold_case(rule.pattern);
+        if (!pattern.empty()) folded.emplace_back(std::move(pattern), rule.id);
+    }
+    automaton->patterns = folded.size();
+
+    for (const auto& entry : folded) {
+        for (unsigned char c : entry.first) {
+            if (automaton->byte_class[c] == 0) automaton->byte_class[c] = static_cast<std::uint16_t>(automaton->classes++);
+        }
+    }
+    const std::size_t classes = automaton->classes;
+
+    // 1) Trie
+    std::vector<std::int32_t>& next = automaton->next;
+    std::vector<std::vector<int>> state_outputs(1);
+    next.assign(classes, -1);
+    for (const auto& entry : folded) {
+        std::int32_t state = 0;
+        for (unsigned char c : entry.first) {
+            const std::size_t slot = static_cast<std::size_t>(state) * classes + automaton->byte_class[c];
+            if (next[slot] < 0) {
+                next[slot] = static_cast<std::int32_t>(state_outputs.size());
+                state_outputs.emplace_back();
+                next.resize(next.size() + classes, -1);
+            }
+            state = next[slot];
+        }
+        state_outputs[static_cast<std::size_t>(state)].push_back(entry.second);
+    }
+
+    // 2) Başarısızlık bağlantıları genişlik öncelikli çözülür ve eksik geçişler doldurulur (tam DFA).
+    std::vector<std::int32_t> fail(state_outputs.size(), 0);
+    std::deque<std::int32_t> queue;
+    for (std::size_t c = 0; c < classes; ++c) {
+        std::int32_t& target = next[c];
+        if (target < 0) {
+            target = 0;
+        } else {
+            queue.push_back(target);
+        }
+    }
+    while (!queue.empty()) {
+        const std::int32_t state = queue.front();
+        queue.pop_front();
+        const std::size_t base = static_cast<std::size_t>(state) * classes;
+        const std::size_t fail_base = static_cast<std::size_t>(fail[static_cast<std::size_t>(state)]) * classes;
+        for (std::size_t c = 0; c < classes; ++c) {
+            const std::int32_t child = next[base + c];
+            if (child < 0) {
+                next[base + c] = next[fail_base + c];
+                continue;
+            }
+            const std::int32_t child_fail = next[fail_base + c];
+            fail[static_cast<std::size_t>(child)] = child_fail;
+            // Ebeveynler önce işlendiğinden child_fail'in çıktıları zaten birleştirilmiştir.
+            const std::vector<int>& inherited = state_outputs[static_cast<std::size_t>(child_fail)];
+            std::vector<int>& own = state_outputs[static_cast<std::size_t>(child)];
+            own.insert(own.end(), inherited.begin(), inherited.end());
+            queue.push_back(child);
+        }
+    }
+
+    // 3) Çıktılar düz diziye
+    automaton->output_begin.reserve(state_outputs.size() + 1);
+    for (std::vector<int>& out : state_outputs) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+        automaton->output_begin.push_back(static_cast<std::uint32_t>(automaton->outputs.size()));
+        automaton->outputs.insert(automaton->outputs.end(), out.begin(), out.end());
+    }
+    automaton->output_begin.push_back(static_cast<std::uint32_t>(automaton->outputs.size()));
+
+    std::atomic_store(&automaton_, std::shared_ptr<const Automaton>(std::move(automaton)));
+}
+
+template <typename OnMatch>
+void KeywordMatcher::scan(const Automaton& automaton, std::string_view text, OnMatch&& on_match) {
+    std::size_t state = 0;
+    for_each_folded_byte(text, [&](unsigned char byte) {
+        state = static_cast<std::size_t>(automaton.next[state * automaton.classes + automaton.byte_class[byte]]);
+        const std::uint32_t end = automaton.output_begin[state + 1];
+        for (std::uint32_t i = automaton.output_begin[state]; i < end; ++i) {
+            if (!on_match(automaton.outputs[i])) return false;
+        }
+        return true;
+    });
+}
+
+std::vector<int> KeywordMatcher::match_ids(std::string_view text) const {
+    std::vector<int> ids;
+    const std::shared_ptr<const Automaton> automaton = std::atomic_load(&automaton_);
+    if (!automaton || automaton->patterns == 0) return ids;
+    scan(*automaton, text, [&](int id) {
+        ids.push_back(id);
+        return true;
+    });
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+std::optional<int> KeywordMatcher::first_match(std::string_view text) const {
+    std::optional<int> best;
+    const std::shared_ptr<const Automaton> automaton = std::atomic_load(&automaton_);
+    if (!automaton || automaton->patterns == 0) return best;
+    scan(*automaton, text, [&](int id) {
+        if (!best || id < *best) best = id;
+        return true;
+    });
+    return best;
+}
+
+bool KeywordMatcher::contains_any(std::string_view text) const {
+    bool found = false;
+    const std::shared_ptr<const Automaton> automaton = std::atomic_load(&automaton_);
+    if (!automaton || automaton->patterns == 0) return false;
+    scan(*automaton, text, [&](int) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+bool KeywordMatcher::empty() const {
+    return pattern_count() == 0;
+}
+
+std::size_t KeywordMatcher::pattern_count() const {
+    const std::shared_ptr<const Automaton> automaton = std::atomic_load(&automaton_);
+    return automaton ? automaton->patterns : 0;
+}
+
+std::string KeywordMatcher::fold_case(std::string_view text) {
+    std::string folded;
+    folded.reserve(text.size());
+    for_each_folded_byte(text, [&](unsigned char byte) {
+        folded.push_back(static_cast<char>(byte));
+        return true;
+    });
+    return folded;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,64 @@
+#ifndef KEYWORD_MATCHER_H
+#define KEYWORD_MATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CerebrumLux {
+
+// Anahtar kelime kuralları için derlenmiş Aho-Corasick otomatı.
+//
+// Her kural bir (desen, kural ID) çiftidir; birden çok desen aynı ID'yi paylaşabilir (ör. bir niyetin tüm anahtar
+// kelimeleri). Desenler derlemede bir kez büyük/küçük harf katlanır; metin ise eşleşme geçişi sırasında kod noktası
+// kod noktası katlanır, yani ayrı bir küçük harf kopyası oluşturulmaz. Katlama UTF-8 farkındadır: ASCII, Latin-1,
+// Latin Genişletilmiş-A (Türkçe Ç Ğ İ Ö Ş Ü dahil) ve temel Kiril büyük harfleri küçültülür; geçersiz UTF-8 baytları
+// olduğu gibi geçer. Eşleşme alt dize eşleşmesidir (eski std::string::find davranışı), kelime sınırı aranmaz.
+//
+// Otomat tam DFA'ya açılır (başarısızlık bağlantıları derlemede çözülür) ve baytlar desenlerde geçen bayt
+// sınıflarına indirgenir; metin başına maliyet bayt başına tek tablo okumasıdır, kural sayısından bağımsızdır.
+//
+// rebuild() yeni otomatı ayrı kurar ve atomik olarak yerleştirir: eşzamanlı eşleşmeler eski veya yeni otomatın
+// tamamını görür, kilit tutulmaz.
+class KeywordMatcher {
+public:
+    struct Rule {
+        std::string pattern;
+        int id;
+    };
+
+    KeywordMatcher() = default;
+    explicit KeywordMatcher(const std::vector<Rule>& rules) { rebuild(rules); }
+
+    // Kural kümesini değiştirir. Boş desenler yok sayılır.
+    void rebuild(const std::vector<Rule>& rules);
+
+    // Tek geçişte eşleşen tüm kural ID'leri, artan sırada ve tekrarsız.
+    std::vector<int> match_ids(std::string_view text) const;
+    // Eşleşen en küçük kural ID'si; ID'ler öncelik sırasıyla verildiyse "ilk eşleşen kural"dır.
+    std::optional<int> first_match(std::string_view text) const;
+    // Herhangi bir kural eşleşiyor mu (ilk eşleşmede durur).
+    bool contains_any(std::string_view text) const;
+
+    bool empty() const;
+    std::size_t pattern_count() const;
+
+    // Eşleşmede kullanılan katlamanın kendisi (testler ve tanılama için).
+    static std::string fold_case(std::string_view text);
+
+private:
+    struct Automaton;
+    // Geçiş sırasında her eşleşme çıktısı için çağrılır; false dönerse tarama durur.
+    template <typename OnMatch>
+    static void scan(const Automaton& automaton, std::string_view text, OnMatch&& on_match);
+
+    std::shared_ptr<const Automaton> automaton_;
+};
+
+} // namespace CerebrumLux
+
+#endif // KEYWORD_MATCHER_H
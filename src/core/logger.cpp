@@ -1,14 +1,35 @@
 #include "logger.h"
+#include "metrics.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip> // std::put_time için
 #include <ctime>   // std::localtime için
 #include <algorithm> // std::find_if için
+#include <array>
 #include <QThread> // QThread::currentThreadId için
 #include <QDateTime> // QDateTime için
 
 namespace CerebrumLux { // TÜM İMPLEMENTASYON BU NAMESPACE İÇİNDE OLACAK
 
+namespace {
+
+// Filtreden geçip yazılan mesajları seviyeye göre sayar; seviye sayısı sabit olduğundan dizi bir kez kurulur.
+Metrics::Counter& logged_messages_counter(LogLevel level) {
+    static constexpr std::size_t kLevelCount = static_cast<std::size_t>(LogLevel::ERR_CRITICAL) + 1;
+    static const auto counters = [] {
+        std::array<Metrics::Counter*, kLevelCount> arr{};
+        for (std::size_t i = 0; i < kLevelCount; ++i) {
+            arr[i] = &Metrics::MetricsRegistry::instance().counter(
+                "cerebrumlux_log_messages_total", "Yazılan log mesajları",
+                "level=\"" + to_string(static_cast<LogLevel>(i)) + "\"");
+        }
+        return arr;
+    }();
+    return *counters[static_cast<std::size_t>(level)];
+}
+
+} // namespace
+
 // Singleton örneğinin başlatılması
 Logger& Logger::getInstance() { // get_instance yerine getInstance
     static Logger instance; // Tek bir örnek oluştur
@@ -62,6 +83,7 @@ void Logger::log(LogLevel level, const std::string& message, const char* file, i
     if (!shouldLog(level)) {
         return;
     }
+    logged_messages_counter(level).inc();
 
     std::string formatted_message = format_log_message(level, message, file, line);
 
@@ -83,6 +105,7 @@ void Logger::log_error_to_cerr(LogLevel level, const std::string& message, const
     if (!shouldLog(level)) {
         return;
     }
+    logged_messages_counter(level).inc();
 
     std::string formatted_message = format_log_message(level, message, file, line);
 
@@ -0,0 +1,255 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace CerebrumLux {
+namespace Metrics {
+
+namespace {
+
+int highest_bit(std::uint64_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int bit = 0;
+    while (v >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+// Prometheus'a ihraç edilen kaba kova sınırları (saniye). İnce HDR kovaları bu sınırlara toplanır.
+constexpr double kExportBoundsSeconds[] = {
+    0.000001, 0.00001, 0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1.0, 5.0, 10.0, 30.0, 60.0
+};
+
+std::string full_key(const std::string& name, const std::string& labels) {
+    return labels.empty() ? name : name + "{" + labels + "}";
+}
+
+std::string with_label(const std::string& labels, const std::string& extra) {
+    return labels.empty() ? extra : labels + "," + extra;
+}
+
+void append_double(std::ostringstream& out, double v) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.9g", v);
+    out << buf;
+}
+
+} // namespace
+
+// --- Gauge ---
+
+std::uint64_t Gauge::to_bits(double v) noexcept {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+double Gauge::from_bits(std::uint64_t bits) noexcept {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+void Gauge::add(double delta) noexcept {
+    std::uint64_t expected = bits_.load(std::memory_order_relaxed);
+    while (!bits_.compare_exchange_weak(expected, to_bits(from_bits(expected) + delta), std::memory_order_relaxed)) {
+    }
+}
+
+// --- Histogram ---
+
+std::size_t Histogram::bucket_index(std::uint64_t value) noexcept {
+    if (value < kSubBucketCount) return static_cast<std::size_t>(value);
+    const int exponent = highest_bit(value);
+    const int shift = exponent - kSubBucketBits;
+    const std::size_t block = static_cast<std::size_t>(shift + 1);
+    const std::size_t sub = static_cast<std::size_t>(value >> shift) - kSubBucketCount;
+    return block * kSubBucketCount + sub;
+}
+
+std::uint64_t Histogram::bucket_upper_bound(std::size_t index) noexcept {
+    if (index < kSubBucketCount) return index;
+    const std::size_t block = index / kSubBucketCount;
+    const std::size_t sub = index % kSubBucketCount;
+    const int shift = static_cast<int>(block) - 1;
+    const std::uint64_t lower = static_cast<std::uint64_t>(kSubBucketCount + sub) << shift;
+    return lower + ((std::uint64_t(1) << shift) - 1);
+}
+
+void Histogram::record(std::uint64_t value) noexcept {
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    std::uint64_t current_max = max_.load(std::memory_order_relaxed);
+    while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snap;
+    snap.buckets.resize(kBucketCount);
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        snap.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += snap.buckets[i];
+    }
+    // count_ kovalardan ayrı okunduğu için eşzamanlı kayıtlarda birkaç örnek sapabilir;
+    // kova toplamı kullanılarak snapshot kendi içinde tutarlı tutulur.
+    snap.count = total;
+    snap.sum = sum_.load(std::memory_order_relaxed);
+    snap.max = max_.load(std::memory_order_relaxed);
+    return snap;
+}
+
+std::uint64_t HistogramSnapshot::quantile(double q) const {
+    if (count == 0) return 0;
+    q = std::min(1.0, std::max(0.0, q));
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(Histogram::bucket_upper_bound(i), max);
+    }
+    return max;
+}
+
+// --- MetricsRegistry ---
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+void* MetricsRegistry::find_locked(const std::string& name, const std::string& labels, MetricType type) const {
+    for (const auto& entry : entries_) {
+        if (entry.type == type && entry.name == name && entry.labels == labels) return entry.metric;
+    }
+    return nullptr;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (void* existing = find_locked(name, labels, MetricType::Counter)) return *static_cast<Counter*>(existing);
+    counters_.emplace_back();
+    entries_.push_back({name, labels, help, MetricType::Counter, &counters_.back()});
+    return counters_.back();
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (void* existing = find_locked(name, labels, MetricType::Gauge)) return *static_cast<Gauge*>(existing);
+    gauges_.emplace_back();
+    entries_.push_back({name, labels, help, MetricType::Gauge, &gauges_.back()});
+    return gauges_.back();
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (void* existing = find_locked(name, labels, MetricType::Histogram)) return *static_cast<Histogram*>(existing);
+    histograms_.emplace_back();
+    entries_.push_back({name, labels, help, MetricType::Histogram, &histograms_.back()});
+    return histograms_.back();
+}
+
+std::string MetricsRegistry::to_prometheus_text() const {
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries = entries_;
+    }
+    // Aynı isimli (farklı etiketli) seriler tek HELP/TYPE başlığı altında gruplanır.
+    std::map<std::string, std::vector<const Entry*>> by_name;
+    for (const auto& entry : entries) by_name[entry.name].push_back(&entry);
+
+    std::ostringstream out;
+    for (const auto& group : by_name) {
+        const Entry& first = *group.second.front();
+        const char* type_name = first.type == MetricType::Counter ? "counter" : first.type == MetricType::Gauge ? "gauge" : "histogram";
+        out << "# HELP " << group.first << ' ' << first.help << '\n';
+        out << "# TYPE " << group.first << ' ' << type_name << '\n';
+
+        for (const Entry* entry : group.second) {
+            if (entry->type == MetricType::Counter) {
+                out << full_key(entry->name, entry->labels) << ' ' << static_cast<const Counter*>(entry->metric)->value() << '\n';
+            } else if (entry->type == MetricType::Gauge) {
+                out << full_key(entry->name, entry->labels) << ' ';
+                append_double(out, static_cast<const Gauge*>(entry->metric)->value());
+                out << '\n';
+            } else {
+                const HistogramSnapshot snap = static_cast<const Histogram*>(entry->metric)->snapshot();
+                std::size_t bucket = 0;
+                std::uint64_t cumulative = 0;
+                for (double bound_s : kExportBoundsSeconds) {
+                    const std::uint64_t bound_ns = static_cast<std::uint64_t>(bound_s * 1e9);
+                    while (bucket < snap.buckets.size() && Histogram::bucket_upper_bound(bucket) <= bound_ns) {
+                        cumulative += snap.buckets[bucket++];
+                    }
+                    std::ostringstream le;
+                    le << "le=\"";
+                    append_double(le, bound_s);
+                    le << '"';
+                    out << full_key(entry->name + "_bucket", with_label(entry->labels, le.str())) << ' ' << cumulative << '\n';
+                }
+                out << full_key(entry->name + "_bucket", with_label(entry->labels, "le=\"+Inf\"")) << ' ' << snap.count << '\n';
+                out << full_key(entry->name + "_sum", entry->labels) << ' ';
+                append_double(out, static_cast<double>(snap.sum) / 1e9);
+                out << '\n';
+                out << full_key(entry->name + "_count", entry->labels) << ' ' << snap.count << '\n';
+            }
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::write_prometheus_file(const std::string& path) const {
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out << to_prometheus_text();
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        // Windows'ta hedef dosya başka bir süreçte açıkken rename başarısız olabilir; silip bir kez daha dene.
+        std::filesystem::remove(path, ec);
+        std::filesystem::rename(tmp_path, path, ec);
+    }
+    return !ec;
+}
+
+std::vector<MetricSample> MetricsRegistry::sample() const {
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries = entries_;
+    }
+    std::vector<MetricSample> samples;
+    samples.reserve(entries.size());
+    for (const auto& entry : entries) {
+        MetricSample s{full_key(entry.name, entry.labels), entry.type, 0.0, 0};
+        if (entry.type == MetricType::Counter) {
+            s.value = static_cast<double>(static_cast<const Counter*>(entry.metric)->value());
+        } else if (entry.type == MetricType::Gauge) {
+            s.value = static_cast<const Gauge*>(entry.metric)->value();
+        } else {
+            const HistogramSnapshot snap = static_cast<const Histogram*>(entry.metric)->snapshot();
+            s.value = static_cast<double>(snap.quantile(0.99)) / 1e6;
+            s.count = snap.count;
+        }
+        samples.push_back(std::move(s));
+    }
+    return samples;
+}
+
+} // namespace Metrics
+} // namespace CerebrumLux
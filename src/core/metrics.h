@@ -0,0 +1,161 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CerebrumLux {
+namespace Metrics {
+
+// Çalışma zamanı metrikleri.
+//
+// Sıcak yolda yalnızca relaxed atomik işlemler yapılır (kilit yok, bellek ayırma yok).
+// Metrikler kayıt defterinden bir kez alınır ve referansı saklanır:
+//
+//   static auto& hits = Metrics::MetricsRegistry::instance().counter("cerebrumlux_cache_hits_total", "Önbellek isabetleri");
+//   hits.inc();
+//
+// Kayıt (registration) mutex altında yapılır; aynı isim + etiketle yapılan ikinci kayıt aynı nesneyi döndürür.
+
+// Farklı metrikler aynı önbellek satırını paylaşıp birbirini yavaşlatmasın diye hizalanır.
+constexpr std::size_t kCacheLineSize = 64;
+
+class alignas(kCacheLineSize) Counter {
+public:
+    void inc(std::uint64_t n = 1) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+class alignas(kCacheLineSize) Gauge {
+public:
+    void set(double v) noexcept { bits_.store(to_bits(v), std::memory_order_relaxed); }
+    void add(double delta) noexcept;
+    void inc() noexcept { add(1.0); }
+    void dec() noexcept { add(-1.0); }
+    double value() const noexcept { return from_bits(bits_.load(std::memory_order_relaxed)); }
+
+private:
+    static std::uint64_t to_bits(double v) noexcept;
+    static double from_bits(std::uint64_t bits) noexcept;
+
+    std::atomic<std::uint64_t> bits_{0}; // 0 bit deseni == 0.0
+};
+
+// Bir histogramın tutarlı olması gerekmeyen, ihracat/görselleştirme için alınmış kopyası.
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t max = 0;
+
+    // q in [0,1]. Dönen değer kovanın üst sınırıdır (ölçüm birimi: kaydedilen birim, genelde ns).
+    std::uint64_t quantile(double q) const;
+    double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+// HDR tarzı log-lineer histogram: her ikinin kuvveti aralığı 16 alt kovaya bölünür (~%6 göreli hata).
+// 0..2^64 aralığındaki tamsayı değerleri (tipik olarak nanosaniye) sabit boyutlu dizide tutar.
+class alignas(kCacheLineSize) Histogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr std::size_t kSubBucketCount = std::size_t(1) << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    void record(std::uint64_t value) noexcept;
+    void record_duration(std::chrono::nanoseconds d) noexcept {
+        record(d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0);
+    }
+
+    std::uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    HistogramSnapshot snapshot() const;
+
+    static std::size_t bucket_index(std::uint64_t value) noexcept;
+    // Kovaya düşen en büyük değer (dahil).
+    static std::uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+    std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+};
+
+// Kapsam süresini bir histograma nanosaniye olarak yazar.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram) noexcept
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { histogram_.record_duration(std::chrono::steady_clock::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+enum class MetricType { Counter, Gauge, Histogram };
+
+// GraphPanel gibi tüketiciler için tek bir metriğin anlık değeri.
+struct MetricSample {
+    std::string key;  // name{labels}
+    MetricType type;
+    double value;     // Counter: toplam, Gauge: değer, Histogram: p99 (ms)
+    std::uint64_t count; // Histogram: örnek sayısı, diğerleri: 0
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    // labels Prometheus biçiminde, süslü parantezsiz verilir: type="inference",result="ok"
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    // Histogramlar nanosaniye kaydeder; Prometheus'a saniye olarak ihraç edilir.
+    Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    // Prometheus metin biçimi (text/plain; version=0.0.4).
+    std::string to_prometheus_text() const;
+    // Geçici dosyaya yazıp yeniden adlandırır; okuyucu yarım dosya görmez.
+    bool write_prometheus_file(const std::string& path) const;
+
+    std::vector<MetricSample> sample() const;
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    struct Entry {
+        std::string name;
+        std::string labels;
+        std::string help;
+        MetricType type;
+        void* metric;
+    };
+
+    void* find_locked(const std::string& name, const std::string& labels, MetricType type) const;
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_; // Kayıt sırası korunur
+    // deque: yeni kayıtlar mevcut referansları geçersiz kılmaz
+    std::deque<Counter> counters_;
+    std::deque<Gauge> gauges_;
+    std::deque<Histogram> histograms_;
+};
+
+} // namespace Metrics
+} // namespace CerebrumLux
+
+#endif // METRICS_H
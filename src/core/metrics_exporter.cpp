@@ -0,0 +1,107 @@
+#include "metrics_exporter.h"
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "logger.h"
+#include "metrics.h"
+
+namespace CerebrumLux {
+
+namespace {
+
+QByteArray http_response(const QByteArray& status, const QByteArray& content_type, const QByteArray& body) {
+    QByteArray response;
+    response.reserve(body.size() + 160);
+    response += "HTTP/1.1 " + status + "\r\n";
+    response += "Content-Type: " + content_type + "\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(QObject* parent) : QObject(parent) {}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::startHttp(quint16 port) {
+    if (!server_) {
+        server_ = new QTcpServer(this);
+        connect(server_, &QTcpServer::newConnection, this, &MetricsExporter::onNewConnection);
+    }
+    if (server_->isListening()) server_->close();
+    // Yalnızca loopback: metrikler ağ dışına açılmaz.
+    if (!server_->listen(QHostAddress::LocalHost, port)) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "MetricsExporter: HTTP uç noktası başlatılamadı (port " << port << "): " << server_->errorString().toStdString());
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::INFO, "MetricsExporter: Prometheus uç noktası http://127.0.0.1:" << server_->serverPort() << "/metrics adresinde dinleniyor.");
+    return true;
+}
+
+void MetricsExporter::startFileDump(const QString& path, int interval_ms) {
+    dump_path_ = path;
+    if (!dump_timer_) {
+        dump_timer_ = new QTimer(this);
+        connect(dump_timer_, &QTimer::timeout, this, &MetricsExporter::onDumpTimer);
+    }
+    dump_timer_->start(interval_ms);
+    onDumpTimer();
+    LOG_DEFAULT(LogLevel::INFO, "MetricsExporter: Metrikler her " << interval_ms << " ms'de " << path.toStdString() << " dosyasına yazılacak.");
+}
+
+void MetricsExporter::stop() {
+    if (server_ && server_->isListening()) server_->close();
+    if (dump_timer_) dump_timer_->stop();
+}
+
+quint16 MetricsExporter::httpPort() const {
+    return server_ && server_->isListening() ? server_->serverPort() : 0;
+}
+
+void MetricsExporter::startFromEnvironment() {
+    bool ok = false;
+    const int port = qEnvironmentVariableIntValue("CEREBRUMLUX_METRICS_PORT", &ok);
+    if (ok && port > 0 && port <= 65535) startHttp(static_cast<quint16>(port));
+
+    const QString file_path = qEnvironmentVariable("CEREBRUMLUX_METRICS_FILE");
+    if (!file_path.isEmpty()) startFileDump(file_path);
+}
+
+void MetricsExporter::onNewConnection() {
+    while (QTcpSocket* socket = server_->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [socket]() {
+            // İstek satırı tek pakette gelir; başlıkların geri kalanıyla ilgilenmiyoruz.
+            if (!socket->canReadLine()) return;
+            const QList<QByteArray> request_line = socket->readLine().trimmed().split(' ');
+            socket->readAll();
+
+            if (request_line.size() >= 2 && request_line[0] == "GET" &&
+                (request_line[1] == "/metrics" || request_line[1] == "/")) {
+                const QByteArray body = QByteArray::fromStdString(Metrics::MetricsRegistry::instance().to_prometheus_text());
+                socket->write(http_response("200 OK", "text/plain; version=0.0.4; charset=utf-8", body));
+            } else {
+                socket->write(http_response("404 Not Found", "text/plain", "not found\n"));
+            }
+            socket->disconnectFromHost();
+        });
+    }
+}
+
+void MetricsExporter::onDumpTimer() {
+    if (dump_path_.isEmpty()) return;
+    if (!Metrics::MetricsRegistry::instance().write_prometheus_file(dump_path_.toStdString())) {
+        LOG_DEFAULT(LogLevel::WARNING, "MetricsExporter: Metrik dosyası yazılamadı: " << dump_path_.toStdString());
+    }
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,44 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include <QObject>
+#include <QString>
+
+class QTcpServer;
+class QTimer;
+
+namespace CerebrumLux {
+
+// MetricsRegistry içeriğini Prometheus metin biçiminde dışarı verir:
+//  - startHttp(): yalnızca 127.0.0.1 üzerinde dinleyen, "GET /metrics" isteğine yanıt veren küçük bir HTTP uç noktası
+//  - startFileDump(): belirli aralıklarla yerel bir dosyaya yazım (node_exporter textfile collector ile uyumlu)
+// Olay döngüsüne sahip thread'de (GUI ana thread'i) yaşamalıdır.
+class MetricsExporter : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MetricsExporter(QObject* parent = nullptr);
+    ~MetricsExporter() override;
+
+    bool startHttp(quint16 port);
+    void startFileDump(const QString& path, int interval_ms = 5000);
+    void stop();
+
+    quint16 httpPort() const;
+
+    // CEREBRUMLUX_METRICS_PORT ve CEREBRUMLUX_METRICS_FILE ortam değişkenlerine göre ihracatçıları başlatır.
+    void startFromEnvironment();
+
+private slots:
+    void onNewConnection();
+    void onDumpTimer();
+
+private:
+    QTcpServer* server_ = nullptr;
+    QTimer* dump_timer_ = nullptr;
+    QString dump_path_;
+};
+
+} // namespace CerebrumLux
+
+#endif // METRICS_EXPORTER_H
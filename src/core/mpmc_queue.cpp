@@ -0,0 +1,74 @@
+#include "mpmc_queue.h"
+
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace CerebrumLux {
+
+namespace {
+
+#if defined(__linux__)
+void futex_wait(std::atomic<std::uint32_t>* address, std::uint32_t expected) {
+    // Değer hâlâ expected ise uyur; değiştiyse EAGAIN ile hemen döner. Sahte uyanmalar çağıranın döngüsünde ele alınır.
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futex_wake(std::atomic<std::uint32_t>* address, int count) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(address), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#endif
+
+} // namespace
+
+std::uint32_t EventCount::prepare_wait() {
+    waiters_.fetch_add(1, std::memory_order_relaxed);
+    // Bekleyen kaydı, çağıranın koşulu yeniden okumasından önce görünür olmalı (notify'daki çitle eşleşir).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_acquire);
+}
+
+void EventCount::cancel_wait() {
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void EventCount::wait(std::uint32_t key) {
+#if defined(__linux__)
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        futex_wait(&epoch_, key);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return epoch_.load(std::memory_order_acquire) != key; });
+    }
+#endif
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void EventCount::notify(bool all) {
+    // Koşulu değiştiren yazma, bekleyen sayısının okunmasından önce görünür olmalı (prepare_wait'teki çitle eşleşir).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) return;
+#if defined(__linux__)
+    epoch_.fetch_add(1, std::memory_order_release);
+    futex_wake(&epoch_, all ? INT_MAX : 1);
+#else
+    {
+        // Dönem mutex altında artırılır; böylece koşulu kontrol edip henüz uyumamış bekleyen uyandırmayı kaçırmaz.
+        std::lock_guard<std::mutex> lock(mutex_);
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (all) {
+        cv_.notify_all();
+    } else {
+        cv_.notify_one();
+    }
+#endif
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,224 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace CerebrumLux {
+
+// Kilitsiz yapılar için bekleme noktası (event count). Bekleyen yoksa notify yalnızca bir çit ve bir atomik okumadır.
+//
+// Kullanım: key = prepare_wait(); koşulu yeniden dene; olduysa cancel_wait(), olmadıysa wait(key). Koşulu değiştiren
+// taraf değişiklikten sonra notify_* çağırır; prepare_wait'ten sonra yapılan bir notify wait(key)'i hemen döndürür.
+// Linux'ta doğrudan futex kullanılır; diğer platformlarda mutex + condition_variable yedeği devreye girer.
+class EventCount {
+public:
+    std::uint32_t prepare_wait();
+    void cancel_wait();
+    void wait(std::uint32_t key);
+    void notify_one() { notify(false); }
+    void notify_all() { notify(true); }
+
+private:
+    void notify(bool all);
+
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+#if !defined(__linux__)
+    std::mutex mutex_;
+    std::condition_variable cv_;
+#endif
+};
+
+// Sınırlı, kilitsiz çok üreticili / çok tüketicili kuyruk (Vyukov'un hücre sıra numaralı halka tamponu).
+//
+// try_push/try_pop hiç kilit almaz ve bellek ayırmaz; her hücrenin sıra numarası hücrenin yazılmaya mı okunmaya mı
+// hazır olduğunu söyler, üretici ve tüketici konumları ayrı önbellek satırlarındadır. push/pop kuyruk dolu/boşken
+// EventCount üzerinde uyur (meşgul bekleme veya periyodik yoklama yok). close() sonrası push başarısız olur; pop
+// kalan öğeleri verir, kuyruk boşalınca false döner. close() ile yarışan ve başarılı dönen her push'un öğesi pop
+// tarafından teslim edilir: pop kapanışı gördükten sonra devam eden eklemelerin bitmesini bekler.
+//
+// T varsayılan kurulabilir ve taşınabilir olmalıdır. Kapasite ikinin kuvvetine yuvarlanır (en az 2).
+template <typename T>
+class BoundedMpmcQueue {
+public:
+    explicit BoundedMpmcQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (std::size_t i = 0; i < size; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    // Kuyruk doluysa veya kapatıldıysa false döner; bu durumda value değişmeden kalır.
+    bool try_push(T& value) {
+        // Ekleme, kapanış kontrolünden önce kaydedilir (ikisi de seq_cst): kontrolü geçen bir ekleme close()'tan sonra
+        // tamamlansa bile pop'un son boşaltması onu bekler ve öğe kuyrukta sahipsiz kalmaz.
+        pushers_.fetch_add(1, std::memory_order_seq_cst);
+        if (closed_.load(std::memory_order_seq_cst)) {
+            pushers_.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        const bool pushed = enqueue(value);
+        pushers_.fetch_sub(1, std::memory_order_release);
+        if (!pushed) return false;
+        not_empty_.notify_one();
+        return true;
+    }
+    bool try_push(T&& value) { return try_push(value); }
+
+    bool try_pop(T& out) {
+        if (!dequeue(out)) return false;
+        not_full_.notify_one();
+        return true;
+    }
+
+    // Yer açılana kadar bekler; kuyruk kapatıldıysa false.
+    bool push(T value) {
+        for (;;) {
+            if (try_push(value)) return true;
+            if (closed_.load(std::memory_order_acquire)) return false;
+            const std::uint32_t key = not_full_.prepare_wait();
+            if (try_push(value)) {
+                not_full_.cancel_wait();
+                return true;
+            }
+            if (closed_.load(std::memory_order_acquire)) {
+                not_full_.cancel_wait();
+                return false;
+            }
+            not_full_.wait(key);
+        }
+    }
+
+    // Öğe gelene kadar bekler; kuyruk kapatılmış ve boşsa false.
+    bool pop(T& out) {
+        for (;;) {
+            if (try_pop(out)) return true;
+            const std::uint32_t key = not_empty_.prepare_wait();
+            if (try_pop(out)) {
+                not_empty_.cancel_wait();
+                return true;
+            }
+            if (closed_.load(std::memory_order_seq_cst)) {
+                not_empty_.cancel_wait();
+                return drain_after_close(out);
+            }
+            not_empty_.wait(key);
+        }
+    }
+
+    // Bekleyen tüm üretici ve tüketicileri uyandırır.
+    void close() {
+        closed_.store(true, std::memory_order_seq_cst);
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    // Tüketilmemiş öğeleri kuyruğu değiştirmeden eskiden yeniye gezer; üreticileri ve tüketicileri bloklamaz. read(const T&)
+    // hücreye eşzamanlı yazılırken çağrılabilir, bu yüzden T'nin okunması yazmayla yarışmamalıdır (ör. atomik
+    // sözcüklerden oluşan T). read'in sonucu, okuma sırasında hücrenin sıra numarası değişmediyse (seqlock) keep'e
+    // verilir; o arada tüketilen veya üzerine yazılan hücreler atlanır.
+    template <typename Read, typename Keep>
+    void peek(Read&& read, Keep&& keep) const {
+        const std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        for (std::size_t pos = head; pos < tail; ++pos) {
+            const Cell& cell = cells_[pos & mask_];
+            const std::size_t seq_before = cell.sequence.load(std::memory_order_acquire);
+            if (seq_before != pos + 1) continue; // Henüz yazılmamış veya tüketilmiş
+            auto copy = read(cell.value);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (cell.sequence.load(std::memory_order_relaxed) != seq_before) continue; // Okurken değişti
+            keep(std::move(copy));
+        }
+    }
+
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return mask_ + 1; }
+    // Eşzamanlı değişiklikler sırasında yaklaşık değerdir (metrikler için).
+    std::size_t size_approx() const {
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        const std::size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    bool enqueue(T& value) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Dolu
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Kapanış görüldükten sonra: kapanış kontrolünü geçmiş eklemeler (en fazla birkaç CAS sürer) bitene kadar bekler,
+    // sonra kalan öğeyi alır.
+    bool drain_after_close(T& out) {
+        if (try_pop(out)) return true;
+        while (pushers_.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        return try_pop(out);
+    }
+
+    bool dequeue(T& out) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.value = T{}; // Taşınan öğenin kaynakları hücrede bir tur boyunca tutulmasın
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Boş
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(kCacheLine) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(kCacheLine) std::atomic<bool> closed_{false};
+    alignas(kCacheLine) std::atomic<std::uint32_t> pushers_{0}; // Kapanış kontrolünü geçmiş, sürmekte olan eklemeler
+    EventCount not_empty_;
+    EventCount not_full_;
+};
+
+} // namespace CerebrumLux
+
+#endif // MPMC_QUEUE_H
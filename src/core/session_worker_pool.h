@@ -0,0 +1,127 @@
+#ifndef SESSION_WORKER_POOL_H
+#define SESSION_WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "mpmc_queue.h"
+
+namespace CerebrumLux {
+
+// Oturum sıralı işçi havuzu: her işçinin kendi sınırlı kilitsiz kuyruğu (şerit) vardır ve bir oturumun tüm öğeleri
+// session % workers şeridine düşer. Böylece aynı oturumun mesajları gönderildiği sırayla ve tek işçide işlenir,
+// farklı oturumlar ise işçiler arasında paralel ilerler. İşçiler boşta EventCount üzerinde uyur (yoklama yok).
+//
+// İşleyici (worker, item) ile çağrılır; worker indeksi işçiye özel durumu (ör. model örnekleri) seçmek içindir.
+// İşleyici istisna fırlatmamalıdır; hataları kendi içinde raporlamalıdır.
+// İşçiler uzun süre bloklayan işler (LLM çağrıları) yürüttüğünden ortak TaskScheduler yerine ayrılmış iş
+// parçacıkları kullanılır; oturum yapışkanlığı da ancak böyle korunur.
+template <typename T>
+class SessionWorkerPool {
+public:
+    using Handler = std::function<void(std::size_t worker, T& item)>;
+
+    SessionWorkerPool() = default;
+    ~SessionWorkerPool() { stop(); }
+
+    // workers 0 ise donanım iş parçacığı sayısı kullanılır. Zaten çalışıyorsa false döner.
+    bool start(std::size_t workers, std::size_t lane_capacity, Handler handler) {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (std::atomic_load(&state_)) return false;
+        if (workers == 0) workers = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        auto state = std::make_shared<State>();
+        state->handler = std::move(handler);
+        state->lanes.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            state->lanes.push_back(std::make_unique<BoundedMpmcQueue<T>>(lane_capacity));
+        }
+        State* raw = state.get();
+        for (std::size_t i = 0; i < workers; ++i) {
+            state->threads.emplace_back([raw, i] { run_lane(*raw, i); });
+        }
+        std::atomic_store(&state_, std::move(state));
+        return true;
+    }
+
+    // Şeritleri kapatır ve işçileri bekler. drain true ise kuyruktaki öğeler işlenir, değilse atılır; işlenmekte
+    // olan öğe her durumda tamamlanır. İşleyicinin içinden çağrılmamalıdır.
+    void stop(bool drain = false) {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        std::shared_ptr<State> state = std::atomic_load(&state_);
+        if (!state) return;
+        state->drop_pending.store(!drain, std::memory_order_release);
+        for (auto& lane : state->lanes) lane->close();
+        // running() false olduğunda şeritler kapalıdır; yarışan gönderimler kapalı şeride düşüp false alır.
+        std::atomic_store(&state_, std::shared_ptr<State>());
+        for (std::thread& t : state->threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    // Şerit doluysa veya havuz çalışmıyorsa false döner (çağıran geri basınç uygular); item bu durumda korunur.
+    bool try_post(std::uint64_t session, T& item) {
+        const std::shared_ptr<State> state = std::atomic_load(&state_);
+        return state && state->lane_for(session).try_push(item);
+    }
+
+    // Şeritte yer açılana kadar bekler; havuz çalışmıyorsa veya beklerken durdurulursa false.
+    bool post(std::uint64_t session, T item) {
+        const std::shared_ptr<State> state = std::atomic_load(&state_);
+        return state && state->lane_for(session).push(std::move(item));
+    }
+
+    bool running() const { return static_cast<bool>(std::atomic_load(&state_)); }
+
+    std::size_t worker_count() const {
+        const std::shared_ptr<State> state = std::atomic_load(&state_);
+        return state ? state->lanes.size() : 0;
+    }
+
+    // Tüm şeritlerdeki yaklaşık bekleyen öğe sayısı.
+    std::size_t pending_approx() const {
+        const std::shared_ptr<State> state = std::atomic_load(&state_);
+        std::size_t total = 0;
+        if (state) {
+            for (const auto& lane : state->lanes) total += lane->size_approx();
+        }
+        return total;
+    }
+
+private:
+    struct State {
+        Handler handler;
+        std::vector<std::unique_ptr<BoundedMpmcQueue<T>>> lanes;
+        std::vector<std::thread> threads;
+        std::atomic<bool> drop_pending{false};
+
+        BoundedMpmcQueue<T>& lane_for(std::uint64_t session) { return *lanes[session % lanes.size()]; }
+    };
+
+    static void run_lane(State& state, std::size_t index) {
+        BoundedMpmcQueue<T>& lane = *state.lanes[index];
+        T item;
+        while (lane.pop(item)) {
+            if (lane.closed() && state.drop_pending.load(std::memory_order_acquire)) break;
+            state.handler(index, item);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+    std::mutex control_mutex_;
+
+    SessionWorkerPool(const SessionWorkerPool&) = delete;
+    SessionWorkerPool& operator=(const SessionWorkerPool&) = delete;
+};
+
+} // namespace CerebrumLux
+
+#endif // SESSION_WORKER_POOL_H
@@ -0,0 +1,446 @@
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+
+#include "logger.h"
+#include "metrics.h"
+
+namespace CerebrumLux {
+
+namespace detail {
+
+struct TaskState {
+    enum Status : int { Queued, Running, Finished, Cancelled };
+
+    TaskScheduler::Task fn;
+    TaskClass cls = TaskClass::Interactive;
+    std::chrono::steady_clock::time_point enqueued;
+    std::atomic<int> status{Queued};
+    std::atomic<bool> cancel_requested{false};
+    const std::atomic<bool>* stopping = nullptr; // Zamanlayıcının kapanma bayrağı (belirteç için)
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool completed = false; // mutex altında; Finished veya Cancelled'a geçişten sonra true
+
+    void complete(Status final_status) {
+        status.store(final_status, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex);
+        completed = true;
+        cv.notify_all();
+    }
+};
+
+} // namespace detail
+
+namespace {
+
+constexpr std::size_t index_of(TaskClass cls) { return static_cast<std::size_t>(cls); }
+
+struct SchedulerClassMetrics {
+    explicit SchedulerClassMetrics(TaskClass cls)
+        : labels(std::string("class=\"") + task_class_to_string(cls) + "\""),
+          queue_depth(Metrics::MetricsRegistry::instance().gauge(
+              "cerebrumlux_scheduler_queue_depth", "TaskScheduler kuyruğunda bekleyen görev sayısı", labels)),
+          running(Metrics::MetricsRegistry::instance().gauge(
+              "cerebrumlux_scheduler_running", "TaskScheduler'da çalışan görev sayısı", labels)),
+          queue_wait(Metrics::MetricsRegistry::instance().histogram(
+              "cerebrumlux_scheduler_queue_wait_seconds", "Görevin gönderimden başlamaya kadar beklediği süre", labels)),
+          run_time(Metrics::MetricsRegistry::instance().histogram(
+              "cerebrumlux_scheduler_run_seconds", "Görevin çalışma süresi", labels)),
+          completed(Metrics::MetricsRegistry::instance().counter(
+              "cerebrumlux_scheduler_tasks_total", "TaskScheduler görev sonuçları", labels + ",result=\"completed\"")),
+          cancelled(Metrics::MetricsRegistry::instance().counter(
+              "cerebrumlux_scheduler_tasks_total", "TaskScheduler görev sonuçları", labels + ",result=\"cancelled\"")),
+          failed(Metrics::MetricsRegistry::instance().counter(
+              "cerebrumlux_scheduler_tasks_total", "TaskScheduler görev sonuçları", labels + ",result=\"failed\"")) {}
+
+    std::string labels;
+    Metrics::Gauge& queue_depth;
+    Metrics::Gauge& running;
+    Metrics::Histogram& queue_wait;
+    Metrics::Histogram& run_time;
+    Metrics::Counter& completed;
+    Metrics::Counter& cancelled;
+    Metrics::Counter& failed;
+};
+
+SchedulerClassMetrics& class_metrics(TaskClass cls) {
+    static SchedulerClassMetrics metrics[kTaskClassCount] = {
+        SchedulerClassMetrics(TaskClass::Interactive),
+        SchedulerClassMetrics(TaskClass::Inference),
+        SchedulerClassMetrics(TaskClass::BackgroundLearning),
+        SchedulerClassMetrics(TaskClass::Persistence),
+    };
+    return metrics[index_of(cls)];
+}
+
+// İşçi iş parçacığının hangi zamanlayıcıya ait olduğu; bu iş parçacığından yapılan gönderimler kendi kuyruğuna gider.
+thread_local const TaskScheduler* t_scheduler = nullptr;
+thread_local std::size_t t_worker_index = 0;
+
+} // namespace
+
+const char* task_class_to_string(TaskClass cls) {
+    switch (cls) {
+        case TaskClass::Interactive: return "interactive";
+        case TaskClass::Inference: return "inference";
+        case TaskClass::BackgroundLearning: return "background_learning";
+        case TaskClass::Persistence: return "persistence";
+    }
+    return "unknown";
+}
+
+// --- CancellationToken ---
+
+bool CancellationToken::cancelled() const {
+    if (!state_) return false;
+    return state_->cancel_requested.load(std::memory_order_relaxed) ||
+           (state_->stopping && state_->stopping->load(std::memory_order_relaxed));
+}
+
+// --- TaskHandle ---
+
+void TaskHandle::cancel() {
+    if (!state_) return;
+    state_->cancel_requested.store(true, std::memory_order_relaxed);
+    int expected = detail::TaskState::Queued;
+    if (state_->status.compare_exchange_strong(expected, detail::TaskState::Cancelled)) {
+        scheduler_->finish_cancelled(*state_);
+    }
+}
+
+bool TaskHandle::wait() {
+    if (!state_) return true;
+    if (state_->status.load(std::memory_order_acquire) == detail::TaskState::Queued) {
+        scheduler_->execute(*state_, true); // Başka biri önce aldıysa hiçbir şey yapmaz
+    }
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->cv.wait(lock, [this] { return state_->completed; });
+    return state_->status.load(std::memory_order_acquire) == detail::TaskState::Finished;
+}
+
+bool TaskHandle::wait_for(std::chrono::milliseconds timeout) {
+    if (!state_) return true;
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->cv.wait_for(lock, timeout, [this] { return state_->completed; });
+}
+
+bool TaskHandle::done() const {
+    if (!state_) return true;
+    const int status = state_->status.load(std::memory_order_acquire);
+    return status == detail::TaskState::Finished || status == detail::TaskState::Cancelled;
+}
+
+// --- TaskScheduler ---
+
+struct TaskScheduler::Worker {
+    std::mutex mutex;
+    std::array<std::deque<std::shared_ptr<detail::TaskState>>, kTaskClassCount> queues;
+};
+
+struct TaskScheduler::ClassCounters {
+    std::atomic<std::size_t> queued{0};  // Henüz başlamamış (Queued durumundaki) görevler
+    std::atomic<std::size_t> entries{0}; // Kuyruklardaki girdiler; wait() ile yürütülen veya iptal edilenler alınana kadar kalır
+    std::atomic<std::size_t> running{0};
+    std::atomic<std::size_t> limit{1};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> cancelled{0};
+    std::atomic<std::uint64_t> failed{0};
+};
+
+std::size_t TaskScheduler::default_max_concurrency(TaskClass cls, std::size_t workers) {
+    switch (cls) {
+        case TaskClass::Interactive: return workers;
+        case TaskClass::Inference: return std::min<std::size_t>(workers, 2);
+        case TaskClass::BackgroundLearning: return std::max<std::size_t>(1, workers / 4);
+        case TaskClass::Persistence: return 1;
+    }
+    return 1;
+}
+
+TaskScheduler::TaskScheduler() : TaskScheduler(Options{}) {}
+
+TaskScheduler::TaskScheduler(const Options& options) : counters_(new ClassCounters[kTaskClassCount]) {
+    const std::size_t hardware = std::max<unsigned>(2, std::thread::hardware_concurrency());
+    const std::size_t workers = options.workers > 0 ? options.workers : hardware;
+    for (std::size_t c = 0; c < kTaskClassCount; ++c) {
+        const TaskClass cls = static_cast<TaskClass>(c);
+        const std::size_t limit = options.max_concurrency[c] > 0 ? options.max_concurrency[c]
+                                                                  : default_max_concurrency(cls, workers);
+        counters_[c].limit.store(std::max<std::size_t>(1, limit), std::memory_order_relaxed);
+        class_metrics(cls); // Metrikler ilk görevden önce kayıtlı olsun
+    }
+
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) workers_.push_back(std::make_unique<Worker>());
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) threads_.emplace_back([this, i] { worker_loop(i); });
+
+    LOG_DEFAULT(LogLevel::INFO, "TaskScheduler: " << workers << " işçiyle başlatıldı. Sınırlar (interactive/inference/background_learning/persistence): "
+                << counters_[0].limit.load() << "/" << counters_[1].limit.load() << "/"
+                << counters_[2].limit.load() << "/" << counters_[3].limit.load());
+}
+
+TaskScheduler::~TaskScheduler() {
+    shutdown();
+}
+
+TaskScheduler& TaskScheduler::instance() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskHandle TaskScheduler::submit(TaskClass cls, std::function<void()> task) {
+    return submit(cls, [task = std::move(task)](const CancellationToken&) { task(); });
+}
+
+TaskHandle TaskScheduler::submit(TaskClass cls, Task task) {
+    auto state = std::make_shared<detail::TaskState>();
+    state->fn = std::move(task);
+    state->cls = cls;
+    state->stopping = &stopping_;
+    state->enqueued = std::chrono::steady_clock::now();
+    TaskHandle handle(state, this);
+
+    ClassCounters& counters = counters_[index_of(cls)];
+    counters.queued.fetch_add(1, std::memory_order_relaxed);
+    class_metrics(cls).queue_depth.inc();
+    if (stopping_.load(std::memory_order_acquire)) {
+        LOG_DEFAULT(LogLevel::WARNING, "TaskScheduler: Kapanırken gönderilen " << task_class_to_string(cls) << " görevi iptal edildi.");
+        state->status.store(detail::TaskState::Cancelled, std::memory_order_relaxed);
+        finish_cancelled(*state);
+        return handle;
+    }
+
+    const std::size_t target = t_scheduler == this ? t_worker_index
+                                                   : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    counters.entries.fetch_add(1, std::memory_order_release);
+    {
+        Worker& worker = *workers_[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[index_of(cls)].push_back(state);
+    }
+
+    if (stopping_.load(std::memory_order_acquire)) {
+        // shutdown kuyrukları bu görev eklenmeden önce boşaltmış olabilir.
+        handle.cancel();
+        return handle;
+    }
+    wake_one();
+    return handle;
+}
+
+void TaskScheduler::parallel_for(TaskClass cls, std::size_t count, const std::function<void(std::size_t)>& fn,
+                                 std::size_t max_participants) {
+    if (count == 0) return;
+    const std::size_t participants = std::min(count, max_participants > 0 ? max_participants : workers_.size() + 1);
+    std::atomic<std::size_t> next{0};
+    auto body = [&] {
+        for (;;) {
+            const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= count) return;
+            fn(i);
+        }
+    };
+    if (participants <= 1) {
+        body();
+        return;
+    }
+
+    std::vector<TaskHandle> helpers;
+    helpers.reserve(participants - 1);
+    for (std::size_t i = 1; i < participants; ++i) helpers.push_back(submit(cls, [&body] { body(); }));
+    try {
+        body();
+    } catch (...) {
+        next.store(count, std::memory_order_relaxed); // Yardımcılar yeni indeks almasın
+        for (TaskHandle& helper : helpers) helper.wait();
+        throw;
+    }
+    // Başlamamış yardımcılar burada çağıran tarafından yürütülür ve boş sayaçla hemen döner.
+    for (TaskHandle& helper : helpers) helper.wait();
+}
+
+void TaskScheduler::set_max_concurrency(TaskClass cls, std::size_t limit) {
+    counters_[index_of(cls)].limit.store(std::max<std::size_t>(1, limit), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ++signal_;
+    }
+    sleep_cv_.notify_all(); // Sınır arttıysa bekleyen görevler hemen alınabilsin
+}
+
+std::size_t TaskScheduler::max_concurrency(TaskClass cls) const {
+    return counters_[index_of(cls)].limit.load(std::memory_order_relaxed);
+}
+
+TaskScheduler::ClassStats TaskScheduler::stats(TaskClass cls) const {
+    const ClassCounters& counters = counters_[index_of(cls)];
+    ClassStats stats;
+    stats.queued = counters.queued.load(std::memory_order_relaxed);
+    stats.running = counters.running.load(std::memory_order_relaxed);
+    stats.completed = counters.completed.load(std::memory_order_relaxed);
+    stats.cancelled = counters.cancelled.load(std::memory_order_relaxed);
+    stats.failed = counters.failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TaskScheduler::shutdown() {
+    std::lock_guard<std::mutex> shutdown_lock(shutdown_mutex_);
+    if (stopping_.exchange(true, std::memory_order_acq_rel) && threads_.empty()) return;
+
+    std::size_t dropped = 0;
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        for (std::size_t c = 0; c < kTaskClassCount; ++c) {
+            auto& queue = worker->queues[c];
+            counters_[c].entries.fetch_sub(queue.size(), std::memory_order_relaxed);
+            for (auto& state : queue) {
+                int expected = detail::TaskState::Queued;
+                if (state->status.compare_exchange_strong(expected, detail::TaskState::Cancelled)) {
+                    finish_cancelled(*state);
+                    ++dropped;
+                }
+            }
+            queue.clear();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ++signal_;
+    }
+    sleep_cv_.notify_all();
+    for (std::thread& thread : threads_) {
+        if (!thread.joinable()) continue;
+        if (thread.get_id() == std::this_thread::get_id()) {
+            thread.detach(); // Bir görevin içinden kapatılıyor; kendi iş parçacığını bekleyemez
+        } else {
+            thread.join();
+        }
+    }
+    threads_.clear();
+    LOG_DEFAULT(LogLevel::INFO, "TaskScheduler: Durduruldu. Başlamadan iptal edilen görev: " << dropped);
+}
+
+void TaskScheduler::worker_loop(std::size_t index) {
+    t_scheduler = this;
+    t_worker_index = index;
+    for (;;) {
+        std::uint64_t seen;
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            seen = signal_;
+        }
+
+        bool ran = false;
+        for (std::size_t c = 0; c < kTaskClassCount && !ran; ++c) {
+            const TaskClass cls = static_cast<TaskClass>(c);
+            if (counters_[c].entries.load(std::memory_order_acquire) == 0) continue;
+            if (!try_reserve(cls)) continue;
+            std::shared_ptr<detail::TaskState> state = take(index, cls);
+            if (state) {
+                execute(*state, false);
+                ran = true;
+            }
+            release(cls);
+        }
+        if (ran) continue; // Her görevden sonra en yüksek öncelikten yeniden tara
+        if (stopping_.load(std::memory_order_acquire)) return;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [&] { return signal_ != seen || stopping_.load(std::memory_order_acquire); });
+    }
+}
+
+std::shared_ptr<detail::TaskState> TaskScheduler::take(std::size_t index, TaskClass cls) {
+    const std::size_t c = index_of(cls);
+    std::shared_ptr<detail::TaskState> state;
+    for (std::size_t k = 0; k < workers_.size() && !state; ++k) {
+        Worker& worker = *workers_[(index + k) % workers_.size()]; // k == 0: kendi kuyruğu, sonra çalma
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        auto& queue = worker.queues[c];
+        if (queue.empty()) continue;
+        state = std::move(queue.front());
+        queue.pop_front();
+    }
+    if (state) counters_[c].entries.fetch_sub(1, std::memory_order_relaxed);
+    return state;
+}
+
+bool TaskScheduler::try_reserve(TaskClass cls) {
+    ClassCounters& counters = counters_[index_of(cls)];
+    std::size_t running = counters.running.load(std::memory_order_relaxed);
+    do {
+        if (running >= counters.limit.load(std::memory_order_relaxed)) return false;
+    } while (!counters.running.compare_exchange_weak(running, running + 1, std::memory_order_acq_rel));
+    return true;
+}
+
+void TaskScheduler::release(TaskClass cls) {
+    counters_[index_of(cls)].running.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void TaskScheduler::execute(detail::TaskState& state, bool inline_run) {
+    int expected = detail::TaskState::Queued;
+    if (!state.status.compare_exchange_strong(expected, detail::TaskState::Running)) return; // İptal edildi veya başkası aldı
+
+    ClassCounters& counters = counters_[index_of(state.cls)];
+    SchedulerClassMetrics& metrics = class_metrics(state.cls);
+    counters.queued.fetch_sub(1, std::memory_order_relaxed);
+    metrics.queue_depth.dec();
+    if (inline_run) counters.running.fetch_add(1, std::memory_order_relaxed); // Bekleyen iş parçacığında; sınır dışı
+    metrics.running.inc();
+
+    const auto start = std::chrono::steady_clock::now();
+    metrics.queue_wait.record_duration(start - state.enqueued);
+    bool failed = false;
+    try {
+        state.fn(CancellationToken(&state));
+    } catch (const std::exception& e) {
+        failed = true;
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "TaskScheduler: " << task_class_to_string(state.cls) << " görevi istisna fırlattı: " << e.what());
+    } catch (...) {
+        failed = true;
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "TaskScheduler: " << task_class_to_string(state.cls) << " görevi bilinmeyen bir istisna fırlattı.");
+    }
+    metrics.run_time.record_duration(std::chrono::steady_clock::now() - start);
+    state.fn = nullptr; // Yakalanan kaynaklar tutamaçlar yaşadıkça tutulmasın
+
+    metrics.running.dec();
+    if (inline_run) {
+        counters.running.fetch_sub(1, std::memory_order_relaxed);
+        // Sınır bu çalıştırma yüzünden doluysa bekleyen görevleri işçiler yeniden tarasın.
+        if (counters.queued.load(std::memory_order_acquire) > 0) wake_one();
+    }
+    if (failed) {
+        counters.failed.fetch_add(1, std::memory_order_relaxed);
+        metrics.failed.inc();
+    } else {
+        counters.completed.fetch_add(1, std::memory_order_relaxed);
+        metrics.completed.inc();
+    }
+    state.complete(detail::TaskState::Finished);
+}
+
+void TaskScheduler::finish_cancelled(detail::TaskState& state) {
+    state.fn = nullptr;
+    ClassCounters& counters = counters_[index_of(state.cls)];
+    counters.queued.fetch_sub(1, std::memory_order_relaxed);
+    counters.cancelled.fetch_add(1, std::memory_order_relaxed);
+    class_metrics(state.cls).queue_depth.dec();
+    class_metrics(state.cls).cancelled.inc();
+    state.complete(detail::TaskState::Cancelled);
+}
+
+void TaskScheduler::wake_one() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        ++signal_;
+    }
+    sleep_cv_.notify_one();
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,159 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+namespace CerebrumLux {
+
+// Görev öncelik sınıfları; işçiler sınıfları bu sırayla tarar (küçük değer = yüksek öncelik).
+enum class TaskClass : std::uint8_t {
+    Interactive = 0,    // Kullanıcının beklediği kısa işler (niyet yönlendirme, arama dağıtımı)
+    Inference,          // Model çağrıları (LLM yanıtı, embedding); modeli paylaştıkları için düşük sınırla
+    BackgroundLearning, // Değerlendirme, öğrenme ve tanılama işleri
+    Persistence         // Disk ağırlıklı bakım (HNSW sıkıştırması vb.)
+};
+
+constexpr std::size_t kTaskClassCount = 4;
+
+const char* task_class_to_string(TaskClass cls);
+
+class TaskScheduler;
+
+namespace detail {
+struct TaskState;
+} // namespace detail
+
+// İşbirlikçi iptal: görev uzun döngülerinde cancelled()'ı kontrol edip erken döner. Görev iptal edildiğinde
+// (TaskHandle::cancel) veya zamanlayıcı kapatılırken true olur.
+class CancellationToken {
+public:
+    CancellationToken() = default;
+    bool cancelled() const;
+
+private:
+    friend class TaskScheduler;
+    explicit CancellationToken(const detail::TaskState* state) : state_(state) {}
+    const detail::TaskState* state_ = nullptr;
+};
+
+// Gönderilen göreve tutamaç. Boş tutamaç (varsayılan) tamamlanmış sayılır.
+class TaskHandle {
+public:
+    TaskHandle() = default;
+
+    // Görev henüz başlamadıysa hiç çalışmaz; çalışıyorsa belirteci iptal edilmiş görünür.
+    void cancel();
+    // Görev bitene kadar bekler. Görev hâlâ kuyruktaysa çağıran iş parçacığında hemen yürütülür; böylece sınıf
+    // sınırı dolu olsa veya bekleyen bir işçi olsa bile kilitlenme olmaz. Görev çalıştıysa true döner.
+    bool wait();
+    // Süre içinde biterse true döner (kuyruktaki görevi yürütmez).
+    bool wait_for(std::chrono::milliseconds timeout);
+    bool done() const;
+    bool valid() const { return state_ != nullptr; }
+
+private:
+    friend class TaskScheduler;
+    TaskHandle(std::shared_ptr<detail::TaskState> state, TaskScheduler* scheduler)
+        : state_(std::move(state)), scheduler_(scheduler) {}
+
+    std::shared_ptr<detail::TaskState> state_;
+    TaskScheduler* scheduler_ = nullptr;
+};
+
+// Öncelik sınıflı, iş çalan (work-stealing) ortak görev zamanlayıcısı.
+//
+// Her işçinin sınıf başına bir FIFO kuyruğu vardır. İşçi önce kendi kuyruğundan alır, boşsa diğer işçilerin aynı
+// sınıf kuyruğundan çalar. Sınıflar öncelik sırasıyla taranır; her sınıfın aynı anda çalışan görev sayısı bir
+// sınırla kısıtlanır (ör. modeli paylaşan Inference işleri tüm işçileri tutamaz). İşçi iş parçacıklarından
+// gönderilen görevler o işçinin kuyruğuna, diğerleri sırayla işçilere dağıtılır.
+//
+// Sınıf başına kuyruk derinliği, çalışan görev sayısı, kuyrukta bekleme ve çalışma süreleri Metrics'e yazılır
+// (cerebrumlux_scheduler_*{class="..."}).
+class TaskScheduler {
+public:
+    using Task = std::function<void(const CancellationToken&)>;
+
+    struct Options {
+        std::size_t workers = 0; // 0: donanım iş parçacığı sayısı (en az 2)
+        // Sınıf başına eşzamanlı görev sınırı; 0: varsayılan (bkz. default_max_concurrency)
+        std::array<std::size_t, kTaskClassCount> max_concurrency{};
+    };
+
+    struct ClassStats {
+        std::size_t queued = 0;
+        std::size_t running = 0;
+        std::uint64_t completed = 0;
+        std::uint64_t cancelled = 0; // Başlamadan iptal edilen
+        std::uint64_t failed = 0;    // İstisna fırlatan
+    };
+
+    TaskScheduler();
+    explicit TaskScheduler(const Options& options);
+    ~TaskScheduler();
+
+    // Süreç geneli zamanlayıcı (ilk kullanımda varsayılan seçeneklerle kurulur).
+    static TaskScheduler& instance();
+
+    TaskHandle submit(TaskClass cls, Task task);
+    TaskHandle submit(TaskClass cls, std::function<void()> task);
+
+    // fn(i)'yi her i < count için çağırır ve hepsi bitince döner. Çağıran iş parçacığı da işe katılır; en fazla
+    // max_participants iş parçacığı (0: işçi sayısı + 1) ortak sayaçtan indeks alır. Yardımcılar cls sınıfında
+    // kuyruğa girer; sınıf sınırı doluysa işi çağıran tamamlar.
+    void parallel_for(TaskClass cls, std::size_t count, const std::function<void(std::size_t)>& fn,
+                      std::size_t max_participants = 0);
+
+    void set_max_concurrency(TaskClass cls, std::size_t limit); // 0 değeri 1 olarak alınır
+    std::size_t max_concurrency(TaskClass cls) const;
+    std::size_t worker_count() const { return workers_.size(); }
+    ClassStats stats(TaskClass cls) const;
+
+    // Kuyruktaki görevleri iptal eder, çalışanların bitmesini bekler ve işçileri durdurur. Sonraki gönderimler
+    // iptal edilmiş tutamaç döndürür. Yıkıcı da çağırır.
+    void shutdown();
+
+    static std::size_t default_max_concurrency(TaskClass cls, std::size_t workers);
+
+private:
+    friend class TaskHandle;
+    struct Worker;
+    struct ClassCounters;
+
+    void worker_loop(std::size_t index);
+    std::shared_ptr<detail::TaskState> take(std::size_t index, TaskClass cls);
+    bool try_reserve(TaskClass cls);
+    void release(TaskClass cls);
+    void execute(detail::TaskState& state, bool inline_run);
+    void finish_cancelled(detail::TaskState& state);
+    void wake_one();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::unique_ptr<ClassCounters[]> counters_;
+    std::atomic<std::size_t> next_worker_{0};
+    std::atomic<bool> stopping_{false};
+
+    // Uyuyan işçiler: her gönderimde signal_ artar; tarama öncesi okunan değer değiştiyse işçi uyumaz.
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::uint64_t signal_ = 0;
+
+    std::mutex shutdown_mutex_;
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+};
+
+} // namespace CerebrumLux
+
+#endif // TASK_SCHEDULER_H
@@ -0,0 +1,193 @@
+#include "time_series.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CerebrumLux {
+
+std::size_t TimeSeriesStore::level_span(std::size_t level) {
+    std::size_t span = kBucketFanout;
+    for (std::size_t i = 0; i < level; ++i) span *= kBucketFanout;
+    return span;
+}
+
+bool TimeSeriesStore::append(double x, double y) {
+    if (!xs_.empty() && x < xs_.back()) return false;
+    const std::size_t index = xs_.size();
+    xs_.push_back(x);
+    ys_.push_back(y);
+
+    if (levels_.empty()) levels_.resize(kMaxLevels);
+    for (std::size_t level = 0; level < kMaxLevels; ++level) {
+        const std::size_t span = level_span(level);
+        std::vector<Bucket>& buckets = levels_[level];
+        if (index / span == buckets.size()) {
+            // Yeni kova açılır; önceki kovalar artık değişmez.
+            Bucket bucket;
+            bucket.y_min = bucket.y_max = y;
+            bucket.x_at_min = bucket.x_at_max = x;
+            buckets.push_back(bucket);
+        }
+        Bucket& bucket = buckets.back();
+        ++bucket.count;
+        if (y < bucket.y_min) { bucket.y_min = y; bucket.x_at_min = x; }
+        if (y > bucket.y_max) { bucket.y_max = y; bucket.x_at_max = x; }
+    }
+    return true;
+}
+
+void TimeSeriesStore::clear() {
+    xs_.clear();
+    ys_.clear();
+    levels_.clear();
+}
+
+std::size_t TimeSeriesStore::lower_index(double x) const {
+    return static_cast<std::size_t>(std::lower_bound(xs_.begin(), xs_.end(), x) - xs_.begin());
+}
+
+std::size_t TimeSeriesStore::upper_index(double x) const {
+    return static_cast<std::size_t>(std::upper_bound(xs_.begin(), xs_.end(), x) - xs_.begin());
+}
+
+std::vector<SeriesPoint> TimeSeriesStore::view_all(std::size_t max_points) const {
+    if (xs_.empty()) return {};
+    return view(xs_.front(), xs_.back(), max_points);
+}
+
+std::vector<SeriesPoint> TimeSeriesStore::view(double x_min, double x_max, std::size_t max_points) const {
+    std::vector<SeriesPoint> out;
+    const std::size_t lo = lower_index(x_min);
+    const std::size_t hi = upper_index(x_max);
+    if (lo >= hi) return out;
+
+    const std::size_t budget = std::max<std::size_t>(3, max_points);
+    const std::size_t n = hi - lo;
+
+    if (n <= 4 * budget) {
+        // Az sayıda nokta: ham veri üzerinde doğrudan LTTB.
+        out.reserve(n);
+        for (std::size_t i = lo; i < hi; ++i) out.push_back({xs_[i], ys_[i]});
+        return lttb(out, budget);
+    }
+
+    // Kova sayısı ~4*bütçeyi aşmayan en ince seviye. Her kova en fazla iki nokta üretir; zarf LTTB ile bütçeye iner.
+    std::size_t level = 0;
+    while (level + 1 < levels_.size() && n / level_span(level) + 2 > 4 * budget) ++level;
+    const std::size_t span = level_span(level);
+    const std::vector<Bucket>& buckets = levels_[level];
+
+    // Zarf, aralığın ilk ve son ham noktası arasına yerleştirilir; LTTB uçları koruduğu için çizgi aralığın tam
+    // başından başlayıp son değerde biter. Kenar kovalarının aralık dışına düşen min/max noktaları atlanır.
+    const std::size_t first_bucket = lo / span;
+    const std::size_t last_bucket = (hi - 1) / span;
+    const SeriesPoint first{xs_[lo], ys_[lo]};
+    const SeriesPoint last{xs_[hi - 1], ys_[hi - 1]};
+    auto push_inside = [&](double x, double y) {
+        if (x > first.x && x < last.x) out.push_back({x, y});
+    };
+    out.reserve(2 * (last_bucket - first_bucket + 1) + 2);
+    out.push_back(first);
+    for (std::size_t b = first_bucket; b <= last_bucket; ++b) {
+        const Bucket& bucket = buckets[b];
+        if (bucket.x_at_min == bucket.x_at_max && bucket.y_min == bucket.y_max) {
+            push_inside(bucket.x_at_min, bucket.y_min);
+        } else if (bucket.x_at_min <= bucket.x_at_max) {
+            push_inside(bucket.x_at_min, bucket.y_min);
+            push_inside(bucket.x_at_max, bucket.y_max);
+        } else {
+            push_inside(bucket.x_at_max, bucket.y_max);
+            push_inside(bucket.x_at_min, bucket.y_min);
+        }
+    }
+    out.push_back(last);
+    return lttb(out, budget);
+}
+
+bool TimeSeriesStore::y_range(double x_min, double x_max, double& y_min, double& y_max) const {
+    const std::size_t lo = lower_index(x_min);
+    const std::size_t hi = upper_index(x_max);
+    if (lo >= hi) return false;
+
+    y_min = ys_[lo];
+    y_max = ys_[lo];
+    std::size_t i = lo;
+    while (i < hi) {
+        // Kovaya hizalı ve tamamı aralıkta kalan en büyük kovayı kullan; yoksa tek ham nokta.
+        std::size_t level = levels_.size();
+        while (level > 0) {
+            const std::size_t span = level_span(level - 1);
+            if (i % span == 0 && i + span <= hi) break;
+            --level;
+        }
+        if (level == 0) {
+            y_min = std::min(y_min, ys_[i]);
+            y_max = std::max(y_max, ys_[i]);
+            ++i;
+        } else {
+            const std::size_t span = level_span(level - 1);
+            const Bucket& bucket = levels_[level - 1][i / span];
+            y_min = std::min(y_min, bucket.y_min);
+            y_max = std::max(y_max, bucket.y_max);
+            i += span;
+        }
+    }
+    return true;
+}
+
+std::vector<SeriesPoint> TimeSeriesStore::lttb(const std::vector<SeriesPoint>& points, std::size_t threshold) {
+    threshold = std::max<std::size_t>(3, threshold);
+    const std::size_t n = points.size();
+    if (n <= threshold) return points;
+
+    std::vector<SeriesPoint> sampled;
+    sampled.reserve(threshold);
+    sampled.push_back(points.front());
+
+    // İlk ve son nokta hariç noktalar threshold-2 kovaya bölünür; her kovadan, önceki seçilen nokta ve
+    // sonraki kovanın ortalamasıyla en büyük üçgeni oluşturan nokta seçilir. Kova sınırları tamsayı bölmesiyle
+    // hesaplanır: k. sınır 1 + k * (n - 2) / (threshold - 2); son kova tam olarak n - 1'de biter, son kovanın
+    // "sonraki kovası" son noktadır.
+    const std::size_t buckets = threshold - 2;
+    auto edge = [n, buckets](std::size_t k) { return std::min(n, 1 + k * (n - 2) / buckets); };
+    std::size_t a = 0;
+    for (std::size_t i = 0; i < buckets; ++i) {
+        const std::size_t range_start = edge(i);
+        const std::size_t range_end = edge(i + 1);
+
+        const std::size_t avg_start = range_end;
+        const std::size_t avg_end = edge(i + 2);
+        double avg_x = 0.0;
+        double avg_y = 0.0;
+        if (avg_end > avg_start) {
+            for (std::size_t j = avg_start; j < avg_end; ++j) {
+                avg_x += points[j].x;
+                avg_y += points[j].y;
+            }
+            avg_x /= static_cast<double>(avg_end - avg_start);
+            avg_y /= static_cast<double>(avg_end - avg_start);
+        } else {
+            avg_x = points.back().x;
+            avg_y = points.back().y;
+        }
+
+        const SeriesPoint& pa = points[a];
+        double max_area = -1.0;
+        std::size_t next_a = range_start;
+        for (std::size_t j = range_start; j < range_end; ++j) {
+            const double area = std::fabs((pa.x - avg_x) * (points[j].y - pa.y) -
+                                          (pa.x - points[j].x) * (avg_y - pa.y));
+            if (area > max_area) {
+                max_area = area;
+                next_a = j;
+            }
+        }
+        sampled.push_back(points[next_a]);
+        a = next_a;
+    }
+
+    sampled.push_back(points.back());
+    return sampled;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,69 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <cstddef>
+#include <vector>
+
+namespace CerebrumLux {
+
+struct SeriesPoint {
+    double x;
+    double y;
+};
+
+// Grafikler için yalnızca ekleme yapılan (append-only) zaman serisi deposu.
+//
+// Ham noktalar x'e göre artan sırada saklanır. Bunun üzerine min/max özet seviyeleri (piramit) tutulur:
+// seviye k'deki her kova ham verinin kBucketFanout^k noktasını özetler ve kovadaki en küçük / en büyük
+// noktayı saklar. Her append yalnızca seviyelerin son (açık) kovasını günceller.
+//
+// view() bir x aralığını piksel bütçesine indirger: aralıktaki nokta sayısı bütçenin birkaç katından azsa ham
+// noktalar, değilse kova sayısı bütçeye yakın olan en ince seviyenin min/max zarfı alınır ve sonuç LTTB
+// (Largest-Triangle-Three-Buckets) ile bütçeye düşürülür. Böylece çizim maliyeti oturum uzunluğundan
+// bağımsızdır (aralık araması O(log n), geri kalanı O(bütçe)). Tepe noktaları zarf sayesinde kaybolmaz.
+class TimeSeriesStore {
+public:
+    static constexpr std::size_t kBucketFanout = 8;
+    static constexpr std::size_t kMaxLevels = 8;
+
+    // x son noktadan küçükse false döner ve nokta eklenmez.
+    bool append(double x, double y);
+    void clear();
+
+    std::size_t size() const { return xs_.size(); }
+    bool empty() const { return xs_.empty(); }
+    double first_x() const { return xs_.front(); }
+    double last_x() const { return xs_.back(); }
+
+    // [x_min, x_max] aralığının en fazla max_points noktalık temsili (max_points < 3 ise 3 kabul edilir). Aralıktaki
+    // ilk ve son ham nokta her zaman korunur; dönen noktalar aralığın dışına taşmaz.
+    std::vector<SeriesPoint> view(double x_min, double x_max, std::size_t max_points) const;
+    std::vector<SeriesPoint> view_all(std::size_t max_points) const;
+
+    // Aralıktaki y değerlerinin min/max'ı (özet seviyelerinden). Aralık boşsa false döner.
+    bool y_range(double x_min, double x_max, double& y_min, double& y_max) const;
+
+    // Sıralı noktaları LTTB ile en fazla threshold noktaya indirir; ilk ve son nokta korunur.
+    static std::vector<SeriesPoint> lttb(const std::vector<SeriesPoint>& points, std::size_t threshold);
+
+private:
+    struct Bucket {
+        std::size_t count = 0;   // Kapsadığı ham nokta sayısı
+        double y_min = 0.0;
+        double x_at_min = 0.0;
+        double y_max = 0.0;
+        double x_at_max = 0.0;
+    };
+
+    static std::size_t level_span(std::size_t level); // Seviyedeki bir kovanın kapsadığı ham nokta sayısı
+    std::size_t lower_index(double x) const;           // x'e eşit veya büyük ilk ham nokta
+    std::size_t upper_index(double x) const;           // x'ten büyük ilk ham nokta
+
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<std::vector<Bucket>> levels_; // levels_[0] -> kBucketFanout noktalık kovalar
+};
+
+} // namespace CerebrumLux
+
+#endif // TIME_SERIES_H
@@ -7,6 +7,7 @@
 #include <deque> // sinyal buffer için
 #include "../sensors/atomic_signal.h" // CerebrumLux::AtomicSignal için
 #include "../brain/autoencoder.h" // CerebrumLux::CryptofigAutoencoder için
+#include "signal_statistics.h" // CerebrumLux::SignalFeatureStatistics için
 #include <iostream> // std::cout, std::endl için (gerekirse)
 
 namespace CerebrumLux { // DynamicSequence struct'ı bu namespace içine alınacak
@@ -48,6 +49,11 @@ struct DynamicSequence {
      * @brief Sinyal arabelleğinden gelen verilere dayanarak mevcut dinamik sekansın durumunu günceller.
      */
     void update_from_signals(const std::deque<CerebrumLux::AtomicSignal>& signal_buffer, long long current_time_us, unsigned short app_hash, CerebrumLux::CryptofigAutoencoder& cryptofig_autoencoder_ref);
+
+    /**
+     * @brief Artımlı tutulan pencere istatistiklerinden sekansı günceller. Sinyal tamponunu yeniden taramaz, O(INPUT_DIM).
+     */
+    void update_from_statistics(const CerebrumLux::SignalFeatureStatistics& stats, const CerebrumLux::SignalStringInterner& interner, long long current_time_us, unsigned short app_hash, CerebrumLux::CryptofigAutoencoder& cryptofig_autoencoder_ref);
 };
 
 } // namespace CerebrumLux
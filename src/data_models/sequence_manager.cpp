@@ -9,32 +9,61 @@
 
 namespace CerebrumLux {
 
-SequenceManager::SequenceManager() : max_buffer_size(100), last_sequence_update_time_us(0) {
+SequenceManager::SequenceManager() : signal_payloads(SIGNAL_RING_CAPACITY), signal_ring(SIGNAL_RING_CAPACITY) {
     LOG_DEFAULT(LogLevel::INFO, "SequenceManager: Initialized.");
 }
 
 bool SequenceManager::add_signal(const AtomicSignal& signal, CryptofigProcessor& cryptofig_processor) {
-    std::lock_guard<std::mutex> lock(buffer_mutex);
-    LOG_DEFAULT(LogLevel::DEBUG, "SequenceManager::add_signal: Yeni sinyal eklendi. Type: " << sensor_type_to_string(signal.type) << ", Value: " << signal.value.substr(0, std::min((size_t)30, signal.value.length()))); 
+    LOG_DEFAULT(LogLevel::TRACE, "SequenceManager::add_signal: Yeni sinyal eklendi. Type: " << sensor_type_to_string(signal.type)); 
+
+    // Tür/protokol stringleri intern edilir, sayısal yükler burada bir kez parse edilir; serbest metin yan tampona yazılır.
+    SignalRecord record = make_signal_record(signal, string_interner);
+    record.sequence_no = next_sequence_no.fetch_add(1, std::memory_order_relaxed);
+    signal_payloads.store(record.sequence_no, signal);
+    const long long previous_timestamp_us = last_signal_timestamp_us.exchange(signal.timestamp_us, std::memory_order_relaxed);
+    record.interval_us = (previous_timestamp_us > 0 && signal.timestamp_us > previous_timestamp_us) ? signal.timestamp_us - previous_timestamp_us : 0;
+
+    // Kilitsiz ekleme; pencere doluysa en eski kayıt düşer ve istatistiklerden geri alınır.
+    signal_ring.push_overwrite(record, [this](const SignalRecord& old) {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        feature_stats.remove(old);
+    });
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        feature_stats.add(record, signal_app_context(signal));
+    }
 
-    signal_buffer.push_back(signal);
-    if (signal_buffer.size() > max_buffer_size) {
-        signal_buffer.pop_front(); // En eski sinyali kaldır
-        LOG_DEFAULT(LogLevel::TRACE, "SequenceManager::add_signal: Sinyal buffer boyutu aşıldı, en eski sinyal silindi.");
+    // Sekans güncellemesi (autoencoder adımı dahil) kısıtlanır; yüksek sinyal hızlarında her push'ta çalışmaz.
+    const long long now_us = get_current_timestamp_us();
+    const long long last_update_us = last_sequence_update_time_us.load(std::memory_order_relaxed);
+    if (now_us - last_update_us >= sequence_update_interval_us.load(std::memory_order_relaxed)) {
+        update_current_sequence(cryptofig_processor);
+    } else {
+        // Patlamanın son sinyali atlanmasın: flush_pending_sequence_update aralık dolunca bir kez daha günceller.
+        sequence_update_pending.store(true, std::memory_order_release);
     }
+    
+    return true;
+}
 
-    // Her sinyal eklendiğinde mevcut sekansı güncelle
+bool SequenceManager::flush_pending_sequence_update(CryptofigProcessor& cryptofig_processor) {
+    if (!sequence_update_pending.load(std::memory_order_acquire)) return false;
+    const long long now_us = get_current_timestamp_us();
+    if (now_us - last_sequence_update_time_us.load(std::memory_order_relaxed) < sequence_update_interval_us.load(std::memory_order_relaxed)) {
+        return false;
+    }
     update_current_sequence(cryptofig_processor);
-    
     return true;
 }
 
 void SequenceManager::process_oldest_signal(CryptofigProcessor& cryptofig_processor) {
-    std::lock_guard<std::mutex> lock(buffer_mutex);
-    if (!signal_buffer.empty()) {
-        AtomicSignal oldest_signal = signal_buffer.front();
-        signal_buffer.pop_front();
-        LOG_DEFAULT(LogLevel::DEBUG, "SequenceManager::process_oldest_signal: Eski sinyal işlendi ve kaldırıldı. ID: " << oldest_signal.id);
+    SignalRecord oldest_signal;
+    if (signal_ring.try_pop(oldest_signal)) {
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            feature_stats.remove(oldest_signal);
+        }
+        LOG_DEFAULT(LogLevel::DEBUG, "SequenceManager::process_oldest_signal: Eski sinyal işlendi ve kaldırıldı. Sıra No: " << oldest_signal.sequence_no);
         // Burada eski sinyalin işlenmesi (örn. arşivlenmesi) yapılabilir.
     } else {
         LOG_DEFAULT(LogLevel::WARNING, "SequenceManager::process_oldest_signal: Sinyal buffer boş.");
@@ -50,14 +79,26 @@ const DynamicSequence& SequenceManager::get_current_sequence_ref() const {
 }
 
 std::deque<AtomicSignal> SequenceManager::get_signal_buffer_copy() {
-    std::lock_guard<std::mutex> lock(buffer_mutex);
-    return signal_buffer;
+    std::deque<AtomicSignal> buffer_copy; // "signals" adı Qt anahtar sözcüğü makrosuyla çakışır
+    for (const auto& record : signal_ring.snapshot()) {
+        buffer_copy.push_back(to_atomic_signal(record, string_interner, signal_payloads));
+    }
+    return buffer_copy;
+}
+
+std::vector<SignalRecord> SequenceManager::get_signal_records_snapshot() const {
+    return signal_ring.snapshot();
+}
+
+SignalFeatureStatistics SequenceManager::get_feature_statistics() const {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return feature_stats;
 }
 
 // YENİ EKLENDİ: Kullanıcı girdisini geçmişe ekle
 void SequenceManager::add_user_input(const std::string& input) {
-    // buffer_mutex ile korumaya alalım, çünkü current_sequence'i değiştiriyoruz.
-    std::lock_guard<std::mutex> lock(buffer_mutex);
+    // sequence_mutex ile korumaya alalım, çünkü current_sequence'i değiştiriyoruz.
+    std::lock_guard<std::mutex> lock(sequence_mutex);
     
     current_sequence.user_input_history.push_back(input);
     if (current_sequence.user_input_history.size() > MAX_HISTORY_SIZE) {
@@ -67,40 +108,29 @@ void SequenceManager::add_user_input(const std::string& input) {
 }
 
 void SequenceManager::update_current_sequence(CryptofigProcessor& cryptofig_processor) {
-    // Not: Bu metod zaten buffer_mutex kilitliyken çağrılıyor (add_signal içinden).
-    // O yüzden burada tekrar kilit almaya gerek yok.
-    
-    long long current_time_us = get_current_timestamp_us();
-
-    current_sequence.id = "seq_" + std::to_string(current_time_us);
-    current_sequence.timestamp_utc = std::chrono::system_clock::now();
-    current_sequence.event_count = signal_buffer.size();
-    current_sequence.current_application_context = "UnknownApp"; // Placeholder
-    current_sequence.current_cpu_usage = 0; // Placeholder
-    current_sequence.current_ram_usage = 0; // Placeholder
-    
-    // Basit bir sinyal analizi ve istatistiksel özellik çıkarma
-    current_sequence.statistical_features_vector.clear();
-    // Örnek: Rastgele veya dummy verilerle dolduralım şimdilik
-    for (int i = 0; i < CryptofigAutoencoder::INPUT_DIM; ++i) {
-        current_sequence.statistical_features_vector.push_back(SafeRNG::getInstance().get_float(0.0f, 1.0f));
+    // Başka bir üretici zaten güncelliyorsa beklemeyiz; onun istatistik kopyası bu sinyali içermeyebileceği için
+    // güncelleme bekleyen olarak işaretlenir ve flush_pending_sequence_update'e kalır.
+    std::unique_lock<std::mutex> sequence_lock(sequence_mutex, std::try_to_lock);
+    if (!sequence_lock.owns_lock()) {
+        sequence_update_pending.store(true, std::memory_order_release);
+        return;
     }
-    LOG_DEFAULT(LogLevel::TRACE, "SequenceManager::update_current_sequence: statistical_features_vector boyutu: " << current_sequence.statistical_features_vector.size());
 
-
-    // Network aktivitesi gibi alanları en son sinyalden güncelle
-    if (!signal_buffer.empty()) {
-        const AtomicSignal& last_signal = signal_buffer.back();
-        current_sequence.current_network_active = last_signal.current_network_active;
-        current_sequence.network_activity_level = last_signal.network_activity_level;
-        current_sequence.network_protocol = last_signal.network_protocol;
-    } else {
-        // Buffer boşsa varsayılan değerler
-        current_sequence.current_network_active = false;
-        current_sequence.network_activity_level = 0;
-        current_sequence.network_protocol = "";
+    long long current_time_us = get_current_timestamp_us();
+    last_sequence_update_time_us.store(current_time_us, std::memory_order_relaxed);
+    // İstatistikler kopyalanmadan önce temizlenir: kopyadan sonra gelen sinyaller bayrağı yeniden kurar.
+    sequence_update_pending.store(false, std::memory_order_relaxed);
+
+    SignalFeatureStatistics stats_copy;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats_copy = feature_stats;
     }
 
+    // Pencere istatistikleri artımlı tutulduğu için burada tampon yeniden taranmaz.
+    current_sequence.update_from_statistics(stats_copy, string_interner, current_time_us, 0, cryptofig_processor.get_autoencoder());
+    LOG_DEFAULT(LogLevel::TRACE, "SequenceManager::update_current_sequence: statistical_features_vector boyutu: " << current_sequence.statistical_features_vector.size());
+
     // CryptofigProcessor'ı çağırarak latent kriptofigi güncelle
     try {
         cryptofig_processor.process_sequence(current_sequence, 0.01f); // 0.01f dummy learning rate
@@ -114,7 +144,6 @@ void SequenceManager::update_current_sequence(CryptofigProcessor& cryptofig_proc
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SequenceManager::update_current_sequence: CryptofigProcessor işlemi sırasında bilinmeyen hata.");
     }
 
-    last_sequence_update_time_us = current_time_us;
     LOG_DEFAULT(LogLevel::TRACE, "SequenceManager::update_current_sequence: DynamicSequence güncellendi. ID: " << current_sequence.id);
 }
 
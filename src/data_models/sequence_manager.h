@@ -5,10 +5,14 @@
 #include <vector>
 #include <deque>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <chrono> // Time functions
 #include "../sensors/atomic_signal.h" // CerebrumLux::AtomicSignal için
 #include "../brain/cryptofig_processor.h" // CerebrumLux::CryptofigProcessor için
 #include "../data_models/dynamic_sequence.h" // CerebrumLux::DynamicSequence için
+#include "../data_models/signal_ring_buffer.h" // SignalRingBuffer, SignalRecord için
+#include "../data_models/signal_statistics.h" // SignalFeatureStatistics için
 #include "../core/enums.h" // UserIntent için eklendi
 
 namespace CerebrumLux { // SequenceManager sınıfı bu namespace içine alınacak
@@ -20,20 +24,42 @@ public:
     bool add_signal(const CerebrumLux::AtomicSignal& signal, CerebrumLux::CryptofigProcessor& cryptofig_processor);
     void process_oldest_signal(CerebrumLux::CryptofigProcessor& cryptofig_processor);
     const DynamicSequence& get_current_sequence_ref() const;
+    // Geriye dönük uyumluluk: halka tampondaki kayıtları AtomicSignal'e geri çevirir (pahalı).
     std::deque<CerebrumLux::AtomicSignal> get_signal_buffer_copy();
+    // Halka tamponun POD kopyası (eskiden yeniye). Üreticileri bloklamaz.
+    std::vector<CerebrumLux::SignalRecord> get_signal_records_snapshot() const;
+    SignalFeatureStatistics get_feature_statistics() const;
+    const SignalStringInterner& get_string_interner() const { return string_interner; }
+    // Snapshot kayıtlarının serbest metin yükleri; halka sardıkça üzerine yazılır.
+    const SignalPayloadStore& get_payload_store() const { return signal_payloads; }
+
+    // Sekans/autoencoder güncellemesi en fazla bu aralıkta bir yapılır; istatistikler her sinyalde güncellenir.
+    void set_sequence_update_interval_us(long long interval_us) { sequence_update_interval_us.store(interval_us, std::memory_order_relaxed); }
+    // Kısıtlama veya kilit çakışması yüzünden sekansa yansımamış bir sinyal varsa ve aralık dolduysa sekansı günceller
+    // (ani bir sinyal patlamasının son güncellemesi). Periyodik olarak çağrılmalıdır; bekleyen yoksa yalnızca atomik okumadır.
+    bool flush_pending_sequence_update(CerebrumLux::CryptofigProcessor& cryptofig_processor);
     
     // YENİ EKLENDİ: Kullanıcı girdisini geçmişe ekler
     void add_user_input(const std::string& input);
 
 private:
-    std::deque<CerebrumLux::AtomicSignal> signal_buffer;
-    mutable std::mutex buffer_mutex; // mutable eklendi çünkü get_current_sequence_ref const, ama mutex'i kilitlemesi gerekiyor.
-                                     // VEYA get_current_sequence_ref'de mutex kullanmıyorsak gerek yok.
-                                     // Kodunuza baktım, get_current_sequence_ref mutex kullanmıyor, o yüzden mutable şart değil ama iyi pratik.
-                                     // Ancak mevcut kodunuzda 'buffer_mutex' var, onu kullanacağız.
+    static constexpr size_t SIGNAL_RING_CAPACITY = 128; // İkinin kuvveti; eski 100'lük deque penceresinin yerini alır
+
+    SignalStringInterner string_interner;
+    SignalPayloadStore signal_payloads; // Sinyal başına serbest metin; interner'ı yüksek kardinaliteli yüklerle doldurmaz
+    SignalRingBuffer signal_ring; // Kilitsiz sinyal penceresi; add_signal üreticileri mutex beklemez
+
+    mutable std::mutex stats_mutex; // Yalnızca O(1) Welford güncellemelerini korur
+    SignalFeatureStatistics feature_stats;
+
+    mutable std::mutex sequence_mutex; // current_sequence ve autoencoder adımını korur
     DynamicSequence current_sequence; // Dinamik sekans
-    size_t max_buffer_size; // Sinyal buffer'ının maksimum boyutu
-    long long last_sequence_update_time_us; // Son sekans güncelleme zamanı
+
+    std::atomic<std::uint64_t> next_sequence_no{0};
+    std::atomic<long long> last_signal_timestamp_us{0};
+    std::atomic<long long> last_sequence_update_time_us{0}; // Son sekans güncelleme zamanı
+    std::atomic<long long> sequence_update_interval_us{20000}; // 20 ms: 2 Hz'de her sinyal yine sekansı günceller
+    std::atomic<bool> sequence_update_pending{false}; // Son güncellemeden sonra gelen, sekansa yansımamış sinyal var
     
     const size_t MAX_HISTORY_SIZE = 20; // Chat geçmişi sınırı
 
@@ -0,0 +1,204 @@
+#include "signal_ring_buffer.h"
+#include <algorithm> // std::max için
+#include <mutex>     // std::unique_lock için
+
+namespace CerebrumLux {
+
+namespace {
+
+// "CPU: 45%" gibi bir yükte anahtardan sonraki ilk sayıyı parse eder (std::stoul/substr kopyası olmadan).
+float parse_number_after(std::string_view text, std::string_view key) {
+    const std::size_t pos = text.find(key);
+    if (pos == std::string_view::npos) return -1.0f;
+
+    std::size_t i = pos + key.size();
+    while (i < text.size() && text[i] == ' ') ++i;
+
+    bool has_digit = false;
+    float value = 0.0f;
+    float fraction_scale = 0.0f;
+    for (; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c >= '0' && c <= '9') {
+            has_digit = true;
+            if (fraction_scale > 0.0f) {
+                value += static_cast<float>(c - '0') * fraction_scale;
+                fraction_scale *= 0.1f;
+            } else {
+                value = value * 10.0f + static_cast<float>(c - '0');
+            }
+        } else if (c == '.' && fraction_scale == 0.0f) {
+            fraction_scale = 0.1f;
+        } else {
+            break;
+        }
+    }
+    return has_digit ? value : -1.0f;
+}
+
+std::string_view text_after(std::string_view text, std::string_view key) {
+    const std::size_t pos = text.find(key);
+    if (pos == std::string_view::npos) return {};
+    std::string_view rest = text.substr(pos + key.size());
+    while (!rest.empty() && rest.front() == ' ') rest.remove_prefix(1);
+    return rest;
+}
+
+// Metni en fazla max_bytes bayta kırpar; çok baytlı bir UTF-8 karakteri ortadan bölünmez.
+std::string_view clamp_utf8(std::string_view text, std::size_t max_bytes) {
+    if (text.size() <= max_bytes) return text;
+    std::size_t end = max_bytes;
+    while (end > 0 && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) --end;
+    return text.substr(0, end);
+}
+
+std::size_t round_up_pow2(std::size_t v) {
+    std::size_t p = 2;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+// === SignalStringInterner ===
+
+SignalStringInterner::SignalStringInterner(std::size_t max_entries)
+    : max_entries_(std::max<std::size_t>(1, max_entries))
+{
+    strings_.emplace_back(); // ID 0 = NO_STRING
+}
+
+std::uint32_t SignalStringInterner::intern(std::string_view str) {
+    if (str.empty()) return SignalRecord::NO_STRING;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(str);
+        if (it != ids_.end()) return it->second;
+        if (strings_.size() > max_entries_) return SignalRecord::NO_STRING;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(str); // Kilit yükseltilirken başka bir thread eklemiş olabilir
+    if (it != ids_.end()) return it->second;
+    if (strings_.size() > max_entries_) return SignalRecord::NO_STRING;
+
+    const std::uint32_t id = static_cast<std::uint32_t>(strings_.size());
+    strings_.emplace_back(str);
+    ids_.emplace(std::string_view(strings_.back()), id);
+    return id;
+}
+
+const std::string& SignalStringInterner::resolve(std::uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= strings_.size()) return strings_.front();
+    return strings_[id];
+}
+
+std::size_t SignalStringInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.size() - 1;
+}
+
+// === SignalPayloadStore ===
+
+SignalPayloadStore::SignalPayloadStore(std::size_t ring_capacity)
+    : slots_(new Slot[round_up_pow2(ring_capacity * 2)]), mask_(round_up_pow2(ring_capacity * 2) - 1)
+{
+}
+
+void SignalPayloadStore::store(std::uint64_t sequence_no, const AtomicSignal& signal) {
+    Slot& slot = slots_[sequence_no & mask_];
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    // assign mevcut kapasiteyi yeniden kullanır; slot bir kez ısındıktan sonra bellek ayrılmaz.
+    slot.sequence_no = sequence_no;
+    slot.value.assign(clamp_utf8(signal.value, kMaxFieldBytes));
+    slot.system_event_data.assign(clamp_utf8(signal.system_event_data, kMaxFieldBytes));
+    slot.ai_internal_event_data.assign(clamp_utf8(signal.ai_internal_event_data, kMaxFieldBytes));
+}
+
+bool SignalPayloadStore::load(std::uint64_t sequence_no, AtomicSignal& signal) const {
+    const Slot& slot = slots_[sequence_no & mask_];
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    if (slot.sequence_no != sequence_no) return false;
+    signal.value = slot.value;
+    signal.system_event_data = slot.system_event_data;
+    signal.ai_internal_event_data = slot.ai_internal_event_data;
+    return true;
+}
+
+// === Dönüşümler ===
+
+std::string_view signal_app_context(const AtomicSignal& signal) {
+    if (signal.type != SensorType::SystemEvent) return {};
+    for (std::string_view text : {std::string_view(signal.value), std::string_view(signal.system_event_data)}) {
+        std::string_view app = text_after(text, "APP:");
+        if (app.empty()) app = text_after(text, "Active App:");
+        if (!app.empty()) return clamp_utf8(app, SignalPayloadStore::kMaxFieldBytes);
+    }
+    return {};
+}
+
+SignalRecord make_signal_record(const AtomicSignal& signal, SignalStringInterner& interner) {
+    SignalRecord record{};
+    record.timestamp_us = signal.timestamp_us;
+    record.type = signal.type;
+    record.key_type = signal.key_type;
+    record.event_type = signal.event_type;
+    record.mouse_button_state = signal.mouse_button_state;
+    record.mouse_x = signal.mouse_x;
+    record.mouse_y = signal.mouse_y;
+    record.mouse_delta_x = signal.mouse_delta_x;
+    record.mouse_delta_y = signal.mouse_delta_y;
+    record.confidence = signal.confidence;
+    record.current_network_active = signal.current_network_active;
+    record.network_activity_level = signal.network_activity_level;
+    record.cpu_usage = -1.0f;
+    record.ram_usage = -1.0f;
+
+    // Yalnızca düşük kardinaliteli alanlar intern edilir; serbest metin SignalPayloadStore'a gider.
+    record.network_protocol_id = interner.intern(signal.network_protocol);
+    record.system_event_type_id = interner.intern(signal.system_event_type);
+    record.ai_internal_event_type_id = interner.intern(signal.ai_internal_event_type);
+
+    if (signal.type == SensorType::SystemEvent) {
+        // Yük hem value hem system_event_data içinde gelebilir; ikisine de bir kez bakılır.
+        for (std::string_view text : {std::string_view(signal.value), std::string_view(signal.system_event_data)}) {
+            if (record.cpu_usage < 0.0f) record.cpu_usage = parse_number_after(text, "CPU:");
+            if (record.ram_usage < 0.0f) record.ram_usage = parse_number_after(text, "RAM:");
+        }
+    }
+    return record;
+}
+
+AtomicSignal to_atomic_signal(const SignalRecord& record, const SignalStringInterner& interner, const SignalPayloadStore& payloads) {
+    AtomicSignal signal;
+    signal.id = "sig_" + std::to_string(record.sequence_no);
+    signal.type = record.type;
+    payloads.load(record.sequence_no, signal);
+    signal.timestamp_us = record.timestamp_us;
+    signal.key_type = record.key_type;
+    signal.event_type = record.event_type;
+    signal.mouse_x = record.mouse_x;
+    signal.mouse_y = record.mouse_y;
+    signal.mouse_delta_x = record.mouse_delta_x;
+    signal.mouse_delta_y = record.mouse_delta_y;
+    signal.mouse_button_state = record.mouse_button_state;
+    signal.ai_internal_event_type = interner.resolve(record.ai_internal_event_type_id);
+    signal.confidence = record.confidence;
+    signal.current_network_active = record.current_network_active;
+    signal.network_activity_level = record.network_activity_level;
+    signal.network_protocol = interner.resolve(record.network_protocol_id);
+    signal.system_event_type = interner.resolve(record.system_event_type_id);
+    return signal;
+}
+
+// === SignalRingBuffer ===
+
+std::vector<SignalRecord> SignalRingBuffer::snapshot() const {
+    std::vector<SignalRecord> out;
+    out.reserve(queue_.size_approx());
+    queue_.peek([](const AtomicSignalRecord& cell) { return cell.load(); },
+                [&out](SignalRecord&& record) { out.push_back(record); });
+    return out;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,200 @@
+#ifndef SIGNAL_RING_BUFFER_H
+#define SIGNAL_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../sensors/atomic_signal.h" // CerebrumLux::AtomicSignal için
+#include "../core/enums.h" // SensorType, KeyType vb. için
+#include "../core/mpmc_queue.h" // BoundedMpmcQueue için
+
+namespace CerebrumLux {
+
+// AtomicSignal'in kompakt, kopyalanması ucuz (POD) karşılığı.
+// Düşük kardinaliteli string alanları (olay türleri, protokol) SignalStringInterner üzerinden 32-bit ID'lere çevrilir;
+// serbest metin yükleri SignalPayloadStore'da sequence_no ile tutulur. "CPU:"/"RAM:" gibi sayısal yükler sinyal
+// alınırken bir kez parse edilir.
+struct SignalRecord {
+    static constexpr std::uint32_t NO_STRING = 0; // Boş veya intern edilemeyen string
+
+    std::uint64_t sequence_no;   // SequenceManager tarafından verilen monoton sıra numarası
+    long long timestamp_us;
+    long long interval_us;       // Bir önceki sinyalden bu yana geçen süre (ilk sinyal için 0)
+
+    SensorType type;
+    KeyType key_type;
+    KeyEventType event_type;
+    MouseButtonState mouse_button_state;
+
+    int mouse_x;
+    int mouse_y;
+    int mouse_delta_x;
+    int mouse_delta_y;
+
+    float confidence;
+    bool current_network_active;
+    int network_activity_level;
+
+    float cpu_usage;  // Sistem olayından parse edilen CPU kullanımı, yoksa -1
+    float ram_usage;  // Sistem olayından parse edilen RAM kullanımı, yoksa -1
+
+    std::uint32_t network_protocol_id;
+    std::uint32_t system_event_type_id;
+    std::uint32_t ai_internal_event_type_id;
+};
+
+static_assert(std::is_trivially_copyable<SignalRecord>::value, "SignalRecord POD olmalı");
+
+// Düşük kardinaliteli sinyal stringleri (olay türleri, ağ protokolü) için sınırlı kapasiteli intern tablosu.
+// Aynı string her zaman aynı ID'yi alır ve girdiler süreç boyunca yaşar; kapasite yalnızca beklenmedik bir tür
+// patlamasına karşı emniyettir, dolduğunda yeni stringler NO_STRING olarak kaydedilir. Serbest metin buraya
+// yazılmaz (bkz. SignalPayloadStore).
+class SignalStringInterner {
+public:
+    explicit SignalStringInterner(std::size_t max_entries = 4096);
+
+    std::uint32_t intern(std::string_view str);
+    // ID'yi string'e çevirir. Dönen referans interner yaşadığı sürece geçerlidir.
+    const std::string& resolve(std::uint32_t id) const;
+    std::size_t size() const;
+
+private:
+    std::size_t max_entries_;
+    std::deque<std::string> strings_; // deque: push_back referansları geçersiz kılmaz, string_view anahtarları güvende
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+    mutable std::shared_mutex mutex_;
+};
+
+// Serbest metin yükleri (value, system_event_data, ai_internal_event_data) için sabit slotlu yan tampon.
+// Kayıt sequence_no % slot sayısı slotuna yazılır ve halka sardıkça üzerine yazılır; her alan kMaxFieldBytes ile
+// kırpıldığından bellek slot sayısıyla sınırlıdır ve ısındıktan sonra yeniden ayırma yapılmaz. Slot sayısı halka
+// kapasitesinin iki katıdır: eşzamanlı üreticiler sıra numarası ile ekleme sırasını biraz kaydırabilir.
+class SignalPayloadStore {
+public:
+    static constexpr std::size_t kMaxFieldBytes = 1024;
+
+    explicit SignalPayloadStore(std::size_t ring_capacity);
+
+    SignalPayloadStore(const SignalPayloadStore&) = delete;
+    SignalPayloadStore& operator=(const SignalPayloadStore&) = delete;
+
+    void store(std::uint64_t sequence_no, const AtomicSignal& signal);
+    // Yükler hâlâ slottaysa signal'e kopyalar ve true döner; slotun üzerine yazıldıysa alanlar boş kalır.
+    bool load(std::uint64_t sequence_no, AtomicSignal& signal) const;
+    std::size_t slot_count() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        mutable std::mutex mutex;
+        std::uint64_t sequence_no = UINT64_MAX;
+        std::string value;
+        std::string system_event_data;
+        std::string ai_internal_event_data;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+};
+
+// Sistem olayı yükündeki "APP:" / "Active App:" uygulama bağlamı (kırpılmış); yoksa boş.
+std::string_view signal_app_context(const AtomicSignal& signal);
+
+// AtomicSignal <-> SignalRecord dönüşümleri
+SignalRecord make_signal_record(const AtomicSignal& signal, SignalStringInterner& interner);
+AtomicSignal to_atomic_signal(const SignalRecord& record, const SignalStringInterner& interner, const SignalPayloadStore& payloads);
+
+// SignalRecord'un 64-bit atomik sözcüklerde tutulan kopyası (halka hücresinin içeriği). snapshot() hücreleri
+// üreticiler yazarken okuyabildiği için düz bir SignalRecord alanı veri yarışı olurdu; sözcük bazında relaxed atomik
+// erişim yarışı ortadan kaldırır, yırtık okumaları ise kuyruk hücresinin sıra numarası (seqlock) eler. x86/ARM64'te
+// relaxed 64-bit erişim düz mov'dur.
+class AtomicSignalRecord {
+public:
+    AtomicSignalRecord() = default;
+    explicit AtomicSignalRecord(const SignalRecord& record) { store(record); }
+    AtomicSignalRecord(const AtomicSignalRecord& other) { store(other.load()); }
+    AtomicSignalRecord& operator=(const AtomicSignalRecord& other) {
+        store(other.load());
+        return *this;
+    }
+
+    void store(const SignalRecord& record) {
+        std::uint64_t words[kWords] = {};
+        std::memcpy(words, &record, sizeof(SignalRecord));
+        // Önceki sahibin sıra numarası yazımı, sözcüklerden önce görünür olmalı: sözcüklerden birini bu yazımdan okuyan
+        // snapshot, acquire çitinden sonra sıra numarasının değiştiğini görür (çit-çit eşlemesi).
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    SignalRecord load() const {
+        std::uint64_t words[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) words[i] = words_[i].load(std::memory_order_relaxed);
+        SignalRecord record;
+        std::memcpy(&record, words, sizeof(SignalRecord));
+        return record;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(SignalRecord) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    std::atomic<std::uint64_t> words_[kWords] = {};
+};
+
+// Sinyal penceresi: BoundedMpmcQueue<AtomicSignalRecord> üzerinde ince bir sarmalayıcı. Çoklu üretici / çoklu
+// tüketici güvenlidir ve kilitsizdir; push_overwrite doluyken en eski kaydı düşürerek eski std::deque + pop_front
+// davranışını korur, snapshot kuyruğu tüketmeden okur.
+class SignalRingBuffer {
+public:
+    // capacity ikinin kuvvetine yuvarlanır.
+    explicit SignalRingBuffer(std::size_t capacity) : queue_(capacity) {}
+
+    SignalRingBuffer(const SignalRingBuffer&) = delete;
+    SignalRingBuffer& operator=(const SignalRingBuffer&) = delete;
+
+    bool try_push(const SignalRecord& record) {
+        AtomicSignalRecord cell(record);
+        return queue_.try_push(cell);
+    }
+
+    bool try_pop(SignalRecord& out) {
+        AtomicSignalRecord cell;
+        if (!queue_.try_pop(cell)) return false;
+        out = cell.load();
+        return true;
+    }
+
+    // Tampon doluysa en eski kayıtları düşürerek ekler. Düşürülen her kayıt on_evict'e verilir.
+    template <typename OnEvict>
+    void push_overwrite(const SignalRecord& record, OnEvict&& on_evict) {
+        while (!try_push(record)) {
+            SignalRecord evicted;
+            if (try_pop(evicted)) {
+                on_evict(evicted);
+            }
+        }
+    }
+
+    // Tampondaki kayıtların tutarlı bir kopyasını (eskiden yeniye) döndürür. Üreticileri bloklamaz;
+    // kopyalama sırasında üzerine yazılan hücreler atlanır.
+    std::vector<SignalRecord> snapshot() const;
+
+    std::size_t size_approx() const { return queue_.size_approx(); }
+    std::size_t capacity() const { return queue_.capacity(); }
+
+private:
+    BoundedMpmcQueue<AtomicSignalRecord> queue_;
+};
+
+} // namespace CerebrumLux
+
+#endif // SIGNAL_RING_BUFFER_H
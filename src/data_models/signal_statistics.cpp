@@ -0,0 +1,89 @@
+#include "signal_statistics.h"
+#include <algorithm> // std::min için
+#include <cmath>     // std::sqrt, std::abs için
+#include <cstdlib>   // std::abs(int) için
+
+namespace CerebrumLux {
+
+namespace {
+
+float clamp01(double v) {
+    return static_cast<float>(std::min(1.0, std::max(0.0, v)));
+}
+
+} // namespace
+
+void SignalFeatureStatistics::add(const SignalRecord& record, std::string_view app_context) {
+    ++total_count_;
+    const std::size_t type_index = static_cast<std::size_t>(record.type);
+    if (type_index < type_counts_.size()) ++type_counts_[type_index];
+
+    confidence_.add(record.confidence);
+    if (record.interval_us > 0) interval_us_.add(static_cast<double>(record.interval_us));
+
+    if (record.type == SensorType::Network) {
+        network_activity_.add(record.network_activity_level);
+        last_network_active_ = record.current_network_active;
+        last_network_activity_level_ = record.network_activity_level;
+        last_network_protocol_id_ = record.network_protocol_id;
+    } else if (record.type == SensorType::SystemEvent) {
+        if (record.cpu_usage >= 0.0f) cpu_usage_.add(record.cpu_usage);
+        if (record.ram_usage >= 0.0f) ram_usage_.add(record.ram_usage);
+        if (!app_context.empty()) last_app_context_.assign(app_context);
+    } else if (record.type == SensorType::Mouse) {
+        mouse_motion_.add(std::abs(record.mouse_delta_x) + std::abs(record.mouse_delta_y));
+    }
+}
+
+void SignalFeatureStatistics::remove(const SignalRecord& record) {
+    if (total_count_ == 0) return;
+    --total_count_;
+    const std::size_t type_index = static_cast<std::size_t>(record.type);
+    if (type_index < type_counts_.size() && type_counts_[type_index] > 0) --type_counts_[type_index];
+
+    confidence_.remove(record.confidence);
+    if (record.interval_us > 0) interval_us_.remove(static_cast<double>(record.interval_us));
+
+    // "Son değer" alanları pencerenin en yeni ucunu temsil eder; en eski kaydın çıkması onları değiştirmez.
+    if (record.type == SensorType::Network) {
+        network_activity_.remove(record.network_activity_level);
+    } else if (record.type == SensorType::SystemEvent) {
+        if (record.cpu_usage >= 0.0f) cpu_usage_.remove(record.cpu_usage);
+        if (record.ram_usage >= 0.0f) ram_usage_.remove(record.ram_usage);
+    } else if (record.type == SensorType::Mouse) {
+        mouse_motion_.remove(std::abs(record.mouse_delta_x) + std::abs(record.mouse_delta_y));
+    }
+}
+
+void SignalFeatureStatistics::reset() {
+    *this = SignalFeatureStatistics();
+}
+
+void SignalFeatureStatistics::fill_feature_vector(std::vector<float>& features) const {
+    std::fill(features.begin(), features.end(), 0.0f);
+
+    // Sabit düzen: indeksler değişirse autoencoder ağırlıkları anlamını yitirir.
+    const float values[] = {
+        static_cast<float>(cpu_usage_.mean / 100.0),            // 0: eski düzen, CPU %
+        static_cast<float>(ram_usage_.mean / 1024.0),           // 1: eski düzen, RAM MB -> GB
+        static_cast<float>(network_activity_.mean / 100.0),     // 2: eski düzen, ağ aktivitesi
+        clamp01(std::sqrt(cpu_usage_.variance()) / 100.0),      // 3
+        clamp01(std::sqrt(network_activity_.variance()) / 100.0), // 4
+        clamp01(confidence_.mean),                              // 5
+        clamp01(std::sqrt(confidence_.variance())),             // 6
+        clamp01(interval_us_.mean / 1e6),                       // 7: ortalama sinyal aralığı (sn)
+        clamp01(std::sqrt(interval_us_.variance()) / 1e6),      // 8
+        clamp01(mouse_motion_.mean / 20.0),                     // 9
+    };
+    const std::size_t fixed_count = sizeof(values) / sizeof(values[0]);
+
+    std::size_t i = 0;
+    for (; i < fixed_count && i < features.size(); ++i) features[i] = values[i];
+
+    // 10..: sensör tiplerinin penceredeki payı
+    for (std::size_t t = 0; t < type_counts_.size() && i < features.size(); ++t, ++i) {
+        features[i] = total_count_ > 0 ? static_cast<float>(type_counts_[t]) / static_cast<float>(total_count_) : 0.0f;
+    }
+}
+
+} // namespace CerebrumLux
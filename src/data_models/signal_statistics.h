@@ -0,0 +1,90 @@
+#ifndef SIGNAL_STATISTICS_H
+#define SIGNAL_STATISTICS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "signal_ring_buffer.h" // SignalRecord için
+#include "../core/enums.h" // SensorType için
+
+namespace CerebrumLux {
+
+// Welford yöntemiyle çevrimiçi ortalama/varyans. remove() ile pencereden çıkan örnekler
+// geri alınabilir, böylece halka tamponun içeriği üzerinde tam pencere istatistiği O(1) tutulur.
+struct RunningStat {
+    std::uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double x) {
+        ++count;
+        const double delta = x - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (x - mean);
+    }
+
+    void remove(double x) {
+        if (count <= 1) { reset(); return; }
+        const double old_mean = mean;
+        mean = (old_mean * static_cast<double>(count) - x) / static_cast<double>(count - 1);
+        m2 -= (x - old_mean) * (x - mean);
+        if (m2 < 0.0) m2 = 0.0; // Kayan nokta sapması
+        --count;
+    }
+
+    void reset() { count = 0; mean = 0.0; m2 = 0.0; }
+    double variance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+};
+
+// SequenceManager'ın sinyal penceresi için artımlı özellik istatistikleri.
+// Her push'ta add(), pencereden düşen her kayıt için remove() çağrılır; tüm tamponun yeniden taranması gerekmez.
+class SignalFeatureStatistics {
+public:
+    // app_context: signal_app_context() ile çıkarılan uygulama bağlamı (kayıtta tutulmaz; boşsa son değer korunur).
+    void add(const SignalRecord& record, std::string_view app_context = {});
+    void remove(const SignalRecord& record);
+    void reset();
+
+    // İstatistikleri CryptofigAutoencoder girdisi için normalize edilmiş özellik vektörüne yazar.
+    // İlk üç eleman DynamicSequence'in eski düzeniyle aynıdır (CPU, RAM, ağ aktivitesi).
+    void fill_feature_vector(std::vector<float>& features) const;
+
+    std::uint64_t total_count() const { return total_count_; }
+    std::uint64_t type_count(SensorType type) const { return type_counts_[static_cast<std::size_t>(type)]; }
+
+    const RunningStat& cpu_usage() const { return cpu_usage_; }
+    const RunningStat& ram_usage() const { return ram_usage_; }
+    const RunningStat& network_activity() const { return network_activity_; }
+    const RunningStat& confidence() const { return confidence_; }
+    const RunningStat& interval_us() const { return interval_us_; }
+    const RunningStat& mouse_motion() const { return mouse_motion_; }
+
+    // Penceredeki en son değerler (eski "son sinyalden al" davranışı)
+    bool last_network_active() const { return last_network_active_; }
+    int last_network_activity_level() const { return last_network_activity_level_; }
+    std::uint32_t last_network_protocol_id() const { return last_network_protocol_id_; }
+    const std::string& last_app_context() const { return last_app_context_; }
+
+private:
+    std::uint64_t total_count_ = 0;
+    std::array<std::uint64_t, static_cast<std::size_t>(SensorType::Count)> type_counts_{};
+
+    RunningStat cpu_usage_;
+    RunningStat ram_usage_;
+    RunningStat network_activity_;
+    RunningStat confidence_;
+    RunningStat interval_us_;
+    RunningStat mouse_motion_;
+
+    bool last_network_active_ = false;
+    int last_network_activity_level_ = 0;
+    std::uint32_t last_network_protocol_id_ = SignalRecord::NO_STRING;
+    std::string last_app_context_;
+};
+
+} // namespace CerebrumLux
+
+#endif // SIGNAL_STATISTICS_H
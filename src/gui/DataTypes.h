@@ -17,6 +17,9 @@ struct ChatResponse {
     std::vector<std::string> suggested_questions; // YENİ: Önerilen takip soruları
     bool needs_clarification = false; // Yanıtın belirsiz olup olmadığı ve kullanıcının onayına ihtiyaç duyup duymadığı
     double latency_ms = 0.0; // Yanıtın üretilme süresi (ms cinsinden)
+    double ttft_ms = 0.0; // Akışlı üretimde ilk token'a kadar geçen süre (ms), LLM kullanılmadıysa 0
+    double tokens_per_second = 0.0; // Akışlı üretimde çözümleme hızı, LLM kullanılmadıysa 0
+    bool cancelled = false; // Üretim kullanıcı tarafından durdurulduysa true (metin kısmi olabilir)
 };
 
 struct SimulationData {
@@ -5,9 +5,10 @@
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QDebug>
-#include <QtConcurrent/QtConcurrent> // Asenkron çalıştırma için
+#include <QPromise> // Zamanlayıcı görevinin sonucunu QFutureWatcher'a bağlamak için
 
 #include "../core/logger.h"
+#include "../core/task_scheduler.h"
 #include "../gui/panels/LogPanel.h"
 #include "../gui/panels/GraphPanel.h"
 #include "../gui/panels/SimulationPanel.h"
@@ -127,6 +128,8 @@ MainWindow::MainWindow(EngineIntegration& engineRef, LearningModule& learningMod
 
     // YENİ: KnowledgeBasePanel'i sinyale bağla
     connect(&learningModule, &CerebrumLux::LearningModule::knowledgeBaseUpdated, this, &CerebrumLux::MainWindow::updateKnowledgeBasePanel, Qt::QueuedConnection);
+    // Grafik de zamanlayıcı tikinde değil, bilgi tabanı değiştiğinde yenilenir.
+    connect(&learningModule, &CerebrumLux::LearningModule::knowledgeBaseUpdated, this, &CerebrumLux::MainWindow::refreshGraph, Qt::QueuedConnection);
 
     // YENİ: Asenkron yanıt izleyicisini bağla
     connect(&responseWatcher, &QFutureWatcher<CerebrumLux::ChatResponse>::finished, this, &CerebrumLux::MainWindow::onLLMResponseReady);
@@ -163,7 +166,7 @@ MainWindow::MainWindow(EngineIntegration& engineRef, LearningModule& learningMod
 
     // OPTİMİZASYON: GUI güncelleme sıklığı 1 saniyeden 3 saniyeye çekildi.
     guiUpdateTimer->start(3000); 
-    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: GUI güncelleme zamanlayıcısı başlatıldı (3000ms). [Graph ve Simulation panellerini etkiler]");    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: QTablePanel güncellemesi GUI zamanlayıcısına bağlandı.");
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: GUI güncelleme zamanlayıcısı başlatıldı (3000ms). [Simulation panelini etkiler; grafik knowledgeBaseUpdated ile yenilenir]");    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: QTablePanel güncellemesi GUI zamanlayıcısına bağlandı.");
 
     // YENİ: Ağır LLM modelini GUI'yi bloklamadan arka planda yükle
     // LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MainWindow: LLM modelinin asenkron yüklenmesi tetikleniyor..."); // Bu satır kaldırıldı
@@ -176,12 +179,16 @@ MainWindow::MainWindow(EngineIntegration& engineRef, LearningModule& learningMod
     // Burada tekrar asenkron yükleme başlatmak (Double Loading), RAM'i şişirir ve açılışı yavaşlatır.
     // Bu blok tamamen kaldırılmıştır.
 
+    refreshGraph(); // İlk çizim; sonrakiler knowledgeBaseUpdated ile gelir
+
     LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MainWindow: Kurucu çıkışı. isVisible(): " << isVisible() << ", geometry: " << geometry().width() << "x" << geometry().height());
 }
 
 MainWindow::~MainWindow()
 {
     guiUpdateTimer->stop();
+    graphRefreshTask.cancel(); // Başlamadıysa hiç çalışmaz; çalışıyorsa bitmesi beklenir (this'i kullanır)
+    graphRefreshTask.wait();
     delete ui;
     // QTablePanel kendi workerThread'ini yönettiği için burada özel bir silme işlemi yapmaya gerek yok.
     // qTablePanel, MainWindow'ın bir child'ı olarak otomatik silinir.
@@ -220,36 +227,8 @@ void MainWindow::updateGui() {
     */
    
    // Sadece LogPanel veya hafif arayüz güncellemeleri burada kalabilir.
-   // Ağır işler Event-Driven oldu.
-
-    // YENİ: GraphData embedding'ini bir kez hesaplayıp önbelleğe alıyoruz.
-    static std::vector<float> graph_query_embedding = engine.getNlpProcessor().generate_text_embedding_sync("GraphData");
-    auto capsules_for_graph = learningModule.getKnowledgeBase().semantic_search(graph_query_embedding, 100);
-     QMap<qreal, qreal> graph_data;
-    qreal min_confidence = std::numeric_limits<qreal>::max();
-    qreal max_confidence = std::numeric_limits<qreal>::lowest();
-    for (const auto& cap : capsules_for_graph) {
-        /*
-        // YENİ LOG: GraphData kapsüllerinin içeriğini kontrol et
-        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow::updateGui: GraphData Kapsül (ID: " << cap.id
-                    << ", Topic: " << cap.topic << ", Confidence: " << cap.confidence
-                    << ", Timestamp (ms): " << std::chrono::duration_cast<std::chrono::milliseconds>(cap.timestamp_utc.time_since_epoch()).count()
-                    << ", Summary: " << cap.plain_text_summary.substr(0, std::min((size_t)50, cap.plain_text_summary.length())) << "...)");
-        */
-        graph_data.insert(std::chrono::duration_cast<std::chrono::milliseconds>(cap.timestamp_utc.time_since_epoch()).count(), static_cast<qreal>(cap.confidence));
-        min_confidence = std::min(min_confidence, static_cast<qreal>(cap.confidence));
-        max_confidence = std::max(max_confidence, static_cast<qreal>(cap.confidence));
-    }
-    
-    // Graph Panel güncellemesini de çok sık yapmaya gerek yok, 
-    // veya sadece yeni veri eklendiğinde yapılmalı.
-    // Şimdilik burayı da yorum satırına alıp, updateKnowledgeBasePanel içine taşıyabiliriz.
-    // Ancak görsel olarak bir şey görmek istiyorsanız açık kalabilir, 
-    // fakat VectorDB optimizasyonu (MDB_NORDAHEAD) olmadan burası diski yorar.
-    
-    // ÖNERİ: GraphPanel güncellemesini de 'knowledgeBaseUpdated' sinyaline taşıyalım.
-    // if (graphPanel) { graphPanel->updateData(...); } // Buradan kaldırıldı.
-    
+   // Ağır işler Event-Driven oldu (grafik: refreshGraph).
+
     // KRİTİK PERFORMANS DÜZELTMESİ:
     // updateKnowledgeBasePanel() çağrısı buradan KALDIRILDI. 
     // Artık sadece sinyal geldiğinde (veri değiştiğinde) çalışacak.
@@ -257,6 +236,35 @@ void MainWindow::updateGui() {
     LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "MainWindow::updateGui: GUI güncellendi."); // TRACE seviyesindeki genel log korunuyor
 }
 
+void MainWindow::refreshGraph() {
+    // Embedding ve semantik arama GUI iş parçacığını bloklamasın diye ortak zamanlayıcıda (BackgroundLearning)
+    // çalışır. Önceki sorgu sürerken gelen güncellemeler birleştirilir ve sorgu bitince tek bir tur daha çalışır.
+    if (!graphRefreshTask.done()) {
+        graphRefreshPending = true;
+        return;
+    }
+    graphRefreshPending = false;
+    graphRefreshTask = CerebrumLux::TaskScheduler::instance().submit(CerebrumLux::TaskClass::BackgroundLearning, [this](const CerebrumLux::CancellationToken& token) {
+        if (token.cancelled()) return;
+        // YENİ: GraphData embedding'ini bir kez hesaplayıp önbelleğe alıyoruz.
+        static std::vector<float> graph_query_embedding = engine.getNlpProcessor().generate_text_embedding_sync("GraphData");
+        auto capsules_for_graph = learningModule.getKnowledgeBase().semantic_search(graph_query_embedding, 100);
+        QMap<qreal, qreal> graph_data;
+        for (const auto& cap : capsules_for_graph) {
+            graph_data.insert(std::chrono::duration_cast<std::chrono::milliseconds>(cap.timestamp_utc.time_since_epoch()).count(), static_cast<qreal>(cap.confidence));
+        }
+        if (token.cancelled() || !graphPanel) return;
+        // Widget'a yalnızca GUI iş parçacığında dokunulur; pencere bu arada silinirse kuyruklanan çağrı düşer.
+        QMetaObject::invokeMethod(this, [this, graph_data = std::move(graph_data)]() {
+            if (graphPanel) graphPanel->updateData("AI Confidence", graph_data);
+            if (graphRefreshPending) {
+                graphRefreshTask.wait(); // Görev bu çağrıyı kuyrukladıktan sonra hemen biter
+                refreshGraph();
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
 void MainWindow::onSimulationCommandEntered(const QString& command) {
     LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "Simulation Command: " << command.toStdString());
     engine.processUserCommand(command.toStdString());
@@ -357,31 +365,51 @@ void MainWindow::onEmbeddingReady(const std::string& request_id, const std::vect
     // KRİTİK: Yanıt üretimini asenkron olarak başlatıyoruz (LLM'i başka bir thread'e atıyoruz)
     // Bu, generate_response içinde LLM.generate çağrısının ana thread'i bloklamasını engeller.
     // user_embedding'i doğrudan generate_response'a iletiyoruz.
-    QFuture<CerebrumLux::ChatResponse> future = QtConcurrent::run([=, this]() {
-        return engine.getResponseEngine().generate_response(
-            user_intent, 
-            current_abstract_state, 
-            current_goal, 
-            current_sequence, 
-            learningModule.getKnowledgeBase(),
-            embedding // YENİ: Embedding'i ResponseEngine'e iletiyoruz
-        );
+    // Token'lar üretildikçe ChatPanel'e akar; panel her karede biriken metni bir kez çizer.
+    auto stream = std::make_shared<CerebrumLux::TokenStream>();
+    if (chatPanel) {
+        chatPanel->beginStreamingMessage("CerebrumLux", stream);
+    }
+    // Üretim ortak zamanlayıcıda Inference sınıfında çalışır; sonuç QPromise üzerinden responseWatcher'a ulaşır.
+    auto promise = std::make_shared<QPromise<CerebrumLux::ChatResponse>>();
+    QFuture<CerebrumLux::ChatResponse> future = promise->future();
+    promise->start();
+    CerebrumLux::TaskScheduler::instance().submit(CerebrumLux::TaskClass::Inference, [=, this]() {
+        try {
+            promise->addResult(engine.getResponseEngine().generate_response_streaming(
+                user_intent, 
+                current_abstract_state, 
+                current_goal, 
+                current_sequence, 
+                learningModule.getKnowledgeBase(),
+                embedding, // YENİ: Embedding'i ResponseEngine'e iletiyoruz
+                stream
+            ));
+        } catch (...) {
+            promise->setException(std::current_exception()); // QtConcurrent::run ile aynı: result() yeniden fırlatır
+        }
+        promise->finish();
     });
     
-    // Sonucu izleyiciye bağla
+    // Sonucu izleyiciye bağla; akış, sonucun hâlâ etkin balona ait olup olmadığını ayırt etmek için saklanır.
+    responseStream = stream;
     responseWatcher.setFuture(future);
 }
 
 // YENİ: Asenkron işlem bittiğinde çağrılacak slot
 void MainWindow::onLLMResponseReady() {
     CerebrumLux::ChatResponse response = responseWatcher.result();
-    
-    // YENİ: Yanıtı doğrudan CoreEventBus üzerinden yayınla
-    emit CerebrumLux::CoreEventBus::getInstance().responseReady(
-        QString::fromStdString(response.text)
-    );
 
-    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: Asenkron NLP yanıtı CoreEventBus üzerinden yayınlandı.");
+    // Akışla yazılan ham metin, nihai (temizlenmiş) yanıt ile değiştirilir.
+    // Yanıt doğrudan akış balonuna yazıldığı için CoreEventBus::responseReady burada yayınlanmaz (çift mesaj olmasın).
+    if (chatPanel) {
+        chatPanel->finishStreamingMessage("CerebrumLux", responseStream, response);
+    }
+
+    if (response.ttft_ms > 0.0) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MainWindow: LLM yanıtı tamamlandı. TTFT: " << response.ttft_ms << " ms, " << response.tokens_per_second << " token/s" << (response.cancelled ? " (durduruldu)" : ""));
+    }
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "MainWindow: Asenkron NLP yanıtı ChatPanel'e iletildi.");
 }
 
 void MainWindow::updateKnowledgeBasePanel() {
@@ -25,6 +25,7 @@
 #include "../ai_tutor/tutor_broker_adapter.h" // YENİ: TutorBrokerAdapter için
 #include "../communication/natural_language_processor.h" // CerebrumLux::ChatResponse için
 #include "../core/CoreEventBus.h" // YENİ: CoreEventBus için
+#include "../core/task_scheduler.h" // Arka plan görevleri için ortak zamanlayıcı
 #include "../gui/engine_integration.h"
 #include "../gui/DataTypes.h"
 #include "ui_MainWindow.h"
@@ -60,6 +61,7 @@ public:
 private slots:
     void updateGui();
     void updateKnowledgeBasePanel();
+    void refreshGraph(); // Bilgi tabanı değişince grafik sorgusunu arka planda yeniden çalıştırır
     void onWebFetchCompleted(const CerebrumLux::IngestReport& report);
     void onChatMessageReceived(const QString& message); // YENİ: Chat mesajı işleme slotu
 
@@ -96,6 +98,11 @@ private:
 
     // YENİ: Asenkron işlem izleyicisi
     QFutureWatcher<CerebrumLux::ChatResponse> responseWatcher;
+    std::shared_ptr<CerebrumLux::TokenStream> responseStream; // responseWatcher'ın izlediği üretimin akışı
+    // refreshGraph'ın arka plandaki grafik sorgusu (aynı anda en fazla bir tane). Sorgu sürerken gelen güncellemeler
+    // tek bir sonraki tura birleştirilir.
+    CerebrumLux::TaskHandle graphRefreshTask;
+    bool graphRefreshPending = false;
 
     SimulationData convertCapsuleToSimulationData(const Capsule& capsule);
 };
@@ -1,5 +1,7 @@
 #include <QLocale> // Dil ayarı için
 #include <QRegularExpression> // Dil algılama için
+#include <QTextCursor>
+#include <QTextBlock>
 
 #include "ChatPanel.h"
 
@@ -28,6 +30,11 @@ ChatPanel::ChatPanel(QWidget *parent) : QWidget(parent)
     // Varsayılan olarak ses kapalı olsun (Kullanıcı isterse açsın)
     isVoiceEnabled = false; 
 
+    // ~60 FPS: token'lar bu aralıkta toplanıp tek seferde belgeye yazılır.
+    streamFrameTimer = new QTimer(this);
+    streamFrameTimer->setInterval(16);
+    connect(streamFrameTimer, &QTimer::timeout, this, &CerebrumLux::ChatPanel::onStreamFrame);
+
 }
 
 ChatPanel::~ChatPanel() {
@@ -80,10 +87,18 @@ void ChatPanel::setupUi() {
     btnVoiceToggle->setCheckable(true);
     connect(btnVoiceToggle, &QPushButton::clicked, this, &CerebrumLux::ChatPanel::onToggleVoiceClicked);
 
+    // Akışlı yanıt sürerken görünen durdurma butonu
+    btnStop = new QPushButton("⏹", this);
+    btnStop->setToolTip("Yanıt üretimini durdur");
+    btnStop->setFixedWidth(30);
+    btnStop->setVisible(false);
+    connect(btnStop, &QPushButton::clicked, this, &CerebrumLux::ChatPanel::onStopClicked);
+
     // Başlangıçta feedback butonları pasif olabilir veya aktif kalabilir
     
     bottomLayout->addWidget(chatMessageLineEdit);
     bottomLayout->addWidget(sendChatMessageButton);
+    bottomLayout->addWidget(btnStop);
     bottomLayout->addWidget(btnLike);
     bottomLayout->addWidget(btnDislike);
     bottomLayout->addWidget(btnVoiceToggle);
@@ -110,6 +125,11 @@ void ChatPanel::appendChatMessage(const QString& sender, const CerebrumLux::Chat
     if (!response.reasoning.empty()) {
         formattedMessage += QString("<br><i><small>(Gerekçe: %1)</small></i>").arg(QString::fromStdString(response.reasoning));
     }
+    if (response.ttft_ms > 0.0) {
+        formattedMessage += QString("<br><i><small>(İlk token: %1 ms, %2 token/s)</small></i>")
+                                .arg(response.ttft_ms, 0, 'f', 0)
+                                .arg(response.tokens_per_second, 0, 'f', 1);
+    }
 
     chatHistoryDisplay->append(formattedMessage);
 
@@ -158,6 +178,76 @@ void ChatPanel::appendChatMessage(const QString& sender, const CerebrumLux::Chat
     }
 }
 
+void ChatPanel::beginStreamingMessage(const QString& sender, std::shared_ptr<CerebrumLux::TokenStream> stream) {
+    detachActiveStream();
+    if (!stream) return;
+
+    chatHistoryDisplay->append(QString("<b>%1:</b> ").arg(sender));
+    streamBlockStart = chatHistoryDisplay->document()->lastBlock().position();
+    activeStream = std::move(stream);
+    btnStop->setVisible(true);
+    streamFrameTimer->start();
+}
+
+void ChatPanel::onStreamFrame() {
+    if (!activeStream) {
+        streamFrameTimer->stop();
+        return;
+    }
+    if (!activeStream->has_pending()) return;
+
+    const QString chunk = QString::fromStdString(activeStream->take_pending());
+    if (chunk.isEmpty()) return;
+    QTextCursor cursor(chatHistoryDisplay->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(chunk); // Düz metin: model çıktısı HTML olarak yorumlanmaz
+}
+
+void ChatPanel::finishStreamingMessage(const QString& sender, const std::shared_ptr<CerebrumLux::TokenStream>& stream,
+                                       const CerebrumLux::ChatResponse& response) {
+    if (!stream || stream != activeStream) {
+        // detachActiveStream kısmi metni "(yanıt durduruldu)" ile bıraktı; geç gelen iptal sonucu ikinci kez yazılmaz.
+        LOG_DEFAULT(LogLevel::DEBUG, "ChatPanel: Ayrılmış akışın sonucu yok sayıldı.");
+        return;
+    }
+    if (streamBlockStart >= 0) {
+        // Akış sırasında yazılan ham metni sil; yerine nihai biçimli mesaj eklenecek.
+        QTextCursor cursor(chatHistoryDisplay->document());
+        cursor.setPosition(streamBlockStart > 0 ? streamBlockStart - 1 : 0);
+        cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+    }
+    streamFrameTimer->stop();
+    activeStream.reset();
+    streamBlockStart = -1;
+    btnStop->setVisible(false);
+
+    if (response.cancelled && response.text.empty()) {
+        chatHistoryDisplay->append(QString("<b>%1:</b> <i>(yanıt durduruldu)</i>").arg(sender));
+        return;
+    }
+    appendChatMessage(sender, response);
+}
+
+void ChatPanel::detachActiveStream() {
+    if (!activeStream) return;
+    // Sonucu artık beklenmeyen akış: üretimi durdur, eldeki kısmi metni bırak.
+    activeStream->cancel();
+    onStreamFrame();
+    chatHistoryDisplay->append("<i><small>(yanıt durduruldu)</small></i>");
+    streamFrameTimer->stop();
+    activeStream.reset();
+    streamBlockStart = -1;
+    btnStop->setVisible(false);
+}
+
+void ChatPanel::onStopClicked() {
+    if (activeStream) {
+        activeStream->cancel();
+        LOG_DEFAULT(LogLevel::INFO, "ChatPanel: Kullanıcı akışlı yanıt üretimini durdurdu.");
+    }
+}
+
 void ChatPanel::addSuggestionButton(const std::string& text) {
     QPushButton* btn = new QPushButton(QString::fromStdString(text), this);
     btn->setStyleSheet("text-align: left; padding: 5px;");
@@ -186,6 +276,7 @@ void ChatPanel::onSuggestionBtnClicked() {
         QString text = btn->text();
         // Öneri tıklandığında bunu sanki kullanıcı yazmış gibi işle
         clearSuggestions();
+        detachActiveStream();
         appendChatMessage("User", text);
         emit chatMessageEntered(text); 
     }
@@ -206,8 +297,9 @@ void ChatPanel::onSendClicked() {
     LOG_DEFAULT(LogLevel::DEBUG, "ChatPanel: onChatMessageLineEditReturnPressed slot triggered.");
     QString message = chatMessageLineEdit->text().trimmed();
     if (!message.isEmpty()) {
-        // Kullanıcı yeni bir şey yazdığında eski önerileri temizle
+        // Kullanıcı yeni bir şey yazdığında eski önerileri temizle, süren yanıtı kes
         clearSuggestions();
+        detachActiveStream();
         appendChatMessage("User", message);
         emit chatMessageEntered(message);
         chatMessageLineEdit->clear();
@@ -11,10 +11,13 @@
 #include <QVBoxLayout>
 #include <QDateTime> // QDateTime için
 #include <QTextToSpeech> // YENİ: TTS Kütüphanesi
+#include <QTimer>
+#include <memory>
 
 #include "../../core/logger.h" // LOG_DEFAULT makrosu için
 #include "../../communication/natural_language_processor.h" // CerebrumLux::ChatResponse için
 #include "../../core/enums.h" // LogLevel için
+#include "../../brain/token_stream.h" // Akışlı LLM yanıtları için
 
 namespace CerebrumLux {
 
@@ -31,6 +34,14 @@ public slots:
     // Basit metin eklemek için overload (Kullanıcı mesajları için)
     void appendChatMessage(const QString& sender, const QString& message);
 
+    // Akışlı yanıt: token'lar geldikçe mesaj balonuna eklenir (her çizim karesinde en fazla bir güncelleme).
+    // Önceki akış hâlâ sürüyorsa iptal edilir ve kısmi metni olduğu gibi bırakılır.
+    void beginStreamingMessage(const QString& sender, std::shared_ptr<CerebrumLux::TokenStream> stream);
+    // Akışın yerine nihai (temizlenmiş) yanıtı, gerekçe ve önerilerle birlikte yazar. stream artık etkin akış
+    // değilse (kullanıcı yeni mesaj gönderip eski akışı ayırdıysa) sonuç yok sayılır: kısmi metni zaten ekranda.
+    void finishStreamingMessage(const QString& sender, const std::shared_ptr<CerebrumLux::TokenStream>& stream,
+                                const CerebrumLux::ChatResponse& response);
+
 signals:
     // Kullanıcı chat mesajı girdiğinde (MainWindow'a bağlanacak)
     void chatMessageEntered(const QString& message);
@@ -44,6 +55,8 @@ private slots:
     void onLikeClicked();
     void onDislikeClicked();
     void onToggleVoiceClicked(); // YENİ: Ses aç/kapa slotu
+    void onStreamFrame();
+    void onStopClicked();
 
 private:
     QTextEdit *chatHistoryDisplay;
@@ -61,6 +74,13 @@ private:
     QPushButton *btnVoiceToggle;
     bool isVoiceEnabled;
 
+    // Akışlı yanıt durumu
+    QPushButton *btnStop;
+    QTimer *streamFrameTimer;
+    std::shared_ptr<CerebrumLux::TokenStream> activeStream;
+    int streamBlockStart = -1; // Akış mesajının belgedeki başlangıç konumu
+
+    void detachActiveStream();
     void clearSuggestions();
     void addSuggestionButton(const std::string& text);
     void setupUi();
@@ -4,8 +4,12 @@
 // QPainter zaten GraphPanel.h'de dahil edildiği için burada tekrar etmiyoruz.
 
 #include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
 #include "../../core/logger.h" // LOG_DEFAULT makrosu için
+#include "../../core/metrics.h" // Çalışma zamanı metrikleri görünümü için
 #include <limits> // std::numeric_limits için
+#include <algorithm>
 #include <QDebug> // Eski kodunuzdaki gibi QDebug için eklendi
 
 // using namespace QtCharts; // Eski çalışan kodunuzda bu yoktu, bu yüzden kaldırıldı.
@@ -17,6 +21,18 @@ CerebrumLux::GraphPanel::GraphPanel(QWidget *parent)
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
+    QHBoxLayout *metricLayout = new QHBoxLayout();
+    metricLayout->addWidget(new QLabel("Metrik:", this));
+    this->metricSelector = new QComboBox(this);
+    this->metricSelector->addItem("(yok)");
+    this->metricSelector->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    metricLayout->addWidget(this->metricSelector);
+    metricLayout->addStretch();
+    this->resetZoomButton = new QPushButton("Yakınlaştırmayı Sıfırla", this);
+    this->resetZoomButton->setEnabled(false);
+    metricLayout->addWidget(this->resetZoomButton);
+    mainLayout->addLayout(metricLayout);
+
     // Eski çalışan kodunuzdaki gibi, QtCharts:: ön eki olmadan kullanıyoruz.
     this->chart = new QChart();
     this->chart->setTitle("AI Güven Seviyesi ve Performans Grafiği");
@@ -40,51 +56,200 @@ CerebrumLux::GraphPanel::GraphPanel(QWidget *parent)
     this->series->attachAxis(this->axisX); // Seriyi X eksenine bağla
     this->series->attachAxis(this->axisY); // Seriyi Y eksenine bağla
 
+    // Metrik serisi kendi eksenlerini kullanır; güven grafiğinin ölçeğini bozmaz.
+    this->metricAxisX = new QValueAxis();
+    this->metricAxisX->setTitleText("Zaman (s)");
+    this->metricAxisX->setLabelFormat("%d");
+    this->metricAxisX->setVisible(false);
+    this->chart->addAxis(this->metricAxisX, Qt::AlignTop);
+
+    this->metricAxisY = new QValueAxis();
+    this->metricAxisY->setLabelFormat("%.2f");
+    this->metricAxisY->setVisible(false);
+    this->chart->addAxis(this->metricAxisY, Qt::AlignRight);
+
+    this->metricSeries = new QLineSeries();
+    this->metricSeries->setName("Metric");
+    this->chart->addSeries(this->metricSeries);
+    this->metricSeries->attachAxis(this->metricAxisX);
+    this->metricSeries->attachAxis(this->metricAxisY);
+
     this->chartView = new QChartView(this->chart);
     this->chartView->setRenderHint(QPainter::Antialiasing);
+    this->chartView->setRubberBand(QChartView::HorizontalRubberBand); // Fare ile yatay yakınlaştırma
     mainLayout->addWidget(this->chartView);
 
     setLayout(mainLayout);
 
+    connect(this->metricSelector, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &GraphPanel::onMetricSelectionChanged);
+    connect(this->axisX, &QValueAxis::rangeChanged, this, &GraphPanel::onConfidenceAxisRangeChanged);
+    connect(this->metricAxisX, &QValueAxis::rangeChanged, this, &GraphPanel::onMetricAxisRangeChanged);
+    connect(this->resetZoomButton, &QPushButton::clicked, this, &GraphPanel::onResetZoomClicked);
+    this->metricsTimer = new QTimer(this);
+    connect(this->metricsTimer, &QTimer::timeout, this, &GraphPanel::onMetricsTimer);
+    this->metricsClock.start();
+    this->metricsTimer->start(1000);
+
     LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "GraphPanel: Initialized.");
 }
 
-void CerebrumLux::GraphPanel::updateData(const QString& seriesName, const QMap<qreal, qreal>& data) {
-    if (seriesName == "AI Confidence" && this->series) {
+void CerebrumLux::GraphPanel::refreshMetricSelector() {
+    // Metrikler ilk kullanımda kaydedildiği için liste zamanla büyür; yalnızca yeni anahtarlar eklenir.
+    const auto samples = Metrics::MetricsRegistry::instance().sample();
+    if (static_cast<int>(samples.size()) + 1 == this->metricSelector->count()) return;
+    for (const auto& sample : samples) {
+        const QString key = QString::fromStdString(sample.key);
+        if (this->metricSelector->findText(key) < 0) {
+            this->metricSelector->addItem(key);
+        }
+    }
+}
+
+int CerebrumLux::GraphPanel::pixelBudget() const {
+    // Piksel başına bir nokta yeterli; grafik henüz yerleşmediyse makul bir varsayılan kullanılır.
+    const int width = static_cast<int>(this->chart->plotArea().width());
+    return width > 0 ? width : 800;
+}
+
+QList<QPointF> CerebrumLux::GraphPanel::toQPoints(const std::vector<SeriesPoint>& points) {
+    QList<QPointF> out;
+    out.reserve(static_cast<qsizetype>(points.size()));
+    for (const SeriesPoint& p : points) out.append(QPointF(p.x, p.y));
+    return out;
+}
+
+void CerebrumLux::GraphPanel::redrawConfidence() {
+    if (this->confidenceStore.empty()) {
         this->series->clear();
-        qreal maxX = 0;
-        qreal minX = std::numeric_limits<qreal>::max();
-        qreal maxY = 0;
-        qreal minY = std::numeric_limits<qreal>::max();
-
-        for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
-            this->series->append(it.key(), it.value());
-            maxX = std::max(maxX, it.key());
-            minX = std::min(minX, it.key());
-            maxY = std::max(maxY, it.value());
-            minY = std::min(minY, it.value());
+        this->applyingRange = true;
+        this->axisX->setRange(0, 10000); // Varsayılan 10 saniye
+        this->axisY->setRange(0, 1);
+        this->applyingRange = false;
+        return;
+    }
+
+    const qreal minX = this->confidenceFollow ? this->confidenceStore.first_x() : this->axisX->min();
+    const qreal maxX = this->confidenceFollow ? this->confidenceStore.last_x() : this->axisX->max();
+    this->series->replace(toQPoints(this->confidenceStore.view(minX, maxX, static_cast<std::size_t>(pixelBudget()))));
+
+    double minY = 0.0;
+    double maxY = 1.0;
+    this->applyingRange = true;
+    if (this->confidenceFollow) this->axisX->setRange(minX, maxX); // Tüm mevcut verinin aralığını göster
+    if (this->confidenceStore.y_range(minX, maxX, minY, maxY)) {
+        // Dinamik Y ekseni aralığı. Confidence 0-1 arasında olmalı; biraz margin eklenir.
+        this->axisY->setRange(std::max(0.0, minY - 0.05), std::min(1.0, maxY + 0.05));
+    } else {
+        this->axisY->setRange(0, 1);
+    }
+    this->applyingRange = false;
+}
+
+void CerebrumLux::GraphPanel::redrawMetric() {
+    if (this->metricStore.empty()) {
+        this->metricSeries->clear();
+        return;
+    }
+
+    const qreal lastX = this->metricStore.last_x();
+    const qreal minX = this->metricFollow ? std::max<qreal>(this->metricStore.first_x(), lastX - kMetricWindowSeconds) : this->metricAxisX->min();
+    const qreal maxX = this->metricFollow ? lastX : this->metricAxisX->max();
+    this->metricSeries->replace(toQPoints(this->metricStore.view(minX, maxX, static_cast<std::size_t>(pixelBudget()))));
+
+    double minY = 0.0;
+    double maxY = 0.0;
+    this->applyingRange = true;
+    if (this->metricFollow) this->metricAxisX->setRange(minX, std::max(maxX, minX + 1.0));
+    if (this->metricStore.y_range(minX, maxX, minY, maxY)) {
+        const qreal margin = std::max<qreal>(1e-3, (maxY - minY) * 0.05);
+        this->metricAxisY->setRange(minY - margin, maxY + margin);
+    }
+    this->applyingRange = false;
+}
+
+void CerebrumLux::GraphPanel::onConfidenceAxisRangeChanged(qreal min, qreal max) {
+    Q_UNUSED(min);
+    Q_UNUSED(max);
+    if (this->applyingRange) return;
+    this->confidenceFollow = false;
+    this->resetZoomButton->setEnabled(true);
+    redrawConfidence();
+}
+
+void CerebrumLux::GraphPanel::onMetricAxisRangeChanged(qreal min, qreal max) {
+    Q_UNUSED(min);
+    Q_UNUSED(max);
+    if (this->applyingRange) return;
+    this->metricFollow = false;
+    this->resetZoomButton->setEnabled(true);
+    redrawMetric();
+}
+
+void CerebrumLux::GraphPanel::onResetZoomClicked() {
+    this->confidenceFollow = true;
+    this->metricFollow = true;
+    this->resetZoomButton->setEnabled(false);
+    redrawConfidence();
+    redrawMetric();
+}
+
+void CerebrumLux::GraphPanel::onMetricSelectionChanged(int index) {
+    this->metricStore.clear();
+    this->metricFollow = true;
+    this->metricSeries->clear();
+    this->lastMetricSampleMs = -1;
+    const bool active = index > 0;
+    this->metricAxisX->setVisible(active);
+    this->metricAxisY->setVisible(active);
+    this->metricAxisY->setTitleText(QString());
+}
+
+void CerebrumLux::GraphPanel::onMetricsTimer() {
+    refreshMetricSelector();
+    if (this->metricSelector->currentIndex() <= 0 || !isVisible()) return;
+
+    const std::string selected = this->metricSelector->currentText().toStdString();
+    const auto samples = Metrics::MetricsRegistry::instance().sample();
+    auto it = std::find_if(samples.begin(), samples.end(), [&](const Metrics::MetricSample& s) { return s.key == selected; });
+    if (it == samples.end()) return;
+
+    const qint64 now_ms = this->metricsClock.elapsed();
+    qreal y = it->value;
+    if (it->type == Metrics::MetricType::Counter) {
+        // Counter toplamı sürekli artar; anlamlı olan saniye başına hızdır.
+        if (this->lastMetricSampleMs < 0) {
+            this->lastMetricValue = it->value;
+            this->lastMetricSampleMs = now_ms;
+            this->metricAxisY->setTitleText("/s");
+            return;
         }
+        const double dt = std::max<qint64>(1, now_ms - this->lastMetricSampleMs) / 1000.0;
+        y = (it->value - this->lastMetricValue) / dt;
+        this->lastMetricValue = it->value;
+    } else if (it->type == Metrics::MetricType::Histogram) {
+        this->metricAxisY->setTitleText("p99 (ms)");
+    } else {
+        this->metricAxisY->setTitleText("değer");
+    }
+    this->lastMetricSampleMs = now_ms;
 
-        if (this->chart->axes(Qt::Horizontal).size() > 0 && this->chart->axes(Qt::Vertical).size() > 0) {
-            // QValueAxis* türüne qobject_cast yaparken tam nitelikli ismi kullanıyoruz.
-            QValueAxis *axisX_ptr = qobject_cast<QValueAxis*>(this->chart->axes(Qt::Horizontal).at(0));
-            QValueAxis *axisY_ptr = qobject_cast<QValueAxis*>(this->chart->axes(Qt::Vertical).at(0));
-            if (axisX_ptr && axisY_ptr) {
-                // DÜZELTİLDİ: Eksen aralığı yönetimi. Veri varsa dinamik, yoksa varsayılan.
-                if (data.isEmpty()) { 
-                    axisX_ptr->setRange(0, 10000); // Varsayılan 10 saniye
-                } else {
-                    axisX_ptr->setRange(minX, maxX); // Tüm mevcut verinin aralığını göster
-                }
-                
-                // YENİ: Dinamik Y ekseni aralığı. Confidence 0-1 arasında olmalı.
-                // Eğer max_confidence 0 ise veya min_confidence çok yüksekse varsayılan 0-1 aralığını koru.
-                axisY_ptr->setRange(std::max(0.0, minY - 0.05), std::min(1.0, maxY + 0.05)); // Biraz margin ekle
-                if (minY == std::numeric_limits<qreal>::max() || maxY == std::numeric_limits<qreal>::lowest()) {
-                    axisY_ptr->setRange(0, 1); // Veri yoksa veya geçersizse varsayılan
-                }
-            }
+    // Tüm oturum depoda kalır; takip modunda son kMetricWindowSeconds çizilir, yakınlaştırmada eski aralıklar da görülebilir.
+    this->metricStore.append(now_ms / 1000.0, y);
+    redrawMetric();
+}
+
+void CerebrumLux::GraphPanel::updateData(const QString& seriesName, const QMap<qreal, qreal>& data) {
+    if (seriesName == "AI Confidence" && this->series) {
+        // Çağıran her seferinde tüm geçmişi gönderir; yalnızca depodaki son x'ten sonraki noktalar eklenir.
+        // Geçmiş geriye gittiyse (ör. veri sıfırlandıysa) depo yeniden kurulur.
+        if (data.isEmpty() || (!this->confidenceStore.empty() && data.lastKey() < this->confidenceStore.last_x())) {
+            this->confidenceStore.clear();
+        }
+        auto it = this->confidenceStore.empty() ? data.constBegin() : data.upperBound(this->confidenceStore.last_x());
+        for (; it != data.constEnd(); ++it) {
+            this->confidenceStore.append(it.key(), it.value());
         }
+        redrawConfidence();
     }
     LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "GraphPanel: Data updated for series: " << seriesName.toStdString());
 }
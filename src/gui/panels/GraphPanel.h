@@ -4,6 +4,10 @@
 #include <QWidget>
 #include <QMap>
 #include <QString>
+#include <QComboBox>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPushButton>
 
 // Çalışan eski kodunuzdaki gibi doğrudan QtCharts başlıklarını dahil ediyoruz.
 // Bu başlıklar, QChart, QChartView, QLineSeries gibi türleri global scope'ta veya Qt'nin mekanizmasıyla görünür kılar.
@@ -16,6 +20,8 @@
 // QPainter için gerekebilir (QChartView render hint için)
 #include <QPainter>
 
+#include "../../core/time_series.h"
+
 namespace CerebrumLux {
 
 class GraphPanel : public QWidget
@@ -23,18 +29,55 @@ class GraphPanel : public QWidget
     Q_OBJECT
 public:
     explicit GraphPanel(QWidget *parent = nullptr);
+
+    static constexpr double kMetricWindowSeconds = 600.0; // Metrik görünümünde takip edilen son 10 dakika
     void updateData(const QString& seriesName, const QMap<qreal, qreal>& data); // Güncelleme için mevcut metod adını koruyorum
     // Eski kodunuzdaki addDataPoint ve updateGraph(size_t) metotları bu sürümde yoktu,
     // ben updateData(const QString& seriesName, const QMap<qreal, qreal>& data); metodunu koruyorum.
     // Eğer bu metotları geri getirmek isterseniz, bana bildirin.
 
+private slots:
+    // MetricsRegistry'den seçili metriği örnekler (saniyede bir).
+    void onMetricsTimer();
+    void onMetricSelectionChanged(int index);
+    // Kullanıcı yakınlaştırdığında (rubber band) görünür aralık özet seviyelerinden yeniden örneklenir.
+    void onConfidenceAxisRangeChanged(qreal min, qreal max);
+    void onMetricAxisRangeChanged(qreal min, qreal max);
+    void onResetZoomClicked();
+
 private:
+    void refreshMetricSelector();
+    // Seriler her güncellemede tüm geçmişle doldurulmaz: depo yalnızca yeni noktaları ekler, seri ise görünür
+    // aralığın piksel genişliğine indirgenmiş hâliyle tek seferde replace() edilir.
+    int pixelBudget() const;
+    void redrawConfidence();
+    void redrawMetric();
+    static QList<QPointF> toQPoints(const std::vector<SeriesPoint>& points);
+
     // Üyeleri eski çalışan kodunuzdaki gibi, QtCharts:: ön eki olmadan tanımlıyoruz.
     QChart *chart;
     QChartView *chartView;
     QLineSeries *series;
     QValueAxis *axisX; // Eski kodunuzdaki gibi QValueAxis
     QValueAxis *axisY; // Eski kodunuzdaki gibi QValueAxis
+    QPushButton *resetZoomButton;
+
+    TimeSeriesStore confidenceStore;
+    bool confidenceFollow = true; // true: tüm veri gösterilir; false: kullanıcının yakınlaştırdığı aralık
+    bool applyingRange = false;   // Eksen aralığını kod değiştirirken rangeChanged sinyallerini yok saymak için
+
+    // Çalışma zamanı metrikleri görünümü: seçilen metrik sağ eksende ayrı bir seri olarak çizilir.
+    // Counter'lar saniye başına hız, gauge'lar anlık değer, histogramlar p99 (ms) olarak gösterilir.
+    QComboBox *metricSelector;
+    QLineSeries *metricSeries;
+    QValueAxis *metricAxisX;
+    QValueAxis *metricAxisY;
+    QTimer *metricsTimer;
+    QElapsedTimer metricsClock;
+    TimeSeriesStore metricStore;
+    bool metricFollow = true; // true: son kMetricWindowSeconds gösterilir
+    double lastMetricValue = 0.0;
+    qint64 lastMetricSampleMs = -1;
 };
 
 
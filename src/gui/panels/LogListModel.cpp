@@ -0,0 +1,308 @@
+#include "LogListModel.h"
+
+#include <algorithm>
+#include <QBrush>
+#include <QColor>
+
+#include "../../core/logger.h"
+
+namespace CerebrumLux {
+
+LogListModel::LogListModel(int maxEntries, QObject *parent)
+    : QAbstractListModel(parent),
+      maxEntries_(std::max(1, maxEntries))
+{
+    ring_.resize(static_cast<std::size_t>(maxEntries_));
+}
+
+LogListModel::~LogListModel() {
+    if (spillFile_.isOpen()) spillFile_.close();
+}
+
+int LogListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return filterLower_.isEmpty() ? static_cast<int>(size_) : static_cast<int>(filtered_.size());
+}
+
+quint64 LogListModel::seqForRow(int row) const {
+    return filterLower_.isEmpty() ? firstSeq_ + static_cast<quint64>(row) : filtered_[static_cast<std::size_t>(row)];
+}
+
+QVariant LogListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) return QVariant();
+    const LogEntry& entry = entryAt(seqForRow(index.row()));
+
+    switch (role) {
+        case Qt::DisplayRole:
+            // Logger'dan gelen mesaj zaten zaman damgası ve diğer bilgileri içeriyor.
+            return entry.rawMessage;
+        case Qt::ToolTipRole:
+            return QString("%1:%2").arg(entry.file).arg(entry.line);
+        case Qt::ForegroundRole:
+            switch (entry.level) {
+                case LogLevel::TRACE:        return QBrush(QColor("gray"));
+                case LogLevel::DEBUG:        return QBrush(QColor("blue"));
+                case LogLevel::INFO:         return QBrush(QColor("white"));
+                case LogLevel::WARNING:      return QBrush(QColor("orange"));
+                case LogLevel::ERR_CRITICAL: return QBrush(QColor("red"));
+                default:                     return QVariant();
+            }
+        default:
+            return QVariant();
+    }
+}
+
+// --- Trigram indeksi ---
+
+void LogListModel::collectTrigrams(const QString& lowerText, std::vector<quint64>& out) {
+    out.clear();
+    const int n = lowerText.size();
+    if (n < 3) return;
+    out.reserve(static_cast<std::size_t>(n - 2));
+    for (int i = 0; i + 2 < n; ++i) {
+        out.push_back((static_cast<quint64>(lowerText.at(i).unicode()) << 32) |
+                      (static_cast<quint64>(lowerText.at(i + 1).unicode()) << 16) |
+                      static_cast<quint64>(lowerText.at(i + 2).unicode()));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void LogListModel::indexEntry(quint64 seq, const LogEntry& entry) {
+    collectTrigrams(entry.rawMessage.toLower(), trigramScratch_);
+    for (quint64 trigram : trigramScratch_) {
+        trigramIndex_[trigram].seqs.push_back(seq); // seq'ler artan sırada geldiği için liste sıralı kalır
+    }
+}
+
+void LogListModel::unindexEntry(quint64 seq, const LogEntry& entry) {
+    collectTrigrams(entry.rawMessage.toLower(), trigramScratch_);
+    for (quint64 trigram : trigramScratch_) {
+        auto it = trigramIndex_.find(trigram);
+        if (it == trigramIndex_.end()) continue;
+        Posting& posting = it.value();
+        // Tahliye her zaman en eski girdiden başlar; bu yüzden seq listenin başındadır.
+        if (posting.begin < posting.seqs.size() && posting.seqs[posting.begin] == seq) ++posting.begin;
+        if (posting.begin == posting.seqs.size()) {
+            trigramIndex_.erase(it);
+        } else if (posting.begin >= 64 && posting.begin * 2 >= posting.seqs.size()) {
+            posting.seqs.erase(posting.seqs.begin(), posting.seqs.begin() + static_cast<std::ptrdiff_t>(posting.begin));
+            posting.begin = 0;
+        }
+    }
+}
+
+std::vector<quint64> LogListModel::candidatesFor(const QString& lowerQuery) const {
+    std::vector<quint64> result;
+    std::vector<quint64> queryTrigrams;
+    collectTrigrams(lowerQuery, queryTrigrams);
+
+    if (queryTrigrams.empty()) {
+        // 3 karakterden kısa sorgular için indeks kullanılamaz: tüm girdiler adaydır.
+        result.reserve(size_);
+        for (std::size_t i = 0; i < size_; ++i) result.push_back(firstSeq_ + i);
+        return result;
+    }
+
+    // En kısa posting listesinden başlayarak kesişim al.
+    std::vector<const Posting*> postings;
+    postings.reserve(queryTrigrams.size());
+    for (quint64 trigram : queryTrigrams) {
+        auto it = trigramIndex_.constFind(trigram);
+        if (it == trigramIndex_.constEnd()) return result; // Hiçbir girdi bu trigram'ı içermiyor
+        postings.push_back(&it.value());
+    }
+    std::sort(postings.begin(), postings.end(), [](const Posting* a, const Posting* b) {
+        return a->seqs.size() - a->begin < b->seqs.size() - b->begin;
+    });
+
+    result.assign(postings.front()->seqs.begin() + static_cast<std::ptrdiff_t>(postings.front()->begin),
+                  postings.front()->seqs.end());
+    for (std::size_t p = 1; p < postings.size() && !result.empty(); ++p) {
+        const auto first = postings[p]->seqs.begin() + static_cast<std::ptrdiff_t>(postings[p]->begin);
+        const auto last = postings[p]->seqs.end();
+        result.erase(std::remove_if(result.begin(), result.end(), [first, last](quint64 seq) {
+            return !std::binary_search(first, last, seq);
+        }), result.end());
+    }
+    return result;
+}
+
+bool LogListModel::matchesFilter(const LogEntry& entry) const {
+    return entry.rawMessage.contains(filterLower_, Qt::CaseInsensitive);
+}
+
+void LogListModel::rebuildFilter() {
+    std::vector<quint64> matched;
+    for (quint64 seq : candidatesFor(filterLower_)) {
+        if (matchesFilter(entryAt(seq))) matched.push_back(seq);
+    }
+    filtered_.swap(matched);
+}
+
+void LogListModel::setFilterText(const QString& text) {
+    if (text == filterText_) return;
+    const QString lower = text.toLower();
+
+    beginResetModel();
+    if (lower.isEmpty()) {
+        filtered_.clear();
+        filtered_.shrink_to_fit();
+    } else if (!filterLower_.isEmpty() && lower.contains(filterLower_)) {
+        // Artımlı arama: yeni sorgu eskisini içeriyorsa sonuçlar mevcut kümenin alt kümesidir.
+        filterLower_ = lower;
+        filtered_.erase(std::remove_if(filtered_.begin(), filtered_.end(), [this](quint64 seq) {
+            return !matchesFilter(entryAt(seq));
+        }), filtered_.end());
+    } else {
+        filterLower_ = lower;
+        rebuildFilter();
+    }
+    filterText_ = text;
+    filterLower_ = lower;
+    endResetModel();
+}
+
+// --- Ekleme / tahliye ---
+
+void LogListModel::spill(const LogEntry& entry) {
+    if (!spillFile_.isOpen()) return;
+    spillFile_.write(entry.rawMessage.toUtf8());
+    spillFile_.write("\n", 1);
+    ++spilledCount_;
+}
+
+bool LogListModel::openSpillFile(QIODevice::OpenMode mode) {
+    if (spillFile_.open(mode | QIODevice::WriteOnly | QIODevice::Text)) return true;
+    LOG_ERROR_CERR(LogLevel::WARNING, "LogListModel: Spill dosyası açılamadı: " << spillFile_.fileName().toStdString());
+    return false;
+}
+
+void LogListModel::rotateSpillIfNeeded() {
+    // size() tamponu boşaltır; yalnızca parti sonlarında çağrılır.
+    if (!spillFile_.isOpen() || spillMaxBytes_ <= 0 || spillFile_.size() < spillMaxBytes_) return;
+    const QString path = spillFile_.fileName();
+    const QString rotated = path + ".1";
+    spillFile_.close();
+    QFile::remove(rotated);
+    if (QFile::rename(path, rotated)) {
+        openSpillFile(QIODevice::Append);
+    } else {
+        // Yeniden adlandırılamadı (ör. Windows'ta dosya başka süreçte açık): eski içerik atılır, sınır yine korunur.
+        LOG_ERROR_CERR(LogLevel::WARNING, "LogListModel: Spill dosyası döndürülemedi, kırpılıyor: " << path.toStdString());
+        openSpillFile(QIODevice::Truncate);
+    }
+}
+
+void LogListModel::evictOldest(std::size_t count) {
+    count = std::min(count, size_);
+    if (count == 0) return;
+
+    const quint64 evictEnd = firstSeq_ + count;
+    int removedRows;
+    if (filterLower_.isEmpty()) {
+        removedRows = static_cast<int>(count);
+    } else {
+        removedRows = static_cast<int>(std::lower_bound(filtered_.begin(), filtered_.end(), evictEnd) - filtered_.begin());
+    }
+
+    if (removedRows > 0) beginRemoveRows(QModelIndex(), 0, removedRows - 1);
+    for (quint64 seq = firstSeq_; seq < evictEnd; ++seq) {
+        LogEntry& entry = ring_[head_];
+        spill(entry);
+        unindexEntry(seq, entry);
+        entry = LogEntry{};
+        head_ = (head_ + 1) % ring_.size();
+    }
+    firstSeq_ = evictEnd;
+    size_ -= count;
+    if (!filterLower_.isEmpty() && removedRows > 0) filtered_.erase(filtered_.begin(), filtered_.begin() + removedRows);
+    if (removedRows > 0) endRemoveRows();
+    if (spillFile_.isOpen()) spillFile_.flush();
+    rotateSpillIfNeeded();
+}
+
+void LogListModel::appendBatch(std::vector<LogEntry>&& entries) {
+    if (entries.empty()) return;
+
+    const std::size_t capacity = ring_.size();
+    std::size_t skip = 0;
+    if (entries.size() > capacity) {
+        // Tek partide kapasiteden fazla girdi: ilk kısmı hiç gösterilmeden doğrudan spill edilir.
+        evictOldest(size_);
+        skip = entries.size() - capacity;
+        for (std::size_t i = 0; i < skip; ++i) spill(entries[i]);
+        firstSeq_ += skip;
+        rotateSpillIfNeeded();
+    } else if (size_ + entries.size() > capacity) {
+        evictOldest(size_ + entries.size() - capacity);
+    }
+
+    const std::size_t incoming = entries.size() - skip;
+    const quint64 startSeq = firstSeq_ + size_;
+
+    std::vector<quint64> newMatches;
+    if (!filterLower_.isEmpty()) {
+        for (std::size_t i = 0; i < incoming; ++i) {
+            if (matchesFilter(entries[skip + i])) newMatches.push_back(startSeq + i);
+        }
+    }
+
+    const int firstRow = rowCount();
+    const int insertedRows = filterLower_.isEmpty() ? static_cast<int>(incoming) : static_cast<int>(newMatches.size());
+    if (insertedRows > 0) beginInsertRows(QModelIndex(), firstRow, firstRow + insertedRows - 1);
+    for (std::size_t i = 0; i < incoming; ++i) {
+        const quint64 seq = startSeq + i;
+        LogEntry& slot = ring_[(head_ + size_) % capacity];
+        slot = std::move(entries[skip + i]);
+        ++size_;
+        indexEntry(seq, slot);
+    }
+    filtered_.insert(filtered_.end(), newMatches.begin(), newMatches.end());
+    if (insertedRows > 0) endInsertRows();
+}
+
+void LogListModel::clear() {
+    beginResetModel();
+    for (LogEntry& entry : ring_) entry = LogEntry{};
+    firstSeq_ += size_;
+    head_ = 0;
+    size_ = 0;
+    filtered_.clear();
+    trigramIndex_.clear();
+    endResetModel();
+    // Temizlenen halkadan önce taşan girdiler de atılır; döndürülmüş eski dosya olduğu gibi kalır.
+    if (spillFile_.isOpen()) {
+        spillFile_.close();
+        openSpillFile(QIODevice::Truncate);
+    }
+}
+
+void LogListModel::setMaxEntries(int maxEntries) {
+    maxEntries = std::max(1, maxEntries);
+    if (maxEntries == maxEntries_) return;
+
+    if (static_cast<std::size_t>(maxEntries) < size_) evictOldest(size_ - static_cast<std::size_t>(maxEntries));
+
+    // Halkayı yeni kapasiteye, en eski girdi başta olacak şekilde yeniden diz. Satır/seq eşlemesi değişmez.
+    std::vector<LogEntry> resized(static_cast<std::size_t>(maxEntries));
+    for (std::size_t i = 0; i < size_; ++i) resized[i] = std::move(ring_[(head_ + i) % ring_.size()]);
+    ring_.swap(resized);
+    head_ = 0;
+    maxEntries_ = maxEntries;
+}
+
+void LogListModel::setSpillFilePath(const QString& path) {
+    if (spillFile_.isOpen()) spillFile_.close();
+    if (path.isEmpty()) return;
+    spillFile_.setFileName(path);
+    // Önceki oturumlardan kalan dosyaya eklenir; sınırı zaten aşmışsa hemen döndürülür.
+    if (openSpillFile(QIODevice::Append)) rotateSpillIfNeeded();
+}
+
+void LogListModel::setSpillMaxBytes(qint64 maxBytes) {
+    spillMaxBytes_ = maxBytes;
+    rotateSpillIfNeeded();
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,104 @@
+#ifndef LOG_LIST_MODEL_H
+#define LOG_LIST_MODEL_H
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <vector>
+
+#include "../../core/enums.h"
+
+namespace CerebrumLux {
+
+struct LogEntry {
+    CerebrumLux::LogLevel level;
+    QString rawMessage;
+    QString file;
+    int line;
+};
+
+// LogPanel'in sınırlı, sanallaştırılmış veri modeli.
+//
+//  - Girdiler sabit kapasiteli bir halkada tutulur; kapasite aşıldığında en eski girdiler (varsa) spill
+//    dosyasına eklenerek modelden çıkarılır. Spill dosyası boyut sınırını aşınca "<yol>.1" olarak döndürülür,
+//    clear() ile kırpılır; diskte en fazla iki dosya (yaklaşık 2 * sınır) kalır.
+//  - Her girdiye artan bir sıra numarası (seq) verilir; satır -> seq eşlemesi filtre yokken doğrudan,
+//    filtre varken sıralı seq listesi üzerinden yapılır. QListView yalnızca görünen satırları ister.
+//  - Arama, küçük harfe çevrilmiş mesajların trigram indeksiyle yapılır: sorgunun tüm trigram'larını
+//    içeren girdiler kesişimle bulunur, ardından alt dize kontrolüyle doğrulanır. Mevcut sorguyu genişleten
+//    (ör. bir harf daha yazılan) sorgular yalnızca mevcut sonuç kümesini daraltır.
+// Tüm metotlar GUI thread'inden çağrılmalıdır.
+class LogListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    static constexpr int kDefaultMaxEntries = 20000;
+    static constexpr qint64 kDefaultSpillMaxBytes = 8 * 1024 * 1024;
+
+    explicit LogListModel(int maxEntries = kDefaultMaxEntries, QObject *parent = nullptr);
+    ~LogListModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // Tek bir satır ekleme/çıkarma bildirimiyle toplu ekleme.
+    void appendBatch(std::vector<LogEntry>&& entries);
+    void clear();
+
+    void setFilterText(const QString& text);
+    QString filterText() const { return filterText_; }
+
+    void setMaxEntries(int maxEntries);
+    int maxEntries() const { return maxEntries_; }
+    // Boş yol spill'i kapatır; bu durumda taşan girdiler atılır.
+    void setSpillFilePath(const QString& path);
+    quint64 spilledCount() const { return spilledCount_; }
+    // 0 veya negatif değer döndürmeyi kapatır (dosya sınırsız büyür).
+    void setSpillMaxBytes(qint64 maxBytes);
+    qint64 spillMaxBytes() const { return spillMaxBytes_; }
+
+    int storedCount() const { return static_cast<int>(size_); }
+
+private:
+    struct Posting {
+        std::vector<quint64> seqs; // Artan sırada
+        std::size_t begin = 0;     // Tahliye edilen önek (ucuz pop_front için)
+    };
+
+    const LogEntry& entryAt(quint64 seq) const { return ring_[(head_ + static_cast<std::size_t>(seq - firstSeq_)) % ring_.size()]; }
+    quint64 seqForRow(int row) const;
+    bool matchesFilter(const LogEntry& entry) const;
+
+    static void collectTrigrams(const QString& lowerText, std::vector<quint64>& out);
+    void indexEntry(quint64 seq, const LogEntry& entry);
+    void unindexEntry(quint64 seq, const LogEntry& entry);
+    std::vector<quint64> candidatesFor(const QString& lowerQuery) const;
+    void rebuildFilter();
+
+    void evictOldest(std::size_t count);
+    void spill(const LogEntry& entry);
+    void rotateSpillIfNeeded();
+    bool openSpillFile(QIODevice::OpenMode mode);
+
+    std::vector<LogEntry> ring_;
+    std::size_t head_ = 0;   // En eski girdinin halkadaki yeri
+    std::size_t size_ = 0;
+    quint64 firstSeq_ = 0;   // En eski girdinin sıra numarası
+    int maxEntries_;
+
+    QString filterText_;
+    QString filterLower_;
+    std::vector<quint64> filtered_; // Filtre aktifken eşleşen seq'ler (artan)
+
+    QHash<quint64, Posting> trigramIndex_;
+    std::vector<quint64> trigramScratch_;
+
+    QFile spillFile_;
+    quint64 spilledCount_ = 0;
+    qint64 spillMaxBytes_ = kDefaultSpillMaxBytes;
+};
+
+} // namespace CerebrumLux
+
+#endif // LOG_LIST_MODEL_H
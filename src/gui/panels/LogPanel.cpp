@@ -2,14 +2,11 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QScrollBar>
-#include <QRegularExpressionMatch>
 #include "../core/logger.h"
 #include <QDateTime>
-#include <QTextCharFormat>
-#include <QBrush>
 #include <QLineEdit>
 #include <QPushButton>
-#include <QRegularExpression>
+#include <cstdlib>
 
 namespace CerebrumLux {
 
@@ -17,9 +14,27 @@ LogPanel::LogPanel(QWidget *parent) : QWidget(parent)
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
-    logTextEdit = new QTextEdit(this);
-    logTextEdit->setReadOnly(true);
-    mainLayout->addWidget(logTextEdit);
+    int maxEntries = LogListModel::kDefaultMaxEntries;
+    if (const char* env = std::getenv("CEREBRUMLUX_LOG_PANEL_MAX_ENTRIES")) {
+        bool ok = false;
+        const int parsed = QString::fromUtf8(env).toInt(&ok);
+        if (ok && parsed > 0) maxEntries = parsed;
+    }
+    logModel = new LogListModel(maxEntries, this);
+    if (const char* env = std::getenv("CEREBRUMLUX_LOG_PANEL_SPILL_MAX_BYTES")) {
+        bool ok = false;
+        const qint64 parsed = QString::fromUtf8(env).toLongLong(&ok);
+        if (ok) logModel->setSpillMaxBytes(parsed);
+    }
+    const char* spillEnv = std::getenv("CEREBRUMLUX_LOG_PANEL_SPILL_FILE");
+    logModel->setSpillFilePath(spillEnv ? QString::fromUtf8(spillEnv) : QString("cerebrum_lux_gui_log_spill.txt"));
+
+    logListView = new QListView(this);
+    logListView->setModel(logModel);
+    logListView->setUniformItemSizes(true); // Satır yükseklikleri tek tek ölçülmez
+    logListView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    logListView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mainLayout->addWidget(logListView);
 
     QHBoxLayout *controlLayout = new QHBoxLayout();
     searchLineEdit = new QLineEdit(this);
@@ -29,6 +44,11 @@ LogPanel::LogPanel(QWidget *parent) : QWidget(parent)
     controlLayout->addWidget(clearLogButton);
     mainLayout->addLayout(controlLayout);
 
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(kFlushIntervalMs);
+    connect(flushTimer, &QTimer::timeout, this, &LogPanel::flushPendingLogs);
+
     // Logger singleton'ından gelen sinyali bu slot'a bağla
     // Qt::QueuedConnection, sinyal emit eden thread ile slot'un çalıştığı thread farklıysa güvenli iletişim sağlar.
     connect(&Logger::getInstance(), &Logger::messageLogged,
@@ -36,21 +56,10 @@ LogPanel::LogPanel(QWidget *parent) : QWidget(parent)
 
     connect(clearLogButton, &QPushButton::clicked, this, &LogPanel::onClearLogClicked);
     connect(searchLineEdit, &QLineEdit::textChanged, this, &LogPanel::onSearchTextChanged);
-    
-    connect(logTextEdit->verticalScrollBar(), &QScrollBar::rangeChanged,
-            [this](int min, int max){ 
-                if (searchLineEdit->text().isEmpty()) { 
-                    Q_UNUSED(min); 
-                    logTextEdit->verticalScrollBar()->setValue(max); 
-                }
-            });
 
     // LogPanel'in başlangıçta boş olmaması için bir hoş geldiniz mesajı
-    // Bu mesajı da kendi formatlayıcısından geçirerek ekleyelim.
-    QString welcomeMessage = "Cerebrum Lux Log Paneli Başlatıldı.";
-    QString formattedWelcome = formatLogMessage(LogLevel::INFO, welcomeMessage, "LogPanel.cpp", __LINE__);
-    originalLogs.push_back({LogLevel::INFO, welcomeMessage, formattedWelcome, "LogPanel.cpp", __LINE__});
-    logTextEdit->append(formattedWelcome);
+    pendingLogs.push_back({LogLevel::INFO, "Cerebrum Lux Log Paneli Başlatıldı.", "LogPanel.cpp", __LINE__});
+    flushPendingLogs();
 
     LOG_DEFAULT(LogLevel::INFO, "LogPanel: Modül Başlatıldı."); // Logger artık çalışıyor, bu log dosyaya/konsola ve GUI'ye gidecek
 }
@@ -60,60 +69,52 @@ LogPanel::~LogPanel() {
     // QObject parent-child mekanizması sayesinde bağlantılar otomatik olarak kopar.
 }
 
+void LogPanel::setMaxEntries(int maxEntries) {
+    logModel->setMaxEntries(maxEntries);
+}
+
+void LogPanel::setSpillFilePath(const QString& path) {
+    logModel->setSpillFilePath(path);
+}
+
+void LogPanel::setSpillMaxBytes(qint64 maxBytes) {
+    logModel->setSpillMaxBytes(maxBytes);
+}
+
 void LogPanel::handleMessageLogged(CerebrumLux::LogLevel level, const QString& rawMessage, const QString& file, int line) {
-    // Logger'dan gelen ham mesajı, LogPanel'in kendi formatlama mantığı ile renklendir ve tam mesajı oluştur.
-    QString fullFormattedMessage = formatLogMessage(level, rawMessage, file, line);
+    // Mesaj hemen modele eklenmez; log fırtınalarında her mesaj için ayrı satır ekleme/yeniden çizim yerine
+    // kFlushIntervalMs içinde gelenler tek partide eklenir.
+    pendingLogs.push_back({level, rawMessage, file, line});
+    if (!flushTimer->isActive()) flushTimer->start();
+}
 
-    // Logu dahili vektöre kaydet (filtreleme için)
-    originalLogs.push_back({level, rawMessage, fullFormattedMessage, file, line});
+void LogPanel::flushPendingLogs() {
+    if (pendingLogs.empty()) return;
 
-    // Eğer arama kutusu boşsa veya yeni log arama metnine uyuyorsa QTextEdit'e ekle
-    if (searchLineEdit->text().isEmpty() || rawMessage.contains(searchLineEdit->text(), Qt::CaseInsensitive)) {
-        logTextEdit->append(fullFormattedMessage);
-    }
+    // Kullanıcı yukarı kaydırmadıysa ve arama yoksa en alttaki yeni mesajları takip et.
+    QScrollBar *scrollBar = logListView->verticalScrollBar();
+    const bool followTail = searchLineEdit->text().isEmpty() && scrollBar->value() >= scrollBar->maximum();
+
+    std::vector<LogEntry> batch;
+    batch.swap(pendingLogs);
+    logModel->appendBatch(std::move(batch));
+
+    if (followTail) logListView->scrollToBottom();
 }
 
 void LogPanel::onClearLogClicked() {
-    logTextEdit->clear();
-    originalLogs.clear();
+    flushTimer->stop();
+    pendingLogs.clear();
+    logModel->clear();
     LOG_DEFAULT(LogLevel::INFO, "LogPanel: Log içeriği ve dahili loglar temizlendi.");
     emit logCleared();
 }
 
 void LogPanel::onSearchTextChanged(const QString& text) {
-    filterLogs(text);
-}
-
-void LogPanel::filterLogs(const QString& filterText) {
-    logTextEdit->clear();
-
-    if (filterText.isEmpty()) {
-        for (const auto& logEntry : originalLogs) {
-            logTextEdit->append(logEntry.formattedMessage); // Formatlanmış mesajı kullan
-        }
-    } else {
-        QRegularExpression regex(filterText, QRegularExpression::CaseInsensitiveOption);
-        for (const auto& logEntry : originalLogs) {
-            if (logEntry.rawMessage.contains(regex)) { // Ham mesaj üzerinde filtrele
-                logTextEdit->append(logEntry.formattedMessage); // Formatlanmış mesajı göster
-            }
-        }
-    }
-}
-
-QString LogPanel::formatLogMessage(CerebrumLux::LogLevel level, const QString& message, const QString& file, int line) const {
-    QString formattedMessage;
-    // Not: Logger'dan gelen mesaj zaten zaman damgası ve diğer bilgileri içeriyor.
-    // Bu fonksiyon sadece renklendirme ekliyor.
-    switch (level) {
-        case LogLevel::TRACE:       formattedMessage = "<font color=\"gray\">" + message + "</font>"; break;
-        case LogLevel::DEBUG:       formattedMessage = "<font color=\"blue\">" + message + "</font>"; break;
-        case LogLevel::INFO:        formattedMessage = "<font color=\"white\">" + message + "</font>"; break;
-        case LogLevel::WARNING:     formattedMessage = "<font color=\"orange\">" + message + "</font>"; break;
-        case LogLevel::ERR_CRITICAL: formattedMessage = "<font color=\"red\">" + message + "</font>"; break;
-        default:                    formattedMessage = message; break;
-    }
-    return formattedMessage; 
+    // Filtre uygulanmadan önce bekleyen mesajlar da indekse girsin.
+    flushPendingLogs();
+    logModel->setFilterText(text);
+    if (text.isEmpty()) logListView->scrollToBottom();
 }
 
-} // namespace CerebrumLux
\ No newline at end of file
+} // namespace CerebrumLux
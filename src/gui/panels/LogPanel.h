@@ -2,27 +2,23 @@
 #define LOG_PANEL_H
 
 #include <QWidget>
-#include <QTextEdit>
+#include <QListView>
 #include <QPushButton>
 #include <QDateTime>
 #include <QVBoxLayout>
+#include <QTimer>
 #include <vector>
 #include <QLineEdit>
-#include <QRegularExpression>
-#include <QTextCharFormat>
 
 #include "../../core/enums.h"
+#include "LogListModel.h"
 
 namespace CerebrumLux {
 
-struct LogEntry {
-    CerebrumLux::LogLevel level;
-    QString rawMessage;
-    QString formattedMessage;
-    QString file;
-    int line;
-};
-
+// Log mesajları LogListModel'de (sınırlı halka + trigram indeksi) tutulur ve QListView ile yalnızca görünen
+// satırlar çizilir. Logger'dan gelen mesajlar kısa bir süre biriktirilip tek seferde modele eklenir.
+// Kapasite, spill dosyası ve spill boyut sınırı CEREBRUMLUX_LOG_PANEL_MAX_ENTRIES / CEREBRUMLUX_LOG_PANEL_SPILL_FILE /
+// CEREBRUMLUX_LOG_PANEL_SPILL_MAX_BYTES ortam değişkenleriyle veya setter'larla ayarlanabilir.
 class LogPanel : public QWidget
 {
     Q_OBJECT
@@ -30,6 +26,12 @@ public:
     explicit LogPanel(QWidget *parent = nullptr);
     ~LogPanel() override;
 
+    void setMaxEntries(int maxEntries);
+    void setSpillFilePath(const QString& path);
+    void setSpillMaxBytes(qint64 maxBytes);
+
+    static constexpr int kFlushIntervalMs = 50;
+
 signals:
     void logCleared();
 
@@ -37,16 +39,16 @@ private slots:
     void handleMessageLogged(CerebrumLux::LogLevel level, const QString& rawMessage, const QString& file, int line);
     void onClearLogClicked();
     void onSearchTextChanged(const QString& text);
+    void flushPendingLogs();
 
 private:
-    QTextEdit *logTextEdit;
+    QListView *logListView;
     QPushButton *clearLogButton;
     QLineEdit *searchLineEdit;
 
-    std::vector<LogEntry> originalLogs;
-    
-    void filterLogs(const QString& filterText);
-    QString formatLogMessage(CerebrumLux::LogLevel level, const QString& message, const QString& file, int line) const;
+    LogListModel *logModel;
+    std::vector<LogEntry> pendingLogs; // Bir sonraki flush'ta modele eklenecek mesajlar
+    QTimer *flushTimer;
 };
 
 } // namespace CerebrumLux
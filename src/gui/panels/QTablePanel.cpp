@@ -22,6 +22,7 @@ QTablePanel::QTablePanel(LearningModule& learningModuleRef, QWidget *parent)
     qTableWorker->moveToThread(&workerThread);
     connect(&workerThread, &QThread::finished, qTableWorker, &QObject::deleteLater);
     connect(qTableWorker, &QTableWorker::qTableContentFetched, this, &QTablePanel::handleQTableContentFetched);
+    connect(qTableWorker, &QTableWorker::qTableDeltaFetched, this, &QTablePanel::handleQTableDeltaFetched);
     connect(qTableWorker, &QTableWorker::workerError, this, &QTablePanel::handleWorkerError);
 
     connect(this, &QTablePanel::requestFetchQTableContent,
@@ -92,22 +93,16 @@ void QTablePanel::handleQTableContentFetched(const std::vector<CerebrumLux::Swar
     currentQStateKeys = all_q_state_keys;
     displayedQTableDetails = displayed_q_table_details;
 
-    //stateListWidget->clear();
-    // DÜZELTİLDİ: DEBUG AMAÇLI HER ZAMAN TEMİZLEME.
-    // Liste boş görünüyorsa, öğelerin görüntülenip görüntülenmediğini test etmek için her seferinde temizliyoruz.
-    // Bu kodu ileride tekrar akıllı temizleme mantığına geri almanız gerekebilir.
-        stateListWidget->clear();
+    // Tam yenileme (ilk çekim, filtre değişikliği veya yeniden yükleme); sonraki güncellemeler delta olarak gelir.
+    stateListWidget->clear();
+    stateItems.clear();
 
     for (const auto& pair : displayed_q_table_details) {
         QString stateKey = pair.first;
-        const QTableDisplayData& data = pair.second;
-
-        QString itemText = QString("Durum Anahtarı: %1 | Eylem Sayısı: %2")
-                            .arg(stateKey.left(50) + "...")
-                            .arg(data.actionQValues.size());
-        QListWidgetItem *item = new QListWidgetItem(itemText);
+        QListWidgetItem *item = new QListWidgetItem(stateItemText(stateKey, pair.second));
         item->setData(Qt::UserRole, stateKey);
         stateListWidget->addItem(item);
+        stateItems.insert(stateKey, item);
     }
 
     // Seçimi geri yükle
@@ -131,6 +126,35 @@ void QTablePanel::handleQTableContentFetched(const std::vector<CerebrumLux::Swar
     LOG_DEFAULT(LogLevel::DEBUG, "QTablePanel: Q-Table içeriği GUI'de güncellendi. Toplam listelenen durum: " << stateListWidget->count());
 }
 
+void QTablePanel::handleQTableDeltaFetched(const std::map<QString, QTableDisplayData>& changed_q_table_details) {
+    QString selectedStateKey;
+    if (stateListWidget->currentItem()) { selectedStateKey = stateListWidget->currentItem()->data(Qt::UserRole).toString(); }
+
+    for (const auto& pair : changed_q_table_details) {
+        const QString& stateKey = pair.first;
+        displayedQTableDetails[stateKey] = pair.second;
+
+        auto item_it = stateItems.find(stateKey);
+        if (item_it != stateItems.end()) {
+            item_it.value()->setText(stateItemText(stateKey, pair.second));
+        } else {
+            QListWidgetItem *item = new QListWidgetItem(stateItemText(stateKey, pair.second));
+            item->setData(Qt::UserRole, stateKey);
+            stateListWidget->addItem(item);
+            stateItems.insert(stateKey, item);
+            currentQStateKeys.push_back(stateKey.toStdString());
+        }
+        if (stateKey == selectedStateKey) displayQValueDetails(pair.second);
+    }
+    LOG_DEFAULT(LogLevel::DEBUG, "QTablePanel: Q-Table delta uygulandı. Değişen durum: " << changed_q_table_details.size() << ", Toplam listelenen durum: " << stateListWidget->count());
+}
+
+QString QTablePanel::stateItemText(const QString& stateKey, const QTableDisplayData& data) {
+    return QString("Durum Anahtarı: %1 | Eylem Sayısı: %2")
+            .arg(stateKey.left(50) + "...")
+            .arg(data.actionQValues.size());
+}
+
 void QTablePanel::handleWorkerError(const QString& error_message) {
     LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "QTablePanel: Worker hatası: " << error_message.toStdString());
     QMessageBox::critical(this, "Hata", "Q-Table verisi çekme sırasında bir hata oluştu: " + error_message);
@@ -8,6 +8,7 @@
 #include <QPushButton>
 #include <QSplitter>
 #include <QThread> // Worker için QThread
+#include <QHash>
 
 #include "../../core/logger.h"
 #include "../../learning/LearningModule.h"
@@ -35,6 +36,7 @@ private slots:
     void handleQTableContentFetched(const std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey>& all_q_state_keys,
                                     const std::map<QString, QTableDisplayData>& displayed_q_table_details,
                                     const QString& restoreSelectionStateKey);
+    void handleQTableDeltaFetched(const std::map<QString, QTableDisplayData>& changed_q_table_details);
     void handleWorkerError(const QString& error_message);
 
     void onSelectedStateChanged(QListWidgetItem* current, QListWidgetItem* previous);
@@ -53,10 +55,12 @@ private:
     QSplitter *splitter;               // Liste ve detay görünümünü ayırmak için
 
     std::map<QString, QTableDisplayData> displayedQTableDetails; // Görüntülenen Q-Table verileri
+    QHash<QString, QListWidgetItem*> stateItems; // Delta güncellemelerinde satırı yerinde değiştirmek için
     std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey> currentQStateKeys; // LMDB'den alınan tüm durum anahtarları
 
     void setupUi(); // Kullanıcı arayüzünü başlatan yardımcı metod
     void displayQValueDetails(const QTableDisplayData& data);
+    static QString stateItemText(const QString& stateKey, const QTableDisplayData& data);
     void applyFiltersAndFetchData(); // Tüm filtreleri uygulayıp worker'a veri çekme isteği gönderen yardımcı metod
 };
 
@@ -18,11 +18,12 @@ QTableWorker::~QTableWorker() {
 }
 
 QTableDisplayData QTableWorker::createDisplayData(const CerebrumLux::SwarmVectorDB::EmbeddingStateKey& stateKey,
-                                                const std::map<CerebrumLux::AIAction, float>& actionQValues) {
+                                                const QValueIndex::StateValues& values) {
     QTableDisplayData data;
     data.stateKey = QString::fromStdString(stateKey);
-    for (const auto& pair : actionQValues) {
-        data.actionQValues[QString::fromStdString(CerebrumLux::to_string(pair.first))] = pair.second;
+    for (std::size_t i = 0; i < QValueIndex::kActionCount; ++i) {
+        if (!values.present.test(i)) continue;
+        data.actionQValues[QString::fromStdString(CerebrumLux::to_string(static_cast<CerebrumLux::AIAction>(i)))] = values.q_values[i];
     }
     return data;
 }
@@ -47,35 +48,48 @@ void QTableWorker::fetchQTableContent(const QString& filterText, const QString&
     try {
         LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: Q-Table içeriği çekme işlemi başlatıldı (Worker Thread). Filter: '" << filterText.toStdString() << "'");
 
-        const CerebrumLux::SwarmVectorDB::SparseQTable& q_table_ref = learningModule.getQTable();
+        // Değişmez snapshot: ana thread'deki update_q_values ile yarışmadan okunur.
+        const std::shared_ptr<const QValueSnapshot> snapshot = learningModule.getQValueIndex().snapshot();
 
-        if (q_table_ref.q_values.empty()) {
+        const bool can_send_delta = hasDeliveredSnapshot && filterText == lastFilterText &&
+                                    !snapshot->requires_full_refresh(lastSnapshotVersion);
+        if (can_send_delta) {
+            if (snapshot->version() == lastSnapshotVersion) return; // Değişiklik yok
+
+            QRegularExpression regex(filterText, QRegularExpression::CaseInsensitiveOption);
+            std::map<QString, QTableDisplayData> changed_details;
+            for (const auto& changed : snapshot->changed_since(lastSnapshotVersion)) {
+                QString stateKey = QString::fromStdString(changed.first);
+                if (filterText.isEmpty() || stateKey.contains(regex)) {
+                    changed_details[stateKey] = createDisplayData(changed.first, *changed.second);
+                }
+            }
+            lastSnapshotVersion = snapshot->version();
+            if (!changed_details.empty()) emit qTableDeltaFetched(changed_details);
+            LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: Q-Table delta gönderildi. Değişen durum: " << changed_details.size() << ", Sürüm: " << lastSnapshotVersion);
+            return;
+        }
+
+        lastSnapshotVersion = snapshot->version();
+        lastFilterText = filterText;
+        hasDeliveredSnapshot = true;
+
+        if (snapshot->size() == 0) {
             LOG_DEFAULT(LogLevel::WARNING, "QTableWorker: LearningModule'den alınan SparseQTable boş görünüyor. Q-Table'da hiç veri yok.");
             // Boş listeleri emit et ve erken çık
             emit qTableContentFetched({}, {}, currentSelectionStateKey);
             return; 
         }
-        // LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: SparseQTable'da bulunan toplam durum anahtarı sayısı: " << q_table_ref.q_values.size());
-
-        // YENİ EKLENDİ: all_q_state_keys oluşturulduktan sonra boyutunu logla
-        std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey> all_q_state_keys;
-        for (const auto& pair : q_table_ref.q_values) {
-            all_q_state_keys.push_back(pair.first);
-        }
 
+        std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey> all_q_state_keys = snapshot->keys();
         std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey> filtered_state_keys = filterStates(all_q_state_keys, filterText);
-        // YENİ EKLENDİ: filterStates sonrası boyutunu logla
-         // LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: Filtrelenmiş durum anahtarı sayısı: " << filtered_state_keys.size());
 
         std::map<QString, QTableDisplayData> displayed_details;
         for (const auto& state_key_std_str : filtered_state_keys) {
-            auto it = q_table_ref.q_values.find(state_key_std_str);
-            if (it != q_table_ref.q_values.end()) {
-                displayed_details[QString::fromStdString(state_key_std_str)] = createDisplayData(state_key_std_str, it->second);
+            if (const QValueIndex::StateValues* values = snapshot->find(state_key_std_str)) {
+                displayed_details[QString::fromStdString(state_key_std_str)] = createDisplayData(state_key_std_str, *values);
             }
         }
-        // YENİ EKLENDİ: displayed_details boyutu logla
-        // LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: Görüntülenmek üzere hazırlanan detaylı durum sayısı: " << displayed_details.size());
 
         emit qTableContentFetched(all_q_state_keys, displayed_details, currentSelectionStateKey);
         LOG_DEFAULT(LogLevel::DEBUG, "QTableWorker: Q-Table içeriği başarıyla çekildi (Worker Thread). Toplam filtrelenmiş: " << filtered_state_keys.size());
@@ -5,12 +5,14 @@
 #include <QString>
 #include <vector>
 #include <map>
+#include <cstdint>
 #include <QDate> // QDate için (Eğer worker'da filtreleme yapılıyorsa)
 #include <QSet> // QSet için (Eğer worker'da benzersiz konular toplanıyorsa)
 #include <chrono> // std::chrono::system_clock::time_point için (Eğer worker'da Capsule ile çalışılıyorsa)
 
 #include "../../core/logger.h"
 #include "../../learning/LearningModule.h"
+#include "../../learning/QValueIndex.h" // QValueSnapshot için
 #include "../../swarm_vectordb/DataModels.h" // SparseQTable ve EmbeddingStateKey için
 #include "../../core/enums.h" // AIAction için
 #include "../../core/utils.h" // action_to_string için
@@ -36,16 +38,24 @@ public slots:
     void fetchQTableContent(const QString& filterText, const QString& currentSelectionStateKey);
 
 signals:
+    // Tam yenileme: ilk çekim, filtre değişikliği veya Q-Table'ın yeniden yüklenmesi sonrası.
     void qTableContentFetched(const std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey>& all_q_state_keys,
                               const std::map<QString, QTableDisplayData>& displayed_q_table_details,
                               const QString& restoreSelectionStateKey);
+    // Artımlı yenileme: yalnızca son gönderilen snapshot'tan beri değişen (filtreye uyan) durumlar.
+    void qTableDeltaFetched(const std::map<QString, QTableDisplayData>& changed_q_table_details);
     void workerError(const QString& error_message);
 
 private:
     LearningModule& learningModule;
 
+    // Son gönderilen görünüm; bir sonraki çekimde delta sorgusu için kullanılır.
+    std::uint64_t lastSnapshotVersion = 0;
+    QString lastFilterText;
+    bool hasDeliveredSnapshot = false;
+
     QTableDisplayData createDisplayData(const CerebrumLux::SwarmVectorDB::EmbeddingStateKey& stateKey,
-                                        const std::map<CerebrumLux::AIAction, float>& actionQValues);
+                                        const QValueIndex::StateValues& values);
 
     std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey> filterStates(
         const std::vector<CerebrumLux::SwarmVectorDB::EmbeddingStateKey>& sourceStateKeys,
@@ -81,13 +81,13 @@ void TrainingHubPanel::setupUi() {
     // Broker'dan gelen mesajları GUI'de göster
     connect(m_tutorBroker, &TutorBroker::new_message_for_gui, this, [this](const Msg& msg){
         QString displayText = QString("<b>[%1]</b>: %2")
-            .arg(QString::fromStdString(msg.from))
-            .arg(QString::fromStdString(msg.payload.value("text", "")));
+            .arg(QString::fromUtf8(msg_actor_to_string(msg.from)))
+            .arg(QString::fromStdString(msg.text));
         
         m_tutorPanel->handleTrainingUpdate(displayText);
 
         // Hata mesajı varsa durumu güncelle
-        if (msg.type == "error") {
+        if (msg.type == MsgType::Error) {
             m_tutorPanel->handleTrainingFinished(); // Hata durumunda da durmuş gibi göster
         }
     });
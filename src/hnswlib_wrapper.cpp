@@ -75,41 +75,100 @@ bool HNSWIndex::save_index(const std::string& path) {
     }
 }
 
-void HNSWIndex::add_item(const std::vector<float>& features, hnswlib::labeltype label) {
+bool HNSWIndex::add_item(const std::vector<float>& features, hnswlib::labeltype label) {
     if (!app_alg_) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::add_item(): HNSW indeksi başlatılmamış. Eleman eklenemedi.");
-        return;
+        return false;
     }
     if (features.size() != dim_) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::add_item(): Vektör boyutu yanlis. Beklenen: " << dim_ << ", Gelen: " << features.size());
-        return;
+        return false;
+    }
+    try {
+        app_alg_->addPoint(features.data(), label);
+    } catch (const std::exception& e) {
+        // hnswlib kapasite dolduğunda istisna fırlatır; silinmiş yuvalar ancak sıkıştırma ile geri kazanılır.
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::add_item(): Eleman eklenemedi (Etiket: " << label << "): " << e.what());
+        return false;
     }
-    app_alg_->addPoint(features.data(), label);
     LOG_DEFAULT(LogLevel::TRACE, "HNSWIndex::add_item(): Eleman eklendi. Etiket: " << label << ", Index eleman sayisi: " << app_alg_->cur_element_count);
+    return true;
 }
 
-std::vector<hnswlib::labeltype> HNSWIndex::search_knn(const std::vector<float>& query, int k) const {
+std::vector<hnswlib::labeltype> HNSWIndex::search_knn(const std::vector<float>& query, int k, hnswlib::BaseFilterFunctor* filter) const {
     std::vector<hnswlib::labeltype> result_labels;
+    for (const ScoredLabel& hit : search_knn_scored(query, k, filter)) result_labels.push_back(hit.second);
+    return result_labels;
+}
+
+std::vector<HNSWIndex::ScoredLabel> HNSWIndex::search_knn_scored(const std::vector<float>& query, int k, hnswlib::BaseFilterFunctor* filter) const {
+    std::vector<ScoredLabel> results;
     if (!app_alg_) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::search_knn(): HNSW indeksi başlatılmamış. Arama yapilamadi.");
-        return result_labels;
+        return results;
     }
     if (query.size() != dim_) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::search_knn(): Sorgu vektör boyutu yanlis. Beklenen: " << dim_ << ", Gelen: " << query.size());
-        return result_labels;
+        return results;
     }
 
-    std::priority_queue<std::pair<float, hnswlib::labeltype>> result_pq = app_alg_->searchKnn(query.data(), k);
+    std::priority_queue<std::pair<float, hnswlib::labeltype>> result_pq = app_alg_->searchKnn(query.data(), k, filter);
 
+    results.reserve(result_pq.size());
     while (!result_pq.empty()) {
-        result_labels.push_back(result_pq.top().second);
+        results.push_back(result_pq.top());
         result_pq.pop();
     }
-    std::reverse(result_labels.begin(), result_labels.end()); // En yakından uzağa sırala
-    LOG_DEFAULT(LogLevel::TRACE, "HNSWIndex::search_knn(): Arama tamamlandi. Bulunan eleman sayisi: " << result_labels.size());
+    std::reverse(results.begin(), results.end()); // En yakından uzağa sırala
+    LOG_DEFAULT(LogLevel::TRACE, "HNSWIndex::search_knn(): Arama tamamlandi. Bulunan eleman sayisi: " << results.size());
+    return results;
+}
+
+std::vector<hnswlib::labeltype> HNSWIndex::search_exact(const std::vector<float>& query, const std::vector<hnswlib::labeltype>& candidates, int k) const {
+    std::vector<hnswlib::labeltype> result_labels;
+    for (const ScoredLabel& hit : search_exact_scored(query, candidates, k)) result_labels.push_back(hit.second);
     return result_labels;
 }
 
+std::vector<HNSWIndex::ScoredLabel> HNSWIndex::search_exact_scored(const std::vector<float>& query, const std::vector<hnswlib::labeltype>& candidates, int k) const {
+    std::vector<ScoredLabel> results;
+    if (!app_alg_ || k <= 0) return results;
+    if (query.size() != dim_) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::search_exact(): Sorgu vektör boyutu yanlis. Beklenen: " << dim_ << ", Gelen: " << query.size());
+        return results;
+    }
+
+    // L2Space ile aynı metrik (karesi alınmış L2); en büyük mesafe tepede kalan k boyutlu yığın.
+    std::priority_queue<ScoredLabel> top;
+    for (hnswlib::labeltype label : candidates) {
+        std::vector<float> data;
+        try {
+            data = app_alg_->getDataByLabel<float>(label);
+        } catch (const std::exception&) {
+            continue; // Silinmiş veya indekste olmayan etiket
+        }
+        if (data.size() != query.size()) continue;
+        float dist = 0.0f;
+        for (size_t i = 0; i < data.size(); ++i) {
+            const float diff = data[i] - query[i];
+            dist += diff * diff;
+        }
+        if (top.size() < static_cast<size_t>(k)) {
+            top.emplace(dist, label);
+        } else if (dist < top.top().first) {
+            top.pop();
+            top.emplace(dist, label);
+        }
+    }
+    results.reserve(top.size());
+    while (!top.empty()) {
+        results.push_back(top.top());
+        top.pop();
+    }
+    std::reverse(results.begin(), results.end()); // En yakından uzağa sırala
+    return results;
+}
+
 size_t HNSWIndex::get_current_elements() const {
     if (!app_alg_) {
         return 0;
@@ -117,13 +176,34 @@ size_t HNSWIndex::get_current_elements() const {
     return app_alg_->cur_element_count;
 }
 
-void HNSWIndex::mark_deleted(hnswlib::labeltype label) {
+size_t HNSWIndex::get_deleted_count() const {
+    if (!app_alg_) {
+        return 0;
+    }
+    return app_alg_->getDeletedCount();
+}
+
+size_t HNSWIndex::get_max_elements() const {
+    if (!app_alg_) {
+        return max_elements_;
+    }
+    return app_alg_->getMaxElements();
+}
+
+bool HNSWIndex::mark_deleted(hnswlib::labeltype label) {
     if (!app_alg_) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "HNSWIndex::mark_deleted(): HNSW indeksi başlatılmamış.");
-        return;
+        return false;
+    }
+    try {
+        app_alg_->markDelete(label);
+    } catch (const std::exception& e) {
+        // Etiket yoksa veya zaten silinmişse hnswlib istisna fırlatır.
+        LOG_DEFAULT(LogLevel::WARNING, "HNSWIndex::mark_deleted(): Etiket " << label << " silinemedi: " << e.what());
+        return false;
     }
-    app_alg_->markDelete(label);
     LOG_DEFAULT(LogLevel::TRACE, "HNSWIndex::mark_deleted(): Etiket " << label << " silindi olarak işaretlendi.");
+    return true;
 }
 
 } // namespace HNSW
@@ -7,6 +7,7 @@
 #include <hnswlib/hnswlib.h> // hnswlib kütüphanesini dahil et
 #include <algorithm> // std::copy için
 #include <queue> // std::priority_queue için
+#include <utility> // std::pair için
 
 namespace CerebrumLux {
 namespace HNSW {
@@ -19,10 +20,20 @@ public:
     bool load_index(const std::string& path);
     void create_new_index();
     bool save_index(const std::string& path);
-    void add_item(const std::vector<float>& features, hnswlib::labeltype label);
-    std::vector<hnswlib::labeltype> search_knn(const std::vector<float>& query, int k) const;
-    void mark_deleted(hnswlib::labeltype label); // YENİ: Öğeyi silindi olarak işaretlemek için
-    size_t get_current_elements() const;
+    bool add_item(const std::vector<float>& features, hnswlib::labeltype label); // Kapasite doluysa false döner
+    // filter verilirse yalnızca filtreyi geçen etiketler döner (hnswlib graf araması içinde uygulanır).
+    std::vector<hnswlib::labeltype> search_knn(const std::vector<float>& query, int k, hnswlib::BaseFilterFunctor* filter = nullptr) const;
+    // Verilen aday etiketler arasında kaba kuvvet (tam) L2 araması; çok seçici filtreler için graf aramasından hızlıdır.
+    std::vector<hnswlib::labeltype> search_exact(const std::vector<float>& query, const std::vector<hnswlib::labeltype>& candidates, int k) const;
+    // Mesafeli sürümler: (karesi alınmış L2 mesafe, etiket), yakından uzağa sıralı. Parçalı (sharded) aramada
+    // farklı indekslerin sonuçlarını birleştirmek için kullanılır.
+    using ScoredLabel = std::pair<float, hnswlib::labeltype>;
+    std::vector<ScoredLabel> search_knn_scored(const std::vector<float>& query, int k, hnswlib::BaseFilterFunctor* filter = nullptr) const;
+    std::vector<ScoredLabel> search_exact_scored(const std::vector<float>& query, const std::vector<hnswlib::labeltype>& candidates, int k) const;
+    bool mark_deleted(hnswlib::labeltype label); // YENİ: Öğeyi silindi olarak işaretlemek için
+    size_t get_current_elements() const; // Silinmiş işaretli yuvalar dahil
+    size_t get_deleted_count() const;
+    size_t get_max_elements() const;
     int get_dim() const { return dim_; } // YENİ: Dimension getter
 
 private:
@@ -0,0 +1,319 @@
+#include "CapsuleSync.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include "KnowledgeBase.h"
+#include "../core/logger.h" // LOG_DEFAULT için
+
+namespace CerebrumLux {
+
+namespace {
+
+using Hash = SwarmVectorDB::SwarmConsensusTree::Hash;
+
+Hash hash_from_hex(const std::string& hex) {
+    Hash hash{};
+    if (hex.size() != hash.size() * 2) throw std::invalid_argument("CapsuleSync: geçersiz hash uzunluğu");
+    auto nibble = [](char c) -> std::uint8_t {
+        if (c >= '0' && c <= '9') return static_cast<std::uint8_t>(c - '0');
+        if (c >= 'a' && c <= 'f') return static_cast<std::uint8_t>(c - 'a' + 10);
+        if (c >= 'A' && c <= 'F') return static_cast<std::uint8_t>(c - 'A' + 10);
+        throw std::invalid_argument("CapsuleSync: geçersiz hex karakteri");
+    };
+    for (std::size_t i = 0; i < hash.size(); ++i) {
+        hash[i] = static_cast<std::uint8_t>((nibble(hex[2 * i]) << 4) | nibble(hex[2 * i + 1]));
+    }
+    return hash;
+}
+
+const char* type_name(CapsuleSyncMessage::Type type) {
+    switch (type) {
+        case CapsuleSyncMessage::Type::NodeHashes:     return "node_hashes";
+        case CapsuleSyncMessage::Type::BucketDigests:  return "bucket_digests";
+        case CapsuleSyncMessage::Type::RangeRequest:   return "range_request";
+        case CapsuleSyncMessage::Type::CapsuleRequest: return "capsule_request";
+        case CapsuleSyncMessage::Type::CapsuleBatch:   return "capsule_batch";
+    }
+    return "unknown";
+}
+
+CapsuleSyncMessage::Type type_from_name(const std::string& name) {
+    static const std::map<std::string, CapsuleSyncMessage::Type> types = {
+        {"node_hashes", CapsuleSyncMessage::Type::NodeHashes},
+        {"bucket_digests", CapsuleSyncMessage::Type::BucketDigests},
+        {"range_request", CapsuleSyncMessage::Type::RangeRequest},
+        {"capsule_request", CapsuleSyncMessage::Type::CapsuleRequest},
+        {"capsule_batch", CapsuleSyncMessage::Type::CapsuleBatch},
+    };
+    auto it = types.find(name);
+    if (it == types.end()) throw std::invalid_argument("CapsuleSync: bilinmeyen mesaj tipi: " + name);
+    return it->second;
+}
+
+} // namespace
+
+// --- CapsuleSyncMessage ---
+
+nlohmann::json CapsuleSyncMessage::to_json() const {
+    using SwarmVectorDB::SwarmConsensusTree;
+    nlohmann::json j;
+    j["type"] = type_name(type);
+    switch (type) {
+        case Type::NodeHashes: {
+            j["level"] = level;
+            nlohmann::json nodes_json = nlohmann::json::array();
+            for (const Node& node : nodes) {
+                nodes_json.push_back({{"index", node.index}, {"hash", SwarmConsensusTree::to_hex(node.hash)}, {"count", node.count}});
+            }
+            j["nodes"] = std::move(nodes_json);
+            break;
+        }
+        case Type::BucketDigests: {
+            nlohmann::json buckets_json = nlohmann::json::array();
+            for (const Bucket& bucket : buckets) {
+                nlohmann::json entries = nlohmann::json::array();
+                for (const auto& entry : bucket.entries) entries.push_back({entry.first, SwarmConsensusTree::to_hex(entry.second)});
+                buckets_json.push_back({{"index", bucket.index}, {"entries", std::move(entries)}});
+            }
+            j["buckets"] = std::move(buckets_json);
+            break;
+        }
+        case Type::RangeRequest:
+            j["level"] = level;
+            j["ranges"] = ranges;
+            break;
+        case Type::CapsuleRequest:
+            j["ids"] = ids;
+            break;
+        case Type::CapsuleBatch:
+            j["capsules"] = capsules;
+            break;
+    }
+    return j;
+}
+
+CapsuleSyncMessage CapsuleSyncMessage::from_json(const nlohmann::json& j) {
+    CapsuleSyncMessage message;
+    message.type = type_from_name(j.at("type").get<std::string>());
+    switch (message.type) {
+        case Type::NodeHashes:
+            message.level = j.at("level").get<unsigned>();
+            for (const auto& node_json : j.at("nodes")) {
+                message.nodes.push_back({node_json.at("index").get<std::size_t>(),
+                                         hash_from_hex(node_json.at("hash").get<std::string>()),
+                                         node_json.at("count").get<std::size_t>()});
+            }
+            break;
+        case Type::BucketDigests:
+            for (const auto& bucket_json : j.at("buckets")) {
+                Bucket bucket;
+                bucket.index = bucket_json.at("index").get<std::size_t>();
+                for (const auto& entry : bucket_json.at("entries")) {
+                    bucket.entries.emplace_back(entry.at(0).get<std::string>(), hash_from_hex(entry.at(1).get<std::string>()));
+                }
+                message.buckets.push_back(std::move(bucket));
+            }
+            break;
+        case Type::RangeRequest:
+            message.level = j.at("level").get<unsigned>();
+            message.ranges = j.at("ranges").get<std::vector<std::size_t>>();
+            break;
+        case Type::CapsuleRequest:
+            message.ids = j.at("ids").get<std::vector<std::string>>();
+            break;
+        case Type::CapsuleBatch:
+            message.capsules = j.at("capsules").get<std::vector<Capsule>>();
+            break;
+    }
+    return message;
+}
+
+// --- CapsuleSyncPeer ---
+
+CapsuleSyncPeer::CapsuleSyncPeer(KnowledgeBase& kb) : kb_(kb) {}
+
+CapsuleSyncMessage CapsuleSyncPeer::start() const {
+    const auto& tree = kb_.capsule_tree();
+    CapsuleSyncMessage message;
+    message.type = CapsuleSyncMessage::Type::NodeHashes;
+    message.level = 0;
+    message.nodes.push_back({0, tree.subtree_hash(0, 0), tree.subtree_size(0, 0)});
+    return message;
+}
+
+std::vector<CapsuleSyncMessage> CapsuleSyncPeer::handle(const CapsuleSyncMessage& message) {
+    std::vector<CapsuleSyncMessage> out;
+    switch (message.type) {
+        case CapsuleSyncMessage::Type::NodeHashes:     handle_node_hashes(message, out); break;
+        case CapsuleSyncMessage::Type::BucketDigests:  handle_bucket_digests(message, out); break;
+        case CapsuleSyncMessage::Type::RangeRequest:   handle_range_request(message, out); break;
+        case CapsuleSyncMessage::Type::CapsuleRequest: handle_capsule_request(message, out); break;
+        case CapsuleSyncMessage::Type::CapsuleBatch:   handle_capsule_batch(message); break;
+    }
+    return out;
+}
+
+std::vector<std::string> CapsuleSyncPeer::ids_in_range(unsigned level, std::size_t index) const {
+    const auto& tree = kb_.capsule_tree();
+    std::vector<std::string> ids;
+    if (level > tree.depth()) return ids;
+    const unsigned shift = tree.depth() - level;
+    const std::size_t first = index << shift;
+    const std::size_t last = (index + 1) << shift;
+    for (std::size_t bucket = first; bucket < last; ++bucket) {
+        for (auto& entry : tree.bucket_entries(bucket)) ids.push_back(std::move(entry.first));
+    }
+    return ids;
+}
+
+void CapsuleSyncPeer::append_capsule_batches(const std::vector<std::string>& ids, std::vector<CapsuleSyncMessage>& out) {
+    CapsuleSyncMessage batch;
+    batch.type = CapsuleSyncMessage::Type::CapsuleBatch;
+    for (const std::string& id : ids) {
+        std::optional<Capsule> capsule = kb_.find_capsule_by_id(id);
+        if (!capsule) continue;
+        batch.capsules.push_back(std::move(*capsule));
+        if (batch.capsules.size() == kBatchSize) {
+            stats_.capsules_sent += batch.capsules.size();
+            out.push_back(std::move(batch));
+            batch = CapsuleSyncMessage{};
+            batch.type = CapsuleSyncMessage::Type::CapsuleBatch;
+        }
+    }
+    if (!batch.capsules.empty()) {
+        stats_.capsules_sent += batch.capsules.size();
+        out.push_back(std::move(batch));
+    }
+}
+
+void CapsuleSyncPeer::handle_node_hashes(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out) {
+    const auto& tree = kb_.capsule_tree();
+    const unsigned depth = tree.depth();
+    if (message.level > depth) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "CapsuleSync: Karşı tarafın ağaç seviyesi (" << message.level << ") yerel derinliği aşıyor.");
+        return;
+    }
+    const unsigned child_level = std::min(message.level + kDescendLevels, depth);
+
+    CapsuleSyncMessage descend;
+    descend.type = CapsuleSyncMessage::Type::NodeHashes;
+    descend.level = child_level;
+    CapsuleSyncMessage digests;
+    digests.type = CapsuleSyncMessage::Type::BucketDigests;
+    CapsuleSyncMessage range_request;
+    range_request.type = CapsuleSyncMessage::Type::RangeRequest;
+    range_request.level = message.level;
+    std::vector<std::string> push_ids;
+
+    for (const auto& node : message.nodes) {
+        if (node.index >= (std::size_t{1} << message.level)) continue;
+        const Hash local_hash = tree.subtree_hash(message.level, node.index);
+        if (local_hash == node.hash) continue;
+        const std::size_t local_count = tree.subtree_size(message.level, node.index);
+
+        if (local_count == 0) {
+            range_request.ranges.push_back(node.index); // Bu aralıkta hiçbir şeyimiz yok: hepsini iste
+        } else if (node.count == 0) {
+            const auto ids = ids_in_range(message.level, node.index); // Karşı tarafta yok: hepsini gönder
+            push_ids.insert(push_ids.end(), ids.begin(), ids.end());
+        } else if (message.level == depth) {
+            digests.buckets.push_back({node.index, tree.bucket_entries(node.index)});
+        } else {
+            const unsigned shift = child_level - message.level;
+            for (std::size_t child = node.index << shift; child < (node.index + 1) << shift; ++child) {
+                descend.nodes.push_back({child, tree.subtree_hash(child_level, child), tree.subtree_size(child_level, child)});
+            }
+        }
+    }
+
+    if (!descend.nodes.empty()) out.push_back(std::move(descend));
+    if (!digests.buckets.empty()) out.push_back(std::move(digests));
+    if (!range_request.ranges.empty()) out.push_back(std::move(range_request));
+    append_capsule_batches(push_ids, out);
+}
+
+void CapsuleSyncPeer::handle_bucket_digests(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out) {
+    const auto& tree = kb_.capsule_tree();
+    CapsuleSyncMessage request;
+    request.type = CapsuleSyncMessage::Type::CapsuleRequest;
+    std::vector<std::string> push_ids;
+
+    for (const auto& bucket : message.buckets) {
+        const auto local = tree.bucket_entries(bucket.index);
+        // Her iki liste de id'ye göre sıralı: birleştirerek karşılaştır.
+        auto remote_it = bucket.entries.begin();
+        auto local_it = local.begin();
+        while (remote_it != bucket.entries.end() || local_it != local.end()) {
+            if (local_it == local.end() || (remote_it != bucket.entries.end() && remote_it->first < local_it->first)) {
+                request.ids.push_back(remote_it->first);
+                ++remote_it;
+            } else if (remote_it == bucket.entries.end() || local_it->first < remote_it->first) {
+                push_ids.push_back(local_it->first);
+                ++local_it;
+            } else {
+                if (remote_it->second > local_it->second) request.ids.push_back(remote_it->first);
+                else if (local_it->second > remote_it->second) push_ids.push_back(local_it->first);
+                ++remote_it;
+                ++local_it;
+            }
+        }
+    }
+
+    if (!request.ids.empty()) out.push_back(std::move(request));
+    append_capsule_batches(push_ids, out);
+}
+
+void CapsuleSyncPeer::handle_range_request(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out) {
+    std::vector<std::string> ids;
+    for (std::size_t index : message.ranges) {
+        const auto range_ids = ids_in_range(message.level, index);
+        ids.insert(ids.end(), range_ids.begin(), range_ids.end());
+    }
+    append_capsule_batches(ids, out);
+}
+
+void CapsuleSyncPeer::handle_capsule_request(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out) {
+    append_capsule_batches(message.ids, out);
+}
+
+void CapsuleSyncPeer::handle_capsule_batch(const CapsuleSyncMessage& message) {
+    for (const Capsule& capsule : message.capsules) kb_.add_capsule(capsule);
+    stats_.capsules_received += message.capsules.size();
+    LOG_DEFAULT(LogLevel::DEBUG, "CapsuleSync: " << message.capsules.size() << " kapsül alındı.");
+}
+
+// --- LoopbackSyncTransport ---
+
+LoopbackSyncTransport::LoopbackSyncTransport(CapsuleSyncPeer& a, CapsuleSyncPeer& b) : a_(a), b_(b) {}
+
+void LoopbackSyncTransport::send(bool to_b, const CapsuleSyncMessage& message) {
+    Envelope envelope{to_b, message.to_json().dump()};
+    CapsuleSyncStats& sender = to_b ? a_.stats() : b_.stats();
+    ++sender.messages_sent;
+    sender.bytes_sent += envelope.payload.size();
+    queue_.push_back(std::move(envelope));
+}
+
+bool LoopbackSyncTransport::run(std::size_t max_messages) {
+    queue_.clear();
+    send(true, a_.start());
+    std::size_t delivered = 0;
+    while (!queue_.empty()) {
+        if (delivered++ >= max_messages) {
+            LOG_ERROR_CERR(LogLevel::WARNING, "CapsuleSync: Mesaj sınırı aşıldı (" << max_messages << "). Oturum yarıda kesildi.");
+            queue_.clear();
+            return false;
+        }
+        Envelope envelope = std::move(queue_.front());
+        queue_.pop_front();
+        CapsuleSyncPeer& receiver = envelope.to_b ? b_ : a_;
+        const CapsuleSyncMessage message = CapsuleSyncMessage::from_json(nlohmann::json::parse(envelope.payload));
+        for (const auto& reply : receiver.handle(message)) send(!envelope.to_b, reply);
+    }
+    LOG_DEFAULT(LogLevel::INFO, "CapsuleSync: Oturum tamamlandı. Teslim edilen mesaj: " << delivered);
+    return true;
+}
+
+} // namespace CerebrumLux
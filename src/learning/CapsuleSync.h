@@ -0,0 +1,126 @@
+#ifndef CAPSULE_SYNC_H
+#define CAPSULE_SYNC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Capsule.h"
+#include "../swarm_vectordb/ConsensusTree.h"
+
+namespace CerebrumLux {
+
+class KnowledgeBase;
+
+// İki KnowledgeBase arasında Merkle aralığı tabanlı kapsül senkronizasyonu (anti-entropy).
+//
+// Her iki taraf da KnowledgeBase::capsule_tree() ile aynı derinlikte bir SwarmConsensusTree tutar. Alt ağaçlar
+// kapsül ID özetlerinin aralıklarına karşılık gelir. Protokol:
+//
+//   NodeHashes     : "bu aralıklar için hash'lerim". Alıcı kendi hash'leriyle karşılaştırır; eşleşenler atlanır,
+//                    farklı olanlar için kDescendLevels seviye aşağıdaki çocuk hash'lerini geri gönderir.
+//                    Taraflardan biri aralıkta hiç kapsüle sahip değilse inmek yerine doğrudan aralığı
+//                    ister (RangeRequest) veya gönderir (CapsuleBatch).
+//   BucketDigests  : kova seviyesinde farklı çıkan kovaların (id, yaprak özeti) listesi. Alıcı eksik/farklı
+//                    kapsülleri ister (CapsuleRequest) ve karşı tarafta olmayanları gönderir (CapsuleBatch).
+//   RangeRequest   : bir aralıktaki tüm kapsülleri iste.
+//   CapsuleRequest : ID listesiyle kapsül iste.
+//   CapsuleBatch   : en fazla kBatchSize kapsül; alıcı add_capsule ile ekler.
+//
+// Aynı ID iki tarafta farklı içerikle varsa büyük yaprak özetine sahip sürüm kazanır. Bu kural keyfi ama
+// deterministiktir; iki taraf da aynı sonuca yakınsar (KnowledgeBase kapsül zaman damgasını saklamadığı için
+// son-yazan-kazanır uygulanamaz). Silmeler taşınmaz: bir tarafta karantinaya alınan kapsül diğer taraftan geri gelir.
+struct CapsuleSyncMessage {
+    enum class Type { NodeHashes, BucketDigests, RangeRequest, CapsuleRequest, CapsuleBatch };
+
+    struct Node {
+        std::size_t index = 0;
+        SwarmVectorDB::SwarmConsensusTree::Hash hash{};
+        std::size_t count = 0;
+    };
+    struct Bucket {
+        std::size_t index = 0;
+        std::vector<std::pair<std::string, SwarmVectorDB::SwarmConsensusTree::Hash>> entries;
+    };
+
+    Type type = Type::NodeHashes;
+    unsigned level = 0;                 // NodeHashes / RangeRequest
+    std::vector<Node> nodes;            // NodeHashes
+    std::vector<std::size_t> ranges;    // RangeRequest: level seviyesindeki düğüm indeksleri
+    std::vector<Bucket> buckets;        // BucketDigests
+    std::vector<std::string> ids;       // CapsuleRequest
+    std::vector<Capsule> capsules;      // CapsuleBatch
+
+    nlohmann::json to_json() const;
+    static CapsuleSyncMessage from_json(const nlohmann::json& j);
+};
+
+struct CapsuleSyncStats {
+    std::size_t messages_sent = 0;
+    std::size_t bytes_sent = 0;
+    std::size_t capsules_sent = 0;
+    std::size_t capsules_received = 0;
+};
+
+// Bir KnowledgeBase adına protokolü yürüten taraf. Durumsuzdur: her mesaj yalnızca yerel ağaca bakılarak yanıtlanır,
+// bu yüzden aynı peer birden fazla oturumda kullanılabilir.
+class CapsuleSyncPeer {
+public:
+    static constexpr unsigned kDescendLevels = 4; // Her turda 16'lık dallanma
+    static constexpr std::size_t kBatchSize = 64;
+
+    explicit CapsuleSyncPeer(KnowledgeBase& kb);
+
+    // Oturumu başlatan ilk mesaj (kök hash).
+    CapsuleSyncMessage start() const;
+    // Gelen mesajı işler ve karşı tarafa gönderilecek yanıtları döndürür.
+    std::vector<CapsuleSyncMessage> handle(const CapsuleSyncMessage& message);
+
+    const CapsuleSyncStats& stats() const { return stats_; }
+    CapsuleSyncStats& stats() { return stats_; }
+
+private:
+    void handle_node_hashes(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out);
+    void handle_bucket_digests(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out);
+    void handle_range_request(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out);
+    void handle_capsule_request(const CapsuleSyncMessage& message, std::vector<CapsuleSyncMessage>& out);
+    void handle_capsule_batch(const CapsuleSyncMessage& message);
+
+    // level/index aralığındaki yerel kapsül ID'leri.
+    std::vector<std::string> ids_in_range(unsigned level, std::size_t index) const;
+    void append_capsule_batches(const std::vector<std::string>& ids, std::vector<CapsuleSyncMessage>& out);
+
+    KnowledgeBase& kb_;
+    CapsuleSyncStats stats_;
+};
+
+// İki peer'i süreç içinde bağlayan taşıma katmanı. Mesajlar gerçek bir ağdaki gibi JSON olarak serileştirilip
+// karşı tarafın kuyruğuna konur; run() kuyruklar boşalana kadar mesajları iletir.
+class LoopbackSyncTransport {
+public:
+    LoopbackSyncTransport(CapsuleSyncPeer& a, CapsuleSyncPeer& b);
+
+    // a'dan başlayan bir anti-entropy oturumu yürütür. max_messages aşılırsa false döner.
+    bool run(std::size_t max_messages = 100000);
+
+private:
+    struct Envelope {
+        bool to_b;
+        std::string payload;
+    };
+
+    void send(bool to_b, const CapsuleSyncMessage& message);
+
+    CapsuleSyncPeer& a_;
+    CapsuleSyncPeer& b_;
+    std::deque<Envelope> queue_;
+};
+
+} // namespace CerebrumLux
+
+#endif // CAPSULE_SYNC_H
@@ -0,0 +1,181 @@
+#include "CapsuleTextIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace CerebrumLux {
+
+namespace {
+
+bool is_token_byte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c >= 0x80;
+}
+
+// Türkçe büyük harflerin UTF-8 küçük karşılıkları; diğer çok baytlı diziler olduğu gibi bırakılır.
+bool lower_turkish(const std::string& text, std::size_t i, std::string& out, std::size_t& consumed) {
+    if (i + 1 >= text.size()) return false;
+    const unsigned char a = static_cast<unsigned char>(text[i]);
+    const unsigned char b = static_cast<unsigned char>(text[i + 1]);
+    consumed = 2;
+    if (a == 0xC3 && (b == 0x87 || b == 0x96 || b == 0x9C)) { // Ç Ö Ü
+        out.push_back(static_cast<char>(0xC3));
+        out.push_back(static_cast<char>(b + 0x20));
+        return true;
+    }
+    if ((a == 0xC4 && b == 0x9E) || (a == 0xC5 && b == 0x9E)) { // Ğ Ş
+        out.push_back(static_cast<char>(a));
+        out.push_back(static_cast<char>(b + 1));
+        return true;
+    }
+    if (a == 0xC4 && b == 0xB0) { // İ
+        out.push_back('i');
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+std::vector<std::string> CapsuleTextIndex::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    auto flush = [&]() {
+        if (current.find_first_not_of('_') == std::string::npos) {
+            current.clear();
+            return;
+        }
+        if (current.find('_') != std::string::npos) {
+            std::size_t start = 0;
+            while (start < current.size()) {
+                std::size_t end = current.find('_', start);
+                if (end == std::string::npos) end = current.size();
+                if (end > start && end - start < current.size()) tokens.push_back(current.substr(start, end - start));
+                start = end + 1;
+            }
+        }
+        tokens.push_back(std::move(current));
+        current.clear();
+    };
+
+    for (std::size_t i = 0; i < text.size();) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        std::size_t consumed = 1;
+        if (c >= 0x80 && lower_turkish(text, i, current, consumed)) {
+            i += consumed;
+            continue;
+        }
+        if (is_token_byte(c)) {
+            current.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : static_cast<char>(c));
+        } else {
+            flush();
+        }
+        ++i;
+    }
+    flush();
+    return tokens;
+}
+
+void CapsuleTextIndex::add_or_update(const std::string& id, const std::string& text) {
+    const std::vector<std::string> tokens = tokenize(text);
+    std::unordered_map<std::string, std::uint32_t> tf;
+    for (const std::string& token : tokens) ++tf[token];
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto existing = id_to_doc_.find(id);
+    if (existing != id_to_doc_.end()) remove_locked(existing->second);
+
+    const DocId doc_id = next_doc_++;
+    Doc& doc = docs_[doc_id];
+    doc.id = id;
+    doc.length = static_cast<std::uint32_t>(tokens.size());
+    doc.terms.reserve(tf.size());
+    for (auto& entry : tf) {
+        postings_[entry.first][doc_id] = entry.second;
+        doc.terms.push_back(entry.first);
+    }
+    id_to_doc_[id] = doc_id;
+    total_length_ += doc.length;
+}
+
+bool CapsuleTextIndex::remove(const std::string& id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = id_to_doc_.find(id);
+    if (it == id_to_doc_.end()) return false;
+    remove_locked(it->second);
+    return true;
+}
+
+void CapsuleTextIndex::remove_locked(DocId doc_id) {
+    auto doc_it = docs_.find(doc_id);
+    if (doc_it == docs_.end()) return;
+    for (const std::string& term : doc_it->second.terms) {
+        auto posting = postings_.find(term);
+        if (posting == postings_.end()) continue;
+        posting->second.erase(doc_id);
+        if (posting->second.empty()) postings_.erase(posting);
+    }
+    total_length_ -= doc_it->second.length;
+    id_to_doc_.erase(doc_it->second.id);
+    docs_.erase(doc_it);
+}
+
+void CapsuleTextIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    postings_.clear();
+    docs_.clear();
+    id_to_doc_.clear();
+    total_length_ = 0;
+}
+
+std::vector<CapsuleTextIndex::Hit> CapsuleTextIndex::search(const std::string& query, std::size_t top_k) const {
+    std::vector<std::string> terms = tokenize(query);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+
+    std::vector<Hit> hits;
+    if (terms.empty() || top_k == 0) return hits;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (docs_.empty()) return hits;
+    const double n = static_cast<double>(docs_.size());
+    const double avgdl = std::max(1.0, static_cast<double>(total_length_) / n);
+
+    std::unordered_map<DocId, double> scores;
+    for (const std::string& term : terms) {
+        auto posting = postings_.find(term);
+        if (posting == postings_.end()) continue;
+        const double df = static_cast<double>(posting->second.size());
+        const double idf = std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+        for (const auto& entry : posting->second) {
+            const double tf = static_cast<double>(entry.second);
+            const double dl = static_cast<double>(docs_.at(entry.first).length);
+            scores[entry.first] += idf * (tf * (kK1 + 1.0)) / (tf + kK1 * (1.0 - kB + kB * dl / avgdl));
+        }
+    }
+
+    hits.reserve(scores.size());
+    for (const auto& entry : scores) {
+        if (entry.second > 0.0) hits.push_back({docs_.at(entry.first).id, entry.second});
+    }
+    auto by_score = [](const Hit& a, const Hit& b) { return a.score != b.score ? a.score > b.score : a.id < b.id; };
+    if (hits.size() > top_k) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(top_k), hits.end(), by_score);
+        hits.resize(top_k);
+    } else {
+        std::sort(hits.begin(), hits.end(), by_score);
+    }
+    return hits;
+}
+
+std::size_t CapsuleTextIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return docs_.size();
+}
+
+bool CapsuleTextIndex::contains(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id_to_doc_.count(id) > 0;
+}
+
+} // namespace CerebrumLux
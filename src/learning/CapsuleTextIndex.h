@@ -0,0 +1,64 @@
+#ifndef CAPSULE_TEXT_INDEX_H
+#define CAPSULE_TEXT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CerebrumLux {
+
+// Kapsül metinleri üzerinde artımlı güncellenen ters indeks ve BM25 puanlaması.
+//
+// HNSW anlamsal olarak yakın kapsülleri bulur ama hata kodu, tanımlayıcı, dosya adı gibi birebir terimleri
+// kaçırabilir; bu indeks KnowledgeBase::hybrid_search'te vektör sonuçlarıyla birleştirilir.
+// Her kapsül (id, metin) olarak eklenir; aynı ID tekrar eklenirse eski terimleri çıkarılıp yenileri yazılır.
+// Okumalar paylaşımlı, yazmalar özel kilit alır.
+class CapsuleTextIndex {
+public:
+    static constexpr double kK1 = 1.2;
+    static constexpr double kB = 0.75;
+
+    struct Hit {
+        std::string id;
+        double score = 0.0;
+    };
+
+    // Küçük harfe çevirir (ASCII + Türkçe büyük harfler) ve harf/rakam/'_' dışındaki karakterlerden böler.
+    // "mdb_put" gibi alt çizgili tanımlayıcılar hem bütün hem parça olarak döner.
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    void add_or_update(const std::string& id, const std::string& text);
+    bool remove(const std::string& id);
+    void clear();
+
+    // BM25 puanına göre azalan sırada en fazla top_k sonuç (puanı 0 olanlar dönmez).
+    std::vector<Hit> search(const std::string& query, std::size_t top_k) const;
+
+    std::size_t size() const;
+    bool contains(const std::string& id) const;
+
+private:
+    using DocId = std::uint32_t;
+    struct Doc {
+        std::string id;
+        std::uint32_t length = 0;
+        std::vector<std::string> terms; // Tekil terimler (silmede posting'leri bulmak için)
+    };
+
+    void remove_locked(DocId doc);
+
+    std::unordered_map<std::string, std::unordered_map<DocId, std::uint32_t>> postings_; // terim -> (belge -> tf)
+    std::unordered_map<DocId, Doc> docs_;
+    std::unordered_map<std::string, DocId> id_to_doc_;
+    DocId next_doc_ = 0;
+    std::uint64_t total_length_ = 0;
+    mutable std::shared_mutex mutex_;
+};
+
+} // namespace CerebrumLux
+
+#endif // CAPSULE_TEXT_INDEX_H
@@ -10,6 +10,7 @@
 #include <filesystem> // std::filesystem için eklendi
 #include <numeric> // std::iota için (embedding için)
 #include <iomanip> // std::setw için
+#include <unordered_map> // hybrid_search füzyon puanları için
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -76,7 +77,8 @@ SwarmVectorDB::CryptofigVector KnowledgeBase::convert_capsule_to_cryptofig_vecto
     );
 }
 
-Capsule KnowledgeBase::convert_cryptofig_vector_to_capsule(const SwarmVectorDB::CryptofigVector& cv) const {
+Capsule KnowledgeBase::convert_cryptofig_vector_to_capsule(const SwarmVectorDB::CryptofigVector& cv,
+                                                           const SwarmVectorDB::VectorAttributes* attributes) const {
     Capsule capsule;
     capsule.id = cv.id;
     capsule.topic = cv.topic;
@@ -110,9 +112,32 @@ Capsule KnowledgeBase::convert_cryptofig_vector_to_capsule(const SwarmVectorDB::
     capsule.trust_score = 1.0f;
     capsule.code_file_path = "";
 
+    // Kapsülle birlikte saklanan nitelikler (kaynak, güven, zaman) varsa geri yükle.
+    std::optional<SwarmVectorDB::VectorAttributes> read_attributes;
+    if (!attributes) {
+        read_attributes = m_swarm_db.get_vector_attributes(cv.id);
+        if (read_attributes) attributes = &*read_attributes;
+    }
+    if (attributes) {
+        if (!attributes->source.empty()) capsule.source = attributes->source;
+        capsule.trust_score = attributes->trust_score;
+        if (attributes->timestamp_ms != 0) {
+            capsule.timestamp_utc = std::chrono::system_clock::time_point(std::chrono::milliseconds(attributes->timestamp_ms));
+        }
+    }
+
     return capsule;
 }
 
+SwarmVectorDB::VectorAttributes KnowledgeBase::capsule_attributes(const Capsule& capsule) {
+    SwarmVectorDB::VectorAttributes attributes;
+    attributes.topic = capsule.topic;
+    attributes.source = capsule.source;
+    attributes.trust_score = capsule.trust_score;
+    attributes.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(capsule.timestamp_utc.time_since_epoch()).count();
+    return attributes;
+}
+
 // --- KnowledgeBase Implementasyonu ---
 
 KnowledgeBase::KnowledgeBase() 
@@ -156,16 +181,74 @@ void KnowledgeBase::add_capsule(const Capsule& capsule) {
     }
     SwarmVectorDB::CryptofigVector cv = convert_capsule_to_cryptofig_vector(corrected_capsule);
     
-    bool vec_ok = m_swarm_db.store_vector(cv);
+    bool vec_ok = m_swarm_db.store_vector(cv, capsule_attributes(corrected_capsule));
     bool content_ok = m_swarm_db.store_capsule_content(capsule.id, capsule.content);
 
     if (vec_ok && content_ok) {
+        {
+            std::lock_guard<std::mutex> lock(m_capsule_tree_mutex);
+            if (m_capsule_tree_built) m_capsule_tree.set_leaf(cv.id, capsule_digest(cv, capsule.content));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_text_index_mutex);
+            if (m_text_index_built) m_text_index.add_or_update(cv.id, indexed_text(cv.id, cv.topic, capsule.content));
+        }
          LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül ve içerik başarıyla eklendi. ID: " << capsule.id);
     } else {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Kapsül tam olarak eklenemedi (Vec: " << vec_ok << ", Cont: " << content_ok << "). ID: " << capsule.id);
     }
 }
 
+std::size_t KnowledgeBase::add_capsules_batch(const std::vector<Capsule>& capsules) {
+    if (capsules.empty()) return 0;
+
+    std::vector<SwarmVectorDB::CryptofigVector> cryptofig_vectors;
+    std::vector<std::string> contents;
+    std::vector<SwarmVectorDB::VectorAttributes> attributes;
+    cryptofig_vectors.reserve(capsules.size());
+    contents.reserve(capsules.size());
+    attributes.reserve(capsules.size());
+    for (const Capsule& capsule : capsules) {
+        // add_capsule ile aynı kendi kendini iyileştirme: embedding boyutu düzeltilir.
+        if (capsule.embedding.size() != CerebrumLux::CryptofigAutoencoder::INPUT_DIM) {
+            Capsule corrected_capsule = capsule;
+            corrected_capsule.embedding.resize(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.0f);
+            cryptofig_vectors.push_back(convert_capsule_to_cryptofig_vector(corrected_capsule));
+        } else {
+            cryptofig_vectors.push_back(convert_capsule_to_cryptofig_vector(capsule));
+        }
+        contents.push_back(capsule.content);
+        attributes.push_back(capsule_attributes(capsule));
+    }
+
+    if (!m_swarm_db.store_vectors_batch(cryptofig_vectors, contents, attributes)) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Kapsül grubu eklenemedi. Kapsül sayısı: " << capsules.size());
+        return 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_capsule_tree_mutex);
+        if (m_capsule_tree_built) {
+            std::vector<std::pair<std::string, SwarmVectorDB::SwarmConsensusTree::Hash>> leaves;
+            leaves.reserve(cryptofig_vectors.size());
+            for (std::size_t i = 0; i < cryptofig_vectors.size(); ++i) {
+                leaves.emplace_back(cryptofig_vectors[i].id, capsule_digest(cryptofig_vectors[i], contents[i]));
+            }
+            m_capsule_tree.set_leaves(leaves);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_text_index_mutex);
+        if (m_text_index_built) {
+            for (std::size_t i = 0; i < cryptofig_vectors.size(); ++i) {
+                m_text_index.add_or_update(cryptofig_vectors[i].id, indexed_text(cryptofig_vectors[i].id, cryptofig_vectors[i].topic, contents[i]));
+            }
+        }
+    }
+    LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase: " << capsules.size() << " kapsül tek transaction'da eklendi.");
+    return capsules.size();
+}
+
 std::vector<Capsule> KnowledgeBase::semantic_search(const std::vector<float>& query_embedding, int top_k) const {
     LOG_DEFAULT(LogLevel::TRACE, "KnowledgeBase: Semantic search initiated with embedding. Top K: " << top_k);
     std::vector<Capsule> results;
@@ -191,6 +274,104 @@ std::vector<Capsule> KnowledgeBase::semantic_search(const std::vector<float>& qu
     return results;
 }
 
+std::vector<Capsule> KnowledgeBase::semantic_search_filtered(const std::vector<float>& query_embedding,
+                                                            const SwarmVectorDB::VectorFilter& filter, int top_k) const {
+    std::vector<Capsule> results;
+    if (!m_swarm_db.is_open() || query_embedding.empty()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Filtreli arama yapilamadi (DB kapalı veya boş sorgu).");
+        return results;
+    }
+    // Sonuç vektörleri ve nitelikleri tek okuma transaction'ında alınır.
+    std::vector<SwarmVectorDB::VectorAttributes> attributes;
+    const auto cryptofig_vectors = m_swarm_db.get_vectors_batch(
+        m_swarm_db.search_similar_vectors_filtered(query_embedding, top_k, filter), &attributes);
+    for (std::size_t i = 0; i < cryptofig_vectors.size(); ++i) {
+        results.push_back(convert_cryptofig_vector_to_capsule(*cryptofig_vectors[i], &attributes[i]));
+    }
+    LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase: Filtreli anlamsal arama " << results.size() << " sonuç döndürdü.");
+    return results;
+}
+
+std::string KnowledgeBase::indexed_text(const std::string& id, const std::string& topic, const std::string& content) {
+    std::string text;
+    text.reserve(id.size() + topic.size() + content.size() + 2);
+    text += id;
+    text += ' ';
+    text += topic;
+    text += ' ';
+    text += content;
+    return text;
+}
+
+const CapsuleTextIndex& KnowledgeBase::text_index() const {
+    std::lock_guard<std::mutex> lock(m_text_index_mutex);
+    if (!m_text_index_built) {
+        if (m_swarm_db.is_open()) {
+            const std::size_t indexed = for_each_capsule([this](const Capsule& capsule) {
+                m_text_index.add_or_update(capsule.id, indexed_text(capsule.id, capsule.topic, capsule.content));
+                return true;
+            });
+            LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül ters indeksi kuruldu. Kapsül sayısı: " << indexed);
+        }
+        m_text_index_built = true;
+    }
+    return m_text_index;
+}
+
+std::vector<Capsule> KnowledgeBase::keyword_search(const std::string& query, int top_k) const {
+    std::vector<Capsule> results;
+    if (top_k <= 0) return results;
+    for (const CapsuleTextIndex::Hit& hit : text_index().search(query, static_cast<std::size_t>(top_k))) {
+        std::optional<Capsule> capsule_opt = find_capsule_by_id(hit.id);
+        if (capsule_opt) results.push_back(std::move(*capsule_opt));
+    }
+    LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase: Anahtar kelime araması " << results.size() << " sonuç döndürdü. Sorgu: '" << query << "'");
+    return results;
+}
+
+std::vector<HybridSearchHit> KnowledgeBase::hybrid_search(const std::string& query_text, const std::vector<float>& query_embedding,
+                                                          const HybridSearchOptions& options) const {
+    std::vector<HybridSearchHit> results;
+    if (options.top_k <= 0) return results;
+    const int candidates = std::max(options.top_k, options.candidate_k);
+
+    // ID -> füzyon puanı; sıra 1 tabanlıdır.
+    std::unordered_map<std::string, double> fused;
+    std::vector<std::string> order; // Eşit puanda ilk görülen önde kalsın diye
+    auto add_ranked = [&](const std::vector<std::string>& ids, double weight) {
+        for (std::size_t rank = 0; rank < ids.size(); ++rank) {
+            auto inserted = fused.emplace(ids[rank], 0.0);
+            if (inserted.second) order.push_back(ids[rank]);
+            inserted.first->second += weight / (options.rrf_k + static_cast<double>(rank + 1));
+        }
+    };
+
+    if (!query_text.empty()) {
+        std::vector<std::string> keyword_ids;
+        for (const CapsuleTextIndex::Hit& hit : text_index().search(query_text, static_cast<std::size_t>(candidates))) {
+            keyword_ids.push_back(hit.id);
+        }
+        add_ranked(keyword_ids, options.keyword_weight);
+    }
+    if (!query_embedding.empty() && m_swarm_db.is_open()) {
+        add_ranked(m_swarm_db.search_similar_vectors(query_embedding, candidates), options.vector_weight);
+    }
+
+    std::vector<std::size_t> positions(order.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) positions[i] = i;
+    std::stable_sort(positions.begin(), positions.end(), [&](std::size_t a, std::size_t b) {
+        return fused[order[a]] > fused[order[b]];
+    });
+
+    for (std::size_t position : positions) {
+        if (results.size() >= static_cast<std::size_t>(options.top_k)) break;
+        std::optional<Capsule> capsule_opt = find_capsule_by_id(order[position]);
+        if (capsule_opt) results.push_back({std::move(*capsule_opt), fused[order[position]]});
+    }
+    LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase: Hibrit arama " << results.size() << " sonuç döndürdü (aday: " << fused.size() << "). Sorgu: '" << query_text << "'");
+    return results;
+}
+
 std::vector<Capsule> KnowledgeBase::search_by_topic(const std::vector<float>& topic_embedding, int top_k) const {
     LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase: Topic embedding ile arama yapılıyor. Top K: " << top_k);
     return semantic_search(topic_embedding, top_k); // Doğrudan embedding ile arama
@@ -206,9 +387,17 @@ std::optional<Capsule> KnowledgeBase::find_capsule_by_id(const std::string& id)
     return std::nullopt;
 }
 
-void KnowledgeBase::quarantine_capsule(const std::string& id) {
+void KnowledgeBase::quarantine_capsule(const std::string& id, const std::string& reason) {
     LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül karantinaya alınıyor. ID: " << id); 
-    if (m_swarm_db.delete_vector(id)) {
+    if (m_swarm_db.quarantine_vector(id, reason)) {
+        {
+            std::lock_guard<std::mutex> lock(m_capsule_tree_mutex);
+            if (m_capsule_tree_built) m_capsule_tree.remove(id);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_text_index_mutex);
+            if (m_text_index_built) m_text_index.remove(id);
+        }
         LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül karantinaya alındı. ID: " << id); 
     } else { 
         LOG_DEFAULT(LogLevel::WARNING, "KnowledgeBase: Karantinaya alınacak ID '" << id << "' ile kapsül bulunamadı.");
@@ -217,17 +406,40 @@ void KnowledgeBase::quarantine_capsule(const std::string& id) {
 
 void KnowledgeBase::revert_capsule(const std::string& id) {
     LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül karantinadan geri alınıyor. ID: " << id);
-    LOG_DEFAULT(LogLevel::WARNING, "KnowledgeBase::revert_capsule(): Metot henüz tam olarak uygulanmadi. ID: " << id << ".");
-    // TODO: Karantinaya alınan kapsüller için ayrı bir LMDB DBI veya flag mekanizması entegre edildiğinde bu metot güncellenecek.
+    if (!m_swarm_db.restore_vector(id)) {
+        LOG_DEFAULT(LogLevel::WARNING, "KnowledgeBase: Karantinadan geri alınacak ID '" << id << "' ile kapsül bulunamadı.");
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_capsule_tree_mutex);
+        if (m_capsule_tree_built) {
+            std::unique_ptr<SwarmVectorDB::CryptofigVector> cv = m_swarm_db.get_vector(id);
+            if (cv) m_capsule_tree.set_leaf(id, capsule_digest(*cv, m_swarm_db.get_capsule_content(id).value_or("")));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_text_index_mutex);
+        if (m_text_index_built) {
+            std::unique_ptr<SwarmVectorDB::CryptofigVector> cv = m_swarm_db.get_vector(id);
+            if (cv) m_text_index.add_or_update(id, indexed_text(id, cv->topic, m_swarm_db.get_capsule_content(id).value_or("")));
+        }
+    }
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül karantinadan geri alındı. ID: " << id);
+}
+
+bool KnowledgeBase::purge_quarantined_capsule(const std::string& id) {
+    const bool purged = m_swarm_db.purge_quarantined(id);
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Karantinadaki kapsül kalıcı olarak silme " << (purged ? "başarılı" : "başarısız") << ". ID: " << id);
+    return purged;
+}
+
+std::vector<SwarmVectorDB::QuarantineEntry> KnowledgeBase::get_quarantined_capsules() const {
+    return m_swarm_db.list_quarantined();
 }
 
 void KnowledgeBase::export_to_json(const std::string& filename) const {
     LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase::export_to_json(): Bilgi tabanı JSON olarak dışa aktarılıyor.");
 
-    nlohmann::json j;
-    std::vector<Capsule> all_active_capsules = get_all_capsules(); 
-    j["active_capsules"] = all_active_capsules;
-
     // Düzeltme: Dosya yolunu, çalıştırılabilir dosyanın konumuna göre belirle.
     // Bu, uygulamanın 'build' klasöründen çalıştırıldığında bile doğru 'data' klasörünü bulmasını sağlar.
     std::filesystem::path app_dir = get_application_directory();
@@ -235,13 +447,26 @@ void KnowledgeBase::export_to_json(const std::string& filename) const {
     std::filesystem::path file_path = data_dir / filename;
     LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "KnowledgeBase: Kaydedilmeye calisilan tam dosya yolu (JSON Export): " << file_path.string());
 
-    std::ofstream o(file_path);
-    if (o.is_open()) {
-        o << std::setw(4) << j << std::endl;
-        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: Bilgi tabanı JSON olarak başarıyla dışa aktarıldı: " << file_path.string());
-    } else {
+    // Kapsüller akış halinde geçici dosyaya yazılır ve tamamlanınca yerine taşınır; yarıda kalan bir dışa aktarma
+    // mevcut dosyayı bozmaz.
+    std::filesystem::path tmp_path = file_path;
+    tmp_path += ".tmp";
+    std::ofstream o(tmp_path);
+    if (!o.is_open()) {
         LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "KnowledgeBase: Bilgi tabanı JSON'a dışa aktarılamadı (dosya açılamadı): " << file_path.string());
+        return;
+    }
+    const bool written = export_json_stream(o);
+    o.close();
+
+    std::error_code ec;
+    if (written) std::filesystem::rename(tmp_path, file_path, ec);
+    if (!written || ec) {
+        std::filesystem::remove(tmp_path, ec);
+        LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "KnowledgeBase: Bilgi tabanı JSON'a dışa aktarılamadı (yazma hatası): " << file_path.string());
+        return;
     }
+    LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: Bilgi tabanı JSON olarak başarıyla dışa aktarıldı: " << file_path.string());
 }
 
 void KnowledgeBase::import_from_json(const std::string& filename) {
@@ -259,50 +484,118 @@ void KnowledgeBase::import_from_json(const std::string& filename) {
     }
 
     std::ifstream i(file_path);
-    if (i.is_open()) {
-        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "KnowledgeBase: JSON dosya var: " << file_path.string());
-        try {
-            nlohmann::json j;
-            i >> j;
-            if (j.contains("active_capsules") && j["active_capsules"].is_array()) {
-                bool needs_rewrite = false;
-                std::vector<CerebrumLux::Capsule> imported_capsules; // Kapsülleri buraya topla
-
-                for (const auto& json_capsule : j["active_capsules"]) {
-                    // JSON'da yeni eklenen alanların olup olmadığını kontrol et
-                    if (!json_capsule.contains("trust_score")) {
-                        needs_rewrite = true;
-                    }
-                    if (!json_capsule.contains("timestamp_utc")) {
-                        needs_rewrite = true;
-                    }
-
-                    CerebrumLux::Capsule capsule = json_capsule.get<CerebrumLux::Capsule>();
-                    imported_capsules.push_back(capsule);
-                }
-
-                // Tüm kapsüller başarıyla yüklendikten sonra topluca ekle
-                for (const auto& capsule : imported_capsules) {
-                    add_capsule(capsule);
-                }
-                
-                LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: JSON dosyasindan kapsüller başarıyla içe aktarıldı: " << file_path.string());
-
-                if (needs_rewrite) {
-                    LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: Eski formatta JSON dosyası algılandı. Yeni formata güncelleniyor: " << file_path.string());
-                    export_to_json(filename); // Dosyayı yeni formata yeniden yaz
-                }
-            } else {
-                LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "KnowledgeBase: JSON dosyasinda 'active_capsules' dizisi bulunamadı veya geçersiz. İçe aktarma atlandı.");
-            }
-        } catch (const nlohmann::json::exception& e) {
-            LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "KnowledgeBase: JSON ayrıştırma hatası: " << e.what() << ". İçe aktarma başarısız.");
-        } catch (const std::exception& e) {
-            LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "KnowledgeBase: Bilgi tabanı yükleme sırasında genel hata: " << e.what() << ". İçe aktarma başarısız.");
+    if (!i.is_open()) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "KnowledgeBase: JSON dosya acilamadi: " << file_path.string() << ". Dosya var ancak acilamiyor (izin veya kilit sorunu olabilir). İçe aktarma atlandı.");
+        return;
+    }
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "KnowledgeBase: JSON dosya var: " << file_path.string());
+
+    const CapsuleImportStats stats = import_json_stream(i);
+    i.close();
+
+    if (!stats.ok) {
+        // Akış halinde okunduğu için hatadan önce ayrıştırılan kapsüller depolanmış olur.
+        LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "KnowledgeBase: JSON ayrıştırma hatası: " << stats.error << ". Hataya kadar " << stats.stored << " kapsül içe aktarıldı.");
+    } else if (!stats.found_capsules) {
+        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "KnowledgeBase: JSON dosyasinda 'active_capsules' dizisi bulunamadı veya geçersiz. İçe aktarma atlandı.");
+    } else {
+        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: JSON dosyasindan " << stats.stored << " kapsül başarıyla içe aktarıldı: " << file_path.string());
+        if (stats.legacy_format) {
+            LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "KnowledgeBase: Eski formatta JSON dosyası algılandı. Yeni formata güncelleniyor: " << file_path.string());
+            export_to_json(filename); // Dosyayı yeni formata yeniden yaz
         }
+    }
+}
+
+bool KnowledgeBase::export_json_stream(std::ostream& out) const {
+    CapsuleJsonWriter writer(out);
+    for_each_capsule([&writer, &out](const Capsule& capsule) {
+        writer.write(capsule);
+        return static_cast<bool>(out);
+    });
+    const bool ok = writer.finish();
+    LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase::export_json_stream(): " << writer.count() << " kapsül yazıldı.");
+    return ok;
+}
+
+CapsuleImportStats KnowledgeBase::import_json_stream(std::istream& in, const CapsuleImportOptions& options) {
+    CapsuleImportPipeline pipeline(*this, options);
+    return pipeline.run_json(in);
+}
+
+bool KnowledgeBase::export_snapshot(const std::string& path) const {
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary);
+    if (!out.is_open()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Snapshot dosyası açılamadı: " << tmp_path);
+        return false;
+    }
+
+    CapsuleSnapshot::Writer writer(out);
+    for_each_capsule([&writer, &out](const Capsule& capsule) {
+        writer.write(capsule);
+        return static_cast<bool>(out);
+    });
+    bool ok = writer.finish();
+    out.close();
+    ok = ok && !out.fail();
+
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tmp_path, path, ec);
+    if (!ok || ec) {
+        std::filesystem::remove(tmp_path, ec);
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Snapshot yazılamadı: " << path);
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: " << writer.count() << " kapsül snapshot'a yazıldı: " << path);
+    return true;
+}
+
+CapsuleImportStats KnowledgeBase::import_snapshot(const std::string& path, const CapsuleImportOptions& options) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        CapsuleImportStats stats;
+        stats.error = "Snapshot dosyası açılamadı: " + path;
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: " << stats.error);
+        return stats;
+    }
+    CapsuleImportPipeline pipeline(*this, options);
+    CapsuleImportStats stats = pipeline.run_snapshot(in);
+    if (!stats.ok) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase: Snapshot geri yükleme hatası: " << stats.error << ". " << stats.stored << " kapsül geri yüklendi.");
     } else {
-        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "KnowledgeBase: JSON dosya acilamadi: " << file_path.string() << ". Dosya var ancak acilamiyor (izin veya kilit sorunu olabilir). İçe aktarma atlandı.");
+        LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Snapshot'tan " << stats.stored << " kapsül geri yüklendi: " << path);
     }
+    return stats;
+}
+
+SwarmVectorDB::SwarmConsensusTree::Hash KnowledgeBase::capsule_digest(const SwarmVectorDB::CryptofigVector& cv, const std::string& content) {
+    std::string bytes(1, '\0'); // Yaprak öneki (SwarmConsensusTree::leaf_hash ile aynı)
+    bytes += SwarmVectorDB::SwarmConsensusTree::canonical_encoding(cv);
+    const std::uint32_t content_size = static_cast<std::uint32_t>(content.size());
+    for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<char>((content_size >> (8 * i)) & 0xFF));
+    bytes += content;
+    return SwarmVectorDB::SwarmConsensusTree::hash_bytes(bytes);
+}
+
+const SwarmVectorDB::SwarmConsensusTree& KnowledgeBase::capsule_tree() const {
+    std::lock_guard<std::mutex> lock(m_capsule_tree_mutex);
+    if (!m_capsule_tree_built) {
+        if (m_swarm_db.is_open()) {
+            const std::vector<std::string> all_ids = m_swarm_db.get_all_ids();
+            auto cryptofig_vectors = m_swarm_db.get_vectors_batch(all_ids);
+            std::vector<std::pair<std::string, SwarmVectorDB::SwarmConsensusTree::Hash>> leaves;
+            leaves.reserve(cryptofig_vectors.size());
+            for (const auto& cv : cryptofig_vectors) {
+                if (!cv) continue;
+                leaves.emplace_back(cv->id, capsule_digest(*cv, m_swarm_db.get_capsule_content(cv->id).value_or("")));
+            }
+            m_capsule_tree.set_leaves(leaves);
+            LOG_DEFAULT(LogLevel::INFO, "KnowledgeBase: Kapsül Merkle ağacı kuruldu. Kapsül sayısı: " << leaves.size());
+        }
+        m_capsule_tree_built = true;
+    }
+    return m_capsule_tree;
 }
 
 std::vector<Capsule> KnowledgeBase::get_all_capsules() const {
@@ -317,16 +610,38 @@ std::vector<Capsule> KnowledgeBase::get_all_capsules() const {
     std::vector<std::string> all_ids = m_swarm_db.get_all_ids();
 
     // DÜZELTME: Tek tek okumak yerine toplu okuma (Batch Read) kullanılıyor
-    auto cryptofig_vectors = m_swarm_db.get_vectors_batch(all_ids);
+    std::vector<SwarmVectorDB::VectorAttributes> attributes;
+    auto cryptofig_vectors = m_swarm_db.get_vectors_batch(all_ids, &attributes);
 
-    for (const auto& cv : cryptofig_vectors) {
-        if (cv) {
-            all_capsules.push_back(convert_cryptofig_vector_to_capsule(*cv));
-        }
+    for (std::size_t i = 0; i < cryptofig_vectors.size(); ++i) {
+        all_capsules.push_back(convert_cryptofig_vector_to_capsule(*cryptofig_vectors[i], &attributes[i]));
     }
 
     LOG_DEFAULT(LogLevel::DEBUG, "KnowledgeBase::get_all_capsules(): Toplam " << all_capsules.size() << " kapsül LMDB'den alındı.");
     return all_capsules;
 }
 
+std::size_t KnowledgeBase::for_each_capsule(const std::function<bool(const Capsule&)>& visitor, std::size_t chunk_size) const {
+    if (!m_swarm_db.is_open()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeBase::for_each_capsule(): SwarmVectorDB acik degil. Kapsuller getirilemedi.");
+        return 0;
+    }
+
+    // Yalnızca ID listesi tamamen bellekte tutulur; vektörler ve içerikler grup grup okunur.
+    const std::vector<std::string> all_ids = m_swarm_db.get_all_ids();
+    chunk_size = std::max<std::size_t>(1, chunk_size);
+    std::size_t visited = 0;
+    for (std::size_t begin = 0; begin < all_ids.size(); begin += chunk_size) {
+        const std::size_t end = std::min(all_ids.size(), begin + chunk_size);
+        const std::vector<std::string> chunk_ids(all_ids.begin() + begin, all_ids.begin() + end);
+        std::vector<SwarmVectorDB::VectorAttributes> attributes;
+        const auto cryptofig_vectors = m_swarm_db.get_vectors_batch(chunk_ids, &attributes);
+        for (std::size_t i = 0; i < cryptofig_vectors.size(); ++i) {
+            ++visited;
+            if (!visitor(convert_cryptofig_vector_to_capsule(*cryptofig_vectors[i], &attributes[i]))) return visited;
+        }
+    }
+    return visited;
+}
+
 } // namespace CerebrumLux
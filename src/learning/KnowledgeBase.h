@@ -4,8 +4,14 @@
 #include <string>
 #include <vector>
 #include <optional>     // std::optional için
+#include <functional>   // for_each_capsule için
+#include <istream>
+#include <ostream>
+#include <mutex>        // capsule_tree_ kurulumu için
 #include <nlohmann/json.hpp> // JSON serileştirme için
 #include "Capsule.h"    // CerebrumLux::Capsule struct'ı için
+#include "KnowledgeStream.h" // Akış tabanlı içe/dışa aktarma ve snapshot için
+#include "CapsuleTextIndex.h" // BM25 anahtar kelime araması için
 
 // SwarmVectorDB entegrasyonu için gerekli başlıklar
 #include "../swarm_vectordb/VectorDB.h"    // CerebrumLux::SwarmVectorDB::SwarmVectorDB sınıfı için
@@ -14,6 +20,20 @@
 
 namespace CerebrumLux {
 
+struct HybridSearchOptions {
+    int top_k = 6;
+    int candidate_k = 20;         // Her aramadan (BM25 ve HNSW) füzyona alınan aday sayısı
+    double rrf_k = 60.0;          // Reciprocal-rank fusion sabiti: puan = sum(w / (rrf_k + sıra))
+    double keyword_weight = 1.0;
+    double vector_weight = 1.0;
+};
+
+// hybrid_search sonucu: kapsül depodaki haliyle (güven puanı dahil) döner, füzyon puanı ayrı taşınır.
+struct HybridSearchHit {
+    Capsule capsule;
+    double fusion_score = 0.0; // RRF puanı; yalnızca aynı sorgunun sonuçları arasında karşılaştırılabilir
+};
+
 class KnowledgeBase {
 public:
     // Kurucular ve Yıkıcı
@@ -28,27 +48,71 @@ public:
 
     // Kapsül Yönetim Metodları
     void add_capsule(const Capsule& capsule); 
+    // Kapsülleri tek bir LMDB yazma transaction'ında ekler; depolanan kapsül sayısını döndürür (hata halinde 0).
+    std::size_t add_capsules_batch(const std::vector<Capsule>& capsules);
     std::optional<Capsule> find_capsule_by_id(const std::string& id) const;
-    void quarantine_capsule(const std::string& id);
+    // Karantinaya alınan kapsül aktif depodan ve aramalardan çıkar ama ayrı bir LMDB DBI'da saklanır;
+    // revert_capsule ile geri alınabilir, purge_quarantined_capsule ile kalıcı olarak silinir.
+    void quarantine_capsule(const std::string& id, const std::string& reason = "");
     void revert_capsule(const std::string& id);
+    bool purge_quarantined_capsule(const std::string& id);
+    std::vector<SwarmVectorDB::QuarantineEntry> get_quarantined_capsules() const;
 
     // Arama ve İçerik Metodları
     std::vector<Capsule> semantic_search(const std::vector<float>& query_embedding, int top_k = 3) const;
     std::vector<Capsule> search_by_topic(const std::vector<float>& topic_embedding, int top_k = 3) const;
+    // Konu/kaynak/güven/zaman aralığı filtreli anlamsal arama; filtre HNSW araması içinde uygulanır.
+    std::vector<Capsule> semantic_search_filtered(const std::vector<float>& query_embedding,
+                                                  const SwarmVectorDB::VectorFilter& filter, int top_k = 3) const;
     virtual std::vector<Capsule> get_all_capsules() const;
+    // Tüm kapsülleri chunk_size'lık gruplar halinde okuyup visitor'a verir (bellekte yalnızca bir grup tutulur).
+    // visitor false dönerse durur. Ziyaret edilen kapsül sayısını döndürür.
+    std::size_t for_each_capsule(const std::function<bool(const Capsule&)>& visitor, std::size_t chunk_size = 256) const;
+    // Kapsül ID/konu/içeriği üzerinde BM25 araması (birebir terimler: hata kodları, tanımlayıcılar).
+    std::vector<Capsule> keyword_search(const std::string& query, int top_k = 3) const;
+    // BM25 ve HNSW sonuçlarını reciprocal-rank fusion ile birleştirir; iki listede de üst sıralarda olanlar öne çıkar.
+    std::vector<HybridSearchHit> hybrid_search(const std::string& query_text, const std::vector<float>& query_embedding,
+                                               const HybridSearchOptions& options = {}) const;
 
     // JSON İçe/Dışa Aktarma Metodları (Araçlar için)
     void export_to_json(const std::string& filename = "knowledge_export.json") const;
     void import_from_json(const std::string& filename = "knowledge_import.json");
 
+    // Akış tabanlı içe/dışa aktarma: dosya boyutundan bağımsız, sınırlı bellekle çalışır (bkz. KnowledgeStream.h).
+    bool export_json_stream(std::ostream& out) const;
+    CapsuleImportStats import_json_stream(std::istream& in, const CapsuleImportOptions& options = {});
+    // İkili snapshot ile yedekleme / geri yükleme. Yol olduğu gibi kullanılır (data dizinine göre çözülmez).
+    bool export_snapshot(const std::string& path) const;
+    CapsuleImportStats import_snapshot(const std::string& path, const CapsuleImportOptions& options = {});
+
+    // Kapsül senkronizasyonu (CapsuleSync) için Merkle ağacı. İlk çağrıda depodaki tüm kapsüllerden kurulur,
+    // sonrasında add_capsule / quarantine_capsule ile artımlı olarak güncellenir.
+    const SwarmVectorDB::SwarmConsensusTree& capsule_tree() const;
+    // Bir kapsülün ağaçtaki yaprak özeti: vektörün kanonik kodlaması + kapsül içeriği.
+    static SwarmVectorDB::SwarmConsensusTree::Hash capsule_digest(const SwarmVectorDB::CryptofigVector& cv, const std::string& content);
+
 private:
     std::string db_path_; // LMDB veritabanı yolu
     // DÜZELTİLDİ: Üye değişken tipi CerebrumLux::SwarmVectorDB::SwarmVectorDB olarak değiştirildi.
     CerebrumLux::SwarmVectorDB::SwarmVectorDB m_swarm_db; // LMDB tabanlı vektör veritabanı üyesi
 
+    mutable SwarmVectorDB::SwarmConsensusTree m_capsule_tree;
+    mutable std::mutex m_capsule_tree_mutex; // Ağacın tembel kurulumu ile artımlı güncellemeleri sıraya sokar
+    mutable bool m_capsule_tree_built = false;
+
+    // Ters indeks ilk anahtar kelime aramasında kurulur, sonra kapsül ekleme/karantina ile artımlı güncellenir.
+    const CapsuleTextIndex& text_index() const;
+    static std::string indexed_text(const std::string& id, const std::string& topic, const std::string& content);
+    mutable CapsuleTextIndex m_text_index;
+    mutable std::mutex m_text_index_mutex;
+    mutable bool m_text_index_built = false;
+
     // Yardımcı Dönüşüm Metodları
     SwarmVectorDB::CryptofigVector convert_capsule_to_cryptofig_vector(const Capsule& capsule) const;
-    Capsule convert_cryptofig_vector_to_capsule(const SwarmVectorDB::CryptofigVector& cv) const;
+    static SwarmVectorDB::VectorAttributes capsule_attributes(const Capsule& capsule);
+    // attributes verilmezse (tekil okuma) nitelikler ayrıca okunur; toplu okumalar get_vectors_batch'ten gelenleri geçirir.
+    Capsule convert_cryptofig_vector_to_capsule(const SwarmVectorDB::CryptofigVector& cv,
+                                                const SwarmVectorDB::VectorAttributes* attributes = nullptr) const;
 };
 
 } // namespace CerebrumLux
@@ -0,0 +1,546 @@
+#include "KnowledgeStream.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "KnowledgeBase.h"
+#include "../core/logger.h"
+#include "../core/metrics.h"
+
+namespace CerebrumLux {
+
+namespace {
+
+using json = nlohmann::json;
+
+Metrics::Counter& imported_capsules_counter(const char* format) {
+    return Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_knowledge_import_capsules_total", "Akış tabanlı içe aktarmada depolanan kapsül sayısı",
+        std::string("format=\"") + format + "\"");
+}
+
+// "active_capsules" dizisinin elemanlarını tek tek json değerine kuran SAX işleyicisi. Dizi dışındaki
+// değerler kurulmadan atlanır.
+class CapsuleSaxHandler : public nlohmann::json_sax<json> {
+public:
+    CapsuleSaxHandler(const CapsuleSink& sink, CapsuleReadResult& result) : sink_(sink), result_(result) {}
+
+    bool null() override { return scalar(json(nullptr)); }
+    bool boolean(bool val) override { return scalar(json(val)); }
+    bool number_integer(number_integer_t val) override { return scalar(json(val)); }
+    bool number_unsigned(number_unsigned_t val) override { return scalar(json(val)); }
+    bool number_float(number_float_t val, const string_t&) override { return scalar(json(val)); }
+    bool string(string_t& val) override { return scalar(json(std::move(val))); }
+    bool binary(binary_t& val) override { return scalar(json::binary(std::move(val))); }
+
+    bool start_object(std::size_t) override {
+        ++depth_;
+        if (building()) {
+            stack_.push_back(insert(json::object()));
+        } else if (capsule_depth_ != 0 && depth_ == capsule_depth_ + 1) {
+            element_ = json::object();
+            stack_.push_back(&element_);
+        } else if (depth_ == 1) {
+            root_is_object_ = true;
+        }
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (building()) {
+            pending_key_ = std::move(val);
+        } else if (depth_ == 1) {
+            root_key_ = std::move(val);
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        --depth_;
+        if (!building()) return true;
+        stack_.pop_back();
+        return stack_.empty() ? deliver_capsule() : true;
+    }
+
+    bool start_array(std::size_t) override {
+        ++depth_;
+        if (building()) {
+            stack_.push_back(insert(json::array()));
+        } else if (capsule_depth_ == 0 && !result_.found_capsules &&
+                   (depth_ == 1 || (depth_ == 2 && root_is_object_ && root_key_ == "active_capsules"))) {
+            capsule_depth_ = depth_;
+            result_.found_capsules = true;
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (building()) {
+            stack_.pop_back();
+        } else if (depth_ == capsule_depth_) {
+            capsule_depth_ = 0;
+        }
+        --depth_;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        result_.error = ex.what();
+        return false;
+    }
+
+    bool stopped() const { return stopped_; }
+
+private:
+    bool building() const { return !stack_.empty(); }
+
+    json* insert(json&& value) {
+        json* parent = stack_.back();
+        if (parent->is_object()) {
+            json& slot = (*parent)[pending_key_];
+            slot = std::move(value);
+            return &slot;
+        }
+        parent->push_back(std::move(value));
+        return &parent->back();
+    }
+
+    bool scalar(json&& value) {
+        if (building()) {
+            insert(std::move(value));
+        } else if (capsule_depth_ != 0 && depth_ == capsule_depth_) {
+            ++result_.skipped; // Dizide nesne olmayan eleman
+        }
+        return true;
+    }
+
+    bool deliver_capsule() {
+        if (!element_.contains("trust_score") || !element_.contains("timestamp_utc")) result_.legacy_format = true;
+        Capsule capsule;
+        try {
+            capsule = element_.get<Capsule>();
+        } catch (const json::exception& e) {
+            ++result_.skipped;
+            LOG_DEFAULT(LogLevel::WARNING, "CapsuleJsonReader: Kapsül ayrıştırılamadı, atlanıyor: " << e.what());
+            element_ = json();
+            return true;
+        }
+        element_ = json();
+        ++result_.capsules;
+        if (!sink_(std::move(capsule))) {
+            stopped_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    const CapsuleSink& sink_;
+    CapsuleReadResult& result_;
+    std::size_t depth_ = 0;
+    std::size_t capsule_depth_ = 0; // Kapsül dizisinin derinliği (0 = dizinin içinde değil)
+    bool root_is_object_ = false;
+    std::string root_key_;
+    std::string pending_key_;
+    json element_;                  // Kurulmakta olan kapsül
+    std::vector<json*> stack_;      // element_ içindeki açık kapların yolu
+    bool stopped_ = false;
+};
+
+// Sabit genişlikli little-endian tamsayı yazma / okuma.
+void put_u32(std::ostream& out, std::uint32_t v) {
+    char b[4];
+    for (int i = 0; i < 4; ++i) b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    out.write(b, 4);
+}
+
+void put_u64(std::ostream& out, std::uint64_t v) {
+    char b[8];
+    for (int i = 0; i < 8; ++i) b[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    out.write(b, 8);
+}
+
+bool get_u32(std::istream& in, std::uint32_t& v) {
+    unsigned char b[4];
+    if (!in.read(reinterpret_cast<char*>(b), 4)) return false;
+    v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(b[i]) << (8 * i);
+    return true;
+}
+
+bool get_u64(std::istream& in, std::uint64_t& v) {
+    unsigned char b[8];
+    if (!in.read(reinterpret_cast<char*>(b), 8)) return false;
+    v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(b[i]) << (8 * i);
+    return true;
+}
+
+constexpr char kSnapshotMagic[8] = {'C', 'L', 'X', 'S', 'N', 'A', 'P', '\0'};
+
+// Kapasitesi dolunca üreticiyi bekleten kuyruk. close() sonrası push başarısız olur, pop kalanları boşaltır.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(std::max<std::size_t>(1, capacity)) {}
+
+    bool push(T&& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || queue_.size() < capacity_; });
+        if (closed_) return false;
+        queue_.push_back(std::move(value));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+        if (queue_.empty()) return false;
+        out = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    const std::size_t capacity_;
+    std::deque<T> queue_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+struct PipelineItem {
+    std::size_t seq = 0;
+    Capsule capsule;
+    bool valid = true;
+};
+
+// Ayrıştırılmış ama henüz depolama aşamasından çıkmamış sıra numaralarını sınırlar. Yavaş bir kapsül tüm işçileri
+// beklettiğinde bile yeniden sıralama tamponu `window` öğeyi aşmaz: ayrıştırıcı seq < next + window olana kadar bekler.
+// Beklenen en eski kapsül (next) her zaman pencerenin içinde olduğundan ilerleme garantilidir.
+class SequenceWindow {
+public:
+    explicit SequenceWindow(std::size_t window) : window_(std::max<std::size_t>(1, window)) {}
+
+    bool acquire(std::size_t seq) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        admit_.wait(lock, [this, seq] { return closed_ || seq < next_ + window_; });
+        return !closed_;
+    }
+
+    void advance_to(std::size_t next) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next_ = next;
+        admit_.notify_all();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        admit_.notify_all();
+    }
+
+private:
+    const std::size_t window_;
+    std::size_t next_ = 0;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable admit_;
+};
+
+} // namespace
+
+// --- CapsuleJsonReader ---
+
+CapsuleReadResult CapsuleJsonReader::read(std::istream& in, const CapsuleSink& sink) {
+    CapsuleReadResult result;
+    CapsuleSaxHandler handler(sink, result);
+    try {
+        result.ok = json::sax_parse(in, &handler);
+    } catch (const std::exception& e) {
+        result.ok = false;
+        result.error = e.what();
+    }
+    if (handler.stopped()) result.error = "Okuma tüketici tarafından durduruldu.";
+    return result;
+}
+
+// --- CapsuleJsonWriter ---
+
+CapsuleJsonWriter::CapsuleJsonWriter(std::ostream& out) : out_(out) {
+    out_ << "{\n    \"active_capsules\": [";
+}
+
+void CapsuleJsonWriter::write(const Capsule& capsule) {
+    const json j = capsule;
+    std::string text = j.dump(4, ' ', false, json::error_handler_t::replace);
+    // Kapsül nesnesi dizinin içinde iki seviye girintilenir. Dize değerlerindeki satır sonları kaçışlı olduğundan
+    // ham '\n' yalnızca biçimlendirmeden gelir.
+    std::string indented;
+    indented.reserve(text.size() + text.size() / 8);
+    for (char c : text) {
+        indented.push_back(c);
+        if (c == '\n') indented.append(8, ' ');
+    }
+    out_ << (count_ == 0 ? "\n        " : ",\n        ") << indented;
+    ++count_;
+}
+
+bool CapsuleJsonWriter::finish() {
+    if (finished_) return static_cast<bool>(out_);
+    finished_ = true;
+    out_ << (count_ == 0 ? "]\n}" : "\n    ]\n}") << std::endl;
+    return static_cast<bool>(out_);
+}
+
+// --- CapsuleSnapshot ---
+
+std::uint32_t CapsuleSnapshot::crc32(const std::uint8_t* data, std::size_t size) {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            t[i] = c;
+        }
+        return t;
+    }();
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+CapsuleSnapshot::Writer::Writer(std::ostream& out) : out_(out) {
+    out_.write(kSnapshotMagic, sizeof(kSnapshotMagic));
+    put_u32(out_, kVersion);
+    put_u32(out_, 0);
+}
+
+bool CapsuleSnapshot::Writer::write(const Capsule& capsule) {
+    const json j = capsule;
+    const std::vector<std::uint8_t> payload = json::to_cbor(j);
+    if (payload.size() > kMaxRecordSize) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "CapsuleSnapshot: Kapsül kaydı çok büyük (" << payload.size() << " bayt), atlanıyor. ID: " << capsule.id);
+        return false;
+    }
+    put_u32(out_, static_cast<std::uint32_t>(payload.size()));
+    out_.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    put_u32(out_, crc32(payload.data(), payload.size()));
+    ++count_;
+    return static_cast<bool>(out_);
+}
+
+bool CapsuleSnapshot::Writer::finish() {
+    if (finished_) return static_cast<bool>(out_);
+    finished_ = true;
+    put_u32(out_, kEndMarker);
+    put_u64(out_, count_);
+    out_.flush();
+    return static_cast<bool>(out_);
+}
+
+CapsuleReadResult CapsuleSnapshot::read(std::istream& in, const CapsuleSink& sink) {
+    CapsuleReadResult result;
+
+    char magic[sizeof(kSnapshotMagic)];
+    std::uint32_t version = 0;
+    std::uint32_t flags = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kSnapshotMagic)) {
+        result.error = "Geçersiz snapshot başlığı.";
+        return result;
+    }
+    if (!get_u32(in, version) || !get_u32(in, flags) || version == 0 || version > kVersion) {
+        result.error = "Desteklenmeyen snapshot sürümü: " + std::to_string(version);
+        return result;
+    }
+    result.found_capsules = true;
+
+    std::uint64_t records = 0;
+    std::vector<std::uint8_t> payload;
+    while (true) {
+        std::uint32_t size = 0;
+        if (!get_u32(in, size)) {
+            result.error = "Snapshot kesilmiş: son işareti bulunamadı.";
+            return result;
+        }
+        if (size == kEndMarker) {
+            std::uint64_t expected = 0;
+            if (!get_u64(in, expected)) {
+                result.error = "Snapshot kesilmiş: kayıt sayısı okunamadı.";
+            } else if (expected != records) {
+                result.error = "Snapshot kayıt sayısı uyuşmuyor (beklenen " + std::to_string(expected) + ", okunan " + std::to_string(records) + ").";
+            } else {
+                result.ok = true;
+            }
+            return result;
+        }
+        if (size > kMaxRecordSize) {
+            // Uzunluk alanı bozuksa sonraki kaydın başı bilinemez; okuma burada biter.
+            result.error = "Geçersiz kayıt uzunluğu: " + std::to_string(size);
+            return result;
+        }
+
+        payload.resize(size);
+        std::uint32_t stored_crc = 0;
+        if (!in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(size)) || !get_u32(in, stored_crc)) {
+            result.error = "Snapshot kesilmiş: kayıt yarıda kaldı.";
+            return result;
+        }
+        ++records;
+
+        if (crc32(payload.data(), payload.size()) != stored_crc) {
+            ++result.skipped;
+            LOG_DEFAULT(LogLevel::WARNING, "CapsuleSnapshot: Kayıt " << records << " sağlama toplamı tutmuyor, atlanıyor.");
+            continue;
+        }
+
+        Capsule capsule;
+        try {
+            capsule = json::from_cbor(payload).get<Capsule>();
+        } catch (const json::exception& e) {
+            ++result.skipped;
+            LOG_DEFAULT(LogLevel::WARNING, "CapsuleSnapshot: Kayıt " << records << " çözülemedi, atlanıyor: " << e.what());
+            continue;
+        }
+        ++result.capsules;
+        if (!sink(std::move(capsule))) {
+            result.error = "Okuma tüketici tarafından durduruldu.";
+            return result;
+        }
+    }
+}
+
+// --- CapsuleImportPipeline ---
+
+CapsuleImportPipeline::CapsuleImportPipeline(KnowledgeBase& kb, CapsuleImportOptions options)
+    : kb_(kb), options_(std::move(options)) {
+    if (options_.workers == 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        options_.workers = hw > 1 ? hw - 1 : 1;
+    }
+    options_.batch_size = std::max<std::size_t>(1, options_.batch_size);
+    options_.queue_capacity = std::max<std::size_t>(1, options_.queue_capacity);
+}
+
+CapsuleImportStats CapsuleImportPipeline::run_json(std::istream& in) {
+    CapsuleImportStats stats = run([&in](const CapsuleSink& sink) { return CapsuleJsonReader::read(in, sink); });
+    imported_capsules_counter("json").inc(stats.stored);
+    return stats;
+}
+
+CapsuleImportStats CapsuleImportPipeline::run_snapshot(std::istream& in) {
+    CapsuleImportStats stats = run([&in](const CapsuleSink& sink) { return CapsuleSnapshot::read(in, sink); });
+    imported_capsules_counter("snapshot").inc(stats.stored);
+    return stats;
+}
+
+CapsuleImportStats CapsuleImportPipeline::run(const Reader& reader) {
+    CapsuleImportStats stats;
+    BoundedQueue<PipelineItem> parsed_queue(options_.queue_capacity);
+    BoundedQueue<PipelineItem> embedded_queue(options_.queue_capacity);
+    SequenceWindow window(options_.queue_capacity);
+
+    // 2. aşama: embedding. Son çıkan işçi bir sonraki kuyruğu kapatır.
+    std::atomic<std::size_t> active_workers{options_.workers};
+    std::vector<std::thread> workers;
+    workers.reserve(options_.workers);
+    for (std::size_t w = 0; w < options_.workers; ++w) {
+        workers.emplace_back([this, &parsed_queue, &embedded_queue, &active_workers] {
+            PipelineItem item;
+            while (parsed_queue.pop(item)) {
+                if (item.capsule.id.empty()) {
+                    item.valid = false;
+                } else if (item.capsule.embedding.empty() && options_.embedder) {
+                    try {
+                        item.capsule.embedding = options_.embedder(item.capsule);
+                    } catch (const std::exception& e) {
+                        item.valid = false;
+                        LOG_DEFAULT(LogLevel::WARNING, "CapsuleImportPipeline: Embedding hesaplanamadı, kapsül atlanıyor. ID: " << item.capsule.id << ", hata: " << e.what());
+                    }
+                }
+                if (!embedded_queue.push(std::move(item))) break;
+            }
+            if (active_workers.fetch_sub(1) == 1) embedded_queue.close();
+        });
+    }
+
+    // 3. aşama: depolama. Kapsüller girdi sırasına geri dizilir ve gruplar halinde yazılır.
+    std::size_t stored = 0;
+    std::size_t batches = 0;
+    std::size_t dropped = 0;
+    std::thread store_thread([this, &embedded_queue, &window, &stored, &batches, &dropped] {
+        std::map<std::size_t, PipelineItem> reorder;
+        std::size_t next_seq = 0;
+        std::vector<Capsule> batch;
+        batch.reserve(options_.batch_size);
+        auto flush = [&] {
+            if (batch.empty()) return;
+            stored += kb_.add_capsules_batch(batch);
+            ++batches;
+            batch.clear();
+        };
+
+        PipelineItem item;
+        while (embedded_queue.pop(item)) {
+            reorder.emplace(item.seq, std::move(item));
+            const std::size_t first_seq = next_seq;
+            for (auto it = reorder.begin(); it != reorder.end() && it->first == next_seq; it = reorder.erase(it), ++next_seq) {
+                if (!it->second.valid) {
+                    ++dropped;
+                    continue;
+                }
+                batch.push_back(std::move(it->second.capsule));
+                if (batch.size() >= options_.batch_size) flush();
+            }
+            if (next_seq != first_seq) window.advance_to(next_seq);
+        }
+        flush();
+        window.close();
+    });
+
+    // 1. aşama: ayrıştırma (çağıran iş parçacığı).
+    std::size_t seq = 0;
+    const CapsuleReadResult read_result = reader([&parsed_queue, &window, &seq](Capsule&& capsule) {
+        PipelineItem item;
+        item.seq = seq++;
+        item.capsule = std::move(capsule);
+        if (!window.acquire(item.seq)) return false;
+        return parsed_queue.push(std::move(item));
+    });
+    parsed_queue.close();
+
+    for (std::thread& worker : workers) worker.join();
+    store_thread.join();
+
+    stats.parsed = read_result.capsules;
+    stats.stored = stored;
+    stats.skipped = read_result.skipped + dropped;
+    stats.batches = batches;
+    stats.found_capsules = read_result.found_capsules;
+    stats.legacy_format = read_result.legacy_format;
+    stats.ok = read_result.ok;
+    stats.error = read_result.error;
+    LOG_DEFAULT(LogLevel::INFO, "CapsuleImportPipeline: " << stats.parsed << " kapsül ayrıştırıldı, " << stats.stored
+                << " depolandı (" << stats.batches << " grup), " << stats.skipped << " atlandı.");
+    return stats;
+}
+
+} // namespace CerebrumLux
@@ -0,0 +1,126 @@
+#ifndef KNOWLEDGE_STREAM_H
+#define KNOWLEDGE_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Capsule.h"
+
+namespace CerebrumLux {
+
+class KnowledgeBase;
+
+// Akış okuyucularının her kapsül için çağırdığı geri çağrı. false dönerse okuma durur.
+using CapsuleSink = std::function<bool(Capsule&&)>;
+
+struct CapsuleReadResult {
+    std::size_t capsules = 0;     // Geri çağrıya teslim edilen kapsül sayısı
+    std::size_t skipped = 0;      // Ayrıştırılamayan / sağlama toplamı tutmayan kayıtlar
+    bool found_capsules = false;  // "active_capsules" dizisi (veya snapshot başlığı) bulundu mu
+    bool legacy_format = false;   // trust_score / timestamp_utc alanı eksik kayıt görüldü mü (JSON)
+    bool ok = false;              // Girdi sonuna kadar hatasız okundu mu
+    std::string error;
+};
+
+// JSON bilgi tabanı dosyasını SAX ile okur: {"active_capsules": [ {...}, {...} ]} (veya kökte doğrudan dizi).
+// Bellekte aynı anda yalnızca o an ayrıştırılan kapsülün JSON ağacı bulunur; dosya boyutundan bağımsızdır.
+class CapsuleJsonReader {
+public:
+    static CapsuleReadResult read(std::istream& in, const CapsuleSink& sink);
+};
+
+// export_to_json ile aynı biçimi (4 boşluk girinti) kapsül kapsül yazar.
+class CapsuleJsonWriter {
+public:
+    explicit CapsuleJsonWriter(std::ostream& out);
+
+    void write(const Capsule& capsule);
+    // Diziyi ve kök nesneyi kapatır; en fazla bir kez çağrılır.
+    bool finish();
+
+    std::size_t count() const { return count_; }
+
+private:
+    std::ostream& out_;
+    std::size_t count_ = 0;
+    bool finished_ = false;
+};
+
+// Hızlı yedekleme / geri yükleme için ikili kapsül anlık görüntüsü.
+//
+// Biçim (tüm tamsayılar little-endian):
+//   başlık : "CLXSNAP\0" (8 bayt) | u32 sürüm | u32 bayraklar (şimdilik 0)
+//   kayıt  : u32 uzunluk | uzunluk baytlık CBOR (Capsule JSON'u) | u32 CRC-32(yük)
+//   son    : u32 0xFFFFFFFF | u64 kayıt sayısı
+// Sağlama toplamı tutmayan kayıt atlanır ve skipped'e sayılır; son işareti olmayan (kesilmiş) dosyada o ana kadar
+// okunan kayıtlar teslim edilir ama ok=false döner.
+class CapsuleSnapshot {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kEndMarker = 0xFFFFFFFFu;
+    static constexpr std::uint32_t kMaxRecordSize = 64u * 1024u * 1024u;
+
+    class Writer {
+    public:
+        explicit Writer(std::ostream& out);
+        bool write(const Capsule& capsule);
+        bool finish();
+        std::size_t count() const { return count_; }
+
+    private:
+        std::ostream& out_;
+        std::uint64_t count_ = 0;
+        bool finished_ = false;
+    };
+
+    static CapsuleReadResult read(std::istream& in, const CapsuleSink& sink);
+
+    static std::uint32_t crc32(const std::uint8_t* data, std::size_t size);
+};
+
+struct CapsuleImportOptions {
+    std::size_t workers = 0;          // Embedding aşaması iş parçacığı sayısı (0 = donanım iş parçacığı - 1, en az 1)
+    std::size_t batch_size = 256;     // Tek LMDB yazma transaction'ına giren kapsül sayısı
+    std::size_t queue_capacity = 512; // Aşamalar arası kuyrukların ve aynı anda işlenen kapsül sayısının üst sınırı (bellek sınırı)
+    // Embedding'i boş olan kapsüller için çağrılır (ör. NLP modeliyle hesaplama). Boşsa eksik embedding sıfırla doldurulur.
+    std::function<std::vector<float>(const Capsule&)> embedder;
+};
+
+struct CapsuleImportStats {
+    std::size_t parsed = 0;
+    std::size_t stored = 0;
+    std::size_t skipped = 0;  // Okuma veya embedding aşamasında düşen kayıtlar
+    std::size_t batches = 0;
+    bool found_capsules = false;
+    bool legacy_format = false;
+    bool ok = false;
+    std::string error;
+};
+
+// Üç aşamalı paralel içe aktarma hattı:
+//   ayrıştırma (çağıran iş parçacığı, reader) -> embedding (workers iş parçacığı) -> depolama (tek iş parçacığı)
+// Aşamalar sınırlı kuyruklarla bağlıdır; depolama aşaması kapsülleri girdi sırasına geri dizer (aynı ID'nin son
+// kaydı kazanır) ve batch_size'lık gruplar halinde KnowledgeBase::add_capsules_batch ile yazar.
+class CapsuleImportPipeline {
+public:
+    using Reader = std::function<CapsuleReadResult(const CapsuleSink&)>;
+
+    CapsuleImportPipeline(KnowledgeBase& kb, CapsuleImportOptions options = {});
+
+    CapsuleImportStats run(const Reader& reader);
+    CapsuleImportStats run_json(std::istream& in);
+    CapsuleImportStats run_snapshot(std::istream& in);
+
+private:
+    KnowledgeBase& kb_;
+    CapsuleImportOptions options_;
+};
+
+} // namespace CerebrumLux
+
+#endif // KNOWLEDGE_STREAM_H
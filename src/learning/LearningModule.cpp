@@ -6,6 +6,7 @@
 
 #include "LearningModule.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
 #include "../core/enums.h"
 #include "../core/utils.h" // SafeRNG için
 #include "../crypto/CryptoManager.h" // cryptoManager için
@@ -16,6 +17,7 @@
 #include <stdexcept> // std::runtime_error için
 #include <sstream>   // std::stringstream için
 #include <iomanip>   // std::fixed, std::setprecision için
+#include <array>
 
 #include <QCoreApplication> 
 #include <QUrlQuery> // URL kodlama için gerekli
@@ -26,6 +28,48 @@ namespace CerebrumLux {
 
 using EmbeddingStateKey = CerebrumLux::SwarmVectorDB::EmbeddingStateKey;
 
+namespace {
+
+const char* ingest_result_label(IngestResult result) {
+    switch (result) {
+        case IngestResult::Success: return "success";
+        case IngestResult::InvalidSignature: return "invalid_signature";
+        case IngestResult::DecryptionFailed: return "decryption_failed";
+        case IngestResult::SchemaMismatch: return "schema_mismatch";
+        case IngestResult::SanitizationNeeded: return "sanitization_needed";
+        case IngestResult::SteganographyDetected: return "steganography_detected";
+        case IngestResult::SandboxFailed: return "sandbox_failed";
+        case IngestResult::CorroborationFailed: return "corroboration_failed";
+        case IngestResult::Busy: return "busy";
+        case IngestResult::UnknownError: break;
+    }
+    return "unknown_error";
+}
+
+// Tüm çıkış noktaları audit_log_append'den geçtiği için sonuç sayacı orada artırılır.
+Metrics::Counter& ingest_result_counter(IngestResult result) {
+    static constexpr std::size_t kResultCount = static_cast<std::size_t>(IngestResult::Busy) + 1;
+    static const auto counters = [] {
+        std::array<Metrics::Counter*, kResultCount> arr{};
+        for (std::size_t i = 0; i < kResultCount; ++i) {
+            arr[i] = &Metrics::MetricsRegistry::instance().counter(
+                "cerebrumlux_ingest_total", "ingest_envelope sonuçları",
+                std::string("result=\"") + ingest_result_label(static_cast<IngestResult>(i)) + "\"");
+        }
+        return arr;
+    }();
+    const std::size_t index = static_cast<std::size_t>(result);
+    return *counters[index < kResultCount ? index : static_cast<std::size_t>(IngestResult::UnknownError)];
+}
+
+Metrics::Histogram& ingest_latency() {
+    static Metrics::Histogram& histogram = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_ingest_seconds", "ingest_envelope toplam süresi (imza, şifre çözme, analiz ve bilgi tabanına ekleme)");
+    return histogram;
+}
+
+} // namespace
+
 LearningModule::LearningModule(KnowledgeBase& kb, CerebrumLux::Crypto::CryptoManager& cryptoMan, NaturalLanguageProcessor& nlp, QObject *parent)
     : QObject(parent),
       knowledgeBase(kb),
@@ -184,133 +228,146 @@ void LearningModule::process_ai_insights(const std::vector<AIInsight>& insights)
     LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] --- İçgörü İşleme Başlıyor ---");
 
     for (const auto& insight : insights) {
-        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] İşleniyor: ID=" << insight.id << " (Type: " << static_cast<int>(insight.type) << ")"
-                                    << ", Gözlem: " << insight.observation
-                                    << ", Bağlam: " << insight.context
-                                    << ", Önerilen Eylem: " << insight.recommended_action
-                                    << ", Tip: " << static_cast<int>(insight.type));
-
-        Capsule insight_capsule;
-        insight_capsule.id = insight.id;
-        insight_capsule.content = insight.observation;
-        insight_capsule.source = "AIInsightsEngine";
-        // YENİ DÜZELTME: plain_text_summary'yi daha anlamlı hale getir.
-        // Eğer insight.observation zaten yeterince uzunsa, onu kullan.
-        // Aksi takdirde, daha açıklayıcı bir özet oluştur.
-        insight_capsule.plain_text_summary = insight.observation.substr(0, std::min((size_t)500, insight.observation.length()));
-        if (insight.observation.length() > 500) insight_capsule.plain_text_summary += "...";
-        insight_capsule.topic = "AI Insight";
-        switch (insight.urgency) {
-            case CerebrumLux::UrgencyLevel::Low: insight_capsule.confidence = 0.7f; break;
-            case CerebrumLux::UrgencyLevel::Medium: insight_capsule.confidence = 0.8f; break;
-            case CerebrumLux::UrgencyLevel::High: insight_capsule.confidence = 0.9f; break;
-            case CerebrumLux::UrgencyLevel::Critical: insight_capsule.confidence = 0.95f; break;
-            case CerebrumLux::UrgencyLevel::None: insight_capsule.confidence = 0.6f; break;
-            default: insight_capsule.confidence = 0.5f; break;
-        }
+        process_ai_insight(insight);
+    }
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] --- İçgörü İşleme Bitti ---");
+}
 
-        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule]   Kontrol ediliyor: insight.type (" << static_cast<int>(insight.type) << ") == CerebrumLux::InsightType::CodeDevelopmentSuggestion (" << static_cast<int>(CerebrumLux::InsightType::CodeDevelopmentSuggestion) << ")");
-        bool is_code_dev = (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion);
-        if (!is_code_dev) {
-            if (!insight.id.empty() && insight.id.rfind("CodeDev", 0) == 0) {
-                is_code_dev = true;
-                LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Fallback: CodeDevelopment tespiti ID prefix'e gore yapildi. ID: " << insight.id);
-            }
-            else if (insight.context.find("Kod") != std::string::npos ||
-                     insight.context.find("Code") != std::string::npos ||
-                     insight.recommended_action.find("Code") != std::string::npos ||
-                     insight.recommended_action.find("Refactor") != std::string::npos) {
-                is_code_dev = true;
-                LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Fallback: CodeDevelopment tespiti string iceriklere gore yapildi. Context: " << insight.context << ", Action: " << insight.recommended_action << ", ID: " << insight.id);
-            }
+void LearningModule::process_ai_insights(const InsightBatch& insights) {
+    LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "[LearningModule] AI Insights isleniyor: " << insights.size() << " adet içgörü (tick " << insights.tick() << ").");
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] --- İçgörü İşleme Başlıyor ---");
+    for (std::size_t i = 0; i < insights.size(); ++i) {
+        process_ai_insight(insights.insight(i));
+    }
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] --- İçgörü İşleme Bitti ---");
+}
+
+void LearningModule::process_ai_insight(const AIInsight& insight) {
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] İşleniyor: ID=" << insight.id << " (Type: " << static_cast<int>(insight.type) << ")"
+                                << ", Gözlem: " << insight.observation
+                                << ", Bağlam: " << insight.context
+                                << ", Önerilen Eylem: " << insight.recommended_action
+                                << ", Tip: " << static_cast<int>(insight.type));
+
+    Capsule insight_capsule;
+    insight_capsule.id = insight.id;
+    insight_capsule.content = insight.observation;
+    insight_capsule.source = "AIInsightsEngine";
+    // YENİ DÜZELTME: plain_text_summary'yi daha anlamlı hale getir.
+    // Eğer insight.observation zaten yeterince uzunsa, onu kullan.
+    // Aksi takdirde, daha açıklayıcı bir özet oluştur.
+    insight_capsule.plain_text_summary = insight.observation.substr(0, std::min((size_t)500, insight.observation.length()));
+    if (insight.observation.length() > 500) insight_capsule.plain_text_summary += "...";
+    insight_capsule.topic = "AI Insight";
+    switch (insight.urgency) {
+        case CerebrumLux::UrgencyLevel::Low: insight_capsule.confidence = 0.7f; break;
+        case CerebrumLux::UrgencyLevel::Medium: insight_capsule.confidence = 0.8f; break;
+        case CerebrumLux::UrgencyLevel::High: insight_capsule.confidence = 0.9f; break;
+        case CerebrumLux::UrgencyLevel::Critical: insight_capsule.confidence = 0.95f; break;
+        case CerebrumLux::UrgencyLevel::None: insight_capsule.confidence = 0.6f; break;
+        default: insight_capsule.confidence = 0.5f; break;
+    }
+
+    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule]   Kontrol ediliyor: insight.type (" << static_cast<int>(insight.type) << ") == CerebrumLux::InsightType::CodeDevelopmentSuggestion (" << static_cast<int>(CerebrumLux::InsightType::CodeDevelopmentSuggestion) << ")");
+    bool is_code_dev = (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion);
+    if (!is_code_dev) {
+        if (!insight.id.empty() && insight.id.rfind("CodeDev", 0) == 0) {
+            is_code_dev = true;
+            LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Fallback: CodeDevelopment tespiti ID prefix'e gore yapildi. ID: " << insight.id);
         }
-        if (is_code_dev) {
-            insight_capsule.topic = "CodeDevelopment";
-            LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] CodeDevelopmentSuggestion için topic 'CodeDevelopment' olarak ayarlandı. ID: " << insight.id);
-        } else {
-            LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] InsightType CodeDevelopmentSuggestion değil (" << static_cast<int>(insight.type) << "). Varsayılan topic ('AI Insight') kullanılıyor.");
+        else if (insight.context.find("Kod") != std::string::npos ||
+                 insight.context.find("Code") != std::string::npos ||
+                 insight.recommended_action.find("Code") != std::string::npos ||
+                 insight.recommended_action.find("Refactor") != std::string::npos) {
+            is_code_dev = true;
+            LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Fallback: CodeDevelopment tespiti string iceriklere gore yapildi. Context: " << insight.context << ", Action: " << insight.recommended_action << ", ID: " << insight.id);
         }
+    }
+    if (is_code_dev) {
+        insight_capsule.topic = "CodeDevelopment";
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] CodeDevelopmentSuggestion için topic 'CodeDevelopment' olarak ayarlandı. ID: " << insight.id);
+    } else {
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] InsightType CodeDevelopmentSuggestion değil (" << static_cast<int>(insight.type) << "). Varsayılan topic ('AI Insight') kullanılıyor.");
+    }
 
-        if (insight.context == "Sistem Genel Performans Metriği") {
-            // YENİ DÜZELTME: insight.observation string'inden confidence değerini doğru şekilde parse et
-            // Örneğin: "AI sisteminin anlık güven seviyesi: 0.85" -> 0.85
-            // YENİ LOG: Sistem Genel Performans Metriği bağlamı için gözlemi logla
-            LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] 'Sistem Genel Performans Metriği' bağlamı algılandı. Gözlem: " << insight.observation);
-            
-            // "AI sisteminin anlık güven seviyesi: 0.85" formatından sayıyı çekmek için
-            // Son ":" karakterinden sonraki kısmı alalım
-            size_t last_colon_pos = insight.observation.rfind(":");
-            if (last_colon_pos != std::string::npos && last_colon_pos + 1 < insight.observation.length()) {
-                std::string confidence_str = insight.observation.substr(last_colon_pos + 1);
-                try {
-                    insight_capsule.confidence = std::stof(confidence_str); // DÜZELTİLDİ: 'pos' yerine 'confidence_str' kullanıldı.
-                    // Boşlukları temizleyelim ve float'a çevirelim
-                    confidence_str.erase(0, confidence_str.find_first_not_of(" \t\n\r\f\v"));
-                    insight_capsule.confidence = std::stof(confidence_str);
-
-                    // YENİ LOG: Çıkarılan confidence değerini logla
-                    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Gözlemden çıkarılan confidence değeri: " << insight_capsule.confidence);
-                    if (insight_capsule.topic != "CodeDevelopment") {
-                        insight_capsule.topic = "GraphData";
-                        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Grafik verisi için içgörü güveni çıkarıldı ve topic 'GraphData' olarak ayarlandı: " << insight_capsule.confidence);
-                        // YENİ LOG: GraphData için topic ayarlandıktan sonraki confidence'ı logla
-                        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] 'GraphData' topic'li kapsül için son confidence: " << insight_capsule.confidence);
-                    } else {
-                        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Grafik verisi içgörüsü, zaten 'CodeDevelopment' topic'ine sahip olduğu için topic değişmedi.");
-                    }
-                } catch (const std::exception& e) {
-                    // Hata durumunda varsayılan bir değer ata veya orijinal urgencyle hesapla
-                    LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] İçgörüden güven değeri çıkarılırken hata: " << e.what() << ". Varsayılan confidence (0.5) kullanılıyor.");
-                    insight_capsule.confidence = 0.5f; // Hata durumunda varsayılan güven değeri
-                    // Ayrıca urgency'den de bir değer atanabilir.
+    if (insight.context == "Sistem Genel Performans Metriği") {
+        // YENİ DÜZELTME: insight.observation string'inden confidence değerini doğru şekilde parse et
+        // Örneğin: "AI sisteminin anlık güven seviyesi: 0.85" -> 0.85
+        // YENİ LOG: Sistem Genel Performans Metriği bağlamı için gözlemi logla
+        LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] 'Sistem Genel Performans Metriği' bağlamı algılandı. Gözlem: " << insight.observation);
+        
+        // "AI sisteminin anlık güven seviyesi: 0.85" formatından sayıyı çekmek için
+        // Son ":" karakterinden sonraki kısmı alalım
+        size_t last_colon_pos = insight.observation.rfind(":");
+        if (last_colon_pos != std::string::npos && last_colon_pos + 1 < insight.observation.length()) {
+            std::string confidence_str = insight.observation.substr(last_colon_pos + 1);
+            try {
+                insight_capsule.confidence = std::stof(confidence_str); // DÜZELTİLDİ: 'pos' yerine 'confidence_str' kullanıldı.
+                // Boşlukları temizleyelim ve float'a çevirelim
+                confidence_str.erase(0, confidence_str.find_first_not_of(" \t\n\r\f\v"));
+                insight_capsule.confidence = std::stof(confidence_str);
+
+                // YENİ LOG: Çıkarılan confidence değerini logla
+                LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Gözlemden çıkarılan confidence değeri: " << insight_capsule.confidence);
+                if (insight_capsule.topic != "CodeDevelopment") {
+                    insight_capsule.topic = "GraphData";
+                    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Grafik verisi için içgörü güveni çıkarıldı ve topic 'GraphData' olarak ayarlandı: " << insight_capsule.confidence);
+                    // YENİ LOG: GraphData için topic ayarlandıktan sonraki confidence'ı logla
+                    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] 'GraphData' topic'li kapsül için son confidence: " << insight_capsule.confidence);
+                } else {
+                    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] Grafik verisi içgörüsü, zaten 'CodeDevelopment' topic'ine sahip olduğu için topic değişmedi.");
                 }
+            } catch (const std::exception& e) {
+                // Hata durumunda varsayılan bir değer ata veya orijinal urgencyle hesapla
+                LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] İçgörüden güven değeri çıkarılırken hata: " << e.what() << ". Varsayılan confidence (0.5) kullanılıyor.");
+                insight_capsule.confidence = 0.5f; // Hata durumunda varsayılan güven değeri
+                // Ayrıca urgency'den de bir değer atanabilir.
             }
         }
+    }
 
-        insight_capsule.timestamp_utc = std::chrono::system_clock::now();
-
-        if (!insight.associated_cryptofig.empty()) {
-            if (insight.associated_cryptofig.size() == CerebrumLux::CryptofigAutoencoder::INPUT_DIM) {
-                insight_capsule.embedding = insight.associated_cryptofig;
-                LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "[LearningModule] AIInsight associated_cryptofig'i Capsule embedding olarak kullanıldı. ID: " << insight.id);
-            } else {
-                insight_capsule.embedding.assign(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.0f);
-                std::copy(insight.associated_cryptofig.begin(),
-                          insight.associated_cryptofig.begin() + std::min((size_t)CerebrumLux::CryptofigAutoencoder::INPUT_DIM, insight.associated_cryptofig.size()),
-                          insight_capsule.embedding.begin());
-                LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] AIInsight associated_cryptofig boyutu INPUT_DIM ile uyuşmuyor. Boyut düzeltildi ve kullanıldı. ID: " << insight.id);
-            }
-        } else {
-            insight_capsule.embedding = compute_embedding(insight_capsule.content);
-            LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] AIInsight için associated_cryptofig boştu. İçerikten yeni embedding hesaplandı. ID: " << insight.id);
-        }
+    insight_capsule.timestamp_utc = std::chrono::system_clock::now();
 
-        if (!insight_capsule.embedding.empty() && insight_capsule.embedding.size() == CerebrumLux::CryptofigAutoencoder::INPUT_DIM) {
-            CerebrumLux::AIAction action = CerebrumLux::AIAction::None;
-            float reward = 0.0f;
-
-            if (insight.urgency == CerebrumLux::UrgencyLevel::Critical) action = CerebrumLux::AIAction::PrioritizeTask;
-            else if (insight.urgency == CerebrumLux::UrgencyLevel::High) action = CerebrumLux::AIAction::SuggestResearch;
-            else if (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion) action = CerebrumLux::AIAction::RefactorCode;
-            else if (insight.urgency == CerebrumLux::UrgencyLevel::None && insight.type == CerebrumLux::InsightType::LearningOpportunity) action = CerebrumLux::AIAction::MaximizeLearning;
-            
-            reward = static_cast<float>(insight.urgency) * 0.1f;
-            if (action == CerebrumLux::AIAction::RefactorCode) reward += 0.2f;
-
-            // DÜZELTİLDİ: update_q_values çağrısı 4 argüman alacak şekilde güncellendi.
-            // next_state_embedding olarak şimdilik current_state_embedding'i kullanıyoruz.
-            update_q_values(insight_capsule.embedding, action, reward, insight_capsule.embedding);
+    if (!insight.associated_cryptofig.empty()) {
+        if (insight.associated_cryptofig.size() == CerebrumLux::CryptofigAutoencoder::INPUT_DIM) {
+            insight_capsule.embedding = insight.associated_cryptofig;
+            LOG_DEFAULT(CerebrumLux::LogLevel::TRACE, "[LearningModule] AIInsight associated_cryptofig'i Capsule embedding olarak kullanıldı. ID: " << insight.id);
         } else {
-            LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Sparse Q-Table güncellenemedi: Embedding boş veya yanlış boyut. ID: " << insight.id);
+            insight_capsule.embedding.assign(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.0f);
+            std::copy(insight.associated_cryptofig.begin(),
+                      insight.associated_cryptofig.begin() + std::min((size_t)CerebrumLux::CryptofigAutoencoder::INPUT_DIM, insight.associated_cryptofig.size()),
+                      insight_capsule.embedding.begin());
+            LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] AIInsight associated_cryptofig boyutu INPUT_DIM ile uyuşmuyor. Boyut düzeltildi ve kullanıldı. ID: " << insight.id);
         }
-        insight_capsule.cryptofig_blob_base64 = cryptofig_encode(insight_capsule.embedding);
-        insight_capsule.code_file_path = insight.code_file_path;
+    } else {
+        insight_capsule.embedding = compute_embedding(insight_capsule.content);
+        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] AIInsight için associated_cryptofig boştu. İçerikten yeni embedding hesaplandı. ID: " << insight.id);
+    }
 
-        knowledgeBase.add_capsule(insight_capsule);
-        emit knowledgeBaseUpdated(); // YENİ: Sinyali yay
-        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "[LearningModule] KnowledgeBase'e içgörü kapsülü EKLENDİ. ID: " << insight_capsule.id << ", Topic: " << insight_capsule.topic << ", Özet: " << insight_capsule.plain_text_summary.substr(0, std::min((size_t)50, insight_capsule.plain_text_summary.length())) << "..." << ", Confidence: " << insight_capsule.confidence);
+    if (!insight_capsule.embedding.empty() && insight_capsule.embedding.size() == CerebrumLux::CryptofigAutoencoder::INPUT_DIM) {
+        CerebrumLux::AIAction action = CerebrumLux::AIAction::None;
+        float reward = 0.0f;
+
+        if (insight.urgency == CerebrumLux::UrgencyLevel::Critical) action = CerebrumLux::AIAction::PrioritizeTask;
+        else if (insight.urgency == CerebrumLux::UrgencyLevel::High) action = CerebrumLux::AIAction::SuggestResearch;
+        else if (insight.type == CerebrumLux::InsightType::CodeDevelopmentSuggestion) action = CerebrumLux::AIAction::RefactorCode;
+        else if (insight.urgency == CerebrumLux::UrgencyLevel::None && insight.type == CerebrumLux::InsightType::LearningOpportunity) action = CerebrumLux::AIAction::MaximizeLearning;
+        
+        reward = static_cast<float>(insight.urgency) * 0.1f;
+        if (action == CerebrumLux::AIAction::RefactorCode) reward += 0.2f;
+
+        // DÜZELTİLDİ: update_q_values çağrısı 4 argüman alacak şekilde güncellendi.
+        // next_state_embedding olarak şimdilik current_state_embedding'i kullanıyoruz.
+        update_q_values(insight_capsule.embedding, action, reward, insight_capsule.embedding);
+    } else {
+        LOG_DEFAULT(CerebrumLux::LogLevel::WARNING, "[LearningModule] Sparse Q-Table güncellenemedi: Embedding boş veya yanlış boyut. ID: " << insight.id);
     }
-    LOG_DEFAULT(CerebrumLux::LogLevel::DEBUG, "[LearningModule] --- İçgörü İşleme Bitti ---");
+    insight_capsule.cryptofig_blob_base64 = cryptofig_encode(insight_capsule.embedding);
+    insight_capsule.code_file_path = insight.code_file_path;
+
+    knowledgeBase.add_capsule(insight_capsule);
+    emit knowledgeBaseUpdated(); // YENİ: Sinyali yay
+    LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "[LearningModule] KnowledgeBase'e içgörü kapsülü EKLENDİ. ID: " << insight_capsule.id << ", Topic: " << insight_capsule.topic << ", Özet: " << insight_capsule.plain_text_summary.substr(0, std::min((size_t)50, insight_capsule.plain_text_summary.length())) << "..." << ", Confidence: " << insight_capsule.confidence);
 }
 
 KnowledgeBase& LearningModule::getKnowledgeBase() {
@@ -322,6 +379,7 @@ const KnowledgeBase& LearningModule::getKnowledgeBase() const {
 }
 
 IngestReport LearningModule::ingest_envelope(const Capsule& envelope, const std::string& signature, const std::string& sender_id) {
+    Metrics::ScopedTimer ingest_timer(ingest_latency());
     IngestReport report;
     report.original_capsule = envelope;
     report.source_peer_id = sender_id;
@@ -513,6 +571,7 @@ bool LearningModule::corroboration_check(const Capsule& capsule) const {
 }
 
 void LearningModule::audit_log_append(const IngestReport& report) const {
+    ingest_result_counter(report.result).inc();
     LOG_DEFAULT(LogLevel::INFO, "[LearningModule] Denetim Kaydı: Kapsül ID: " << report.original_capsule.id
                 << ", Sonuç: " << static_cast<int>(report.result)
                 << ", Mesaj: " << report.message
@@ -527,18 +586,18 @@ void LearningModule::processCodeSuggestionFeedback(const std::string& capsuleId,
     }
 }
 
-void LearningModule::update_q_values(const std::vector<float>& current_state_embedding, CerebrumLux::AIAction action, float reward, const std::vector<float>& next_state_embedding) {
-    // DÜZELTME BAŞLANGICI: EmbeddingStateKey'i embedding vektörünün SHA-256 hash'i olarak oluştur.
-    // Bu, LMDB'nin MDB_BAD_VALSIZE hatasını çözmelidir.
-    // std::vector<float>'ı önce bir string'e (veya byte dizisine) serileştirmemiz ve sonra hashlememiz gerekir.
-    std::string current_embedding_str(reinterpret_cast<const char*>(current_state_embedding.data()), current_state_embedding.size() * sizeof(float));
+// DÜZELTME: EmbeddingStateKey'i embedding vektörünün SHA-256 hash'i olarak oluştur.
+// Bu, LMDB'nin MDB_BAD_VALSIZE hatasını çözmelidir.
+EmbeddingStateKey LearningModule::state_key_for(const std::vector<float>& state_embedding) {
+    // std::vector<float>'ı önce bir byte dizisine serileştirip sonra hashliyoruz.
+    std::string embedding_str(reinterpret_cast<const char*>(state_embedding.data()), state_embedding.size() * sizeof(float));
     // sha256_hash fonksiyonu CryptoUtils.h'de doğrudan CerebrumLux::Crypto namespace'i içinde tanımlandı.
-    EmbeddingStateKey current_state_key = CerebrumLux::Crypto::sha256_hash(current_embedding_str);
+    return CerebrumLux::Crypto::sha256_hash(embedding_str);
+}
 
-    std::string next_embedding_str(reinterpret_cast<const char*>(next_state_embedding.data()), next_state_embedding.size() * sizeof(float));
-    // sha256_hash fonksiyonu CryptoUtils.h'de doğrudan CerebrumLux::Crypto namespace'i içinde tanımlandı.
-    EmbeddingStateKey next_state_key = CerebrumLux::Crypto::sha256_hash(next_embedding_str);
-    // DÜZELTME BİTİŞİ
+void LearningModule::update_q_values(const std::vector<float>& current_state_embedding, CerebrumLux::AIAction action, float reward, const std::vector<float>& next_state_embedding) {
+    EmbeddingStateKey current_state_key = state_key_for(current_state_embedding);
+    EmbeddingStateKey next_state_key = state_key_for(next_state_embedding);
 
     float current_q_value = q_table.q_values[current_state_key][action];
     float learning_rate_rl = 0.1f;
@@ -560,6 +619,7 @@ void LearningModule::update_q_values(const std::vector<float>& current_state_emb
     }
 
     q_table.q_values[current_state_key][action] = current_q_value + learning_rate_rl * (reward + discount_factor * max_next_q - current_q_value);
+    q_index.set(current_state_key, action, q_table.q_values[current_state_key][action]);
     
     LOG_DEFAULT(LogLevel::INFO, "[LearningModule] Q-Table değeri güncellendi. Durum (Kısmi): " << current_state_key.substr(0, std::min((size_t)50, current_state_key.length())) << "..., Eylem: " << CerebrumLux::to_string(action) << ", Ödül: " << reward << ", Yeni Q-Değeri: " << q_table.q_values[current_state_key][action]);
     emit qTableUpdated(); // Q-Table güncellendiğinde sinyal yay
@@ -597,6 +657,7 @@ void LearningModule::load_q_table() {
 
     LOG_DEFAULT(LogLevel::INFO, "[LearningModule] Q-Table LMDB'den yükleniyor.");
     q_table.q_values.clear();
+    q_index.clear();
 
     // SwarmVectorDB'nin açık olduğunu varsayıyoruz (KnowledgeBase tarafından yönetiliyor).
 
@@ -619,6 +680,9 @@ void LearningModule::load_q_table() {
             }
         }
     }
+    for (const auto& state_pair : q_table.q_values) {
+        q_index.set_state(state_pair.first, state_pair.second);
+    }
     LOG_DEFAULT(LogLevel::TRACE, "[LearningModule] load_q_table() EXIT. Q-Table LMDB'den yüklendi. Son q_table boyutu (in-memory): " << q_table.q_values.size());
 
     LOG_DEFAULT(LogLevel::INFO, "[LearningModule] Q-Table yükleme tamamlandı. Toplam yüklü durum: " << q_table.q_values.size());
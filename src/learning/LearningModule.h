@@ -9,11 +9,13 @@
 
 #include "KnowledgeBase.h" // CerebrumLux::KnowledgeBase'i içeriyor
 #include "../communication/ai_insights_engine.h"
+#include "../communication/insight_batch.h"
 #include "../crypto/CryptoManager.h"
 #include "UnicodeSanitizer.h" // Tam tanıma ihtiyaç duyulduğu için eklendi
 #include "../swarm_vectordb/DataModels.h" // SparseQTable için
 #include "../communication/natural_language_processor.h" // generate_text_embedding için
 #include "StegoDetector.h"    // Tam tanıma ihtiyaç duyulduğu için eklendi
+#include "QValueIndex.h"
 #include "WebFetcher.h" // WebFetcher için
 #include "web_page_parser.h" // WebPageParser için
 #include "web_search_result.h" // WebSearchResult için
@@ -78,12 +80,17 @@ public:
     std::vector<Capsule> search_by_topic(const std::string& topic) const;
 
     void process_ai_insights(const std::vector<AIInsight>& insights);
+    void process_ai_insights(const InsightBatch& insights); // Motor döngüsünün tipli yolu
 
     KnowledgeBase& getKnowledgeBase();
     const KnowledgeBase& getKnowledgeBase() const; // Const versiyonu eklendi
     
     // YENİ EKLENDİ: SparseQTable'a erişim için getter
     const CerebrumLux::SwarmVectorDB::SparseQTable& getQTable() const { return q_table; }
+    // Eşzamanlı okunabilen, argmax'ı önceden hesaplanmış Q-değeri görünümü (sömürü adımı için).
+    const QValueIndex& getQValueIndex() const { return q_index; }
+    // update_q_values ile aynı durum anahtarı (embedding baytlarının SHA-256 özeti).
+    static CerebrumLux::SwarmVectorDB::EmbeddingStateKey state_key_for(const std::vector<float>& state_embedding);
 
     // DÜZELTİLDİ: cryptoManager'a erişim için public getter eklendi.
     CerebrumLux::Crypto::CryptoManager& get_crypto_manager() const { return cryptoManager; }
@@ -147,12 +154,15 @@ private:
     bool webFetchInProgress = false;
     QString currentWebFetchQuery;
     CerebrumLux::SwarmVectorDB::SparseQTable q_table; // Sparse Q-Table üyesi eklendi
+    QValueIndex q_index; // q_table ile senkron tutulur
     QTimer* autoSaveTimer; // YENİ: Otomatik kayıt zamanlayıcısı
 
     // RLHF (Human Feedback) için son durumu tutan değişkenler
     std::vector<float> last_interaction_state;
     CerebrumLux::AIAction last_interaction_action = CerebrumLux::AIAction::None;
 
+    void process_ai_insight(const AIInsight& insight);
+
     bool verify_signature(const Capsule& capsule, const std::string& signature, const std::string& sender_id) const;
     Capsule decrypt_payload(const Capsule& encrypted_capsule) const;
     bool schema_validate(const Capsule& capsule) const;
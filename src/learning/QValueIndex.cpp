@@ -0,0 +1,157 @@
+#include "QValueIndex.h"
+
+namespace CerebrumLux {
+
+void QValueIndex::StateValues::recompute_best() {
+    has_best = false;
+    best = BestAction{};
+    // Index 0 == AIAction::None; sömürü adımı None'u geçerli bir eylem saymaz.
+    for (std::size_t i = 1; i < kActionCount; ++i) {
+        if (!present.test(i)) continue;
+        if (!has_best || q_values[i] > best.q_value) {
+            best.action = static_cast<AIAction>(i);
+            best.q_value = q_values[i];
+            has_best = true;
+        }
+    }
+}
+
+QValueIndex::QValueIndex() = default;
+
+void QValueIndex::set(const StateKey& key, AIAction action, float q_value) {
+    Shard& shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    StateValues& entry = shard.states[key];
+    const std::size_t index = action_index(action);
+    const bool was_best = entry.has_best && entry.best.action == action;
+    entry.q_values[index] = q_value;
+    entry.present.set(index);
+    // Sürüm parça kilidi altında artırılır: snapshot() bir sürümü okuduktan sonra o sürüme kadarki
+    // tüm yazımlar ilgili parçada görünür olur.
+    entry.version = shard.version = version_.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    if (index == 0) return;
+    if (was_best && q_value < entry.best.q_value) {
+        // Mevcut en iyi eylemin değeri düştü: argmax değişmiş olabilir.
+        entry.recompute_best();
+    } else if (!entry.has_best || q_value > entry.best.q_value || was_best) {
+        entry.best.action = action;
+        entry.best.q_value = q_value;
+        entry.has_best = true;
+    }
+}
+
+void QValueIndex::set_state(const StateKey& key, const std::map<AIAction, float>& action_values) {
+    StateValues entry;
+    for (const auto& action_pair : action_values) {
+        const std::size_t index = action_index(action_pair.first);
+        entry.q_values[index] = action_pair.second;
+        entry.present.set(index);
+    }
+    entry.recompute_best();
+
+    Shard& shard = shard_for(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    entry.version = shard.version = version_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    shard.states[key] = entry;
+}
+
+void QValueIndex::clear() {
+    for (Shard& shard : shards_) shard.mutex.lock();
+    const std::uint64_t reset = version_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    for (Shard& shard : shards_) {
+        shard.states.clear();
+        shard.version = reset;
+    }
+    reset_version_.store(reset, std::memory_order_release);
+    for (Shard& shard : shards_) shard.mutex.unlock();
+}
+
+std::optional<float> QValueIndex::q_value(const StateKey& key, AIAction action) const {
+    const Shard& shard = shard_for(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.states.find(key);
+    if (it == shard.states.end() || !it->second.has(action)) return std::nullopt;
+    return it->second.value(action);
+}
+
+std::optional<QValueIndex::BestAction> QValueIndex::best_action(const StateKey& key) const {
+    const Shard& shard = shard_for(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.states.find(key);
+    if (it == shard.states.end() || !it->second.has_best) return std::nullopt;
+    return it->second.best;
+}
+
+bool QValueIndex::contains(const StateKey& key) const {
+    const Shard& shard = shard_for(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.states.count(key) != 0;
+}
+
+std::size_t QValueIndex::size() const {
+    std::size_t total = 0;
+    for (const Shard& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.states.size();
+    }
+    return total;
+}
+
+std::shared_ptr<const QValueSnapshot> QValueIndex::snapshot() const {
+    std::lock_guard<std::mutex> snapshot_lock(snapshot_mutex_);
+    const std::uint64_t current = version_.load(std::memory_order_acquire);
+    if (last_snapshot_ && last_snapshot_->version_ == current) return last_snapshot_;
+
+    auto snap = std::make_shared<QValueSnapshot>();
+    snap->version_ = current;
+    snap->reset_version_ = reset_version_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < kShardCount; ++i) {
+        const Shard& shard = shards_[i];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        if (!published_shards_[i] || published_shard_versions_[i] != shard.version) {
+            // Yalnızca değişen parça kopyalanır; diğerleri önceki snapshot ile paylaşılır.
+            published_shards_[i] = std::make_shared<const ShardMap>(shard.states);
+            published_shard_versions_[i] = shard.version;
+        }
+        snap->shards_[i] = published_shards_[i];
+        snap->shard_versions_[i] = published_shard_versions_[i];
+    }
+    last_snapshot_ = snap;
+    return snap;
+}
+
+// --- QValueSnapshot ---
+
+std::size_t QValueSnapshot::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) total += shard->size();
+    return total;
+}
+
+const QValueSnapshot::StateValues* QValueSnapshot::find(const StateKey& key) const {
+    const auto& shard = *shards_[QValueIndex::shard_index(key)];
+    auto it = shard.find(key);
+    return it == shard.end() ? nullptr : &it->second;
+}
+
+std::vector<QValueSnapshot::StateKey> QValueSnapshot::keys() const {
+    std::vector<StateKey> out;
+    out.reserve(size());
+    for_each([&out](const StateKey& key, const StateValues&) { out.push_back(key); });
+    return out;
+}
+
+std::vector<std::pair<QValueSnapshot::StateKey, const QValueSnapshot::StateValues*>>
+QValueSnapshot::changed_since(std::uint64_t since) const {
+    std::vector<std::pair<StateKey, const StateValues*>> out;
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        if (shard_versions_[i] <= since) continue; // Parça o sürümden beri hiç yazılmadı
+        for (const auto& entry : *shards_[i]) {
+            if (entry.second.version > since) out.emplace_back(entry.first, &entry.second);
+        }
+    }
+    return out;
+}
+
+} // namespace CerebrumLux
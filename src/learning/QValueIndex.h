@@ -0,0 +1,144 @@
+#ifndef QVALUE_INDEX_H
+#define QVALUE_INDEX_H
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/enums.h" // AIAction
+
+namespace CerebrumLux {
+
+class QValueSnapshot;
+
+// SparseQTable'ın bellek içi, okuma için optimize edilmiş görünümü.
+//
+// Her durum için eylem Q-değerleri sabit boyutlu bir dizide tutulur ve en iyi eylem (argmax) her yazımda
+// yeniden hesaplanır; böylece meta-evrim döngüsünün sömürü (exploitation) adımı tek bir hash araması ile
+// sonuçlanır. LMDB yalnızca kalıcılık (save_q_table / load_q_table) sırasında kullanılır.
+//
+// Eşzamanlılık: durumlar anahtar hash'ine göre parçalara (shard) bölünür; her parça kendi shared_mutex'i ile
+// korunur. Okuyucular paylaşımlı kilit alır ve birbirini bloklamaz; yazıcı yalnızca ilgili parçayı kilitler.
+//
+// Sürümleme: her yazım global sürümü bir artırır ve yazılan duruma bu sürümü damgalar. snapshot() değişmez
+// (immutable) bir görünüm döndürür; yalnızca son snapshot'tan beri değişen parçalar kopyalanır (copy-on-write),
+// değişmeyen parçalar önceki snapshot ile paylaşılır. Okuyucu thread'ler (ör. QTableWorker) snapshot'ı
+// shared_ptr olarak tutar; yazıcı hiçbir zaman okuyucuyu beklemez.
+class QValueIndex {
+public:
+    using StateKey = std::string; // SwarmVectorDB::EmbeddingStateKey ile aynı
+
+    static constexpr std::size_t kActionCount = static_cast<std::size_t>(AIAction::Evaluate) + 1;
+    static constexpr std::size_t kShardCount = 16;
+
+    struct BestAction {
+        AIAction action = AIAction::None;
+        float q_value = 0.0f;
+    };
+
+    struct StateValues {
+        std::array<float, kActionCount> q_values{};
+        std::bitset<kActionCount> present;
+        BestAction best;
+        bool has_best = false;
+        std::uint64_t version = 0; // Son yazımın global sürümü
+
+        void recompute_best();
+        bool has(AIAction action) const { return present.test(action_index(action)); }
+        float value(AIAction action) const { return q_values[action_index(action)]; }
+    };
+
+    QValueIndex();
+
+    void set(const StateKey& key, AIAction action, float q_value);
+    void set_state(const StateKey& key, const std::map<AIAction, float>& action_values);
+    void clear();
+
+    std::optional<float> q_value(const StateKey& key, AIAction action) const;
+    // AIAction::None dışındaki en yüksek Q-değerli eylem. Durum yoksa veya hiç eylem yoksa boş döner.
+    std::optional<BestAction> best_action(const StateKey& key) const;
+    bool contains(const StateKey& key) const;
+    std::size_t size() const;
+
+    std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+    // O ana kadarki tüm yazımları içeren değişmez görünüm. Sürüm değişmediyse önceki snapshot yeniden döner.
+    std::shared_ptr<const QValueSnapshot> snapshot() const;
+
+    static std::size_t action_index(AIAction action) {
+        const std::size_t index = static_cast<std::size_t>(action);
+        return index < kActionCount ? index : 0;
+    }
+
+private:
+    using ShardMap = std::unordered_map<StateKey, StateValues>;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        ShardMap states;
+        std::uint64_t version = 0; // Parçadaki son yazımın sürümü
+    };
+
+    Shard& shard_for(const StateKey& key) { return shards_[shard_index(key)]; }
+    const Shard& shard_for(const StateKey& key) const { return shards_[shard_index(key)]; }
+    static std::size_t shard_index(const StateKey& key) { return std::hash<StateKey>{}(key) % kShardCount; }
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<std::uint64_t> version_{0};
+    std::atomic<std::uint64_t> reset_version_{0}; // Son clear() sürümü; daha eski delta'lar geçersizdir
+
+    // snapshot() tarafından paylaşılan, son yayımlanmış parça kopyaları.
+    mutable std::mutex snapshot_mutex_;
+    mutable std::array<std::shared_ptr<const ShardMap>, kShardCount> published_shards_;
+    mutable std::array<std::uint64_t, kShardCount> published_shard_versions_{};
+    mutable std::shared_ptr<const QValueSnapshot> last_snapshot_;
+
+    friend class QValueSnapshot;
+};
+
+// QValueIndex'in belirli bir sürümdeki değişmez görünümü. Herhangi bir thread'den kilitsiz okunabilir.
+class QValueSnapshot {
+public:
+    using StateKey = QValueIndex::StateKey;
+    using StateValues = QValueIndex::StateValues;
+
+    std::uint64_t version() const { return version_; }
+    std::size_t size() const;
+    const StateValues* find(const StateKey& key) const;
+
+    std::vector<StateKey> keys() const;
+
+    // since sürümünden sonra yazılan durumlar. requires_full_refresh(since) true ise (arada clear() olmuşsa)
+    // silinen durumlar burada görünmez; okuyucu tam yenileme yapmalıdır.
+    std::vector<std::pair<StateKey, const StateValues*>> changed_since(std::uint64_t since) const;
+    bool requires_full_refresh(std::uint64_t since) const { return since < reset_version_; }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& shard : shards_) {
+            for (const auto& entry : *shard) fn(entry.first, entry.second);
+        }
+    }
+
+private:
+    friend class QValueIndex;
+
+    std::array<std::shared_ptr<const QValueIndex::ShardMap>, QValueIndex::kShardCount> shards_;
+    std::array<std::uint64_t, QValueIndex::kShardCount> shard_versions_{};
+    std::uint64_t version_ = 0;
+    std::uint64_t reset_version_ = 0;
+};
+
+} // namespace CerebrumLux
+
+#endif // QVALUE_INDEX_H
@@ -22,6 +22,7 @@
 #include "core/enums.h"
 #include "core/utils.h" // YENİ EKLENDİ: SafeRNG için (getInstance, shutdown metodları için)
 #include "core/logger.h" // YENİ EKLENDİ: Logger için (getInstance, shutdown metodları için)
+#include "core/metrics_exporter.h" // Prometheus metrik ihracatı için
 #include "sensors/simulated_processor.h" // SimulatedAtomicSignalProcessor için
 #include "data_models/sequence_manager.h"
 #include "brain/intent_analyzer.h"
@@ -157,6 +158,15 @@ int main(int argc, char *argv[])
             }
             throw std::runtime_error("LLMEngine not loaded or global_instance is null for LlamaAdapter inference.");
         });
+        // Yapılandırılmış (JSON şemalı) çağrılar: şema bir kez derlenip önbelleklenir, örnekleyici maskeyle sınırlanır.
+        CerebrumLux::LlamaAdapter::set_structured_inference_fn([](const std::string& prompt, const std::string& json_schema) {
+            if (CerebrumLux::LLMEngine::global_instance && CerebrumLux::LLMEngine::global_instance->is_model_loaded()) {
+                CerebrumLux::LLMGenerationConfig config;
+                config.grammar = CerebrumLux::JsonGrammar::cached(json_schema);
+                return CerebrumLux::LLMEngine::global_instance->generate(prompt, config);
+            }
+            throw std::runtime_error("LLMEngine not loaded or global_instance is null for LlamaAdapter inference.");
+        });
         LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MAIN_APP: LlamaAdapter, LLMEngine ile bağlandı.");
 
     } else {
@@ -189,6 +199,10 @@ int main(int argc, char *argv[])
     early_diagnostic_log << CerebrumLux::get_current_timestamp_str() << " [EARLY DIAGNOSTIC] MainWindow created." << std::endl;
     early_diagnostic_log.flush();
 
+    // CEREBRUMLUX_METRICS_PORT / CEREBRUMLUX_METRICS_FILE tanımlıysa metrikler dışarı verilir.
+    CerebrumLux::MetricsExporter metrics_exporter;
+    metrics_exporter.startFromEnvironment();
+
     window.show();
     early_diagnostic_log << CerebrumLux::get_current_timestamp_str() << " [EARLY DIAGNOSTIC] MainWindow shown." << std::endl;
     early_diagnostic_log.flush();
@@ -200,6 +214,11 @@ int main(int argc, char *argv[])
         try {
             kb.import_from_json("knowledge.json");
             LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MAIN_APP: KnowledgeBase JSON dosyasindan kapsuller basariyla yuklendi.");
+            // Autoencoder'ı yüklenen kapsül embedding'leriyle mini-batch olarak ısıt. Autoencoder'ın diğer kullanıcıları
+            // (sequence güncellemesi, meta evrim döngüsü) da GUI iş parçacığındaki zamanlayıcılardan çalıştığı için
+            // eğitim onlarla yarışmaz; KB boyutunda 256x3 ağırlık için maliyet milisaniyeler mertebesindedir.
+            const float kb_training_rmse = cryptofig_processor.train_autoencoder_on_knowledge_base(kb, 0.01f, 32, 1);
+            LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "MAIN_APP: Autoencoder KnowledgeBase üzerinde eğitildi, ortalama RMSE: " << kb_training_rmse);
         } catch (const std::exception& e) {
             LOG_ERROR_CERR(CerebrumLux::LogLevel::ERR_CRITICAL, "MAIN_APP: KnowledgeBase yuklenirken kritik hata: " << e.what());
             // İsteğe bağlı: Kullanıcıya bir hata mesajı göstermek için GUI'ye bir sinyal gönderilebilir.
@@ -246,6 +265,13 @@ int main(int argc, char *argv[])
     });
     signalCaptureTimer->start(500);
 
+    // Kısıtlanan sekans güncellemelerinin sonuncusu: sinyaller kesildikten sonra da son sinyal sekansa yansır.
+    QTimer* sequenceFlushTimer = new QTimer(&app);
+    QObject::connect(sequenceFlushTimer, &QTimer::timeout, [&]() {
+        sequenceManager.flush_pending_sequence_update(cryptofig_processor);
+    });
+    sequenceFlushTimer->start(50);
+
     early_diagnostic_log << CerebrumLux::get_current_timestamp_str() << " [EARLY DIAGNOSTIC] Entering QApplication::exec()." << std::endl;
     early_diagnostic_log.flush();
 
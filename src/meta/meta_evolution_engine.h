@@ -11,6 +11,7 @@
 #include "../planning_execution/goal_manager.h"
 #include "../brain/cryptofig_processor.h"
 #include "../communication/ai_insights_engine.h"
+#include "../communication/insight_batch.h"
 #include "../learning/LearningModule.h"
 
 // YENİ EKLENDİ (run_self_simulation mantığı için gerekli)
@@ -34,6 +35,12 @@ public:
 
     void run_meta_evolution_cycle(const DynamicSequence& current_sequence);
 
+    // Son döngüde üretilen içgörüler (GUI/dışa aktarım için to_json() ile serileştirilebilir).
+    const InsightBatch& last_insights() const { return insight_batch; }
+
+    static void compute_insight_rewards(const InsightBatch& insights, AIGoal current_goal,
+                                        float& goal_alignment_reward, float& insight_based_reward);
+
 private:
     IntentAnalyzer& analyzer;
     IntentLearner& learner;
@@ -42,6 +49,8 @@ private:
     CryptofigProcessor& cryptofig_processor;
     AIInsightsEngine& insights_engine;
     LearningModule& learning_module;
+
+    InsightBatch insight_batch; // Her döngüde yeniden kullanılır
 };
 
 // StateKey alias'ı global namespace'ten CerebrumLux namespace'ine taşındı (veya uygun yere eklendi)
@@ -2,7 +2,7 @@
 #include "../core/logger.h"
 #include "../core/utils.h" // goal_to_string, intent_to_string için
 #include "../core/enums.h" // AIAction, UserIntent, AbstractState için
-#include "../external/nlohmann/json.hpp" // JSON için
+#include "../communication/insight_batch.h"
 
 namespace CerebrumLux {
 
@@ -25,13 +25,9 @@ void GoalManager::set_current_goal(AIGoal goal) {
 }
 
 void GoalManager::evaluate_and_set_goal(const DynamicSequence& current_sequence) {
-    // İçgörülere ve mevcut duruma göre hedef belirleme lojiği
-    std::vector<AIInsight> insights;
-    std::string insights_json_str; // ✅ DÜZELTME: insights_json_str try bloğunun dışında tanımlandı
-
+    InsightBatch insights;
     try {
-        insights_json_str = insights_engine.generate_insights(current_sequence); // JSON string'ini al
-        LOG_DEFAULT(LogLevel::DEBUG, "GoalManager: AIInsightsEngine'den JSON string alındı. Boyut: " << insights_json_str.length() << " İçerik: " << insights_json_str.substr(0, std::min((size_t)200, insights_json_str.length())));
+        insights_engine.generate_insights(current_sequence, insights);
     } catch (const std::exception& e) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "GoalManager: insights_engine.generate_insights çağrısında hata: " << e.what());
         return; // Hata durumunda döngüyü kes
@@ -39,23 +35,16 @@ void GoalManager::evaluate_and_set_goal(const DynamicSequence& current_sequence)
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "GoalManager: insights_engine.generate_insights çağrısında bilinmeyen hata.");
         return; // Hata durumunda döngüyü kes
     }
+    evaluate_and_set_goal(current_sequence, insights);
+}
 
-    if (!insights_json_str.empty()) {
-        try {
-            nlohmann::json insights_json = nlohmann::json::parse(insights_json_str);
-            insights = insights_json.get<std::vector<AIInsight>>(); // JSON'dan vektöre ayrıştır
-        } catch (const nlohmann::json::exception& e) {
-            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "GoalManager: Insights JSON ayrıştırma hatası: " << e.what());
-            return; // Hata durumunda döngüyü kes
-        } catch (const std::exception& e) {
-            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "GoalManager: Insights JSON'dan dönüştürme hatası: " << e.what());
-            return; // Hata durumunda döngüyü kes
-        }
-    }
-    LOG_DEFAULT(LogLevel::TRACE, "GoalManager: AIInsightsEngine'den " << insights.size() << " adet içgörü alındı (JSON dönüşüm sonrası).");
+void GoalManager::evaluate_and_set_goal(const DynamicSequence& current_sequence, const InsightBatch& insights) {
+    // İçgörülere ve mevcut duruma göre hedef belirleme lojiği
+    LOG_DEFAULT(LogLevel::TRACE, "GoalManager: " << insights.size() << " adet içgörü değerlendiriliyor (tick " << insights.tick() << ").");
 
     // Basit bir örnek:
-    for (const auto& insight : insights) {
+    for (std::size_t i = 0; i < insights.size(); ++i) {
+        const InsightRecord& insight = insights.record(i);
         if (insight.type == InsightType::SecurityAlert && insight.urgency == UrgencyLevel::Critical) {
             set_current_goal(AIGoal::EnsureSecurity);
             return;
@@ -9,6 +9,8 @@
 
 namespace CerebrumLux { // GoalManager sınıfı bu namespace içine alınacak
 
+class InsightBatch; // ../communication/insight_batch.h
+
 class GoalManager {
 public:
     GoalManager(AIInsightsEngine& insights_engine_ref);
@@ -16,6 +18,8 @@ public:
     virtual AIGoal get_current_goal() const;
     void set_current_goal(AIGoal goal);
     void evaluate_and_set_goal(const DynamicSequence& current_sequence);
+    // Motor döngüsünde önceden üretilmiş içgörülerle (içgörüler ikinci kez üretilmez).
+    void evaluate_and_set_goal(const DynamicSequence& current_sequence, const InsightBatch& insights);
 
     void adjust_goals_based_on_feedback(); // Meta-yönetimden çağrılabilir
     void evaluate_goals(); // Mevcut hedefleri değerlendir
@@ -0,0 +1,339 @@
+#include "signal_log.h"
+#include "../core/logger.h" // LOG_DEFAULT için
+#include "../core/utils.h"  // get_current_timestamp_us için
+#include <chrono>
+#include <cstring> // std::memcpy için
+#include <thread>  // std::this_thread::sleep_until için
+
+namespace CerebrumLux {
+
+namespace {
+
+constexpr char SIGNAL_LOG_MAGIC[8] = {'C', 'L', 'S', 'I', 'G', 'L', 'O', 'G'};
+constexpr std::uint32_t SIGNAL_LOG_VERSION = 1;
+
+// Sözlük yalnızca kısa, tekrar etmesi muhtemel stringler için kullanılır.
+constexpr std::size_t DICTIONARY_MAX_ENTRIES = 4096;
+constexpr std::size_t DICTIONARY_MAX_STRING_LENGTH = 64;
+
+// String etiketleri: 0 = boş, 1 = düz (sözlüğe eklenmez), 2 = düz + sözlüğe eklenir, >=3 = sözlük[etiket - 3]
+constexpr std::uint64_t STRING_TAG_EMPTY = 0;
+constexpr std::uint64_t STRING_TAG_LITERAL = 1;
+constexpr std::uint64_t STRING_TAG_LITERAL_ADD = 2;
+constexpr std::uint64_t STRING_TAG_DICT_BASE = 3;
+
+constexpr std::size_t MAX_RECORD_SIZE = 64 * 1024 * 1024; // Bozuk uzunluk önekine karşı koruma
+
+void put_varint(std::string& buffer, std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+bool get_varint(const std::string& buffer, std::size_t& pos, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= buffer.size()) return false;
+        const auto byte = static_cast<unsigned char>(buffer[pos++]);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+std::uint64_t zigzag_encode(long long v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+long long zigzag_decode(std::uint64_t v) {
+    return static_cast<long long>(v >> 1) ^ -static_cast<long long>(v & 1);
+}
+
+void put_float(std::string& buffer, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; ++i) buffer.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+}
+
+bool get_float(const std::string& buffer, std::size_t& pos, float& value) {
+    if (pos + 4 > buffer.size()) return false;
+    std::uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i) bits |= static_cast<std::uint32_t>(static_cast<unsigned char>(buffer[pos + i])) << (8 * i);
+    pos += 4;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool get_byte(const std::string& buffer, std::size_t& pos, unsigned char& value) {
+    if (pos >= buffer.size()) return false;
+    value = static_cast<unsigned char>(buffer[pos++]);
+    return true;
+}
+
+void put_bytes(std::string& buffer, const std::vector<unsigned char>& bytes) {
+    put_varint(buffer, bytes.size());
+    buffer.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+bool get_bytes(const std::string& buffer, std::size_t& pos, std::vector<unsigned char>& bytes) {
+    std::uint64_t length = 0;
+    if (!get_varint(buffer, pos, length) || length > buffer.size() - pos) return false;
+    bytes.assign(buffer.begin() + pos, buffer.begin() + pos + length);
+    pos += length;
+    return true;
+}
+
+} // namespace
+
+// === SignalLogWriter ===
+
+SignalLogWriter::~SignalLogWriter() {
+    close();
+}
+
+bool SignalLogWriter::open(const std::string& path) {
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_.is_open()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SignalLogWriter: Kayıt dosyası açılamadı: " << path);
+        return false;
+    }
+    std::string header(SIGNAL_LOG_MAGIC, sizeof(SIGNAL_LOG_MAGIC));
+    for (int i = 0; i < 4; ++i) header.push_back(static_cast<char>((SIGNAL_LOG_VERSION >> (8 * i)) & 0xFF));
+    out_.write(header.data(), header.size());
+
+    dictionary_.clear();
+    last_timestamp_us_ = 0;
+    signals_written_ = 0;
+    bytes_written_ = header.size();
+    LOG_DEFAULT(LogLevel::INFO, "SignalLogWriter: Sinyal kaydı başlatıldı: " << path);
+    return static_cast<bool>(out_);
+}
+
+void SignalLogWriter::write_string(std::string& buffer, const std::string& str) {
+    if (str.empty()) {
+        put_varint(buffer, STRING_TAG_EMPTY);
+        return;
+    }
+    if (str.size() <= DICTIONARY_MAX_STRING_LENGTH) {
+        // Sözlük küçük tutulduğu için doğrusal arama kayıt maliyetinde ihmal edilebilir.
+        for (std::size_t i = 0; i < dictionary_.size(); ++i) {
+            if (dictionary_[i] == str) {
+                put_varint(buffer, STRING_TAG_DICT_BASE + i);
+                return;
+            }
+        }
+        if (dictionary_.size() < DICTIONARY_MAX_ENTRIES) {
+            dictionary_.push_back(str);
+            put_varint(buffer, STRING_TAG_LITERAL_ADD);
+            put_varint(buffer, str.size());
+            buffer.append(str);
+            return;
+        }
+    }
+    put_varint(buffer, STRING_TAG_LITERAL);
+    put_varint(buffer, str.size());
+    buffer.append(str);
+}
+
+bool SignalLogWriter::write(const AtomicSignal& signal) {
+    if (!out_.is_open()) return false;
+
+    std::string record;
+    record.reserve(64);
+    put_varint(record, zigzag_encode(signal.timestamp_us - last_timestamp_us_));
+    last_timestamp_us_ = signal.timestamp_us;
+
+    record.push_back(static_cast<char>(signal.type));
+    record.push_back(static_cast<char>(signal.key_type));
+    record.push_back(static_cast<char>(signal.event_type));
+    record.push_back(static_cast<char>(signal.mouse_button_state));
+    put_varint(record, zigzag_encode(signal.mouse_x));
+    put_varint(record, zigzag_encode(signal.mouse_y));
+    put_varint(record, zigzag_encode(signal.mouse_delta_x));
+    put_varint(record, zigzag_encode(signal.mouse_delta_y));
+    put_float(record, signal.confidence);
+    record.push_back(static_cast<char>(signal.current_network_active ? 1 : 0));
+    put_varint(record, zigzag_encode(signal.network_activity_level));
+
+    write_string(record, signal.id);
+    write_string(record, signal.value);
+    write_string(record, signal.network_protocol);
+    write_string(record, signal.system_event_type);
+    write_string(record, signal.system_event_data);
+    write_string(record, signal.ai_internal_event_type);
+    write_string(record, signal.ai_internal_event_data);
+    put_bytes(record, signal.raw_audio_data);
+    put_bytes(record, signal.raw_image_data);
+
+    std::string prefix;
+    put_varint(prefix, record.size());
+    out_.write(prefix.data(), prefix.size());
+    out_.write(record.data(), record.size());
+    if (!out_) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SignalLogWriter: Sinyal kaydı yazılamadı.");
+        return false;
+    }
+    ++signals_written_;
+    bytes_written_ += prefix.size() + record.size();
+    return true;
+}
+
+void SignalLogWriter::close() {
+    if (out_.is_open()) {
+        out_.flush();
+        out_.close();
+        LOG_DEFAULT(LogLevel::INFO, "SignalLogWriter: Kayıt kapatıldı. Sinyal: " << signals_written_ << ", Bayt: " << bytes_written_);
+    }
+}
+
+// === SignalLogReader ===
+
+bool SignalLogReader::open(const std::string& path) {
+    close();
+    in_.open(path, std::ios::binary);
+    if (!in_.is_open()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SignalLogReader: Kayıt dosyası açılamadı: " << path);
+        return false;
+    }
+    char header[sizeof(SIGNAL_LOG_MAGIC) + 4];
+    if (!in_.read(header, sizeof(header)) || std::memcmp(header, SIGNAL_LOG_MAGIC, sizeof(SIGNAL_LOG_MAGIC)) != 0) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SignalLogReader: Geçersiz sinyal kayıt dosyası: " << path);
+        in_.close();
+        return false;
+    }
+    std::uint32_t version = 0;
+    for (int i = 0; i < 4; ++i) version |= static_cast<std::uint32_t>(static_cast<unsigned char>(header[sizeof(SIGNAL_LOG_MAGIC) + i])) << (8 * i);
+    if (version != SIGNAL_LOG_VERSION) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SignalLogReader: Desteklenmeyen kayıt sürümü: " << version);
+        in_.close();
+        return false;
+    }
+    dictionary_.clear();
+    last_timestamp_us_ = 0;
+    signals_read_ = 0;
+    return true;
+}
+
+bool SignalLogReader::read_string(const std::string& buffer, std::size_t& pos, std::string& out) {
+    std::uint64_t tag = 0;
+    if (!get_varint(buffer, pos, tag)) return false;
+    if (tag == STRING_TAG_EMPTY) {
+        out.clear();
+        return true;
+    }
+    if (tag >= STRING_TAG_DICT_BASE) {
+        const std::uint64_t index = tag - STRING_TAG_DICT_BASE;
+        if (index >= dictionary_.size()) return false;
+        out = dictionary_[index];
+        return true;
+    }
+    std::uint64_t length = 0;
+    if (!get_varint(buffer, pos, length) || length > buffer.size() - pos) return false;
+    out.assign(buffer, pos, length);
+    pos += length;
+    if (tag == STRING_TAG_LITERAL_ADD) dictionary_.push_back(out);
+    return true;
+}
+
+bool SignalLogReader::next(AtomicSignal& signal) {
+    if (!in_.is_open()) return false;
+
+    // Uzunluk öneki varint olarak akıştan okunur.
+    std::uint64_t length = 0;
+    int shift = 0;
+    for (;;) {
+        const int c = in_.get();
+        if (c == std::char_traits<char>::eof()) return false; // Normal dosya sonu
+        length |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) break;
+        shift += 7;
+        if (shift >= 64) return false;
+    }
+    if (length > MAX_RECORD_SIZE) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "SignalLogReader: Bozuk kayıt uzunluğu: " << length);
+        return false;
+    }
+    record_buffer_.resize(length);
+    if (!in_.read(&record_buffer_[0], static_cast<std::streamsize>(length))) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "SignalLogReader: Kesik kayıt, oynatma sonlandırılıyor.");
+        return false;
+    }
+
+    const std::string& rb = record_buffer_;
+    std::size_t pos = 0;
+    std::uint64_t v = 0;
+    unsigned char b = 0;
+    bool ok = get_varint(rb, pos, v);
+    if (ok) { last_timestamp_us_ += zigzag_decode(v); signal.timestamp_us = last_timestamp_us_; }
+    ok = ok && get_byte(rb, pos, b); signal.type = static_cast<SensorType>(b);
+    ok = ok && get_byte(rb, pos, b); signal.key_type = static_cast<KeyType>(b);
+    ok = ok && get_byte(rb, pos, b); signal.event_type = static_cast<KeyEventType>(b);
+    ok = ok && get_byte(rb, pos, b); signal.mouse_button_state = static_cast<MouseButtonState>(b);
+    ok = ok && get_varint(rb, pos, v); signal.mouse_x = static_cast<int>(zigzag_decode(v));
+    ok = ok && get_varint(rb, pos, v); signal.mouse_y = static_cast<int>(zigzag_decode(v));
+    ok = ok && get_varint(rb, pos, v); signal.mouse_delta_x = static_cast<int>(zigzag_decode(v));
+    ok = ok && get_varint(rb, pos, v); signal.mouse_delta_y = static_cast<int>(zigzag_decode(v));
+    ok = ok && get_float(rb, pos, signal.confidence);
+    ok = ok && get_byte(rb, pos, b); signal.current_network_active = (b != 0);
+    ok = ok && get_varint(rb, pos, v); signal.network_activity_level = static_cast<int>(zigzag_decode(v));
+    ok = ok && read_string(rb, pos, signal.id);
+    ok = ok && read_string(rb, pos, signal.value);
+    ok = ok && read_string(rb, pos, signal.network_protocol);
+    ok = ok && read_string(rb, pos, signal.system_event_type);
+    ok = ok && read_string(rb, pos, signal.system_event_data);
+    ok = ok && read_string(rb, pos, signal.ai_internal_event_type);
+    ok = ok && read_string(rb, pos, signal.ai_internal_event_data);
+    ok = ok && get_bytes(rb, pos, signal.raw_audio_data);
+    ok = ok && get_bytes(rb, pos, signal.raw_image_data);
+
+    if (!ok) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "SignalLogReader: Bozuk sinyal kaydı (#" << signals_read_ << "), oynatma sonlandırılıyor.");
+        return false;
+    }
+    ++signals_read_;
+    return true;
+}
+
+void SignalLogReader::close() {
+    if (in_.is_open()) in_.close();
+}
+
+// === SignalReplayer ===
+
+SignalReplayer::SignalReplayer(double speed, bool restamp)
+    : speed_(speed), restamp_(restamp) {}
+
+SignalReplayer::Stats SignalReplayer::replay(const std::string& path, const std::function<bool(AtomicSignal&)>& on_signal) const {
+    Stats stats;
+    SignalLogReader reader;
+    if (!reader.open(path)) return stats;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    long long first_timestamp_us = 0;
+    long long last_timestamp_us = 0;
+
+    AtomicSignal signal;
+    while (reader.next(signal)) {
+        if (stats.signal_count == 0) first_timestamp_us = signal.timestamp_us;
+        last_timestamp_us = signal.timestamp_us;
+
+        if (speed_ > 0.0) {
+            const double offset_us = static_cast<double>(signal.timestamp_us - first_timestamp_us) / speed_;
+            std::this_thread::sleep_until(wall_start + std::chrono::microseconds(static_cast<long long>(offset_us)));
+        }
+        if (restamp_) signal.timestamp_us = get_current_timestamp_us();
+
+        ++stats.signal_count;
+        if (!on_signal(signal)) break;
+    }
+
+    stats.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    stats.recorded_seconds = static_cast<double>(last_timestamp_us - first_timestamp_us) / 1e6;
+    LOG_DEFAULT(LogLevel::INFO, "SignalReplayer: " << stats.signal_count << " sinyal " << stats.wall_seconds << " sn'de oynatıldı (kayıt süresi: " << stats.recorded_seconds << " sn).");
+    return stats;
+}
+
+} // namespace CerebrumLux
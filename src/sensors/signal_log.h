@@ -0,0 +1,85 @@
+#ifndef SIGNAL_LOG_H
+#define SIGNAL_LOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "atomic_signal.h" // CerebrumLux::AtomicSignal için
+
+namespace CerebrumLux {
+
+// AtomicSignal akışları için kompakt ikili kayıt formatı.
+//
+// Dosya: "CLSIGLOG" + u32 sürüm, ardından her sinyal için varint uzunluk önekli bir kayıt.
+// Zaman damgaları bir öncekine göre zigzag varint delta olarak, tekrar eden stringler
+// (protokol, olay tipi vb.) dosya içi sözlük referansı olarak yazılır.
+class SignalLogWriter {
+public:
+    SignalLogWriter() = default;
+    ~SignalLogWriter();
+
+    bool open(const std::string& path);
+    bool write(const AtomicSignal& signal);
+    void close();
+
+    bool is_open() const { return out_.is_open(); }
+    std::uint64_t signals_written() const { return signals_written_; }
+    std::uint64_t bytes_written() const { return bytes_written_; }
+
+private:
+    void write_string(std::string& buffer, const std::string& str);
+
+    std::ofstream out_;
+    std::vector<std::string> dictionary_;
+    long long last_timestamp_us_ = 0;
+    std::uint64_t signals_written_ = 0;
+    std::uint64_t bytes_written_ = 0;
+};
+
+class SignalLogReader {
+public:
+    bool open(const std::string& path);
+    // Bir sonraki sinyali okur. Dosya sonu veya bozuk kayıtta false döner.
+    bool next(AtomicSignal& signal);
+    void close();
+
+    bool is_open() const { return in_.is_open(); }
+    std::uint64_t signals_read() const { return signals_read_; }
+
+private:
+    bool read_string(const std::string& buffer, std::size_t& pos, std::string& out);
+
+    std::ifstream in_;
+    std::vector<std::string> dictionary_;
+    std::string record_buffer_;
+    long long last_timestamp_us_ = 0;
+    std::uint64_t signals_read_ = 0;
+};
+
+// Kaydedilmiş bir sinyal akışını Qt zamanlayıcıları olmadan, çağıran thread üzerinde yeniden oynatır.
+class SignalReplayer {
+public:
+    struct Stats {
+        std::uint64_t signal_count = 0;
+        double wall_seconds = 0.0;     // Oynatmanın gerçek süresi
+        double recorded_seconds = 0.0; // Kayıttaki ilk ve son sinyal arası süre
+    };
+
+    // speed: 1.0 = kayıt hızında, N = N kat hızlı, 0 (veya negatif) = bekleme olmadan maksimum hız.
+    // restamp: true ise sinyallerin timestamp_us alanı oynatma anına göre yeniden yazılır.
+    explicit SignalReplayer(double speed = 1.0, bool restamp = true);
+
+    // on_signal false döndürürse oynatma durur.
+    Stats replay(const std::string& path, const std::function<bool(AtomicSignal&)>& on_signal) const;
+
+private:
+    double speed_;
+    bool restamp_;
+};
+
+} // namespace CerebrumLux
+
+#endif // SIGNAL_LOG_H
@@ -0,0 +1,147 @@
+#include "AttributeColumns.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+namespace {
+
+void append_u32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
+
+} // namespace
+
+std::string VectorAttributes::encode() const {
+    std::string out;
+    out.reserve(20 + topic.size() + source.size());
+    append_u32(out, static_cast<std::uint32_t>(topic.size()));
+    out += topic;
+    append_u32(out, static_cast<std::uint32_t>(source.size()));
+    out += source;
+    std::uint32_t trust_bits;
+    std::memcpy(&trust_bits, &trust_score, sizeof(trust_bits));
+    append_u32(out, trust_bits);
+    const std::uint64_t ts = static_cast<std::uint64_t>(timestamp_ms);
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((ts >> (8 * i)) & 0xFF));
+    return out;
+}
+
+bool VectorAttributes::decode(const void* data, std::size_t size, VectorAttributes& out) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    auto read_u32 = [&](std::uint32_t& v) {
+        if (end - p < 4) return false;
+        v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        p += 4;
+        return true;
+    };
+    auto read_str = [&](std::string& s) {
+        std::uint32_t len = 0;
+        if (!read_u32(len) || static_cast<std::size_t>(end - p) < len) return false;
+        s.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return true;
+    };
+    std::uint32_t trust_bits = 0;
+    if (!read_str(out.topic) || !read_str(out.source) || !read_u32(trust_bits) || end - p < 8) return false;
+    std::memcpy(&out.trust_score, &trust_bits, sizeof(trust_bits));
+    std::uint64_t ts = 0;
+    for (int i = 0; i < 8; ++i) ts |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    out.timestamp_ms = static_cast<std::int64_t>(ts);
+    return true;
+}
+
+std::uint32_t AttributeColumns::intern(const std::string& value) {
+    auto it = dictionary_.find(value);
+    if (it != dictionary_.end()) return it->second;
+    const std::uint32_t code = static_cast<std::uint32_t>(dictionary_.size());
+    dictionary_.emplace(value, code);
+    return code;
+}
+
+void AttributeColumns::ensure_size(hnswlib::labeltype label) {
+    if (label < live_.size()) return;
+    const std::size_t size = static_cast<std::size_t>(label) + 1;
+    live_.resize(size, 0);
+    topic_.resize(size, kNoCode);
+    source_.resize(size, kNoCode);
+    trust_.resize(size, 0.0f);
+    timestamp_.resize(size, 0);
+}
+
+void AttributeColumns::set(hnswlib::labeltype label, const VectorAttributes& attributes) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    ensure_size(label);
+    if (!live_[label]) ++live_count_;
+    live_[label] = 1;
+    topic_[label] = intern(attributes.topic);
+    source_[label] = intern(attributes.source);
+    trust_[label] = attributes.trust_score;
+    timestamp_[label] = attributes.timestamp_ms;
+}
+
+void AttributeColumns::clear(hnswlib::labeltype label) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (label >= live_.size() || !live_[label]) return;
+    live_[label] = 0;
+    --live_count_;
+}
+
+void AttributeColumns::reset() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    live_.clear();
+    topic_.clear();
+    source_.clear();
+    trust_.clear();
+    timestamp_.clear();
+    dictionary_.clear();
+    live_count_ = 0;
+}
+
+AttributeColumns::CompiledFilter AttributeColumns::compile(const VectorFilter& filter) const {
+    CompiledFilter compiled;
+    auto to_codes = [&](const std::vector<std::string>& values, std::vector<std::uint32_t>& codes) {
+        for (const std::string& value : values) {
+            auto it = dictionary_.find(value);
+            if (it != dictionary_.end()) codes.push_back(it->second);
+        }
+        std::sort(codes.begin(), codes.end());
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+        // İstenen değerlerin hiçbiri hiç görülmediyse hiçbir etiket eşleşemez.
+        return values.empty() || !codes.empty();
+    };
+    if (!to_codes(filter.topics, compiled.topics) || !to_codes(filter.sources, compiled.sources)) compiled.impossible = true;
+    if (filter.min_trust) compiled.min_trust = *filter.min_trust;
+    if (filter.from_ms) compiled.from_ms = *filter.from_ms;
+    if (filter.to_ms) compiled.to_ms = *filter.to_ms;
+    if (compiled.from_ms > compiled.to_ms) compiled.impossible = true;
+    return compiled;
+}
+
+bool AttributeColumns::matches(hnswlib::labeltype label, const CompiledFilter& filter) const {
+    if (filter.impossible || label >= live_.size() || !live_[label]) return false;
+    if (!filter.topics.empty() && !std::binary_search(filter.topics.begin(), filter.topics.end(), topic_[label])) return false;
+    if (!filter.sources.empty() && !std::binary_search(filter.sources.begin(), filter.sources.end(), source_[label])) return false;
+    if (trust_[label] < filter.min_trust) return false;
+    const std::int64_t ts = timestamp_[label];
+    return ts >= filter.from_ms && ts <= filter.to_ms;
+}
+
+std::vector<hnswlib::labeltype> AttributeColumns::matching_labels(const CompiledFilter& filter, std::size_t limit) const {
+    std::vector<hnswlib::labeltype> labels;
+    if (filter.impossible) return labels;
+    for (std::size_t label = 0; label < live_.size(); ++label) {
+        if (!matches(label, filter)) continue;
+        labels.push_back(label);
+        if (labels.size() > limit) break;
+    }
+    return labels;
+}
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
@@ -0,0 +1,104 @@
+#ifndef SWARM_VECTORDB_ATTRIBUTECOLUMNS_H
+#define SWARM_VECTORDB_ATTRIBUTECOLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <hnswlib/hnswlib.h>
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+// Filtrelenebilir vektör nitelikleri. LMDB'de "vector_attributes_db" içinde ID anahtarıyla saklanır.
+struct VectorAttributes {
+    std::string topic;
+    std::string source;
+    float trust_score = 1.0f;
+    std::int64_t timestamp_ms = 0; // Unix epoch ms; 0 = bilinmiyor (nitelik kaydı olmadan eklenmiş eski vektörler)
+
+    // Kodlama (little-endian): u32 len | topic | u32 len | source | f32 trust | i64 timestamp
+    std::string encode() const;
+    static bool decode(const void* data, std::size_t size, VectorAttributes& out);
+};
+
+// Arama filtresi. Boş bırakılan alan filtrelenmez; dolu alanların hepsi sağlanmalıdır (AND).
+struct VectorFilter {
+    std::vector<std::string> topics;   // Herhangi biri (OR)
+    std::vector<std::string> sources;  // Herhangi biri (OR)
+    std::optional<float> min_trust;
+    std::optional<std::int64_t> from_ms; // Dahil
+    std::optional<std::int64_t> to_ms;   // Dahil
+
+    bool empty() const {
+        return topics.empty() && sources.empty() && !min_trust && !from_ms && !to_ms;
+    }
+};
+
+// HNSW etiketine göre dizilmiş sıkıştırılmış nitelik sütunları (etiket başına ~21 bayt).
+// Konu ve kaynak sözlükle tamsayı koduna çevrilir; böylece graf araması sırasındaki filtre kontrolü
+// string karşılaştırması yapmadan birkaç dizi okumasıyla biter.
+//
+// Yazmalar (set/clear/reset) kendi özel kilidini alır. compile/matches/matching_labels okuma kilidi altında
+// çağrılmalıdır: arama boyunca read_lock() tutulur, böylece graf araması sırasında sütunlar değişmez.
+class AttributeColumns {
+public:
+    struct CompiledFilter {
+        std::vector<std::uint32_t> topics;  // Sıralı kodlar; boşsa tümü
+        std::vector<std::uint32_t> sources;
+        float min_trust = -std::numeric_limits<float>::infinity();
+        std::int64_t from_ms = std::numeric_limits<std::int64_t>::min();
+        std::int64_t to_ms = std::numeric_limits<std::int64_t>::max();
+        bool impossible = false; // Ör. sözlükte olmayan bir konu istendi
+    };
+
+    void set(hnswlib::labeltype label, const VectorAttributes& attributes);
+    void clear(hnswlib::labeltype label);
+    void reset();
+
+    std::shared_lock<std::shared_mutex> read_lock() const { return std::shared_lock<std::shared_mutex>(mutex_); }
+
+    CompiledFilter compile(const VectorFilter& filter) const;
+    bool matches(hnswlib::labeltype label, const CompiledFilter& filter) const;
+    // Filtreyi sağlayan etiketler; limit aşılırsa limit + 1 eleman döner (çağıran seçiciliği buradan anlar).
+    std::vector<hnswlib::labeltype> matching_labels(const CompiledFilter& filter,
+                                                    std::size_t limit = std::numeric_limits<std::size_t>::max() - 1) const;
+    std::size_t live_count() const { return live_count_; }
+
+private:
+    static constexpr std::uint32_t kNoCode = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t intern(const std::string& value);
+    void ensure_size(hnswlib::labeltype label);
+
+    std::vector<std::uint8_t> live_;
+    std::vector<std::uint32_t> topic_;
+    std::vector<std::uint32_t> source_;
+    std::vector<float> trust_;
+    std::vector<std::int64_t> timestamp_;
+    std::unordered_map<std::string, std::uint32_t> dictionary_;
+    std::size_t live_count_ = 0;
+    mutable std::shared_mutex mutex_;
+};
+
+// hnswlib'in graf araması sırasında her aday etiket için çağırdığı filtre.
+class AttributeFilterFunctor : public hnswlib::BaseFilterFunctor {
+public:
+    AttributeFilterFunctor(const AttributeColumns& columns, const AttributeColumns::CompiledFilter& filter)
+        : columns_(columns), filter_(filter) {}
+    bool operator()(hnswlib::labeltype label) override { return columns_.matches(label, filter_); }
+
+private:
+    const AttributeColumns& columns_;
+    const AttributeColumns::CompiledFilter& filter_;
+};
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
+
+#endif // SWARM_VECTORDB_ATTRIBUTECOLUMNS_H
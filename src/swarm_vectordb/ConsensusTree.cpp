@@ -0,0 +1,246 @@
+#include "ConsensusTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <openssl/sha.h>
+
+#include "../core/logger.h" // LOG_DEFAULT için
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+namespace {
+
+constexpr std::uint8_t kLeafPrefix = 0x00;
+constexpr std::uint8_t kNodePrefix = 0x01;
+constexpr std::uint8_t kBucketPrefix = 0x02;
+constexpr std::uint8_t kEncodingVersion = 0x01;
+
+const SwarmConsensusTree::Hash kEmptyHash{};
+
+void put_u32(std::string& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void put_bytes(std::string& out, const void* data, std::size_t size) {
+    put_u32(out, static_cast<std::uint32_t>(size));
+    out.append(static_cast<const char*>(data), size);
+}
+
+std::uint32_t canonical_float_bits(float value) {
+    if (std::isnan(value)) return 0x7FC00000u;
+    if (value == 0.0f) return 0u; // -0.0 ve +0.0 aynı kodlanır
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+SwarmConsensusTree::SwarmConsensusTree(unsigned depth)
+    : depth_(std::min(std::max(depth, 1u), kMaxDepth)),
+      nodes_(std::size_t{2} << depth_),
+      counts_(std::size_t{2} << depth_, 0),
+      buckets_(std::size_t{1} << depth_) {
+    LOG_DEFAULT(LogLevel::INFO, "SwarmConsensusTree: Başlatıldı. Derinlik: " << depth_);
+}
+
+std::string SwarmConsensusTree::canonical_encoding(const CryptofigVector& cv) {
+    std::string out;
+    out.reserve(32 + cv.id.size() + cv.content_hash.size() + cv.topic.size() + cv.fisher_query.size() +
+                cv.cryptofig.size() + 4 * static_cast<std::size_t>(cv.embedding.size()));
+    out.push_back(static_cast<char>(kEncodingVersion));
+    put_bytes(out, cv.id.data(), cv.id.size());
+    put_bytes(out, cv.content_hash.data(), cv.content_hash.size());
+    put_bytes(out, cv.topic.data(), cv.topic.size());
+    put_bytes(out, cv.fisher_query.data(), cv.fisher_query.size());
+    put_bytes(out, cv.cryptofig.data(), cv.cryptofig.size());
+    put_u32(out, static_cast<std::uint32_t>(cv.embedding.size()));
+    for (Eigen::Index i = 0; i < cv.embedding.size(); ++i) put_u32(out, canonical_float_bits(cv.embedding(i)));
+    return out;
+}
+
+SwarmConsensusTree::Hash SwarmConsensusTree::hash_bytes(const std::string& bytes) {
+    Hash hash;
+    SHA256(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), hash.data());
+    return hash;
+}
+
+SwarmConsensusTree::Hash SwarmConsensusTree::leaf_hash(const CryptofigVector& cv) {
+    std::string bytes(1, static_cast<char>(kLeafPrefix));
+    bytes += canonical_encoding(cv);
+    return hash_bytes(bytes);
+}
+
+std::string SwarmConsensusTree::to_hex(const Hash& hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(hash.size() * 2, '0');
+    for (std::size_t i = 0; i < hash.size(); ++i) {
+        out[2 * i] = digits[hash[i] >> 4];
+        out[2 * i + 1] = digits[hash[i] & 0x0F];
+    }
+    return out;
+}
+
+std::size_t SwarmConsensusTree::bucket_of(const std::string& id) const {
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const unsigned char*>(id.data()), id.size(), digest);
+    const std::uint32_t prefix = (std::uint32_t{digest[0]} << 24) | (std::uint32_t{digest[1]} << 16) |
+                                 (std::uint32_t{digest[2]} << 8) | std::uint32_t{digest[3]};
+    return static_cast<std::size_t>(prefix >> (32 - depth_));
+}
+
+void SwarmConsensusTree::rehash_bucket(std::size_t bucket) {
+    const std::map<std::string, Hash>& entries = buckets_[bucket];
+    const std::size_t node = node_index(depth_, bucket);
+    counts_[node] = static_cast<std::uint32_t>(entries.size());
+    if (entries.empty()) {
+        nodes_[node] = kEmptyHash;
+        return;
+    }
+    std::string bytes(1, static_cast<char>(kBucketPrefix));
+    for (const auto& entry : entries) {
+        put_bytes(bytes, entry.first.data(), entry.first.size());
+        bytes.append(reinterpret_cast<const char*>(entry.second.data()), entry.second.size());
+    }
+    nodes_[node] = hash_bytes(bytes);
+}
+
+void SwarmConsensusTree::rehash_dirty(std::vector<std::size_t>& dirty_buckets) {
+    std::sort(dirty_buckets.begin(), dirty_buckets.end());
+    dirty_buckets.erase(std::unique(dirty_buckets.begin(), dirty_buckets.end()), dirty_buckets.end());
+    for (std::size_t bucket : dirty_buckets) rehash_bucket(bucket);
+
+    // Seviye seviye yukarı çık: kardeş kovaların ortak ebeveyni yalnızca bir kez hash'lenir.
+    std::vector<std::size_t> level_nodes;
+    level_nodes.reserve(dirty_buckets.size());
+    for (std::size_t bucket : dirty_buckets) level_nodes.push_back(node_index(depth_, bucket));
+
+    std::string bytes;
+    bytes.reserve(1 + 2 * kEmptyHash.size());
+    while (!level_nodes.empty() && level_nodes.front() > 1) {
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < level_nodes.size(); ++i) {
+            const std::size_t parent = level_nodes[i] >> 1;
+            if (out > 0 && level_nodes[out - 1] == parent) continue;
+            level_nodes[out++] = parent;
+
+            const std::size_t left = parent << 1;
+            counts_[parent] = counts_[left] + counts_[left + 1];
+            if (counts_[parent] == 0) {
+                nodes_[parent] = kEmptyHash;
+                continue;
+            }
+            bytes.assign(1, static_cast<char>(kNodePrefix));
+            bytes.append(reinterpret_cast<const char*>(nodes_[left].data()), nodes_[left].size());
+            bytes.append(reinterpret_cast<const char*>(nodes_[left + 1].data()), nodes_[left + 1].size());
+            nodes_[parent] = hash_bytes(bytes);
+        }
+        level_nodes.resize(out);
+    }
+}
+
+void SwarmConsensusTree::update_tree(const CryptofigVector& cv) {
+    set_leaf(cv.id, leaf_hash(cv));
+}
+
+void SwarmConsensusTree::update_batch(const std::vector<CryptofigVector>& cvs) {
+    // Yaprak hash'leri kilit dışında hesaplanır; kilit altında yalnızca ağaç güncellenir.
+    std::vector<std::pair<std::string, Hash>> leaves;
+    leaves.reserve(cvs.size());
+    for (const auto& cv : cvs) leaves.emplace_back(cv.id, leaf_hash(cv));
+    set_leaves(leaves);
+}
+
+void SwarmConsensusTree::set_leaf(const std::string& id, const Hash& leaf) {
+    const std::size_t bucket = bucket_of(id);
+    std::lock_guard<std::mutex> lock(mutex_); // Thread güvenliği
+    buckets_[bucket][id] = leaf;
+    std::vector<std::size_t> dirty{bucket};
+    rehash_dirty(dirty);
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmConsensusTree: Ağaç güncellendi. ID: " << id);
+}
+
+void SwarmConsensusTree::set_leaves(const std::vector<std::pair<std::string, Hash>>& leaves) {
+    if (leaves.empty()) return;
+    std::vector<std::size_t> dirty;
+    dirty.reserve(leaves.size());
+    for (const auto& leaf : leaves) dirty.push_back(bucket_of(leaf.first));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < leaves.size(); ++i) buckets_[dirty[i]][leaves[i].first] = leaves[i].second;
+    rehash_dirty(dirty);
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmConsensusTree: Toplu güncelleme. Yaprak sayısı: " << leaves.size());
+}
+
+bool SwarmConsensusTree::remove(const std::string& id) {
+    return remove_batch({id}) == 1;
+}
+
+std::size_t SwarmConsensusTree::remove_batch(const std::vector<std::string>& ids) {
+    std::vector<std::size_t> buckets;
+    buckets.reserve(ids.size());
+    for (const auto& id : ids) buckets.push_back(bucket_of(id));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::size_t> dirty;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (buckets_[buckets[i]].erase(ids[i]) > 0) dirty.push_back(buckets[i]);
+    }
+    const std::size_t removed = dirty.size();
+    rehash_dirty(dirty);
+    return removed;
+}
+
+void SwarmConsensusTree::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& bucket : buckets_) bucket.clear();
+    std::fill(nodes_.begin(), nodes_.end(), kEmptyHash);
+    std::fill(counts_.begin(), counts_.end(), 0);
+}
+
+SwarmConsensusTree::Hash SwarmConsensusTree::root() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodes_[1];
+}
+
+std::string SwarmConsensusTree::get_root_hash() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counts_[1] == 0 ? std::string() : to_hex(nodes_[1]);
+}
+
+SwarmConsensusTree::Hash SwarmConsensusTree::subtree_hash(unsigned level, std::size_t index) const {
+    if (level > depth_ || index >= (std::size_t{1} << level)) return kEmptyHash;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodes_[node_index(level, index)];
+}
+
+std::size_t SwarmConsensusTree::subtree_size(unsigned level, std::size_t index) const {
+    if (level > depth_ || index >= (std::size_t{1} << level)) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counts_[node_index(level, index)];
+}
+
+std::vector<std::pair<std::string, SwarmConsensusTree::Hash>> SwarmConsensusTree::bucket_entries(std::size_t bucket) const {
+    if (bucket >= buckets_.size()) return {};
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {buckets_[bucket].begin(), buckets_[bucket].end()};
+}
+
+std::optional<SwarmConsensusTree::Hash> SwarmConsensusTree::leaf(const std::string& id) const {
+    const std::size_t bucket = bucket_of(id);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buckets_[bucket].find(id);
+    if (it == buckets_[bucket].end()) return std::nullopt;
+    return it->second;
+}
+
+std::size_t SwarmConsensusTree::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counts_[1];
+}
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
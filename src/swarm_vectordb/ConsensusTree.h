@@ -0,0 +1,95 @@
+#ifndef SWARM_VECTORDB_CONSENSUSTREE_H
+#define SWARM_VECTORDB_CONSENSUSTREE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataModels.h" // CryptofigVector için
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+// Sürü Konsensüs Ağacı (artımlı Merkle ağacı)
+//
+// Anahtar uzayı, ID'nin SHA-256 özetinin ilk `depth` biti ile 2^depth kovaya bölünür; ağaç bu kovalar üzerinde
+// sabit derinlikli, dizi (heap) düzeninde bir ikili Merkle ağacıdır. Bu sayede:
+//  - Kök hash ekleme sırasından bağımsızdır; aynı yaprak kümesine sahip iki düğüm aynı kökü üretir.
+//  - Bir güncelleme yalnızca ilgili kovayı ve kökten o kovaya giden `depth` düğümü yeniden hash'ler.
+//  - (level, index) alt ağaçları ID-özet aralıklarına karşılık gelir; iki ağaç alt ağaç hash'leri
+//    karşılaştırılarak yalnızca farklı aralıklara inilebilir.
+//
+// Hash tanımları (SHA-256, alan ayrımı için önek baytı ile):
+//  - yaprak  = H(0x00 || canonical_encoding(cv))
+//  - kova    = H(0x02 || her (id, yaprak) için, id'ye göre sıralı: u32le(len(id)) || id || yaprak)
+//  - iç düğüm = H(0x01 || sol || sağ)
+// Boş kova / boş alt ağaç hash'i 32 sıfır bayttır.
+class SwarmConsensusTree {
+public:
+    using Hash = std::array<std::uint8_t, 32>;
+
+    static constexpr unsigned kDefaultDepth = 12; // 4096 kova
+    static constexpr unsigned kMaxDepth = 20;
+
+    explicit SwarmConsensusTree(unsigned depth = kDefaultDepth);
+
+    // CryptofigVector'ün platformdan bağımsız ikili kodlaması: sabit genişlikli little-endian uzunluklar,
+    // float'lar IEEE-754 bit desenleriyle (-0.0 -> +0.0, tüm NaN'lar tek kanonik NaN).
+    static std::string canonical_encoding(const CryptofigVector& cv);
+    static Hash leaf_hash(const CryptofigVector& cv);
+    static Hash hash_bytes(const std::string& bytes);
+
+    // CryptofigVector'den hash oluşturur ve ağacı günceller (aynı ID varsa yaprağı değiştirir).
+    void update_tree(const CryptofigVector& cv);
+    // Toplu güncelleme: her kova ve her iç düğüm en fazla bir kez yeniden hash'lenir.
+    void update_batch(const std::vector<CryptofigVector>& cvs);
+
+    // Yaprak özeti dışarıda hesaplanan kayıtlar için (ör. kapsül içeriği de dahil edilecekse).
+    void set_leaf(const std::string& id, const Hash& leaf);
+    void set_leaves(const std::vector<std::pair<std::string, Hash>>& leaves);
+    bool remove(const std::string& id);
+    std::size_t remove_batch(const std::vector<std::string>& ids);
+    void clear();
+
+    // Kök hash'i hex olarak döndürür (ağaç boşsa boş string).
+    std::string get_root_hash() const;
+    Hash root() const;
+
+    // level 0 = kök, level == depth() = kovalar; index < 2^level.
+    Hash subtree_hash(unsigned level, std::size_t index) const;
+    std::size_t subtree_size(unsigned level, std::size_t index) const;
+
+    // ID'nin düştüğü kova (level == depth() indeksi).
+    std::size_t bucket_of(const std::string& id) const;
+    // Kovadaki (id, yaprak) çiftleri, id'ye göre sıralı.
+    std::vector<std::pair<std::string, Hash>> bucket_entries(std::size_t bucket) const;
+    std::optional<Hash> leaf(const std::string& id) const;
+
+    std::size_t size() const;
+    unsigned depth() const { return depth_; }
+
+    static std::string to_hex(const Hash& hash);
+
+private:
+    std::size_t node_index(unsigned level, std::size_t index) const { return (std::size_t{1} << level) + index; }
+    void rehash_bucket(std::size_t bucket);
+    // Kirli kovaları yeniden hash'ler ve köke kadar olan yolları (birleşimi) günceller.
+    void rehash_dirty(std::vector<std::size_t>& dirty_buckets);
+
+    unsigned depth_;
+    std::vector<Hash> nodes_;            // 1 tabanlı heap: düğüm i'nin çocukları 2i ve 2i+1
+    std::vector<std::uint32_t> counts_;  // Alt ağaçtaki yaprak sayısı
+    std::vector<std::map<std::string, Hash>> buckets_;
+    mutable std::mutex mutex_; // Thread güvenliği için
+};
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
+
+#endif // SWARM_VECTORDB_CONSENSUSTREE_H
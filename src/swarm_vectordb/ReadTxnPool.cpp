@@ -0,0 +1,220 @@
+#include "ReadTxnPool.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+namespace {
+
+// Yaşayan havuzlar; sona eren iş parçacıkları önbelleklerini yalnızca hâlâ var olan havuzlara geri verir.
+std::mutex& registry_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::unordered_map<std::uint64_t, ReadTxnPool*>& registry() {
+    static std::unordered_map<std::uint64_t, ReadTxnPool*> pools;
+    return pools;
+}
+
+std::uint64_t next_pool_uid() {
+    static std::atomic<std::uint64_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+struct ThreadTxnCache {
+    struct Entry {
+        std::uint64_t pool_uid;
+        std::uint64_t epoch;
+        MDB_txn* txn; // null: bu iş parçacığının transaction'ı şu an bir Lease'te
+        std::size_t gate_holds = 0; // Bu iş parçacığında yaşayan kira sayısı
+        std::shared_lock<std::shared_mutex> gate; // gate_holds > 0 iken kilitli
+    };
+    std::vector<Entry> entries;
+
+    ~ThreadTxnCache() {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for (const Entry& entry : entries) {
+            if (!entry.txn) continue;
+            auto it = registry().find(entry.pool_uid);
+            if (it != registry().end()) it->second->give_back(entry.epoch, entry.txn);
+        }
+    }
+
+    Entry* find(std::uint64_t pool_uid) {
+        for (Entry& entry : entries) {
+            if (entry.pool_uid == pool_uid) return &entry;
+        }
+        return nullptr;
+    }
+
+    Entry& find_or_add(std::uint64_t pool_uid, std::uint64_t epoch) {
+        if (Entry* entry = find(pool_uid)) return *entry;
+        entries.push_back({pool_uid, epoch, nullptr});
+        return entries.back();
+    }
+};
+
+namespace {
+thread_local ThreadTxnCache t_txn_cache;
+} // namespace
+
+// --- Lease ---
+
+ReadTxnPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), txn_(other.txn_) {
+    other.pool_ = nullptr;
+    other.txn_ = nullptr;
+}
+
+ReadTxnPool::Lease& ReadTxnPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (pool_ && txn_) pool_->release(txn_);
+        pool_ = other.pool_;
+        txn_ = other.txn_;
+        other.pool_ = nullptr;
+        other.txn_ = nullptr;
+    }
+    return *this;
+}
+
+ReadTxnPool::Lease::~Lease() {
+    if (pool_ && txn_) pool_->release(txn_);
+}
+
+// --- ReadTxnPool ---
+
+ReadTxnPool::ReadTxnPool(std::shared_mutex& gate) : gate_(gate), uid_(next_pool_uid()) {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().emplace(uid_, this);
+}
+
+ReadTxnPool::~ReadTxnPool() {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        registry().erase(uid_);
+    }
+    detach();
+}
+
+void ReadTxnPool::attach(MDB_env* env) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    env_ = env;
+}
+
+void ReadTxnPool::detach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // İş parçacığı önbelleklerindeki girdiler epoch uyuşmazlığıyla geçersizleşir; gösterdikleri transaction'lar
+    // burada kapatılır ve bir daha kullanılmaz.
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (MDB_txn* txn : all_) mdb_txn_abort(txn);
+    all_.clear();
+    idle_.clear();
+    env_ = nullptr;
+}
+
+void ReadTxnPool::lock_gate() {
+    ThreadTxnCache::Entry& entry = t_txn_cache.find_or_add(uid_, epoch_.load(std::memory_order_acquire));
+    if (entry.gate_holds++ == 0) entry.gate = std::shared_lock<std::shared_mutex>(gate_);
+}
+
+void ReadTxnPool::unlock_gate() {
+    ThreadTxnCache::Entry* entry = t_txn_cache.find(uid_);
+    if (entry && entry->gate_holds > 0 && --entry->gate_holds == 0) entry->gate.unlock();
+}
+
+ReadTxnPool::Lease ReadTxnPool::acquire() {
+    Lease lease;
+    lock_gate();
+    const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+
+    MDB_txn* txn = nullptr;
+    ThreadTxnCache::Entry* cached = t_txn_cache.find(uid_);
+    if (cached->epoch != epoch) {
+        // Havuz bu iş parçacığı önbelleğe aldıktan sonra kapatılıp yeniden açılmış.
+        cached->epoch = epoch;
+        cached->txn = nullptr;
+    }
+    if (cached->txn) {
+        txn = cached->txn;
+        cached->txn = nullptr;
+    }
+
+    MDB_env* env = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        env = env_;
+        if (!txn && !idle_.empty()) {
+            txn = idle_.back();
+            idle_.pop_back();
+        }
+    }
+    if (!env) {
+        unlock_gate();
+        return lease;
+    }
+
+    if (txn) {
+        if (mdb_txn_renew(txn) == MDB_SUCCESS) {
+            reused_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            discard(txn);
+            txn = nullptr;
+        }
+    }
+    if (!txn) {
+        if (mdb_txn_begin(env, nullptr, MDB_RDONLY, &txn) != MDB_SUCCESS) {
+            unlock_gate();
+            return lease;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        all_.push_back(txn);
+        created_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    lease.pool_ = this;
+    lease.txn_ = txn;
+    return lease;
+}
+
+void ReadTxnPool::release(MDB_txn* txn) {
+    // Kapı hâlâ paylaşımlı tutuluyor: detach bu sırada çalışamaz.
+    mdb_txn_reset(txn);
+    const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    ThreadTxnCache::Entry& cached = t_txn_cache.find_or_add(uid_, epoch);
+    if (!cached.txn || cached.epoch != epoch) {
+        cached.epoch = epoch;
+        cached.txn = txn;
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(txn);
+    }
+    unlock_gate();
+}
+
+void ReadTxnPool::give_back(std::uint64_t epoch, MDB_txn* txn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ && epoch == epoch_.load(std::memory_order_acquire)) idle_.push_back(txn);
+}
+
+void ReadTxnPool::discard(MDB_txn* txn) {
+    mdb_txn_abort(txn);
+    std::lock_guard<std::mutex> lock(mutex_);
+    all_.erase(std::remove(all_.begin(), all_.end(), txn), all_.end());
+}
+
+ReadTxnPool::Stats ReadTxnPool::stats() const {
+    Stats stats;
+    stats.created = created_.load(std::memory_order_relaxed);
+    stats.reused = reused_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.idle = idle_.size();
+    return stats;
+}
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
@@ -0,0 +1,88 @@
+#ifndef SWARM_VECTORDB_READTXNPOOL_H
+#define SWARM_VECTORDB_READTXNPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <lmdb.h>
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+// LMDB okuma transaction'ı havuzu. Ortam MDB_NOTLS ile açıldığından sıfırlanmış (mdb_txn_reset) bir transaction
+// herhangi bir iş parçacığında mdb_txn_renew ile yeniden kullanılabilir; böylece her okuma için okuyucu yuvası
+// ayırma ve malloc maliyeti ödenmez.
+//
+// Her iş parçacığı son kullandığı transaction'ı kendi önbelleğinde tutar (kilitsiz yol); ikinci bir eşzamanlı okuma
+// veya önbelleği boş iş parçacıkları küçük bir kilitle korunan ortak boşta listesini kullanır. İş parçacığı sona
+// erince önbelleğindeki transaction havuza geri verilir.
+//
+// Lease, ömrü boyunca harita büyütme kapısını (gate) paylaşımlı tutar; attach/detach kapı özel tutulurken çağrılır.
+// Kapı iş parçacığı başına bir kez kilitlenir: aynı iş parçacığındaki iç içe kiralar (ör. kira tutarken get_vector)
+// kapıyı yeniden kilitlemez, yalnızca sayacı artırır; kapı son kira bırakılınca çözülür. std::shared_mutex'i aynı
+// iş parçacığında ikinci kez paylaşımlı kilitlemek tanımsızdır ve yazar öncelikli uygulamalarda bekleyen bir harita
+// büyütmesiyle kilitlenir. Bu yüzden Lease onu alan iş parçacığında bırakılmalıdır (başka iş parçacığına taşınmamalı).
+class ReadTxnPool {
+public:
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        MDB_txn* get() const { return txn_; }
+        explicit operator bool() const { return txn_ != nullptr; }
+
+    private:
+        friend class ReadTxnPool;
+        ReadTxnPool* pool_ = nullptr;
+        MDB_txn* txn_ = nullptr;
+    };
+
+    struct Stats {
+        std::size_t created = 0; // mdb_txn_begin ile açılan
+        std::size_t reused = 0;  // mdb_txn_renew ile yeniden kullanılan
+        std::size_t idle = 0;    // Ortak boşta listesindeki
+    };
+
+    explicit ReadTxnPool(std::shared_mutex& gate);
+    ~ReadTxnPool();
+
+    void attach(MDB_env* env); // Ortam açıldıktan sonra (kapı özel tutulurken)
+    void detach();             // mdb_env_close'dan önce (kapı özel tutulurken); tüm transaction'lar kapatılır
+
+    // Ortam bağlı değilse veya transaction açılamazsa boş Lease döner.
+    Lease acquire();
+    Stats stats() const;
+
+private:
+    friend struct ThreadTxnCache;
+
+    void release(MDB_txn* txn); // Transaction sıfırlandıktan sonra kapıyı da bırakır
+    void lock_gate();   // Bu iş parçacığında ilk kirada kapıyı paylaşımlı kilitler, sonrakilerde sayacı artırır
+    void unlock_gate(); // Bu iş parçacığının son kirası bırakılınca kapıyı çözer
+    void give_back(std::uint64_t epoch, MDB_txn* txn); // Sona eren iş parçacığının önbelleğinden
+    void discard(MDB_txn* txn);                        // Yenilenemeyen transaction'ı kapatır
+
+    std::shared_mutex& gate_;
+    const std::uint64_t uid_;                // Süreç içinde benzersiz; iş parçacığı önbelleği havuzları bununla ayırır
+    std::atomic<std::uint64_t> epoch_{0};    // Her detach'te artar; eski önbellek girdileri geçersizleşir
+    MDB_env* env_ = nullptr;
+    mutable std::mutex mutex_;
+    std::vector<MDB_txn*> idle_;
+    std::vector<MDB_txn*> all_;              // detach'te kapatılacak tüm transaction'lar
+    std::atomic<std::size_t> created_{0};
+    std::atomic<std::size_t> reused_{0};
+};
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
+
+#endif // SWARM_VECTORDB_READTXNPOOL_H
@@ -0,0 +1,273 @@
+#include "ShardedVectorDB.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+
+#include "../core/logger.h"
+#include "../core/task_scheduler.h"
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+// --- ShardedSwarmVectorDB ---
+
+ShardedSwarmVectorDB::ShardedSwarmVectorDB(const std::string& base_path, std::size_t shard_count,
+                                           ShardPartition partition, std::size_t hnsw_max_elements_per_shard,
+                                           LmdbMapOptions map_options)
+    : base_path_(base_path), partition_(partition) {
+    if (shard_count == 0) {
+        LOG_ERROR_CERR(LogLevel::WARNING, "ShardedSwarmVectorDB: Parça sayısı 0 verildi, 1 kullanılıyor.");
+        shard_count = 1;
+    }
+    shards_.reserve(shard_count);
+    for (std::size_t i = 0; i < shard_count; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "shard_%02zu", i);
+        shards_.push_back(std::make_unique<SwarmVectorDB>((std::filesystem::path(base_path_) / name).string(),
+                                                          hnsw_max_elements_per_shard, map_options));
+    }
+}
+
+ShardedSwarmVectorDB::~ShardedSwarmVectorDB() {
+    close();
+}
+
+std::uint64_t ShardedSwarmVectorDB::fnv1a(const std::string& key) {
+    // std::hash platformlar arası kararlı değildir; parça yönlendirmesi diskteki yerleşimi belirlediği için FNV-1a.
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void ShardedSwarmVectorDB::for_each_shard(const std::function<void(std::size_t)>& fn) const {
+    // Parça işleri çağıranın kritik yolundadır (arama, açılış, toplu yazım): Interactive sınıfında, parça başına bir katılımcı.
+    TaskScheduler::instance().parallel_for(TaskClass::Interactive, shards_.size(), fn, shards_.size());
+}
+
+std::size_t ShardedSwarmVectorDB::shard_for(const CryptofigVector& cv) const {
+    const std::string& key = partition_ == ShardPartition::Topic ? cv.topic : cv.id;
+    return fnv1a(key) % shards_.size();
+}
+
+bool ShardedSwarmVectorDB::open() {
+    std::error_code ec;
+    std::filesystem::create_directories(base_path_, ec);
+    if (ec) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "ShardedSwarmVectorDB: Ana dizin oluşturulamadı: " << base_path_ << " (" << ec.message() << ")");
+        return false;
+    }
+
+    std::atomic<bool> all_ok{true};
+    for_each_shard([&](std::size_t i) {
+        if (!shards_[i]->open()) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "ShardedSwarmVectorDB: Parça " << i << " açılamadı.");
+            all_ok = false;
+        }
+    });
+    if (!all_ok) {
+        close();
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::INFO, "ShardedSwarmVectorDB: " << shards_.size() << " parça açıldı (" << base_path_ << ", "
+                << (partition_ == ShardPartition::Topic ? "konu" : "hash") << " bölümleme).");
+    return true;
+}
+
+void ShardedSwarmVectorDB::close() {
+    for (auto& shard : shards_) shard->close();
+}
+
+bool ShardedSwarmVectorDB::is_open() const {
+    return !shards_.empty() && std::all_of(shards_.begin(), shards_.end(), [](const auto& s) { return s->is_open(); });
+}
+
+bool ShardedSwarmVectorDB::store_vector(const CryptofigVector& cv) {
+    const std::size_t target = shard_for(cv);
+    if (!shards_[target]->store_vector(cv)) return false;
+    drop_stale_copies({&cv}, {target});
+    return true;
+}
+
+bool ShardedSwarmVectorDB::store_vector(const CryptofigVector& cv, const VectorAttributes& attributes) {
+    const std::size_t target = shard_for(cv);
+    if (!shards_[target]->store_vector(cv, attributes)) return false;
+    drop_stale_copies({&cv}, {target});
+    return true;
+}
+
+void ShardedSwarmVectorDB::drop_stale_copies(const std::vector<const CryptofigVector*>& stored,
+                                             const std::vector<std::size_t>& targets) {
+    if (partition_ != ShardPartition::Topic || shards_.size() < 2 || stored.empty()) return;
+    // Yeni kopya önce yazıldığı için silme başarısız olsa da kayıt kaybolmaz; en kötü durumda eski kopya kalır.
+    for_each_shard([&](std::size_t i) {
+        for (std::size_t k = 0; k < stored.size(); ++k) {
+            if (targets[k] == i || !shards_[i]->get_vector(stored[k]->id)) continue;
+            if (shards_[i]->delete_vector(stored[k]->id)) {
+                LOG_DEFAULT(LogLevel::DEBUG, "ShardedSwarmVectorDB: '" << stored[k]->id << "' konusu değiştiği için parça "
+                            << i << "'den parça " << targets[k] << "'e taşındı.");
+            } else {
+                LOG_ERROR_CERR(LogLevel::WARNING, "ShardedSwarmVectorDB: '" << stored[k]->id << "' için parça " << i
+                               << "'deki eski kopya silinemedi.");
+            }
+        }
+    });
+}
+
+bool ShardedSwarmVectorDB::store_vectors_batch(const std::vector<CryptofigVector>& cvs, const std::vector<std::string>& contents,
+                                               const std::vector<VectorAttributes>& attributes) {
+    if (cvs.empty()) return true;
+    if (!contents.empty() && contents.size() != cvs.size()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "ShardedSwarmVectorDB::store_vectors_batch: contents boyutu vektör sayısıyla eşleşmiyor.");
+        return false;
+    }
+    if (!attributes.empty() && attributes.size() != cvs.size()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "ShardedSwarmVectorDB::store_vectors_batch: attributes boyutu vektör sayısıyla eşleşmiyor.");
+        return false;
+    }
+
+    struct Group {
+        std::vector<CryptofigVector> cvs;
+        std::vector<std::string> contents;
+        std::vector<VectorAttributes> attributes;
+    };
+    std::vector<Group> groups(shards_.size());
+    std::vector<std::size_t> targets(cvs.size());
+    for (std::size_t i = 0; i < cvs.size(); ++i) {
+        targets[i] = shard_for(cvs[i]);
+        Group& group = groups[targets[i]];
+        group.cvs.push_back(cvs[i]);
+        if (!contents.empty()) group.contents.push_back(contents[i]);
+        if (!attributes.empty()) group.attributes.push_back(attributes[i]);
+    }
+
+    std::atomic<bool> all_ok{true};
+    std::vector<char> shard_ok(shards_.size(), 1);
+    for_each_shard([&](std::size_t i) {
+        if (groups[i].cvs.empty()) return;
+        if (!shards_[i]->store_vectors_batch(groups[i].cvs, groups[i].contents, groups[i].attributes)) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "ShardedSwarmVectorDB: Parça " << i << " toplu yazımı başarısız ("
+                           << groups[i].cvs.size() << " vektör).");
+            shard_ok[i] = 0;
+            all_ok = false;
+        }
+    });
+
+    if (partition_ == ShardPartition::Topic) {
+        // Yalnızca yazımı başarılı olan parçalara giden ID'lerin eski kopyaları silinir.
+        std::vector<const CryptofigVector*> stored;
+        std::vector<std::size_t> stored_targets;
+        for (std::size_t i = 0; i < cvs.size(); ++i) {
+            if (!shard_ok[targets[i]]) continue;
+            stored.push_back(&cvs[i]);
+            stored_targets.push_back(targets[i]);
+        }
+        drop_stale_copies(stored, stored_targets);
+    }
+    return all_ok;
+}
+
+std::size_t ShardedSwarmVectorDB::locate(const std::string& id) const {
+    if (partition_ == ShardPartition::Hash) {
+        const std::size_t index = shard_for_id(id);
+        return shards_[index]->get_vector(id) ? index : shards_.size();
+    }
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        if (shards_[i]->get_vector(id)) return i;
+    }
+    return shards_.size();
+}
+
+std::unique_ptr<CryptofigVector> ShardedSwarmVectorDB::get_vector(const std::string& id) const {
+    if (partition_ == ShardPartition::Hash) return shards_[shard_for_id(id)]->get_vector(id);
+    for (const auto& shard : shards_) {
+        if (auto cv = shard->get_vector(id)) return cv;
+    }
+    return nullptr;
+}
+
+std::optional<std::string> ShardedSwarmVectorDB::get_capsule_content(const std::string& id) const {
+    if (partition_ == ShardPartition::Hash) return shards_[shard_for_id(id)]->get_capsule_content(id);
+    for (const auto& shard : shards_) {
+        if (auto content = shard->get_capsule_content(id)) return content;
+    }
+    return std::nullopt;
+}
+
+bool ShardedSwarmVectorDB::delete_vector(const std::string& id) {
+    const std::size_t index = locate(id);
+    if (index == shards_.size()) return false;
+    return shards_[index]->delete_vector(id);
+}
+
+std::vector<ShardedSearchHit> ShardedSwarmVectorDB::search_similar_scored(const std::vector<float>& query_embedding, int top_k,
+                                                                          const VectorFilter* filter) const {
+    std::vector<ShardedSearchHit> merged;
+    if (top_k <= 0) return merged;
+
+    // Her parça kendi top_k'sını döndürür; küresel top_k bu kümelerin birleşiminin içindedir.
+    std::vector<std::vector<std::pair<std::string, float>>> partial(shards_.size());
+    for_each_shard([&](std::size_t i) {
+        partial[i] = shards_[i]->search_similar_scored(query_embedding, top_k, filter);
+    });
+
+    std::size_t total = 0;
+    for (const auto& hits : partial) total += hits.size();
+    merged.reserve(total);
+    for (std::size_t i = 0; i < partial.size(); ++i) {
+        for (auto& hit : partial[i]) merged.push_back(ShardedSearchHit{std::move(hit.first), hit.second, i});
+    }
+
+    const std::size_t keep = std::min<std::size_t>(merged.size(), static_cast<std::size_t>(top_k));
+    auto closer = [](const ShardedSearchHit& a, const ShardedSearchHit& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+    };
+    std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(), closer);
+    merged.resize(keep);
+    return merged;
+}
+
+std::vector<std::string> ShardedSwarmVectorDB::search_similar_vectors(const std::vector<float>& query_embedding, int top_k) const {
+    std::vector<std::string> ids;
+    for (auto& hit : search_similar_scored(query_embedding, top_k)) ids.push_back(std::move(hit.id));
+    return ids;
+}
+
+std::vector<std::string> ShardedSwarmVectorDB::search_similar_vectors_filtered(const std::vector<float>& query_embedding, int top_k,
+                                                                               const VectorFilter& filter) const {
+    std::vector<std::string> ids;
+    for (auto& hit : search_similar_scored(query_embedding, top_k, &filter)) ids.push_back(std::move(hit.id));
+    return ids;
+}
+
+std::vector<std::string> ShardedSwarmVectorDB::get_all_ids() const {
+    std::vector<std::string> ids;
+    for (const auto& shard : shards_) {
+        std::vector<std::string> shard_ids = shard->get_all_ids();
+        ids.insert(ids.end(), std::make_move_iterator(shard_ids.begin()), std::make_move_iterator(shard_ids.end()));
+    }
+    return ids;
+}
+
+VectorIndexStats ShardedSwarmVectorDB::get_index_stats() const {
+    VectorIndexStats total;
+    for (const auto& shard : shards_) {
+        const VectorIndexStats stats = shard->get_index_stats();
+        total.live_elements += stats.live_elements;
+        total.deleted_elements += stats.deleted_elements;
+        total.capacity += stats.capacity;
+        total.quarantined += stats.quarantined;
+        total.compactions += stats.compactions;
+        total.compaction_running = total.compaction_running || stats.compaction_running;
+    }
+    const std::size_t slot_count = total.live_elements + total.deleted_elements;
+    total.deleted_ratio = slot_count ? static_cast<double>(total.deleted_elements) / static_cast<double>(slot_count) : 0.0;
+    return total;
+}
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
@@ -0,0 +1,99 @@
+#ifndef SWARM_VECTORDB_SHARDEDVECTORDB_H
+#define SWARM_VECTORDB_SHARDEDVECTORDB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "VectorDB.h"
+
+namespace CerebrumLux {
+namespace SwarmVectorDB {
+
+enum class ShardPartition {
+    Hash,  // ID'nin FNV-1a özetine göre; yük eşit dağılır
+    Topic  // Konunun özetine göre; aynı konudaki vektörler aynı parçada toplanır (konu filtreli aramalar tek parçaya düşer)
+};
+
+struct ShardedSearchHit {
+    std::string id;
+    float distance = 0.0f; // Karesi alınmış L2
+    std::size_t shard = 0;
+};
+
+// N adet bağımsız SwarmVectorDB (her biri kendi LMDB ortamı ve HNSW indeksi) üzerinde parçalı vektör deposu.
+//
+// Parça dizinleri base_path/shard_00, shard_01, ... şeklindedir. Yazmalar ID'nin (veya konunun) özetiyle tek bir
+// parçaya gider. Aramalar tüm parçalara paralel yollanır ve her parçanın top_k sonucu mesafeye göre birleştirilir
+// (parçalar aynı metrikte olduğu için birleştirme tam sonucu verir). Parça sayısı veritabanı oluşturulduktan sonra
+// değiştirilmemelidir: yönlendirme parça sayısına bağlıdır.
+class ShardedSwarmVectorDB {
+public:
+    ShardedSwarmVectorDB(const std::string& base_path, std::size_t shard_count,
+                         ShardPartition partition = ShardPartition::Hash,
+                         std::size_t hnsw_max_elements_per_shard = 100000, LmdbMapOptions map_options = {});
+    ~ShardedSwarmVectorDB();
+
+    bool open();  // Tüm parçaları paralel açar; biri bile açılamazsa false
+    void close();
+    bool is_open() const;
+
+    std::size_t shard_count() const { return shards_.size(); }
+    ShardPartition partition() const { return partition_; }
+    SwarmVectorDB& shard(std::size_t index) { return *shards_[index]; }
+    const SwarmVectorDB& shard(std::size_t index) const { return *shards_[index]; }
+    std::size_t shard_for(const CryptofigVector& cv) const;
+
+    bool store_vector(const CryptofigVector& cv);
+    bool store_vector(const CryptofigVector& cv, const VectorAttributes& attributes);
+    // Vektörler parçalara göre gruplanır ve her grup kendi parçasında tek transaction'da, gruplar paralel yazılır.
+    // Atomiklik parça başınadır: bir parça başarısız olursa diğer parçalara yazılanlar geri alınmaz.
+    // Konu bölümlemede aynı ID başka bir parçada (eski konusuyla) duruyorsa, yeni kayıt yazıldıktan sonra oradan silinir.
+    bool store_vectors_batch(const std::vector<CryptofigVector>& cvs, const std::vector<std::string>& contents = {},
+                             const std::vector<VectorAttributes>& attributes = {});
+
+    // Hash bölümlemede tek parçaya, konu bölümlemede (konu ID'den bilinemediği için) sırayla parçalara bakar.
+    std::unique_ptr<CryptofigVector> get_vector(const std::string& id) const;
+    std::optional<std::string> get_capsule_content(const std::string& id) const;
+    bool delete_vector(const std::string& id);
+
+    std::vector<ShardedSearchHit> search_similar_scored(const std::vector<float>& query_embedding, int top_k,
+                                                        const VectorFilter* filter = nullptr) const;
+    std::vector<std::string> search_similar_vectors(const std::vector<float>& query_embedding, int top_k) const;
+    std::vector<std::string> search_similar_vectors_filtered(const std::vector<float>& query_embedding, int top_k,
+                                                             const VectorFilter& filter) const;
+
+    std::vector<std::string> get_all_ids() const;
+
+    // Parça bazında toplanmış indeks durumu.
+    VectorIndexStats get_index_stats() const;
+
+    static std::uint64_t fnv1a(const std::string& key);
+
+private:
+    // fn(i)'yi her parça için ortak zamanlayıcıda (Interactive sınıfı; çağıran da katılır) çalıştırır, tümü bitince döner.
+    void for_each_shard(const std::function<void(std::size_t)>& fn) const;
+
+    std::size_t shard_for_id(const std::string& id) const { return fnv1a(id) % shards_.size(); }
+    std::size_t locate(const std::string& id) const; // ID'nin bulunduğu parça; yoksa shards_.size()
+    // Konu bölümlemede konusu değişen bir ID yeni parçasına yazılınca eski parçadaki kopyası silinir; aksi halde
+    // aramalar aynı ID'yi iki kez döndürür. Hash bölümlemede ID hep aynı parçaya gittiği için bir şey yapmaz.
+    void drop_stale_copies(const std::vector<const CryptofigVector*>& stored, const std::vector<std::size_t>& targets);
+
+    std::string base_path_;
+    ShardPartition partition_;
+    std::vector<std::unique_ptr<SwarmVectorDB>> shards_;
+
+    ShardedSwarmVectorDB(const ShardedSwarmVectorDB&) = delete;
+    ShardedSwarmVectorDB& operator=(const ShardedSwarmVectorDB&) = delete;
+};
+
+} // namespace SwarmVectorDB
+} // namespace CerebrumLux
+
+#endif // SWARM_VECTORDB_SHARDEDVECTORDB_H
@@ -9,6 +9,7 @@
 
 #include "DataModels.h" // CryptofigVector
 #include "../core/logger.h" // LOG_DEFAULT için
+#include "../core/metrics.h" // Çalışma zamanı metrikleri için
 #include "../hnswlib_wrapper.h" // HNSWIndex wrapper için
 
 namespace fs = std::filesystem; // std::filesystem için alias
@@ -16,66 +17,125 @@ namespace fs = std::filesystem; // std::filesystem için alias
 namespace CerebrumLux {
 namespace SwarmVectorDB {
 
-// --- SwarmConsensusTree Implementasyonu ---
-
-SwarmConsensusTree::SwarmConsensusTree() {
-    root_hash_ = "";
-    LOG_DEFAULT(LogLevel::INFO, "SwarmConsensusTree: Başlatıldı.");
+namespace {
+
+struct VectorDbMetrics {
+    Metrics::Histogram& store_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"store_vector\"");
+    Metrics::Histogram& store_batch_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"store_vectors_batch\"");
+    Metrics::Histogram& get_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"get_vector\"");
+    Metrics::Histogram& search_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"search_similar\"");
+    Metrics::Counter& get_misses = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_get_misses_total", "get_vector çağrısında bulunamayan ID sayısı");
+    Metrics::Gauge& hnsw_elements = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_vectordb_hnsw_elements", "HNSW indeksindeki eleman sayısı (silinmiş işaretliler dahil)");
+    Metrics::Gauge& hnsw_deleted = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_vectordb_hnsw_deleted_elements", "HNSW indeksinde silinmiş işaretli yuva sayısı");
+    Metrics::Gauge& hnsw_deleted_ratio = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_vectordb_hnsw_deleted_ratio", "HNSW indeksinde silinmiş yuvaların oranı");
+    Metrics::Counter& compactions = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_hnsw_compactions_total", "Tamamlanan HNSW sıkıştırma sayısı");
+    Metrics::Histogram& compaction_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"compact_index\"");
+    Metrics::Histogram& filtered_search_latency = Metrics::MetricsRegistry::instance().histogram(
+        "cerebrumlux_vectordb_op_seconds", "SwarmVectorDB işlem süresi (kilit bekleme dahil)", "op=\"search_filtered\"");
+    Metrics::Counter& filtered_exact = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_filtered_search_total", "Filtreli arama sayısı (yol)", "path=\"exact\"");
+    Metrics::Counter& filtered_graph = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_filtered_search_total", "Filtreli arama sayısı (yol)", "path=\"graph\"");
+    Metrics::Gauge& map_size = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_vectordb_lmdb_map_size_bytes", "LMDB bellek eşlemesinin geçerli boyutu");
+    Metrics::Gauge& map_used = Metrics::MetricsRegistry::instance().gauge(
+        "cerebrumlux_vectordb_lmdb_map_used_bytes", "LMDB haritasında kullanılan en yüksek sayfaya kadarki bayt");
+    Metrics::Counter& map_resizes = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_lmdb_map_resizes_total", "MDB_MAP_FULL sonrası yapılan harita büyütme sayısı");
+    Metrics::Counter& map_full = Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_lmdb_map_full_total", "MDB_MAP_FULL ile başarısız olan yazma denemesi sayısı");
+};
+
+VectorDbMetrics& db_metrics() {
+    static VectorDbMetrics metrics;
+    return metrics;
 }
 
-void SwarmConsensusTree::update_tree(const CryptofigVector& cv) {
-    std::lock_guard<std::mutex> lock(mutex_); // Thread güvenliği
-    
-    // CryptofigVector'den hash oluştur (basit örnek)
-    // Gerçek bir hash için CryptofigVector'ün tüm içeriği (cryptofig, embedding, fisher_query, id, content_hash)
-    // byte dizisine dönüştürülüp hash'lenmelidir.
-    std::string data_to_hash = cv.id + cv.content_hash + cv.fisher_query;
-    for (uint8_t byte : cv.cryptofig) {
-        data_to_hash += static_cast<char>(byte);
-    }
-    for (int i = 0; i < cv.embedding.size(); ++i) {
-        data_to_hash += std::to_string(cv.embedding(i));
-    }
-
-    unsigned char hash_buf[SHA256_DIGEST_LENGTH];
-    SHA256(reinterpret_cast<const unsigned char*>(data_to_hash.data()), data_to_hash.size(), hash_buf);
-
-    std::stringstream ss;
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << (int)hash_buf[i];
-    }
-    leaf_hashes_.push_back(ss.str());
+// Karantina kaydı (tombstone) kodlaması, little-endian:
+//   u64 karantina zamanı (epoch ms) | u32 len | neden | u32 len | serileştirilmiş vektör | u8 içerik var mı | u32 len | içerik
+struct Tombstone {
+    std::uint64_t quarantined_at_ms = 0;
+    std::string reason;
+    std::string vector_bytes;
+    bool has_content = false;
+    std::string content;
+};
+
+void append_u32(std::string& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+}
 
-    // Basit root hash güncellemesi: Tüm yaprak hash'lerini birleştirip tekrar hash'le
-    // Gerçek Merkle Tree implementasyonu daha karmaşıktır.
-    std::string combined_hashes;
-    for (const auto& h : leaf_hashes_) {
-        combined_hashes += h;
-    }
-    SHA256(reinterpret_cast<const unsigned char*>(combined_hashes.data()), combined_hashes.size(), hash_buf);
-    ss.str(""); // Stringstream'i temizle
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << (int)hash_buf[i];
-    }
-    root_hash_ = ss.str();
+std::string encode_tombstone(const Tombstone& t) {
+    std::string out;
+    out.reserve(21 + t.reason.size() + t.vector_bytes.size() + t.content.size());
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((t.quarantined_at_ms >> (8 * i)) & 0xFF));
+    append_u32(out, static_cast<std::uint32_t>(t.reason.size()));
+    out += t.reason;
+    append_u32(out, static_cast<std::uint32_t>(t.vector_bytes.size()));
+    out += t.vector_bytes;
+    out.push_back(t.has_content ? 1 : 0);
+    append_u32(out, static_cast<std::uint32_t>(t.content.size()));
+    out += t.content;
+    return out;
+}
 
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmConsensusTree: Ağaç güncellendi. Kök Hash: " << root_hash_);
+bool decode_tombstone(const MDB_val& val, Tombstone& t) {
+    const unsigned char* p = static_cast<const unsigned char*>(val.mv_data);
+    const unsigned char* end = p + val.mv_size;
+    auto read_u32 = [&](std::uint32_t& v) {
+        if (end - p < 4) return false;
+        v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+        p += 4;
+        return true;
+    };
+    auto read_str = [&](std::string& s) {
+        std::uint32_t len = 0;
+        if (!read_u32(len) || static_cast<std::size_t>(end - p) < len) return false;
+        s.assign(reinterpret_cast<const char*>(p), len);
+        p += len;
+        return true;
+    };
+    if (end - p < 8) return false;
+    t.quarantined_at_ms = 0;
+    for (int i = 0; i < 8; ++i) t.quarantined_at_ms |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    p += 8;
+    if (!read_str(t.reason) || !read_str(t.vector_bytes) || p == end) return false;
+    t.has_content = (*p++ != 0);
+    return read_str(t.content);
 }
 
+} // namespace
 
 // --- SwarmVectorDB Implementasyonu (LMDB tabanlı) ---
 
-SwarmVectorDB::SwarmVectorDB(const std::string& db_path)
+SwarmVectorDB::SwarmVectorDB(const std::string& db_path, size_t hnsw_max_elements, LmdbMapOptions map_options)
     : db_path_(db_path), 
-    hnsw_index_(std::make_unique<CerebrumLux::HNSW::HNSWIndex>(256, 100000)), // DÜZELTME: HNSW Index 256D
+    map_options_(map_options),
+    hnsw_index_(std::make_shared<CerebrumLux::HNSW::HNSWIndex>(256, hnsw_max_elements)), // DÜZELTME: HNSW Index 256D
+    hnsw_default_capacity_(hnsw_max_elements),
     next_hnsw_label_(0) {
     hnsw_label_to_id_map_dbi_ = 0;
     id_to_hnsw_label_map_dbi_ = 0;
     hnsw_next_label_dbi_ = 0;
     capsule_content_dbi_ = 0; // Yeni eklenen DBI'ı başlat
+    quarantine_dbi_ = 0;
+    attributes_dbi_ = 0;
     q_values_dbi_ = 0;
     q_metadata_dbi_ = 0;
     strategy_outcome_dbi_ = 0; // Initialize new DBI
+    if (map_options_.growth_factor < 1.1) map_options_.growth_factor = 2.0;
+    if (map_options_.max_size < map_options_.initial_size) map_options_.max_size = map_options_.initial_size;
     LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB Kurucusu: Başlatıldı. DB Yolu: " << db_path_);
     env_ = nullptr; // env_ ve dbi_ üyelerini açıkça başlat
     dbi_ = 0;
@@ -101,7 +161,7 @@ void SwarmVectorDB::close_internal() {
         // Save maps and next_hnsw_label_ to LMDB
         MDB_txn* txn;
         LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB::close_internal(): HNSW maps, next_hnsw_label_ ve Q-Table verileri LMDB'ye kaydediliyor.");
-        int rc = mdb_txn_begin(env_, nullptr, 0, &txn);
+        int rc = begin_write_txn(&txn);
         if (rc != MDB_SUCCESS) {
             LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): mdb_txn_begin başarısız (close save maps): " << mdb_strerror(rc));
         } else {
@@ -113,7 +173,7 @@ void SwarmVectorDB::close_internal() {
             next_label_key.mv_data = (void*)next_label_key_str_close.c_str();
             next_label_data.mv_size = next_hnsw_label_str_close.length();
             next_label_data.mv_data = (void*)next_hnsw_label_str_close.c_str();
-            rc = mdb_put(txn, hnsw_next_label_dbi_, &next_label_key, &next_label_data, 0);
+            rc = txn_put(txn, hnsw_next_label_dbi_, &next_label_key, &next_label_data, 0);
             if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): next_hnsw_label_ put başarısız: " << mdb_strerror(rc));
 
             // YENİ DÜZELTME: HNSW ID haritalarını LMDB'ye kaydetme
@@ -124,7 +184,7 @@ void SwarmVectorDB::close_internal() {
                 key_l.mv_data = (void*)label_key_string.c_str();
                 val_id.mv_size = pair.second.size();
                 val_id.mv_data = (void*)pair.second.c_str();
-                rc = mdb_put(txn, hnsw_label_to_id_map_dbi_, &key_l, &val_id, 0);
+                rc = txn_put(txn, hnsw_label_to_id_map_dbi_, &key_l, &val_id, 0);
                 if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): hnsw_label_to_id_map put başarısız (close): " << mdb_strerror(rc));
             }
             for (const auto& pair : id_to_hnsw_label_map_) {
@@ -134,7 +194,7 @@ void SwarmVectorDB::close_internal() {
                 key_id.mv_data = (void*)pair.first.c_str();
                 val_l.mv_size = label_val_string.size();
                 val_l.mv_data = (void*)label_val_string.c_str();
-                rc = mdb_put(txn, id_to_hnsw_label_map_dbi_, &key_id, &val_l, 0);
+                rc = txn_put(txn, id_to_hnsw_label_map_dbi_, &key_id, &val_l, 0);
                 if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): id_to_hnsw_label_map put başarısız (close): " << mdb_strerror(rc));
             }
             LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB::close_internal(): HNSW maps kaydedildi. Toplam label: " << hnsw_label_to_id_map_.size());
@@ -148,7 +208,7 @@ void SwarmVectorDB::close_internal() {
                 key_l.mv_data = (void*)label_key_string.c_str();
                 val_id.mv_size = pair.second.size();
                 val_id.mv_data = (void*)pair.second.c_str();
-                rc = mdb_put(txn, hnsw_label_to_id_map_dbi_, &key_l, &val_id, 0);
+                rc = txn_put(txn, hnsw_label_to_id_map_dbi_, &key_l, &val_id, 0);
                 if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): hnsw_label_to_id_map put başarısız (close): " << mdb_strerror(rc));
             }
             for (const auto& pair : id_to_hnsw_label_map_) {
@@ -158,11 +218,11 @@ void SwarmVectorDB::close_internal() {
                 key_id.mv_data = (void*)pair.first.c_str();
                 val_l.mv_size = label_val_string.size();
                 val_l.mv_data = (void*)label_val_string.c_str();
-                rc = mdb_put(txn, id_to_hnsw_label_map_dbi_, &key_id, &val_l, 0);
+                rc = txn_put(txn, id_to_hnsw_label_map_dbi_, &key_id, &val_l, 0);
                 if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): id_to_hnsw_label_map put başarısız (close): " << mdb_strerror(rc));
             }
 
-            rc = mdb_txn_commit(txn);
+            rc = txn_commit(txn);
             if (rc != MDB_SUCCESS) {
                 LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::close(): mdb_txn_commit başarısız (close save maps): " << mdb_strerror(rc));
             } else {
@@ -170,6 +230,10 @@ void SwarmVectorDB::close_internal() {
             }
         }
 
+        // Kapı özel alınır: kiradaki okumalar bitene kadar beklenir, havuzdaki transaction'lar ortamdan önce kapatılır.
+        std::unique_lock<std::shared_mutex> gate(map_resize_mutex_);
+        read_txns_.detach();
+
         // Close all DBI handles
         if (dbi_ != 0) { mdb_dbi_close(env_, dbi_); dbi_ = 0; }
         if (hnsw_label_to_id_map_dbi_ != 0) { mdb_dbi_close(env_, hnsw_label_to_id_map_dbi_); hnsw_label_to_id_map_dbi_ = 0; }
@@ -180,6 +244,9 @@ void SwarmVectorDB::close_internal() {
         if (q_metadata_dbi_ != 0) { mdb_dbi_close(env_, q_metadata_dbi_); q_metadata_dbi_ = 0; }
         if (capsule_content_dbi_ != 0) { mdb_dbi_close(env_, capsule_content_dbi_); capsule_content_dbi_ = 0; }
         if (strategy_outcome_dbi_ != 0) { mdb_dbi_close(env_, strategy_outcome_dbi_); strategy_outcome_dbi_ = 0; } // Close new DBI
+        if (quarantine_dbi_ != 0) { mdb_dbi_close(env_, quarantine_dbi_); quarantine_dbi_ = 0; }
+        if (attributes_dbi_ != 0) { mdb_dbi_close(env_, attributes_dbi_); attributes_dbi_ = 0; }
+        attribute_columns_.reset();
 
         // Close the environment
         mdb_env_close(env_);
@@ -190,7 +257,9 @@ void SwarmVectorDB::close_internal() {
 }
 
 bool SwarmVectorDB::open() {
+    stop_compaction(); // Yeniden açılışta eski ortamı kullanan arka plan işi kalmasın
     std::lock_guard<std::mutex> lock(mutex_);
+    compaction_cancel_ = false;
     // Eğer ortam zaten açıksa, önce kapatıp sonra tekrar açarak temiz bir başlangıç yapalım.
     // Bu, uygulamanın yeniden başlatılması gibi durumlarda kilitli kalma sorunlarını önler.
     if (env_ != nullptr) {
@@ -224,23 +293,23 @@ bool SwarmVectorDB::open() {
 
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_env_create başarılı.");
 
-    // 2. Ortam boyutunu ayarla (örn: 4GB)
-    rc = mdb_env_set_mapsize(env_, 4ULL * 1024ULL * 1024ULL * 1024ULL); // 4GB
+    // 2. Başlangıç harita boyutunu ayarla. Dolunca yazma yolları haritayı büyütür (bkz. grow_map_locked).
+    rc = mdb_env_set_mapsize(env_, map_options_.initial_size);
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_env_set_mapsize başarısız: " << mdb_strerror(rc));
         mdb_env_close(env_); env_ = nullptr;
         return false;
     }
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_env_set_mapsize başarılı (4GB).");
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_env_set_mapsize başarılı (" << (map_options_.initial_size >> 20) << " MB).");
 
     // 3. Maksimum veritabanı sayısını ayarla (CryptofigVector'lar için birincil DB ve potansiyel diğerleri)
-    rc = mdb_env_set_maxdbs(env_, 10); // Maksimum 10 DBI
+    rc = mdb_env_set_maxdbs(env_, 16); // Maksimum 16 DBI
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_env_set_maxdbs başarısız: " << mdb_strerror(rc));
         mdb_env_close(env_); env_ = nullptr;
         return false;
     }
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_env_set_maxdbs başarılı (10 DB).");
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_env_set_maxdbs başarılı (16 DB).");
 
     // MDB_NOSUBDIR, dizini oluşturmayıp dosyaları doğrudan db_path'e yazar. Bu, bizim fs::create_directories ile çelişmez.
     // Ancak, eğer db_path zaten bir dosya ise MDB_NOSUBDIR sorun çıkarabilir.
@@ -262,10 +331,11 @@ bool SwarmVectorDB::open() {
         return false;
     }
     LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::open(): LMDB ortamı başarıyla açıldı. Yol: " << db_path_);
+    update_map_metrics(); // Mevcut dosya başlangıç boyutundan büyükse LMDB dosya boyutunu kullanır
 
     // 5. Veritabanını aç (veya oluştur)
     MDB_txn* txn;
-    rc = mdb_txn_begin(env_, nullptr, 0, &txn);
+    rc = begin_write_txn(&txn);
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
         mdb_env_close(env_); env_ = nullptr;
@@ -342,7 +412,23 @@ bool SwarmVectorDB::open() {
     }
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_dbi_open 'strategy_outcome_db' başarılı.");
 
-    rc = mdb_txn_commit(txn);
+    rc = mdb_dbi_open(txn, "quarantine_db", MDB_CREATE, &quarantine_dbi_);
+    if (rc != MDB_SUCCESS) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_dbi_open 'quarantine_db' başarısız: " << mdb_strerror(rc));
+        mdb_txn_abort(txn); mdb_env_close(env_); env_ = nullptr;
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_dbi_open 'quarantine_db' başarılı.");
+
+    rc = mdb_dbi_open(txn, "vector_attributes_db", MDB_CREATE, &attributes_dbi_);
+    if (rc != MDB_SUCCESS) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_dbi_open 'vector_attributes_db' başarısız: " << mdb_strerror(rc));
+        mdb_txn_abort(txn); mdb_env_close(env_); env_ = nullptr;
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::open(): mdb_dbi_open 'vector_attributes_db' başarılı.");
+
+    rc = txn_commit(txn);
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_txn_commit başarısız: " << mdb_strerror(rc) << ", Yol: " << db_path_);
         mdb_env_close(env_); env_ = nullptr;
@@ -465,7 +551,7 @@ bool SwarmVectorDB::open() {
             hnsw_index_->create_new_index();
 
             MDB_txn* write_txn;
-            rc = mdb_txn_begin(env_, nullptr, 0, &write_txn); // DÜZELTME: Yeniden doldurma için yazma transaction'ı gerekli.
+            rc = begin_write_txn(&write_txn); // DÜZELTME: Yeniden doldurma için yazma transaction'ı gerekli.
             if (rc != MDB_SUCCESS) {
                 LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): mdb_txn_begin başarısız (hnsw populate): " << mdb_strerror(rc));
                 return false;
@@ -492,14 +578,14 @@ bool SwarmVectorDB::open() {
                         label_key_mdb_store.mv_data = (void*)label_str.c_str();
                         id_val_mdb_store.mv_size = id.length();
                         id_val_mdb_store.mv_data = (void*)id.c_str();
-                        mdb_put(write_txn, hnsw_label_to_id_map_dbi_, &label_key_mdb_store, &id_val_mdb_store, 0);
+                        txn_put(write_txn, hnsw_label_to_id_map_dbi_, &label_key_mdb_store, &id_val_mdb_store, 0);
 
                         MDB_val id_key_mdb_store, label_val_mdb_store;
                         id_key_mdb_store.mv_size = id.length();
                         id_key_mdb_store.mv_data = (void*)id.c_str();
                         label_val_mdb_store.mv_size = label_str.length();
                         label_val_mdb_store.mv_data = (void*)label_str.c_str();
-                        mdb_put(write_txn, id_to_hnsw_label_map_dbi_, &id_key_mdb_store, &label_val_mdb_store, 0);
+                        txn_put(write_txn, id_to_hnsw_label_map_dbi_, &id_key_mdb_store, &label_val_mdb_store, 0);
                     }
                 }
             }
@@ -510,9 +596,9 @@ bool SwarmVectorDB::open() {
             std::string next_hnsw_label_str_final = std::to_string(next_hnsw_label_);
             next_label_key_save.mv_size = next_label_key_str_final.length(); next_label_key_save.mv_data = (void*)next_label_key_str_final.c_str();
             next_label_data_save.mv_size = next_hnsw_label_str_final.length(); next_label_data_save.mv_data = (void*)next_hnsw_label_str_final.c_str();
-            mdb_put(write_txn, hnsw_next_label_dbi_, &next_label_key_save, &next_label_data_save, 0);
+            txn_put(write_txn, hnsw_next_label_dbi_, &next_label_key_save, &next_label_data_save, 0);
 
-            rc = mdb_txn_commit(write_txn); // Yazma işlemi yapıldı, commit et
+            rc = txn_commit(write_txn); // Yazma işlemi yapıldı, commit et
             if (rc != MDB_SUCCESS) {
                 LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): HNSW populate commit başarısız: " << mdb_strerror(rc));
                 return false;
@@ -529,16 +615,90 @@ bool SwarmVectorDB::open() {
             LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::open(): HNSWIndex nesnesi başlatılmamış. Kritik hata.");
             return false;
     }
+    {
+        std::unique_lock<std::shared_mutex> gate(map_resize_mutex_);
+        read_txns_.attach(env_);
+    }
+    if (!load_attribute_columns()) {
+        LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::open(): Nitelik sütunları eksik yüklendi; filtreli arama bazı vektörleri kaçırabilir.");
+    }
+    // Önceki oturumlardan birikmiş silinmiş yuvalar varsa sıkıştırma burada tetiklenir.
+    update_index_metrics_and_maybe_compact();
     return true; // Başarıyla açıldı
 }
 
+bool SwarmVectorDB::load_attribute_columns() {
+    attribute_columns_.reset();
+    MDB_txn* txn;
+    int rc = begin_write_txn(&txn);
+    if (rc != MDB_SUCCESS) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::load_attribute_columns(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+        return false;
+    }
+
+    // Nitelik DBI'ı sırayla taranır (ID başına rastgele okuma yerine).
+    std::vector<bool> loaded(next_hnsw_label_, false);
+    MDB_cursor* cursor;
+    rc = mdb_cursor_open(txn, attributes_dbi_, &cursor);
+    if (rc == MDB_SUCCESS) {
+        MDB_val key, data;
+        while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == MDB_SUCCESS) {
+            auto it = id_to_hnsw_label_map_.find(std::string(static_cast<const char*>(key.mv_data), key.mv_size));
+            if (it == id_to_hnsw_label_map_.end()) continue; // Karantinadaki kayıtlar
+            VectorAttributes attributes;
+            if (!VectorAttributes::decode(data.mv_data, data.mv_size, attributes)) continue;
+            attribute_columns_.set(it->second, attributes);
+            if (it->second < loaded.size()) loaded[it->second] = true;
+        }
+        mdb_cursor_close(cursor);
+    }
+
+    // Nitelik kaydı olmayan (bu özellikten önce eklenmiş) vektörler: konu vektörden okunur, zaman bilinmiyor.
+    size_t migrated = 0;
+    for (const auto& entry : hnsw_label_to_id_map_) {
+        if (entry.first < loaded.size() && loaded[entry.first]) continue;
+        std::unique_ptr<CryptofigVector> cv = get_vector(entry.second, txn);
+        if (!cv) continue;
+        VectorAttributes attributes;
+        attributes.topic = cv->topic;
+        const std::string encoded = attributes.encode();
+        MDB_val key, data;
+        key.mv_size = entry.second.size();
+        key.mv_data = (void*)entry.second.data();
+        data.mv_size = encoded.size();
+        data.mv_data = (void*)encoded.data();
+        if (txn_put(txn, attributes_dbi_, &key, &data, 0) == MDB_SUCCESS) ++migrated;
+        attribute_columns_.set(entry.first, attributes);
+    }
+
+    rc = txn_commit(txn);
+    if (rc != MDB_SUCCESS) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::load_attribute_columns(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
+        return false;
+    }
+    LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::open(): Nitelik sütunları yüklendi. Etiket: " << attribute_columns_.live_count()
+                << ", nitelik kaydı oluşturulan eski vektör: " << migrated);
+    return true;
+}
+
 void SwarmVectorDB::close() {
     LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::close(): Veritabanı kapatma işlemi başlatılıyor.");
+    stop_compaction(); // Sıkıştırma iş parçacığı mutex_'i alabileceği için kilitten önce durdurulur
     std::lock_guard<std::mutex> lock(mutex_); // Kilidi en dışarıda alıyoruz.
     close_internal();
+    compaction_cancel_ = false;
 }
 
 bool SwarmVectorDB::store_vector(const CryptofigVector& cv) {
+    return store_vector_impl(cv, nullptr);
+}
+
+bool SwarmVectorDB::store_vector(const CryptofigVector& cv, const VectorAttributes& attributes) {
+    return store_vector_impl(cv, &attributes);
+}
+
+bool SwarmVectorDB::store_vector_impl(const CryptofigVector& cv, const VectorAttributes* attributes) {
+    Metrics::ScopedTimer metric_timer(db_metrics().store_latency);
 
     std::lock_guard<std::mutex> lock(mutex_);
     if (env_ == nullptr) {
@@ -546,14 +706,212 @@ bool SwarmVectorDB::store_vector(const CryptofigVector& cv) {
         return false;
     }
 
-    int rc;
-    MDB_txn* txn;
-    rc = mdb_txn_begin(env_, nullptr, 0, &txn);
+    return with_map_growth("store_vector", [&]() -> bool {
+        int rc;
+        MDB_txn* txn;
+        rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (store): " << mdb_strerror(rc));
+            return false;
+        }
+
+        PendingIndexUpdates pending;
+        if (!store_vector_in_txn(txn, cv, pending, attributes)) {
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        rc = txn_commit(txn);
+
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+
+        apply_pending_index_updates(pending);
+        update_index_metrics_and_maybe_compact();
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör başarıyla depolandı. ID: " << cv.id);
+        return true;
+    });
+}
+
+bool SwarmVectorDB::store_vectors_batch(const std::vector<CryptofigVector>& cvs, const std::vector<std::string>& contents,
+                                        const std::vector<VectorAttributes>& attributes) {
+    Metrics::ScopedTimer metric_timer(db_metrics().store_batch_latency);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ == nullptr) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Veritabanı açık değil. Vektör grubu depolanamadı.");
+        return false;
+    }
+    if (!contents.empty() && contents.size() != cvs.size()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vectors_batch(): Vektör (" << cvs.size() << ") ve içerik (" << contents.size() << ") sayıları uyuşmuyor.");
+        return false;
+    }
+    if (!attributes.empty() && attributes.size() != cvs.size()) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vectors_batch(): Vektör (" << cvs.size() << ") ve nitelik (" << attributes.size() << ") sayıları uyuşmuyor.");
+        return false;
+    }
+    if (cvs.empty()) return true;
+
+    return with_map_growth("store_vectors_batch", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (store_batch): " << mdb_strerror(rc));
+            return false;
+        }
+
+        // Grup tek bir yazma transaction'ında ya tamamen işlenir ya da hiç işlenmez; HNSW'ye yalnızca commit'ten
+        // sonra eklenir.
+        PendingIndexUpdates pending;
+        for (size_t i = 0; i < cvs.size(); ++i) {
+            bool ok = store_vector_in_txn(txn, cvs[i], pending, attributes.empty() ? nullptr : &attributes[i]);
+            if (ok && !contents.empty()) {
+                MDB_val key, data;
+                key.mv_size = cvs[i].id.length();
+                key.mv_data = (void*)cvs[i].id.c_str();
+                data.mv_size = contents[i].length();
+                data.mv_data = (void*)contents[i].c_str();
+                rc = txn_put(txn, capsule_content_dbi_, &key, &data, 0);
+                if (rc != MDB_SUCCESS) {
+                    LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vectors_batch(): içerik mdb_put başarısız (ID: " << cvs[i].id << "): " << mdb_strerror(rc));
+                    ok = false;
+                }
+            }
+            if (!ok) {
+                mdb_txn_abort(txn);
+                return false;
+            }
+        }
+
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız (store_batch): " << mdb_strerror(rc));
+            return false;
+        }
+
+        apply_pending_index_updates(pending);
+        update_index_metrics_and_maybe_compact();
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: " << cvs.size() << " vektör tek transaction'da depolandı.");
+        return true;
+    });
+}
+
+void SwarmVectorDB::apply_pending_index_updates(PendingIndexUpdates& pending) {
+    for (PendingIndexUpdate& update : pending.updates) {
+        if (!update.embedding.empty() && hnsw_index_) {
+            // Etiket ve eşlemeler LMDB'ye işlendi; HNSW eklemesi başarısız olsa da etiket bir daha verilmemeli.
+            next_hnsw_label_ = std::max(next_hnsw_label_, update.label + 1);
+            std::unique_lock<std::shared_mutex> index_lock(index_mutex_);
+            if (!hnsw_index_->add_item(update.embedding, update.label)) {
+                index_lock.unlock();
+                // store_vector_in_txn kapasiteyi önceden denetlediği için beklenmez; kayıt LMDB'de kalır ve yeniden
+                // açılışta indekslenir.
+                LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Commit sonrası HNSW eklemesi başarısız (ID: " << update.id
+                               << ", Label: " << update.label << ").");
+                if (!compaction_running_) start_compaction_locked();
+                continue;
+            }
+            hnsw_label_to_id_map_[update.label] = update.id;
+            id_to_hnsw_label_map_[update.id] = update.label;
+            index_lock.unlock();
+            log_index_op(update.label, std::move(update.embedding));
+            LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: HNSW index'e vektör eklendi. ID: " << update.id << ", Label: " << update.label);
+        }
+        attribute_columns_.set(update.label, update.attributes);
+    }
+}
+
+int SwarmVectorDB::begin_write_txn(MDB_txn** txn) {
+    int rc = mdb_txn_begin(env_, nullptr, 0, txn);
+    if (rc == MDB_MAP_RESIZED) {
+        // Aynı ortamı kullanan başka bir süreç haritayı büyütmüş: yeni boyutu benimse ve tekrar dene.
+        {
+            std::unique_lock<std::shared_mutex> gate(map_resize_mutex_);
+            rc = mdb_env_set_mapsize(env_, 0);
+        }
+        if (rc == MDB_SUCCESS) rc = mdb_txn_begin(env_, nullptr, 0, txn);
+        update_map_metrics();
+    }
+    return rc;
+}
+
+int SwarmVectorDB::txn_put(MDB_txn* txn, MDB_dbi dbi, MDB_val* key, MDB_val* data, unsigned int flags) {
+    const int rc = mdb_put(txn, dbi, key, data, flags);
+    if (rc == MDB_MAP_FULL) map_full_hit_ = true;
+    return rc;
+}
+
+int SwarmVectorDB::txn_del(MDB_txn* txn, MDB_dbi dbi, MDB_val* key, MDB_val* data) {
+    const int rc = mdb_del(txn, dbi, key, data);
+    if (rc == MDB_MAP_FULL) map_full_hit_ = true;
+    return rc;
+}
+
+int SwarmVectorDB::txn_commit(MDB_txn* txn) {
+    const int rc = mdb_txn_commit(txn);
+    if (rc == MDB_MAP_FULL) map_full_hit_ = true;
+    return rc;
+}
+
+bool SwarmVectorDB::with_map_growth(const char* op, const std::function<bool()>& attempt) {
+    for (;;) {
+        map_full_hit_ = false;
+        if (attempt()) return true;
+        // MDB_MAP_FULL sonrası transaction hata durumundadır ve geri alınmıştır; büyütüp baştan dene.
+        if (!map_full_hit_ || !grow_map_locked(op)) return false;
+    }
+}
+
+bool SwarmVectorDB::grow_map_locked(const char* op) {
+    db_metrics().map_full.inc();
+    MDB_envinfo info;
+    int rc = mdb_env_info(env_, &info);
+    if (rc != MDB_SUCCESS) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::" << op << "(): mdb_env_info başarısız: " << mdb_strerror(rc));
+        return false;
+    }
+    const size_t current = info.me_mapsize;
+    if (current >= map_options_.max_size) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::" << op << "(): LMDB haritası dolu ve üst sınırda ("
+                       << (map_options_.max_size >> 20) << " MB). Yazma başarısız.");
+        return false;
+    }
+    // Geometrik büyüme; boyut 1 MB'ın katına yuvarlanır (sayfa boyutunun ve Windows ayırma biriminin katı).
+    constexpr size_t kAlign = 1ULL << 20;
+    size_t target = static_cast<size_t>(static_cast<double>(current) * map_options_.growth_factor);
+    target = std::min(std::max(target, current + kAlign), map_options_.max_size);
+    target = (target + kAlign - 1) / kAlign * kAlign;
+
+    {
+        // Yazarlar mutex_ ile zaten durmuş durumda; mutex_ dışındaki okuyucuların transaction'larını bitirmesi beklenir.
+        std::unique_lock<std::shared_mutex> gate(map_resize_mutex_);
+        rc = mdb_env_set_mapsize(env_, target);
+    }
     if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (store): " << mdb_strerror(rc));
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::" << op << "(): LMDB haritası büyütülemedi (" << (target >> 20)
+                       << " MB): " << mdb_strerror(rc));
         return false;
     }
+    ++map_resizes_;
+    db_metrics().map_resizes.inc();
+    update_map_metrics();
+    LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::" << op << "(): LMDB haritası büyütüldü: " << (current >> 20) << " MB -> "
+                << (target >> 20) << " MB. Transaction yeniden deneniyor.");
+    return true;
+}
+
+void SwarmVectorDB::update_map_metrics() {
+    MDB_envinfo info;
+    MDB_stat stat;
+    if (mdb_env_info(env_, &info) != MDB_SUCCESS || mdb_env_stat(env_, &stat) != MDB_SUCCESS) return;
+    db_metrics().map_size.set(static_cast<double>(info.me_mapsize));
+    db_metrics().map_used.set(static_cast<double>((info.me_last_pgno + 1) * stat.ms_psize));
+}
 
+bool SwarmVectorDB::store_vector_in_txn(MDB_txn* txn, const CryptofigVector& cv, PendingIndexUpdates& pending,
+                                        const VectorAttributes* attributes) {
+    int rc;
     MDB_val key, data;
     key.mv_size = cv.id.size();
     key.mv_data = (void*)cv.id.data();
@@ -577,7 +935,6 @@ bool SwarmVectorDB::store_vector(const CryptofigVector& cv) {
     // Use get_dim from HNSWIndex for consistency
     if (hnsw_index_ && static_cast<size_t>(cv.embedding.size()) != hnsw_index_->get_dim()) { 
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): Embedding boyutu 128 float degil! ID: " << cv.id);
-        mdb_txn_abort(txn);
         return false;
     }
 
@@ -603,81 +960,122 @@ bool SwarmVectorDB::store_vector(const CryptofigVector& cv) {
     data.mv_size = serialized_data.size();
     data.mv_data = serialized_data.data();
 
-    rc = mdb_put(txn, dbi_, &key, &data, 0);
+    rc = txn_put(txn, dbi_, &key, &data, 0);
     if (rc != MDB_SUCCESS) { // Hata kontrolü
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_put başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
         return false;
     }
 
-    // HNSW index'e de ekle (aynı transaction içinde)
-    if (hnsw_index_) {
-        if (!id_to_hnsw_label_map_.count(cv.id)) { // Hata kontrolü
-            hnswlib::labeltype current_label = next_hnsw_label_++;
-            std::vector<float> emb(cv.embedding.data(), cv.embedding.data() + cv.embedding.size());
-            hnsw_index_->add_item(emb, current_label);
-            hnsw_label_to_id_map_[current_label] = cv.id;
-            id_to_hnsw_label_map_[cv.id] = current_label;
-
-            const std::string label_str_key_store = std::to_string(current_label);
-            MDB_val label_key_mdb_store, id_val_mdb_store;
-            label_key_mdb_store.mv_size = label_str_key_store.length();
-            label_key_mdb_store.mv_data = (void*)label_str_key_store.c_str();
-            id_val_mdb_store.mv_size = cv.id.length();
-            id_val_mdb_store.mv_data = (void*)cv.id.c_str();
-            rc = mdb_put(txn, hnsw_label_to_id_map_dbi_, &label_key_mdb_store, &id_val_mdb_store, 0);
-            if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): hnsw_label_to_id_map put başarısız (label: " << label_str_key_store << ", ID: " << cv.id << "): " << mdb_strerror(rc));
-
-            const std::string label_str_val_store = std::to_string(current_label);
-            MDB_val id_key_mdb_store, label_val_mdb_store;
-            id_key_mdb_store.mv_size = cv.id.length();
-            id_key_mdb_store.mv_data = (void*)cv.id.c_str();
-            label_val_mdb_store.mv_size = label_str_val_store.length();
-            label_val_mdb_store.mv_data = (void*)label_str_val_store.c_str();
-            rc = mdb_put(txn, id_to_hnsw_label_map_dbi_, &id_key_mdb_store, &label_val_mdb_store, 0);
-            if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): id_to_hnsw_label_map put başarısız (ID: " << cv.id << ", label: " << label_str_val_store << "): " << mdb_strerror(rc));
+    // HNSW etiketi bu transaction'da ayrılır ve eşlemeleri LMDB'ye yazılır; indekse ekleme commit'ten sonra yapılır
+    // (apply_pending_index_updates).
+    std::vector<float> emb;
+    std::optional<hnswlib::labeltype> label;
+    if (auto known = id_to_hnsw_label_map_.find(cv.id); known != id_to_hnsw_label_map_.end()) {
+        label = known->second;
+    } else if (auto reserved = pending.new_labels.find(cv.id); reserved != pending.new_labels.end()) {
+        label = reserved->second; // Aynı grupta tekrar eden ID
+    } else if (hnsw_index_) {
+        if (hnsw_index_->get_current_elements() + pending.new_labels.size() >= hnsw_index_->get_max_elements()) {
+            // İndeks dolu: kayıt geri alınır, sıkıştırma yer açınca tekrar denenebilir.
+            if (!compaction_running_) start_compaction_locked();
+            return false;
+        }
+        const hnswlib::labeltype current_label = next_hnsw_label_ + pending.new_labels.size();
+        label = current_label;
+        pending.new_labels.emplace(cv.id, current_label);
+        emb.assign(cv.embedding.data(), cv.embedding.data() + cv.embedding.size());
+
+        const std::string label_str_key_store = std::to_string(current_label);
+        MDB_val label_key_mdb_store, id_val_mdb_store;
+        label_key_mdb_store.mv_size = label_str_key_store.length();
+        label_key_mdb_store.mv_data = (void*)label_str_key_store.c_str();
+        id_val_mdb_store.mv_size = cv.id.length();
+        id_val_mdb_store.mv_data = (void*)cv.id.c_str();
+        rc = txn_put(txn, hnsw_label_to_id_map_dbi_, &label_key_mdb_store, &id_val_mdb_store, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): hnsw_label_to_id_map put başarısız (label: " << label_str_key_store << ", ID: " << cv.id << "): " << mdb_strerror(rc));
+            return false;
+        }
 
-            MDB_val next_label_key, next_label_data;
-            const std::string next_label_key_str = "next_hnsw_label";
-            const std::string next_hnsw_label_str_val = std::to_string(next_hnsw_label_);
-            next_label_key.mv_size = next_label_key_str.size();
-            next_label_key.mv_data = (void*)next_label_key_str.data();
-            next_label_data.mv_size = next_hnsw_label_str_val.size();
-            next_label_data.mv_data = (void*)next_hnsw_label_str_val.data();
-            rc = mdb_put(txn, hnsw_next_label_dbi_, &next_label_key, &next_label_data, 0);
-            if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): next_hnsw_label_ put başarısız: " << mdb_strerror(rc));
-
-            LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: HNSW index'e vektör eklendi. ID: " << cv.id << ", Label: " << current_label);
+        const std::string label_str_val_store = std::to_string(current_label);
+        MDB_val id_key_mdb_store, label_val_mdb_store;
+        id_key_mdb_store.mv_size = cv.id.length();
+        id_key_mdb_store.mv_data = (void*)cv.id.c_str();
+        label_val_mdb_store.mv_size = label_str_val_store.length();
+        label_val_mdb_store.mv_data = (void*)label_str_val_store.c_str();
+        rc = txn_put(txn, id_to_hnsw_label_map_dbi_, &id_key_mdb_store, &label_val_mdb_store, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): id_to_hnsw_label_map put başarısız (ID: " << cv.id << ", label: " << label_str_val_store << "): " << mdb_strerror(rc));
+            return false;
         }
-    }
 
-    rc = mdb_txn_commit(txn);
+        MDB_val next_label_key, next_label_data;
+        const std::string next_label_key_str = "next_hnsw_label";
+        const std::string next_hnsw_label_str_val = std::to_string(current_label + 1);
+        next_label_key.mv_size = next_label_key_str.size();
+        next_label_key.mv_data = (void*)next_label_key_str.data();
+        next_label_data.mv_size = next_hnsw_label_str_val.size();
+        next_label_data.mv_data = (void*)next_hnsw_label_str_val.data();
+        rc = txn_put(txn, hnsw_next_label_dbi_, &next_label_key, &next_label_data, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): next_hnsw_label_ put başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+    }
 
+    // Nitelikler: verilmediyse mevcut kayıt korunur (yoksa varsayılan); konu her zaman vektörünkidir.
+    VectorAttributes resolved;
+    if (attributes) {
+        resolved = *attributes;
+    } else if (auto existing = get_vector_attributes(cv.id, txn)) {
+        resolved = std::move(*existing);
+    }
+    resolved.topic = cv.topic;
+    const std::string encoded_attributes = resolved.encode();
+    MDB_val attr_val;
+    attr_val.mv_size = encoded_attributes.size();
+    attr_val.mv_data = (void*)encoded_attributes.data();
+    rc = txn_put(txn, attributes_dbi_, &key, &attr_val, 0);
     if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız: " << mdb_strerror(rc));
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_vector(): nitelik mdb_put başarısız (ID: " << cv.id << "): " << mdb_strerror(rc));
         return false;
     }
-
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör başarıyla depolandı. ID: " << cv.id << ", Boyut: " << data.mv_size << " byte.");
+    if (label) pending.updates.push_back({*label, cv.id, std::move(emb), std::move(resolved)});
     return true;
 }
 
+std::optional<VectorAttributes> SwarmVectorDB::get_vector_attributes(const std::string& id, MDB_txn* existing_txn) const {
+    MDB_txn* txn = existing_txn;
+    ReadTxnPool::Lease lease;
+    if (!txn) {
+        lease = read_txns_.acquire();
+        if (!lease) return std::nullopt;
+        txn = lease.get();
+    }
 
-std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id, MDB_txn* existing_txn) const { // Keep consistent
-    //std::lock_guard<std::mutex> lock(mutex_);
-    if (env_ == nullptr) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Veritabanı açık değil. Vektör getirilemedi.");
-        return nullptr;
+    std::optional<VectorAttributes> result;
+    MDB_val key, data;
+    key.mv_size = id.size();
+    key.mv_data = (void*)id.data();
+    if (mdb_get(txn, attributes_dbi_, &key, &data) == MDB_SUCCESS) {
+        VectorAttributes attributes;
+        if (VectorAttributes::decode(data.mv_data, data.mv_size, attributes)) result = std::move(attributes);
     }
+    return result;
+}
 
+
+std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id, MDB_txn* existing_txn) const { // Keep consistent
+    Metrics::ScopedTimer metric_timer(db_metrics().get_latency);
     MDB_txn* current_txn = existing_txn;
-    if (!current_txn) { // Eğer dışarıdan bir transaction sağlanmadıysa, yeni bir read-only transaction başlat
-        LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB::get_vector(): Yeni RDONLY transaction başlatılıyor. ID: " << id);
-        int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &current_txn);
-        if (rc != MDB_SUCCESS) {
-            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (get_vector - yeni txn): " << mdb_strerror(rc));
+    ReadTxnPool::Lease lease; // Kira bitene kadar harita büyütülmez; transaction dönüşte havuza sıfırlanarak geri verilir
+    if (!current_txn) { // Eğer dışarıdan bir transaction sağlanmadıysa havuzdan bir read-only transaction kirala
+        lease = read_txns_.acquire();
+        if (!lease) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Veritabanı açık değil veya okuma transaction'ı alınamadı. ID: " << id);
             return nullptr;
         }
+        current_txn = lease.get();
     }
 
     MDB_val key, data;
@@ -687,14 +1085,11 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     int rc = mdb_get(current_txn, dbi_, &key, &data);
     //LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB::get_vector(): mdb_get çağrıldı. ID: " << id << ", RC: " << rc << ", Hata: " << mdb_strerror(rc) << ", Data Size: " << data.mv_size);
     if (rc == MDB_NOTFOUND) {
+        db_metrics().get_misses.inc();
         LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör bulunamadı. ID: " << id);
-        if (!existing_txn) { // Kendi başlattığı transaction'ı abort et
-            mdb_txn_abort(current_txn);
-        }
         return nullptr;
     } else if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_get başarısız: " << mdb_strerror(rc));
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
 
@@ -709,7 +1104,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     size_t cryptofig_len;
     if (remaining_size < sizeof(size_t)) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: Cryptofig boyutu verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     std::memcpy(&cryptofig_len, current_ptr + offset, sizeof(size_t));
@@ -719,7 +1113,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // 2. Deserialize cv.cryptofig
     if (remaining_size < cryptofig_len) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: Cryptofig verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     cv->cryptofig.assign(current_ptr + offset, current_ptr + offset + cryptofig_len);
@@ -731,7 +1124,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     size_t embedding_byte_size = 256 * sizeof(float); // DÜZELTME: 256
     if (remaining_size < embedding_byte_size) { // KRİTİK EKSİK SINIR KONTROLÜ EKLENDİ
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: Embedding verisi eksik veya bozuk. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     std::memcpy(cv->embedding.data(), current_ptr + offset, embedding_byte_size);
@@ -741,7 +1133,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // 4. Deserialize fisher_query_len
     if (remaining_size < sizeof(size_t)) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: fisher_query uzunluk verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     size_t fisher_query_len;
@@ -752,7 +1143,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // 5. Deserialize cv.fisher_query
     if (remaining_size < fisher_query_len) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: fisher_query verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     cv->fisher_query.assign(reinterpret_cast<const char*>(current_ptr + offset), fisher_query_len);
@@ -762,7 +1152,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // 6. Deserialize content_hash_len
     if (remaining_size < sizeof(size_t)) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: content_hash uzunluk verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     size_t content_hash_len;
@@ -773,7 +1162,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // 7. Deserialize cv.content_hash
     if (remaining_size < content_hash_len) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: content_hash verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     cv->content_hash.assign(reinterpret_cast<const char*>(current_ptr + offset), content_hash_len);
@@ -784,7 +1172,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     size_t topic_len;
     if (remaining_size < sizeof(size_t)) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: topic uzunluk verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     std::memcpy(&topic_len, current_ptr + offset, sizeof(size_t));
@@ -794,7 +1181,6 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // YENİ: 9. Deserialize cv.topic
     if (remaining_size < topic_len) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: topic verisi eksik. ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     cv->topic.assign(reinterpret_cast<const char*>(current_ptr + offset), topic_len);
@@ -806,42 +1192,38 @@ std::unique_ptr<CryptofigVector> SwarmVectorDB::get_vector(const std::string& id
     // Check if there's any remaining data unread, indicates serialization/deserialization mismatch
     if (remaining_size != 0) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: CryptofigVector deserialization hatasi: Okunmayan veri kaldi (" << remaining_size << " byte). ID: " << id);
-        if (!existing_txn) mdb_txn_abort(current_txn);
         return nullptr;
     }
     
     cv->id = id;
-    if (!existing_txn) { // Sadece kendi başlattığı transaction'ı abort et
-        mdb_txn_abort(current_txn);
-    }
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör başarıyla getirildi. ID: " << id << ", Boyut: " << data.mv_size << " byte.");
     return cv;
 }
 
 // YENİ: Toplu okuma implementasyonu
-std::vector<std::unique_ptr<CryptofigVector>> SwarmVectorDB::get_vectors_batch(const std::vector<std::string>& ids) const {
+std::vector<std::unique_ptr<CryptofigVector>> SwarmVectorDB::get_vectors_batch(const std::vector<std::string>& ids,
+                                                                               std::vector<VectorAttributes>* attributes) const {
     std::vector<std::unique_ptr<CryptofigVector>> results;
-    if (env_ == nullptr) return results;
-
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
-    if (rc != MDB_SUCCESS) {
+    if (attributes) attributes->clear();
+    auto lease = read_txns_.acquire();
+    if (!lease) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_vectors_batch: Transaction başlatılamadı.");
         return results;
     }
+    MDB_txn* txn = lease.get();
 
     results.reserve(ids.size());
+    if (attributes) attributes->reserve(ids.size());
     for (const auto& id : ids) {
         // get_vector metodunu mevcut transaction ile çağırıyoruz.
         // Not: get_vector içindeki transaction kontrol mantığına güveniyoruz.
         // get_vector, verilen txn null değilse onu kullanır ve abort etmez.
         auto cv = get_vector(id, txn);
         if (cv) {
+            if (attributes) attributes->push_back(get_vector_attributes(id, txn).value_or(VectorAttributes{}));
             results.push_back(std::move(cv));
         }
     }
-
-    mdb_txn_abort(txn); // Read-only transaction bitti
     return results;
 }
 
@@ -852,88 +1234,487 @@ bool SwarmVectorDB::delete_vector(const std::string& id) {
         return false;
     }
 
-    int rc;
-    MDB_txn* txn;
-    rc = mdb_txn_begin(env_, nullptr, 0, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (delete): " << mdb_strerror(rc));
-        return false;
-    }
+    return with_map_growth("delete_vector", [&]() -> bool {
+        int rc;
+        MDB_txn* txn;
+        rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (delete): " << mdb_strerror(rc));
+            return false;
+        }
+
+        rc = delete_vector_in_txn(txn, id);
+        if (rc == MDB_NOTFOUND) {
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB: Silinecek vektör bulunamadı. ID: " << id);
+            mdb_txn_abort(txn);
+            return true;
+        } else if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_del başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        // Tüm silme işlemleri tamamlandıktan sonra transaction'ı commit et
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız (delete): " << mdb_strerror(rc));
+            return false;
+        }
 
+        forget_hnsw_entry(id);
+        update_index_metrics_and_maybe_compact();
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör başarıyla silindi. ID: " << id);
+        return true;
+    });
+}
+
+int SwarmVectorDB::delete_vector_in_txn(MDB_txn* txn, const std::string& id, bool drop_attributes) {
     MDB_val key;
     key.mv_size = id.size();
     key.mv_data = (void*)id.data();
 
-    rc = mdb_del(txn, dbi_, &key, nullptr);
-    if (rc == MDB_NOTFOUND) {
-        LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB: Silinecek vektör bulunamadı. ID: " << id);
-        mdb_txn_abort(txn);
-        return true;
-    } else if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_del başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
-        return false;
+    int rc = txn_del(txn, dbi_, &key, nullptr);
+    if (rc != MDB_SUCCESS) return rc;
+    if (drop_attributes) {
+        rc = txn_del(txn, attributes_dbi_, &key, nullptr);
+        if (rc != MDB_SUCCESS && rc != MDB_NOTFOUND) return rc;
     }
 
-    // HNSW index'ten de kaldır
-    if (hnsw_index_ && id_to_hnsw_label_map_.count(id)) {
-        hnswlib::labeltype label_to_remove = id_to_hnsw_label_map_[id];
-        // HNSW index'te öğeyi silindi olarak işaretle
-        hnsw_index_->mark_deleted(label_to_remove); // Bu işlem diske yazma gerektirmez, sadece bellekte işaretler.
-        
+    // HNSW eşlemelerini LMDB'den kaldır; bellekteki eşlemeler commit sonrası forget_hnsw_entry ile güncellenir.
+    auto it = id_to_hnsw_label_map_.find(id);
+    if (it != id_to_hnsw_label_map_.end()) {
         MDB_val label_key_del, id_key_del;
-        std::string label_to_remove_str = std::to_string(label_to_remove);
+        std::string label_to_remove_str = std::to_string(it->second);
         label_key_del.mv_size = label_to_remove_str.size();
         label_key_del.mv_data = (void*)label_to_remove_str.data();
-        rc = mdb_del(txn, hnsw_label_to_id_map_dbi_, &label_key_del, nullptr);
+        rc = txn_del(txn, hnsw_label_to_id_map_dbi_, &label_key_del, nullptr);
         if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_vector(): hnsw_label_to_id_map del başarısız (label: " << label_to_remove_str << "): " << mdb_strerror(rc));
 
-        std::string id_str_del = id; // Ensure lifetime
-        id_key_del.mv_size = id_str_del.size();
-        id_key_del.mv_data = (void*)id_str_del.data();
-        rc = mdb_del(txn, id_to_hnsw_label_map_dbi_, &id_key_del, nullptr);
+        id_key_del.mv_size = id.size();
+        id_key_del.mv_data = (void*)id.data();
+        rc = txn_del(txn, id_to_hnsw_label_map_dbi_, &id_key_del, nullptr);
         if (rc != MDB_SUCCESS) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_vector(): id_to_hnsw_label_map del başarısız: " << mdb_strerror(rc));
+    }
+    return MDB_SUCCESS;
+}
 
-        hnsw_label_to_id_map_.erase(label_to_remove);
-        id_to_hnsw_label_map_.erase(id);
-        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: HNSW index haritasindan vektör kaldirildi. ID: " << id << ", Label: " << label_to_remove);
+void SwarmVectorDB::forget_hnsw_entry(const std::string& id) {
+    std::unique_lock<std::shared_mutex> index_lock(index_mutex_);
+    auto it = id_to_hnsw_label_map_.find(id);
+    if (it == id_to_hnsw_label_map_.end()) return;
+    const hnswlib::labeltype label = it->second;
+    // HNSW index'te öğeyi silindi olarak işaretle. Yuva, sıkıştırma indeksi yeniden kurana kadar yer kaplar.
+    if (hnsw_index_) hnsw_index_->mark_deleted(label);
+    log_index_op(label, {});
+    attribute_columns_.clear(label);
+    hnsw_label_to_id_map_.erase(label);
+    id_to_hnsw_label_map_.erase(it);
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: HNSW index haritasindan vektör kaldirildi. ID: " << id << ", Label: " << label);
+}
+
+bool SwarmVectorDB::quarantine_vector(const std::string& id, const std::string& reason) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ == nullptr) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Veritabanı açık değil. Vektör karantinaya alınamadı.");
+        return false;
     }
 
-    // Tüm silme işlemleri tamamlandıktan sonra transaction'ı commit et
-    rc = mdb_txn_commit(txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız (delete): " << mdb_strerror(rc));
+    return with_map_growth("quarantine_vector", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (quarantine): " << mdb_strerror(rc));
+            return false;
+        }
+
+        MDB_val key, data;
+        key.mv_size = id.size();
+        key.mv_data = (void*)id.data();
+        rc = mdb_get(txn, dbi_, &key, &data);
+        if (rc != MDB_SUCCESS) {
+            if (rc != MDB_NOTFOUND) LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::quarantine_vector(): mdb_get başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        Tombstone tombstone;
+        tombstone.quarantined_at_ms = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        tombstone.reason = reason;
+        tombstone.vector_bytes.assign(static_cast<const char*>(data.mv_data), data.mv_size);
+        if (mdb_get(txn, capsule_content_dbi_, &key, &data) == MDB_SUCCESS) {
+            tombstone.has_content = true;
+            tombstone.content.assign(static_cast<const char*>(data.mv_data), data.mv_size);
+        }
+
+        const std::string encoded = encode_tombstone(tombstone);
+        MDB_val tomb_val;
+        tomb_val.mv_size = encoded.size();
+        tomb_val.mv_data = (void*)encoded.data();
+        rc = txn_put(txn, quarantine_dbi_, &key, &tomb_val, 0);
+        if (rc == MDB_SUCCESS && tombstone.has_content) {
+            rc = txn_del(txn, capsule_content_dbi_, &key, nullptr);
+        }
+        if (rc == MDB_SUCCESS) rc = delete_vector_in_txn(txn, id, false);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::quarantine_vector(): karantinaya taşıma başarısız (ID: " << id << "): " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız (quarantine): " << mdb_strerror(rc));
+            return false;
+        }
+
+        forget_hnsw_entry(id);
+        update_index_metrics_and_maybe_compact();
+        LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB: Vektör karantinaya alındı. ID: " << id);
+        return true;
+    });
+}
+
+bool SwarmVectorDB::restore_vector(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ == nullptr) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: Veritabanı açık değil. Vektör karantinadan geri alınamadı.");
         return false;
     }
 
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB: Vektör başarıyla silindi. ID: " << id);
-    return true;
+    return with_map_growth("restore_vector", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (restore): " << mdb_strerror(rc));
+            return false;
+        }
+
+        MDB_val key, data;
+        key.mv_size = id.size();
+        key.mv_data = (void*)id.data();
+        Tombstone tombstone;
+        rc = mdb_get(txn, quarantine_dbi_, &key, &data);
+        if (rc != MDB_SUCCESS || !decode_tombstone(data, tombstone)) {
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::restore_vector(): Karantinada geçerli kayıt bulunamadı. ID: " << id);
+            mdb_txn_abort(txn);
+            return false;
+        }
+        if (mdb_get(txn, dbi_, &key, &data) == MDB_SUCCESS) {
+            // Karantinadan sonra aynı ID ile yeni bir kayıt eklenmiş; üzerine yazmak yerine geri almayı reddet.
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::restore_vector(): ID zaten aktif, karantina kaydı geri alınmadı. ID: " << id);
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        MDB_val vec_val;
+        vec_val.mv_size = tombstone.vector_bytes.size();
+        vec_val.mv_data = (void*)tombstone.vector_bytes.data();
+        rc = txn_put(txn, dbi_, &key, &vec_val, 0);
+        if (rc == MDB_SUCCESS && tombstone.has_content) {
+            MDB_val content_val;
+            content_val.mv_size = tombstone.content.size();
+            content_val.mv_data = (void*)tombstone.content.data();
+            rc = txn_put(txn, capsule_content_dbi_, &key, &content_val, 0);
+        }
+        if (rc == MDB_SUCCESS) rc = txn_del(txn, quarantine_dbi_, &key, nullptr);
+
+        // Serileştirilmiş vektör çözülüp HNSW'ye yeni bir etiketle eklenir.
+        PendingIndexUpdates pending;
+        std::unique_ptr<CryptofigVector> cv = (rc == MDB_SUCCESS) ? get_vector(id, txn) : nullptr;
+        if (!cv || !store_vector_in_txn(txn, *cv, pending)) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::restore_vector(): Vektör geri yüklenemedi (ID: " << id << "): " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
+
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_commit başarısız (restore): " << mdb_strerror(rc));
+            return false;
+        }
+
+        apply_pending_index_updates(pending);
+        update_index_metrics_and_maybe_compact();
+        LOG_DEFAULT(LogLevel::DEBUG, "SwarmVectorDB: Vektör karantinadan geri alındı. ID: " << id);
+        return true;
+    });
 }
 
+bool SwarmVectorDB::purge_quarantined(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ == nullptr) return false;
 
-std::vector<std::string> SwarmVectorDB::search_similar_vectors(const std::vector<float>& query_embedding, int top_k) const {
-    std::vector<std::string> result_ids;
-    if (!hnsw_index_) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::search_similar_vectors(): HNSW indeksi başlatılmamış. Arama yapilamadi.");
-        return result_ids;
+    return with_map_growth("purge_quarantined", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB: mdb_txn_begin başarısız (purge): " << mdb_strerror(rc));
+            return false;
+        }
+        MDB_val key;
+        key.mv_size = id.size();
+        key.mv_data = (void*)id.data();
+        rc = txn_del(txn, quarantine_dbi_, &key, nullptr);
+        if (rc != MDB_SUCCESS) {
+            mdb_txn_abort(txn);
+            return false;
+        }
+        // Karantinada korunan nitelik kaydı da silinir (aynı ID aktifse onunkine dokunulmaz).
+        MDB_val data;
+        if (mdb_get(txn, dbi_, &key, &data) == MDB_NOTFOUND) txn_del(txn, attributes_dbi_, &key, nullptr);
+        return txn_commit(txn) == MDB_SUCCESS;
+    });
+}
+
+std::vector<QuarantineEntry> SwarmVectorDB::list_quarantined() const {
+    std::vector<QuarantineEntry> entries;
+    auto lease = read_txns_.acquire();
+    if (!lease) return entries;
+    MDB_cursor* cursor;
+    if (mdb_cursor_open(lease.get(), quarantine_dbi_, &cursor) != MDB_SUCCESS) return entries;
+    MDB_val key, data;
+    while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == MDB_SUCCESS) {
+        Tombstone tombstone;
+        if (!decode_tombstone(data, tombstone)) continue;
+        QuarantineEntry entry;
+        entry.id.assign(static_cast<const char*>(key.mv_data), key.mv_size);
+        entry.reason = std::move(tombstone.reason);
+        entry.quarantined_at = std::chrono::system_clock::time_point(std::chrono::milliseconds(tombstone.quarantined_at_ms));
+        entries.push_back(std::move(entry));
     }
+    mdb_cursor_close(cursor);
+    return entries;
+}
 
-    try {
-        std::vector<hnswlib::labeltype> hnsw_results = hnsw_index_->search_knn(query_embedding, top_k);
-        
-        for (hnswlib::labeltype label : hnsw_results) {
-            if (hnsw_label_to_id_map_.count(label)) {
-                result_ids.push_back(hnsw_label_to_id_map_.at(label));
-            } else {
-                LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::search_similar_vectors(): HNSW label '" << label << "' için ID bulunamadı.");
+bool SwarmVectorDB::is_quarantined(const std::string& id) const {
+    auto lease = read_txns_.acquire();
+    if (!lease) return false;
+    MDB_val key, data;
+    key.mv_size = id.size();
+    key.mv_data = (void*)id.data();
+    return mdb_get(lease.get(), quarantine_dbi_, &key, &data) == MDB_SUCCESS;
+}
+
+// --- HNSW sıkıştırma ---
+
+void SwarmVectorDB::log_index_op(hnswlib::labeltype label, std::vector<float> embedding) {
+    if (compaction_log_active_) compaction_log_.push_back({label, std::move(embedding)});
+}
+
+void SwarmVectorDB::update_index_metrics() {
+    if (!hnsw_index_) return;
+    const size_t current = hnsw_index_->get_current_elements();
+    const size_t deleted = hnsw_index_->get_deleted_count();
+    db_metrics().hnsw_elements.set(static_cast<double>(current));
+    db_metrics().hnsw_deleted.set(static_cast<double>(deleted));
+    db_metrics().hnsw_deleted_ratio.set(current > 0 ? static_cast<double>(deleted) / static_cast<double>(current) : 0.0);
+}
+
+void SwarmVectorDB::update_index_metrics_and_maybe_compact() {
+    update_index_metrics();
+    if (!hnsw_index_ || compaction_running_) return;
+    const size_t current = hnsw_index_->get_current_elements();
+    const size_t deleted = hnsw_index_->get_deleted_count();
+    const size_t capacity = hnsw_index_->get_max_elements();
+    const bool too_many_deleted = deleted >= kCompactionMinDeleted &&
+                                  static_cast<double>(deleted) >= kCompactionDeletedRatio * static_cast<double>(current);
+    const bool nearly_full = capacity > 0 && static_cast<double>(current) >= kCompactionCapacityRatio * static_cast<double>(capacity);
+    if (too_many_deleted || nearly_full) {
+        LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB: HNSW sıkıştırması tetiklendi. Eleman: " << current << ", silinmiş: " << deleted << ", kapasite: " << capacity);
+        start_compaction_locked();
+    }
+}
+
+bool SwarmVectorDB::start_compaction_locked() {
+    if (env_ == nullptr || !hnsw_index_ || compaction_cancel_) return false;
+    if (compaction_running_.exchange(true)) return false;
+
+    std::vector<std::pair<hnswlib::labeltype, std::string>> live(hnsw_label_to_id_map_.begin(), hnsw_label_to_id_map_.end());
+    // Yeni kapasite canlı elemanların iki katından az olmaz; böylece doluluk tetikleyicisi hemen yeniden ateşlenmez.
+    const size_t capacity = std::max(hnsw_default_capacity_, live.size() * 2 + 1);
+    compaction_log_.clear();
+    compaction_log_active_ = true;
+    compaction_task_ = TaskScheduler::instance().submit(TaskClass::Persistence,
+        [this, live = std::move(live), capacity](const CancellationToken& token) mutable {
+            run_compaction(std::move(live), capacity, token);
+        });
+    return true;
+}
+
+void SwarmVectorDB::run_compaction(std::vector<std::pair<hnswlib::labeltype, std::string>> live, size_t capacity,
+                                   const CancellationToken& token) {
+    Metrics::ScopedTimer metric_timer(db_metrics().compaction_latency);
+    const int dim = hnsw_index_->get_dim(); // Boyut sabittir; işaretçi değişse de aynı kalır
+    auto fresh = std::make_shared<CerebrumLux::HNSW::HNSWIndex>(dim, capacity);
+    fresh->create_new_index();
+
+    // Yeni indeks kilitsiz kurulur; bu sırada aramalar ve yazmalar eski indeksle devam eder. Etiketler korunur,
+    // böylece ID <-> etiket haritaları değişmeden kalır.
+    // Okuma transaction'ı kCompactionReadChunk kayıtta bir yenilenir; böylece harita büyütmesi (okuyucu kapısının
+    // özel kilidi) sıkıştırmanın tamamını beklemez.
+    constexpr size_t kCompactionReadChunk = 1024;
+    bool ok = true;
+    for (size_t begin = 0; ok && begin < live.size(); begin += kCompactionReadChunk) {
+        auto lease = read_txns_.acquire();
+        if (!lease) {
+            ok = false;
+            break;
+        }
+        MDB_txn* txn = lease.get();
+        const size_t end = std::min(live.size(), begin + kCompactionReadChunk);
+        for (size_t i = begin; i < end; ++i) {
+            if (compaction_cancel_ || token.cancelled()) {
+                ok = false;
+                break;
+            }
+            std::unique_ptr<CryptofigVector> cv = get_vector(live[i].second, txn);
+            if (!cv) continue; // Anlık görüntüden sonra silinmiş
+            std::vector<float> emb(cv->embedding.data(), cv->embedding.data() + cv->embedding.size());
+            if (!fresh->add_item(emb, live[i].first)) {
+                ok = false;
+                break;
             }
         }
-        LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::search_similar_vectors(): " << result_ids.size() << " benzer vektör bulundu.");
+    }
 
-    } catch (const std::exception& e) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::search_similar_vectors(): HNSW arama hatasi: " << e.what());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ok && !compaction_cancel_ && env_ != nullptr) {
+            // Kurulum sırasında eski indekse yapılan değişiklikleri yeni indekse uygula, sonra atomik olarak değiştir.
+            for (IndexLogOp& op : compaction_log_) {
+                if (op.embedding.empty()) {
+                    fresh->mark_deleted(op.label);
+                } else {
+                    fresh->add_item(op.embedding, op.label);
+                }
+            }
+            const size_t reclaimed = hnsw_index_->get_current_elements() - fresh->get_current_elements();
+            std::unique_lock<std::shared_mutex> index_lock(index_mutex_);
+            std::atomic_store(&hnsw_index_, fresh);
+            index_lock.unlock();
+            ++compactions_done_;
+            db_metrics().compactions.inc();
+            LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB: HNSW sıkıştırması tamamlandı. Eleman: " << fresh->get_current_elements()
+                        << ", geri kazanılan yuva: " << reclaimed << ", kapasite: " << fresh->get_max_elements());
+        } else {
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB: HNSW sıkıştırması iptal edildi veya başarısız oldu; mevcut indeks korunuyor.");
+        }
+        compaction_log_active_ = false;
+        compaction_log_.clear();
+        compaction_log_.shrink_to_fit();
+        update_index_metrics();
     }
+    compaction_running_ = false;
+}
+
+void SwarmVectorDB::stop_compaction() {
+    compaction_cancel_ = true;
+    TaskHandle task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task = std::move(compaction_task_);
+    }
+    task.wait(); // Henüz başlamadıysa burada yürür ve iptal bayrağını görüp hemen biter
+}
 
+bool SwarmVectorDB::compact_index(bool wait) {
+    bool started = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        started = start_compaction_locked();
+    }
+    if (started && wait) {
+        TaskHandle task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task = compaction_task_;
+        }
+        task.wait();
+    }
+    return started;
+}
+
+VectorIndexStats SwarmVectorDB::get_index_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VectorIndexStats stats;
+    if (hnsw_index_) {
+        const size_t current = hnsw_index_->get_current_elements();
+        stats.deleted_elements = hnsw_index_->get_deleted_count();
+        stats.live_elements = current - std::min(current, stats.deleted_elements);
+        stats.capacity = hnsw_index_->get_max_elements();
+        stats.deleted_ratio = current > 0 ? static_cast<double>(stats.deleted_elements) / static_cast<double>(current) : 0.0;
+    }
+    stats.compactions = compactions_done_;
+    stats.compaction_running = compaction_running_;
+    if (auto lease = read_txns_.acquire()) { // mutex_ -> kapı: yazarlarla aynı kilit sırası
+        MDB_stat stat;
+        if (mdb_stat(lease.get(), quarantine_dbi_, &stat) == MDB_SUCCESS) stats.quarantined = stat.ms_entries;
+    }
+    return stats;
+}
+
+
+LmdbEnvStats SwarmVectorDB::get_env_stats() const {
+    LmdbEnvStats stats;
+    // Kira kapıyı paylaşımlı tuttuğundan harita bu sırada büyütülmez; yazarlar beklenmez.
+    auto lease = read_txns_.acquire();
+    if (!lease) return stats;
+    MDB_txn* txn = lease.get();
+
+    MDB_envinfo info;
+    MDB_stat env_stat;
+    if (mdb_env_info(env_, &info) != MDB_SUCCESS || mdb_env_stat(env_, &env_stat) != MDB_SUCCESS) return stats;
+    stats.map_size = info.me_mapsize;
+    stats.page_size = env_stat.ms_psize;
+    stats.last_page = info.me_last_pgno;
+    stats.used_bytes = (info.me_last_pgno + 1) * env_stat.ms_psize;
+    stats.map_usage = stats.map_size ? static_cast<double>(stats.used_bytes) / static_cast<double>(stats.map_size) : 0.0;
+    stats.max_readers = info.me_maxreaders;
+    stats.readers = info.me_numreaders;
+    stats.map_resizes = map_resizes_;
+
+    // Serbest sayfalar: FREE_DBI (0) kayıtlarının her biri, ilk elemanı liste uzunluğu olan bir sayfa numarası listesidir.
+    MDB_cursor* cursor = nullptr;
+    if (mdb_cursor_open(txn, 0, &cursor) == MDB_SUCCESS) {
+        MDB_val key, data;
+        while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == MDB_SUCCESS) {
+            if (data.mv_size >= sizeof(size_t)) stats.free_pages += *static_cast<const size_t*>(data.mv_data);
+        }
+        mdb_cursor_close(cursor);
+    }
+
+    const std::pair<const char*, MDB_dbi> databases[] = {
+        {"cryptofig_vectors", dbi_},
+        {"hnsw_label_to_id_map", hnsw_label_to_id_map_dbi_},
+        {"id_to_hnsw_label_map", id_to_hnsw_label_map_dbi_},
+        {"hnsw_next_label_dbi", hnsw_next_label_dbi_},
+        {"q_values_db", q_values_dbi_},
+        {"q_metadata_db", q_metadata_dbi_},
+        {"capsule_content_db", capsule_content_dbi_},
+        {"strategy_outcome_db", strategy_outcome_dbi_},
+        {"quarantine_db", quarantine_dbi_},
+        {"vector_attributes_db", attributes_dbi_},
+    };
+    for (const auto& db : databases) {
+        MDB_stat st;
+        if (mdb_stat(txn, db.second, &st) != MDB_SUCCESS) continue;
+        LmdbDbiStats entry;
+        entry.name = db.first;
+        entry.depth = st.ms_depth;
+        entry.branch_pages = st.ms_branch_pages;
+        entry.leaf_pages = st.ms_leaf_pages;
+        entry.overflow_pages = st.ms_overflow_pages;
+        entry.entries = st.ms_entries;
+        stats.databases.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+std::vector<std::string> SwarmVectorDB::search_similar_vectors(const std::vector<float>& query_embedding, int top_k) const {
+    std::vector<std::string> result_ids;
+    for (auto& hit : search_similar_scored(query_embedding, top_k)) result_ids.push_back(std::move(hit.first));
+    LOG_DEFAULT(LogLevel::INFO, "SwarmVectorDB::search_similar_vectors(): " << result_ids.size() << " benzer vektör bulundu.");
     return result_ids;
 }
 
@@ -969,24 +1750,79 @@ std::vector<std::string> SwarmVectorDB::get_all_ids_internal(MDB_txn* txn) const
 }
 
 
-std::vector<std::string> SwarmVectorDB::get_all_ids() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::vector<std::string> ids;
-    if (env_ == nullptr) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_ids(): Veritabanı açık değil.");
+std::vector<std::string> SwarmVectorDB::search_similar_vectors_filtered(const std::vector<float>& query_embedding, int top_k,
+                                                                       const VectorFilter& filter) const {
+    std::vector<std::string> result_ids;
+    for (auto& hit : search_similar_scored(query_embedding, top_k, &filter)) result_ids.push_back(std::move(hit.first));
+    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::search_similar_vectors_filtered(): " << result_ids.size() << " sonuç.");
+    return result_ids;
+}
+
+std::vector<std::pair<std::string, float>> SwarmVectorDB::search_similar_scored(const std::vector<float>& query_embedding, int top_k,
+                                                                                const VectorFilter* filter) const {
+    const bool filtered = filter && !filter->empty();
+    Metrics::ScopedTimer metric_timer(filtered ? db_metrics().filtered_search_latency : db_metrics().search_latency);
+
+    std::vector<std::pair<std::string, float>> results;
+    // İndeksin anlık kopyası: arka plan sıkıştırması indeksi değiştirse bile bu arama eski indeksle tamamlanır.
+    const std::shared_ptr<CerebrumLux::HNSW::HNSWIndex> index = std::atomic_load(&hnsw_index_);
+    if (!index) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::search_similar_vectors(): HNSW indeksi başlatılmamış. Arama yapilamadi.");
+        return results;
     }
+    if (top_k <= 0) return results;
 
-    MDB_txn* txn = nullptr; // Initialize to nullptr
-    int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_ids(): mdb_txn_begin başarısız: " << mdb_strerror(rc) << ").");
-        return ids;
+    // Graf araması ve etiket -> ID çevirisi boyunca paylaşımlı: aramalar birbirini beklemez, yalnızca ekleme/silme bekler.
+    std::shared_lock<std::shared_mutex> index_lock(index_mutex_);
+    std::vector<CerebrumLux::HNSW::HNSWIndex::ScoredLabel> hits;
+    try {
+        if (!filtered) {
+            hits = index->search_knn_scored(query_embedding, top_k);
+        } else {
+            // Sütunlar arama boyunca değişmesin diye okuma kilidi tutulur (index_mutex_'ten sonra: yazarlarla aynı sıra).
+            auto columns_lock = attribute_columns_.read_lock();
+            const AttributeColumns::CompiledFilter compiled = attribute_columns_.compile(*filter);
+            if (compiled.impossible) return results;
+
+            std::vector<hnswlib::labeltype> candidates = attribute_columns_.matching_labels(compiled, kExactSearchMaxCandidates);
+            if (candidates.size() <= kExactSearchMaxCandidates) {
+                hits = index->search_exact_scored(query_embedding, candidates, top_k);
+                db_metrics().filtered_exact.inc();
+            } else {
+                AttributeFilterFunctor functor(attribute_columns_, compiled);
+                hits = index->search_knn_scored(query_embedding, top_k, &functor);
+                db_metrics().filtered_graph.inc();
+                if (hits.size() < static_cast<size_t>(top_k)) {
+                    // Graf araması ef sınırında yeterli eşleşme bulamadı: tüm adaylar üzerinde tam arama.
+                    hits = index->search_exact_scored(query_embedding, attribute_columns_.matching_labels(compiled), top_k);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::search_similar_vectors(): HNSW arama hatasi: " << e.what());
+        return results;
     }
 
-    ids = get_all_ids_internal(txn); // Call the internal helper with the new transaction
-    mdb_txn_abort(txn); // Abort the read-only transaction
+    results.reserve(hits.size());
+    for (const auto& hit : hits) {
+        auto it = hnsw_label_to_id_map_.find(hit.second);
+        if (it != hnsw_label_to_id_map_.end()) {
+            results.emplace_back(it->second, hit.first);
+        } else {
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::search_similar_vectors(): HNSW label '" << hit.second << "' için ID bulunamadı.");
+        }
+    }
+    return results;
+}
 
-    return ids;
+std::vector<std::string> SwarmVectorDB::get_all_ids() const {
+    std::vector<std::string> ids;
+    auto lease = read_txns_.acquire();
+    if (!lease) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_ids(): Veritabanı açık değil veya okuma transaction'ı alınamadı.");
+        return ids;
+    }
+    return get_all_ids_internal(lease.get());
 }
 
 
@@ -998,66 +1834,59 @@ bool SwarmVectorDB::store_q_value_json(const EmbeddingStateKey& state_key, const
         return false;
     }
 
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, 0, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return false;
-    }
+    return with_map_growth("store_q_value_json", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+            return false;
+        }
 
-    MDB_val key, data;
-    key.mv_size = state_key.length();
-    key.mv_data = (void*)state_key.c_str();
-    data.mv_size = action_map_json_str.length();
-    data.mv_data = (void*)action_map_json_str.c_str();
+        MDB_val key, data;
+        key.mv_size = state_key.length();
+        key.mv_data = (void*)state_key.c_str();
+        data.mv_size = action_map_json_str.length();
+        data.mv_data = (void*)action_map_json_str.c_str();
 
-    rc = mdb_put(txn, q_values_dbi_, &key, &data, 0);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_put başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
-        return false;
-    }
+        rc = txn_put(txn, q_values_dbi_, &key, &data, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_put başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
 
-    rc = mdb_txn_commit(txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
-        return false;
-    }
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::store_q_value_json(): Q-değeri başarıyla depolandı. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
-    return true;
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_q_value_json(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::store_q_value_json(): Q-değeri başarıyla depolandı. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
+        return true;
+    });
 }
 
 std::optional<std::string> SwarmVectorDB::get_q_value_json(const EmbeddingStateKey& state_key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (env_ == nullptr) {
+    auto lease = read_txns_.acquire();
+    if (!lease) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_q_value_json(): Veritabanı açık değil. Q-değeri getirilemedi.");
         return std::nullopt;
     }
-
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_q_value_json(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return std::nullopt;
-    }
+    MDB_txn* txn = lease.get();
 
     MDB_val key, data;
     key.mv_size = state_key.length();
     key.mv_data = (void*)state_key.c_str();
 
-    rc = mdb_get(txn, q_values_dbi_, &key, &data);
+    int rc = mdb_get(txn, q_values_dbi_, &key, &data);
     if (rc == MDB_NOTFOUND) {
         LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::get_q_value_json(): Q-değeri bulunamadı. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
-        mdb_txn_abort(txn);
         return std::nullopt;
     } else if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_q_value_json(): mdb_get başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
         return std::nullopt;
     }
 
     std::string json_str(static_cast<char*>(data.mv_data), data.mv_size);
-    mdb_txn_abort(txn);
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::get_q_value_json(): Q-değeri başarıyla getirildi. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
     return json_str;
 }
@@ -1069,57 +1898,51 @@ bool SwarmVectorDB::delete_q_value_json(const EmbeddingStateKey& state_key) {
         return false;
     }
 
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, 0, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return false;
-    }
+    return with_map_growth("delete_q_value_json", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+            return false;
+        }
 
-    MDB_val key;
-    key.mv_size = state_key.length();
-    key.mv_data = (void*)state_key.c_str();
+        MDB_val key;
+        key.mv_size = state_key.length();
+        key.mv_data = (void*)state_key.c_str();
+
+        rc = txn_del(txn, q_values_dbi_, &key, nullptr);
+        if (rc == MDB_NOTFOUND) {
+            LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::delete_q_value_json(): Silinecek Q-değeri bulunamadı. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
+            mdb_txn_abort(txn);
+            return true;
+        } else if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_del başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
 
-    rc = mdb_del(txn, q_values_dbi_, &key, nullptr);
-    if (rc == MDB_NOTFOUND) {
-        LOG_DEFAULT(LogLevel::WARNING, "SwarmVectorDB::delete_q_value_json(): Silinecek Q-değeri bulunamadı. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
-        mdb_txn_abort(txn);
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::delete_q_value_json(): Q-değeri başarıyla silindi. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
         return true;
-    } else if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_del başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
-        return false;
-    }
-
-    rc = mdb_txn_commit(txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::delete_q_value_json(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
-        return false;
-    }
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::delete_q_value_json(): Q-değeri başarıyla silindi. EmbeddingStateKey (kısmi): " << state_key.substr(0, std::min((size_t)50, state_key.length())));
-    return true;
+    });
 }
 
 std::vector<EmbeddingStateKey> SwarmVectorDB::get_all_keys_for_dbi(MDB_dbi dbi) const {
     std::vector<EmbeddingStateKey> keys;
-    std::lock_guard<std::mutex> lock(mutex_); // Mutex kilidi al
-    if (env_ == nullptr) {
+    auto lease = read_txns_.acquire();
+    if (!lease) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_keys_for_dbi(): Veritabanı açık değil.");
         return keys;
     }
 
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_keys_for_dbi(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return keys;
-    }
-
     MDB_cursor* cursor;
-    rc = mdb_cursor_open(txn, dbi, &cursor);
+    int rc = mdb_cursor_open(lease.get(), dbi, &cursor);
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::get_all_keys_for_dbi(): mdb_cursor_open başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
         return keys;
     }
 
@@ -1129,7 +1952,6 @@ std::vector<EmbeddingStateKey> SwarmVectorDB::get_all_keys_for_dbi(MDB_dbi dbi)
     }
 
     mdb_cursor_close(cursor);
-    mdb_txn_abort(txn); // Salt okunur işlem iptal edilebilir
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::get_all_keys_for_dbi(): DBI " << dbi << " için toplam " << keys.size() << " anahtar getirildi.");
     return keys;
 }
@@ -1137,46 +1959,49 @@ std::vector<EmbeddingStateKey> SwarmVectorDB::get_all_keys_for_dbi(MDB_dbi dbi)
 
 // YENİ: Kapsül içeriğini depolamak için metot
 bool SwarmVectorDB::store_capsule_content(const std::string& id, const std::string& content, MDB_txn* existing_txn) {
-    bool created_new_txn = false;
-    MDB_txn* current_txn = existing_txn;
-    if (!current_txn) {
-        int rc = mdb_txn_begin(env_, nullptr, 0, &current_txn);
-        if (rc != MDB_SUCCESS) {
-            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_capsule_content(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-            return false;
-        }
-        created_new_txn = true;
-    }
-
     MDB_val key, data;
     key.mv_size = id.length();
     key.mv_data = (void*)id.c_str();
     data.mv_size = content.length();
     data.mv_data = (void*)content.c_str();
 
-    int rc = mdb_put(current_txn, capsule_content_dbi_, &key, &data, 0);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_capsule_content(): mdb_put başarısız: " << mdb_strerror(rc));
-        if (created_new_txn) mdb_txn_abort(current_txn);
-        return false;
+    if (existing_txn) {
+        // Transaction'ın sahibi (mutex_ altında) harita dolarsa yeniden denemeyi kendisi yapar.
+        int rc = txn_put(existing_txn, capsule_content_dbi_, &key, &data, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_capsule_content(): mdb_put başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+        return true;
     }
 
-    if (created_new_txn) {
-        rc = mdb_txn_commit(current_txn);
-        if (rc != MDB_SUCCESS) return false;
-    }
-    return true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (env_ == nullptr) return false;
+    return with_map_growth("store_capsule_content", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_capsule_content(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+        rc = txn_put(txn, capsule_content_dbi_, &key, &data, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_capsule_content(): mdb_put başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
+        return txn_commit(txn) == MDB_SUCCESS;
+    });
 }
 
 // YENİ: Kapsül içeriğini getirmek için metot
 std::optional<std::string> SwarmVectorDB::get_capsule_content(const std::string& id, MDB_txn* existing_txn) const {
-    if (!env_) return std::nullopt;
-
     MDB_txn* txn = existing_txn;
-    bool local_txn = false;
+    ReadTxnPool::Lease lease;
     if (!txn) {
-        if (mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn) != MDB_SUCCESS) return std::nullopt;
-        local_txn = true;
+        lease = read_txns_.acquire();
+        if (!lease) return std::nullopt;
+        txn = lease.get();
     }
 
     MDB_val key = { id.size(), (void*)id.data() };
@@ -1186,7 +2011,6 @@ std::optional<std::string> SwarmVectorDB::get_capsule_content(const std::string&
     std::optional<std::string> result;
     if (rc == MDB_SUCCESS) result = std::string((char*)data.mv_data, data.mv_size);
 
-    if (local_txn) mdb_txn_abort(txn);
     return result;
 }
 
@@ -1200,62 +2024,56 @@ bool SwarmVectorDB::store_strategy_outcome(UserIntent intent, const StrategyOutc
         return false;
     }
 
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, 0, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return false;
-    }
+    return with_map_growth("store_strategy_outcome", [&]() -> bool {
+        MDB_txn* txn;
+        int rc = begin_write_txn(&txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+            return false;
+        }
 
-    nlohmann::json j_outcome = outcome; // StrategyOutcome'u JSON'a dönüştür
-    std::string outcome_json_str = j_outcome.dump();
+        nlohmann::json j_outcome = outcome; // StrategyOutcome'u JSON'a dönüştür
+        std::string outcome_json_str = j_outcome.dump();
 
-    // Anahtar: IntentType_timestamp (örn: CODE_1678886400)
-    std::string key_str = CerebrumLux::to_string(intent) + "_" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        // Anahtar: IntentType_timestamp (örn: CODE_1678886400)
+        std::string key_str = CerebrumLux::to_string(intent) + "_" + std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
     
-    MDB_val key, data;
-    key.mv_size = key_str.length();
-    key.mv_data = (void*)key_str.c_str();
-    data.mv_size = outcome_json_str.length();
-    data.mv_data = (void*)outcome_json_str.c_str();
+        MDB_val key, data;
+        key.mv_size = key_str.length();
+        key.mv_data = (void*)key_str.c_str();
+        data.mv_size = outcome_json_str.length();
+        data.mv_data = (void*)outcome_json_str.c_str();
 
-    rc = mdb_put(txn, strategy_outcome_dbi_, &key, &data, 0);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_put başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
-        return false;
-    }
+        rc = txn_put(txn, strategy_outcome_dbi_, &key, &data, 0);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_put başarısız: " << mdb_strerror(rc));
+            mdb_txn_abort(txn);
+            return false;
+        }
 
-    rc = mdb_txn_commit(txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
-        return false;
-    }
-    LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::store_strategy_outcome(): Strateji sonucu başarıyla depolandı. Intent: " << CerebrumLux::to_string(intent) << ", Key: " << key_str);
-    return true;
+        rc = txn_commit(txn);
+        if (rc != MDB_SUCCESS) {
+            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::store_strategy_outcome(): mdb_txn_commit başarısız: " << mdb_strerror(rc));
+            return false;
+        }
+        LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::store_strategy_outcome(): Strateji sonucu başarıyla depolandı. Intent: " << CerebrumLux::to_string(intent) << ", Key: " << key_str);
+        return true;
+    });
 }
 
 // YENİ: Öğretme stratejisi geçmişini yüklemek için metot
 std::vector<StrategyOutcome> SwarmVectorDB::load_strategy_history(UserIntent intent, int limit) const {
     std::vector<StrategyOutcome> history;
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (env_ == nullptr) {
+    auto lease = read_txns_.acquire();
+    if (!lease) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::load_strategy_history(): Veritabanı açık değil. Strateji geçmişi yüklenemedi.");
         return history;
     }
 
-    MDB_txn* txn;
-    int rc = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
-    if (rc != MDB_SUCCESS) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::load_strategy_history(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
-        return history;
-    }
-
     MDB_cursor* cursor;
-    rc = mdb_cursor_open(txn, strategy_outcome_dbi_, &cursor);
+    int rc = mdb_cursor_open(lease.get(), strategy_outcome_dbi_, &cursor);
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "SwarmVectorDB::load_strategy_history(): mdb_cursor_open başarısız: " << mdb_strerror(rc));
-        mdb_txn_abort(txn);
         return history;
     }
 
@@ -1314,7 +2132,6 @@ std::vector<StrategyOutcome> SwarmVectorDB::load_strategy_history(UserIntent int
     }
 
     mdb_cursor_close(cursor);
-    mdb_txn_abort(txn);
     LOG_DEFAULT(LogLevel::TRACE, "SwarmVectorDB::load_strategy_history(): Intent " << CerebrumLux::to_string(intent) << " için " << history.size() << " strateji sonucu yüklendi.");
     return history;
 }
@@ -5,11 +5,20 @@
 #include <vector>
 #include <memory> // std::unique_ptr için
 #include <mutex> // LMDB erişimi için mutex
+#include <shared_mutex> // LMDB harita büyütmesi sırasında okuyucuları durdurmak için
+#include <functional>
 #include <map> // hnswlib label'larını ID'lerle eşlemek için
+#include <atomic> // Arka plan sıkıştırma durumu için
+#include <optional>
+#include <chrono>
 #include <nlohmann/json.hpp> // JSON serileştirme için
 
 #include "../core/logger.h" // CerebrumLux Logger için
 #include "DataModels.h"     // CryptofigVector için
+#include "ConsensusTree.h"  // SwarmConsensusTree için
+#include "AttributeColumns.h" // Filtreli arama için nitelik sütunları
+#include "ReadTxnPool.h"      // Okuma transaction'ı havuzu
+#include "../core/task_scheduler.h" // Arka plan HNSW sıkıştırması (Persistence sınıfı)
 #include "../hnswlib_wrapper.h" // HNSWIndex wrapper için
 #include "../learning/StrategyOutcome.h" // StrategyOutcome için
 #include "../core/enums.h" // UserIntent için
@@ -24,25 +33,69 @@
 namespace CerebrumLux {
 namespace SwarmVectorDB {
 
-// Sürü Konsensüs Ağacı (Merkle Tree benzeri)
-class SwarmConsensusTree {
-public:
-    SwarmConsensusTree();
-    // CryptofigVector'den hash oluşturur ve ağacı günceller
-    void update_tree(const CryptofigVector& cv);
-    // Kök hash'i döndürür
-    std::string get_root_hash() const { return root_hash_; }
+// HNSW indeksi ve karantina deposu için anlık durum bilgisi.
+struct VectorIndexStats {
+    size_t live_elements = 0;      // Aramaya katılan (silinmemiş) eleman sayısı
+    size_t deleted_elements = 0;   // Silinmiş işaretli, yer kaplayan yuvalar
+    size_t capacity = 0;           // HNSW indeksinin max_elements değeri
+    double deleted_ratio = 0.0;    // deleted / (live + deleted)
+    size_t quarantined = 0;        // Karantina DBI'ındaki kayıt sayısı
+    size_t compactions = 0;        // Bu oturumda tamamlanan sıkıştırma sayısı
+    bool compaction_running = false;
+};
 
-private:
-    std::vector<std::string> leaf_hashes_; // CryptofigVector hash'leri
-    std::string root_hash_;
-    std::mutex mutex_; // Thread güvenliği için
+// LMDB bellek eşlemesinin boyutlandırılması. Bir yazma transaction'ı MDB_MAP_FULL ile başarısız olursa yazarlar
+// ve okuyucular durdurulur, harita growth_factor katına (en fazla max_size'a) büyütülür ve transaction baştan denenir.
+struct LmdbMapOptions {
+    size_t initial_size = 4ULL * 1024ULL * 1024ULL * 1024ULL; // 4GB; mevcut dosya daha büyükse dosya boyutu kullanılır
+    size_t max_size = 64ULL * 1024ULL * 1024ULL * 1024ULL;    // Bu sınırda harita dolarsa yazma başarısız olur
+    double growth_factor = 2.0;
+};
+
+// Tek bir DBI'ın B+ ağacı istatistikleri (mdb_stat).
+struct LmdbDbiStats {
+    std::string name;
+    unsigned int depth = 0;
+    size_t branch_pages = 0;
+    size_t leaf_pages = 0;
+    size_t overflow_pages = 0;
+    size_t entries = 0;
+};
+
+// LMDB ortamının anlık durumu; dağıtım boyutlandırması için.
+struct LmdbEnvStats {
+    size_t map_size = 0;     // Geçerli harita boyutu (bayt)
+    size_t page_size = 0;
+    size_t last_page = 0;    // Kullanılan en yüksek sayfa numarası
+    size_t used_bytes = 0;   // (last_page + 1) * page_size
+    size_t free_pages = 0;   // Serbest listede yeniden kullanılmayı bekleyen sayfalar
+    double map_usage = 0.0;  // used_bytes / map_size
+    unsigned int max_readers = 0;
+    unsigned int readers = 0; // Kullanımdaki okuyucu yuvaları
+    size_t map_resizes = 0;   // Bu oturumda yapılan büyütme sayısı
+    std::vector<LmdbDbiStats> databases;
+};
+
+// Karantinaya alınmış bir kaydın özeti.
+struct QuarantineEntry {
+    std::string id;
+    std::string reason;
+    std::chrono::system_clock::time_point quarantined_at;
 };
 
 // Yerel Vektör Deposu (LMDB tabanlı)
 class SwarmVectorDB {
 public:
-    SwarmVectorDB(const std::string& db_path);
+    // Silinmiş yuvaların oranı bu eşiği (ve en az kCompactionMinDeleted yuvayı) aşınca ya da indeks doluluğu
+    // kCompactionCapacityRatio'ya ulaşınca arka planda sıkıştırma başlatılır.
+    static constexpr double kCompactionDeletedRatio = 0.25;
+    static constexpr size_t kCompactionMinDeleted = 256;
+    static constexpr double kCompactionCapacityRatio = 0.9;
+    // Filtreyi geçen etiket sayısı bunu aşmıyorsa filtreli arama graf yerine adaylar üzerinde tam arama yapar.
+    static constexpr size_t kExactSearchMaxCandidates = 4096;
+
+    // hnsw_max_elements: yeni oluşturulan HNSW indeksinin kapasitesi (diskten yüklenen indeks kendi kapasitesini korur)
+    explicit SwarmVectorDB(const std::string& db_path, size_t hnsw_max_elements = 100000, LmdbMapOptions map_options = {});
     ~SwarmVectorDB();
 
     // Vektör veritabanını açar veya oluşturur
@@ -50,20 +103,54 @@ public:
     // Vektör veritabanını kapatır
     void close();
 
-    // CryptofigVector'ü veritabanına depolar
+    // CryptofigVector'ü veritabanına depolar. Nitelik verilmezse mevcut nitelik kaydı korunur (yoksa konu
+    // cv.topic'ten, diğer alanlar varsayılandan alınır). Konu her zaman cv.topic'tir.
     bool store_vector(const CryptofigVector& cv);
+    bool store_vector(const CryptofigVector& cv, const VectorAttributes& attributes);
+    // Vektörleri (ve contents/attributes boş değilse aynı sıradaki kapsül içeriklerini ve nitelikleri) tek bir
+    // yazma transaction'ında depolar. Herhangi bir kayıt başarısız olursa grubun tamamı geri alınır.
+    bool store_vectors_batch(const std::vector<CryptofigVector>& cvs, const std::vector<std::string>& contents = {},
+                             const std::vector<VectorAttributes>& attributes = {});
+    std::optional<VectorAttributes> get_vector_attributes(const std::string& id, MDB_txn* existing_txn = nullptr) const;
     // Verilen hash'e sahip CryptofigVector'ü veritabanından getirir
     std::unique_ptr<CryptofigVector> get_vector(const std::string& id, MDB_txn* existing_txn = nullptr) const; // Keep consistent
     // Verilen hash'e sahip vektörü siler
 
     // YENİ: Toplu okuma fonksiyonu (Performans optimizasyonu)
-    std::vector<std::unique_ptr<CryptofigVector>> get_vectors_batch(const std::vector<std::string>& ids) const;
+    // attributes verilirse bulunan her vektörün nitelikleri aynı okuma transaction'ında, sonuçlarla aynı sırada
+    // doldurulur (nitelik kaydı yoksa varsayılan değerler).
+    std::vector<std::unique_ptr<CryptofigVector>> get_vectors_batch(const std::vector<std::string>& ids,
+                                                                    std::vector<VectorAttributes>* attributes = nullptr) const;
 
     bool delete_vector(const std::string& id);
+
+    // Karantina (tombstone) deposu: vektör ve kapsül içeriği aktif DBI'lardan ve HNSW'den çıkarılıp
+    // quarantine_db'ye taşınır. restore_vector ile geri alınabilir, purge_quarantined ile kalıcı olarak silinir.
+    bool quarantine_vector(const std::string& id, const std::string& reason = "");
+    bool restore_vector(const std::string& id);
+    bool purge_quarantined(const std::string& id);
+    std::vector<QuarantineEntry> list_quarantined() const;
+    bool is_quarantined(const std::string& id) const;
+
+    // HNSW indeksini yalnızca canlı elemanlarla arka planda yeniden kurar ve hazır olunca atomik olarak
+    // değiştirir; bu sırada aramalar eski indeksle devam eder. Zaten çalışıyorsa false döner.
+    bool compact_index(bool wait = false);
+    VectorIndexStats get_index_stats() const;
+    LmdbEnvStats get_env_stats() const;
+    ReadTxnPool::Stats read_txn_stats() const { return read_txns_.stats(); }
     // Veritabanının açık olup olmadığını döndürür
     bool is_open() const { return env_ != nullptr; }
     // En yakın N vektörü arar (hnswlib kullanır)
     std::vector<std::string> search_similar_vectors(const std::vector<float>& query_embedding, int top_k) const;
+    // Nitelik filtresiyle en yakın N vektör. Filtre HNSW graf aramasının içinde uygulanır; filtreyi geçen etiket
+    // sayısı kExactSearchMaxCandidates'i aşmıyorsa (veya graf araması yeterli sonuç bulamazsa) adaylar üzerinde
+    // tam arama yapılır. Sonradan eleme yapılmadığı için top_k sonuç, filtreyi geçen vektör varsa eksiksiz döner.
+    std::vector<std::string> search_similar_vectors_filtered(const std::vector<float>& query_embedding, int top_k,
+                                                             const VectorFilter& filter) const;
+    // Yukarıdakilerin mesafeli sürümü: (ID, karesi alınmış L2 mesafe), yakından uzağa. filter null veya boşsa
+    // filtresiz arama yapılır. Parçalı veritabanı (ShardedSwarmVectorDB) sonuçları bu mesafelerle birleştirir.
+    std::vector<std::pair<std::string, float>> search_similar_scored(const std::vector<float>& query_embedding, int top_k,
+                                                                     const VectorFilter* filter = nullptr) const;
     // Veritabanındaki tüm ID'leri döndürür (dikkat: büyük DB'lerde yavaş olabilir)
     std::vector<std::string> get_all_ids() const;
 
@@ -88,6 +175,9 @@ public:
     MDB_env* get_env() const { return env_; }
     MDB_dbi get_dbi() const { return dbi_; }
     MDB_dbi q_values_dbi() const { return q_values_dbi_; } // YENİ: q_values_dbi_ için getter
+    // get_env() ile kendi okuma transaction'ını açanlar, transaction boyunca bu kilidi tutmalıdır: harita büyütülürken
+    // bellek eşlemesi yeniden kurulur ve açık okuma transaction'larının gösterdiği veriler geçersizleşir.
+    std::shared_lock<std::shared_mutex> read_gate() const { return std::shared_lock<std::shared_mutex>(map_resize_mutex_); }
 
 
 private:
@@ -95,6 +185,15 @@ private:
     MDB_env* env_; // LMDB ortamı
     MDB_dbi dbi_;                         // LMDB veritabanı handle'ı
     mutable std::mutex mutex_;            // Thread güvenliği için (const metotlarda kilitlenebilmesi için mutable eklendi)
+    // Harita büyütme kapısı: mutex_ dışında okuma transaction'ı açanlar paylaşımlı, büyütme (mutex_ tutulurken) özel alır.
+    // Kilit sırası her zaman mutex_ -> map_resize_mutex_'tir.
+    mutable std::shared_mutex map_resize_mutex_;
+    // Okuyucular mutex_ almaz: transaction'ı bu havuzdan kiralar (kira kapıyı paylaşımlı tutar). Kira tutan bir
+    // iş parçacığı mutex_ almamalıdır; iç içe kiralar kapıyı yeniden kilitlemez (bkz. ReadTxnPool).
+    mutable ReadTxnPool read_txns_{map_resize_mutex_};
+    LmdbMapOptions map_options_;
+    std::atomic<bool> map_full_hit_{false}; // Geçerli yazma denemesinde MDB_MAP_FULL görüldü mü
+    std::atomic<size_t> map_resizes_{0};
     MDB_dbi hnsw_label_to_id_map_dbi_;    // HNSW label -> CryptofigVector ID haritası için DBI
     MDB_dbi id_to_hnsw_label_map_dbi_;    // CryptofigVector ID -> HNSW label haritası için DBI
     MDB_dbi hnsw_next_label_dbi_;         // Bir sonraki hnswlib label değerini saklamak için DBI
@@ -105,16 +204,82 @@ private:
     // YENİ: Öğretme stratejisi sonuçları için DBI
     MDB_dbi strategy_outcome_dbi_;
 
-    // HNSW index'i std::unique_ptr ile yönetiyoruz
-    std::unique_ptr<CerebrumLux::HNSW::HNSWIndex> hnsw_index_; 
+    // HNSW index'i paylaşımlı işaretçiyle yönetiyoruz: aramalar std::atomic_load ile anlık bir kopya alır,
+    // sıkıştırma yeni indeksi std::atomic_store ile yerleştirir. Eski indeks son arama bitince serbest kalır.
+    std::shared_ptr<CerebrumLux::HNSW::HNSWIndex> hnsw_index_; 
+    size_t hnsw_default_capacity_;
     hnswlib::labeltype next_hnsw_label_ = 0; // HNSW index'e eklenecek bir sonraki etiket
     std::map<hnswlib::labeltype, std::string> hnsw_label_to_id_map_; // HNSW etiketlerini CryptofigVector ID'lerine eşler
     std::map<std::string, hnswlib::labeltype> id_to_hnsw_label_map_; // CryptofigVector ID'lerini HNSW etiketlerine eşler
+    // HNSW grafını ve yukarıdaki iki haritayı korur: aramalar paylaşımlı, yazarlar (mutex_ tutarken) özel alır.
+    // Kilit sırası mutex_ -> index_mutex_ -> nitelik sütunları kilidi.
+    mutable std::shared_mutex index_mutex_;
 
     MDB_dbi capsule_content_dbi_; // Kapsül içeriklerini saklamak için
+    MDB_dbi quarantine_dbi_;      // Karantinadaki kayıtlar (ID -> tombstone)
+    MDB_dbi attributes_dbi_;      // Vektör nitelikleri (ID -> VectorAttributes::encode)
+    AttributeColumns attribute_columns_; // HNSW etiketine göre bellekteki nitelik sütunları
+
+    // Arka plan sıkıştırması. Çalışırken indekse yapılan ekleme/silmeler compaction_log_'a da yazılır ve yeni
+    // indeks yerleştirilmeden önce ona uygulanır (mutex_ altında).
+    struct IndexLogOp {
+        hnswlib::labeltype label;
+        std::vector<float> embedding; // Boşsa silme
+    };
+    TaskHandle compaction_task_; // Ortak zamanlayıcıda; beklenirken henüz başlamadıysa bekleyen yürütür
+    std::atomic<bool> compaction_running_{false};
+    std::atomic<bool> compaction_cancel_{false};
+    bool compaction_log_active_ = false;
+    std::vector<IndexLogOp> compaction_log_;
+    size_t compactions_done_ = 0;
     std::vector<std::string> get_all_ids_internal(MDB_txn* txn) const; // Yeni internal metot
 
     void close_internal(); // Mutex kilidi olmadan kapatma mantığını yönetir
+    // Vektörü ve HNSW eşlemelerini verilen yazma transaction'ında siler (mutex_ çağıran tarafından tutulur).
+    // Vektör yoksa MDB_NOTFOUND döner.
+    // drop_attributes=false iken nitelik kaydı korunur (karantina: geri alınınca nitelikler de geri gelir).
+    int delete_vector_in_txn(MDB_txn* txn, const std::string& id, bool drop_attributes = true);
+    // Commit sonrası: ID'nin HNSW etiketini silindi işaretler ve bellekteki haritalardan çıkarır.
+    void forget_hnsw_entry(const std::string& id);
+    void log_index_op(hnswlib::labeltype label, std::vector<float> embedding);
+    void update_index_metrics();                   // mutex_ çağıran tarafından tutulur
+    void update_index_metrics_and_maybe_compact(); // mutex_ çağıran tarafından tutulur
+    bool start_compaction_locked();                // mutex_ çağıran tarafından tutulur
+    void run_compaction(std::vector<std::pair<hnswlib::labeltype, std::string>> live, size_t capacity,
+                        const CancellationToken& token);
+    void stop_compaction();                        // mutex_ tutulmadan çağrılmalı
+    // Yazma transaction'ının HNSW'ye ve bellekteki haritalara yansıyacak değişiklikleri. Bunlar yalnızca commit
+    // başarılı olunca uygulanır: geri alınan ya da MDB_MAP_FULL sonrası baştan denenen transaction indekste yuva veya
+    // etiket harcamaz, yeniden deneme aynı etiketleri ayırır.
+    struct PendingIndexUpdate {
+        hnswlib::labeltype label;
+        std::string id;
+        std::vector<float> embedding; // Boşsa ID'nin etiketi zaten var; yalnızca nitelik sütunu güncellenir
+        VectorAttributes attributes;
+    };
+    struct PendingIndexUpdates {
+        std::vector<PendingIndexUpdate> updates;
+        std::map<std::string, hnswlib::labeltype> new_labels; // Bu transaction'da etiket ayrılan ID'ler
+    };
+    // Vektörü verilen yazma transaction'ına ekler (mutex_ çağıran tarafından tutulur). İndeks değişiklikleri
+    // pending'e yazılır; başarısızlıkta transaction'ı çağıran geri alır ve pending'i atar.
+    bool store_vector_in_txn(MDB_txn* txn, const CryptofigVector& cv, PendingIndexUpdates& pending,
+                             const VectorAttributes* attributes = nullptr);
+    bool store_vector_impl(const CryptofigVector& cv, const VectorAttributes* attributes);
+    // Açılışta nitelik sütunlarını LMDB'den doldurur; nitelik kaydı olmayan eski vektörler için kayıt oluşturur.
+    bool load_attribute_columns();
+    // Commit sonrası: bekleyen eklemeleri HNSW'ye ve haritalara, nitelikleri sütunlara uygular (mutex_ tutulur).
+    void apply_pending_index_updates(PendingIndexUpdates& pending);
+
+    // Yazma yolları LMDB'ye bu sarmalayıcılarla erişir; MDB_MAP_FULL sonucu map_full_hit_'e işlenir.
+    int begin_write_txn(MDB_txn** txn); // Başka süreç haritayı büyüttüyse (MDB_MAP_RESIZED) yeni boyutu benimser
+    int txn_put(MDB_txn* txn, MDB_dbi dbi, MDB_val* key, MDB_val* data, unsigned int flags);
+    int txn_del(MDB_txn* txn, MDB_dbi dbi, MDB_val* key, MDB_val* data);
+    int txn_commit(MDB_txn* txn);
+    // attempt'i çalıştırır; MDB_MAP_FULL nedeniyle başarısız olursa haritayı büyütüp baştan dener (mutex_ tutulur).
+    bool with_map_growth(const char* op, const std::function<bool()>& attempt);
+    bool grow_map_locked(const char* op); // mutex_ çağıran tarafından tutulur
+    void update_map_metrics();            // mutex_ çağıran tarafından tutulur
    
     // Kopyalama ve atamayı engelle
     SwarmVectorDB(const SwarmVectorDB&) = delete;
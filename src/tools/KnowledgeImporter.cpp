@@ -80,6 +80,10 @@ public:
     // Veritabanındaki tüm ID'leri ve boyutları listeler
     bool list_data(); 
 
+    // İkili snapshot ile yedekleme / geri yükleme
+    bool export_snapshot(const std::string& snapshot_path);
+    bool restore_snapshot(const std::string& snapshot_path);
+
     // Veritabanında semantik arama yapar
     bool perform_semantic_search(const std::string& query, int top_k); // CLI için string sorguyu korur
 
@@ -107,58 +111,44 @@ KnowledgeImporter::~KnowledgeImporter() {
 bool KnowledgeImporter::import_data() {
     LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Veri içe aktarma başlatılıyor...");
 
-    // KnowledgeBase::import_from_json metodu artık SwarmVectorDB'yi kendi içinde açıp kapatıyor.
-    // Bu sayede KnowledgeImporter daha temiz bir arayüze sahip olur.
-    // m_knowledge_base.import_from_json çağrısı yapılmalı
-
-    m_knowledge_base.import_from_json(json_path_); // Yeni import metodu çağrıldı
-
+    // Dosya SAX ile akış halinde okunur; kapsüller paralel hattan geçip gruplar halinde LMDB'ye yazılır.
+    // Tüm dosya belleğe yüklenmediği için büyük bilgi tabanları da sınırlı bellekle içe aktarılır.
     std::ifstream ifs(json_path_);
-    if (!ifs.is_open()) { // No change needed
+    if (!ifs.is_open()) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter: knowledge.json dosyası açılamadı: " << json_path_);
-        // import_from_json zaten kapatıyor, burada tekrar kapatmaya gerek yok.
         return false;
     }
 
-    nlohmann::json j;
-    try {
-        ifs >> j;
-        LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: JSON dosyası başarıyla okundu ve ayrıştırıldı.");
-    } catch (const nlohmann::json::parse_error& e) {
-        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter: JSON ayrıştırma hatası: " << e.what() << " - " << json_path_);
-        // import_from_json zaten kapatıyor, burada tekrar kapatmaya gerek yok.
+    const auto start = std::chrono::steady_clock::now();
+    const CerebrumLux::CapsuleImportStats stats = m_knowledge_base.import_json_stream(ifs);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!stats.ok) {
+        LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter: JSON ayrıştırma hatası: " << stats.error << " - " << json_path_
+                       << " (hataya kadar " << stats.stored << " kapsül içe aktarıldı)");
         return false;
     }
-    ifs.close();
-
-    if (!j.contains("active_capsules") || !j["active_capsules"].is_array()) {
+    if (!stats.found_capsules) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter: JSON dosyasında 'active_capsules' dizisi bulunamadı veya geçersiz.");
-        // import_from_json zaten kapatıyor, burada tekrar kapatmaya gerek yok.
         return false;
     }
 
-    int imported_count = 0;
-    for (const auto& json_capsule : j["active_capsules"]) {
-        try {
-            CerebrumLux::Capsule capsule;
-            capsule.id = json_capsule.value("id", "");
-            capsule.topic = json_capsule.value("topic", "");
-            capsule.source = json_capsule.value("source", "");
-            capsule.content = json_capsule.value("content", "");
-            capsule.cryptofig_blob_base64 = json_capsule.value("cryptofig_blob_base64", "");
-
-            m_knowledge_base.add_capsule(capsule); 
-            imported_count++;
-        } catch (const std::exception& e) {
-            LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter: Kapsül işleme hatası (ID: " << json_capsule.value("id", "UNKNOWN") << "): " << e.what());
-        }
-        LOG_DEFAULT(LogLevel::TRACE, "KnowledgeImporter: Bir kapsül işlendi.");
-    }
-
-    LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Veri içe aktarma tamamlandı. Toplam içe aktarılan vektör: " << imported_count);
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Veri içe aktarma tamamlandı. Toplam içe aktarılan vektör: " << stats.stored
+                << ", atlanan: " << stats.skipped << ", süre: " << seconds << " sn.");
     return true;
 }
 
+bool KnowledgeImporter::export_snapshot(const std::string& snapshot_path) {
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Snapshot alınıyor: " << snapshot_path);
+    return m_knowledge_base.export_snapshot(snapshot_path);
+}
+
+bool KnowledgeImporter::restore_snapshot(const std::string& snapshot_path) {
+    LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Snapshot geri yükleniyor: " << snapshot_path);
+    const CerebrumLux::CapsuleImportStats stats = m_knowledge_base.import_snapshot(snapshot_path);
+    return stats.ok;
+}
+
 bool KnowledgeImporter::list_data() {
     LOG_DEFAULT(LogLevel::INFO, "KnowledgeImporter: Veritabanı içeriği listeleniyor. DB Yolu: " << db_path_);
 
@@ -170,9 +160,11 @@ bool KnowledgeImporter::list_data() {
 
     MDB_txn* txn;
     int rc; // rc bildirimi eklendi
+    auto gate = m_knowledge_base.get_swarm_db().read_gate(); // Transaction boyunca LMDB haritası büyütülmesin
     rc = mdb_txn_begin(m_knowledge_base.get_swarm_db().get_env(), nullptr, MDB_RDONLY, &txn); 
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter::list_data(): mdb_txn_begin başarısız: " << mdb_strerror(rc));
+        gate.unlock();
         m_knowledge_base.get_swarm_db().close(); 
         return false;
     }
@@ -182,6 +174,7 @@ bool KnowledgeImporter::list_data() {
     if (rc != MDB_SUCCESS) {
         LOG_ERROR_CERR(LogLevel::ERR_CRITICAL, "KnowledgeImporter::list_data(): mdb_cursor_open başarısız: " << mdb_strerror(rc));
         mdb_txn_abort(txn);
+        gate.unlock();
         m_knowledge_base.get_swarm_db().close(); 
         return false;
     }
@@ -196,6 +189,7 @@ bool KnowledgeImporter::list_data() {
 
     mdb_cursor_close(cursor);
     mdb_txn_abort(txn);
+    gate.unlock();
     m_knowledge_base.get_swarm_db().close(); 
 
     if (rc != MDB_NOTFOUND) {
@@ -312,6 +306,8 @@ int main(int argc, char* argv[]) {
         std::cerr << "Kullanım 1 (Import): " << argv[0] << " <db_path> <json_path>" << std::endl;
         std::cerr << "Kullanım 2 (List):   " << argv[0] << " <db_path> -list" << std::endl;
         std::cerr << "Kullanım 3 (Search): " << argv[0] << " <db_path> -search <sorgu>" << std::endl;
+        std::cerr << "Kullanım 4 (Yedek):  " << argv[0] << " <db_path> -snapshot <dosya>" << std::endl;
+        std::cerr << "Kullanım 5 (Geri):   " << argv[0] << " <db_path> -restore <dosya>" << std::endl;
         return 1;
     }
 
@@ -339,7 +335,18 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-    // Durum 3: İçe aktarma komutu
+    // Durum 3: Snapshot alma / geri yükleme
+    } else if (argc == 4 && (std::string(argv[2]) == "-snapshot" || std::string(argv[2]) == "-restore")) {
+        const bool restore = std::string(argv[2]) == "-restore";
+        std::string snapshot_path = argv[3];
+        LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "Mod: " << (restore ? "Snapshot Geri Yükleme" : "Snapshot Alma") << ". DB Yolu: " << db_path << ", Dosya: " << snapshot_path);
+        CerebrumLux::Tools::KnowledgeImporter importer(db_path, "");
+        if (!(restore ? importer.restore_snapshot(snapshot_path) : importer.export_snapshot(snapshot_path))) {
+            LOG_DEFAULT(CerebrumLux::LogLevel::ERR_CRITICAL, "Snapshot işlemi başarısız oldu.");
+            return 1;
+        }
+
+    // Durum 4: İçe aktarma komutu
     } else if (argc == 3) {
         std::string json_path = argv[2];
         LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "Mod: JSON İçe Aktarma. DB Yolu: " << db_path << ", JSON Yolu: " << json_path);
@@ -356,6 +363,8 @@ int main(int argc, char* argv[]) {
         std::cerr << "Kullanım 1 (Import): " << argv[0] << " <db_path> <json_path>" << std::endl;
         std::cerr << "Kullanım 2 (List):   " << argv[0] << " <db_path> -list" << std::endl;
         std::cerr << "Kullanım 3 (Search): " << argv[0] << " <db_path> -search <sorgu>" << std::endl;
+        std::cerr << "Kullanım 4 (Yedek):  " << argv[0] << " <db_path> -snapshot <dosya>" << std::endl;
+        std::cerr << "Kullanım 5 (Geri):   " << argv[0] << " <db_path> -restore <dosya>" << std::endl;
         return 1;
     }
 
@@ -0,0 +1,165 @@
+// Headless sinyal hattı yük sürücüsü.
+//
+// SequenceManager -> CryptofigProcessor -> IntentAnalyzer zincirini Qt zamanlayıcıları olmadan,
+// kaydedilmiş veya sentetik sinyal akışlarıyla besler ve uçtan uca sinyal->niyet gecikme
+// yüzdeliklerini ve sürdürülebilir sinyal/sn değerini raporlar.
+//
+// Kullanım:
+//   signal_pipeline_bench --record <dosya> [--count N] [--rate HZ]
+//   signal_pipeline_bench --replay <dosya> [--speed X|max] [--sequence-interval-us US]
+//   signal_pipeline_bench --synthetic N [--rate HZ] [--speed X|max] [--sequence-interval-us US]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../core/logger.h"
+#include "../core/enums.h"
+#include "../core/utils.h"
+#include "../sensors/atomic_signal.h"
+#include "../sensors/simulated_processor.h"
+#include "../sensors/signal_log.h"
+#include "../data_models/sequence_manager.h"
+#include "../brain/autoencoder.h"
+#include "../brain/cryptofig_processor.h"
+#include "../brain/intent_analyzer.h"
+#include "../communication/fasttext_wrapper.h"
+
+namespace {
+
+struct BenchOptions {
+    std::string record_path;
+    std::string replay_path;
+    std::size_t count = 10000;
+    double rate_hz = 1000.0;
+    double speed = 0.0; // 0 = maksimum hız
+    long long sequence_interval_us = -1; // -1 = SequenceManager varsayılanı
+};
+
+void print_usage() {
+    std::cout << "Kullanim:\n"
+              << "  signal_pipeline_bench --record <dosya> [--count N] [--rate HZ]\n"
+              << "  signal_pipeline_bench --replay <dosya> [--speed X|max] [--sequence-interval-us US]\n"
+              << "  signal_pipeline_bench --synthetic N [--rate HZ] [--speed X|max] [--sequence-interval-us US]\n";
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next = [&](std::string& out) {
+            if (i + 1 >= argc) return false;
+            out = argv[++i];
+            return true;
+        };
+        std::string value;
+        if (arg == "--record" && next(value)) opts.record_path = value;
+        else if (arg == "--replay" && next(value)) opts.replay_path = value;
+        else if ((arg == "--count" || arg == "--synthetic") && next(value)) opts.count = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--rate" && next(value)) opts.rate_hz = std::atof(value.c_str());
+        else if (arg == "--speed" && next(value)) opts.speed = (value == "max") ? 0.0 : std::atof(value.c_str());
+        else if (arg == "--sequence-interval-us" && next(value)) opts.sequence_interval_us = std::atoll(value.c_str());
+        else return false;
+    }
+    return opts.rate_hz > 0.0;
+}
+
+// Simülatörden sentetik bir akış üretip ikili kayda yazar. Zaman damgaları rate_hz'e göre sabit aralıklıdır.
+bool write_synthetic_log(const std::string& path, std::size_t count, double rate_hz) {
+    CerebrumLux::SimulatedAtomicSignalProcessor simulator;
+    CerebrumLux::SignalLogWriter writer;
+    if (!writer.open(path)) return false;
+
+    const long long start_us = CerebrumLux::get_current_timestamp_us();
+    const double interval_us = 1e6 / rate_hz;
+    for (std::size_t i = 0; i < count; ++i) {
+        CerebrumLux::AtomicSignal signal = simulator.capture_next_signal();
+        signal.timestamp_us = start_us + static_cast<long long>(i * interval_us);
+        if (!writer.write(signal)) return false;
+    }
+    writer.close();
+    std::cout << "Kaydedildi: " << writer.signals_written() << " sinyal, " << writer.bytes_written() << " bayt ("
+              << static_cast<double>(writer.bytes_written()) / std::max<std::uint64_t>(1, writer.signals_written()) << " bayt/sinyal) -> " << path << "\n";
+    return true;
+}
+
+double percentile_us(const std::vector<long long>& sorted_ns, double p) {
+    if (sorted_ns.empty()) return 0.0;
+    const std::size_t index = std::min(sorted_ns.size() - 1, static_cast<std::size_t>(p * (sorted_ns.size() - 1) + 0.5));
+    return static_cast<double>(sorted_ns[index]) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_options(argc, argv, opts)) {
+        print_usage();
+        return 1;
+    }
+
+    // Hat içi DEBUG logları ölçümü domine etmesin diye yalnızca uyarılar loglanır.
+    CerebrumLux::Logger::getInstance().init(CerebrumLux::LogLevel::WARNING, "signal_pipeline_bench_log.txt", "SIGNAL_BENCH");
+
+    if (!opts.record_path.empty()) {
+        const bool ok = write_synthetic_log(opts.record_path, opts.count, opts.rate_hz);
+        CerebrumLux::Logger::getInstance().shutdown();
+        return ok ? 0 : 1;
+    }
+
+    std::string replay_path = opts.replay_path;
+    if (replay_path.empty()) {
+        replay_path = "signal_pipeline_bench_synthetic.bin";
+        if (!write_synthetic_log(replay_path, opts.count, opts.rate_hz)) return 1;
+    }
+
+    CerebrumLux::FastTextWrapper fasttext_model("dummy.bin");
+    CerebrumLux::IntentAnalyzer analyzer(fasttext_model);
+    CerebrumLux::CryptofigAutoencoder autoencoder;
+    CerebrumLux::CryptofigProcessor cryptofig_processor(analyzer, autoencoder);
+    CerebrumLux::SequenceManager sequence_manager;
+    if (opts.sequence_interval_us >= 0) sequence_manager.set_sequence_update_interval_us(opts.sequence_interval_us);
+
+    std::vector<long long> latencies_ns;
+    latencies_ns.reserve(opts.count);
+    std::map<CerebrumLux::UserIntent, std::size_t> intent_counts;
+
+    CerebrumLux::SignalReplayer replayer(opts.speed, true);
+    const CerebrumLux::SignalReplayer::Stats stats = replayer.replay(replay_path, [&](CerebrumLux::AtomicSignal& signal) {
+        const auto t0 = std::chrono::steady_clock::now();
+        sequence_manager.add_signal(signal, cryptofig_processor);
+        const CerebrumLux::UserIntent intent = analyzer.analyze_intent(sequence_manager.get_current_sequence_ref());
+        const auto t1 = std::chrono::steady_clock::now();
+
+        latencies_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        ++intent_counts[intent];
+        return true;
+    });
+
+    if (stats.signal_count == 0) {
+        std::cerr << "Oynatilacak sinyal bulunamadi: " << replay_path << "\n";
+        CerebrumLux::Logger::getInstance().shutdown();
+        return 1;
+    }
+
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    const double throughput = stats.wall_seconds > 0.0 ? static_cast<double>(stats.signal_count) / stats.wall_seconds : 0.0;
+
+    std::printf("Sinyal sayisi        : %llu\n", static_cast<unsigned long long>(stats.signal_count));
+    std::printf("Oynatma hizi         : %s\n", opts.speed > 0.0 ? (std::to_string(opts.speed) + "x").c_str() : "max");
+    std::printf("Gercek sure          : %.3f sn (kayit: %.3f sn)\n", stats.wall_seconds, stats.recorded_seconds);
+    std::printf("Surdurulen hiz       : %.1f sinyal/sn\n", throughput);
+    std::printf("Sinyal->niyet gecikme: p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+                percentile_us(latencies_ns, 0.50), percentile_us(latencies_ns, 0.90), percentile_us(latencies_ns, 0.99),
+                percentile_us(latencies_ns, 0.999), static_cast<double>(latencies_ns.back()) / 1000.0);
+    for (const auto& entry : intent_counts) {
+        std::printf("  %-20s: %zu\n", CerebrumLux::to_string(entry.first).c_str(), entry.second);
+    }
+
+    CerebrumLux::Logger::getInstance().shutdown();
+    return 0;
+}
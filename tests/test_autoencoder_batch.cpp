@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/brain/autoencoder.h"
+
+// Eigen ile toplu (batched) ileri/geri geçiş, eski skaler örnek başına kuralla aynı sonucu vermeli: encode_batch /
+// decode_batch satırları encode / decode ile, train_batch ise skaler referansla (aynı kayıp, aynı ağırlık değişimi)
+// tolerans içinde örtüşmeli. Referans, Eigen'e geçmeden önceki adjust_weights_on_error döngülerinin mini-batch
+// ortalamalı karşılığıdır; tek satırlık dilimde birebir eski kuraldır.
+
+namespace {
+
+using CerebrumLux::CryptofigAutoencoder;
+
+constexpr int kIn = CryptofigAutoencoder::INPUT_DIM;
+constexpr int kLatent = CryptofigAutoencoder::LATENT_DIM;
+
+// save_weights / load_weights dosya biçimindeki ağırlıklar (encoder_weights[i * LATENT + j], decoder_weights[i * INPUT + j]).
+struct Weights {
+    std::vector<float> enc_w, enc_b, dec_w, dec_b;
+};
+
+class TempWeightsFile {
+public:
+    TempWeightsFile() {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = (std::filesystem::temp_directory_path() / ("cerebrumlux_ae_" + std::to_string(stamp) + ".bin")).string();
+    }
+    ~TempWeightsFile() {
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+    const std::string& str() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+bool read_block(FILE* fp, std::vector<float>& out) {
+    std::size_t size = 0;
+    if (std::fread(&size, sizeof(size), 1, fp) != 1) return false;
+    out.resize(size);
+    return std::fread(out.data(), sizeof(float), size, fp) == size;
+}
+
+void write_block(FILE* fp, const std::vector<float>& values) {
+    const std::size_t size = values.size();
+    std::fwrite(&size, sizeof(size), 1, fp);
+    std::fwrite(values.data(), sizeof(float), size, fp);
+}
+
+Weights weights_of(const CryptofigAutoencoder& ae) {
+    TempWeightsFile file;
+    ae.save_weights(file.str());
+    Weights w;
+    FILE* fp = std::fopen(file.str().c_str(), "rb");
+    EXPECT_NE(fp, nullptr);
+    if (!fp) return w;
+    int dims[2] = {};
+    EXPECT_EQ(std::fread(dims, sizeof(int), 2, fp), 2u);
+    EXPECT_TRUE(read_block(fp, w.enc_w) && read_block(fp, w.enc_b) && read_block(fp, w.dec_w) && read_block(fp, w.dec_b));
+    std::fclose(fp);
+    return w;
+}
+
+void set_weights(CryptofigAutoencoder& ae, const Weights& w) {
+    TempWeightsFile file;
+    FILE* fp = std::fopen(file.str().c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    const int dims[2] = {kIn, kLatent};
+    std::fwrite(dims, sizeof(int), 2, fp);
+    write_block(fp, w.enc_w);
+    write_block(fp, w.enc_b);
+    write_block(fp, w.dec_w);
+    write_block(fp, w.dec_b);
+    std::fclose(fp);
+    ae.load_weights(file.str());
+}
+
+float sigmoid(double x) { return static_cast<float>(1.0 / (1.0 + std::exp(-x))); }
+float clamp_unit(double x) { return static_cast<float>(std::min(1.0, std::max(-1.0, x))); }
+
+std::vector<float> ref_encode(const Weights& w, const std::vector<float>& x) {
+    std::vector<float> latent(kLatent);
+    for (int j = 0; j < kLatent; ++j) {
+        double sum = w.enc_b[j];
+        for (int i = 0; i < kIn; ++i) sum += x[i] * w.enc_w[i * kLatent + j];
+        latent[j] = sigmoid(sum);
+    }
+    return latent;
+}
+
+std::vector<float> ref_decode(const Weights& w, const std::vector<float>& latent) {
+    std::vector<float> out(kIn);
+    for (int j = 0; j < kIn; ++j) {
+        double sum = w.dec_b[j];
+        for (int i = 0; i < kLatent; ++i) sum += latent[i] * w.dec_w[i * kIn + j];
+        out[j] = sigmoid(sum);
+    }
+    return out;
+}
+
+// Skaler referans mini-batch adımı: örnek başına eski kuralın düzeltmeleri (eşik, lr * RMSE ağırlığı) dilim üzerinden
+// ortalanır; gizil hata sinyali güncellenmiş decoder ağırlıklarıyla hesaplanır. RMSE toplamını döndürür.
+double ref_minibatch(Weights& w, const std::vector<std::vector<float>>& batch, float lr) {
+    const std::size_t rows = batch.size();
+    std::vector<std::vector<float>> latents(rows), errors(rows);
+    std::vector<double> scale(rows, 0.0);
+    double error_sum = 0.0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        latents[r] = ref_encode(w, batch[r]);
+        const std::vector<float> reconstructed = ref_decode(w, latents[r]);
+        errors[r].resize(kIn);
+        double sq = 0.0;
+        for (int j = 0; j < kIn; ++j) {
+            errors[r][j] = batch[r][j] - reconstructed[j];
+            sq += static_cast<double>(errors[r][j]) * errors[r][j];
+        }
+        const double rmse = std::sqrt(sq / kIn);
+        error_sum += rmse;
+        if (rmse > 0.1) scale[r] = lr * rmse;
+    }
+    if (*std::max_element(scale.begin(), scale.end()) <= 0.0) return error_sum;
+
+    for (int j = 0; j < kIn; ++j) {
+        double db = 0.0;
+        for (std::size_t r = 0; r < rows; ++r) db += scale[r] * errors[r][j];
+        w.dec_b[j] = clamp_unit(w.dec_b[j] + db / rows);
+        for (int i = 0; i < kLatent; ++i) {
+            double dw = 0.0;
+            for (std::size_t r = 0; r < rows; ++r) dw += scale[r] * errors[r][j] * latents[r][i];
+            w.dec_w[i * kIn + j] = clamp_unit(w.dec_w[i * kIn + j] + dw / rows);
+        }
+    }
+    std::vector<std::vector<double>> signal(rows, std::vector<double>(kLatent, 0.0));
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (int j = 0; j < kLatent; ++j) {
+            for (int k = 0; k < kIn; ++k) signal[r][j] += scale[r] * errors[r][k] * w.dec_w[j * kIn + k];
+        }
+    }
+    for (int j = 0; j < kLatent; ++j) {
+        double db = 0.0;
+        for (std::size_t r = 0; r < rows; ++r) db += signal[r][j];
+        w.enc_b[j] = clamp_unit(w.enc_b[j] + db / rows);
+        for (int i = 0; i < kIn; ++i) {
+            double dw = 0.0;
+            for (std::size_t r = 0; r < rows; ++r) dw += signal[r][j] * batch[r][i];
+            w.enc_w[i * kLatent + j] = clamp_unit(w.enc_w[i * kLatent + j] + dw / rows);
+        }
+    }
+    return error_sum;
+}
+
+double ref_train(Weights& w, const std::vector<std::vector<float>>& samples, float lr, std::size_t batch_size) {
+    double error_sum = 0.0;
+    for (std::size_t start = 0; start < samples.size(); start += batch_size) {
+        const std::size_t end = std::min(samples.size(), start + batch_size);
+        error_sum += ref_minibatch(w, {samples.begin() + start, samples.begin() + end}, lr);
+    }
+    return error_sum / samples.size();
+}
+
+std::vector<std::vector<float>> make_samples(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<std::vector<float>> samples(count, std::vector<float>(kIn));
+    for (auto& sample : samples) {
+        for (float& v : sample) v = dist(rng);
+    }
+    return samples;
+}
+
+CryptofigAutoencoder::SampleMatrix to_matrix(const std::vector<std::vector<float>>& samples) {
+    CryptofigAutoencoder::SampleMatrix m(static_cast<Eigen::Index>(samples.size()), kIn);
+    for (std::size_t r = 0; r < samples.size(); ++r) {
+        for (int c = 0; c < kIn; ++c) m(static_cast<Eigen::Index>(r), c) = samples[r][c];
+    }
+    return m;
+}
+
+// Ağırlık değişimleri (gradyan * lr) referansla tolerans içinde aynı olmalı; değişimin kendisi de sıfır olmamalı.
+void expect_same_update(const Weights& before, const Weights& expected, const Weights& actual) {
+    auto compare = [](const char* name, const std::vector<float>& b, const std::vector<float>& e, const std::vector<float>& a) {
+        ASSERT_EQ(e.size(), a.size()) << name;
+        double moved = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            EXPECT_NEAR(a[i] - b[i], e[i] - b[i], 1e-5) << name << "[" << i << "]";
+            moved += std::abs(e[i] - b[i]);
+        }
+        EXPECT_GT(moved, 0.0) << name << " hiç güncellenmedi";
+    };
+    compare("encoder_weights", before.enc_w, expected.enc_w, actual.enc_w);
+    compare("encoder_bias", before.enc_b, expected.enc_b, actual.enc_b);
+    compare("decoder_weights", before.dec_w, expected.dec_w, actual.dec_w);
+    compare("decoder_bias", before.dec_b, expected.dec_b, actual.dec_b);
+}
+
+} // namespace
+
+TEST(AutoencoderBatch, EncodeDecodeBatchMatchesPerSample) {
+    CryptofigAutoencoder ae;
+    const Weights w = weights_of(ae);
+    const auto samples = make_samples(17, 1);
+
+    CryptofigAutoencoder::LatentMatrix latent;
+    CryptofigAutoencoder::SampleMatrix reconstructed;
+    ae.encode_batch(to_matrix(samples), latent);
+    ae.decode_batch(latent, reconstructed);
+    ASSERT_EQ(latent.rows(), 17);
+    ASSERT_EQ(reconstructed.rows(), 17);
+
+    for (std::size_t r = 0; r < samples.size(); ++r) {
+        const auto row = static_cast<Eigen::Index>(r);
+        const std::vector<float> single_latent = ae.encode(samples[r]);
+        const std::vector<float> single_out = ae.decode(single_latent);
+        const std::vector<float> expected_latent = ref_encode(w, samples[r]);
+        const std::vector<float> expected_out = ref_decode(w, expected_latent);
+        for (int j = 0; j < kLatent; ++j) {
+            EXPECT_NEAR(latent(row, j), single_latent[j], 1e-5f);
+            EXPECT_NEAR(single_latent[j], expected_latent[j], 1e-5f);
+        }
+        for (int j = 0; j < kIn; ++j) {
+            EXPECT_NEAR(reconstructed(row, j), single_out[j], 1e-5f);
+            EXPECT_NEAR(single_out[j], expected_out[j], 1e-5f);
+        }
+    }
+}
+
+TEST(AutoencoderBatch, PerSampleUpdateMatchesScalarRule) {
+    CryptofigAutoencoder per_sample;
+    const Weights initial = weights_of(per_sample);
+    CryptofigAutoencoder batched;
+    set_weights(batched, initial);
+    const auto samples = make_samples(12, 2);
+    const float lr = 0.05f;
+
+    Weights expected = initial;
+    const double expected_loss = ref_train(expected, samples, lr, 1);
+
+    for (const auto& sample : samples) per_sample.adjust_weights_on_error(sample, lr);
+    const float loss = batched.train_batch(to_matrix(samples), lr, 1);
+
+    EXPECT_NEAR(loss, expected_loss, 1e-5);
+    expect_same_update(initial, expected, weights_of(per_sample));
+    expect_same_update(initial, expected, weights_of(batched));
+}
+
+TEST(AutoencoderBatch, MiniBatchMatchesAveragedScalarGradients) {
+    CryptofigAutoencoder ae;
+    const Weights initial = weights_of(ae);
+    const auto samples = make_samples(21, 3); // Son dilim eksik (21 = 8 + 8 + 5)
+    const float lr = 0.05f;
+
+    Weights expected = initial;
+    const double expected_loss = ref_train(expected, samples, lr, 8);
+    const float loss = ae.train_batch(to_matrix(samples), lr, 8);
+
+    EXPECT_NEAR(loss, expected_loss, 1e-5);
+    expect_same_update(initial, expected, weights_of(ae));
+
+    // İkinci tur aynı ön-ayrılmış tamponları yeniden kullanır ve referansla örtüşmeye devam eder.
+    const Weights second_start = weights_of(ae);
+    const double second_expected_loss = ref_train(expected, samples, lr, 8);
+    EXPECT_NEAR(ae.train_batch(to_matrix(samples), lr, 8), second_expected_loss, 1e-5);
+    expect_same_update(second_start, expected, weights_of(ae));
+}
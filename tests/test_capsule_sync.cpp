@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include "../src/learning/KnowledgeBase.h"
+#include "../src/learning/CapsuleSync.h"
+#include "../src/brain/autoencoder.h" // CryptofigAutoencoder::INPUT_DIM için
+
+// İki süreç içi KnowledgeBase örneğinin LoopbackSyncTransport üzerinden Merkle aralığı senkronizasyonu.
+
+namespace {
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_sync_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+CerebrumLux::Capsule make_capsule(const std::string& id, const std::string& content) {
+    CerebrumLux::Capsule capsule;
+    capsule.id = id;
+    capsule.topic = "SyncTest";
+    capsule.content = content;
+    capsule.confidence = 1.0f;
+    capsule.embedding.assign(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.0f);
+    capsule.embedding[std::hash<std::string>{}(id) % capsule.embedding.size()] = 1.0f;
+    return capsule;
+}
+
+bool same_capsules(const CerebrumLux::KnowledgeBase& a, const CerebrumLux::KnowledgeBase& b) {
+    return a.capsule_tree().root() == b.capsule_tree().root() && a.capsule_tree().size() == b.capsule_tree().size();
+}
+
+} // namespace
+
+TEST(CapsuleSync, OverlappingKnowledgeBasesConverge) {
+    TempDbDir dir_a("a"), dir_b("b");
+    CerebrumLux::KnowledgeBase kb_a(dir_a.str());
+    CerebrumLux::KnowledgeBase kb_b(dir_b.str());
+
+    for (int i = 0; i < 120; ++i) kb_a.add_capsule(make_capsule("cap_" + std::to_string(i), "icerik " + std::to_string(i)));
+    for (int i = 80; i < 200; ++i) kb_b.add_capsule(make_capsule("cap_" + std::to_string(i), "icerik " + std::to_string(i)));
+    kb_b.add_capsule(make_capsule("cap_90", "farkli icerik")); // Çakışan sürüm
+
+    CerebrumLux::CapsuleSyncPeer peer_a(kb_a), peer_b(kb_b);
+    CerebrumLux::LoopbackSyncTransport transport(peer_a, peer_b);
+    ASSERT_TRUE(transport.run());
+
+    EXPECT_TRUE(same_capsules(kb_a, kb_b));
+    EXPECT_EQ(kb_a.capsule_tree().size(), 200u);
+    // Yalnızca eksik kapsüller (80 + 80) ve çakışan tek kapsül taşınır.
+    EXPECT_EQ(peer_a.stats().capsules_sent + peer_b.stats().capsules_sent, 161u);
+    ASSERT_TRUE(kb_a.find_capsule_by_id("cap_150").has_value());
+    EXPECT_EQ(kb_a.find_capsule_by_id("cap_150")->content, "icerik 150");
+}
+
+TEST(CapsuleSync, InSyncPeersExchangeOnlyRootHash) {
+    TempDbDir dir_a("a"), dir_b("b");
+    CerebrumLux::KnowledgeBase kb_a(dir_a.str());
+    CerebrumLux::KnowledgeBase kb_b(dir_b.str());
+    for (int i = 0; i < 50; ++i) {
+        kb_a.add_capsule(make_capsule("cap_" + std::to_string(i), "ayni"));
+        kb_b.add_capsule(make_capsule("cap_" + std::to_string(i), "ayni"));
+    }
+
+    CerebrumLux::CapsuleSyncPeer peer_a(kb_a), peer_b(kb_b);
+    CerebrumLux::LoopbackSyncTransport transport(peer_a, peer_b);
+    ASSERT_TRUE(transport.run());
+
+    EXPECT_EQ(peer_a.stats().messages_sent, 1u);
+    EXPECT_EQ(peer_b.stats().messages_sent, 0u);
+    EXPECT_EQ(peer_a.stats().capsules_sent + peer_b.stats().capsules_sent, 0u);
+}
+
+TEST(CapsuleSync, IncrementalChangesTransferOnlyDelta) {
+    TempDbDir dir_a("a"), dir_b("b");
+    CerebrumLux::KnowledgeBase kb_a(dir_a.str());
+    CerebrumLux::KnowledgeBase kb_b(dir_b.str());
+    for (int i = 0; i < 300; ++i) kb_a.add_capsule(make_capsule("cap_" + std::to_string(i), "v1"));
+
+    CerebrumLux::CapsuleSyncPeer peer_a(kb_a), peer_b(kb_b);
+    CerebrumLux::LoopbackSyncTransport initial(peer_a, peer_b);
+    ASSERT_TRUE(initial.run());
+    ASSERT_TRUE(same_capsules(kb_a, kb_b));
+
+    kb_a.add_capsule(make_capsule("cap_new_a", "v1"));
+    kb_b.add_capsule(make_capsule("cap_new_b", "v1"));
+    kb_b.add_capsule(make_capsule("cap_7", "v2"));
+
+    CerebrumLux::CapsuleSyncPeer delta_a(kb_a), delta_b(kb_b);
+    CerebrumLux::LoopbackSyncTransport delta(delta_a, delta_b);
+    ASSERT_TRUE(delta.run());
+
+    EXPECT_TRUE(same_capsules(kb_a, kb_b));
+    EXPECT_EQ(delta_a.stats().capsules_sent + delta_b.stats().capsules_sent, 3u);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../src/learning/CapsuleTextIndex.h"
+#include "../src/communication/context_packer.h"
+
+// Hibrit aramanın anahtar kelime tarafı (CapsuleTextIndex: bölme, Türkçe küçük harf, BM25 sıralaması) ve
+// sonuçların token bütçesine paketlenmesi (ContextPacker: bütçe, tekrar eleme, en iyi cümle penceresi).
+
+using CerebrumLux::Capsule;
+using CerebrumLux::CapsuleTextIndex;
+using CerebrumLux::ContextPacker;
+using CerebrumLux::ContextPackerOptions;
+using CerebrumLux::PackedContext;
+
+namespace {
+
+std::vector<std::string> hit_ids(const std::vector<CapsuleTextIndex::Hit>& hits) {
+    std::vector<std::string> ids;
+    for (const auto& hit : hits) ids.push_back(hit.id);
+    return ids;
+}
+
+// Kelime sayan sayaç: pencere sınırları tahmin formülünden bağımsız, elle hesaplanabilir olsun.
+std::size_t count_words(const std::string& text) {
+    std::size_t words = 0;
+    bool in_word = false;
+    for (char c : text) {
+        const bool space = c == ' ' || c == '\n';
+        if (!space && !in_word) ++words;
+        in_word = !space;
+    }
+    return words;
+}
+
+Capsule make_capsule(const std::string& id, const std::string& content) {
+    Capsule capsule;
+    capsule.id = id;
+    capsule.content = content;
+    capsule.confidence = 0.5f;
+    return capsule;
+}
+
+ContextPacker word_packer(std::size_t budget, std::size_t per_capsule, std::size_t min_per_capsule = 4) {
+    ContextPackerOptions options;
+    options.token_budget = budget;
+    options.max_capsules = 10;
+    options.max_tokens_per_capsule = per_capsule;
+    options.min_tokens_per_capsule = min_per_capsule;
+    options.token_counter = count_words;
+    return ContextPacker(options);
+}
+
+} // namespace
+
+TEST(CapsuleTextIndex, TokenizeSplitsIdentifiersAndFoldsTurkish) {
+    EXPECT_EQ(CapsuleTextIndex::tokenize("mdb_put FAILED: MDB_MAP_FULL"),
+              (std::vector<std::string>{"mdb", "put", "mdb_put", "failed", "mdb", "map", "full", "mdb_map_full"}));
+    // Baştaki/sondaki alt çizgi boş parça üretmez; yalnızca alt çizgiden oluşan dizi atlanır.
+    EXPECT_EQ(CapsuleTextIndex::tokenize("_özel __ x_"), (std::vector<std::string>{"özel", "_özel", "x", "x_"}));
+    // Türkçe büyük harfler küçültülür; İ noktasız 'i' olur.
+    EXPECT_EQ(CapsuleTextIndex::tokenize("İSTANBUL ÇÖÜ ĞŞ"), (std::vector<std::string>{"istanbul", "çöü", "ğş"}));
+    EXPECT_EQ(CapsuleTextIndex::tokenize("Çalışma"), CapsuleTextIndex::tokenize("çalışma"));
+    EXPECT_TRUE(CapsuleTextIndex::tokenize(" ,.;!? ").empty());
+}
+
+TEST(CapsuleTextIndex, Bm25RanksByTermFrequencyAndLength) {
+    CapsuleTextIndex index;
+    index.add_or_update("once", "hata hata hata kodu");
+    index.add_or_update("twice", "hata hata kodu kodu");
+    index.add_or_update("long", "hata kodu ve çok uzun bir açıklama metni burada devam ediyor");
+    index.add_or_update("other", "tamamen ilgisiz bir kapsül");
+
+    // Aynı uzunlukta daha yüksek tf önde; aynı tf'de kısa belge uzun belgenin önünde.
+    EXPECT_EQ(hit_ids(index.search("hata", 10)), (std::vector<std::string>{"once", "twice", "long"}));
+    const auto hits = index.search("hata", 10);
+    EXPECT_GT(hits[0].score, hits[1].score);
+    EXPECT_GT(hits[1].score, hits[2].score);
+
+    // Nadir terim yaygın terimden ağır basar.
+    index.add_or_update("rare", "hata E4021");
+    EXPECT_EQ(index.search("kodu e4021", 1).front().id, "rare");
+
+    // top_k, eşleşmeyen sorgu ve boş sorgu.
+    EXPECT_EQ(index.search("hata", 2).size(), 2u);
+    EXPECT_TRUE(index.search("olmayanterim", 5).empty());
+    EXPECT_TRUE(index.search("  ", 5).empty());
+}
+
+TEST(CapsuleTextIndex, MatchesIdentifierPartsAndCaseInsensitively) {
+    CapsuleTextIndex index;
+    index.add_or_update("lmdb", "mdb_put MDB_MAP_FULL döndürdü");
+    index.add_or_update("city", "İstanbul Boğazı");
+
+    EXPECT_EQ(hit_ids(index.search("map_full", 5)), std::vector<std::string>{"lmdb"});
+    EXPECT_EQ(hit_ids(index.search("PUT", 5)), std::vector<std::string>{"lmdb"});
+    EXPECT_EQ(hit_ids(index.search("istanbul boğazı", 5)), std::vector<std::string>{"city"});
+}
+
+TEST(CapsuleTextIndex, UpdateAndRemoveReplacePostings) {
+    CapsuleTextIndex index;
+    index.add_or_update("a", "eski terim");
+    index.add_or_update("b", "başka belge");
+    ASSERT_EQ(index.size(), 2u);
+
+    index.add_or_update("a", "yeni içerik");
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_TRUE(index.search("eski", 5).empty());
+    EXPECT_EQ(hit_ids(index.search("yeni", 5)), std::vector<std::string>{"a"});
+
+    EXPECT_TRUE(index.remove("a"));
+    EXPECT_FALSE(index.remove("a"));
+    EXPECT_FALSE(index.contains("a"));
+    EXPECT_TRUE(index.search("yeni", 5).empty());
+    EXPECT_EQ(hit_ids(index.search("belge", 5)), std::vector<std::string>{"b"});
+
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.search("belge", 5).empty());
+}
+
+TEST(ContextPacker, StaysWithinBudgetAndSkipsDuplicates) {
+    const ContextPacker packer = word_packer(20, 10);
+    const std::vector<Capsule> ranked = {
+        make_capsule("c0", "bir iki üç dört beş altı yedi sekiz."),
+        make_capsule("c1", "bir iki üç dört beş altı yedi sekiz."), // c0 ile aynı içerik
+        make_capsule("c2", "dokuz on onbir oniki onüç ondört onbeş onaltı."),
+        make_capsule("c3", ""),                                     // Gösterilecek metin yok
+        make_capsule("c4", "a b c d e f g h i j k l."),
+        make_capsule("c5", "son kapsül için yer kalmadı."),
+    };
+    const PackedContext packed = packer.pack(ranked, "");
+
+    ASSERT_EQ(packed.items.size(), 3u);
+    EXPECT_EQ(packed.items[0].index, 0u);
+    EXPECT_EQ(packed.items[1].index, 2u);
+    EXPECT_EQ(packed.items[2].index, 4u);
+    EXPECT_FALSE(packed.items[0].truncated);
+    EXPECT_TRUE(packed.items[2].truncated); // Kalan 4 token'a kırpıldı
+    EXPECT_LE(packed.used_tokens, 20u);
+    std::size_t total = 0;
+    for (const auto& item : packed.items) {
+        EXPECT_LE(item.tokens, 10u);
+        EXPECT_EQ(item.tokens, count_words(item.snippet));
+        total += item.tokens;
+    }
+    EXPECT_EQ(total, packed.used_tokens);
+    EXPECT_EQ(packed.leftover, (std::vector<std::size_t>{1, 3, 5}));
+}
+
+TEST(ContextPacker, ReplacesMeaninglessContentWithSummary) {
+    Capsule placeholder = make_capsule("p", "Bilgi bulunamadı.");
+    placeholder.plain_text_summary = "Özet metni.";
+    Capsule empty = make_capsule("e", "Is this data relevant to AI Insight?");
+
+    EXPECT_EQ(ContextPacker::display_text(placeholder), "Özet metni.");
+    EXPECT_EQ(ContextPacker::display_text(empty), "");
+    EXPECT_EQ(ContextPacker::display_text(make_capsule("x", "Gerçek içerik.")), "Gerçek içerik.");
+}
+
+TEST(ContextPacker, BestWindowFollowsQueryTermsAndMarksCuts) {
+    const std::string text = "Birinci cümle giriş. İkinci cümle dolgu. Üçüncü cümle hata kodu E42 içerir.";
+    const ContextPacker packer = word_packer(100, 7);
+
+    // Sorgu terimi son cümlede: pencere oradan başlar, metnin sonuna ulaştığı için sonda "..." yoktur.
+    PackedContext packed = packer.pack({make_capsule("c", text)}, "e42");
+    ASSERT_EQ(packed.items.size(), 1u);
+    EXPECT_TRUE(packed.items[0].truncated);
+    EXPECT_EQ(packed.items[0].snippet, "...Üçüncü cümle hata kodu E42 içerir.");
+
+    // Sorgu terimi ilk cümlede: pencere baştan başlar, sonraki cümle sığmadığı için sonda "..." vardır.
+    packed = packer.pack({make_capsule("c", text)}, "giriş");
+    ASSERT_EQ(packed.items.size(), 1u);
+    EXPECT_EQ(packed.items[0].snippet, "Birinci cümle giriş. İkinci cümle dolgu....");
+
+    // Bütçeye sığan metin olduğu gibi döner.
+    packed = word_packer(100, 50).pack({make_capsule("c", text)}, "e42");
+    ASSERT_EQ(packed.items.size(), 1u);
+    EXPECT_FALSE(packed.items[0].truncated);
+    EXPECT_EQ(packed.items[0].snippet, text);
+}
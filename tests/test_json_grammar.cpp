@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/brain/json_grammar.h"
+#include "../src/external/nlohmann/json.hpp"
+
+// Şemadan derlenen JSON dilbilgisi: kabul/ret kuralları, aralık ve uzunluk sınırları, önbellek ve her kabul edilen
+// önekin geçerli bir belgeye tamamlanabildiği (örnekleyici maskesinin çıkmaza girmediği).
+
+using CerebrumLux::JsonGrammar;
+
+namespace {
+
+const std::string kEvaluationSchema = R"({
+    "type": "object",
+    "properties": {
+        "score": { "type": "integer", "minimum": 0, "maximum": 100 },
+        "level": { "enum": ["beginner", "intermediate", "advanced"] },
+        "passed": { "type": "boolean" },
+        "feedback": { "type": "string", "maxLength": 12 }
+    }
+})";
+
+bool accepts(const JsonGrammar& grammar, const std::string& text, bool require_complete = true) {
+    JsonGrammar::State state = grammar.initial_state();
+    if (!grammar.advance(state, text)) return false;
+    return !require_complete || grammar.complete(state);
+}
+
+} // namespace
+
+TEST(JsonGrammar, AcceptsConformingDocumentAndStopsAtClosingBrace) {
+    auto grammar = JsonGrammar::compile(kEvaluationSchema);
+    ASSERT_NE(grammar, nullptr);
+    const std::string doc = "{\"score\": 87, \"level\": \"advanced\",\n \"passed\": true, \"feedback\": \"iyi \\\"is\\\"\"}";
+    EXPECT_TRUE(accepts(*grammar, doc));
+    // Yapısal karakter önündeki boşluk dizisi kMaxWhitespaceRun ile sınırlıdır.
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":\n   87", false));
+    EXPECT_TRUE(accepts(*grammar, " {\"score\":0,\"level\":\"beginner\",\"passed\":false,\"feedback\":\"\"}"));
+
+    JsonGrammar::State state = grammar->initial_state();
+    ASSERT_TRUE(grammar->advance(state, doc));
+    EXPECT_FALSE(grammar->advance(state, static_cast<unsigned char>(' '))); // Belge bitti, devam yok
+}
+
+TEST(JsonGrammar, RejectsOutOfOrderOrMissingFields) {
+    auto grammar = JsonGrammar::compile(kEvaluationSchema);
+    ASSERT_NE(grammar, nullptr);
+    EXPECT_FALSE(accepts(*grammar, "{\"level\":\"advanced\"", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":5}", false));
+    EXPECT_FALSE(accepts(*grammar, "Sure! {", false));
+}
+
+TEST(JsonGrammar, EnforcesIntegerRangeDuringGeneration) {
+    auto grammar = JsonGrammar::compile(kEvaluationSchema);
+    ASSERT_NE(grammar, nullptr);
+    EXPECT_TRUE(accepts(*grammar, "{\"score\":100", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":101", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":-1", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":05", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"score\":1.5", false));
+
+    auto bounded = JsonGrammar::compile(R"({"type":"object","properties":{"n":{"type":"integer","minimum":-20,"maximum":-3}}})");
+    ASSERT_NE(bounded, nullptr);
+    EXPECT_TRUE(accepts(*bounded, "{\"n\":-20}"));
+    EXPECT_TRUE(accepts(*bounded, "{\"n\":-3}"));
+    EXPECT_FALSE(accepts(*bounded, "{\"n\":3", false));
+    EXPECT_FALSE(accepts(*bounded, "{\"n\":-2}", false));  // -2 > maximum: sonlandırılamaz
+    EXPECT_FALSE(accepts(*bounded, "{\"n\":-21", false));
+}
+
+TEST(JsonGrammar, BoundsStringsAndValidatesEscapes) {
+    auto grammar = JsonGrammar::compile(R"({"type":"object","properties":{"s":{"type":"string","maxLength":3}}})");
+    ASSERT_NE(grammar, nullptr);
+    EXPECT_TRUE(accepts(*grammar, "{\"s\":\"abc\"}"));
+    EXPECT_FALSE(accepts(*grammar, "{\"s\":\"abcd", false));
+    EXPECT_TRUE(accepts(*grammar, "{\"s\":\"a\\nb\"}"));
+    EXPECT_FALSE(accepts(*grammar, "{\"s\":\"\\x", false));
+    EXPECT_FALSE(accepts(*grammar, "{\"s\":\"a\nb", false)); // Ham kontrol karakteri
+    EXPECT_FALSE(accepts(*grammar, "{\"s\":\"ab\xC3\xA7", false)); // 2 baytlık karakter sınıra sığmaz
+}
+
+TEST(JsonGrammar, CompileRejectsUnsupportedSchemasAndCacheReusesGrammar) {
+    EXPECT_EQ(JsonGrammar::compile("not json"), nullptr);
+    EXPECT_EQ(JsonGrammar::compile(R"({"type":"array"})"), nullptr);
+    EXPECT_EQ(JsonGrammar::compile(R"({"type":"object","properties":{"x":{"type":"number"}}})"), nullptr);
+    EXPECT_EQ(JsonGrammar::compile(R"({"type":"object","properties":{"x":{"enum":[1,2]}}})"), nullptr);
+
+    auto first = JsonGrammar::cached(kEvaluationSchema);
+    auto second = JsonGrammar::cached(kEvaluationSchema);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST(JsonGrammar, CompileRejectsWronglyTypedSchemaValuesWithoutThrowing) {
+    // nlohmann value()/get() bu alanlarda type_error fırlatır; compile istisna sızdırmadan nullptr dönmeli.
+    const char* const schemas[] = {
+        R"({"type":3,"properties":{"x":{"type":"string"}}})",
+        R"({"type":"object","properties":{"x":{"type":["string"]}}})",
+        R"({"type":"object","properties":{"x":{"type":"string","maxLength":"uzun"}}})",
+        R"({"type":"object","properties":{"x":{"type":"string","maxLength":-1}}})",
+        R"({"type":"object","properties":{"x":{"type":"integer","minimum":"0"}}})",
+        R"({"type":"object","properties":{"x":{"type":"integer","maximum":[10]}}})",
+    };
+    for (const char* schema : schemas) {
+        std::shared_ptr<const JsonGrammar> grammar;
+        EXPECT_NO_THROW(grammar = JsonGrammar::compile(schema)) << schema;
+        EXPECT_EQ(grammar, nullptr) << schema;
+    }
+}
+
+TEST(JsonGrammar, EveryAcceptedPrefixCompletesWithinDocumentBound) {
+    auto grammar = JsonGrammar::compile(kEvaluationSchema);
+    ASSERT_NE(grammar, nullptr);
+    std::mt19937 rng(1234);
+
+    // Rastgele bir "model": her adımda kabul edilen baytlardan birini seçer. Maske hiçbir zaman boş kalmamalı ve
+    // belge sınır içinde tamamlanıp şemaya uyan JSON olarak ayrışmalı.
+    for (int run = 0; run < 300; ++run) {
+        JsonGrammar::State state = grammar->initial_state();
+        std::string out;
+        while (!grammar->complete(state)) {
+            ASSERT_LE(out.size(), grammar->max_document_length());
+            std::vector<unsigned char> allowed;
+            for (int byte = 0; byte < 256; ++byte) {
+                JsonGrammar::State probe = state;
+                if (grammar->advance(probe, static_cast<unsigned char>(byte))) allowed.push_back(static_cast<unsigned char>(byte));
+            }
+            ASSERT_FALSE(allowed.empty()) << "çıkmaz durum: " << out;
+            // Yapısal ilerlemeyi hızlandırmak için ASCII baytları tercih et; UTF-8 dizilerini bütün olarak ekle.
+            unsigned char c = allowed[std::uniform_int_distribution<std::size_t>(0, allowed.size() - 1)(rng)];
+            if (c >= 0x80) c = 'x';
+            JsonGrammar::State probe = state;
+            if (!grammar->advance(probe, c)) c = allowed.front();
+            ASSERT_TRUE(grammar->advance(state, c));
+            out.push_back(static_cast<char>(c));
+        }
+        nlohmann::json parsed = nlohmann::json::parse(out);
+        EXPECT_GE(parsed["score"].get<int>(), 0);
+        EXPECT_LE(parsed["score"].get<int>(), 100);
+        EXPECT_TRUE(parsed["passed"].is_boolean());
+        EXPECT_LE(parsed["feedback"].get<std::string>().size(), 12u);
+    }
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../src/core/keyword_matcher.h"
+
+// Aho-Corasick anahtar kelime otomatı: örtüşen desenler, öncelik, UTF-8 katlama ve çalışma anında yeniden derleme.
+
+using CerebrumLux::KeywordMatcher;
+
+TEST(KeywordMatcher, FindsOverlappingPatternsInOnePass) {
+    KeywordMatcher matcher({{"he", 1}, {"she", 2}, {"his", 3}, {"hers", 4}});
+    EXPECT_EQ(matcher.match_ids("ushers"), (std::vector<int>{1, 2, 4}));
+    EXPECT_EQ(matcher.match_ids("this"), (std::vector<int>{3}));
+    EXPECT_TRUE(matcher.match_ids("xyz").empty());
+    EXPECT_EQ(matcher.pattern_count(), 4u);
+}
+
+TEST(KeywordMatcher, FirstMatchIsLowestRuleId) {
+    // Aynı ID'yi paylaşan desenler tek bir kural gibi davranır.
+    KeywordMatcher matcher({{"kapat", 5}, {"exit", 5}, {"selam", 0}, {"kimsin", 3}});
+    EXPECT_EQ(matcher.first_match("kimsin? selam"), 0);
+    EXPECT_EQ(matcher.first_match("uygulamayı kapat"), 5);
+    EXPECT_EQ(matcher.first_match("EXIT"), 5);
+    EXPECT_FALSE(matcher.first_match("hiçbiri").has_value());
+}
+
+TEST(KeywordMatcher, FoldsUtf8CaseOnce) {
+    KeywordMatcher matcher({{"Nasılsın", 1}, {"ŞEKER", 2}, {"İstanbul", 3}, {"Привет", 4}});
+    EXPECT_TRUE(matcher.contains_any("nasılsın?"));
+    EXPECT_TRUE(matcher.contains_any("NASıLSıN"));
+    // ASCII I, Türkçe ı'ya değil i'ye katlanır (std::tolower ile aynı).
+    EXPECT_FALSE(matcher.contains_any("NASILSIN"));
+    EXPECT_EQ(matcher.first_match("bir şeker lütfen"), 2);
+    EXPECT_EQ(matcher.first_match("İSTANBUL"), 3);
+    EXPECT_EQ(matcher.first_match("привет!"), 4);
+    EXPECT_EQ(KeywordMatcher::fold_case("ĞÜŞİÖÇ Abc"), "ğüşiöç abc");
+}
+
+TEST(KeywordMatcher, PassesInvalidUtf8Through) {
+    KeywordMatcher matcher({{"ab", 1}});
+    const std::string text = std::string("\xC3") + "AB" + "\xFF";
+    EXPECT_TRUE(matcher.contains_any(text));
+    EXPECT_EQ(KeywordMatcher::fold_case(text), std::string("\xC3") + "ab" + "\xFF");
+}
+
+TEST(KeywordMatcher, RebuildReplacesRules) {
+    KeywordMatcher matcher;
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_FALSE(matcher.contains_any("anything"));
+
+    matcher.rebuild({{"compile", 0}});
+    EXPECT_TRUE(matcher.contains_any("please COMPILE this"));
+    matcher.rebuild({{"lesson", 1}, {"", 2}});
+    EXPECT_FALSE(matcher.contains_any("please compile this"));
+    EXPECT_EQ(matcher.first_match("next lesson"), 1);
+    EXPECT_EQ(matcher.pattern_count(), 1u); // Boş desen yok sayılır
+}
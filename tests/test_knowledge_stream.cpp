@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/learning/KnowledgeStream.h"
+#include "../src/learning/KnowledgeBase.h"
+#include "../src/brain/autoencoder.h" // CryptofigAutoencoder::INPUT_DIM için
+
+// Akış tabanlı kapsül içe aktarma: ikili snapshot biçimi (gidiş-dönüş, CRC/kesilme reddi), SAX tabanlı JSON okuyucu
+// (eski biçim ve kök dizi girdileri) ve içe aktarma hattının eşzamanlı işlenen kapsül sınırı.
+
+using CerebrumLux::Capsule;
+using CerebrumLux::CapsuleJsonReader;
+using CerebrumLux::CapsuleJsonWriter;
+using CerebrumLux::CapsuleReadResult;
+using CerebrumLux::CapsuleSnapshot;
+
+namespace {
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_stream_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+Capsule make_capsule(int i) {
+    Capsule capsule;
+    capsule.id = "cap_" + std::to_string(i);
+    capsule.topic = "StreamTest";
+    capsule.source = "unit";
+    capsule.content = "içerik " + std::to_string(i) + "\n\"tırnaklı\" satır";
+    capsule.confidence = 0.5f;
+    capsule.embedding = {static_cast<float>(i), 0.25f, -1.0f};
+    return capsule;
+}
+
+std::string write_snapshot(int count) {
+    std::ostringstream out(std::ios::binary);
+    CapsuleSnapshot::Writer writer(out);
+    for (int i = 0; i < count; ++i) EXPECT_TRUE(writer.write(make_capsule(i)));
+    EXPECT_TRUE(writer.finish());
+    return out.str();
+}
+
+// Başlık: 8 bayt sihirli dize + sürüm + bayraklar.
+constexpr std::size_t kHeaderSize = 16;
+
+CapsuleReadResult read_snapshot(const std::string& data, std::vector<Capsule>& out) {
+    std::istringstream in(data, std::ios::binary);
+    return CapsuleSnapshot::read(in, [&out](Capsule&& capsule) {
+        out.push_back(std::move(capsule));
+        return true;
+    });
+}
+
+CapsuleReadResult read_json(const std::string& text, std::vector<Capsule>& out) {
+    std::istringstream in(text);
+    return CapsuleJsonReader::read(in, [&out](Capsule&& capsule) {
+        out.push_back(std::move(capsule));
+        return true;
+    });
+}
+
+} // namespace
+
+TEST(CapsuleSnapshot, RoundTripPreservesCapsulesAndOrder) {
+    const std::string data = write_snapshot(50);
+    std::vector<Capsule> capsules;
+    const CapsuleReadResult result = read_snapshot(data, capsules);
+
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(result.found_capsules);
+    EXPECT_EQ(result.capsules, 50u);
+    EXPECT_EQ(result.skipped, 0u);
+    ASSERT_EQ(capsules.size(), 50u);
+    for (int i = 0; i < 50; ++i) {
+        const Capsule expected = make_capsule(i);
+        EXPECT_EQ(capsules[i].id, expected.id);
+        EXPECT_EQ(capsules[i].content, expected.content);
+        EXPECT_EQ(capsules[i].topic, expected.topic);
+        EXPECT_EQ(capsules[i].embedding, expected.embedding);
+    }
+}
+
+TEST(CapsuleSnapshot, SkipsRecordWithCrcMismatch) {
+    std::string data = write_snapshot(3);
+    // İlk kaydın yükündeki bir baytı boz: kayıt atlanmalı, diğerleri okunmalı.
+    data[kHeaderSize + 4 + 2] ^= 0x5A;
+    std::vector<Capsule> capsules;
+    const CapsuleReadResult result = read_snapshot(data, capsules);
+
+    EXPECT_TRUE(result.ok) << result.error;
+    EXPECT_EQ(result.skipped, 1u);
+    EXPECT_EQ(result.capsules, 2u);
+    ASSERT_EQ(capsules.size(), 2u);
+    EXPECT_EQ(capsules[0].id, "cap_1");
+    EXPECT_EQ(capsules[1].id, "cap_2");
+}
+
+TEST(CapsuleSnapshot, RejectsTruncatedRecordAndBadHeader) {
+    const std::string data = write_snapshot(3);
+    // Son işaretinden (4 + 8 bayt) ve son kaydın yarısından kesilmiş dosya.
+    const std::string truncated = data.substr(0, data.size() - 12 - 10);
+    std::vector<Capsule> capsules;
+    const CapsuleReadResult result = read_snapshot(truncated, capsules);
+
+    EXPECT_FALSE(result.ok);
+    EXPECT_FALSE(result.error.empty());
+    EXPECT_EQ(capsules.size(), 2u); // Kesilmeden önceki tam kayıtlar teslim edilir
+
+    // Son işareti olmayan (kayıt sınırında kesilmiş) dosya da tamamlanmış sayılmaz.
+    capsules.clear();
+    EXPECT_FALSE(read_snapshot(data.substr(0, data.size() - 12), capsules).ok);
+    EXPECT_EQ(capsules.size(), 3u);
+
+    capsules.clear();
+    std::string bad_magic = data;
+    bad_magic[0] = 'X';
+    const CapsuleReadResult header = read_snapshot(bad_magic, capsules);
+    EXPECT_FALSE(header.ok);
+    EXPECT_FALSE(header.found_capsules);
+    EXPECT_TRUE(capsules.empty());
+}
+
+TEST(CapsuleJsonReader, ReadsWriterOutputAndFlagsLegacyCapsules) {
+    std::ostringstream out;
+    CapsuleJsonWriter writer(out);
+    for (int i = 0; i < 3; ++i) writer.write(make_capsule(i));
+    ASSERT_TRUE(writer.finish());
+
+    std::vector<Capsule> capsules;
+    CapsuleReadResult result = read_json(out.str(), capsules);
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(result.found_capsules);
+    EXPECT_FALSE(result.legacy_format);
+    ASSERT_EQ(capsules.size(), 3u);
+    EXPECT_EQ(capsules[2].content, make_capsule(2).content);
+
+    // trust_score / timestamp_utc içermeyen eski kapsüller okunur ve eski biçim olarak işaretlenir.
+    const std::string legacy = R"({"version": 1, "active_capsules": [
+        {"id": "old_1", "topic": "Eski", "content": "a", "embedding": [1.0, 2.0]},
+        {"id": "old_2", "topic": "Eski", "content": "b", "nested": {"x": [1, {"y": 2}]}}
+    ], "trailer": {"ignored": true}})";
+    capsules.clear();
+    result = read_json(legacy, capsules);
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(result.legacy_format);
+    ASSERT_EQ(capsules.size(), 2u);
+    EXPECT_EQ(capsules[0].id, "old_1");
+    EXPECT_EQ(capsules[0].embedding, (std::vector<float>{1.0f, 2.0f}));
+    EXPECT_EQ(capsules[1].content, "b");
+}
+
+TEST(CapsuleJsonReader, AcceptsRootArrayAndReportsMissingCapsules) {
+    const std::string array = R"([{"id": "a1", "content": "x"}, {"id": "a2", "content": "y"}, {"id": "a3", "content": "z"}])";
+    std::vector<Capsule> capsules;
+    CapsuleReadResult result = read_json(array, capsules);
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(result.found_capsules);
+    ASSERT_EQ(capsules.size(), 3u);
+    EXPECT_EQ(capsules[0].id, "a1");
+    EXPECT_EQ(capsules[2].id, "a3");
+
+    capsules.clear();
+    result = read_json(R"({"other": [1, 2, 3]})", capsules);
+    EXPECT_FALSE(result.found_capsules);
+    EXPECT_TRUE(capsules.empty());
+
+    capsules.clear();
+    result = read_json(R"({"active_capsules": [{"id": "b1", "content": "x"}, )", capsules);
+    EXPECT_FALSE(result.ok);
+    EXPECT_EQ(capsules.size(), 1u);
+}
+
+TEST(CapsuleImportPipeline, StalledCapsuleBoundsInFlightWork) {
+    TempDbDir dir("pipeline");
+    CerebrumLux::KnowledgeBase kb(dir.str());
+
+    std::ostringstream out(std::ios::binary);
+    CapsuleSnapshot::Writer writer(out);
+    for (int i = 0; i < 200; ++i) {
+        Capsule capsule = make_capsule(i);
+        capsule.embedding.clear(); // Embedding aşamasında hesaplanır
+        writer.write(capsule);
+    }
+    ASSERT_TRUE(writer.finish());
+
+    // İlk kapsülün embedding'i takılır; diğer işçiler sıradaki kapsülleri işlemeye devam eder. Depolama ilk kapsülü
+    // beklediği sürece ayrıştırıcı pencerenin ötesine geçmemeli.
+    CerebrumLux::CapsuleImportOptions options;
+    options.workers = 3;
+    options.batch_size = 16;
+    options.queue_capacity = 8;
+    std::atomic<std::size_t> embedded_while_stalled{0};
+    std::atomic<bool> stalled{true};
+    options.embedder = [&](const Capsule& capsule) {
+        if (capsule.id == "cap_0") {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            stalled = false;
+        } else if (stalled) {
+            ++embedded_while_stalled;
+        }
+        return std::vector<float>(CerebrumLux::CryptofigAutoencoder::INPUT_DIM, 0.5f);
+    };
+
+    CerebrumLux::CapsuleImportPipeline pipeline(kb, options);
+    std::istringstream in(out.str(), std::ios::binary);
+    const CerebrumLux::CapsuleImportStats stats = pipeline.run_snapshot(in);
+
+    ASSERT_TRUE(stats.ok) << stats.error;
+    EXPECT_EQ(stats.parsed, 200u);
+    EXPECT_EQ(stats.stored, 200u);
+    EXPECT_LT(embedded_while_stalled.load(), options.queue_capacity);
+    ASSERT_TRUE(kb.find_capsule_by_id("cap_199").has_value());
+}
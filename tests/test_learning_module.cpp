@@ -174,6 +174,24 @@ int main() {
     // assert(report_4.result == CerebrumLux::IngestResult::SanitizationNeeded); // Eğer sanitizer aktifse
 
 
+    // Test Senaryosu 5: Bellek içi Q-değeri indeksi Q-Table ile senkron kalmalı
+    LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "Running Test Scenario 5: In-memory Q-value index");
+    std::vector<float> q_state(CerebrumLux::CryptofigAutoencoder::LATENT_DIM, 0.25f);
+    const auto q_state_key = CerebrumLux::LearningModule::state_key_for(q_state);
+    learning_module.update_q_values(q_state, CerebrumLux::AIAction::RefactorCode, 1.0f, q_state);
+    learning_module.update_q_values(q_state, CerebrumLux::AIAction::SuggestResearch, -1.0f, q_state);
+    auto best = learning_module.getQValueIndex().best_action(q_state_key);
+    assert(best && best->action == CerebrumLux::AIAction::RefactorCode);
+    assert(*learning_module.getQValueIndex().q_value(q_state_key, CerebrumLux::AIAction::RefactorCode) ==
+           learning_module.getQTable().q_values.at(q_state_key).at(CerebrumLux::AIAction::RefactorCode));
+    // En iyi eylemin değeri düşünce argmax yeniden hesaplanmalı.
+    for (int i = 0; i < 20; ++i) {
+        learning_module.update_q_values(q_state, CerebrumLux::AIAction::RefactorCode, -5.0f, q_state);
+    }
+    best = learning_module.getQValueIndex().best_action(q_state_key);
+    assert(best && best->action == CerebrumLux::AIAction::SuggestResearch);
+
+
     LOG_DEFAULT(CerebrumLux::LogLevel::INFO, "--- Finished LearningModule Test Scenarios ---");
 
     return 0; // Testlerin başarılı olduğunu gösterir
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/swarm_vectordb/ShardedVectorDB.h"
+
+// Parçalı vektör deposu: parçaların top_k sonuçlarının birleşimi tek veritabanının top_k sonucuyla aynı olmalı
+// (hash ve konu bölümleme, filtreli ve filtresiz). Konu bölümlemede konusu değişen bir ID yeniden yazıldığında eski
+// parçada kopyası kalmamalı.
+
+namespace {
+
+using CerebrumLux::SwarmVectorDB::CryptofigVector;
+using CerebrumLux::SwarmVectorDB::ShardedSearchHit;
+using CerebrumLux::SwarmVectorDB::ShardedSwarmVectorDB;
+using CerebrumLux::SwarmVectorDB::ShardPartition;
+using CerebrumLux::SwarmVectorDB::SwarmVectorDB;
+using CerebrumLux::SwarmVectorDB::VectorAttributes;
+using CerebrumLux::SwarmVectorDB::VectorFilter;
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_sharded_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+    std::string sub(const std::string& name) const { return (path_ / name).string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+const char* const kTopics[] = {"Fizik", "Kimya", "Tarih", "Biyoloji", "Edebiyat"};
+
+std::vector<float> embedding_for(int i) {
+    std::mt19937 rng(static_cast<unsigned>(i) + 1);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> values(256);
+    for (float& v : values) v = dist(rng);
+    return values;
+}
+
+CryptofigVector make_vector(int i, const std::string& topic) {
+    CryptofigVector cv;
+    cv.id = "vec_" + std::to_string(i);
+    cv.topic = topic;
+    const std::vector<float> values = embedding_for(i);
+    cv.embedding = Eigen::Map<const Eigen::VectorXf>(values.data(), static_cast<Eigen::Index>(values.size()));
+    return cv;
+}
+
+// Aynı kayıtlar hem parçalı hem tek veritabanına yazılır; konu ve nitelikler ID'den türetilir.
+void fill_both(ShardedSwarmVectorDB& sharded, SwarmVectorDB& single, int count) {
+    for (int start = 0; start < count; start += 100) {
+        std::vector<CryptofigVector> cvs;
+        std::vector<VectorAttributes> attributes;
+        for (int i = start; i < std::min(count, start + 100); ++i) {
+            cvs.push_back(make_vector(i, kTopics[i % 5]));
+            VectorAttributes a;
+            a.topic = cvs.back().topic;
+            a.source = (i % 3 == 0) ? "web" : "book";
+            a.trust_score = static_cast<float>(i % 10) / 10.0f;
+            attributes.push_back(a);
+        }
+        ASSERT_TRUE(sharded.store_vectors_batch(cvs, {}, attributes));
+        ASSERT_TRUE(single.store_vectors_batch(cvs, {}, attributes));
+    }
+}
+
+void expect_same_top_k(const std::vector<ShardedSearchHit>& sharded, const std::vector<std::pair<std::string, float>>& single,
+                       int probe) {
+    ASSERT_EQ(sharded.size(), single.size()) << "probe " << probe;
+    for (std::size_t i = 0; i < sharded.size(); ++i) {
+        EXPECT_EQ(sharded[i].id, single[i].first) << "probe " << probe << " sıra " << i;
+        EXPECT_NEAR(sharded[i].distance, single[i].second, 1e-3f * std::max(1.0f, single[i].second)) << "probe " << probe;
+    }
+}
+
+// Verilen konudan farklı bir parçaya düşen ilk konu.
+std::string topic_on_other_shard(const ShardedSwarmVectorDB& db, const CryptofigVector& cv) {
+    const std::size_t current = db.shard_for(cv);
+    for (const char* topic : kTopics) {
+        CryptofigVector moved = cv;
+        moved.topic = topic;
+        if (db.shard_for(moved) != current) return topic;
+    }
+    return "";
+}
+
+} // namespace
+
+TEST(ShardedVectorDb, HashPartitionMatchesUnshardedTopK) {
+    TempDbDir dir("hash");
+    ShardedSwarmVectorDB sharded(dir.sub("sharded"), 4, ShardPartition::Hash, 10000);
+    SwarmVectorDB single(dir.sub("single"), 10000);
+    ASSERT_TRUE(sharded.open());
+    ASSERT_TRUE(single.open());
+    fill_both(sharded, single, 600);
+
+    EXPECT_EQ(sharded.get_all_ids().size(), 600u);
+    EXPECT_EQ(sharded.get_index_stats().live_elements, 600u);
+    for (std::size_t i = 0; i < sharded.shard_count(); ++i) EXPECT_GT(sharded.shard(i).get_index_stats().live_elements, 0u);
+
+    for (int probe = 0; probe < 600; probe += 47) {
+        const std::vector<float> query = embedding_for(probe);
+        expect_same_top_k(sharded.search_similar_scored(query, 10), single.search_similar_scored(query, 10), probe);
+        EXPECT_EQ(sharded.search_similar_vectors(query, 1), std::vector<std::string>{"vec_" + std::to_string(probe)});
+    }
+
+    // Parçalardaki toplam kayıttan büyük top_k her şeyi döndürür.
+    EXPECT_EQ(sharded.search_similar_scored(embedding_for(1), 1000).size(), 600u);
+}
+
+TEST(ShardedVectorDb, TopicPartitionMatchesUnshardedFilteredTopK) {
+    TempDbDir dir("topic");
+    ShardedSwarmVectorDB sharded(dir.sub("sharded"), 3, ShardPartition::Topic, 10000);
+    SwarmVectorDB single(dir.sub("single"), 10000);
+    ASSERT_TRUE(sharded.open());
+    ASSERT_TRUE(single.open());
+    fill_both(sharded, single, 500);
+
+    VectorFilter filter;
+    filter.topics = {"Kimya", "Edebiyat"};
+    filter.sources = {"web"};
+    for (int probe = 3; probe < 500; probe += 61) {
+        const std::vector<float> query = embedding_for(probe);
+        expect_same_top_k(sharded.search_similar_scored(query, 8), single.search_similar_scored(query, 8), probe);
+        expect_same_top_k(sharded.search_similar_scored(query, 8, &filter), single.search_similar_scored(query, 8, &filter),
+                          probe);
+    }
+}
+
+TEST(ShardedVectorDb, TopicChangeMovesIdToNewShard) {
+    TempDbDir dir("move");
+    ShardedSwarmVectorDB db(dir.str(), 4, ShardPartition::Topic, 10000);
+    ASSERT_TRUE(db.open());
+
+    const CryptofigVector original = make_vector(7, "Fizik");
+    ASSERT_TRUE(db.store_vector(original));
+    const std::size_t old_shard = db.shard_for(original);
+
+    // Tekli yazım: konu değişince kayıt yeni parçaya taşınır, eskisinde kopya kalmaz.
+    CryptofigVector moved = original;
+    moved.topic = topic_on_other_shard(db, original);
+    ASSERT_FALSE(moved.topic.empty());
+    ASSERT_TRUE(db.store_vector(moved));
+    const std::size_t new_shard = db.shard_for(moved);
+    EXPECT_EQ(db.shard(old_shard).get_vector("vec_7"), nullptr);
+    ASSERT_NE(db.shard(new_shard).get_vector("vec_7"), nullptr);
+    EXPECT_EQ(db.get_vector("vec_7")->topic, moved.topic);
+    EXPECT_EQ(db.get_all_ids(), std::vector<std::string>{"vec_7"});
+    EXPECT_EQ(db.search_similar_vectors(embedding_for(7), 5), std::vector<std::string>{"vec_7"});
+
+    // Toplu yazım: aynı ID'ler eski konularıyla geri yazılır; her biri tam bir kez bulunur.
+    std::vector<CryptofigVector> batch;
+    for (int i = 0; i < 40; ++i) batch.push_back(make_vector(i, kTopics[i % 5]));
+    ASSERT_TRUE(db.store_vectors_batch(batch));
+    for (auto& cv : batch) cv.topic = topic_on_other_shard(db, cv);
+    ASSERT_TRUE(db.store_vectors_batch(batch));
+
+    std::vector<std::string> ids = db.get_all_ids();
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+    EXPECT_EQ(ids.size(), 40u);
+    EXPECT_EQ(db.get_index_stats().live_elements, 40u);
+    for (const auto& cv : batch) {
+        for (std::size_t i = 0; i < db.shard_count(); ++i) {
+            EXPECT_EQ(db.shard(i).get_vector(cv.id) != nullptr, i == db.shard_for(cv)) << cv.id << " parça " << i;
+        }
+    }
+
+    const auto hits = db.search_similar_vectors(embedding_for(12), 40);
+    std::vector<std::string> sorted_hits = hits;
+    std::sort(sorted_hits.begin(), sorted_hits.end());
+    EXPECT_EQ(std::adjacent_find(sorted_hits.begin(), sorted_hits.end()), sorted_hits.end());
+    EXPECT_EQ(hits.front(), "vec_12");
+}
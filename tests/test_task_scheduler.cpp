@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../src/core/task_scheduler.h"
+
+// Ortak görev zamanlayıcısı: öncelik sırası, sınıf sınırları, işbirlikçi iptal ve çağıranın katıldığı parallel_for.
+
+using CerebrumLux::CancellationToken;
+using CerebrumLux::TaskClass;
+using CerebrumLux::TaskHandle;
+using CerebrumLux::TaskScheduler;
+
+namespace {
+
+TaskScheduler::Options options_with(std::size_t workers) {
+    TaskScheduler::Options options;
+    options.workers = workers;
+    return options;
+}
+
+} // namespace
+
+TEST(TaskScheduler, RunsSubmittedTasksAndReportsCompletion) {
+    TaskScheduler scheduler(options_with(4));
+    std::atomic<int> sum{0};
+    std::vector<TaskHandle> handles;
+    for (int i = 1; i <= 100; ++i) {
+        handles.push_back(scheduler.submit(TaskClass::Interactive, [&sum, i] { sum += i; }));
+    }
+    for (TaskHandle& handle : handles) EXPECT_TRUE(handle.wait());
+    EXPECT_EQ(sum.load(), 5050);
+    EXPECT_EQ(scheduler.stats(TaskClass::Interactive).completed, 100u);
+    EXPECT_EQ(scheduler.stats(TaskClass::Interactive).queued, 0u);
+}
+
+TEST(TaskScheduler, EnforcesPerClassConcurrencyLimit) {
+    TaskScheduler::Options options = options_with(6);
+    options.max_concurrency[static_cast<std::size_t>(TaskClass::Inference)] = 2;
+    TaskScheduler scheduler(options);
+
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::vector<TaskHandle> handles;
+    for (int i = 0; i < 12; ++i) {
+        handles.push_back(scheduler.submit(TaskClass::Inference, [&] {
+            const int now = ++active;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            --active;
+        }));
+    }
+    // wait_for kuyruktaki görevi çağıranda yürütmez; sınır yalnızca işçilerde ölçülür.
+    for (TaskHandle& handle : handles) EXPECT_TRUE(handle.wait_for(std::chrono::seconds(10)));
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_EQ(scheduler.stats(TaskClass::Inference).completed, 12u);
+}
+
+TEST(TaskScheduler, HigherPriorityClassRunsFirst) {
+    TaskScheduler scheduler(options_with(1));
+    std::mutex order_mutex;
+    std::vector<TaskClass> order;
+    std::atomic<bool> release{false};
+
+    // Tek işçiyi meşgul et, sonra ters öncelik sırasıyla gönder.
+    TaskHandle blocker = scheduler.submit(TaskClass::Interactive, [&] {
+        while (!release) std::this_thread::yield();
+    });
+    while (scheduler.stats(TaskClass::Interactive).running == 0) std::this_thread::yield();
+
+    std::vector<TaskHandle> handles;
+    for (TaskClass cls : {TaskClass::Persistence, TaskClass::BackgroundLearning, TaskClass::Inference, TaskClass::Interactive}) {
+        handles.push_back(scheduler.submit(cls, [&, cls] {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(cls);
+        }));
+    }
+    release = true;
+    blocker.wait();
+    for (TaskHandle& handle : handles) handle.wait_for(std::chrono::seconds(10));
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[0], TaskClass::Interactive);
+    EXPECT_EQ(order[1], TaskClass::Inference);
+    EXPECT_EQ(order[2], TaskClass::BackgroundLearning);
+    EXPECT_EQ(order[3], TaskClass::Persistence);
+}
+
+TEST(TaskScheduler, CancellationIsCooperative) {
+    TaskScheduler scheduler(options_with(1));
+    std::atomic<bool> started{false};
+    std::atomic<bool> observed_cancel{false};
+    TaskHandle running = scheduler.submit(TaskClass::BackgroundLearning, [&](const CancellationToken& token) {
+        started = true;
+        while (!token.cancelled()) std::this_thread::yield();
+        observed_cancel = true;
+    });
+    while (!started) std::this_thread::yield();
+
+    std::atomic<bool> queued_ran{false};
+    TaskHandle queued = scheduler.submit(TaskClass::BackgroundLearning, [&] { queued_ran = true; });
+    queued.cancel();
+    running.cancel();
+
+    EXPECT_TRUE(running.wait());
+    EXPECT_TRUE(observed_cancel);
+    EXPECT_FALSE(queued.wait());
+    EXPECT_FALSE(queued_ran);
+    EXPECT_EQ(scheduler.stats(TaskClass::BackgroundLearning).cancelled, 1u);
+}
+
+TEST(TaskScheduler, WaitRunsQueuedTaskInlineWhenWorkersAreBusy) {
+    TaskScheduler scheduler(options_with(1));
+    std::atomic<bool> release{false};
+    TaskHandle blocker = scheduler.submit(TaskClass::Persistence, [&] {
+        while (!release) std::this_thread::yield();
+    });
+    while (scheduler.stats(TaskClass::Persistence).running == 0) std::this_thread::yield();
+
+    // Persistence sınırı 1 ve tek işçi meşgul: wait() görevi çağıran iş parçacığında yürütür.
+    std::thread::id ran_on;
+    TaskHandle queued = scheduler.submit(TaskClass::Persistence, [&] { ran_on = std::this_thread::get_id(); });
+    EXPECT_TRUE(queued.wait());
+    EXPECT_EQ(ran_on, std::this_thread::get_id());
+
+    release = true;
+    EXPECT_TRUE(blocker.wait());
+}
+
+TEST(TaskScheduler, ParallelForVisitsEveryIndexOnce) {
+    TaskScheduler scheduler(options_with(4));
+    std::vector<std::atomic<int>> visits(1000);
+    scheduler.parallel_for(TaskClass::Interactive, visits.size(), [&](std::size_t i) { ++visits[i]; });
+    for (const auto& v : visits) EXPECT_EQ(v.load(), 1);
+
+    // İç içe çağrı (bir görevin içinden) kilitlenmeden tamamlanır.
+    std::atomic<int> nested{0};
+    scheduler.parallel_for(TaskClass::Interactive, 8, [&](std::size_t) {
+        scheduler.parallel_for(TaskClass::Interactive, 8, [&](std::size_t) { ++nested; });
+    });
+    EXPECT_EQ(nested.load(), 64);
+}
+
+TEST(TaskScheduler, FailedTaskIsCountedAndDoesNotStopWorkers) {
+    TaskScheduler scheduler(options_with(2));
+    TaskHandle failing = scheduler.submit(TaskClass::Interactive, [] { throw std::runtime_error("boom"); });
+    EXPECT_TRUE(failing.wait());
+    std::atomic<bool> ran{false};
+    EXPECT_TRUE(scheduler.submit(TaskClass::Interactive, [&] { ran = true; }).wait());
+    EXPECT_TRUE(ran);
+    EXPECT_EQ(scheduler.stats(TaskClass::Interactive).failed, 1u);
+}
+
+TEST(TaskScheduler, ShutdownCancelsQueuedTasks) {
+    TaskScheduler scheduler(options_with(1));
+    std::atomic<bool> release{false};
+    TaskHandle blocker = scheduler.submit(TaskClass::Interactive, [&] {
+        while (!release) std::this_thread::yield();
+    });
+    while (scheduler.stats(TaskClass::Interactive).running == 0) std::this_thread::yield();
+    TaskHandle queued = scheduler.submit(TaskClass::Interactive, [] {});
+
+    std::thread stopper([&] { scheduler.shutdown(); });
+    EXPECT_TRUE(queued.wait_for(std::chrono::seconds(10)));
+    EXPECT_FALSE(queued.wait());
+    release = true;
+    stopper.join();
+    EXPECT_TRUE(blocker.wait());
+    EXPECT_FALSE(scheduler.submit(TaskClass::Interactive, [] {}).wait());
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../src/core/time_series.h"
+
+// Grafik zaman serisi: LTTB'nin kova sınırları (ilk/son nokta hariç threshold-2 kova, her kovadan tam bir nokta),
+// ilk ve son noktanın korunması ve TimeSeriesStore::view'ün min/max özet seviyelerinden sonra da aralığın
+// uçlarını ve tepe noktalarını kaybetmemesi.
+
+using CerebrumLux::SeriesPoint;
+using CerebrumLux::TimeSeriesStore;
+
+namespace {
+
+// x = indeks olan seri; seçilen noktaların hangi ham noktadan geldiği x'ten okunur.
+std::vector<SeriesPoint> indexed_series(std::size_t n, double (*y)(std::size_t)) {
+    std::vector<SeriesPoint> points(n);
+    for (std::size_t i = 0; i < n; ++i) points[i] = {static_cast<double>(i), y(i)};
+    return points;
+}
+
+double wave(std::size_t i) { return std::sin(static_cast<double>(i) * 0.37) * 10.0 + static_cast<double>(i % 7); }
+
+// Beklenen k. kova sınırı, gerçekleştirmeden bağımsız olarak tamsayılarla.
+std::size_t bucket_edge(std::size_t k, std::size_t n, std::size_t threshold) { return 1 + k * (n - 2) / (threshold - 2); }
+
+void expect_increasing_x(const std::vector<SeriesPoint>& points) {
+    for (std::size_t i = 1; i < points.size(); ++i) EXPECT_LE(points[i - 1].x, points[i].x) << "sıra " << i;
+}
+
+} // namespace
+
+TEST(TimeSeriesLttb, EachBucketContributesExactlyOnePointWithinItsEdges) {
+    for (std::size_t n : {10u, 97u, 1000u, 1003u}) {
+        const std::vector<SeriesPoint> points = indexed_series(n, wave);
+        for (std::size_t threshold : {3u, 4u, 7u, 50u, 333u}) {
+            if (threshold >= n) continue;
+            const std::vector<SeriesPoint> sampled = TimeSeriesStore::lttb(points, threshold);
+            ASSERT_EQ(sampled.size(), threshold) << "n " << n << " threshold " << threshold;
+
+            EXPECT_EQ(sampled.front().x, 0.0);
+            EXPECT_EQ(sampled.front().y, points.front().y);
+            EXPECT_EQ(sampled.back().x, static_cast<double>(n - 1));
+            EXPECT_EQ(sampled.back().y, points.back().y);
+
+            // Son kova tam n-1'de biter: iç noktalar asla ilk veya son noktayı tekrar seçmez.
+            EXPECT_EQ(bucket_edge(threshold - 2, n, threshold), n - 1);
+            for (std::size_t k = 0; k + 2 < threshold; ++k) {
+                const auto index = static_cast<std::size_t>(sampled[k + 1].x);
+                EXPECT_GE(index, bucket_edge(k, n, threshold)) << "n " << n << " threshold " << threshold << " kova " << k;
+                EXPECT_LT(index, bucket_edge(k + 1, n, threshold)) << "n " << n << " threshold " << threshold << " kova " << k;
+                EXPECT_EQ(sampled[k + 1].y, points[index].y);
+            }
+        }
+    }
+}
+
+TEST(TimeSeriesLttb, PicksTheSpikeInEveryBucket) {
+    // n - 2 = 100 nokta, 10 kova: her kova tam 10 noktadır ve ortasında tek bir tepe vardır.
+    const std::size_t n = 102;
+    const std::size_t threshold = 12;
+    std::vector<SeriesPoint> points = indexed_series(n, [](std::size_t) { return 0.0; });
+    for (std::size_t k = 0; k < 10; ++k) points[1 + k * 10 + 5].y = (k % 2 == 0) ? 50.0 : -50.0;
+
+    const std::vector<SeriesPoint> sampled = TimeSeriesStore::lttb(points, threshold);
+    ASSERT_EQ(sampled.size(), threshold);
+    for (std::size_t k = 0; k < 10; ++k) {
+        EXPECT_EQ(sampled[k + 1].x, static_cast<double>(1 + k * 10 + 5)) << "kova " << k;
+    }
+}
+
+TEST(TimeSeriesLttb, SmallInputsAndThresholdsBelowThree) {
+    const std::vector<SeriesPoint> points = indexed_series(5, wave);
+    // Eşiğe sığan girdi olduğu gibi döner.
+    const std::vector<SeriesPoint> same = TimeSeriesStore::lttb(points, 5);
+    ASSERT_EQ(same.size(), 5u);
+    for (std::size_t i = 0; i < 5; ++i) EXPECT_EQ(same[i].x, points[i].x);
+
+    // 3'ten küçük eşik 3 kabul edilir: ilk, bir iç nokta ve son.
+    for (std::size_t threshold : {0u, 1u, 2u}) {
+        const std::vector<SeriesPoint> sampled = TimeSeriesStore::lttb(points, threshold);
+        ASSERT_EQ(sampled.size(), 3u);
+        EXPECT_EQ(sampled.front().x, 0.0);
+        EXPECT_EQ(sampled.back().x, 4.0);
+        EXPECT_GT(sampled[1].x, 0.0);
+        EXPECT_LT(sampled[1].x, 4.0);
+    }
+    EXPECT_TRUE(TimeSeriesStore::lttb({}, 10).empty());
+}
+
+TEST(TimeSeriesStore, ViewKeepsRangeEndpointsAndPeaksAcrossSummaryLevels) {
+    TimeSeriesStore store;
+    const std::size_t n = 100000;
+    for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(store.append(static_cast<double>(i) * 0.5, wave(i)));
+    // Tek noktalık tepeler: özet seviyesinden okunan görünümde de kaybolmamalı.
+    TimeSeriesStore spiky;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double y = (i == 12345) ? 1000.0 : (i == 95000) ? -1000.0 : wave(i);
+        ASSERT_TRUE(spiky.append(static_cast<double>(i) * 0.5, y));
+    }
+    EXPECT_FALSE(spiky.append(0.0, 1.0)); // Geriye giden x reddedilir
+
+    // Tüm seri: ilk ve son ham nokta korunur, bütçe aşılmaz.
+    const std::vector<SeriesPoint> all = spiky.view_all(200);
+    ASSERT_LE(all.size(), 200u);
+    ASSERT_GE(all.size(), 3u);
+    EXPECT_EQ(all.front().x, 0.0);
+    EXPECT_EQ(all.front().y, wave(0));
+    EXPECT_EQ(all.back().x, spiky.last_x());
+    EXPECT_EQ(all.back().y, wave(n - 1));
+    expect_increasing_x(all);
+    auto has_y = [](const std::vector<SeriesPoint>& points, double y) {
+        return std::any_of(points.begin(), points.end(), [y](const SeriesPoint& p) { return p.y == y; });
+    };
+    EXPECT_TRUE(has_y(all, 1000.0));
+    EXPECT_TRUE(has_y(all, -1000.0));
+
+    // Kova sınırlarına hizalı olmayan alt aralık: uçlar aralığın ilk/son ham noktasıdır, aralık dışına taşmaz.
+    const double x_min = 1234.25;
+    const double x_max = 45678.75;
+    const std::vector<SeriesPoint> part = spiky.view(x_min, x_max, 150);
+    ASSERT_LE(part.size(), 150u);
+    EXPECT_EQ(part.front().x, 1234.5);
+    EXPECT_EQ(part.back().x, 45678.5);
+    for (const SeriesPoint& p : part) {
+        EXPECT_GE(p.x, x_min);
+        EXPECT_LE(p.x, x_max);
+    }
+    expect_increasing_x(part);
+    EXPECT_TRUE(has_y(part, 1000.0));
+    EXPECT_FALSE(has_y(part, -1000.0));
+
+    // Bütçenin dört katından az noktalı aralık (61 nokta) ham LTTB yolundan gelir ve yine uçları korur.
+    const std::vector<SeriesPoint> narrow = store.view(100.0, 130.0, 20);
+    ASSERT_EQ(narrow.size(), 20u);
+    EXPECT_EQ(narrow.front().x, 100.0);
+    EXPECT_EQ(narrow.back().x, 130.0);
+
+    // y_range, hizasız uçlarda ham noktalara, ortada özet kovalarına bakar; kaba kuvvetle aynı sonucu verir.
+    double y_min = 0.0;
+    double y_max = 0.0;
+    ASSERT_TRUE(store.y_range(x_min, x_max, y_min, y_max));
+    double expected_min = wave(2469);
+    double expected_max = expected_min;
+    for (std::size_t i = 2469; i <= 91357; ++i) {
+        expected_min = std::min(expected_min, wave(i));
+        expected_max = std::max(expected_max, wave(i));
+    }
+    EXPECT_EQ(y_min, expected_min);
+    EXPECT_EQ(y_max, expected_max);
+    EXPECT_FALSE(store.y_range(-10.0, -1.0, y_min, y_max));
+    EXPECT_TRUE(TimeSeriesStore().view_all(100).empty());
+}
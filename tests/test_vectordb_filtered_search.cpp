@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lmdb.h>
+
+#include "../src/core/metrics.h"
+#include "../src/swarm_vectordb/VectorDB.h"
+
+// Nitelik filtreli arama: seçici filtrelerde aday listesi üzerinde tam arama, geniş filtrelerde HNSW graf araması
+// içinde AttributeFilterFunctor. İki yol da yalnızca filtreyi sağlayan ID'leri döndürmeli. Ayrıca nitelik kaydı
+// olmadan eklenmiş eski vektörlerin açılışta konu niteliğiyle taşınması.
+
+namespace {
+
+using CerebrumLux::SwarmVectorDB::CryptofigVector;
+using CerebrumLux::SwarmVectorDB::SwarmVectorDB;
+using CerebrumLux::SwarmVectorDB::VectorAttributes;
+using CerebrumLux::SwarmVectorDB::VectorFilter;
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_filtered_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+std::vector<float> embedding_for(int i) {
+    std::mt19937 rng(static_cast<unsigned>(i) + 1);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> values(256);
+    for (float& v : values) v = dist(rng);
+    return values;
+}
+
+CryptofigVector make_vector(int i, const std::string& topic) {
+    CryptofigVector cv;
+    cv.id = "vec_" + std::to_string(i);
+    cv.topic = topic;
+    const std::vector<float> values = embedding_for(i);
+    cv.embedding = Eigen::Map<const Eigen::VectorXf>(values.data(), static_cast<Eigen::Index>(values.size()));
+    return cv;
+}
+
+struct Record {
+    CryptofigVector cv;
+    VectorAttributes attributes;
+};
+
+// Konu, kaynak, güven ve zaman ID'den türetilir; beklenen sonuçlar testte kaba kuvvetle yeniden hesaplanır.
+Record make_record(int i, const std::string& topic) {
+    Record record{make_vector(i, topic), {}};
+    record.attributes.topic = topic;
+    record.attributes.source = (i % 2 == 0) ? "web" : "book";
+    record.attributes.trust_score = static_cast<float>(i % 10) / 10.0f;
+    record.attributes.timestamp_ms = 1'700'000'000'000LL + i * 1000LL;
+    return record;
+}
+
+bool store_all(SwarmVectorDB& db, const std::vector<Record>& records) {
+    for (std::size_t start = 0; start < records.size(); start += 200) {
+        std::vector<CryptofigVector> cvs;
+        std::vector<VectorAttributes> attributes;
+        for (std::size_t i = start; i < std::min(records.size(), start + 200); ++i) {
+            cvs.push_back(records[i].cv);
+            attributes.push_back(records[i].attributes);
+        }
+        if (!db.store_vectors_batch(cvs, {}, attributes)) return false;
+    }
+    return true;
+}
+
+bool passes(const VectorAttributes& a, const VectorFilter& filter) {
+    auto any_of = [](const std::vector<std::string>& values, const std::string& v) {
+        return values.empty() || std::find(values.begin(), values.end(), v) != values.end();
+    };
+    return any_of(filter.topics, a.topic) && any_of(filter.sources, a.source) &&
+           (!filter.min_trust || a.trust_score >= *filter.min_trust) &&
+           (!filter.from_ms || a.timestamp_ms >= *filter.from_ms) && (!filter.to_ms || a.timestamp_ms <= *filter.to_ms);
+}
+
+std::vector<std::string> brute_force(const std::vector<Record>& records, const std::vector<float>& query,
+                                     const VectorFilter& filter, std::size_t top_k) {
+    std::vector<std::pair<float, std::string>> scored;
+    for (const Record& record : records) {
+        if (!passes(record.attributes, filter)) continue;
+        float dist = 0.0f;
+        for (int d = 0; d < 256; ++d) {
+            const float diff = record.cv.embedding[d] - query[d];
+            dist += diff * diff;
+        }
+        scored.emplace_back(dist, record.cv.id);
+    }
+    std::sort(scored.begin(), scored.end());
+    std::vector<std::string> ids;
+    for (std::size_t i = 0; i < scored.size() && i < top_k; ++i) ids.push_back(scored[i].second);
+    return ids;
+}
+
+CerebrumLux::Metrics::Counter& path_counter(const char* path) {
+    return CerebrumLux::Metrics::MetricsRegistry::instance().counter(
+        "cerebrumlux_vectordb_filtered_search_total", "Filtreli arama sayısı (yol)", std::string("path=\"") + path + "\"");
+}
+
+} // namespace
+
+TEST(VectorDbFilteredSearch, SelectiveFilterUsesExactSearchOverCandidates) {
+    TempDbDir dir("exact");
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+    std::vector<Record> records;
+    const char* topics[] = {"Fizik", "Kimya", "Tarih"};
+    for (int i = 0; i < 600; ++i) records.push_back(make_record(i, topics[i % 3]));
+    ASSERT_TRUE(store_all(db, records));
+
+    VectorFilter filter;
+    filter.topics = {"Kimya"};
+    filter.sources = {"web"};
+    filter.min_trust = 0.5f;
+    filter.from_ms = records[100].attributes.timestamp_ms;
+
+    const std::uint64_t exact_before = path_counter("exact").value();
+    const std::uint64_t graph_before = path_counter("graph").value();
+    for (int probe : {0, 101, 250, 599}) {
+        const std::vector<float> query = embedding_for(probe);
+        const auto hits = db.search_similar_vectors_filtered(query, 10, filter);
+        EXPECT_EQ(hits, brute_force(records, query, filter, 10)) << "probe " << probe;
+        for (const std::string& id : hits) {
+            const auto attributes = db.get_vector_attributes(id);
+            ASSERT_TRUE(attributes.has_value());
+            EXPECT_TRUE(passes(*attributes, filter)) << id;
+        }
+    }
+    EXPECT_EQ(path_counter("exact").value() - exact_before, 4u);
+    EXPECT_EQ(path_counter("graph").value(), graph_before);
+
+    // Sözlükte olmayan konu: hiçbir etiket eşleşemez.
+    VectorFilter impossible;
+    impossible.topics = {"Yok"};
+    EXPECT_TRUE(db.search_similar_vectors_filtered(embedding_for(1), 5, impossible).empty());
+}
+
+TEST(VectorDbFilteredSearch, BroadFilterUsesGraphSearchWithFunctor) {
+    TempDbDir dir("graph");
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+
+    // Geniş konunun aday sayısı kExactSearchMaxCandidates'ı aşar; graf yolu seçilir.
+    const int common = static_cast<int>(SwarmVectorDB::kExactSearchMaxCandidates) + 200;
+    std::vector<Record> records;
+    for (int i = 0; i < common; ++i) records.push_back(make_record(i, "Genel"));
+    for (int i = common; i < common + 300; ++i) records.push_back(make_record(i, "Nadir"));
+    ASSERT_TRUE(store_all(db, records));
+
+    VectorFilter filter;
+    filter.topics = {"Genel"};
+
+    const std::uint64_t exact_before = path_counter("exact").value();
+    const std::uint64_t graph_before = path_counter("graph").value();
+    std::size_t searches = 0;
+    for (int probe = 0; probe < common + 300; probe += 251, ++searches) {
+        const std::vector<float> query = embedding_for(probe);
+        const auto hits = db.search_similar_vectors_filtered(query, 5, filter);
+        ASSERT_EQ(hits.size(), 5u);
+        for (const std::string& id : hits) {
+            const int index = std::stoi(id.substr(4));
+            EXPECT_LT(index, common) << id << " filtre dışı bir konudan";
+        }
+        // Genel konudaki vektörün kendisiyle sorgusu onu ilk sırada bulur; Nadir konudaki vektör asla dönmez.
+        if (probe < common) EXPECT_EQ(hits.front(), "vec_" + std::to_string(probe));
+        EXPECT_EQ(hits.front(), brute_force(records, query, filter, 1).front());
+    }
+    EXPECT_EQ(path_counter("graph").value() - graph_before, searches);
+    EXPECT_EQ(path_counter("exact").value(), exact_before);
+
+    // Aynı veri üzerinde seçici filtre tam arama yoluna döner ve yalnızca Nadir konuyu döndürür.
+    VectorFilter rare;
+    rare.topics = {"Nadir"};
+    const auto rare_hits = db.search_similar_vectors_filtered(embedding_for(3), 10, rare);
+    EXPECT_EQ(rare_hits, brute_force(records, embedding_for(3), rare, 10));
+    EXPECT_EQ(path_counter("exact").value() - exact_before, 1u);
+}
+
+TEST(VectorDbFilteredSearch, LegacyVectorsWithoutAttributesAreMigratedOnOpen) {
+    TempDbDir dir("legacy");
+    std::vector<Record> records;
+    for (int i = 0; i < 40; ++i) records.push_back(make_record(i, i < 20 ? "Eski" : "Yeni"));
+    {
+        SwarmVectorDB db(dir.str(), 10000);
+        ASSERT_TRUE(db.open());
+        ASSERT_TRUE(store_all(db, records));
+    }
+
+    // Nitelik özelliğinden önce yazılmış bir veritabanını taklit et: nitelik DBI'ını boşalt.
+    {
+        MDB_env* env = nullptr;
+        ASSERT_EQ(mdb_env_create(&env), MDB_SUCCESS);
+        ASSERT_EQ(mdb_env_set_maxdbs(env, 16), MDB_SUCCESS);
+        ASSERT_EQ(mdb_env_open(env, dir.str().c_str(), MDB_NOTLS, 0664), MDB_SUCCESS);
+        MDB_txn* txn = nullptr;
+        ASSERT_EQ(mdb_txn_begin(env, nullptr, 0, &txn), MDB_SUCCESS);
+        MDB_dbi dbi;
+        ASSERT_EQ(mdb_dbi_open(txn, "vector_attributes_db", 0, &dbi), MDB_SUCCESS);
+        ASSERT_EQ(mdb_drop(txn, dbi, 0), MDB_SUCCESS);
+        ASSERT_EQ(mdb_txn_commit(txn), MDB_SUCCESS);
+        mdb_env_close(env);
+    }
+
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+
+    // Konu vektörden alınır; kaynak ve zaman bilinmez, güven varsayılandır.
+    const auto migrated = db.get_vector_attributes("vec_5");
+    ASSERT_TRUE(migrated.has_value());
+    EXPECT_EQ(migrated->topic, "Eski");
+    EXPECT_TRUE(migrated->source.empty());
+    EXPECT_EQ(migrated->timestamp_ms, 0);
+    EXPECT_FLOAT_EQ(migrated->trust_score, 1.0f);
+
+    VectorFilter by_topic;
+    by_topic.topics = {"Eski"};
+    const auto hits = db.search_similar_vectors_filtered(embedding_for(25), 40, by_topic);
+    EXPECT_EQ(hits.size(), 20u);
+    for (const std::string& id : hits) EXPECT_LT(std::stoi(id.substr(4)), 20) << id;
+
+    // Kaybolan kaynak niteliğiyle eşleşen kayıt kalmaz.
+    VectorFilter by_source;
+    by_source.sources = {"web"};
+    EXPECT_TRUE(db.search_similar_vectors_filtered(embedding_for(2), 5, by_source).empty());
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/swarm_vectordb/VectorDB.h"
+
+// Küçük bir başlangıç haritasıyla açılan SwarmVectorDB'nin MDB_MAP_FULL sonrası haritayı büyütüp yazmayı
+// yeniden denemesi ve üst sınırda temiz biçimde başarısız olması. Ayrıca okuma kiralarının büyütme kapısını iç içe
+// kiralarda yeniden kilitlemeden, son kira bırakılana kadar tutması.
+
+namespace {
+
+using CerebrumLux::SwarmVectorDB::CryptofigVector;
+using CerebrumLux::SwarmVectorDB::LmdbMapOptions;
+using CerebrumLux::SwarmVectorDB::ReadTxnPool;
+using CerebrumLux::SwarmVectorDB::SwarmVectorDB;
+
+constexpr size_t kMiB = 1024 * 1024;
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_mapgrow_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+CryptofigVector make_vector(int i) {
+    CryptofigVector cv;
+    cv.id = "vec_" + std::to_string(i);
+    cv.topic = "MapGrowth";
+    cv.embedding = Eigen::VectorXf::Zero(256);
+    cv.embedding[i % 256] = 1.0f;
+    cv.embedding[(i * 7 + 3) % 256] += 0.5f;
+    return cv;
+}
+
+// 100'lük gruplar halinde yazar; ~4 KB'lık içerikler taşma sayfalarına düştüğü için birkaç yüz kayıt 1 MB'ı aşar.
+bool fill(SwarmVectorDB& db, int count, const std::string& padding) {
+    for (int start = 0; start < count; start += 100) {
+        std::vector<CryptofigVector> cvs;
+        std::vector<std::string> contents;
+        for (int i = start; i < start + 100 && i < count; ++i) {
+            cvs.push_back(make_vector(i));
+            contents.push_back(padding + std::to_string(i));
+        }
+        if (!db.store_vectors_batch(cvs, contents)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(VectorDbMapGrowth, GrowsPastTinyInitialMapAndKeepsData) {
+    TempDbDir dir("grow");
+    LmdbMapOptions options;
+    options.initial_size = 1 * kMiB;
+    options.max_size = 256 * kMiB;
+    const std::string padding(4096, 'x');
+
+    {
+        SwarmVectorDB db(dir.str(), 10000, options);
+        ASSERT_TRUE(db.open());
+        ASSERT_TRUE(fill(db, 1500, padding));
+        // Tekil yazma yolu da büyümeden sonra çalışmaya devam eder.
+        ASSERT_TRUE(db.store_vector(make_vector(1500)));
+
+        const auto stats = db.get_env_stats();
+        EXPECT_GT(stats.map_resizes, 0u);
+        EXPECT_GT(stats.map_size, options.initial_size);
+        EXPECT_LE(stats.used_bytes, stats.map_size);
+        EXPECT_GT(stats.map_usage, 0.0);
+        EXPECT_GT(stats.page_size, 0u);
+
+        size_t vector_entries = 0;
+        for (const auto& dbi : stats.databases) {
+            if (dbi.name == "cryptofig_vectors") vector_entries = dbi.entries;
+        }
+        EXPECT_EQ(vector_entries, 1501u);
+
+        // MDB_MAP_FULL sonrası yeniden denenen gruplar HNSW'de yuva veya silinmiş etiket bırakmaz.
+        const auto index_stats = db.get_index_stats();
+        EXPECT_EQ(index_stats.live_elements, 1501u);
+        EXPECT_EQ(index_stats.deleted_elements, 0u);
+
+        auto cv = db.get_vector("vec_1234");
+        ASSERT_NE(cv, nullptr);
+        EXPECT_EQ(cv->topic, "MapGrowth");
+        EXPECT_EQ(db.get_capsule_content("vec_1234").value_or(""), padding + "1234");
+        const CryptofigVector probe = make_vector(42);
+        const std::vector<float> query(probe.embedding.data(), probe.embedding.data() + probe.embedding.size());
+        const auto hits = db.search_similar_vectors(query, 1);
+        ASSERT_EQ(hits.size(), 1u);
+        EXPECT_EQ(hits.front(), "vec_42");
+    }
+
+    // Yeniden açılışta küçük başlangıç boyutu istense de LMDB mevcut dosyanın boyutunu kullanır.
+    SwarmVectorDB reopened(dir.str(), 10000, options);
+    ASSERT_TRUE(reopened.open());
+    const auto stats = reopened.get_env_stats();
+    EXPECT_GE(stats.map_size, stats.used_bytes);
+    EXPECT_NE(reopened.get_vector("vec_1499"), nullptr);
+}
+
+TEST(VectorDbMapGrowth, FailsCleanlyAtMaxSize) {
+    TempDbDir dir("cap");
+    LmdbMapOptions options;
+    options.initial_size = 1 * kMiB;
+    options.max_size = 2 * kMiB;
+    const std::string padding(4096, 'y');
+
+    SwarmVectorDB db(dir.str(), 10000, options);
+    ASSERT_TRUE(db.open());
+    EXPECT_FALSE(fill(db, 2000, padding));
+
+    const auto stats = db.get_env_stats();
+    EXPECT_EQ(stats.map_size, options.max_size);
+    EXPECT_GT(stats.map_resizes, 0u);
+    // Başarısız grup geri alınmıştır; önceki gruplar okunabilir kalır.
+    EXPECT_NE(db.get_vector("vec_0"), nullptr);
+    EXPECT_EQ(db.get_vector("vec_1999"), nullptr);
+    // Başarısız denemeler indekse hiç ulaşmaz: indeksteki her eleman LMDB'deki bir vektördür.
+    const auto index_stats = db.get_index_stats();
+    EXPECT_EQ(index_stats.deleted_elements, 0u);
+    EXPECT_EQ(index_stats.live_elements, db.get_all_ids().size());
+}
+
+TEST(VectorDbMapGrowth, NestedReadLeasesShareTheGateUntilTheLastIsReleased) {
+    TempDbDir dir("gate");
+    MDB_env* env = nullptr;
+    ASSERT_EQ(mdb_env_create(&env), MDB_SUCCESS);
+    ASSERT_EQ(mdb_env_open(env, dir.str().c_str(), MDB_NOTLS, 0664), MDB_SUCCESS);
+
+    std::shared_mutex gate;
+    {
+        ReadTxnPool pool(gate);
+        pool.attach(env);
+
+        // Büyütme, kapının özel kilidini bekler; iç içe kiralar sırasında hep beklemede kalmalı.
+        std::atomic<bool> grown{false};
+        auto outer = std::make_unique<ReadTxnPool::Lease>(pool.acquire());
+        ASSERT_TRUE(*outer);
+        std::thread grower([&] {
+            std::unique_lock<std::shared_mutex> exclusive(gate);
+            grown = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        // Bekleyen yazar varken iç kira kapıyı yeniden kilitlemez (yazar öncelikli kilitte kendini kilitlerdi).
+        ReadTxnPool::Lease inner = pool.acquire();
+        ASSERT_TRUE(inner);
+        EXPECT_NE(inner.get(), outer->get());
+        {
+            ReadTxnPool::Lease innermost = pool.acquire();
+            ASSERT_TRUE(innermost);
+        }
+
+        // Dış kira iç kiradan önce bırakılır: kapı iç kira yaşadıkça tutulmaya devam eder.
+        outer.reset();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(grown);
+
+        inner = ReadTxnPool::Lease();
+        grower.join();
+        EXPECT_TRUE(grown);
+
+        // Kapı çözüldükten sonra yeni kiralar normal çalışır ve transaction'lar yeniden kullanılır.
+        ReadTxnPool::Lease again = pool.acquire();
+        EXPECT_TRUE(again);
+        EXPECT_GT(pool.stats().reused, 0u);
+    }
+    mdb_env_close(env);
+}
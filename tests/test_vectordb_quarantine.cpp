@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/swarm_vectordb/VectorDB.h"
+
+// Karantina (taşıma, geri alma, kalıcı silme) ve HNSW sıkıştırmasının arama sonuçlarını koruyarak silinmiş
+// yuvaları geri kazanması.
+
+namespace {
+
+using CerebrumLux::SwarmVectorDB::CryptofigVector;
+using CerebrumLux::SwarmVectorDB::SwarmVectorDB;
+
+class TempDbDir {
+public:
+    explicit TempDbDir(const std::string& name) {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = std::filesystem::temp_directory_path() / ("cerebrumlux_quarantine_" + name + "_" + std::to_string(stamp));
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDbDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    std::string str() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Her ID için farklı, tekrarlanabilir bir embedding: kendisiyle sorgulanan vektör en yakın komşu olarak döner.
+CryptofigVector make_vector(int i) {
+    CryptofigVector cv;
+    cv.id = "vec_" + std::to_string(i);
+    cv.topic = "Quarantine";
+    cv.embedding = Eigen::VectorXf::Zero(256);
+    std::mt19937 rng(static_cast<unsigned>(i) + 1);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    for (int d = 0; d < 256; ++d) cv.embedding[d] = dist(rng);
+    return cv;
+}
+
+std::vector<float> query_for(int i) {
+    const CryptofigVector cv = make_vector(i);
+    return std::vector<float>(cv.embedding.data(), cv.embedding.data() + cv.embedding.size());
+}
+
+bool fill(SwarmVectorDB& db, int count) {
+    for (int start = 0; start < count; start += 100) {
+        std::vector<CryptofigVector> cvs;
+        std::vector<std::string> contents;
+        for (int i = start; i < start + 100 && i < count; ++i) {
+            cvs.push_back(make_vector(i));
+            contents.push_back("içerik " + std::to_string(i));
+        }
+        if (!db.store_vectors_batch(cvs, contents)) return false;
+    }
+    return true;
+}
+
+bool contains(const std::vector<std::string>& ids, const std::string& id) {
+    return std::find(ids.begin(), ids.end(), id) != ids.end();
+}
+
+} // namespace
+
+TEST(VectorDbQuarantine, QuarantineHidesVectorAndRestoreBringsItBack) {
+    TempDbDir dir("restore");
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+    ASSERT_TRUE(fill(db, 50));
+
+    ASSERT_EQ(db.search_similar_vectors(query_for(7), 1), std::vector<std::string>{"vec_7"});
+
+    ASSERT_TRUE(db.quarantine_vector("vec_7", "yanlış kaynak"));
+    EXPECT_TRUE(db.is_quarantined("vec_7"));
+    EXPECT_EQ(db.get_vector("vec_7"), nullptr);
+    EXPECT_FALSE(db.get_capsule_content("vec_7").has_value());
+    EXPECT_FALSE(contains(db.search_similar_vectors(query_for(7), 10), "vec_7"));
+
+    const auto entries = db.list_quarantined();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].id, "vec_7");
+    EXPECT_EQ(entries[0].reason, "yanlış kaynak");
+    EXPECT_EQ(db.get_index_stats().quarantined, 1u);
+
+    ASSERT_TRUE(db.restore_vector("vec_7"));
+    EXPECT_FALSE(db.is_quarantined("vec_7"));
+    ASSERT_NE(db.get_vector("vec_7"), nullptr);
+    EXPECT_EQ(db.get_capsule_content("vec_7").value_or(""), "içerik 7");
+    EXPECT_EQ(db.search_similar_vectors(query_for(7), 1), std::vector<std::string>{"vec_7"});
+    EXPECT_EQ(db.get_index_stats().quarantined, 0u);
+
+    // Karantinada olmayan bir kaydı geri almak başarısız olur ve aktif kayda dokunmaz.
+    EXPECT_FALSE(db.restore_vector("vec_7"));
+    EXPECT_NE(db.get_vector("vec_7"), nullptr);
+}
+
+TEST(VectorDbQuarantine, PurgeRemovesTombstone) {
+    TempDbDir dir("purge");
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+    ASSERT_TRUE(fill(db, 20));
+
+    ASSERT_TRUE(db.quarantine_vector("vec_3", "tekrar"));
+    ASSERT_TRUE(db.is_quarantined("vec_3"));
+
+    ASSERT_TRUE(db.purge_quarantined("vec_3"));
+    EXPECT_FALSE(db.is_quarantined("vec_3"));
+    EXPECT_TRUE(db.list_quarantined().empty());
+    EXPECT_EQ(db.get_index_stats().quarantined, 0u);
+    EXPECT_FALSE(db.get_vector_attributes("vec_3").has_value());
+
+    // Mezar taşı gittiği için geri alma ve ikinci silme başarısız olur.
+    EXPECT_FALSE(db.restore_vector("vec_3"));
+    EXPECT_FALSE(db.purge_quarantined("vec_3"));
+    EXPECT_EQ(db.get_vector("vec_3"), nullptr);
+    EXPECT_FALSE(contains(db.search_similar_vectors(query_for(3), 10), "vec_3"));
+}
+
+TEST(VectorDbQuarantine, CompactionReclaimsDeletedSlotsAndKeepsResults) {
+    TempDbDir dir("compact");
+    SwarmVectorDB db(dir.str(), 10000);
+    ASSERT_TRUE(db.open());
+
+    // Silinenler kCompactionMinDeleted'ı aşar ama canlı elemanların dörtte birinin altında kalır; böylece otomatik
+    // tetikleyici çalışmaz ve sıkıştırmayı compact_index başlatır.
+    constexpr int kCount = 1400;
+    constexpr int kDeleted = 300;
+    static_assert(kDeleted > static_cast<int>(SwarmVectorDB::kCompactionMinDeleted), "silinen sayısı eşiği aşmalı");
+    ASSERT_TRUE(fill(db, kCount));
+    for (int i = 0; i < kDeleted; ++i) ASSERT_TRUE(db.delete_vector("vec_" + std::to_string(i * 4)));
+
+    const auto before_stats = db.get_index_stats();
+    EXPECT_FALSE(before_stats.compaction_running);
+    EXPECT_EQ(before_stats.compactions, 0u);
+    EXPECT_EQ(before_stats.deleted_elements, static_cast<size_t>(kDeleted));
+    EXPECT_EQ(before_stats.live_elements, static_cast<size_t>(kCount - kDeleted));
+
+    std::vector<std::vector<std::string>> before;
+    for (int probe = 1; probe < kCount; probe += 37) before.push_back(db.search_similar_vectors(query_for(probe), 1));
+
+    ASSERT_TRUE(db.compact_index(true));
+
+    const auto after_stats = db.get_index_stats();
+    EXPECT_FALSE(after_stats.compaction_running);
+    EXPECT_EQ(after_stats.compactions, 1u);
+    EXPECT_EQ(after_stats.deleted_elements, 0u);
+    EXPECT_EQ(after_stats.live_elements, static_cast<size_t>(kCount - kDeleted));
+
+    size_t index = 0;
+    for (int probe = 1; probe < kCount; probe += 37, ++index) {
+        const auto hits = db.search_similar_vectors(query_for(probe), 1);
+        EXPECT_EQ(hits, before[index]) << "probe " << probe;
+        if (probe % 4 != 0) EXPECT_EQ(hits, std::vector<std::string>{"vec_" + std::to_string(probe)});
+    }
+    for (int i = 0; i < kDeleted; i += 25) {
+        EXPECT_FALSE(contains(db.search_similar_vectors(query_for(i * 4), 5), "vec_" + std::to_string(i * 4)));
+    }
+
+    // Sıkıştırılmış indeks yazmaya devam eder: silinen bir ID yeniden eklenince bulunur.
+    ASSERT_TRUE(db.store_vector(make_vector(0)));
+    EXPECT_EQ(db.search_similar_vectors(query_for(0), 1), std::vector<std::string>{"vec_0"});
+}